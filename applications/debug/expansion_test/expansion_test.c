@@ -11,9 +11,11 @@
  * - Enables module support and emulates the module on a single device
  *   (hence the above connection),
  * - Connects to the expansion module service, sets baud rate,
+ * - Negotiates stream mode (unless TEST_STREAM_MODE is set to false),
  * - Starts the RPC session,
+ * - Measures average RPC ping round trip time,
  * - Creates a directory at `/ext/ExpansionTest` and writes a file
- *   named `test.txt` under it,
+ *   named `test.txt` under it several times, measuring the throughput,
  * - Plays an audiovisual alert (sound and blinking display),
  * - Waits 10 cycles of idle loop,
  * - Stops the RPC session,
@@ -47,7 +49,14 @@
 #define HOST_SERIAL_ID   (FuriHalSerialIdLpuart)
 #define MODULE_SERIAL_ID (FuriHalSerialIdUsart)
 
-#define RECEIVE_BUFFER_SIZE (sizeof(ExpansionFrame) + sizeof(ExpansionFrameChecksum))
+#define TEST_BAUD_RATE     (230400UL)
+#define TEST_STREAM_MODE   (true)
+#define TEST_STREAM_WINDOW (4U)
+#define TEST_PING_COUNT    (16U)
+#define TEST_WRITE_COUNT   (8U)
+
+#define RECEIVE_BUFFER_SIZE \
+    (TEST_STREAM_WINDOW * (sizeof(ExpansionFrame) + sizeof(ExpansionFrameChecksum)))
 
 typedef enum {
     ExpansionTestAppFlagData = 1U << 0,
@@ -64,6 +73,17 @@ typedef struct {
     ExpansionFrame frame;
     PB_Main msg;
     Storage* storage;
+
+    bool is_stream_mode;
+    uint16_t tx_max_data_size;
+    uint8_t tx_window;
+    uint8_t tx_seq;
+    uint8_t tx_seq_acked;
+    uint8_t rx_seq;
+
+    uint8_t tx_buf[EXPANSION_PROTOCOL_STREAM_MAX_DATA_SIZE];
+    size_t tx_buf_size;
+    uint32_t write_size;
 } ExpansionTestApp;
 
 static void expansion_test_app_serial_rx_callback(
@@ -218,23 +238,111 @@ static bool expansion_test_app_send_data_request(
            ExpansionProtocolStatusOk;
 }
 
+static bool
+    expansion_test_app_send_stream_config_request(ExpansionTestApp* instance, uint8_t window) {
+    ExpansionFrame frame = {
+        .header.type = ExpansionFrameTypeStreamConfig,
+        .content.stream_config.max_data_size = EXPANSION_PROTOCOL_STREAM_MAX_DATA_SIZE,
+        .content.stream_config.window = window,
+    };
+    return expansion_protocol_encode(&frame, expansion_test_app_send_callback, instance) ==
+           ExpansionProtocolStatusOk;
+}
+
+static bool expansion_test_app_send_stream_data_request(
+    ExpansionTestApp* instance,
+    const uint8_t* data,
+    size_t data_size) {
+    furi_assert(data_size <= instance->tx_max_data_size);
+
+    ExpansionFrame frame = {
+        .header.type = ExpansionFrameTypeStreamData,
+        .content.stream_data.seq = instance->tx_seq++,
+        .content.stream_data.size = data_size,
+    };
+
+    memcpy(frame.content.stream_data.bytes, data, data_size);
+    return expansion_protocol_encode(&frame, expansion_test_app_send_callback, instance) ==
+           ExpansionProtocolStatusOk;
+}
+
+static bool expansion_test_app_send_stream_ack(ExpansionTestApp* instance, uint8_t seq) {
+    ExpansionFrame frame = {
+        .header.type = ExpansionFrameTypeStreamAck,
+        .content.stream_ack.seq = seq,
+    };
+    return expansion_protocol_encode(&frame, expansion_test_app_send_callback, instance) ==
+           ExpansionProtocolStatusOk;
+}
+
+static bool expansion_test_app_receive_stream_ack(ExpansionTestApp* instance) {
+    bool success = false;
+
+    do {
+        if(!expansion_test_app_receive_frame(instance, &instance->frame)) break;
+        if(instance->frame.header.type != ExpansionFrameTypeStreamAck) break;
+        const uint8_t frames_in_flight = instance->tx_seq - instance->tx_seq_acked;
+        const uint8_t frames_acked =
+            instance->frame.content.stream_ack.seq + 1U - instance->tx_seq_acked;
+        if((frames_acked == 0) || (frames_acked > frames_in_flight)) break;
+        instance->tx_seq_acked += frames_acked;
+        success = true;
+    } while(false);
+
+    return success;
+}
+
+static bool expansion_test_app_flush_data(ExpansionTestApp* instance) {
+    bool success = false;
+
+    do {
+        if(instance->is_stream_mode) {
+            // Only wait for acknowledgements once the host's window is full
+            const uint8_t frames_in_flight = instance->tx_seq - instance->tx_seq_acked;
+            if(frames_in_flight >= instance->tx_window) {
+                if(!expansion_test_app_receive_stream_ack(instance)) break;
+            }
+            if(!expansion_test_app_send_stream_data_request(
+                   instance, instance->tx_buf, instance->tx_buf_size))
+                break;
+        } else {
+            if(!expansion_test_app_send_data_request(
+                   instance, instance->tx_buf, instance->tx_buf_size))
+                break;
+            if(!expansion_test_app_receive_frame(instance, &instance->frame)) break;
+            if(!expansion_test_app_is_success_response(&instance->frame)) break;
+        }
+        instance->tx_buf_size = 0;
+        success = true;
+    } while(false);
+
+    return success;
+}
+
 static bool expansion_test_app_rpc_encode_callback(
     pb_ostream_t* stream,
     const pb_byte_t* data,
     size_t data_size) {
     ExpansionTestApp* instance = stream->state;
 
+    const size_t max_data_size = instance->is_stream_mode ? instance->tx_max_data_size :
+                                                            EXPANSION_PROTOCOL_MAX_DATA_SIZE;
     size_t size_sent = 0;
 
+    // Small protobuf fields are gathered into full frames
     while(size_sent < data_size) {
-        const size_t current_size = MIN(data_size - size_sent, EXPANSION_PROTOCOL_MAX_DATA_SIZE);
-        if(!expansion_test_app_send_data_request(instance, data + size_sent, current_size)) break;
-        if(!expansion_test_app_receive_frame(instance, &instance->frame)) break;
-        if(!expansion_test_app_is_success_response(&instance->frame)) break;
+        const size_t current_size =
+            MIN(data_size - size_sent, max_data_size - instance->tx_buf_size);
+        memcpy(instance->tx_buf + instance->tx_buf_size, data + size_sent, current_size);
+        instance->tx_buf_size += current_size;
         size_sent += current_size;
+
+        if(instance->tx_buf_size == max_data_size) {
+            if(!expansion_test_app_flush_data(instance)) return false;
+        }
     }
 
-    return size_sent == data_size;
+    return true;
 }
 
 static bool expansion_test_app_send_rpc_request(ExpansionTestApp* instance, PB_Main* message) {
@@ -246,8 +354,20 @@ static bool expansion_test_app_send_rpc_request(ExpansionTestApp* instance, PB_M
         .errmsg = NULL,
     };
 
-    const bool success = pb_encode_ex(&stream, &PB_Main_msg, message, PB_ENCODE_DELIMITED);
+    instance->tx_buf_size = 0;
+
+    bool success = pb_encode_ex(&stream, &PB_Main_msg, message, PB_ENCODE_DELIMITED);
     pb_release(&PB_Main_msg, message);
+
+    if(success && (instance->tx_buf_size > 0)) {
+        success = expansion_test_app_flush_data(instance);
+    }
+
+    // The host acknowledges all frames before it is able to respond
+    while(success && instance->is_stream_mode && (instance->tx_seq != instance->tx_seq_acked)) {
+        success = expansion_test_app_receive_stream_ack(instance);
+    }
+
     return success;
 }
 
@@ -256,10 +376,24 @@ static bool expansion_test_app_receive_rpc_request(ExpansionTestApp* instance, P
 
     do {
         if(!expansion_test_app_receive_frame(instance, &instance->frame)) break;
-        if(!expansion_test_app_send_status_response(instance, ExpansionFrameErrorNone)) break;
-        if(instance->frame.header.type != ExpansionFrameTypeData) break;
-        pb_istream_t stream = pb_istream_from_buffer(
-            instance->frame.content.data.bytes, instance->frame.content.data.size);
+
+        const uint8_t* data;
+        size_t data_size;
+
+        if(instance->is_stream_mode) {
+            if(instance->frame.header.type != ExpansionFrameTypeStreamData) break;
+            if(instance->frame.content.stream_data.seq != instance->rx_seq) break;
+            if(!expansion_test_app_send_stream_ack(instance, instance->rx_seq++)) break;
+            data = instance->frame.content.stream_data.bytes;
+            data_size = instance->frame.content.stream_data.size;
+        } else {
+            if(!expansion_test_app_send_status_response(instance, ExpansionFrameErrorNone)) break;
+            if(instance->frame.header.type != ExpansionFrameTypeData) break;
+            data = instance->frame.content.data.bytes;
+            data_size = instance->frame.content.data.size;
+        }
+
+        pb_istream_t stream = pb_istream_from_buffer(data, data_size);
         if(!pb_decode_ex(&stream, &PB_Main_msg, message, PB_DECODE_DELIMITED)) break;
         success = true;
     } while(false);
@@ -291,10 +425,10 @@ static bool expansion_test_app_handshake(ExpansionTestApp* instance) {
     bool success = false;
 
     do {
-        if(!expansion_test_app_send_baud_rate_request(instance, 230400)) break;
+        if(!expansion_test_app_send_baud_rate_request(instance, TEST_BAUD_RATE)) break;
         if(!expansion_test_app_receive_frame(instance, &instance->frame)) break;
         if(!expansion_test_app_is_success_response(&instance->frame)) break;
-        furi_hal_serial_set_br(instance->handle, 230400);
+        furi_hal_serial_set_br(instance->handle, TEST_BAUD_RATE);
         furi_delay_ms(EXPANSION_PROTOCOL_BAUD_CHANGE_DT_MS);
         success = true;
     } while(false);
@@ -302,6 +436,35 @@ static bool expansion_test_app_handshake(ExpansionTestApp* instance) {
     return success;
 }
 
+static bool expansion_test_app_negotiate_stream_mode(ExpansionTestApp* instance) {
+    bool success = false;
+
+    do {
+        if(!expansion_test_app_send_stream_config_request(instance, TEST_STREAM_WINDOW)) break;
+        if(!expansion_test_app_receive_frame(instance, &instance->frame)) break;
+        if(instance->frame.header.type != ExpansionFrameTypeStreamConfig) break;
+
+        const ExpansionFrameStreamConfig* config = &instance->frame.content.stream_config;
+        if((config->max_data_size == 0) || (config->window == 0)) break;
+
+        instance->is_stream_mode = true;
+        instance->tx_max_data_size = MIN(config->max_data_size, sizeof(instance->tx_buf));
+        instance->tx_window = config->window;
+        instance->tx_seq = 0;
+        instance->tx_seq_acked = 0;
+        instance->rx_seq = 0;
+
+        FURI_LOG_I(
+            TAG,
+            "Stream mode: %u bytes per frame, window %u",
+            instance->tx_max_data_size,
+            instance->tx_window);
+        success = true;
+    } while(false);
+
+    return success;
+}
+
 static bool expansion_test_app_start_rpc(ExpansionTestApp* instance) {
     bool success = false;
 
@@ -335,6 +498,42 @@ static bool expansion_test_app_rpc_mkdir(ExpansionTestApp* instance) {
     return success;
 }
 
+static bool expansion_test_app_rpc_ping(ExpansionTestApp* instance) {
+    bool success = false;
+
+    instance->msg.command_id++;
+    instance->msg.command_status = PB_CommandStatus_OK;
+    instance->msg.which_content = PB_Main_system_ping_request_tag;
+    instance->msg.has_next = false;
+    instance->msg.content.system_ping_request.data = NULL;
+
+    do {
+        if(!expansion_test_app_send_rpc_request(instance, &instance->msg)) break;
+        if(!expansion_test_app_receive_rpc_request(instance, &instance->msg)) break;
+        if(instance->msg.which_content != PB_Main_system_ping_response_tag) break;
+        if(instance->msg.command_status != PB_CommandStatus_OK) break;
+        success = true;
+    } while(false);
+
+    pb_release(&PB_Main_msg, &instance->msg);
+
+    return success;
+}
+
+static bool expansion_test_app_rpc_ping_benchmark(ExpansionTestApp* instance) {
+    const uint32_t start_tick = furi_get_tick();
+
+    uint32_t num_pings_done;
+    for(num_pings_done = 0; num_pings_done < TEST_PING_COUNT; ++num_pings_done) {
+        if(!expansion_test_app_rpc_ping(instance)) break;
+    }
+
+    const uint32_t elapsed_ms = furi_get_tick() - start_tick;
+    FURI_LOG_I(TAG, "Ping: %lu us average round trip", elapsed_ms * 1000UL / TEST_PING_COUNT);
+
+    return num_pings_done == TEST_PING_COUNT;
+}
+
 static bool expansion_test_app_rpc_write(ExpansionTestApp* instance) {
     bool success = false;
 
@@ -368,6 +567,7 @@ static bool expansion_test_app_rpc_write(ExpansionTestApp* instance) {
         if(!expansion_test_app_send_rpc_request(instance, &instance->msg)) break;
         if(!expansion_test_app_receive_rpc_request(instance, &instance->msg)) break;
         if(!expansion_test_app_is_success_rpc_message(&instance->msg)) break;
+        instance->write_size += file_size;
         success = true;
     } while(false);
 
@@ -377,6 +577,26 @@ static bool expansion_test_app_rpc_write(ExpansionTestApp* instance) {
     return success;
 }
 
+static bool expansion_test_app_rpc_write_benchmark(ExpansionTestApp* instance) {
+    const uint32_t start_tick = furi_get_tick();
+    instance->write_size = 0;
+
+    uint32_t num_writes_done;
+    for(num_writes_done = 0; num_writes_done < TEST_WRITE_COUNT; ++num_writes_done) {
+        if(!expansion_test_app_rpc_write(instance)) break;
+    }
+
+    const uint32_t elapsed_ms = MAX(furi_get_tick() - start_tick, 1UL);
+    FURI_LOG_I(
+        TAG,
+        "Write: %lu bytes in %lu ms, %lu bytes/s",
+        instance->write_size,
+        elapsed_ms,
+        instance->write_size * 1000UL / elapsed_ms);
+
+    return num_writes_done == TEST_WRITE_COUNT;
+}
+
 static bool expansion_test_app_rpc_alert(ExpansionTestApp* instance) {
     bool success = false;
 
@@ -434,9 +654,11 @@ int32_t expansion_test_app(void* p) {
         if(!expansion_test_app_send_presence(instance)) break;
         if(!expansion_test_app_wait_ready(instance)) break;
         if(!expansion_test_app_handshake(instance)) break;
+        if(TEST_STREAM_MODE && !expansion_test_app_negotiate_stream_mode(instance)) break;
         if(!expansion_test_app_start_rpc(instance)) break;
+        if(!expansion_test_app_rpc_ping_benchmark(instance)) break;
         if(!expansion_test_app_rpc_mkdir(instance)) break;
-        if(!expansion_test_app_rpc_write(instance)) break;
+        if(!expansion_test_app_rpc_write_benchmark(instance)) break;
         if(!expansion_test_app_rpc_alert(instance)) break;
         if(!expansion_test_app_idle(instance, 10)) break;
         if(!expansion_test_app_stop_rpc(instance)) break;
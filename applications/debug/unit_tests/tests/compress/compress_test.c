@@ -13,6 +13,8 @@
 
 #include <stdint.h>
 
+#define TAG "CompressTest"
+
 #define COMPRESS_UNIT_TESTS_PATH(path) EXT_PATH("unit_tests/compress/" path)
 
 static void compress_test_reference_comp_decomp() {
@@ -338,11 +340,157 @@ static void compress_test_heatshrink_tar() {
     furi_record_close(RECORD_STORAGE);
 }
 
+#define GZ_INDEX_TAR_PATH     COMPRESS_UNIT_TESTS_PATH("gzip_index.tar.gz")
+#define GZ_INDEX_PATH         COMPRESS_UNIT_TESTS_PATH("gzip_index.tar.gz.idx")
+#define GZ_INDEX_EXTRACT_PATH COMPRESS_UNIT_TESTS_PATH("gzip_index_extracted.txt")
+#define GZ_INDEX_EDITED_PATH  COMPRESS_UNIT_TESTS_PATH("gzip_index_edited.tar.gz")
+#define GZ_INDEX_INTERVAL     (16 * 1024)
+
+static const char gz_index_first_content[] = "First file in the gzip index test archive\n";
+static const char gz_index_last_content[] = "Last file in the gzip index test archive\n";
+
+static bool compress_test_gzip_index_check_file(Storage* api, const char* expected) {
+    File* file = storage_file_alloc(api);
+    size_t expected_size = strlen(expected);
+    char* buffer = malloc(expected_size + 1);
+    bool success =
+        storage_file_open(file, GZ_INDEX_EXTRACT_PATH, FSAM_READ, FSOM_OPEN_EXISTING) &&
+        storage_file_size(file) == expected_size &&
+        storage_file_read(file, buffer, expected_size) == expected_size &&
+        memcmp(buffer, expected, expected_size) == 0;
+    free(buffer);
+    storage_file_free(file);
+    return success;
+}
+
+static bool compress_test_gzip_index_unpack(
+    Storage* api,
+    TarArchive* archive,
+    const char* name,
+    const char* expected,
+    uint32_t* elapsed) {
+    uint32_t start = furi_get_tick();
+    bool success = tar_archive_unpack_file(archive, name, GZ_INDEX_EXTRACT_PATH);
+    if(elapsed) *elapsed = furi_get_tick() - start;
+    success = success && compress_test_gzip_index_check_file(api, expected);
+    storage_simply_remove(api, GZ_INDEX_EXTRACT_PATH);
+    return success;
+}
+
+static uint64_t compress_test_gzip_index_size(Storage* api) {
+    FileInfo info;
+    return (storage_common_stat(api, GZ_INDEX_PATH, &info) == FSE_OK) ? info.size : 0;
+}
+
+/* Same size copy of the archive with a different gzip trailer CRC */
+static bool compress_test_gzip_index_make_edited(Storage* api) {
+    if(storage_common_copy(api, GZ_INDEX_TAR_PATH, GZ_INDEX_EDITED_PATH) != FSE_OK) return false;
+
+    File* file = storage_file_alloc(api);
+    uint8_t crc_byte;
+    bool success =
+        storage_file_open(file, GZ_INDEX_EDITED_PATH, FSAM_READ_WRITE, FSOM_OPEN_EXISTING) &&
+        storage_file_seek(file, storage_file_size(file) - 8, true) &&
+        storage_file_read(file, &crc_byte, 1) == 1;
+    crc_byte ^= 0xFF;
+    success = success && storage_file_seek(file, storage_file_size(file) - 8, true) &&
+              storage_file_write(file, &crc_byte, 1) == 1;
+    storage_file_free(file);
+    return success;
+}
+
+/*
+gzip_index.tar.gz: first.txt, bulk/bulk_[0-7].txt (48KB each), last.txt
+*/
+
+static void compress_test_gzip_index() {
+    Storage* api = furi_record_open(RECORD_STORAGE);
+    storage_simply_remove(api, GZ_INDEX_PATH);
+
+    // Build index on first scan, then seek back and forth
+    TarArchive* archive = tar_archive_alloc(api);
+    mu_assert(tar_archive_open(archive, GZ_INDEX_TAR_PATH, TAR_OPEN_MODE_READ), "Failed to open");
+    mu_assert(
+        tar_archive_set_gzip_index(archive, GZ_INDEX_PATH, GZ_INDEX_INTERVAL),
+        "Failed to create index");
+    mu_assert(
+        !tar_archive_set_gzip_index(archive, GZ_INDEX_PATH, GZ_INDEX_INTERVAL),
+        "Index attached twice");
+
+    uint32_t build_time, warm_time, cold_time, plain_time;
+    mu_assert(
+        compress_test_gzip_index_unpack(
+            api, archive, "last.txt", gz_index_last_content, &build_time),
+        "Failed to unpack last file");
+    mu_assert(
+        compress_test_gzip_index_unpack(api, archive, "first.txt", gz_index_first_content, NULL),
+        "Failed to unpack first file after backward seek");
+    mu_assert(
+        compress_test_gzip_index_unpack(
+            api, archive, "last.txt", gz_index_last_content, &warm_time),
+        "Failed to unpack last file with index");
+    mu_assert(tar_archive_get_entries_count(archive) == 10, "Invalid number of entries");
+    tar_archive_free(archive);
+
+    // Reopen with the index stored in the sidecar file
+    archive = tar_archive_alloc(api);
+    mu_assert(tar_archive_open(archive, GZ_INDEX_TAR_PATH, TAR_OPEN_MODE_READ), "Failed to open");
+    mu_assert(
+        tar_archive_set_gzip_index(archive, GZ_INDEX_PATH, GZ_INDEX_INTERVAL),
+        "Failed to load index");
+    mu_assert(
+        compress_test_gzip_index_unpack(
+            api, archive, "last.txt", gz_index_last_content, &cold_time),
+        "Failed to unpack last file with stored index");
+    mu_assert(
+        compress_test_gzip_index_unpack(api, archive, "first.txt", gz_index_first_content, NULL),
+        "Failed to unpack first file with stored index");
+    tar_archive_free(archive);
+
+    // Edited archive of the same size must not reuse checkpoints of the original
+    uint64_t index_size = compress_test_gzip_index_size(api);
+    mu_assert(compress_test_gzip_index_make_edited(api), "Failed to create edited archive");
+    archive = tar_archive_alloc(api);
+    mu_assert(
+        tar_archive_open(archive, GZ_INDEX_EDITED_PATH, TAR_OPEN_MODE_READ), "Failed to open");
+    mu_assert(
+        tar_archive_set_gzip_index(archive, GZ_INDEX_PATH, GZ_INDEX_INTERVAL),
+        "Failed to attach index");
+    mu_assert(
+        compress_test_gzip_index_unpack(api, archive, "first.txt", gz_index_first_content, NULL),
+        "Failed to unpack first file from edited archive");
+    tar_archive_free(archive);
+    storage_simply_remove(api, GZ_INDEX_EDITED_PATH);
+    mu_assert(
+        compress_test_gzip_index_size(api) < index_size, "Index of other archive was reused");
+
+    // Plain sequential archive for reference
+    archive = tar_archive_alloc(api);
+    mu_assert(tar_archive_open(archive, GZ_INDEX_TAR_PATH, TAR_OPEN_MODE_READ), "Failed to open");
+    mu_assert(
+        compress_test_gzip_index_unpack(
+            api, archive, "last.txt", gz_index_last_content, &plain_time),
+        "Failed to unpack last file without index");
+    tar_archive_free(archive);
+
+    FURI_LOG_I(
+        TAG,
+        "Single file unpack: plain %lums, index build %lums, warm %lums, from file %lums",
+        plain_time,
+        build_time,
+        warm_time,
+        cold_time);
+
+    storage_simply_remove(api, GZ_INDEX_PATH);
+    furi_record_close(RECORD_STORAGE);
+}
+
 MU_TEST_SUITE(test_compress) {
     MU_RUN_TEST(compress_test_random_comp_decomp);
     MU_RUN_TEST(compress_test_reference_comp_decomp);
     MU_RUN_TEST(compress_test_heatshrink_stream);
     MU_RUN_TEST(compress_test_heatshrink_tar);
+    MU_RUN_TEST(compress_test_gzip_index);
 }
 
 int run_minunit_test_compress(void) {
@@ -0,0 +1,162 @@
+#include <furi.h>
+#include <furi_hal.h>
+
+#include "../test.h" // IWYU pragma: keep
+
+#include <toolbox/crc.h>
+
+#define TAG "CrcTest"
+
+#define CRC_TEST_BUFFER_SIZE  (512U)
+#define CRC_TEST_ROUNDS       (2000U)
+#define CRC_TEST_BENCH_ROUNDS (64U)
+
+static const char crc_test_check_input[] = "123456789";
+
+/* Bitwise reference implementations, same as ones the table-driven code replaced */
+static uint32_t crc_test_crc32_reference(uint32_t crc, const uint8_t* data, size_t size) {
+    while(size--) {
+        crc ^= *data++;
+        for(uint8_t i = 0; i < 8; i++) {
+            crc = (crc & 1U) ? (crc >> 1) ^ 0xEDB88320U : crc >> 1;
+        }
+    }
+    return crc;
+}
+
+static uint16_t crc_test_crc16_ccitt_reference(uint16_t crc, const uint8_t* data, size_t size) {
+    while(size--) {
+        crc ^= (uint16_t)*data++ << 8;
+        for(uint8_t i = 0; i < 8; i++) {
+            crc = (crc & 0x8000U) ? (crc << 1) ^ 0x1021U : crc << 1;
+        }
+    }
+    return crc;
+}
+
+static uint16_t
+    crc_test_crc16_ccitt_reflected_reference(uint16_t crc, const uint8_t* data, size_t size) {
+    while(size--) {
+        crc ^= *data++;
+        for(uint8_t i = 0; i < 8; i++) {
+            crc = (crc & 1U) ? (crc >> 1) ^ 0x8408U : crc >> 1;
+        }
+    }
+    return crc;
+}
+
+static uint8_t crc_test_crc8_maxim_reference(uint8_t crc, const uint8_t* data, size_t size) {
+    while(size--) {
+        uint8_t byte = *data++;
+        for(uint8_t i = 0; i < 8; i++) {
+            uint8_t mix = (crc ^ byte) & 0x01;
+            crc >>= 1;
+            if(mix) crc ^= 0x8C;
+            byte >>= 1;
+        }
+    }
+    return crc;
+}
+
+MU_TEST(crc_test_check_values) {
+    const size_t size = strlen(crc_test_check_input);
+
+    mu_assert_int_eq(0xCBF43926, ~crc32_update(UINT32_MAX, crc_test_check_input, size));
+    mu_assert_int_eq(0x31C3, crc16_ccitt_update(0x0000, crc_test_check_input, size));
+    // ISO14443-3 CRC_A
+    mu_assert_int_eq(0xBF05, crc16_ccitt_reflected_update(0x6363, crc_test_check_input, size));
+    // ISO14443-3 CRC_B
+    mu_assert_int_eq(
+        0x906E, (uint16_t)~crc16_ccitt_reflected_update(0xFFFF, crc_test_check_input, size));
+    mu_assert_int_eq(0xA1, crc8_maxim_update(0x00, crc_test_check_input, size));
+}
+
+MU_TEST(crc_test_random_buffers) {
+    uint8_t* buffer = malloc(CRC_TEST_BUFFER_SIZE);
+
+    for(uint32_t round = 0; round < CRC_TEST_ROUNDS; round++) {
+        // Cover unaligned starts and all tail lengths of the sliced loops
+        size_t offset = furi_hal_random_get() % 8;
+        size_t size = furi_hal_random_get() % (CRC_TEST_BUFFER_SIZE - offset);
+        furi_hal_random_fill_buf(buffer, CRC_TEST_BUFFER_SIZE);
+        const uint8_t* data = buffer + offset;
+        uint32_t init = furi_hal_random_get();
+
+        mu_assert_int_eq(
+            crc_test_crc32_reference(init, data, size), crc32_update(init, data, size));
+        mu_assert_int_eq(
+            crc_test_crc16_ccitt_reference(init, data, size),
+            crc16_ccitt_update(init, data, size));
+        mu_assert_int_eq(
+            crc_test_crc16_ccitt_reflected_reference(init, data, size),
+            crc16_ccitt_reflected_update(init, data, size));
+        mu_assert_int_eq(
+            crc_test_crc8_maxim_reference(init, data, size), crc8_maxim_update(init, data, size));
+    }
+
+    free(buffer);
+}
+
+static uint32_t crc_test_bytes_per_second(uint32_t elapsed) {
+    return (uint64_t)CRC_TEST_BUFFER_SIZE * CRC_TEST_BENCH_ROUNDS * 1000 / MAX(elapsed, 1UL);
+}
+
+MU_TEST(crc_test_benchmark) {
+    uint8_t* buffer = malloc(CRC_TEST_BUFFER_SIZE);
+    furi_hal_random_fill_buf(buffer, CRC_TEST_BUFFER_SIZE);
+    volatile uint32_t sink = 0;
+
+    uint32_t start = furi_get_tick();
+    for(uint32_t i = 0; i < CRC_TEST_BENCH_ROUNDS; i++) {
+        sink ^= crc_test_crc32_reference(i, buffer, CRC_TEST_BUFFER_SIZE);
+    }
+    uint32_t crc32_bitwise = furi_get_tick() - start;
+
+    start = furi_get_tick();
+    for(uint32_t i = 0; i < CRC_TEST_BENCH_ROUNDS; i++) {
+        sink ^= crc32_update(i, buffer, CRC_TEST_BUFFER_SIZE);
+    }
+    uint32_t crc32_sliced = furi_get_tick() - start;
+
+    start = furi_get_tick();
+    for(uint32_t i = 0; i < CRC_TEST_BENCH_ROUNDS; i++) {
+        sink ^= crc_test_crc16_ccitt_reflected_reference(i, buffer, CRC_TEST_BUFFER_SIZE);
+    }
+    uint32_t crc16_bitwise = furi_get_tick() - start;
+
+    start = furi_get_tick();
+    for(uint32_t i = 0; i < CRC_TEST_BENCH_ROUNDS; i++) {
+        sink ^= crc16_ccitt_reflected_update(i, buffer, CRC_TEST_BUFFER_SIZE);
+    }
+    uint32_t crc16_sliced = furi_get_tick() - start;
+    UNUSED(sink);
+
+    FURI_LOG_I(
+        TAG,
+        "CRC32 bytes/s: bitwise %lu, slicing-by-8 %lu",
+        crc_test_bytes_per_second(crc32_bitwise),
+        crc_test_bytes_per_second(crc32_sliced));
+    FURI_LOG_I(
+        TAG,
+        "CRC16 bytes/s: bitwise %lu, slicing-by-4 %lu",
+        crc_test_bytes_per_second(crc16_bitwise),
+        crc_test_bytes_per_second(crc16_sliced));
+
+    mu_assert(crc32_sliced <= crc32_bitwise, "Sliced CRC32 is slower than bitwise");
+    mu_assert(crc16_sliced <= crc16_bitwise, "Sliced CRC16 is slower than bitwise");
+
+    free(buffer);
+}
+
+MU_TEST_SUITE(test_crc_suite) {
+    MU_RUN_TEST(crc_test_check_values);
+    MU_RUN_TEST(crc_test_random_buffers);
+    MU_RUN_TEST(crc_test_benchmark);
+}
+
+int run_minunit_test_crc(void) {
+    MU_RUN_SUITE(test_crc_suite);
+    return MU_EXIT_CODE;
+}
+
+TEST_API_DEFINE(run_minunit_test_crc)
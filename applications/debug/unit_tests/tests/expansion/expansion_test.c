@@ -29,6 +29,18 @@ MU_TEST(test_expansion_encoded_size) {
         frame.content.data.size = i;
         mu_assert_int_eq(i + 2, expansion_frame_get_encoded_size(&frame));
     }
+
+    frame.header.type = ExpansionFrameTypeStreamConfig;
+    mu_assert_int_eq(4, expansion_frame_get_encoded_size(&frame));
+
+    frame.header.type = ExpansionFrameTypeStreamData;
+    for(size_t i = 0; i <= EXPANSION_PROTOCOL_STREAM_MAX_DATA_SIZE; ++i) {
+        frame.content.stream_data.size = i;
+        mu_assert_int_eq(i + 4, expansion_frame_get_encoded_size(&frame));
+    }
+
+    frame.header.type = ExpansionFrameTypeStreamAck;
+    mu_assert_int_eq(2, expansion_frame_get_encoded_size(&frame));
 }
 
 MU_TEST(test_expansion_remaining_size) {
@@ -90,6 +102,33 @@ MU_TEST(test_expansion_remaining_size) {
     }
     mu_check(expansion_frame_get_remaining_size(&frame, 100, &remaining_size));
     mu_assert_int_eq(0, remaining_size);
+    frame.content.data.size = EXPANSION_PROTOCOL_MAX_DATA_SIZE + 1;
+    mu_check(!expansion_frame_get_remaining_size(&frame, 2, &remaining_size));
+
+    frame.header.type = ExpansionFrameTypeStreamConfig;
+    mu_check(expansion_frame_get_remaining_size(&frame, 1, &remaining_size));
+    mu_assert_int_eq(3, remaining_size);
+    mu_check(expansion_frame_get_remaining_size(&frame, 4, &remaining_size));
+    mu_assert_int_eq(0, remaining_size);
+
+    frame.header.type = ExpansionFrameTypeStreamData;
+    frame.content.stream_data.size = EXPANSION_PROTOCOL_STREAM_MAX_DATA_SIZE;
+    mu_check(expansion_frame_get_remaining_size(&frame, 1, &remaining_size));
+    mu_assert_int_eq(3, remaining_size);
+    mu_check(expansion_frame_get_remaining_size(&frame, 3, &remaining_size));
+    mu_assert_int_eq(1, remaining_size);
+    for(size_t i = 0; i <= EXPANSION_PROTOCOL_STREAM_MAX_DATA_SIZE; ++i) {
+        mu_check(expansion_frame_get_remaining_size(&frame, i + 4, &remaining_size));
+        mu_assert_int_eq(EXPANSION_PROTOCOL_STREAM_MAX_DATA_SIZE - i, remaining_size);
+    }
+    frame.content.stream_data.size = EXPANSION_PROTOCOL_STREAM_MAX_DATA_SIZE + 1;
+    mu_check(!expansion_frame_get_remaining_size(&frame, 4, &remaining_size));
+
+    frame.header.type = ExpansionFrameTypeStreamAck;
+    mu_check(expansion_frame_get_remaining_size(&frame, 1, &remaining_size));
+    mu_assert_int_eq(1, remaining_size);
+    mu_check(expansion_frame_get_remaining_size(&frame, 2, &remaining_size));
+    mu_assert_int_eq(0, remaining_size);
 }
 
 typedef struct {
@@ -170,6 +209,63 @@ MU_TEST(test_expansion_encode_decode_frame) {
     mu_assert_mem_eq(&frame_in, &frame_out, encoded_size);
 }
 
+MU_TEST(test_expansion_encode_decode_stream_frames) {
+    ExpansionFrame frame_in = {
+        .header.type = ExpansionFrameTypeStreamData,
+        .content.stream_data.seq = 0xff,
+        .content.stream_data.size = EXPANSION_PROTOCOL_STREAM_MAX_DATA_SIZE,
+    };
+
+    furi_hal_random_fill_buf(
+        frame_in.content.stream_data.bytes, sizeof(frame_in.content.stream_data.bytes));
+
+    // Stream data frame followed by an acknowledgement, as they would appear on the line
+    uint8_t encoded_data[2 * (sizeof(ExpansionFrame) + sizeof(ExpansionFrameChecksum))];
+    memset(encoded_data, 0, sizeof(encoded_data));
+
+    TestExpansionSendStream send_stream = {
+        .data_out = &encoded_data,
+        .size_available = sizeof(encoded_data),
+        .size_sent = 0,
+    };
+
+    const size_t encoded_size = expansion_frame_get_encoded_size(&frame_in);
+
+    mu_assert_int_eq(
+        expansion_protocol_encode(&frame_in, test_expansion_send_callback, &send_stream),
+        ExpansionProtocolStatusOk);
+
+    const ExpansionFrame ack_in = {
+        .header.type = ExpansionFrameTypeStreamAck,
+        .content.stream_ack.seq = 0xff,
+    };
+
+    mu_assert_int_eq(
+        expansion_protocol_encode(&ack_in, test_expansion_send_callback, &send_stream),
+        ExpansionProtocolStatusOk);
+
+    TestExpansionReceiveStream stream = {
+        .data_in = encoded_data,
+        .size_available = send_stream.size_sent,
+        .size_received = 0,
+    };
+
+    ExpansionFrame frame_out;
+
+    mu_assert_int_eq(
+        expansion_protocol_decode(&frame_out, test_expansion_receive_callback, &stream),
+        ExpansionProtocolStatusOk);
+    mu_assert_int_eq(encoded_size + sizeof(ExpansionFrameChecksum), stream.size_received);
+    mu_assert_mem_eq(&frame_in, &frame_out, encoded_size);
+
+    mu_assert_int_eq(
+        expansion_protocol_decode(&frame_out, test_expansion_receive_callback, &stream),
+        ExpansionProtocolStatusOk);
+    mu_assert_int_eq(send_stream.size_sent, stream.size_received);
+    mu_assert_int_eq(ExpansionFrameTypeStreamAck, frame_out.header.type);
+    mu_assert_int_eq(0xff, frame_out.content.stream_ack.seq);
+}
+
 MU_TEST(test_expansion_garbage_input) {
     uint8_t garbage_data[EXPANSION_TEST_GARBAGE_BUF_SIZE];
     for(uint32_t i = 0; i < EXPANSION_TEST_GARBAGE_ITERATIONS; ++i) {
@@ -191,6 +287,7 @@ MU_TEST_SUITE(test_expansion_suite) {
     MU_RUN_TEST(test_expansion_encoded_size);
     MU_RUN_TEST(test_expansion_remaining_size);
     MU_RUN_TEST(test_expansion_encode_decode_frame);
+    MU_RUN_TEST(test_expansion_encode_decode_stream_frames);
     MU_RUN_TEST(test_expansion_garbage_input);
 }
 
@@ -2,12 +2,27 @@
 #include <flipper_format.h>
 #include <infrared.h>
 #include <common/infrared_common_i.h>
+#include <infrared/signal/infrared_remote.h>
+#include <storage/storage.h>
 #include "../test.h" // IWYU pragma: keep
 
+#define TAG "InfraredTest"
+
 #define IR_TEST_FILES_DIR   EXT_PATH("unit_tests/infrared/")
 #define IR_TEST_FILE_PREFIX "test_"
 #define IR_TEST_FILE_SUFFIX ".irtest"
 
+#define IR_TEST_REMOTE_DIR             EXT_PATH(".tmp/unit_tests/infrared")
+#define IR_TEST_REMOTE_PATH            IR_TEST_REMOTE_DIR "/remote.ir"
+#define IR_TEST_REMOTE_BACKUP_PATH     IR_TEST_REMOTE_DIR "/backup.ir"
+#define IR_TEST_REMOTE_COMPACTED_PATH  IR_TEST_REMOTE_DIR "/compacted.ir"
+#define IR_TEST_REMOTE_JOURNAL_SUFFIX  ".journal"
+#define IR_TEST_REMOTE_SIGNAL_COUNT    (16U)
+#define IR_TEST_REMOTE_SIGNAL_MAX      (32U)
+#define IR_TEST_REMOTE_NAME_SIZE       (24U)
+#define IR_TEST_BENCHMARK_SIGNAL_COUNT (500U)
+#define IR_TEST_BENCHMARK_EDIT_COUNT   (100U)
+
 typedef struct {
     InfraredDecoderHandler* decoder_handler;
     InfraredEncoderHandler* encoder_handler;
@@ -523,6 +538,383 @@ MU_TEST(infrared_test_encoder_decoder_all) {
     infrared_test_run_encoder_decoder(InfraredProtocolPioneer, 1);
 }
 
+/* Expected remote contents, every edit is applied to both the model and the remote */
+typedef struct {
+    size_t count;
+    uint32_t commands[IR_TEST_REMOTE_SIGNAL_MAX];
+    char names[IR_TEST_REMOTE_SIGNAL_MAX][IR_TEST_REMOTE_NAME_SIZE];
+} InfraredTestRemoteModel;
+
+static void infrared_test_remote_set_message(InfraredSignal* signal, uint32_t command) {
+    const InfraredMessage message = {
+        .protocol = InfraredProtocolNECext,
+        .address = 0x10,
+        .command = command,
+    };
+    infrared_signal_set_message(signal, &message);
+}
+
+static void infrared_test_remote_insert(
+    InfraredRemote* remote,
+    InfraredTestRemoteModel* model,
+    size_t index,
+    uint32_t command) {
+    furi_check(model->count < IR_TEST_REMOTE_SIGNAL_MAX);
+
+    InfraredSignal* signal = infrared_signal_alloc();
+    infrared_test_remote_set_message(signal, command);
+
+    memmove(
+        &model->commands[index + 1],
+        &model->commands[index],
+        (model->count - index) * sizeof(model->commands[0]));
+    memmove(
+        model->names[index + 1],
+        model->names[index],
+        (model->count - index) * sizeof(model->names[0]));
+    model->commands[index] = command;
+    snprintf(model->names[index], IR_TEST_REMOTE_NAME_SIZE, "Signal_%lu", command);
+    model->count++;
+
+    const InfraredErrorCode error =
+        infrared_remote_insert_signal(remote, signal, model->names[index], index);
+    infrared_signal_free(signal);
+
+    mu_assert(!INFRARED_ERROR_PRESENT(error), "Failed to insert signal");
+}
+
+static void infrared_test_remote_rename(
+    InfraredRemote* remote,
+    InfraredTestRemoteModel* model,
+    size_t index) {
+    snprintf(
+        model->names[index], IR_TEST_REMOTE_NAME_SIZE, "Renamed_%lu", model->commands[index]);
+    mu_assert(
+        !INFRARED_ERROR_PRESENT(infrared_remote_rename_signal(remote, index, model->names[index])),
+        "Failed to rename signal");
+}
+
+static void infrared_test_remote_move(
+    InfraredRemote* remote,
+    InfraredTestRemoteModel* model,
+    size_t index,
+    size_t new_index) {
+    const uint32_t command = model->commands[index];
+    char name[IR_TEST_REMOTE_NAME_SIZE];
+    memcpy(name, model->names[index], sizeof(name));
+
+    // Take the signal out and put it back at its new place
+    memmove(
+        &model->commands[index],
+        &model->commands[index + 1],
+        (model->count - index - 1) * sizeof(model->commands[0]));
+    memmove(
+        model->names[index],
+        model->names[index + 1],
+        (model->count - index - 1) * sizeof(model->names[0]));
+    memmove(
+        &model->commands[new_index + 1],
+        &model->commands[new_index],
+        (model->count - new_index - 1) * sizeof(model->commands[0]));
+    memmove(
+        model->names[new_index + 1],
+        model->names[new_index],
+        (model->count - new_index - 1) * sizeof(model->names[0]));
+    model->commands[new_index] = command;
+    memcpy(model->names[new_index], name, sizeof(name));
+
+    mu_assert(
+        !INFRARED_ERROR_PRESENT(infrared_remote_move_signal(remote, index, new_index)),
+        "Failed to move signal");
+}
+
+static void infrared_test_remote_delete(
+    InfraredRemote* remote,
+    InfraredTestRemoteModel* model,
+    size_t index) {
+    memmove(
+        &model->commands[index],
+        &model->commands[index + 1],
+        (model->count - index - 1) * sizeof(model->commands[0]));
+    memmove(
+        model->names[index],
+        model->names[index + 1],
+        (model->count - index - 1) * sizeof(model->names[0]));
+    model->count--;
+
+    mu_assert(
+        !INFRARED_ERROR_PRESENT(infrared_remote_delete_signal(remote, index)),
+        "Failed to delete signal");
+}
+
+static void infrared_test_remote_check(
+    const InfraredRemote* remote,
+    const InfraredTestRemoteModel* model) {
+    mu_assert_int_eq(model->count, infrared_remote_get_signal_count(remote));
+
+    InfraredSignal* signal = infrared_signal_alloc();
+
+    for(size_t i = 0; i < model->count; ++i) {
+        mu_assert_string_eq(model->names[i], infrared_remote_get_signal_name(remote, i));
+        mu_assert(
+            !INFRARED_ERROR_PRESENT(infrared_remote_load_signal(remote, signal, i)),
+            "Failed to load signal");
+        mu_assert(!infrared_signal_is_raw(signal), "Signal must be parsed");
+        mu_assert_int_eq(model->commands[i], infrared_signal_get_message(signal)->command);
+    }
+
+    infrared_signal_free(signal);
+}
+
+static bool infrared_test_remote_journal_exists(Storage* storage, const char* path) {
+    FuriString* journal_path = furi_string_alloc_printf("%s" IR_TEST_REMOTE_JOURNAL_SUFFIX, path);
+    const bool exists = storage_file_exists(storage, furi_string_get_cstr(journal_path));
+    furi_string_free(journal_path);
+    return exists;
+}
+
+static void infrared_test_remote_copy(
+    Storage* storage,
+    const char* path_from,
+    const char* path_to,
+    bool with_journal) {
+    FuriString* journal_from =
+        furi_string_alloc_printf("%s" IR_TEST_REMOTE_JOURNAL_SUFFIX, path_from);
+    FuriString* journal_to = furi_string_alloc_printf("%s" IR_TEST_REMOTE_JOURNAL_SUFFIX, path_to);
+
+    storage_simply_remove(storage, path_to);
+    storage_simply_remove(storage, furi_string_get_cstr(journal_to));
+
+    const bool success =
+        storage_common_copy(storage, path_from, path_to) == FSE_OK &&
+        (!with_journal || storage_common_copy(
+                              storage,
+                              furi_string_get_cstr(journal_from),
+                              furi_string_get_cstr(journal_to)) == FSE_OK);
+
+    furi_string_free(journal_to);
+    furi_string_free(journal_from);
+
+    mu_assert(success, "Failed to copy remote");
+}
+
+/* Create a remote with a journal full of pending edits of all kinds */
+static void
+    infrared_test_remote_prepare(InfraredRemote* remote, InfraredTestRemoteModel* model) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    storage_simply_remove_recursive(storage, IR_TEST_REMOTE_DIR);
+    storage_simply_mkdir(storage, IR_TEST_REMOTE_DIR);
+    furi_record_close(RECORD_STORAGE);
+
+    mu_assert(
+        !INFRARED_ERROR_PRESENT(infrared_remote_create(remote, IR_TEST_REMOTE_PATH)),
+        "Failed to create remote");
+
+    model->count = 0;
+    for(uint32_t i = 0; i < IR_TEST_REMOTE_SIGNAL_COUNT; ++i) {
+        infrared_test_remote_insert(remote, model, model->count, i);
+    }
+
+    infrared_test_remote_insert(remote, model, 3, 100);
+    infrared_test_remote_insert(remote, model, 0, 101);
+    infrared_test_remote_rename(remote, model, 5);
+    infrared_test_remote_move(remote, model, 0, 10);
+    infrared_test_remote_delete(remote, model, 7);
+    infrared_test_remote_move(remote, model, 12, 2);
+    infrared_test_remote_insert(remote, model, model->count, 102);
+    infrared_test_remote_rename(remote, model, 0);
+    infrared_test_remote_delete(remote, model, 0);
+    infrared_test_remote_rename(remote, model, model->count - 1);
+}
+
+MU_TEST(infrared_test_remote_edit) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    InfraredTestRemoteModel* model = malloc(sizeof(InfraredTestRemoteModel));
+
+    InfraredRemote* remote = infrared_remote_alloc();
+    infrared_test_remote_prepare(remote, model);
+    infrared_test_remote_check(remote, model);
+    mu_assert(
+        infrared_test_remote_journal_exists(storage, IR_TEST_REMOTE_PATH),
+        "Edits must be journaled");
+
+    // Compaction writes everything out and removes the journal
+    infrared_remote_free(remote);
+    mu_assert(
+        !infrared_test_remote_journal_exists(storage, IR_TEST_REMOTE_PATH),
+        "Journal must be removed on compaction");
+
+    remote = infrared_remote_alloc();
+    mu_assert(
+        !INFRARED_ERROR_PRESENT(infrared_remote_load(remote, IR_TEST_REMOTE_PATH)),
+        "Failed to load remote");
+    infrared_test_remote_check(remote, model);
+    infrared_remote_free(remote);
+
+    free(model);
+    storage_simply_remove_recursive(storage, IR_TEST_REMOTE_DIR);
+    furi_record_close(RECORD_STORAGE);
+}
+
+MU_TEST(infrared_test_remote_journal) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    InfraredTestRemoteModel* model = malloc(sizeof(InfraredTestRemoteModel));
+
+    // Keep the state of a session that ended before compaction
+    InfraredRemote* remote = infrared_remote_alloc();
+    infrared_test_remote_prepare(remote, model);
+    infrared_test_remote_copy(storage, IR_TEST_REMOTE_PATH, IR_TEST_REMOTE_BACKUP_PATH, true);
+    infrared_remote_free(remote);
+    infrared_test_remote_copy(storage, IR_TEST_REMOTE_PATH, IR_TEST_REMOTE_COMPACTED_PATH, false);
+
+    // Journal left behind is replayed and compacted on load
+    infrared_test_remote_copy(storage, IR_TEST_REMOTE_BACKUP_PATH, IR_TEST_REMOTE_PATH, true);
+    remote = infrared_remote_alloc();
+    mu_assert(
+        !INFRARED_ERROR_PRESENT(infrared_remote_load(remote, IR_TEST_REMOTE_PATH)),
+        "Failed to load remote");
+    infrared_test_remote_check(remote, model);
+    mu_assert(
+        !infrared_test_remote_journal_exists(storage, IR_TEST_REMOTE_PATH),
+        "Journal must be removed after replay");
+    infrared_remote_free(remote);
+
+    // Journal next to an already compacted file must not be applied twice
+    infrared_test_remote_copy(storage, IR_TEST_REMOTE_COMPACTED_PATH, IR_TEST_REMOTE_PATH, false);
+    mu_assert(
+        storage_common_copy(
+            storage,
+            IR_TEST_REMOTE_BACKUP_PATH IR_TEST_REMOTE_JOURNAL_SUFFIX,
+            IR_TEST_REMOTE_PATH IR_TEST_REMOTE_JOURNAL_SUFFIX) == FSE_OK,
+        "Failed to copy journal");
+    remote = infrared_remote_alloc();
+    mu_assert(
+        !INFRARED_ERROR_PRESENT(infrared_remote_load(remote, IR_TEST_REMOTE_PATH)),
+        "Failed to load remote");
+    infrared_test_remote_check(remote, model);
+    mu_assert(
+        !infrared_test_remote_journal_exists(storage, IR_TEST_REMOTE_PATH),
+        "Stale journal must be discarded");
+    infrared_remote_free(remote);
+
+    // Same for a remote file changed outside of the app, even if its size stays the same
+    infrared_test_remote_copy(storage, IR_TEST_REMOTE_BACKUP_PATH, IR_TEST_REMOTE_PATH, true);
+    File* file = storage_file_alloc(storage);
+    mu_assert(
+        storage_file_open(file, IR_TEST_REMOTE_PATH, FSAM_READ_WRITE, FSOM_OPEN_EXISTING),
+        "Failed to open remote");
+    const size_t file_size = storage_file_size(file);
+    char* file_data = malloc(file_size + 1);
+    mu_assert_int_eq(file_size, storage_file_read(file, file_data, file_size));
+    char* signal_name = strstr(file_data, "Signal_1\n");
+    mu_assert(signal_name, "Signal not found");
+    signal_name[strlen("Signal_")] = 'Z';
+    mu_assert(storage_file_seek(file, 0, true), "Failed to seek remote");
+    mu_assert_int_eq(file_size, storage_file_write(file, file_data, file_size));
+    free(file_data);
+    storage_file_free(file);
+
+    remote = infrared_remote_alloc();
+    mu_assert(
+        !INFRARED_ERROR_PRESENT(infrared_remote_load(remote, IR_TEST_REMOTE_PATH)),
+        "Failed to load remote");
+    mu_assert(
+        !infrared_test_remote_journal_exists(storage, IR_TEST_REMOTE_PATH),
+        "Foreign journal must be discarded");
+    // Signals are taken as they are in the file, appended ones included
+    mu_assert_int_eq(IR_TEST_REMOTE_SIGNAL_COUNT + 3, infrared_remote_get_signal_count(remote));
+    mu_assert_string_eq("Signal_Z", infrared_remote_get_signal_name(remote, 1));
+    infrared_remote_free(remote);
+
+    free(model);
+    storage_simply_remove_recursive(storage, IR_TEST_REMOTE_DIR);
+    furi_record_close(RECORD_STORAGE);
+}
+
+static void
+    infrared_test_remote_benchmark_report(const char* name, uint32_t start, uint32_t count) {
+    const uint32_t time_ms = furi_get_tick() - start;
+    FURI_LOG_I(TAG, "%-8s %6lu ms total, %6lu us each", name, time_ms, time_ms * 1000 / count);
+}
+
+MU_TEST(infrared_test_remote_benchmark) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    storage_simply_remove_recursive(storage, IR_TEST_REMOTE_DIR);
+    storage_simply_mkdir(storage, IR_TEST_REMOTE_DIR);
+
+    InfraredRemote* remote = infrared_remote_alloc();
+    InfraredSignal* signal = infrared_signal_alloc();
+    FuriString* signal_name = furi_string_alloc();
+
+    InfraredErrorCode error = infrared_remote_create(remote, IR_TEST_REMOTE_PATH);
+    mu_assert(!INFRARED_ERROR_PRESENT(error), "Failed to create remote");
+
+    uint32_t start = furi_get_tick();
+    for(uint32_t i = 0; i < IR_TEST_BENCHMARK_SIGNAL_COUNT; ++i) {
+        infrared_test_remote_set_message(signal, i);
+        furi_string_printf(signal_name, "Signal_%lu", i);
+        error = infrared_remote_append_signal(remote, signal, furi_string_get_cstr(signal_name));
+        mu_assert(!INFRARED_ERROR_PRESENT(error), "Failed to append signal");
+    }
+    infrared_test_remote_benchmark_report("Append", start, IR_TEST_BENCHMARK_SIGNAL_COUNT);
+
+    start = furi_get_tick();
+    for(uint32_t i = 0; i < IR_TEST_BENCHMARK_EDIT_COUNT; ++i) {
+        infrared_test_remote_set_message(signal, IR_TEST_BENCHMARK_SIGNAL_COUNT + i);
+        furi_string_printf(signal_name, "Inserted_%lu", i);
+        const size_t index = rand() % infrared_remote_get_signal_count(remote);
+        error = infrared_remote_insert_signal(
+            remote, signal, furi_string_get_cstr(signal_name), index);
+        mu_assert(!INFRARED_ERROR_PRESENT(error), "Failed to insert signal");
+    }
+    infrared_test_remote_benchmark_report("Insert", start, IR_TEST_BENCHMARK_EDIT_COUNT);
+
+    start = furi_get_tick();
+    for(uint32_t i = 0; i < IR_TEST_BENCHMARK_EDIT_COUNT; ++i) {
+        furi_string_printf(signal_name, "Renamed_%lu", i);
+        const size_t index = rand() % infrared_remote_get_signal_count(remote);
+        error = infrared_remote_rename_signal(remote, index, furi_string_get_cstr(signal_name));
+        mu_assert(!INFRARED_ERROR_PRESENT(error), "Failed to rename signal");
+    }
+    infrared_test_remote_benchmark_report("Rename", start, IR_TEST_BENCHMARK_EDIT_COUNT);
+
+    start = furi_get_tick();
+    for(uint32_t i = 0; i < IR_TEST_BENCHMARK_EDIT_COUNT; ++i) {
+        const size_t count = infrared_remote_get_signal_count(remote);
+        error = infrared_remote_move_signal(remote, rand() % count, rand() % count);
+        mu_assert(!INFRARED_ERROR_PRESENT(error), "Failed to move signal");
+    }
+    infrared_test_remote_benchmark_report("Move", start, IR_TEST_BENCHMARK_EDIT_COUNT);
+
+    start = furi_get_tick();
+    for(uint32_t i = 0; i < IR_TEST_BENCHMARK_EDIT_COUNT; ++i) {
+        const size_t index = rand() % infrared_remote_get_signal_count(remote);
+        error = infrared_remote_delete_signal(remote, index);
+        mu_assert(!INFRARED_ERROR_PRESENT(error), "Failed to delete signal");
+    }
+    infrared_test_remote_benchmark_report("Delete", start, IR_TEST_BENCHMARK_EDIT_COUNT);
+
+    start = furi_get_tick();
+    for(uint32_t i = 0; i < IR_TEST_BENCHMARK_EDIT_COUNT; ++i) {
+        const size_t index = rand() % infrared_remote_get_signal_count(remote);
+        error = infrared_remote_load_signal(remote, signal, index);
+        mu_assert(!INFRARED_ERROR_PRESENT(error), "Failed to load signal");
+    }
+    infrared_test_remote_benchmark_report("Load", start, IR_TEST_BENCHMARK_EDIT_COUNT);
+
+    start = furi_get_tick();
+    error = infrared_remote_compact(remote);
+    mu_assert(!INFRARED_ERROR_PRESENT(error), "Failed to compact remote");
+    infrared_test_remote_benchmark_report("Compact", start, 1);
+
+    furi_string_free(signal_name);
+    infrared_signal_free(signal);
+    infrared_remote_free(remote);
+
+    storage_simply_remove_recursive(storage, IR_TEST_REMOTE_DIR);
+    furi_record_close(RECORD_STORAGE);
+}
+
 MU_TEST_SUITE(infrared_test) {
     MU_SUITE_CONFIGURE(&infrared_test_alloc, &infrared_test_free);
 
@@ -543,6 +935,9 @@ MU_TEST_SUITE(infrared_test) {
     MU_RUN_TEST(infrared_test_decoder_pioneer);
     MU_RUN_TEST(infrared_test_decoder_mixed);
     MU_RUN_TEST(infrared_test_encoder_decoder_all);
+    MU_RUN_TEST(infrared_test_remote_edit);
+    MU_RUN_TEST(infrared_test_remote_journal);
+    MU_RUN_TEST(infrared_test_remote_benchmark);
 }
 
 int run_minunit_test_infrared(void) {
@@ -0,0 +1,353 @@
+#include <furi.h>
+#include <furi_hal_cortex.h>
+#include <storage/storage.h>
+#include <toolbox/crc.h>
+#include <mjs_core_public.h>
+#include <mjs_exec_public.h>
+#include <mjs_primitive_public.h>
+#include <mjs_gc_public.h>
+#include "../test.h" // IWYU pragma: keep
+
+#define TAG "JsTest"
+
+#define JS_TEST_DIR         EXT_PATH(".tmp/unit_tests/js")
+#define JS_TEST_SCRIPT_PATH JS_TEST_DIR "/test.js"
+#define JS_TEST_CACHE_DIR   JS_TEST_DIR "/cache"
+#define JS_TEST_SCRIPTS_DIR EXT_PATH("apps/Scripts")
+#define JS_TEST_BUILD_ID    (0x12345678UL)
+
+static const char* js_test_source_a = "let a = 20;\n"
+                                      "function twice(x) { return x * 2; }\n"
+                                      "twice(a) + 2;\n";
+static const char* js_test_source_b = "let a = 20;\n"
+                                      "function twice(x) { return x * 2; }\n"
+                                      "twice(a) + 3;\n";
+
+// Builds strings and short-lived objects in a loop, keeping some of them alive
+static const char* js_test_source_gc =
+    "let total = 0;\n"
+    "let keep = [];\n"
+    "for (let i = 0; i < 3000; i++) {\n"
+    "  let s = 'line ' + chr(65 + i % 26) + ' of text rendering';\n"
+    "  let o = { text: s, n: i, next: { v: i * 2 } };\n"
+    "  if (i % 100 === 0) keep.push(o);\n"
+    "  total = total + o.next.v + s.length;\n"
+    "}\n"
+    "let sum = 0;\n"
+    "for (let j = 0; j < keep.length; j++) sum = sum + keep[j].n;\n"
+    "total + sum;\n";
+
+static void js_test_write_file(const char* path, const void* data, size_t size) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* file = storage_file_alloc(storage);
+    mu_assert(storage_file_open(file, path, FSAM_WRITE, FSOM_CREATE_ALWAYS), "open failed");
+    mu_assert_int_eq(size, storage_file_write(file, data, size));
+    storage_file_free(file);
+    furi_record_close(RECORD_STORAGE);
+}
+
+// Cache files are named after CRC-32 of the script path
+static void js_test_get_cache_path(FuriString* cache_path, const char* path) {
+    furi_string_printf(
+        cache_path,
+        "%s/%08lx.jsc",
+        JS_TEST_CACHE_DIR,
+        crc32_update(UINT32_MAX, path, strlen(path)));
+}
+
+static struct mjs* js_test_create(int generate_jsc, uint32_t build_id) {
+    struct mjs* mjs = mjs_create(NULL);
+    mjs_set_generate_jsc(mjs, generate_jsc);
+    mjs_set_jsc_cache(mjs, JS_TEST_CACHE_DIR, build_id);
+    return mjs;
+}
+
+static int js_test_exec_build(
+    const char* path,
+    int generate_jsc,
+    uint32_t build_id,
+    mjs_err_t* error) {
+    struct mjs* mjs = js_test_create(generate_jsc, build_id);
+    mjs_val_t res = MJS_UNDEFINED;
+    *error = mjs_exec_file(mjs, path, &res);
+    int value = mjs_is_number(res) ? mjs_get_int(mjs, res) : -1;
+    mjs_destroy(mjs);
+    return value;
+}
+
+static int js_test_exec(const char* path, int generate_jsc, mjs_err_t* error) {
+    return js_test_exec_build(path, generate_jsc, JS_TEST_BUILD_ID, error);
+}
+
+static bool js_test_read_file(const char* path, uint8_t* data, size_t size) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* file = storage_file_alloc(storage);
+    bool success = storage_file_open(file, path, FSAM_READ, FSOM_OPEN_EXISTING) &&
+                   storage_file_read(file, data, size) == size;
+    storage_file_free(file);
+    furi_record_close(RECORD_STORAGE);
+    return success;
+}
+
+static void js_test_setup(void) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    storage_simply_remove_recursive(storage, JS_TEST_DIR);
+    storage_simply_mkdir(storage, EXT_PATH(".tmp"));
+    storage_simply_mkdir(storage, EXT_PATH(".tmp/unit_tests"));
+    storage_simply_mkdir(storage, JS_TEST_DIR);
+    furi_record_close(RECORD_STORAGE);
+}
+
+static void js_test_teardown(void) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    storage_simply_remove_recursive(storage, JS_TEST_DIR);
+    furi_record_close(RECORD_STORAGE);
+}
+
+MU_TEST(js_jsc_cache_test) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FuriString* cache_path_str = furi_string_alloc();
+    js_test_get_cache_path(cache_path_str, JS_TEST_SCRIPT_PATH);
+    const char* cache_path = furi_string_get_cstr(cache_path_str);
+    mjs_err_t error;
+
+    // Cache is not written unless enabled
+    js_test_write_file(JS_TEST_SCRIPT_PATH, js_test_source_a, strlen(js_test_source_a));
+    mu_assert_int_eq(42, js_test_exec(JS_TEST_SCRIPT_PATH, 0, &error));
+    mu_assert_int_eq(MJS_OK, error);
+    mu_assert(!storage_file_exists(storage, cache_path), "unexpected .jsc");
+
+    // Nothing is written without cache directory
+    struct mjs* mjs = mjs_create(NULL);
+    mjs_set_generate_jsc(mjs, 1);
+    mu_assert_int_eq(MJS_OK, mjs_exec_file(mjs, JS_TEST_SCRIPT_PATH, NULL));
+    mjs_destroy(mjs);
+    mu_assert(!storage_file_exists(storage, cache_path), "unexpected .jsc");
+    mu_assert(!storage_file_exists(storage, JS_TEST_SCRIPT_PATH "c"), ".jsc next to script");
+
+    // First run writes cache, second run and .jsc itself give the same result
+    mu_assert_int_eq(42, js_test_exec(JS_TEST_SCRIPT_PATH, 1, &error));
+    mu_assert_int_eq(MJS_OK, error);
+    mu_assert(storage_file_exists(storage, cache_path), ".jsc not written");
+    mu_assert_int_eq(42, js_test_exec(JS_TEST_SCRIPT_PATH, 1, &error));
+    mu_assert_int_eq(MJS_OK, error);
+    mu_assert_int_eq(42, js_test_exec(cache_path, 0, &error));
+    mu_assert_int_eq(MJS_OK, error);
+
+    // Changed source of the same size invalidates cache
+    js_test_write_file(JS_TEST_SCRIPT_PATH, js_test_source_b, strlen(js_test_source_b));
+    mu_assert_int_eq(43, js_test_exec(JS_TEST_SCRIPT_PATH, 1, &error));
+    mu_assert_int_eq(MJS_OK, error);
+    mu_assert_int_eq(43, js_test_exec(cache_path, 0, &error));
+
+    // Corrupted cache falls back to parsing and gets rewritten
+    FileInfo info;
+    mu_assert_int_eq(FSE_OK, storage_common_stat(storage, cache_path, &info));
+    File* file = storage_file_alloc(storage);
+    mu_assert(
+        storage_file_open(file, cache_path, FSAM_READ_WRITE, FSOM_OPEN_EXISTING),
+        "open failed");
+    uint8_t byte;
+    storage_file_seek(file, info.size - 1, true);
+    mu_assert_int_eq(1, storage_file_read(file, &byte, 1));
+    byte = ~byte;
+    storage_file_seek(file, info.size - 1, true);
+    mu_assert_int_eq(1, storage_file_write(file, &byte, 1));
+    storage_file_free(file);
+    js_test_exec(cache_path, 0, &error);
+    mu_assert_int_eq(MJS_FILE_READ_ERROR, error);
+    mu_assert_int_eq(43, js_test_exec(JS_TEST_SCRIPT_PATH, 1, &error));
+    mu_assert_int_eq(MJS_OK, error);
+    mu_assert_int_eq(43, js_test_exec(cache_path, 0, &error));
+
+    // Cache of another build is neither executed nor loaded, it is rewritten
+    uint8_t header[12], header_other[12];
+    mu_assert(js_test_read_file(cache_path, header, sizeof(header)), "read failed");
+    js_test_exec_build(cache_path, 0, JS_TEST_BUILD_ID + 1, &error);
+    mu_assert_int_eq(MJS_FILE_READ_ERROR, error);
+    mu_assert_int_eq(43, js_test_exec_build(JS_TEST_SCRIPT_PATH, 1, JS_TEST_BUILD_ID + 1, &error));
+    mu_assert_int_eq(MJS_OK, error);
+    mu_assert(js_test_read_file(cache_path, header_other, sizeof(header)), "read failed");
+    mu_assert(memcmp(header, header_other, sizeof(header)) != 0, "cache not rewritten");
+
+    furi_string_free(cache_path_str);
+    furi_record_close(RECORD_STORAGE);
+}
+
+MU_TEST(js_compile_file_test) {
+    js_test_write_file(JS_TEST_SCRIPT_PATH, js_test_source_a, strlen(js_test_source_a));
+
+    struct mjs* mjs = mjs_create(NULL);
+    mu_assert_int_eq(MJS_OK, mjs_compile_file(mjs, JS_TEST_SCRIPT_PATH));
+    mjs_destroy(mjs);
+
+    const char* broken = "let a = ;";
+    js_test_write_file(JS_TEST_SCRIPT_PATH, broken, strlen(broken));
+    mjs = js_test_create(1, JS_TEST_BUILD_ID);
+    mu_assert(mjs_compile_file(mjs, JS_TEST_SCRIPT_PATH) != MJS_OK, "broken script compiled");
+    mjs_destroy(mjs);
+
+    FuriString* cache_path = furi_string_alloc();
+    js_test_get_cache_path(cache_path, JS_TEST_SCRIPT_PATH);
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    mu_assert(
+        !storage_file_exists(storage, furi_string_get_cstr(cache_path)),
+        ".jsc for broken script");
+    furi_record_close(RECORD_STORAGE);
+    furi_string_free(cache_path);
+}
+
+static uint32_t js_test_compile_ticks(
+    const char* path,
+    int generate_jsc,
+    size_t* heap_used,
+    mjs_err_t* error) {
+    size_t heap_before = memmgr_get_free_heap();
+    uint32_t start = furi_get_tick();
+    struct mjs* mjs = js_test_create(generate_jsc, JS_TEST_BUILD_ID);
+    *error = mjs_compile_file(mjs, path);
+    uint32_t ticks = furi_get_tick() - start;
+    *heap_used = heap_before - memmgr_get_free_heap();
+    mjs_destroy(mjs);
+    return ticks;
+}
+
+MU_TEST(js_jsc_benchmark_test) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* dir = storage_file_alloc(storage);
+    FuriString* source_path = furi_string_alloc();
+    FuriString* test_path = furi_string_alloc();
+    FuriString* cache_path = furi_string_alloc();
+    char name[128];
+    FileInfo info;
+
+    // Scripts are shipped with js_app, test is skipped if they are not installed
+    if(storage_dir_open(dir, JS_TEST_SCRIPTS_DIR)) {
+        while(storage_dir_read(dir, &info, name, sizeof(name))) {
+            size_t len = strlen(name);
+            if(file_info_is_dir(&info) || len < 3 || strcmp(name + len - 3, ".js") != 0) {
+                continue;
+            }
+
+            furi_string_printf(source_path, "%s/%s", JS_TEST_SCRIPTS_DIR, name);
+            furi_string_printf(test_path, "%s/%s", JS_TEST_DIR, name);
+            js_test_get_cache_path(cache_path, furi_string_get_cstr(test_path));
+            mu_assert_int_eq(
+                FSE_OK,
+                storage_common_copy(
+                    storage,
+                    furi_string_get_cstr(source_path),
+                    furi_string_get_cstr(test_path)));
+
+            // Parse without cache, then write cache and load from it
+            size_t parse_heap, load_heap;
+            mjs_err_t error;
+            const char* path = furi_string_get_cstr(test_path);
+            uint32_t parse_ticks = js_test_compile_ticks(path, 0, &parse_heap, &error);
+            mu_assert_int_eq(MJS_OK, error);
+            js_test_compile_ticks(path, 1, &load_heap, &error);
+            mu_assert_int_eq(MJS_OK, error);
+            uint32_t load_ticks = js_test_compile_ticks(path, 1, &load_heap, &error);
+            mu_assert_int_eq(MJS_OK, error);
+
+            FileInfo cache_info;
+            mu_assert_int_eq(
+                FSE_OK,
+                storage_common_stat(storage, furi_string_get_cstr(cache_path), &cache_info));
+            FURI_LOG_I(
+                TAG,
+                "%s: source %lu, jsc %lu bytes; parse %lu ms, %u heap; load %lu ms, %u heap",
+                name,
+                (uint32_t)info.size,
+                (uint32_t)cache_info.size,
+                parse_ticks,
+                parse_heap,
+                load_ticks,
+                load_heap);
+        }
+        storage_dir_close(dir);
+    }
+
+    furi_string_free(cache_path);
+    furi_string_free(test_path);
+    furi_string_free(source_path);
+    storage_file_free(dir);
+    furi_record_close(RECORD_STORAGE);
+}
+
+static uint32_t js_test_gc_clock(void) {
+    return furi_hal_cortex_timer_get(0).start;
+}
+
+static void js_test_gc_run(int incremental) {
+    struct mjs* mjs = mjs_create(NULL);
+    mjs_gc_set_incremental(mjs, incremental);
+    mjs_gc_set_clock(mjs, js_test_gc_clock, furi_hal_cortex_instructions_per_microsecond());
+
+    mjs_val_t res = MJS_UNDEFINED;
+    uint32_t start = furi_get_tick();
+    mjs_err_t error = mjs_exec(mjs, js_test_source_gc, &res);
+    uint32_t ticks = furi_get_tick() - start;
+    mu_assert_int_eq(MJS_OK, error);
+    mu_assert_double_eq(9112500, mjs_get_double(mjs, res));
+
+    mjs_gc_idle(mjs, true);
+    struct mjs_gc_stats stats;
+    mjs_gc_get_stats(mjs, &stats);
+    mu_assert(stats.collections > 0, "no collections");
+    mu_assert(stats.bytes_freed > 0, "nothing freed");
+    mu_assert(stats.pause_total_us > 0, "pauses not timed");
+    mu_assert(stats.pause_max_us >= stats.pause_last_us, "wrong max pause");
+    mu_assert(stats.object_cells_free <= stats.object_cells, "wrong object occupancy");
+    mu_assert(stats.property_cells_free <= stats.property_cells, "wrong property occupancy");
+    mu_assert(stats.strings_used <= stats.strings_size, "wrong strings occupancy");
+    if(incremental) {
+        mu_assert(stats.sweep_steps > 0, "no incremental sweep");
+    } else {
+        mu_assert_int_eq(0, stats.sweep_steps);
+    }
+
+    // Same numbers are available to scripts
+    error = mjs_exec(mjs, "gcStats().collections;", &res);
+    mu_assert_int_eq(MJS_OK, error);
+    mu_assert(mjs_get_int(mjs, res) >= (int)stats.collections, "wrong script stats");
+
+    FURI_LOG_I(
+        TAG,
+        "GC %s: %lu ms, %lu collections, pause max %lu us, total %lu us, "
+        "%lu sweep steps, max %lu us, %lu bytes freed",
+        incremental ? "incremental" : "full",
+        ticks,
+        stats.collections,
+        stats.pause_max_us,
+        stats.pause_total_us,
+        stats.sweep_steps,
+        stats.sweep_max_us,
+        stats.bytes_freed);
+
+    mjs_destroy(mjs);
+}
+
+MU_TEST(js_gc_full_test) {
+    js_test_gc_run(false);
+}
+
+MU_TEST(js_gc_incremental_test) {
+    js_test_gc_run(true);
+}
+
+MU_TEST_SUITE(js) {
+    MU_SUITE_CONFIGURE(&js_test_setup, &js_test_teardown);
+    MU_RUN_TEST(js_jsc_cache_test);
+    MU_RUN_TEST(js_compile_file_test);
+    MU_RUN_TEST(js_jsc_benchmark_test);
+    MU_RUN_TEST(js_gc_full_test);
+    MU_RUN_TEST(js_gc_incremental_test);
+}
+
+int run_minunit_test_js(void) {
+    MU_RUN_SUITE(js);
+    return MU_EXIT_CODE;
+}
+
+TEST_API_DEFINE(run_minunit_test_js)
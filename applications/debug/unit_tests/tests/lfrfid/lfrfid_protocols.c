@@ -3,9 +3,20 @@
 #include <toolbox/protocols/protocol_dict.h>
 #include <lfrfid/protocols/lfrfid_protocols.h>
 #include <toolbox/pulse_protocols/pulse_glue.h>
+#include <lfrfid/lfrfid_waveform.h>
+#include <lfrfid/lfrfid_raw_analyzer.h>
+#include <toolbox/varint.h>
 
 #define LF_RFID_READ_TIMING_MULTIPLIER 8
 
+#define LF_RFID_WAVEFORM_BUFFER_SIZE 1024
+#define LF_RFID_WAVEFORM_CHECK_SIZE  (LF_RFID_WAVEFORM_BUFFER_SIZE * 3)
+
+#define LF_RFID_RAW_TEST_TIME_US     (1000000)
+#define LF_RFID_RAW_TEST_CHUNK       (64)
+#define LF_RFID_RAW_TEST_BUFFER_SIZE (512)
+#define LF_RFID_RAW_TEST_FILE        EXT_PATH(".tmp/unit_tests/lfrfid.raw")
+
 #define EM_TEST_DATA                    {0x58, 0x00, 0x85, 0x64, 0x02}
 #define EM_TEST_DATA_SIZE               5
 #define EM_TEST_EMULATION_TIMINGS_COUNT (64 * 2)
@@ -526,6 +537,206 @@ MU_TEST(test_lfrfid_protocol_fdxb_read_simple) {
     protocol_dict_free(dict);
 }
 
+MU_TEST(test_lfrfid_protocol_waveform_periodic) {
+    ProtocolDict* dict = protocol_dict_alloc(lfrfid_protocols, LFRFIDProtocolMax);
+    uint8_t* data = malloc(protocol_dict_get_max_data_size(dict));
+    uint32_t* duration = malloc(sizeof(uint32_t) * LF_RFID_WAVEFORM_BUFFER_SIZE);
+    uint32_t* pulse = malloc(sizeof(uint32_t) * LF_RFID_WAVEFORM_BUFFER_SIZE);
+    uint32_t* stream_duration = malloc(sizeof(uint32_t) * LF_RFID_WAVEFORM_CHECK_SIZE);
+    uint32_t* stream_pulse = malloc(sizeof(uint32_t) * LF_RFID_WAVEFORM_CHECK_SIZE);
+    size_t periodic_count = 0;
+
+    for(size_t protocol = 0; protocol < LFRFIDProtocolMax; protocol++) {
+        if(protocol_dict_get_features(dict, protocol) & LFRFIDFeatureRTF) continue;
+
+        size_t data_size = protocol_dict_get_data_size(dict, protocol);
+        for(size_t i = 0; i < data_size; i++) {
+            data[i] = i * 37 + 1;
+        }
+        protocol_dict_set_data(dict, protocol, data, data_size);
+
+        size_t length = lfrfid_waveform_render_periodic(
+            dict, protocol, duration, pulse, LF_RFID_WAVEFORM_BUFFER_SIZE);
+        if(!length) continue;
+        periodic_count++;
+
+        // Encoders may keep state between starts, so reference is rendered by a fresh one
+        ProtocolDict* reference = protocol_dict_alloc(lfrfid_protocols, LFRFIDProtocolMax);
+        PulseGlue* pulse_glue = pulse_glue_alloc();
+        protocol_dict_set_data(reference, protocol, data, data_size);
+        mu_check(protocol_dict_encoder_start(reference, protocol));
+        lfrfid_waveform_render(
+            reference,
+            protocol,
+            pulse_glue,
+            stream_duration,
+            stream_pulse,
+            LF_RFID_WAVEFORM_CHECK_SIZE);
+        pulse_glue_free(pulse_glue);
+        protocol_dict_free(reference);
+
+        // Loop starts with the second pulse
+        for(size_t i = 0; i < LF_RFID_WAVEFORM_CHECK_SIZE - 1; i++) {
+            mu_assert_int_eq(stream_duration[i + 1], duration[i % length]);
+            mu_assert_int_eq(stream_pulse[i + 1], pulse[i % length]);
+        }
+    }
+
+    // ASK protocols and short PSK ones fit into the buffer
+    mu_check(periodic_count >= LFRFIDProtocolMax / 2);
+
+    free(stream_pulse);
+    free(stream_duration);
+    free(pulse);
+    free(duration);
+    free(data);
+    protocol_dict_free(dict);
+}
+
+typedef void (*LfRfidTestRawCallback)(uint32_t duration, uint32_t pulse, void* context);
+
+/* Render encoder output as it would be captured, with timings in microseconds */
+static void lfrfid_test_render_raw(
+    ProtocolDict* dict,
+    ProtocolId protocol,
+    LfRfidTestRawCallback callback,
+    void* context) {
+    uint32_t* duration = malloc(sizeof(uint32_t) * LF_RFID_RAW_TEST_CHUNK);
+    uint32_t* pulse = malloc(sizeof(uint32_t) * LF_RFID_RAW_TEST_CHUNK);
+    PulseGlue* pulse_glue = pulse_glue_alloc();
+
+    protocol_dict_encoder_start(dict, protocol);
+    uint32_t time = 0;
+    while(time < LF_RFID_RAW_TEST_TIME_US) {
+        lfrfid_waveform_render(
+            dict, protocol, pulse_glue, duration, pulse, LF_RFID_RAW_TEST_CHUNK);
+        for(size_t i = 0; i < LF_RFID_RAW_TEST_CHUNK; i++) {
+            uint32_t duration_us = (duration[i] + 1) * LF_RFID_READ_TIMING_MULTIPLIER;
+            callback(duration_us, pulse[i] * LF_RFID_READ_TIMING_MULTIPLIER, context);
+            time += duration_us;
+        }
+    }
+
+    pulse_glue_free(pulse_glue);
+    free(pulse);
+    free(duration);
+}
+
+static void lfrfid_test_raw_analyzer_feed(uint32_t duration, uint32_t pulse, void* context) {
+    lfrfid_raw_analyzer_feed(context, duration, pulse);
+}
+
+static void test_lfrfid_raw_analyzer_check(ProtocolId protocol, const uint8_t* data, size_t size) {
+    ProtocolDict* encoder = protocol_dict_alloc(lfrfid_protocols, LFRFIDProtocolMax);
+    ProtocolDict* decoder = protocol_dict_alloc(lfrfid_protocols, LFRFIDProtocolMax);
+    LFRFIDRawAnalyzer* analyzer = lfrfid_raw_analyzer_alloc(decoder);
+
+    protocol_dict_set_data(encoder, protocol, data, size);
+    lfrfid_test_render_raw(encoder, protocol, lfrfid_test_raw_analyzer_feed, analyzer);
+
+    LFRFIDRawAnalyzerStats stats;
+    ProtocolId result = lfrfid_raw_analyzer_get_result(analyzer, &stats);
+    FURI_LOG_I(
+        "LfRfidTest",
+        "%s: %lu/%lu windows, %lu pairs in %lu us",
+        protocol_dict_get_name(decoder, protocol),
+        stats.windows_matched,
+        stats.windows,
+        stats.pairs,
+        stats.decode_time_us);
+
+    uint8_t* received_data = malloc(size);
+    protocol_dict_get_data(decoder, protocol, received_data, size);
+    bool data_match = memcmp(data, received_data, size) == 0;
+
+    free(received_data);
+    lfrfid_raw_analyzer_free(analyzer);
+    protocol_dict_free(decoder);
+    protocol_dict_free(encoder);
+
+    mu_assert_int_eq(protocol, result);
+    mu_check(data_match);
+    mu_assert_int_eq(0, stats.warnings);
+    mu_check(stats.windows_matched * 2 > stats.windows);
+}
+
+MU_TEST(test_lfrfid_raw_analyzer) {
+    const uint8_t em_data[EM_TEST_DATA_SIZE] = EM_TEST_DATA;
+    test_lfrfid_raw_analyzer_check(LFRFIDProtocolEM4100, em_data, EM_TEST_DATA_SIZE);
+
+    const uint8_t h10301_data[HID10301_TEST_DATA_SIZE] = HID10301_TEST_DATA;
+    test_lfrfid_raw_analyzer_check(LFRFIDProtocolH10301, h10301_data, HID10301_TEST_DATA_SIZE);
+
+    const uint8_t ioprox_data[IOPROX_XSF_TEST_DATA_SIZE] = IOPROX_XSF_TEST_DATA;
+    test_lfrfid_raw_analyzer_check(
+        LFRFIDProtocolIOProxXSF, ioprox_data, IOPROX_XSF_TEST_DATA_SIZE);
+
+    const uint8_t fdxb_data[FDXB_TEST_DATA_SIZE] = FDXB_TEST_DATA;
+    test_lfrfid_raw_analyzer_check(LFRFIDProtocolFDXB, fdxb_data, FDXB_TEST_DATA_SIZE);
+}
+
+typedef struct {
+    LFRFIDRawFile* file;
+    uint8_t buffer[LF_RFID_RAW_TEST_BUFFER_SIZE];
+    size_t size;
+    bool ok;
+} LfRfidTestRawWriter;
+
+static void lfrfid_test_raw_file_write(uint32_t duration, uint32_t pulse, void* context) {
+    LfRfidTestRawWriter* writer = context;
+    // Same layout as RAW worker writes: pulse and duration as a pair of varints
+    if(writer->size + 2 * varint_uint32_length(UINT32_MAX) > LF_RFID_RAW_TEST_BUFFER_SIZE) {
+        writer->ok &= lfrfid_raw_file_write_buffer(writer->file, writer->buffer, writer->size);
+        writer->size = 0;
+    }
+    writer->size += varint_uint32_pack(pulse, &writer->buffer[writer->size]);
+    writer->size += varint_uint32_pack(duration, &writer->buffer[writer->size]);
+}
+
+MU_TEST(test_lfrfid_raw_analyzer_file) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    ProtocolDict* dict = protocol_dict_alloc(lfrfid_protocols, LFRFIDProtocolMax);
+    LfRfidTestRawWriter* writer = malloc(sizeof(LfRfidTestRawWriter));
+    writer->file = lfrfid_raw_file_alloc(storage);
+    writer->ok = true;
+
+    const uint8_t data[EM_TEST_DATA_SIZE] = EM_TEST_DATA;
+    protocol_dict_set_data(dict, LFRFIDProtocolEM4100, data, EM_TEST_DATA_SIZE);
+
+    mu_check(lfrfid_raw_file_open_write(writer->file, LF_RFID_RAW_TEST_FILE));
+    mu_check(
+        lfrfid_raw_file_write_header(writer->file, 125000, 0.5, LF_RFID_RAW_TEST_BUFFER_SIZE));
+    lfrfid_test_render_raw(dict, LFRFIDProtocolEM4100, lfrfid_test_raw_file_write, writer);
+    writer->ok &= lfrfid_raw_file_write_buffer(writer->file, writer->buffer, writer->size);
+    mu_check(writer->ok);
+    lfrfid_raw_file_free(writer->file);
+    free(writer);
+
+    // Analyze with fresh data in dictionary
+    protocol_dict_free(dict);
+    dict = protocol_dict_alloc(lfrfid_protocols, LFRFIDProtocolMax);
+    LFRFIDRawAnalyzer* analyzer = lfrfid_raw_analyzer_alloc(dict);
+    LFRFIDRawFile* file = lfrfid_raw_file_alloc(storage);
+    float frequency, duty_cycle;
+
+    mu_check(lfrfid_raw_file_open_read(file, LF_RFID_RAW_TEST_FILE));
+    mu_check(lfrfid_raw_file_read_header(file, &frequency, &duty_cycle));
+    mu_check(lfrfid_raw_analyzer_feed_file(analyzer, file));
+
+    LFRFIDRawAnalyzerStats stats;
+    mu_assert_int_eq(LFRFIDProtocolEM4100, lfrfid_raw_analyzer_get_result(analyzer, &stats));
+    uint8_t received_data[EM_TEST_DATA_SIZE] = {0};
+    protocol_dict_get_data(dict, LFRFIDProtocolEM4100, received_data, EM_TEST_DATA_SIZE);
+    mu_assert_mem_eq(data, received_data, EM_TEST_DATA_SIZE);
+    mu_assert_int_eq(stats.windows, stats.windows_matched);
+
+    lfrfid_raw_file_free(file);
+    lfrfid_raw_analyzer_free(analyzer);
+    protocol_dict_free(dict);
+    storage_simply_remove(storage, LF_RFID_RAW_TEST_FILE);
+    furi_record_close(RECORD_STORAGE);
+}
+
 MU_TEST_SUITE(test_lfrfid_protocols_suite) {
     MU_RUN_TEST(test_lfrfid_protocol_em_read_simple);
     MU_RUN_TEST(test_lfrfid_protocol_em_emulate_simple);
@@ -540,6 +751,11 @@ MU_TEST_SUITE(test_lfrfid_protocols_suite) {
 
     MU_RUN_TEST(test_lfrfid_protocol_fdxb_read_simple);
     MU_RUN_TEST(test_lfrfid_protocol_fdxb_emulate_simple);
+
+    MU_RUN_TEST(test_lfrfid_protocol_waveform_periodic);
+
+    MU_RUN_TEST(test_lfrfid_raw_analyzer);
+    MU_RUN_TEST(test_lfrfid_raw_analyzer_file);
 }
 
 int run_minunit_test_lfrfid_protocols(void) {
@@ -9,6 +9,9 @@
 #include <nfc/protocols/iso14443_3a/iso14443_3a.h>
 #include <nfc/protocols/iso14443_3a/iso14443_3a_poller.h>
 #include <nfc/protocols/iso14443_3a/iso14443_3a_poller_sync.h>
+#include <nfc/protocols/iso14443_3a/iso14443_3a_listener_i.h>
+#include <nfc/protocols/iso14443_4a/iso14443_4a_poller.h>
+#include <nfc/protocols/iso14443_4a/iso14443_4a_listener_i.h>
 #include <nfc/protocols/mf_ultralight/mf_ultralight.h>
 #include <nfc/protocols/mf_ultralight/mf_ultralight_poller_sync.h>
 #include <nfc/protocols/mf_classic/mf_classic_poller_sync.h>
@@ -25,6 +28,10 @@
 
 #include <toolbox/keys_dict.h>
 #include <nfc/nfc.h>
+#include <nfc/nfc_mock.h>
+#include <nfc/helpers/crypto1.h>
+#include <nfc/helpers/mf_classic_key_stats.h>
+#include <bit_lib/bit_lib.h>
 
 #include "../test.h" // IWYU pragma: keep
 
@@ -32,9 +39,24 @@
 
 #define NFC_TEST_NFC_DEV_PATH                  EXT_PATH("unit_tests/nfc/nfc_device_test.nfc")
 #define NFC_APP_MF_CLASSIC_DICT_UNIT_TEST_PATH EXT_PATH("unit_tests/mf_dict.nfc")
+#define NFC_TEST_KEY_STATS_PATH                EXT_PATH("unit_tests/mf_key_stats.nfc")
+#define NFC_TEST_KEY_STATS_DICT_PATH           EXT_PATH("unit_tests/mf_key_stats_dict.nfc")
 
 #define NFC_TEST_FLAG_WORKER_DONE (1)
 
+#define NFC_TEST_THROUGHPUT_ROUNDS (20)
+
+#define NFC_TEST_FUZZ_ITERATIONS     (500)
+#define NFC_TEST_FUZZ_FRAME_SIZE_MAX (20)
+#define NFC_TEST_FUZZ_CORPUS_SIZE    (32)
+#define NFC_TEST_FUZZ_COVERAGE_BITS  (256)
+
+#define NFC_TEST_KEY_STATS_CARDS       (3)
+#define NFC_TEST_KEY_STATS_DICT_DECOYS (16)
+
+#define NFC_TEST_CRYPTO1_ROUNDS      (2000)
+#define NFC_TEST_CRYPTO1_BENCH_WORDS (20000)
+
 typedef enum {
     NfcTestMfClassicSendFrameTestStateAuth,
     NfcTestMfClassicSendFrameTestStateReadBlock,
@@ -652,6 +674,344 @@ MU_TEST(mf_classic_dict_test) {
         "Remove test dict failed");
 }
 
+static const MfClassicKey nfc_test_key_stats_keys[] = {
+    {.data = {0xff, 0xff, 0xff, 0xff, 0xff, 0xff}},
+    {.data = {0xa0, 0xa1, 0xa2, 0xa3, 0xa4, 0xa5}},
+    {.data = {0x4d, 0x3a, 0x99, 0xc3, 0x51, 0xdd}},
+    {.data = {0x1a, 0x98, 0x2c, 0x7e, 0x45, 0x9a}},
+    {.data = {0xd3, 0xf7, 0xd3, 0xf7, 0xd3, 0xf7}},
+    {.data = {0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff}},
+};
+
+// Layout of a typical access system card: MAD in sector 0, two application key pairs
+// and unused sectors with default keys
+static void nfc_test_key_stats_fill_card(MfClassicData* data) {
+    for(uint8_t i = 0; i < mf_classic_get_total_sectors_num(data->type); i++) {
+        MfClassicSectorTrailer* sec_tr = mf_classic_get_sector_trailer_by_sector(data, i);
+        size_t key_a = (i == 0) ? 1 : (i < 8) ? 2 : (i < 12) ? 4 : 0;
+        size_t key_b = (i < 8) ? 3 : (i < 12) ? 5 : 0;
+        sec_tr->key_a = nfc_test_key_stats_keys[key_a];
+        sec_tr->key_b = nfc_test_key_stats_keys[key_b];
+    }
+}
+
+typedef struct {
+    FuriThreadId thread_id;
+    KeysDict* dict;
+    MfClassicKeyStats* key_stats;
+    const MfClassicData* data;
+    MfClassicPollerEventType last_event;
+} NfcTestMfClassicKeyStatsContext;
+
+// Same key order as the NFC app dictionary attack: key stats first, then the dictionary
+static NfcCommand nfc_test_mf_classic_key_stats_callback(NfcGenericEvent event, void* context) {
+    furi_check(event.event_data);
+    furi_check(context);
+
+    NfcCommand command = NfcCommandContinue;
+    MfClassicPollerEvent* mfc_event = event.event_data;
+    NfcTestMfClassicKeyStatsContext* ctx = context;
+
+    if(mfc_event->type == MfClassicPollerEventTypeRequestMode) {
+        mfc_event->data->poller_mode.mode = MfClassicPollerModeDictAttack;
+        mfc_event->data->poller_mode.data = ctx->data;
+    } else if(mfc_event->type == MfClassicPollerEventTypeRequestKey) {
+        MfClassicKey key = {};
+        bool key_provided =
+            ctx->key_stats && mf_classic_key_stats_get_next_key(ctx->key_stats, &key);
+        if(!key_provided) {
+            key_provided = keys_dict_get_next_key(ctx->dict, key.data, sizeof(MfClassicKey));
+        }
+        mfc_event->data->key_request_data.key = key;
+        mfc_event->data->key_request_data.key_provided = key_provided;
+    } else if(mfc_event->type == MfClassicPollerEventTypeNextSector) {
+        keys_dict_rewind(ctx->dict);
+        if(ctx->key_stats) {
+            mf_classic_key_stats_rewind(
+                ctx->key_stats, mfc_event->data->next_sector_data.current_sector);
+        }
+    } else if(
+        (mfc_event->type == MfClassicPollerEventTypeKeyAttackStop) ||
+        (mfc_event->type == MfClassicPollerEventTypeSuccess) ||
+        (mfc_event->type == MfClassicPollerEventTypeFail) ||
+        (mfc_event->type == MfClassicPollerEventTypeCardLost)) {
+        ctx->last_event = mfc_event->type;
+        furi_thread_flags_set(ctx->thread_id, NFC_TEST_FLAG_WORKER_DONE);
+        command = NfcCommandStop;
+    }
+
+    return command;
+}
+
+/*
+ * Dictionary attack with the MIFARE Classic poller, returns frames sent to the card.
+ * Mock listener can't go through nested attack, so the poller is stopped once key reuse
+ * is over and started again with the keys found so far, until no more keys are found.
+ */
+static uint32_t nfc_test_key_stats_dict_attack(
+    Nfc* poller,
+    KeysDict* dict,
+    MfClassicKeyStats* key_stats,
+    MfClassicData* data) {
+    NfcTestMfClassicKeyStatsContext context = {
+        .thread_id = furi_thread_get_current_id(),
+        .dict = dict,
+        .key_stats = key_stats,
+        .data = data,
+        .last_event = MfClassicPollerEventTypeKeyAttackStop,
+    };
+
+    nfc_mock_reset_frame_count();
+    for(size_t run = 0; (run < MF_CLASSIC_TOTAL_SECTORS_MAX * 2) &&
+                        (context.last_event == MfClassicPollerEventTypeKeyAttackStop);
+        run++) {
+        keys_dict_rewind(dict);
+        if(key_stats) mf_classic_key_stats_rewind(key_stats, 0);
+
+        NfcPoller* mfc_poller = nfc_poller_alloc(poller, NfcProtocolMfClassic);
+        nfc_poller_start(mfc_poller, nfc_test_mf_classic_key_stats_callback, &context);
+        furi_thread_flags_wait(NFC_TEST_FLAG_WORKER_DONE, FuriFlagWaitAny, FuriWaitForever);
+        nfc_poller_stop(mfc_poller);
+        mf_classic_copy(data, nfc_poller_get_data(mfc_poller));
+        nfc_poller_free(mfc_poller);
+    }
+
+    return nfc_mock_get_frame_count();
+}
+
+MU_TEST(mf_classic_key_stats_test) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    storage_simply_remove(storage, NFC_TEST_KEY_STATS_DICT_PATH);
+    storage_simply_remove(storage, NFC_TEST_KEY_STATS_PATH);
+
+    // Application keys are at the end of the dictionary, as in a big real one
+    KeysDict* dict = keys_dict_alloc(
+        NFC_TEST_KEY_STATS_DICT_PATH, KeysDictModeOpenAlways, sizeof(MfClassicKey));
+    mu_assert(dict != NULL, "keys_dict_alloc() failed");
+    keys_dict_add_key(dict, nfc_test_key_stats_keys[0].data, sizeof(MfClassicKey));
+    for(size_t i = 0; i < NFC_TEST_KEY_STATS_DICT_DECOYS; i++) {
+        MfClassicKey key = {};
+        furi_hal_random_fill_buf(key.data, sizeof(MfClassicKey));
+        keys_dict_add_key(dict, key.data, sizeof(MfClassicKey));
+    }
+    for(size_t i = 1; i < COUNT_OF(nfc_test_key_stats_keys); i++) {
+        keys_dict_add_key(dict, nfc_test_key_stats_keys[i].data, sizeof(MfClassicKey));
+    }
+
+    Nfc* poller = nfc_alloc();
+    Nfc* listener = nfc_alloc();
+    NfcDevice* nfc_device = nfc_device_alloc();
+    MfClassicData* card = mf_classic_alloc();
+    MfClassicData* data = mf_classic_alloc();
+    MfClassicKeyStats* key_stats = mf_classic_key_stats_alloc();
+
+    nfc_mock_set_trace(false);
+
+    // First pass goes in dictionary order and collects statistics, second one uses them
+    uint32_t frames_total[2] = {};
+    bool all_keys_found = true;
+    for(size_t pass = 0; pass < COUNT_OF(frames_total); pass++) {
+        for(size_t i = 0; i < NFC_TEST_KEY_STATS_CARDS; i++) {
+            nfc_data_generator_fill_data(NfcDataGeneratorTypeMfClassic1k_4b, nfc_device);
+            mf_classic_copy(card, nfc_device_get_data(nfc_device, NfcProtocolMfClassic));
+            nfc_test_key_stats_fill_card(card);
+
+            NfcListener* mfc_listener = nfc_listener_alloc(listener, NfcProtocolMfClassic, card);
+            nfc_listener_start(mfc_listener, NULL, NULL);
+
+            mf_classic_copy(data, card);
+            data->key_a_mask = 0;
+            data->key_b_mask = 0;
+            memset(data->block_read_mask, 0, sizeof(data->block_read_mask));
+            frames_total[pass] +=
+                nfc_test_key_stats_dict_attack(poller, dict, pass ? key_stats : NULL, data);
+
+            nfc_listener_stop(mfc_listener);
+            nfc_listener_free(mfc_listener);
+
+            uint64_t keys_mask = (1ULL << mf_classic_get_total_sectors_num(card->type)) - 1;
+            all_keys_found &= (data->key_a_mask == keys_mask) && (data->key_b_mask == keys_mask);
+            if(pass == 0) mf_classic_key_stats_add_card(key_stats, data);
+        }
+    }
+
+    nfc_mock_set_trace(true);
+
+    FURI_LOG_I(
+        TAG,
+        "Frames per card: %lu in dictionary order, %lu with key stats",
+        frames_total[0] / NFC_TEST_KEY_STATS_CARDS,
+        frames_total[1] / NFC_TEST_KEY_STATS_CARDS);
+
+    // Only default keys were found in sector 12
+    MfClassicKey key = {};
+    mf_classic_key_stats_rewind(key_stats, 12);
+    bool default_key_first =
+        mf_classic_key_stats_get_next_key(key_stats, &key) &&
+        memcmp(key.data, nfc_test_key_stats_keys[0].data, sizeof(MfClassicKey)) == 0;
+
+    bool stats_saved = mf_classic_key_stats_save(key_stats, NFC_TEST_KEY_STATS_PATH);
+    MfClassicKeyStats* key_stats_loaded = mf_classic_key_stats_alloc();
+    bool stats_loaded = mf_classic_key_stats_load(key_stats_loaded, NFC_TEST_KEY_STATS_PATH);
+    bool stats_equal = mf_classic_key_stats_get_cards_num(key_stats_loaded) ==
+                           mf_classic_key_stats_get_cards_num(key_stats) &&
+                       mf_classic_key_stats_get_keys_num(key_stats_loaded) ==
+                           mf_classic_key_stats_get_keys_num(key_stats);
+    for(uint8_t i = 0; (i < MF_CLASSIC_TOTAL_SECTORS_MAX) && stats_equal; i++) {
+        MfClassicKey key_loaded = {};
+        mf_classic_key_stats_rewind(key_stats, i);
+        mf_classic_key_stats_rewind(key_stats_loaded, i);
+        while(mf_classic_key_stats_get_next_key(key_stats, &key)) {
+            stats_equal &= mf_classic_key_stats_get_next_key(key_stats_loaded, &key_loaded) &&
+                           memcmp(key.data, key_loaded.data, sizeof(MfClassicKey)) == 0;
+        }
+    }
+
+    mf_classic_key_stats_free(key_stats_loaded);
+    mf_classic_key_stats_free(key_stats);
+    mf_classic_free(data);
+    mf_classic_free(card);
+    nfc_device_free(nfc_device);
+    nfc_free(listener);
+    nfc_free(poller);
+    keys_dict_free(dict);
+    storage_simply_remove(storage, NFC_TEST_KEY_STATS_DICT_PATH);
+    storage_simply_remove(storage, NFC_TEST_KEY_STATS_PATH);
+    furi_record_close(RECORD_STORAGE);
+
+    mu_assert(all_keys_found, "Not all keys found by dictionary attack");
+    mu_assert(frames_total[1] < frames_total[0], "Key stats didn't reduce frames");
+    mu_assert(default_key_first, "Key stats order mismatch");
+    mu_assert(stats_saved && stats_loaded, "Key stats save/load failed");
+    mu_assert(stats_equal, "Loaded key stats mismatch");
+}
+
+typedef struct {
+    FuriThreadId thread_id;
+    const MfClassicData* data;
+    const MfClassicKey* keys;
+    size_t keys_num;
+    size_t key_index;
+} NfcTestMfClassicKeyReuseContext;
+
+static NfcCommand nfc_test_mf_classic_key_reuse_callback(NfcGenericEvent event, void* context) {
+    furi_check(event.event_data);
+    furi_check(context);
+
+    NfcCommand command = NfcCommandContinue;
+    MfClassicPollerEvent* mfc_event = event.event_data;
+    NfcTestMfClassicKeyReuseContext* ctx = context;
+
+    if(mfc_event->type == MfClassicPollerEventTypeRequestMode) {
+        mfc_event->data->poller_mode.mode = MfClassicPollerModeDictAttack;
+        mfc_event->data->poller_mode.data = ctx->data;
+    } else if(mfc_event->type == MfClassicPollerEventTypeRequestKey) {
+        MfClassicPollerEventDataKeyRequest* key_request = &mfc_event->data->key_request_data;
+        key_request->key_provided = ctx->key_index < ctx->keys_num;
+        if(key_request->key_provided) {
+            key_request->key = ctx->keys[ctx->key_index++];
+        }
+    } else if(mfc_event->type == MfClassicPollerEventTypeNextSector) {
+        ctx->key_index = 0;
+    } else if(
+        (mfc_event->type == MfClassicPollerEventTypeKeyAttackStop) ||
+        (mfc_event->type == MfClassicPollerEventTypeSuccess) ||
+        (mfc_event->type == MfClassicPollerEventTypeFail) ||
+        (mfc_event->type == MfClassicPollerEventTypeCardLost)) {
+        // Stop before nested attack, only dictionary and key reuse are measured
+        furi_thread_flags_set(ctx->thread_id, NFC_TEST_FLAG_WORKER_DONE);
+        command = NfcCommandStop;
+    }
+
+    return command;
+}
+
+static void mf_classic_key_reuse_test(NfcDataGeneratorType type, const char* name) {
+    Nfc* poller = nfc_alloc();
+    Nfc* listener = nfc_alloc();
+    NfcDevice* nfc_device = nfc_device_alloc();
+    MfClassicData* card = mf_classic_alloc();
+    MfClassicData* data = mf_classic_alloc();
+
+    nfc_data_generator_fill_data(type, nfc_device);
+    mf_classic_copy(card, nfc_device_get_data(nfc_device, NfcProtocolMfClassic));
+    nfc_test_key_stats_fill_card(card);
+    mf_classic_copy(data, card);
+    data->key_a_mask = 0;
+    data->key_b_mask = 0;
+    memset(data->block_read_mask, 0, sizeof(data->block_read_mask));
+
+    // Default key first, then unknown keys, then the key B of the first 8 sectors
+    MfClassicKey keys[NFC_TEST_KEY_STATS_DICT_DECOYS + 2] = {};
+    keys[0] = nfc_test_key_stats_keys[0];
+    for(size_t i = 1; i < COUNT_OF(keys) - 1; i++) {
+        furi_hal_random_fill_buf(keys[i].data, sizeof(MfClassicKey));
+    }
+    keys[COUNT_OF(keys) - 1] = nfc_test_key_stats_keys[3];
+
+    NfcListener* mfc_listener = nfc_listener_alloc(listener, NfcProtocolMfClassic, card);
+    nfc_listener_start(mfc_listener, NULL, NULL);
+
+    NfcTestMfClassicKeyReuseContext context = {
+        .thread_id = furi_thread_get_current_id(),
+        .data = data,
+        .keys = keys,
+        .keys_num = COUNT_OF(keys),
+    };
+
+    nfc_mock_set_trace(false);
+    nfc_mock_reset_frame_count();
+    uint32_t start = furi_get_tick();
+
+    NfcPoller* mfc_poller = nfc_poller_alloc(poller, NfcProtocolMfClassic);
+    nfc_poller_start(mfc_poller, nfc_test_mf_classic_key_reuse_callback, &context);
+    uint32_t flag =
+        furi_thread_flags_wait(NFC_TEST_FLAG_WORKER_DONE, FuriFlagWaitAny, FuriWaitForever);
+    nfc_poller_stop(mfc_poller);
+
+    uint32_t elapsed = furi_get_tick() - start;
+    uint32_t frames = nfc_mock_get_frame_count();
+    nfc_mock_set_trace(true);
+
+    const MfClassicData* result = nfc_poller_get_data(mfc_poller);
+    uint64_t key_a_mask = result->key_a_mask;
+    uint64_t key_b_mask = result->key_b_mask;
+    uint8_t sectors_read = 0;
+    uint8_t keys_found = 0;
+    mf_classic_get_read_sectors_and_keys(result, &sectors_read, &keys_found);
+
+    nfc_poller_free(mfc_poller);
+    nfc_listener_stop(mfc_listener);
+    nfc_listener_free(mfc_listener);
+
+    FURI_LOG_I(
+        TAG,
+        "%s: dictionary and key reuse in %lu ms, %lu frames, %u sectors read",
+        name,
+        elapsed,
+        frames,
+        sectors_read);
+
+    mf_classic_free(data);
+    mf_classic_free(card);
+    nfc_device_free(nfc_device);
+    nfc_free(listener);
+    nfc_free(poller);
+
+    mu_assert(flag == NFC_TEST_FLAG_WORKER_DONE, "Wrong thread flag");
+    mu_assert(key_a_mask == 0, "Unexpected key A found");
+    mu_assert(key_b_mask == 0xff, "Key B not found by key reuse");
+    mu_assert((sectors_read == 8) && (keys_found == 8), "Sectors not read with found keys");
+}
+
+MU_TEST(mf_classic_1k_key_reuse_test) {
+    mf_classic_key_reuse_test(NfcDataGeneratorTypeMfClassic1k_4b, "MIFARE Classic 1K");
+}
+
+MU_TEST(mf_classic_4k_key_reuse_test) {
+    mf_classic_key_reuse_test(NfcDataGeneratorTypeMfClassic4k_4b, "MIFARE Classic 4K");
+}
+
 static FelicaError
     felica_do_request_response(FelicaData* felica_data, const FelicaCardKey* card_key) {
     NfcDeviceData* nfc_device = nfc_device_alloc();
@@ -823,6 +1183,849 @@ MU_TEST(slix_set_password_access_all_passwords_cap) {
         EXT_PATH("unit_tests/nfc/Slix_cap_accept_all_pass.nfc"), 0x12341234, false);
 }
 
+typedef bool (*NfcTestThroughputRead)(Nfc* poller, void* context);
+
+typedef struct {
+    NfcProtocol protocol;
+    NfcGenericCallback callback;
+    const NfcDeviceData* reference;
+    FuriThreadId thread_id;
+    BitBuffer* tx_buf;
+    BitBuffer* rx_buf;
+    bool success;
+} NfcTestThroughputAsync;
+
+static bool nfc_test_throughput_run(
+    const char* name,
+    NfcProtocol protocol,
+    const NfcDeviceData* listener_data,
+    NfcGenericCallback listener_callback,
+    NfcTestThroughputRead read,
+    void* read_context) {
+    Nfc* poller = nfc_alloc();
+    Nfc* listener = nfc_alloc();
+
+    NfcListener* nfc_listener = nfc_listener_alloc(listener, protocol, listener_data);
+    nfc_listener_start(nfc_listener, listener_callback, NULL);
+
+    nfc_mock_set_trace(false);
+    nfc_mock_reset_frame_count();
+
+    uint32_t rounds_ok = 0;
+    uint32_t start = furi_get_tick();
+    for(uint32_t i = 0; i < NFC_TEST_THROUGHPUT_ROUNDS; i++) {
+        rounds_ok += read(poller, read_context) ? 1 : 0;
+    }
+    uint32_t elapsed = MAX(furi_get_tick() - start, 1UL);
+    uint32_t frames = nfc_mock_get_frame_count();
+
+    nfc_mock_set_trace(true);
+
+    nfc_listener_stop(nfc_listener);
+    nfc_listener_free(nfc_listener);
+    nfc_free(listener);
+    nfc_free(poller);
+
+    FURI_LOG_I(
+        TAG,
+        "%s: %lu transactions/s, %lu frames/s (%lu frames per transaction)",
+        name,
+        NFC_TEST_THROUGHPUT_ROUNDS * 1000 / elapsed,
+        frames * 1000 / elapsed,
+        frames / NFC_TEST_THROUGHPUT_ROUNDS);
+
+    return rounds_ok == NFC_TEST_THROUGHPUT_ROUNDS;
+}
+
+static bool nfc_test_throughput_iso14443_3a_read(Nfc* poller, void* context) {
+    UNUSED(context);
+    Iso14443_3aData data = {};
+    return iso14443_3a_poller_sync_read(poller, &data) == Iso14443_3aErrorNone;
+}
+
+static bool nfc_test_throughput_mf_ultralight_read(Nfc* poller, void* context) {
+    return mf_ultralight_poller_sync_read_card(poller, context) == MfUltralightErrorNone;
+}
+
+static bool nfc_test_throughput_mf_classic_read(Nfc* poller, void* context) {
+    UNUSED(context);
+    MfClassicBlock block = {};
+    MfClassicKey key = {.data = {0xff, 0xff, 0xff, 0xff, 0xff, 0xff}};
+    return mf_classic_poller_sync_read_block(poller, 4, &key, MfClassicKeyTypeA, &block) ==
+           MfClassicErrorNone;
+}
+
+static bool nfc_test_throughput_felica_read(Nfc* poller, void* context) {
+    return felica_poller_sync_read(poller, context, NULL) == FelicaErrorNone;
+}
+
+/* Protocols without sync API: one poller session per transaction, same as sync wrappers do */
+static bool nfc_test_throughput_async_read(Nfc* poller, void* context) {
+    NfcTestThroughputAsync* async = context;
+    async->thread_id = furi_thread_get_current_id();
+    async->success = false;
+
+    NfcPoller* nfc_poller = nfc_poller_alloc(poller, async->protocol);
+    nfc_poller_start(nfc_poller, async->callback, async);
+    furi_thread_flags_wait(NFC_TEST_FLAG_WORKER_DONE, FuriFlagWaitAny, FuriWaitForever);
+    nfc_poller_stop(nfc_poller);
+    nfc_poller_free(nfc_poller);
+
+    return async->success;
+}
+
+/* Lock bits can't be read back, so only compare what poller is able to read */
+static bool nfc_test_iso15693_3_read_matches(
+    const Iso15693_3Data* data,
+    const Iso15693_3Data* reference) {
+    return memcmp(data->uid, reference->uid, ISO15693_3_UID_SIZE) == 0 &&
+           simple_array_is_equal(data->block_data, reference->block_data);
+}
+
+static NfcCommand nfc_test_throughput_iso15693_3_callback(NfcGenericEvent event, void* context) {
+    furi_check(event.protocol == NfcProtocolIso15693_3);
+
+    NfcTestThroughputAsync* async = context;
+    const Iso15693_3PollerEvent* iso15_event = event.event_data;
+
+    if(iso15_event->type == Iso15693_3PollerEventTypeReady) {
+        async->success = !async->reference ||
+                         nfc_test_iso15693_3_read_matches(
+                             iso15693_3_poller_get_data(event.instance), async->reference);
+    }
+
+    furi_thread_flags_set(async->thread_id, NFC_TEST_FLAG_WORKER_DONE);
+    return NfcCommandStop;
+}
+
+static NfcCommand nfc_test_throughput_slix_callback(NfcGenericEvent event, void* context) {
+    furi_check(event.protocol == NfcProtocolSlix);
+
+    NfcTestThroughputAsync* async = context;
+    const SlixPoller* instance = event.instance;
+    const SlixPollerEvent* slix_event = event.event_data;
+    const SlixData* reference = async->reference;
+
+    if(slix_event->type == SlixPollerEventTypeReady) {
+        async->success =
+            !reference ||
+            (nfc_test_iso15693_3_read_matches(
+                 slix_get_base_data(instance->data), slix_get_base_data(reference)) &&
+             memcmp(instance->data->signature, reference->signature, SLIX_SIGNATURE_SIZE) == 0);
+    }
+
+    furi_thread_flags_set(async->thread_id, NFC_TEST_FLAG_WORKER_DONE);
+    return NfcCommandStop;
+}
+
+static NfcCommand nfc_test_throughput_iso14443_4a_callback(NfcGenericEvent event, void* context) {
+    furi_check(event.protocol == NfcProtocolIso14443_4a);
+
+    NfcTestThroughputAsync* async = context;
+    Iso14443_4aPoller* instance = event.instance;
+    const Iso14443_4aPollerEvent* iso4_event = event.event_data;
+
+    if(iso4_event->type == Iso14443_4aPollerEventTypeReady) {
+        // Select NDEF application, the usual first APDU
+        const uint8_t apdu[] = {
+            0x00, 0xA4, 0x04, 0x00, 0x07, 0xD2, 0x76, 0x00, 0x00, 0x85, 0x01, 0x01, 0x00};
+        bit_buffer_copy_bytes(async->tx_buf, apdu, sizeof(apdu));
+
+        Iso14443_4aError error =
+            iso14443_4a_poller_send_block(instance, async->tx_buf, async->rx_buf);
+        async->success = error == Iso14443_4aErrorNone &&
+                         bit_buffer_get_size_bytes(async->rx_buf) == sizeof(apdu) &&
+                         memcmp(bit_buffer_get_data(async->rx_buf), apdu, sizeof(apdu)) == 0;
+
+        // Listener keeps the session until halted, next round starts with RATS again
+        iso14443_4a_poller_halt(instance);
+    }
+
+    furi_thread_flags_set(async->thread_id, NFC_TEST_FLAG_WORKER_DONE);
+    return NfcCommandStop;
+}
+
+/* Iso14443_4a listener leaves blocks to the application, send every one of them back */
+static NfcCommand nfc_test_iso14443_4a_echo_callback(NfcGenericEvent event, void* context) {
+    UNUSED(context);
+    furi_check(event.protocol == NfcProtocolIso14443_4a);
+
+    Iso14443_4aListener* instance = event.instance;
+    const Iso14443_4aListenerEvent* iso4_event = event.event_data;
+
+    if(iso4_event->type == Iso14443_4aListenerEventTypeReceivedData) {
+        iso14443_3a_listener_send_standard_frame(
+            instance->iso14443_3a_listener, iso4_event->data->buffer);
+    }
+
+    return NfcCommandContinue;
+}
+
+static Iso14443_4aData* nfc_test_iso14443_4a_alloc(void) {
+    Iso14443_3aData iso14443_3a_data = {
+        .uid_len = 7,
+        .uid = {0x04, 0x51, 0x5C, 0xFA, 0x6F, 0x73, 0x81},
+        .atqa = {0x44, 0x00},
+        .sak = 0x20,
+    };
+
+    Iso14443_4aData* data = iso14443_4a_alloc();
+    iso14443_3a_copy(iso14443_4a_get_base_data(data), &iso14443_3a_data);
+    // FSCI 256 bytes, 106 kbit/s only, FWI 8, CID supported
+    data->ats_data.tl = 5;
+    data->ats_data.t0 = ISO14443_4A_ATS_T0_TA1 | ISO14443_4A_ATS_T0_TB1 |
+                        ISO14443_4A_ATS_T0_TC1 | 0x08;
+    data->ats_data.ta_1 = ISO14443_4A_ATS_TA1_BOTH_106KBIT;
+    data->ats_data.tb_1 = 0x80;
+    data->ats_data.tc_1 = ISO14443_4A_ATS_TC1_CID;
+
+    return data;
+}
+
+MU_TEST(nfc_mock_throughput_test) {
+    Iso14443_3aData iso14443_3a_data = {
+        .uid_len = 7,
+        .uid = {0x04, 0x51, 0x5C, 0xFA, 0x6F, 0x73, 0x81},
+        .atqa = {0x44, 0x00},
+        .sak = 0x00,
+    };
+    mu_assert(
+        nfc_test_throughput_run(
+            "Iso14443_3a",
+            NfcProtocolIso14443_3a,
+            &iso14443_3a_data,
+            NULL,
+            nfc_test_throughput_iso14443_3a_read,
+            NULL),
+        "Iso14443_3a read failed");
+
+    NfcDevice* nfc_device = nfc_device_alloc();
+    mu_assert(
+        nfc_device_load(nfc_device, EXT_PATH("unit_tests/nfc/Ntag215.nfc")),
+        "nfc_device_load() failed\r\n");
+    MfUltralightData* mfu_data = mf_ultralight_alloc();
+    mu_assert(
+        nfc_test_throughput_run(
+            "MfUltralight",
+            NfcProtocolMfUltralight,
+            nfc_device_get_data(nfc_device, NfcProtocolMfUltralight),
+            NULL,
+            nfc_test_throughput_mf_ultralight_read,
+            mfu_data),
+        "MfUltralight read failed");
+    mf_ultralight_free(mfu_data);
+
+    nfc_data_generator_fill_data(NfcDataGeneratorTypeMfClassic1k_7b, nfc_device);
+    mu_assert(
+        nfc_test_throughput_run(
+            "MfClassic",
+            NfcProtocolMfClassic,
+            nfc_device_get_data(nfc_device, NfcProtocolMfClassic),
+            NULL,
+            nfc_test_throughput_mf_classic_read,
+            NULL),
+        "MfClassic read failed");
+
+    mu_assert(
+        nfc_device_load(nfc_device, EXT_PATH("unit_tests/nfc/Felica.nfc")),
+        "nfc_device_load() failed\r\n");
+    FelicaData* felica_data = felica_alloc();
+    mu_assert(
+        nfc_test_throughput_run(
+            "Felica",
+            NfcProtocolFelica,
+            nfc_device_get_data(nfc_device, NfcProtocolFelica),
+            NULL,
+            nfc_test_throughput_felica_read,
+            felica_data),
+        "Felica read failed");
+    felica_free(felica_data);
+
+    mu_assert(
+        nfc_device_load(nfc_device, EXT_PATH("unit_tests/nfc/Slix_cap_default.nfc")),
+        "nfc_device_load() failed\r\n");
+    const SlixData* slix_data = nfc_device_get_data(nfc_device, NfcProtocolSlix);
+    NfcTestThroughputAsync async = {
+        .protocol = NfcProtocolIso15693_3,
+        .callback = nfc_test_throughput_iso15693_3_callback,
+        .reference = slix_get_base_data(slix_data),
+    };
+    mu_assert(
+        nfc_test_throughput_run(
+            "Iso15693_3",
+            NfcProtocolIso15693_3,
+            slix_get_base_data(slix_data),
+            NULL,
+            nfc_test_throughput_async_read,
+            &async),
+        "Iso15693_3 read failed");
+
+    async.protocol = NfcProtocolSlix;
+    async.callback = nfc_test_throughput_slix_callback;
+    async.reference = slix_data;
+    mu_assert(
+        nfc_test_throughput_run(
+            "Slix", NfcProtocolSlix, slix_data, NULL, nfc_test_throughput_async_read, &async),
+        "Slix read failed");
+
+    Iso14443_4aData* iso14443_4a_data = nfc_test_iso14443_4a_alloc();
+    async.protocol = NfcProtocolIso14443_4a;
+    async.callback = nfc_test_throughput_iso14443_4a_callback;
+    async.tx_buf = bit_buffer_alloc(NFC_TEST_FUZZ_FRAME_SIZE_MAX);
+    async.rx_buf = bit_buffer_alloc(256);
+    mu_assert(
+        nfc_test_throughput_run(
+            "Iso14443_4a",
+            NfcProtocolIso14443_4a,
+            iso14443_4a_data,
+            nfc_test_iso14443_4a_echo_callback,
+            nfc_test_throughput_async_read,
+            &async),
+        "Iso14443_4a exchange failed");
+    bit_buffer_free(async.tx_buf);
+    bit_buffer_free(async.rx_buf);
+    iso14443_4a_free(iso14443_4a_data);
+
+    nfc_device_free(nfc_device);
+}
+
+typedef struct {
+    uint8_t data[NFC_TEST_FUZZ_FRAME_SIZE_MAX];
+    uint8_t size;
+} NfcTestFuzzFrame;
+
+typedef struct {
+    FuriThreadId thread_id;
+    NfcTestFuzzFrame corpus[NFC_TEST_FUZZ_CORPUS_SIZE];
+    size_t corpus_size;
+    uint32_t coverage[NFC_TEST_FUZZ_COVERAGE_BITS / 32];
+    uint32_t coverage_count;
+    uint32_t iterations;
+    uint32_t responses;
+    BitBuffer* tx_buf;
+    BitBuffer* rx_buf;
+} NfcTestFuzzContext;
+
+typedef struct {
+    NfcProtocol protocol;
+    NfcGenericCallback callback;
+    const NfcTestFuzzFrame* seeds;
+    size_t seeds_count;
+} NfcTestFuzzPoller;
+
+/* Valid commands of Iso14443-3a based listeners to start mutating from */
+static const NfcTestFuzzFrame nfc_test_fuzz_seeds[] = {
+    {.data = {0x30, 0x00}, .size = 2}, // Read
+    {.data = {0x3A, 0x00, 0x04}, .size = 3}, // Fast read
+    {.data = {0x60}, .size = 1}, // Get version
+    {.data = {0x3C, 0x00}, .size = 2}, // Read signature
+    {.data = {0x39, 0x02}, .size = 2}, // Read counter
+    {.data = {0xA2, 0x10, 0x01, 0x02, 0x03, 0x04}, .size = 6}, // Write page
+    {.data = {0x1B, 0xFF, 0xFF, 0xFF, 0xFF}, .size = 5}, // Password auth
+    {.data = {0xC2, 0xFF}, .size = 2}, // Sector select
+    {.data = {0x60, 0x04}, .size = 2}, // Mf Classic auth A
+    {.data = {0x61, 0x04}, .size = 2}, // Mf Classic auth B
+    {.data = {0xE0, 0x80}, .size = 2}, // RATS
+    {.data = {0x02, 0x00, 0xA4, 0x04, 0x00, 0x02, 0x3F, 0x00}, .size = 8}, // I-block, select
+    {.data = {0x03, 0x00, 0xB0, 0x00, 0x00, 0x10}, .size = 6}, // I-block, read binary
+    {.data = {0xB2}, .size = 1}, // R(ACK)
+    {.data = {0xC2}, .size = 1}, // S(DESELECT)
+    {.data = {0x50, 0x00}, .size = 2}, // Halt
+};
+
+/* Valid Iso15693-3 and Slix requests, high data rate, non-addressed */
+static const NfcTestFuzzFrame nfc_test_fuzz_iso15693_3_seeds[] = {
+    {.data = {0x26, 0x01, 0x00}, .size = 3}, // Inventory
+    {.data = {0x02, 0x2B}, .size = 2}, // Get system info
+    {.data = {0x02, 0x20, 0x00}, .size = 3}, // Read block
+    {.data = {0x02, 0x23, 0x00, 0x07}, .size = 4}, // Read multiple blocks
+    {.data = {0x02, 0x2C, 0x00, 0x07}, .size = 4}, // Get blocks security
+    {.data = {0x02, 0x21, 0x10, 0x01, 0x02, 0x03, 0x04}, .size = 7}, // Write block
+    {.data = {0x02, 0x26}, .size = 2}, // Reset to ready
+    {.data = {0x02, 0xAB, 0x04}, .size = 3}, // Get NXP system info
+    {.data = {0x02, 0xBD, 0x04}, .size = 3}, // Read signature
+    {.data = {0x02, 0xB2, 0x04}, .size = 3}, // Get random number
+    {.data = {0x02, 0xB3, 0x04, 0x04, 0x00, 0x00, 0x00, 0x00}, .size = 8}, // Set password
+    {.data = {0x02, 0xA2, 0x04}, .size = 3}, // Set EAS
+};
+
+static void nfc_test_fuzz_mutate(NfcTestFuzzFrame* frame) {
+    uint8_t mutations = 1 + furi_hal_random_get() % 3;
+    for(uint8_t i = 0; i < mutations; i++) {
+        uint32_t random = furi_hal_random_get();
+        uint8_t pos = (random >> 8) % frame->size;
+        switch(random % 4) {
+        case 0:
+            frame->data[pos] ^= 1 << ((random >> 16) % 8);
+            break;
+        case 1:
+            frame->data[pos] = random >> 16;
+            break;
+        case 2:
+            if(frame->size < NFC_TEST_FUZZ_FRAME_SIZE_MAX) {
+                frame->data[frame->size++] = random >> 16;
+            }
+            break;
+        default:
+            if(frame->size > 1) {
+                frame->size--;
+            }
+            break;
+        }
+    }
+}
+
+/* Response kind (error, length, first byte) stands in for code coverage:
+ * inputs which make listener answer in a new way are kept for further mutations */
+static bool nfc_test_fuzz_update_coverage(
+    NfcTestFuzzContext* fuzz,
+    uint32_t error,
+    const BitBuffer* rx_buf) {
+    size_t rx_bits = bit_buffer_get_size(rx_buf);
+    uint8_t first_byte = rx_bits >= 8 ? bit_buffer_get_byte(rx_buf, 0) : 0;
+    uint32_t hash = (error * 31 + rx_bits) * 131 + first_byte;
+    uint32_t bit = hash % NFC_TEST_FUZZ_COVERAGE_BITS;
+
+    bool is_new = !(fuzz->coverage[bit / 32] & (1UL << (bit % 32)));
+    if(is_new) {
+        fuzz->coverage[bit / 32] |= 1UL << (bit % 32);
+        fuzz->coverage_count++;
+    }
+
+    return is_new;
+}
+
+static void nfc_test_fuzz_next_frame(NfcTestFuzzContext* fuzz, NfcTestFuzzFrame* frame) {
+    *frame = fuzz->corpus[furi_hal_random_get() % fuzz->corpus_size];
+    nfc_test_fuzz_mutate(frame);
+    fuzz->iterations++;
+    bit_buffer_copy_bytes(fuzz->tx_buf, frame->data, frame->size);
+}
+
+/* Both Iso14443_3a and Iso15693_3 errors have None as 0 */
+static void nfc_test_fuzz_process_response(
+    NfcTestFuzzContext* fuzz,
+    const NfcTestFuzzFrame* frame,
+    uint32_t error) {
+    if(error == 0) {
+        fuzz->responses++;
+    }
+
+    if(nfc_test_fuzz_update_coverage(fuzz, error, fuzz->rx_buf)) {
+        size_t slot = fuzz->corpus_size < NFC_TEST_FUZZ_CORPUS_SIZE ?
+                          fuzz->corpus_size++ :
+                          furi_hal_random_get() % NFC_TEST_FUZZ_CORPUS_SIZE;
+        fuzz->corpus[slot] = *frame;
+    }
+}
+
+static NfcCommand nfc_test_fuzz_callback(NfcGenericEvent event, void* context) {
+    furi_check(event.protocol == NfcProtocolIso14443_3a);
+
+    NfcTestFuzzContext* fuzz = context;
+    Iso14443_3aPoller* instance = event.instance;
+    const Iso14443_3aPollerEvent* iso3_event = event.event_data;
+
+    if(iso3_event->type == Iso14443_3aPollerEventTypeReady) {
+        while(fuzz->iterations < NFC_TEST_FUZZ_ITERATIONS) {
+            NfcTestFuzzFrame frame;
+            nfc_test_fuzz_next_frame(fuzz, &frame);
+
+            Iso14443_3aError error = iso14443_3a_poller_send_standard_frame(
+                instance, fuzz->tx_buf, fuzz->rx_buf, ISO14443_3A_FDT_LISTEN_FC);
+            nfc_test_fuzz_process_response(fuzz, &frame, error);
+
+            if(error != Iso14443_3aErrorNone) {
+                // Listener may be halted or in the middle of something, start over
+                iso14443_3a_poller_activate(instance, NULL);
+            }
+        }
+
+        // Iso14443_4a listener only leaves its session on halt
+        iso14443_3a_poller_halt(instance);
+    }
+
+    furi_thread_flags_set(fuzz->thread_id, NFC_TEST_FLAG_WORKER_DONE);
+    return NfcCommandStop;
+}
+
+/* There is no field reset in mock, so quiet and selected states have to be left explicitly.
+ * Quiet and selected listeners differ in which form they accept, send both */
+static void nfc_test_fuzz_iso15693_3_reset(NfcTestFuzzContext* fuzz, Iso15693_3Poller* instance) {
+    const Iso15693_3Data* data = iso15693_3_poller_get_data(instance);
+
+    bit_buffer_reset(fuzz->tx_buf);
+    bit_buffer_append_byte(
+        fuzz->tx_buf, ISO15693_3_REQ_FLAG_DATA_RATE_HI | ISO15693_3_REQ_FLAG_T4_ADDRESSED);
+    bit_buffer_append_byte(fuzz->tx_buf, ISO15693_3_CMD_RESET_TO_READY);
+    for(size_t i = 0; i < ISO15693_3_UID_SIZE; i++) {
+        bit_buffer_append_byte(fuzz->tx_buf, data->uid[ISO15693_3_UID_SIZE - i - 1]);
+    }
+    iso15693_3_poller_send_frame(instance, fuzz->tx_buf, fuzz->rx_buf, ISO15693_3_FDT_POLL_FC);
+
+    bit_buffer_reset(fuzz->tx_buf);
+    bit_buffer_append_byte(fuzz->tx_buf, ISO15693_3_REQ_FLAG_DATA_RATE_HI);
+    bit_buffer_append_byte(fuzz->tx_buf, ISO15693_3_CMD_RESET_TO_READY);
+    iso15693_3_poller_send_frame(instance, fuzz->tx_buf, fuzz->rx_buf, ISO15693_3_FDT_POLL_FC);
+}
+
+static NfcCommand nfc_test_fuzz_iso15693_3_callback(NfcGenericEvent event, void* context) {
+    furi_check(event.protocol == NfcProtocolIso15693_3);
+
+    NfcTestFuzzContext* fuzz = context;
+    Iso15693_3Poller* instance = event.instance;
+    const Iso15693_3PollerEvent* iso15_event = event.event_data;
+
+    if(iso15_event->type == Iso15693_3PollerEventTypeReady) {
+        while(fuzz->iterations < NFC_TEST_FUZZ_ITERATIONS) {
+            NfcTestFuzzFrame frame;
+            nfc_test_fuzz_next_frame(fuzz, &frame);
+
+            Iso15693_3Error error = iso15693_3_poller_send_frame(
+                instance, fuzz->tx_buf, fuzz->rx_buf, ISO15693_3_FDT_POLL_FC);
+            nfc_test_fuzz_process_response(fuzz, &frame, error);
+
+            if(error != Iso15693_3ErrorNone) {
+                nfc_test_fuzz_iso15693_3_reset(fuzz, instance);
+            }
+        }
+
+        nfc_test_fuzz_iso15693_3_reset(fuzz, instance);
+    }
+
+    furi_thread_flags_set(fuzz->thread_id, NFC_TEST_FLAG_WORKER_DONE);
+    return NfcCommandStop;
+}
+
+static const NfcTestFuzzPoller nfc_test_fuzz_iso14443_3a = {
+    .protocol = NfcProtocolIso14443_3a,
+    .callback = nfc_test_fuzz_callback,
+    .seeds = nfc_test_fuzz_seeds,
+    .seeds_count = COUNT_OF(nfc_test_fuzz_seeds),
+};
+
+static const NfcTestFuzzPoller nfc_test_fuzz_iso15693_3 = {
+    .protocol = NfcProtocolIso15693_3,
+    .callback = nfc_test_fuzz_iso15693_3_callback,
+    .seeds = nfc_test_fuzz_iso15693_3_seeds,
+    .seeds_count = COUNT_OF(nfc_test_fuzz_iso15693_3_seeds),
+};
+
+static bool nfc_test_fuzz_listener(
+    const char* name,
+    NfcProtocol protocol,
+    const NfcDeviceData* listener_data,
+    NfcGenericCallback listener_callback,
+    const NfcTestFuzzPoller* fuzz_poller,
+    NfcTestThroughputRead read,
+    void* read_context) {
+    Nfc* poller = nfc_alloc();
+    Nfc* listener = nfc_alloc();
+
+    NfcListener* nfc_listener = nfc_listener_alloc(listener, protocol, listener_data);
+    nfc_listener_start(nfc_listener, listener_callback, NULL);
+    nfc_mock_set_trace(false);
+
+    NfcTestFuzzContext* fuzz = malloc(sizeof(NfcTestFuzzContext));
+    fuzz->thread_id = furi_thread_get_current_id();
+    fuzz->tx_buf = bit_buffer_alloc(NFC_TEST_FUZZ_FRAME_SIZE_MAX + 2);
+    fuzz->rx_buf = bit_buffer_alloc(256);
+    fuzz->corpus_size = fuzz_poller->seeds_count;
+    memcpy(fuzz->corpus, fuzz_poller->seeds, fuzz_poller->seeds_count * sizeof(NfcTestFuzzFrame));
+
+    uint32_t start = furi_get_tick();
+    NfcPoller* nfc_poller = nfc_poller_alloc(poller, fuzz_poller->protocol);
+    nfc_poller_start(nfc_poller, fuzz_poller->callback, fuzz);
+    furi_thread_flags_wait(NFC_TEST_FLAG_WORKER_DONE, FuriFlagWaitAny, FuriWaitForever);
+    nfc_poller_stop(nfc_poller);
+    nfc_poller_free(nfc_poller);
+    uint32_t elapsed = MAX(furi_get_tick() - start, 1UL);
+
+    // Listener has to survive and still be readable after all that
+    bool alive = read(poller, read_context);
+
+    FURI_LOG_I(
+        TAG,
+        "%s fuzz: %lu frames, %lu responses, %lu response kinds, %lu frames/s",
+        name,
+        fuzz->iterations,
+        fuzz->responses,
+        fuzz->coverage_count,
+        fuzz->iterations * 1000 / elapsed);
+
+    nfc_mock_set_trace(true);
+    bit_buffer_free(fuzz->tx_buf);
+    bit_buffer_free(fuzz->rx_buf);
+    free(fuzz);
+
+    nfc_listener_stop(nfc_listener);
+    nfc_listener_free(nfc_listener);
+    nfc_free(listener);
+    nfc_free(poller);
+
+    return alive;
+}
+
+MU_TEST(nfc_mock_fuzz_test) {
+    Iso14443_3aData iso14443_3a_data = {
+        .uid_len = 7,
+        .uid = {0x04, 0x51, 0x5C, 0xFA, 0x6F, 0x73, 0x81},
+        .atqa = {0x44, 0x00},
+        .sak = 0x00,
+    };
+    mu_assert(
+        nfc_test_fuzz_listener(
+            "Iso14443_3a",
+            NfcProtocolIso14443_3a,
+            &iso14443_3a_data,
+            NULL,
+            &nfc_test_fuzz_iso14443_3a,
+            nfc_test_throughput_iso14443_3a_read,
+            NULL),
+        "Iso14443_3a listener stopped responding");
+
+    NfcDevice* nfc_device = nfc_device_alloc();
+    mu_assert(
+        nfc_device_load(nfc_device, EXT_PATH("unit_tests/nfc/Ntag215.nfc")),
+        "nfc_device_load() failed\r\n");
+    mu_assert(
+        nfc_test_fuzz_listener(
+            "MfUltralight",
+            NfcProtocolMfUltralight,
+            nfc_device_get_data(nfc_device, NfcProtocolMfUltralight),
+            NULL,
+            &nfc_test_fuzz_iso14443_3a,
+            nfc_test_throughput_iso14443_3a_read,
+            NULL),
+        "MfUltralight listener stopped responding");
+
+    nfc_data_generator_fill_data(NfcDataGeneratorTypeMfClassic1k_7b, nfc_device);
+    mu_assert(
+        nfc_test_fuzz_listener(
+            "MfClassic",
+            NfcProtocolMfClassic,
+            nfc_device_get_data(nfc_device, NfcProtocolMfClassic),
+            NULL,
+            &nfc_test_fuzz_iso14443_3a,
+            nfc_test_throughput_iso14443_3a_read,
+            NULL),
+        "MfClassic listener stopped responding");
+
+    NfcTestThroughputAsync async = {
+        .protocol = NfcProtocolIso14443_4a,
+        .callback = nfc_test_throughput_iso14443_4a_callback,
+        .tx_buf = bit_buffer_alloc(NFC_TEST_FUZZ_FRAME_SIZE_MAX),
+        .rx_buf = bit_buffer_alloc(256),
+    };
+    Iso14443_4aData* iso14443_4a_data = nfc_test_iso14443_4a_alloc();
+    mu_assert(
+        nfc_test_fuzz_listener(
+            "Iso14443_4a",
+            NfcProtocolIso14443_4a,
+            iso14443_4a_data,
+            nfc_test_iso14443_4a_echo_callback,
+            &nfc_test_fuzz_iso14443_3a,
+            nfc_test_throughput_async_read,
+            &async),
+        "Iso14443_4a listener stopped responding");
+    iso14443_4a_free(iso14443_4a_data);
+    bit_buffer_free(async.tx_buf);
+    bit_buffer_free(async.rx_buf);
+
+    mu_assert(
+        nfc_device_load(nfc_device, EXT_PATH("unit_tests/nfc/Slix_cap_default.nfc")),
+        "nfc_device_load() failed\r\n");
+    const SlixData* slix_data = nfc_device_get_data(nfc_device, NfcProtocolSlix);
+    // Block writes land in listener's own copy of data, so only check it still answers
+    async.protocol = NfcProtocolIso15693_3;
+    async.callback = nfc_test_throughput_iso15693_3_callback;
+    mu_assert(
+        nfc_test_fuzz_listener(
+            "Iso15693_3",
+            NfcProtocolIso15693_3,
+            slix_get_base_data(slix_data),
+            NULL,
+            &nfc_test_fuzz_iso15693_3,
+            nfc_test_throughput_async_read,
+            &async),
+        "Iso15693_3 listener stopped responding");
+
+    async.protocol = NfcProtocolSlix;
+    async.callback = nfc_test_throughput_slix_callback;
+    mu_assert(
+        nfc_test_fuzz_listener(
+            "Slix",
+            NfcProtocolSlix,
+            slix_data,
+            NULL,
+            &nfc_test_fuzz_iso15693_3,
+            nfc_test_throughput_async_read,
+            &async),
+        "Slix listener stopped responding");
+
+    nfc_device_free(nfc_device);
+}
+
+/* Bit at a time Crypto1 the table-driven implementation must stay bit-exact with */
+static uint8_t crypto1_reference_filter(uint32_t in) {
+    uint32_t out = 0;
+    out = 0xf22c0 >> (in & 0xf) & 16;
+    out |= 0x6c9c0 >> (in >> 4 & 0xf) & 8;
+    out |= 0x3c8b0 >> (in >> 8 & 0xf) & 4;
+    out |= 0x1e458 >> (in >> 12 & 0xf) & 2;
+    out |= 0x0d938 >> (in >> 16 & 0xf) & 1;
+    return FURI_BIT(0xEC57E80A, out);
+}
+
+static uint8_t crypto1_reference_bit(Crypto1* crypto1, uint8_t in, int is_encrypted) {
+    uint8_t out = crypto1_reference_filter(crypto1->odd);
+    uint32_t feed = out & (!!is_encrypted);
+    feed ^= !!in;
+    feed ^= 0x29CE5C & crypto1->odd;
+    feed ^= 0x870804 & crypto1->even;
+    crypto1->even = crypto1->even << 1 | __builtin_parity(feed);
+
+    FURI_SWAP(crypto1->odd, crypto1->even);
+    return out;
+}
+
+static uint32_t crypto1_reference_word(Crypto1* crypto1, uint32_t in, int is_encrypted) {
+    uint32_t out = 0;
+    for(uint8_t i = 0; i < 32; i++) {
+        out |= (uint32_t)crypto1_reference_bit(crypto1, FURI_BIT(in, i ^ 24), is_encrypted)
+               << (24 ^ i);
+    }
+    return out;
+}
+
+static uint64_t nfc_test_crypto1_random_key(void) {
+    return ((uint64_t)furi_hal_random_get() << 16 ^ furi_hal_random_get()) & 0xFFFFFFFFFFFF;
+}
+
+MU_TEST(crypto1_bit_exact_test) {
+    for(uint32_t round = 0; round < NFC_TEST_CRYPTO1_ROUNDS; round++) {
+        uint64_t key = nfc_test_crypto1_random_key();
+        Crypto1 crypto = {};
+        Crypto1 reference = {};
+        crypto1_init(&crypto, key);
+        crypto1_init(&reference, key);
+
+        uint32_t in = furi_hal_random_get();
+        int is_encrypted = round & 1;
+
+        uint32_t out = crypto1_word(&crypto, in, is_encrypted);
+        uint32_t out_ref = crypto1_reference_word(&reference, in, is_encrypted);
+        mu_assert(out == out_ref, "crypto1_word() output mismatch");
+
+        uint8_t byte = crypto1_byte(&crypto, in >> 8, is_encrypted);
+        uint8_t byte_ref = 0;
+        for(uint8_t i = 0; i < 8; i++) {
+            byte_ref |= crypto1_reference_bit(&reference, FURI_BIT(in >> 8, i), is_encrypted)
+                        << i;
+        }
+        mu_assert(byte == byte_ref, "crypto1_byte() output mismatch");
+
+        uint8_t bit = crypto1_bit(&crypto, in & 1, is_encrypted);
+        uint8_t bit_ref = crypto1_reference_bit(&reference, in & 1, is_encrypted);
+        mu_assert(bit == bit_ref, "crypto1_bit() output mismatch");
+
+        mu_assert(
+            (crypto.odd == reference.odd) && (crypto.even == reference.even),
+            "Crypto1 state mismatch");
+    }
+}
+
+MU_TEST(crypto1_batch_test) {
+    uint64_t keys[CRYPTO1_BATCH_SIZE];
+    Crypto1 reference[CRYPTO1_BATCH_SIZE];
+    uint32_t out[CRYPTO1_BATCH_SIZE];
+
+    for(uint32_t round = 0; round < NFC_TEST_CRYPTO1_ROUNDS / CRYPTO1_BATCH_SIZE; round++) {
+        // Partially filled batches as well as full ones
+        size_t count = 1 + round % CRYPTO1_BATCH_SIZE;
+        for(size_t i = 0; i < count; i++) {
+            keys[i] = nfc_test_crypto1_random_key();
+            crypto1_init(&reference[i], keys[i]);
+        }
+
+        Crypto1Batch batch;
+        crypto1_batch_init(&batch, keys, count);
+
+        for(uint8_t word = 0; word < 3; word++) {
+            uint32_t in = furi_hal_random_get();
+            int is_encrypted = word == 0;
+            crypto1_batch_word(&batch, in, is_encrypted, out);
+            for(size_t i = 0; i < count; i++) {
+                mu_assert(
+                    out[i] == crypto1_reference_word(&reference[i], in, is_encrypted),
+                    "crypto1_batch_word() output mismatch");
+            }
+        }
+    }
+
+    // Batch must give the same plain nonces as decrypt_nt_enc()
+    uint32_t cuid = furi_hal_random_get();
+    uint32_t nt_enc = furi_hal_random_get();
+    MfClassicKey key_data[CRYPTO1_BATCH_SIZE];
+    for(size_t i = 0; i < CRYPTO1_BATCH_SIZE; i++) {
+        furi_hal_random_fill_buf(key_data[i].data, sizeof(MfClassicKey));
+        keys[i] = bit_lib_bytes_to_num_be(key_data[i].data, sizeof(MfClassicKey));
+    }
+    Crypto1Batch batch;
+    crypto1_batch_init(&batch, keys, CRYPTO1_BATCH_SIZE);
+    crypto1_batch_word(&batch, nt_enc ^ cuid, 1, out);
+    for(size_t i = 0; i < CRYPTO1_BATCH_SIZE; i++) {
+        mu_assert(
+            (nt_enc ^ out[i]) == decrypt_nt_enc(cuid, nt_enc, key_data[i]),
+            "Batch nonce decryption mismatch");
+    }
+}
+
+static uint32_t nfc_test_crypto1_cycles_per_byte(uint32_t elapsed_ms, uint32_t bytes) {
+    uint64_t cycles = (uint64_t)elapsed_ms * 1000 * furi_hal_cortex_instructions_per_microsecond();
+    return cycles / bytes;
+}
+
+MU_TEST(crypto1_benchmark) {
+    Crypto1 crypto = {};
+    volatile uint32_t sink = 0;
+    const uint32_t bytes = NFC_TEST_CRYPTO1_BENCH_WORDS * sizeof(uint32_t);
+
+    crypto1_init(&crypto, 0xFFFFFFFFFFFF);
+    uint32_t start = furi_get_tick();
+    for(uint32_t i = 0; i < NFC_TEST_CRYPTO1_BENCH_WORDS; i++) {
+        sink ^= crypto1_reference_word(&crypto, i, 0);
+    }
+    uint32_t reference_ms = MAX(furi_get_tick() - start, 1UL);
+
+    crypto1_init(&crypto, 0xFFFFFFFFFFFF);
+    start = furi_get_tick();
+    for(uint32_t i = 0; i < NFC_TEST_CRYPTO1_BENCH_WORDS; i++) {
+        sink ^= crypto1_word(&crypto, i, 0);
+    }
+    uint32_t word_ms = MAX(furi_get_tick() - start, 1UL);
+
+    uint64_t keys[CRYPTO1_BATCH_SIZE] = {};
+    uint32_t out[CRYPTO1_BATCH_SIZE];
+    Crypto1Batch batch;
+    crypto1_batch_init(&batch, keys, CRYPTO1_BATCH_SIZE);
+    start = furi_get_tick();
+    for(uint32_t i = 0; i < NFC_TEST_CRYPTO1_BENCH_WORDS / CRYPTO1_BATCH_SIZE; i++) {
+        crypto1_batch_word(&batch, i, 0, out);
+        sink ^= out[0];
+    }
+    uint32_t batch_ms = MAX(furi_get_tick() - start, 1UL);
+    UNUSED(sink);
+
+    FURI_LOG_I(
+        TAG,
+        "Crypto1 cycles per byte: bitwise %lu, table-driven %lu, batch %lu per cipher",
+        nfc_test_crypto1_cycles_per_byte(reference_ms, bytes),
+        nfc_test_crypto1_cycles_per_byte(word_ms, bytes),
+        nfc_test_crypto1_cycles_per_byte(batch_ms, bytes));
+    mu_assert(word_ms <= reference_ms, "Table-driven Crypto1 is slower than bitwise one");
+}
+
 MU_TEST_SUITE(nfc) {
     nfc_test_alloc();
 
@@ -864,6 +2067,9 @@ MU_TEST_SUITE(nfc) {
     MU_RUN_TEST(mf_classic_value_block);
     MU_RUN_TEST(mf_classic_send_frame_test);
     MU_RUN_TEST(mf_classic_dict_test);
+    MU_RUN_TEST(mf_classic_key_stats_test);
+    MU_RUN_TEST(mf_classic_1k_key_reuse_test);
+    MU_RUN_TEST(mf_classic_4k_key_reuse_test);
     MU_RUN_TEST(felica_read);
     MU_RUN_TEST(felica_read_auth);
 
@@ -872,6 +2078,13 @@ MU_TEST_SUITE(nfc) {
     MU_RUN_TEST(slix_set_password_default_cap_incorrect_pass);
     MU_RUN_TEST(slix_set_password_access_all_passwords_cap);
 
+    MU_RUN_TEST(crypto1_bit_exact_test);
+    MU_RUN_TEST(crypto1_batch_test);
+    MU_RUN_TEST(crypto1_benchmark);
+
+    MU_RUN_TEST(nfc_mock_throughput_test);
+    MU_RUN_TEST(nfc_mock_fuzz_test);
+
     nfc_test_free();
 }
 
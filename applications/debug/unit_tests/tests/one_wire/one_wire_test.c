@@ -0,0 +1,346 @@
+#include <furi.h>
+#include <furi_hal.h>
+
+#include "../test.h" // IWYU pragma: keep
+
+#include <one_wire/one_wire_host.h>
+
+#define TAG "OneWireTest"
+
+#define ONE_WIRE_TEST_CMD_READ_MEM     (0xF0U)
+#define ONE_WIRE_TEST_MEMORY_SIZE      (8192U) /* DS1996 */
+#define ONE_WIRE_TEST_READ_MEM_ADDRESS (0x0123U)
+
+/* Slave side limits in microseconds, from DS199x datasheets */
+typedef struct {
+    uint32_t tw1l_max; /* Slave samples written bits after this time */
+    uint32_t tw0l_min; /* Slave samples written bits before this time */
+    uint32_t tw0l_max; /* Longer low time may be taken as a reset */
+    uint32_t trl_max; /* Maximum host low time in a read slot */
+    uint32_t trdv; /* Slave holds the bus low this long to send 0 */
+    uint32_t tslot_min; /* Minimum slot length */
+    uint32_t trec_min; /* Minimum bus high time between slots */
+} OneWireTestSlaveTimings;
+
+static const OneWireTestSlaveTimings one_wire_test_slave_timings_normal = {
+    .tw1l_max = 15,
+    .tw0l_min = 60,
+    .tw0l_max = 120,
+    .trl_max = 15,
+    .trdv = 30,
+    .tslot_min = 60,
+    .trec_min = 1,
+};
+
+static const OneWireTestSlaveTimings one_wire_test_slave_timings_overdrive = {
+    .tw1l_max = 2,
+    .tw0l_min = 6,
+    .tw0l_max = 16,
+    .trl_max = 2,
+    .trdv = 3,
+    .tslot_min = 6,
+    .trec_min = 1,
+};
+
+/* Software model of a memory iButton, sees the bus only through host time slots */
+typedef struct {
+    const OneWireTestSlaveTimings* timings;
+    uint32_t ticks_per_us;
+
+    const uint8_t* memory;
+    uint8_t command[3];
+    size_t command_size;
+    uint8_t rx_byte;
+    uint8_t rx_bits;
+    uint16_t address;
+    uint8_t tx_bits;
+
+    uint32_t timing_errors;
+    uint64_t bus_ticks;
+} OneWireTestSlave;
+
+static void one_wire_test_slave_init(
+    OneWireTestSlave* slave,
+    const uint8_t* memory,
+    bool overdrive,
+    uint32_t ticks_per_us) {
+    memset(slave, 0, sizeof(OneWireTestSlave));
+    slave->timings = overdrive ? &one_wire_test_slave_timings_overdrive :
+                                 &one_wire_test_slave_timings_normal;
+    slave->ticks_per_us = ticks_per_us;
+    slave->memory = memory;
+}
+
+static void one_wire_test_slave_receive_bit(OneWireTestSlave* slave, bool bit) {
+    if(bit) slave->rx_byte |= 1U << slave->rx_bits;
+    if(++slave->rx_bits < 8) return;
+
+    if(slave->command_size < COUNT_OF(slave->command)) {
+        slave->command[slave->command_size++] = slave->rx_byte;
+        if(slave->command_size == COUNT_OF(slave->command)) {
+            slave->address = slave->command[1] | (slave->command[2] << 8);
+        }
+    }
+    slave->rx_byte = 0;
+    slave->rx_bits = 0;
+}
+
+static bool one_wire_test_slave_transmit_bit(OneWireTestSlave* slave) {
+    // Memory is sent only after a complete READ MEMORY command
+    if((slave->command_size < COUNT_OF(slave->command)) ||
+       (slave->command[0] != ONE_WIRE_TEST_CMD_READ_MEM)) {
+        return true;
+    }
+
+    const uint8_t byte = slave->memory[slave->address % ONE_WIRE_TEST_MEMORY_SIZE];
+    const bool bit = (byte >> slave->tx_bits) & 0x01;
+    if(++slave->tx_bits == 8) {
+        slave->tx_bits = 0;
+        slave->address++;
+    }
+
+    return bit;
+}
+
+/* Plays one host slot against the model, returns the bus level seen by the host */
+static bool one_wire_test_slave_slot(OneWireTestSlave* slave, const OneWireHostSlot* slot) {
+    const OneWireTestSlaveTimings* timings = slave->timings;
+    const uint32_t tpu = slave->ticks_per_us;
+
+    uint32_t bus_low_end = slot->release;
+    bool level = true;
+
+    if(slot->sample) {
+        if(slot->release > timings->trl_max * tpu) slave->timing_errors++;
+        if(slot->sample <= slot->release) slave->timing_errors++;
+
+        if(!one_wire_test_slave_transmit_bit(slave)) {
+            bus_low_end = MAX(bus_low_end, timings->trdv * tpu);
+        }
+        level = slot->sample >= bus_low_end;
+    } else {
+        bool bit = false;
+        if(slot->release <= timings->tw1l_max * tpu) {
+            bit = true;
+        } else if(
+            (slot->release < timings->tw0l_min * tpu) ||
+            (slot->release > timings->tw0l_max * tpu)) {
+            slave->timing_errors++;
+        }
+        one_wire_test_slave_receive_bit(slave, bit);
+    }
+
+    if((slot->end < timings->tslot_min * tpu) ||
+       (slot->end < bus_low_end + timings->trec_min * tpu)) {
+        slave->timing_errors++;
+    }
+    slave->bus_ticks += slot->end;
+
+    return level;
+}
+
+/* Same bit order and slot selection as the host block transfers */
+static void one_wire_test_host_write(
+    OneWireTestSlave* slave,
+    const OneWireHostSlotTable* table,
+    const uint8_t* data,
+    size_t size) {
+    for(size_t i = 0; i < size; i++) {
+        for(uint8_t bit_mask = 0x01; bit_mask; bit_mask <<= 1) {
+            one_wire_test_slave_slot(
+                slave, (data[i] & bit_mask) ? &table->write_1 : &table->write_0);
+        }
+    }
+}
+
+static void one_wire_test_host_read(
+    OneWireTestSlave* slave,
+    const OneWireHostSlotTable* table,
+    uint8_t* data,
+    size_t size) {
+    for(size_t i = 0; i < size; i++) {
+        data[i] = 0;
+        for(uint8_t bit_mask = 0x01; bit_mask; bit_mask <<= 1) {
+            if(one_wire_test_slave_slot(slave, &table->read)) data[i] |= bit_mask;
+        }
+    }
+}
+
+/* Reads the whole memory from READ_MEM_ADDRESS on, returns number of mismatching bytes */
+static size_t one_wire_test_read_mem(
+    OneWireTestSlave* slave,
+    const OneWireHostSlotTable* table,
+    const uint8_t* memory) {
+    const uint8_t read_mem_cmd[] = {
+        ONE_WIRE_TEST_CMD_READ_MEM,
+        (uint8_t)ONE_WIRE_TEST_READ_MEM_ADDRESS,
+        (uint8_t)(ONE_WIRE_TEST_READ_MEM_ADDRESS >> 8),
+    };
+    uint8_t* data = malloc(ONE_WIRE_TEST_MEMORY_SIZE);
+
+    one_wire_test_host_write(slave, table, read_mem_cmd, sizeof(read_mem_cmd));
+    one_wire_test_host_read(slave, table, data, ONE_WIRE_TEST_MEMORY_SIZE);
+
+    size_t mismatches = 0;
+    for(size_t i = 0; i < ONE_WIRE_TEST_MEMORY_SIZE; i++) {
+        const size_t address = (ONE_WIRE_TEST_READ_MEM_ADDRESS + i) % ONE_WIRE_TEST_MEMORY_SIZE;
+        if(data[i] != memory[address]) mismatches++;
+    }
+
+    free(data);
+    return mismatches;
+}
+
+static void one_wire_test_slot_table(bool overdrive) {
+    const uint32_t ticks_per_us = furi_hal_cortex_instructions_per_microsecond();
+    uint8_t* memory = malloc(ONE_WIRE_TEST_MEMORY_SIZE);
+    furi_hal_random_fill_buf(memory, ONE_WIRE_TEST_MEMORY_SIZE);
+
+    OneWireHostSlotTable table;
+    onewire_host_get_slot_table(&table, overdrive, ticks_per_us);
+
+    OneWireTestSlave slave;
+    one_wire_test_slave_init(&slave, memory, overdrive, ticks_per_us);
+    const size_t mismatches = one_wire_test_read_mem(&slave, &table, memory);
+
+    FURI_LOG_I(
+        TAG,
+        "%s speed: 8 KiB memory read takes %lu ms of bus time",
+        overdrive ? "Overdrive" : "Standard",
+        (uint32_t)(slave.bus_ticks / ticks_per_us / 1000));
+
+    free(memory);
+
+    mu_assert_int_eq(0, slave.timing_errors);
+    mu_assert_int_eq(ONE_WIRE_TEST_CMD_READ_MEM, slave.command[0]);
+    mu_assert_int_eq(0, mismatches);
+}
+
+MU_TEST(one_wire_slot_table_normal_test) {
+    one_wire_test_slot_table(false);
+}
+
+MU_TEST(one_wire_slot_table_overdrive_test) {
+    one_wire_test_slot_table(true);
+}
+
+#define ONE_WIRE_TEST_BUS_EDGES_MAX (4U)
+
+/* Edges of the real bus, seen through the pin interrupt and timestamped in CPU cycles */
+typedef struct {
+    const GpioPin* pin;
+    uint32_t ticks[ONE_WIRE_TEST_BUS_EDGES_MAX];
+    bool levels[ONE_WIRE_TEST_BUS_EDGES_MAX];
+    volatile size_t count;
+} OneWireTestBus;
+
+static void one_wire_test_bus_callback(void* context) {
+    OneWireTestBus* bus = context;
+    if(bus->count < ONE_WIRE_TEST_BUS_EDGES_MAX) {
+        bus->ticks[bus->count] = DWT->CYCCNT;
+        bus->levels[bus->count] = furi_hal_gpio_read(bus->pin);
+        bus->count++;
+    }
+}
+
+/* Pin interrupt on top of the open drain output the host drives */
+static void one_wire_test_bus_start(OneWireTestBus* bus, OneWireHost* host, const GpioPin* pin) {
+    memset(bus, 0, sizeof(OneWireTestBus));
+    bus->pin = pin;
+
+    onewire_host_start(host);
+    furi_hal_gpio_add_int_callback(pin, one_wire_test_bus_callback, bus);
+    furi_hal_gpio_init(pin, GpioModeInterruptRiseFall, GpioPullNo, GpioSpeedLow);
+    LL_GPIO_SetPinOutputType(pin->port, pin->pin, LL_GPIO_OUTPUT_OPENDRAIN);
+    LL_GPIO_SetPinMode(pin->port, pin->pin, LL_GPIO_MODE_OUTPUT);
+}
+
+static void one_wire_test_bus_stop(OneWireTestBus* bus, OneWireHost* host) {
+    // Host stop resets pin mode, which also clears interrupt triggers
+    onewire_host_stop(host);
+    furi_hal_gpio_remove_int_callback(bus->pin);
+}
+
+/* Runs one bit slot on the real bus, returns its length in CPU cycles */
+static uint32_t
+    one_wire_test_bus_slot(OneWireTestBus* bus, OneWireHost* host, bool is_read, bool* bit) {
+    bus->count = 0;
+    const uint32_t start = DWT->CYCCNT;
+    if(is_read) {
+        *bit = onewire_host_read_bit(host);
+    } else {
+        onewire_host_write_bit(host, *bit);
+    }
+    return DWT->CYCCNT - start;
+}
+
+static void one_wire_test_bus_slots(bool overdrive) {
+    const OneWireTestSlaveTimings* timings = overdrive ? &one_wire_test_slave_timings_overdrive :
+                                                         &one_wire_test_slave_timings_normal;
+    const uint32_t tpu = furi_hal_cortex_instructions_per_microsecond();
+
+    OneWireHost* host = onewire_host_alloc(&gpio_ibutton);
+    onewire_host_set_overdrive(host, overdrive);
+    OneWireTestBus bus;
+    one_wire_test_bus_start(&bus, host, &gpio_ibutton);
+    const bool idle = furi_hal_gpio_read(&gpio_ibutton);
+
+    // Write 0 slot, interrupts are serviced while the bus is low at standard speed only
+    bool bit = false;
+    const uint32_t write_0_ticks = one_wire_test_bus_slot(&bus, host, false, &bit);
+    const size_t write_0_edges = bus.count;
+    const bool write_0_low = !bus.levels[0];
+    const uint32_t write_0_low_ticks = bus.ticks[1] - bus.ticks[0];
+
+    // Write 1 and read slots keep interrupts off, both edges show up as one afterwards
+    bit = true;
+    const uint32_t write_1_ticks = one_wire_test_bus_slot(&bus, host, false, &bit);
+    const size_t write_1_edges = bus.count;
+    bool read_bit = false;
+    const uint32_t read_ticks = one_wire_test_bus_slot(&bus, host, true, &read_bit);
+    const size_t read_edges = bus.count;
+
+    one_wire_test_bus_stop(&bus, host);
+    onewire_host_free(host);
+
+    mu_assert(idle, "Bus is not pulled up, iButton pin must be free");
+
+    if(overdrive) {
+        mu_assert_int_eq(1, write_0_edges);
+    } else {
+        mu_assert_int_eq(2, write_0_edges);
+        mu_assert(write_0_low, "Bus was not low in write 0 slot");
+        mu_assert(write_0_low_ticks >= timings->tw0l_min * tpu, "Write 0 low pulse is short");
+        mu_assert(write_0_low_ticks <= timings->tw0l_max * tpu, "Write 0 low pulse is long");
+    }
+    mu_assert_int_eq(1, write_1_edges);
+    mu_assert_int_eq(1, read_edges);
+    // Nothing else is on the bus, so the pull-up is read
+    mu_assert(read_bit, "Read 0 from an empty bus");
+
+    mu_assert(write_0_ticks >= timings->tslot_min * tpu, "Write 0 slot is short");
+    mu_assert(write_1_ticks >= timings->tslot_min * tpu, "Write 1 slot is short");
+    mu_assert(read_ticks >= timings->tslot_min * tpu, "Read slot is short");
+}
+
+MU_TEST(one_wire_bus_normal_test) {
+    one_wire_test_bus_slots(false);
+}
+
+MU_TEST(one_wire_bus_overdrive_test) {
+    one_wire_test_bus_slots(true);
+}
+
+MU_TEST_SUITE(one_wire_suite) {
+    MU_RUN_TEST(one_wire_slot_table_normal_test);
+    MU_RUN_TEST(one_wire_slot_table_overdrive_test);
+    MU_RUN_TEST(one_wire_bus_normal_test);
+    MU_RUN_TEST(one_wire_bus_overdrive_test);
+}
+
+int run_minunit_test_one_wire(void) {
+    MU_RUN_SUITE(one_wire_suite);
+    return MU_EXIT_CODE;
+}
+
+TEST_API_DEFINE(run_minunit_test_one_wire)
@@ -6,6 +6,7 @@
 #include <cli/cli.h>
 #include <storage/storage.h>
 #include <loader/loader.h>
+#include <gui/gui.h>
 #include <storage/filesystem_api_defines.h>
 
 #include <lib/toolbox/md5_calc.h>
@@ -19,6 +20,7 @@
 #include <pb_encode.h>
 #include <pb_decode.h>
 #include <storage.pb.h>
+#include <gui.pb.h>
 #include <flipper.pb.h>
 
 LIST_DEF(MsgList, PB_Main, M_POD_OPLIST)
@@ -50,6 +52,7 @@ static RpcSessionContext rpc_session[TEST_RPC_SESSIONS];
 #define TEST_DIR_NAME              EXT_PATH(".tmp/unit_tests/rpc")
 #define TEST_DIR                   TEST_DIR_NAME "/"
 #define MD5SUM_SIZE                16
+#define BENCHMARK_FILE_SIZE        (64 * 1024)
 
 #define PING_REQUEST  0
 #define PING_RESPONSE 1
@@ -1004,6 +1007,68 @@ MU_TEST(test_storage_read) {
     test_storage_read_run(TEST_DIR "file4.txt", ++command_id);
 }
 
+static size_t test_rpc_benchmark_heap_min = 0;
+
+static void
+    test_rpc_benchmark_output_bytes_callback(void* ctx, uint8_t* got_bytes, size_t got_size) {
+    test_rpc_benchmark_heap_min = MIN(test_rpc_benchmark_heap_min, memmgr_get_free_heap());
+    output_bytes_callback(ctx, got_bytes, got_size);
+}
+
+MU_TEST(test_storage_read_benchmark) {
+    test_create_file(TEST_DIR "benchmark.bin", BENCHMARK_FILE_SIZE);
+
+    PB_Main request;
+    test_rpc_create_simple_message(
+        &request, PB_Main_storage_read_request_tag, TEST_DIR "benchmark.bin", ++command_id);
+
+    rpc_session_set_send_bytes_callback(
+        rpc_session[0].session, test_rpc_benchmark_output_bytes_callback);
+    size_t heap_before = memmgr_get_free_heap();
+    test_rpc_benchmark_heap_min = heap_before;
+    uint32_t start = furi_get_tick();
+    test_rpc_encode_and_feed_one(&request, 0);
+
+    rpc_session[0].timeout = furi_get_tick() + MAX_RECEIVE_OUTPUT_TIMEOUT;
+    pb_istream_t istream = {
+        .callback = test_rpc_pb_stream_read,
+        .state = &rpc_session[0],
+        .errmsg = NULL,
+        .bytes_left = 0x7FFFFFFF,
+    };
+    PB_Main result = {.cb_content.funcs.decode = NULL};
+
+    size_t messages = 0;
+    size_t bytes = 0;
+    bool has_next = true;
+    while(has_next && pb_decode_ex(&istream, &PB_Main_msg, &result, PB_DECODE_DELIMITED)) {
+        messages++;
+        has_next = result.has_next;
+        if((result.which_content == PB_Main_storage_read_response_tag) &&
+           result.content.storage_read_response.file.data) {
+            bytes += result.content.storage_read_response.file.data->size;
+        }
+        pb_release(&PB_Main_msg, &result);
+        rpc_session[0].timeout = furi_get_tick() + MAX_RECEIVE_OUTPUT_TIMEOUT;
+    }
+    uint32_t ticks = MAX(furi_get_tick() - start, 1UL);
+
+    rpc_session_set_send_bytes_callback(rpc_session[0].session, output_bytes_callback);
+
+    FURI_LOG_I(
+        TAG,
+        "Storage read %zu bytes: %zu messages, %lu messages/s, %lu bytes/s, heap dip %zu bytes",
+        bytes,
+        messages,
+        (uint32_t)(messages * furi_kernel_get_tick_frequency() / ticks),
+        (uint32_t)(bytes * furi_kernel_get_tick_frequency() / ticks),
+        heap_before - test_rpc_benchmark_heap_min);
+
+    mu_assert(!has_next, "not all read responses decoded");
+    mu_assert_int_eq(BENCHMARK_FILE_SIZE, bytes);
+    mu_assert_int_eq(BENCHMARK_FILE_SIZE / MAX_DATA_SIZE, messages);
+}
+
 static void test_storage_write_run(
     const char* path,
     size_t write_size,
@@ -1498,6 +1563,7 @@ MU_TEST_SUITE(test_rpc_storage) {
     MU_RUN_TEST(test_storage_list_md5);
     MU_RUN_TEST(test_storage_list_size);
     MU_RUN_TEST(test_storage_read);
+    MU_RUN_TEST(test_storage_read_benchmark);
     MU_RUN_TEST(test_storage_write_read);
     MU_RUN_TEST(test_storage_write);
     MU_RUN_TEST(test_storage_delete);
@@ -1621,6 +1687,152 @@ MU_TEST_SUITE(test_rpc_app) {
     DISABLE_TEST(MU_RUN_TEST(test_app_start_and_lock_status););
 }
 
+#define TEST_RPC_GUI_FRAME_INTERVAL 20
+
+/* Recorded GUI session: menu idling with periodic redraws, scrolling down,
+ * an operation with progress bar and going back. Every entry is one commit,
+ * repeated entries are redraws without visible change.
+ */
+static const uint8_t test_rpc_gui_session[] = {
+    0,  0,  0,  0,  0,  1,  1,  2,  2,  3,  3,  3,  4,  4,  4,  4,  10, 10, 11, 11,
+    12, 12, 13, 13, 14, 14, 15, 15, 16, 16, 17, 17, 17, 17, 4,  4,  3,  2,  1,  0,
+    0,  0,  1,  2,  3,  4,  3,  2,  1,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+};
+
+static uint8_t test_rpc_gui_scene = 0;
+
+typedef struct {
+    uint32_t stop_command_id;
+    size_t frames;
+    size_t frame_bytes;
+    size_t repeated;
+    uint32_t first_frame_tick;
+    uint32_t last_frame_tick;
+} TestRpcGuiStats;
+
+static void test_rpc_gui_draw_callback(Canvas* canvas, void* context) {
+    UNUSED(context);
+    char text[16];
+    uint8_t scene = test_rpc_gui_scene;
+
+    canvas_clear(canvas);
+    canvas_set_font(canvas, FontSecondary);
+    if(scene < 10) {
+        for(uint8_t i = 0; i < 5; i++) {
+            snprintf(text, sizeof(text), "Item %d", i);
+            canvas_draw_str(canvas, 2, 11 + i * 12, text);
+        }
+        canvas_set_color(canvas, ColorXOR);
+        canvas_draw_box(canvas, 0, scene * 12, 128, 12);
+        canvas_set_color(canvas, ColorBlack);
+    } else {
+        snprintf(text, sizeof(text), "Step %d/8", scene - 9);
+        canvas_draw_str(canvas, 2, 11, text);
+        canvas_draw_frame(canvas, 0, 40, 128, 10);
+        canvas_draw_box(canvas, 0, 40, (scene - 9) * 16, 10);
+    }
+}
+
+static int32_t test_rpc_gui_receive_thread(void* context) {
+    TestRpcGuiStats* stats = context;
+    uint8_t* last_frame = NULL;
+
+    rpc_session[0].timeout = furi_get_tick() + MAX_RECEIVE_OUTPUT_TIMEOUT;
+    pb_istream_t istream = {
+        .callback = test_rpc_pb_stream_read,
+        .state = &rpc_session[0],
+        .errmsg = NULL,
+        .bytes_left = 0x7FFFFFFF,
+    };
+    PB_Main result = {.cb_content.funcs.decode = NULL};
+
+    while(true) {
+        size_t bytes_left = istream.bytes_left;
+        if(!pb_decode_ex(&istream, &PB_Main_msg, &result, PB_DECODE_DELIMITED)) break;
+        rpc_session[0].timeout = furi_get_tick() + MAX_RECEIVE_OUTPUT_TIMEOUT;
+
+        bool is_done = (result.which_content != PB_Main_gui_screen_frame_tag) &&
+                       (result.command_id == stats->stop_command_id);
+        if(result.which_content == PB_Main_gui_screen_frame_tag) {
+            pb_bytes_array_t* data = result.content.gui_screen_frame.data;
+            if(!last_frame) {
+                last_frame = malloc(data->size);
+                stats->first_frame_tick = furi_get_tick();
+            } else if(memcmp(last_frame, data->bytes, data->size) == 0) {
+                stats->repeated++;
+            }
+            memcpy(last_frame, data->bytes, data->size);
+            stats->frames++;
+            stats->frame_bytes += bytes_left - istream.bytes_left;
+            stats->last_frame_tick = furi_get_tick();
+        }
+        pb_release(&PB_Main_msg, &result);
+        if(is_done) break;
+    }
+
+    free(last_frame);
+
+    return 0;
+}
+
+MU_TEST(test_gui_screen_stream) {
+    TestRpcGuiStats stats = {0};
+
+    Gui* gui = furi_record_open(RECORD_GUI);
+    ViewPort* view_port = view_port_alloc();
+    view_port_draw_callback_set(view_port, test_rpc_gui_draw_callback, NULL);
+    test_rpc_gui_scene = test_rpc_gui_session[0];
+    gui_add_view_port(gui, view_port, GuiLayerFullscreen);
+
+    FuriThread* receive_thread =
+        furi_thread_alloc_ex("RpcGuiReceive", 2048, test_rpc_gui_receive_thread, &stats);
+    furi_thread_start(receive_thread);
+
+    PB_Main request;
+    test_rpc_fill_basic_message(
+        &request, PB_Main_gui_start_screen_stream_request_tag, ++command_id);
+    test_rpc_encode_and_feed_one(&request, 0);
+
+    // Replay the session
+    for(size_t i = 0; i < COUNT_OF(test_rpc_gui_session); i++) {
+        test_rpc_gui_scene = test_rpc_gui_session[i];
+        view_port_update(view_port);
+        furi_delay_ms(TEST_RPC_GUI_FRAME_INTERVAL);
+    }
+
+    stats.stop_command_id = ++command_id;
+    test_rpc_fill_basic_message(
+        &request, PB_Main_gui_stop_screen_stream_request_tag, stats.stop_command_id);
+    test_rpc_encode_and_feed_one(&request, 0);
+
+    furi_thread_join(receive_thread);
+    furi_thread_free(receive_thread);
+
+    gui_remove_view_port(gui, view_port);
+    view_port_free(view_port);
+    furi_record_close(RECORD_GUI);
+
+    uint32_t ticks = MAX(stats.last_frame_tick - stats.first_frame_tick, 1UL);
+    FURI_LOG_I(
+        TAG,
+        "Screen stream %zu commits: %zu frames, %zu bytes/frame, %lu frames/s, %zu repeated",
+        COUNT_OF(test_rpc_gui_session),
+        stats.frames,
+        stats.frames ? stats.frame_bytes / stats.frames : 0,
+        (uint32_t)(stats.frames * furi_kernel_get_tick_frequency() / ticks),
+        stats.repeated);
+
+    mu_assert(stats.frames > 0, "no screen frames received");
+    mu_assert(stats.frames <= COUNT_OF(test_rpc_gui_session), "more frames than commits");
+    mu_assert_int_eq(0, stats.repeated);
+}
+
+MU_TEST_SUITE(test_rpc_gui) {
+    MU_SUITE_CONFIGURE(&test_rpc_setup, &test_rpc_teardown);
+
+    MU_RUN_TEST(test_gui_screen_stream);
+}
+
 static void
     test_send_rubbish(RpcSession* session, const char* pattern, size_t pattern_size, size_t size) {
     UNUSED(session);
@@ -1850,6 +2062,7 @@ int run_minunit_test_rpc(void) {
     furi_record_close(RECORD_STORAGE);
     MU_RUN_SUITE(test_rpc_system);
     MU_RUN_SUITE(test_rpc_app);
+    MU_RUN_SUITE(test_rpc_gui);
     MU_RUN_SUITE(test_rpc_session);
 
     return MU_EXIT_CODE;
@@ -1,11 +1,14 @@
 #include "../test.h" // IWYU pragma: keep
 #include <furi.h>
+#include <furi_hal.h>
 #include <storage/storage.h>
 
 // DO NOT USE THIS IN PRODUCTION CODE
 // This is a hack to access internal storage functions and definitions
 #include <storage/storage_i.h>
 
+#define TAG "UnitTestsStorage"
+
 #define UNIT_TESTS_RESOURCES_PATH(path) EXT_PATH("unit_tests/" path)
 #define UNIT_TESTS_PATH(path)           EXT_PATH(".tmp/unit_tests/" path)
 
@@ -187,6 +190,196 @@ MU_TEST_SUITE(storage_file_64k) {
     MU_RUN_TEST(storage_file_read_write_64k);
 }
 
+#define STORAGE_BENCHMARK_DIR       UNIT_TESTS_PATH("benchmark")
+#define STORAGE_BENCHMARK_FILES     (100)
+#define STORAGE_BENCHMARK_FILE_SIZE (256 * 1024)
+#define STORAGE_BENCHMARK_CHUNK     (64)
+
+static uint32_t storage_benchmark_ticks_to_ms(uint32_t ticks) {
+    return ticks * 1000 / furi_kernel_get_tick_frequency();
+}
+
+static uint32_t storage_benchmark_read_commands(void) {
+    StorageSdStats stats;
+    storage_sd_get_stats(&stats);
+    return stats.read_commands;
+}
+
+MU_TEST(storage_sd_benchmark) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FuriString* path = furi_string_alloc();
+    File* file = storage_file_alloc(storage);
+    uint8_t* data = malloc(1024);
+
+    // Prepare: directory with long file names and a large file
+    storage_simply_remove_recursive(storage, STORAGE_BENCHMARK_DIR);
+    mu_assert_int_eq(FSE_OK, storage_common_mkdir(storage, STORAGE_BENCHMARK_DIR));
+    for(size_t i = 0; i < STORAGE_BENCHMARK_FILES; i++) {
+        furi_string_printf(path, "%s/benchmark_file_%03zu.txt", STORAGE_BENCHMARK_DIR, i);
+        mu_check(storage_file_create(storage, furi_string_get_cstr(path), "benchmark"));
+    }
+    for(size_t i = 0; i < 1024; i++) {
+        data[i] = i % 113;
+    }
+    mu_check(storage_file_open(
+        file, STORAGE_BENCHMARK_DIR "/large.bin", FSAM_WRITE, FSOM_CREATE_ALWAYS));
+    for(size_t i = 0; i < STORAGE_BENCHMARK_FILE_SIZE / 1024; i++) {
+        mu_assert_int_eq(1024, storage_file_write(file, data, 1024));
+    }
+    storage_file_close(file);
+
+    // Directory listing with stat of every entry, like file browser does
+    uint32_t commands = storage_benchmark_read_commands();
+    uint32_t start = furi_get_tick();
+    size_t entries = 0;
+    File* dir = storage_file_alloc(storage);
+    mu_check(storage_dir_open(dir, STORAGE_BENCHMARK_DIR));
+    char name[64];
+    while(storage_dir_read(dir, NULL, name, sizeof(name))) {
+        FileInfo fileinfo;
+        furi_string_printf(path, "%s/%s", STORAGE_BENCHMARK_DIR, name);
+        mu_assert_int_eq(
+            FSE_OK, storage_common_stat(storage, furi_string_get_cstr(path), &fileinfo));
+        entries++;
+    }
+    storage_dir_close(dir);
+    storage_file_free(dir);
+    uint32_t listing_ms = storage_benchmark_ticks_to_ms(furi_get_tick() - start);
+    uint32_t listing_commands = storage_benchmark_read_commands() - commands;
+
+    // Large file copy
+    commands = storage_benchmark_read_commands();
+    start = furi_get_tick();
+    mu_assert_int_eq(
+        FSE_OK,
+        storage_common_copy(
+            storage, STORAGE_BENCHMARK_DIR "/large.bin", STORAGE_BENCHMARK_DIR "/copy.bin"));
+    uint32_t copy_ms = storage_benchmark_ticks_to_ms(furi_get_tick() - start);
+    uint32_t copy_commands = storage_benchmark_read_commands() - commands;
+
+    // Reading in small chunks, like file parsers do
+    commands = storage_benchmark_read_commands();
+    start = furi_get_tick();
+    size_t errors = 0;
+    size_t offset = 0;
+    mu_check(storage_file_open(
+        file, STORAGE_BENCHMARK_DIR "/copy.bin", FSAM_READ, FSOM_OPEN_EXISTING));
+    size_t read;
+    while((read = storage_file_read(file, data, STORAGE_BENCHMARK_CHUNK)) > 0) {
+        for(size_t i = 0; i < read; i++, offset++) {
+            if(data[i] != (offset % 1024) % 113) errors++;
+        }
+    }
+    storage_file_close(file);
+    uint32_t read_ms = storage_benchmark_ticks_to_ms(furi_get_tick() - start);
+    uint32_t read_commands = storage_benchmark_read_commands() - commands;
+
+    // SD read commands are what the sector cache and read-ahead save, time also depends on card
+    FURI_LOG_I(
+        TAG,
+        "Listing %zu entries: %lums %lu reads, copy %d bytes: %lums %lu reads, "
+        "read in %d byte chunks: %lums %lu reads",
+        entries,
+        listing_ms,
+        listing_commands,
+        STORAGE_BENCHMARK_FILE_SIZE,
+        copy_ms,
+        copy_commands,
+        STORAGE_BENCHMARK_CHUNK,
+        read_ms,
+        read_commands);
+
+    storage_simply_remove_recursive(storage, STORAGE_BENCHMARK_DIR);
+    free(data);
+    storage_file_free(file);
+    furi_string_free(path);
+    furi_record_close(RECORD_STORAGE);
+
+    mu_assert_int_eq(STORAGE_BENCHMARK_FILES + 1, entries);
+    mu_assert_int_eq(STORAGE_BENCHMARK_FILE_SIZE, offset);
+    mu_assert_int_eq(0, errors);
+}
+
+#define STORAGE_INT_BENCHMARK_ROUNDS (10)
+
+/* Settings files saved over and over: sizes of desktop, dolphin, bt keys and notification */
+static const size_t storage_int_benchmark_sizes[] = {64, 128, 240, 400};
+
+MU_TEST(storage_int_benchmark) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FuriString* path = furi_string_alloc();
+    File* file = storage_file_alloc(storage);
+    uint8_t* data = malloc(512);
+    StorageIntStats before, after;
+    size_t written = 0;
+    size_t errors = 0;
+
+    storage_int_get_stats(&before);
+    uint32_t start = furi_get_tick();
+    for(size_t round = 0; round < STORAGE_INT_BENCHMARK_ROUNDS; round++) {
+        for(size_t i = 0; i < COUNT_OF(storage_int_benchmark_sizes); i++) {
+            const size_t size = storage_int_benchmark_sizes[i];
+            memset(data, round + i, size);
+            furi_string_printf(path, INT_PATH(".benchmark_%zu"), i);
+            if(storage_file_open(
+                   file, furi_string_get_cstr(path), FSAM_WRITE, FSOM_CREATE_ALWAYS) &&
+               storage_file_write(file, data, size) == size) {
+                written += size;
+            } else {
+                errors++;
+            }
+            storage_file_close(file);
+        }
+    }
+    uint32_t save_ms = storage_benchmark_ticks_to_ms(furi_get_tick() - start);
+
+    // Close syncs the file, low wear mode must not keep anything back after it
+    storage_int_get_stats(&after);
+
+    // Read back the last round
+    for(size_t i = 0; i < COUNT_OF(storage_int_benchmark_sizes); i++) {
+        const size_t size = storage_int_benchmark_sizes[i];
+        furi_string_printf(path, INT_PATH(".benchmark_%zu"), i);
+        memset(data, 0, size);
+        if(!storage_file_open(file, furi_string_get_cstr(path), FSAM_READ, FSOM_OPEN_EXISTING) ||
+           storage_file_read(file, data, size) != size) {
+            errors++;
+        }
+        storage_file_close(file);
+        for(size_t j = 0; j < size; j++) {
+            if(data[j] != (uint8_t)(STORAGE_INT_BENCHMARK_ROUNDS - 1 + i)) errors++;
+        }
+        storage_simply_remove(storage, furi_string_get_cstr(path));
+    }
+
+    const uint32_t prog_bytes = after.prog_bytes - before.prog_bytes;
+    FURI_LOG_I(
+        TAG,
+        "Int %s mode, %zu saves of %zu bytes: %lums, %luB programmed in %lu ops, "
+        "%lu pages erased, amplification %.2f",
+        furi_hal_rtc_get_storage_mode() == FuriHalRtcStorageModeLowWear ? "low wear" : "default",
+        STORAGE_INT_BENCHMARK_ROUNDS * COUNT_OF(storage_int_benchmark_sizes),
+        written,
+        save_ms,
+        prog_bytes,
+        after.prog_count - before.prog_count,
+        after.erase_count - before.erase_count,
+        (double)prog_bytes / (double)MAX(written, 1U));
+
+    free(data);
+    storage_file_free(file);
+    furi_string_free(path);
+    furi_record_close(RECORD_STORAGE);
+
+    mu_assert_int_eq(0, errors);
+    mu_assert_int_eq(written, after.write_bytes - before.write_bytes);
+}
+
+MU_TEST_SUITE(storage_benchmark) {
+    MU_RUN_TEST(storage_sd_benchmark);
+    MU_RUN_TEST(storage_int_benchmark);
+}
+
 MU_TEST(storage_dir_open_close) {
     Storage* storage = furi_record_open(RECORD_STORAGE);
     File* file;
@@ -754,6 +947,7 @@ MU_TEST_SUITE(test_md5_calc_suite) {
 int run_minunit_test_storage(void) {
     MU_RUN_SUITE(storage_file);
     MU_RUN_SUITE(storage_file_64k);
+    MU_RUN_SUITE(storage_benchmark);
     MU_RUN_SUITE(storage_dir);
     MU_RUN_SUITE(storage_rename);
     MU_RUN_SUITE(test_data_path);
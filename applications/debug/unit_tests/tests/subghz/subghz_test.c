@@ -4,8 +4,16 @@
 #include <lib/subghz/receiver.h>
 #include <lib/subghz/transmitter.h>
 #include <lib/subghz/subghz_keystore.h>
+#include <lib/subghz/subghz_keystore_i.h>
 #include <lib/subghz/subghz_file_encoder_worker.h>
+#include <lib/subghz/subghz_raw_file.h>
+#include <lib/subghz/subghz_hopper.h>
+#include <lib/subghz/subghz_spectrum.h>
+#include <lib/subghz/subghz_raw_dedup.h>
+#include <lib/subghz/subghz_tx_queue.h>
 #include <lib/subghz/protocols/protocol_items.h>
+#include <lib/subghz/protocols/keeloq_common.h>
+#include <lib/subghz/blocks/math.h>
 #include <flipper_format/flipper_format_i.h>
 #include <lib/subghz/devices/devices.h>
 #include <lib/subghz/devices/cc1101_configs.h>
@@ -20,6 +28,20 @@
 #define TEST_RANDOM_COUNT_PARSE 329
 #define TEST_TIMEOUT            10000
 
+#define TEST_RAW_DIR_NAME     EXT_PATH(".tmp/unit_tests/subghz")
+#define TEST_RAW_BINARY_PATH  TEST_RAW_DIR_NAME "/random_raw_binary.sub"
+#define TEST_RAW_TEXT_PATH    TEST_RAW_DIR_NAME "/random_raw_text.sub"
+#define TEST_RAW_WRITE_BLOCKS 64
+
+#define TEST_KEELOQ_KEYSTORE_PATH TEST_RAW_DIR_NAME "/keeloq_keystore.txt"
+#define TEST_KEELOQ_KEYS          1000
+#define TEST_KEELOQ_REMOTES       8
+#define TEST_KEELOQ_NLF           0x3A5C742EUL
+// Three slices of bitsliced keys, the last one partial
+#define TEST_KEELOQ_LEARNING_KEYS 80
+#define TEST_KEELOQ_CENTURION_KEY 42
+#define TEST_KEELOQ_SEED          0x5EED1234UL
+
 static SubGhzEnvironment* environment_handler;
 static SubGhzReceiver* receiver_handler;
 //static SubGhzTransmitter* transmitter_handler;
@@ -844,6 +866,1407 @@ MU_TEST(subghz_random_test) {
     mu_assert(subghz_decode_random_test(TEST_RANDOM_DIR_NAME), "Random test error\r\n");
 }
 
+typedef struct {
+    SubGhzRawFileFormat format;
+    size_t sample_count;
+    uint32_t hash;
+    uint32_t file_size;
+    uint32_t ticks;
+} SubGhzRawFileTestResult;
+
+static bool subghz_raw_file_test_read(const char* path, SubGhzRawFileTestResult* result) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FlipperFormat* flipper_format = flipper_format_file_alloc(storage);
+    SubGhzRawFile* raw_file = subghz_raw_file_alloc();
+    int32_t* samples = malloc(SUBGHZ_RAW_FILE_BLOCK_SIZE_MAX * sizeof(int32_t));
+    FuriString* temp_str = furi_string_alloc();
+    bool success = false;
+
+    memset(result, 0, sizeof(SubGhzRawFileTestResult));
+
+    if(flipper_format_file_open_existing(flipper_format, path) &&
+       flipper_format_read_string(flipper_format, "Protocol", temp_str)) {
+        result->file_size = stream_size(flipper_format_get_raw_stream(flipper_format));
+
+        uint32_t start = furi_get_tick();
+        result->format = subghz_raw_file_read_format(raw_file, flipper_format);
+        size_t count;
+        while((count = subghz_raw_file_read(
+                   raw_file, flipper_format, samples, SUBGHZ_RAW_FILE_BLOCK_SIZE_MAX)) > 0) {
+            for(size_t i = 0; i < count; i++) {
+                result->hash = result->hash * 31 + (uint32_t)samples[i];
+            }
+            result->sample_count += count;
+        }
+        result->ticks = furi_get_tick() - start;
+        success = true;
+    }
+
+    furi_string_free(temp_str);
+    free(samples);
+    subghz_raw_file_free(raw_file);
+    flipper_format_free(flipper_format);
+    furi_record_close(RECORD_STORAGE);
+
+    return success;
+}
+
+static uint32_t subghz_raw_file_test_write(const char* path, SubGhzRawFileFormat format) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FlipperFormat* flipper_format = flipper_format_file_alloc(storage);
+    SubGhzRawFile* raw_file = subghz_raw_file_alloc();
+    int32_t* samples = malloc(SUBGHZ_RAW_FILE_BLOCK_SIZE_MAX * sizeof(int32_t));
+    uint32_t ticks = 0;
+
+    for(size_t i = 0; i < SUBGHZ_RAW_FILE_BLOCK_SIZE_MAX; i++) {
+        int32_t duration = 50 + (int32_t)(furi_hal_random_get() % 2000);
+        samples[i] = (i % 2) ? -duration : duration;
+    }
+
+    if(flipper_format_file_open_always(flipper_format, path) &&
+       flipper_format_write_header_cstr(
+           flipper_format, SUBGHZ_RAW_FILE_TYPE, SUBGHZ_RAW_FILE_VERSION) &&
+       flipper_format_write_string_cstr(flipper_format, "Protocol", "RAW") &&
+       subghz_raw_file_write_format(raw_file, flipper_format, format)) {
+        uint32_t start = furi_get_tick();
+        size_t i = 0;
+        for(; i < TEST_RAW_WRITE_BLOCKS; i++) {
+            if(!subghz_raw_file_write(
+                   raw_file, flipper_format, samples, SUBGHZ_RAW_FILE_BLOCK_SIZE_MAX)) {
+                break;
+            }
+        }
+        if(i == TEST_RAW_WRITE_BLOCKS) ticks = furi_get_tick() - start;
+    }
+
+    free(samples);
+    subghz_raw_file_free(raw_file);
+    flipper_format_free(flipper_format);
+    furi_record_close(RECORD_STORAGE);
+
+    return ticks;
+}
+
+MU_TEST(subghz_raw_file_convert_test) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    mu_assert(storage_simply_mkdir(storage, TEST_RAW_DIR_NAME), "Cannot create test dir");
+
+    mu_assert(
+        subghz_raw_file_convert(
+            storage, TEST_RANDOM_DIR_NAME, TEST_RAW_BINARY_PATH, SubGhzRawFileFormatBinary),
+        "Convert to binary failed\r\n");
+    mu_assert(
+        subghz_raw_file_convert(
+            storage, TEST_RAW_BINARY_PATH, TEST_RAW_TEXT_PATH, SubGhzRawFileFormatText),
+        "Convert to text failed\r\n");
+    furi_record_close(RECORD_STORAGE);
+
+    SubGhzRawFileTestResult text, binary, text_back;
+    mu_assert(subghz_raw_file_test_read(TEST_RANDOM_DIR_NAME, &text), "Read text failed\r\n");
+    mu_assert(subghz_raw_file_test_read(TEST_RAW_BINARY_PATH, &binary), "Read binary failed\r\n");
+    mu_assert(subghz_raw_file_test_read(TEST_RAW_TEXT_PATH, &text_back), "Read back failed\r\n");
+
+    mu_assert(text.format == SubGhzRawFileFormatText, "Text format is not detected\r\n");
+    mu_assert(binary.format == SubGhzRawFileFormatBinary, "Binary format is not detected\r\n");
+    mu_assert(text_back.format == SubGhzRawFileFormatText, "Text format is not restored\r\n");
+
+    mu_assert(text.sample_count > 0, "No samples\r\n");
+    mu_assert_int_eq(text.sample_count, binary.sample_count);
+    mu_assert_int_eq(text.hash, binary.hash);
+    mu_assert_int_eq(text.sample_count, text_back.sample_count);
+    mu_assert_int_eq(text.hash, text_back.hash);
+    mu_assert(binary.file_size < text.file_size, "Binary file is not smaller\r\n");
+
+    FURI_LOG_I(
+        TAG,
+        "RAW %zu samples: text %lu bytes %lu ms, binary %lu bytes %lu ms",
+        text.sample_count,
+        text.file_size,
+        text.ticks,
+        binary.file_size,
+        binary.ticks);
+}
+
+MU_TEST(subghz_raw_file_skip_test) {
+    const size_t skip = SUBGHZ_RAW_FILE_BLOCK_SIZE_MAX * 3 + 100;
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FlipperFormat* binary = flipper_format_file_alloc(storage);
+    FlipperFormat* text = flipper_format_file_alloc(storage);
+    SubGhzRawFile* binary_file = subghz_raw_file_alloc();
+    SubGhzRawFile* text_file = subghz_raw_file_alloc();
+    int32_t* binary_samples = malloc(SUBGHZ_RAW_FILE_BLOCK_SIZE_MAX * sizeof(int32_t));
+    int32_t* text_samples = malloc(SUBGHZ_RAW_FILE_BLOCK_SIZE_MAX * sizeof(int32_t));
+    FuriString* temp_str = furi_string_alloc();
+
+    bool opened = flipper_format_file_open_existing(binary, TEST_RAW_BINARY_PATH) &&
+                  flipper_format_read_string(binary, "Protocol", temp_str) &&
+                  flipper_format_file_open_existing(text, TEST_RAW_TEXT_PATH) &&
+                  flipper_format_read_string(text, "Protocol", temp_str);
+
+    size_t binary_skipped = 0, text_skipped = 0;
+    size_t binary_count = 0, text_count = 0;
+    if(opened) {
+        subghz_raw_file_read_format(binary_file, binary);
+        subghz_raw_file_read_format(text_file, text);
+        binary_skipped = subghz_raw_file_skip(binary_file, binary, skip);
+        text_skipped = subghz_raw_file_skip(text_file, text, skip);
+        binary_count = subghz_raw_file_read(
+            binary_file, binary, binary_samples, SUBGHZ_RAW_FILE_BLOCK_SIZE_MAX);
+        text_count =
+            subghz_raw_file_read(text_file, text, text_samples, SUBGHZ_RAW_FILE_BLOCK_SIZE_MAX);
+    }
+    bool equal = binary_count == text_count &&
+                 !memcmp(binary_samples, text_samples, binary_count * sizeof(int32_t));
+
+    furi_string_free(temp_str);
+    free(text_samples);
+    free(binary_samples);
+    subghz_raw_file_free(text_file);
+    subghz_raw_file_free(binary_file);
+    flipper_format_free(text);
+    flipper_format_free(binary);
+    furi_record_close(RECORD_STORAGE);
+
+    mu_assert(opened, "Cannot open converted files\r\n");
+    mu_assert(binary_skipped > 0 && binary_skipped <= skip, "Wrong skip count\r\n");
+    mu_assert_int_eq(binary_skipped, text_skipped);
+    mu_assert(binary_count > 0, "No samples after skip\r\n");
+    mu_assert(equal, "Samples after skip differ\r\n");
+}
+
+MU_TEST(subghz_raw_file_binary_random_test) {
+    mu_assert(subghz_decode_random_test(TEST_RAW_BINARY_PATH), "Binary random test error\r\n");
+}
+
+MU_TEST(subghz_raw_file_benchmark) {
+    uint32_t text_write = subghz_raw_file_test_write(TEST_RAW_TEXT_PATH, SubGhzRawFileFormatText);
+    uint32_t binary_write =
+        subghz_raw_file_test_write(TEST_RAW_BINARY_PATH, SubGhzRawFileFormatBinary);
+
+    SubGhzRawFileTestResult text, binary;
+    mu_assert(subghz_raw_file_test_read(TEST_RAW_TEXT_PATH, &text), "Read text failed\r\n");
+    mu_assert(subghz_raw_file_test_read(TEST_RAW_BINARY_PATH, &binary), "Read binary failed\r\n");
+    mu_assert_int_eq(TEST_RAW_WRITE_BLOCKS * SUBGHZ_RAW_FILE_BLOCK_SIZE_MAX, text.sample_count);
+    mu_assert_int_eq(TEST_RAW_WRITE_BLOCKS * SUBGHZ_RAW_FILE_BLOCK_SIZE_MAX, binary.sample_count);
+
+    FURI_LOG_I(
+        TAG,
+        "RAW write: text %lu ms, binary %lu ms; read: text %lu ms, binary %lu ms; size: text %lu, binary %lu",
+        text_write,
+        binary_write,
+        text.ticks,
+        binary.ticks,
+        text.file_size,
+        binary.file_size);
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    mu_assert(storage_simply_remove_recursive(storage, TEST_RAW_DIR_NAME), "Cannot clean data");
+    furi_record_close(RECORD_STORAGE);
+}
+
+#define subghz_test_keeloq_bit(x, n) (((x) >> (n)) & 1U)
+#define subghz_test_keeloq_g5(x, a, b, c, d, e)                                          \
+    (subghz_test_keeloq_bit(x, a) + subghz_test_keeloq_bit(x, b) * 2 +                   \
+     subghz_test_keeloq_bit(x, c) * 4 + subghz_test_keeloq_bit(x, d) * 8 +               \
+     subghz_test_keeloq_bit(x, e) * 16)
+
+/* KeeLoq as in the datasheet, a bit per round */
+static uint32_t subghz_test_keeloq_encrypt(uint32_t data, uint64_t key) {
+    uint32_t x = data;
+    for(uint32_t r = 0; r < 528; r++) {
+        x = (x >> 1) ^ ((subghz_test_keeloq_bit(x, 0) ^ subghz_test_keeloq_bit(x, 16) ^
+                         (uint32_t)subghz_test_keeloq_bit(key, r & 63) ^
+                         subghz_test_keeloq_bit(
+                             TEST_KEELOQ_NLF, subghz_test_keeloq_g5(x, 1, 9, 20, 26, 31)))
+                        << 31);
+    }
+    return x;
+}
+
+static uint32_t subghz_test_keeloq_decrypt(uint32_t data, uint64_t key) {
+    uint32_t x = data;
+    for(uint32_t r = 0; r < 528; r++) {
+        x = (x << 1) ^ subghz_test_keeloq_bit(x, 31) ^ subghz_test_keeloq_bit(x, 15) ^
+            (uint32_t)subghz_test_keeloq_bit(key, (15 - r) & 63) ^
+            subghz_test_keeloq_bit(TEST_KEELOQ_NLF, subghz_test_keeloq_g5(x, 0, 8, 19, 25, 30));
+    }
+    return x;
+}
+
+static uint64_t subghz_test_keeloq_normal_learning(uint32_t fix, uint64_t key) {
+    uint32_t serial = fix & 0x0FFFFFFF;
+    return (uint64_t)subghz_test_keeloq_decrypt(serial | 0x60000000, key) << 32 |
+           subghz_test_keeloq_decrypt(serial | 0x20000000, key);
+}
+
+/* Linear search over all keys, the way KeeLoq decoder used to do it */
+static int32_t subghz_test_keeloq_find_key(
+    const uint64_t* keys,
+    uint32_t fix,
+    uint32_t hop,
+    uint32_t* cnt) {
+    for(int32_t i = 0; i < TEST_KEELOQ_KEYS; i++) {
+        uint32_t decrypt =
+            subghz_test_keeloq_decrypt(hop, subghz_test_keeloq_normal_learning(fix, keys[i]));
+        uint32_t end_serial = (decrypt >> 16) & 0xFF;
+        if((decrypt >> 28 == fix >> 28) && ((end_serial == (fix & 0xFF)) || (end_serial == 0))) {
+            *cnt = decrypt & 0xFFFF;
+            return i;
+        }
+    }
+    return -1;
+}
+
+static void subghz_test_keeloq_key_name(FuriString* name, int32_t index, int32_t centurion_key) {
+    if(index == centurion_key) {
+        furi_string_set(name, "Centurion");
+    } else {
+        furi_string_printf(name, "Test_%04ld", index);
+    }
+}
+
+static uint64_t* subghz_test_keeloq_keys_alloc(size_t count) {
+    uint64_t* keys = malloc(count * sizeof(uint64_t));
+    uint64_t seed = 0x5DEECE66DULL;
+    for(size_t i = 0; i < count; i++) {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        keys[i] = seed;
+    }
+    return keys;
+}
+
+/* Keys are of normal learning type if types is NULL */
+static bool subghz_test_keeloq_write_keystore(
+    const uint64_t* keys,
+    const uint8_t* types,
+    size_t count,
+    int32_t centurion_key) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    bool written = storage_simply_mkdir(storage, TEST_RAW_DIR_NAME);
+    File* file = storage_file_alloc(storage);
+    FuriString* name = furi_string_alloc();
+    FuriString* line = furi_string_alloc_set("Filetype: Flipper SubGhz Keystore File\n"
+                                             "Version: 0\n"
+                                             "Encryption: 0\n");
+    written = written &&
+              storage_file_open(file, TEST_KEELOQ_KEYSTORE_PATH, FSAM_WRITE, FSOM_CREATE_ALWAYS);
+    for(size_t i = 0; (i < count) && written; i++) {
+        subghz_test_keeloq_key_name(name, i, centurion_key);
+        furi_string_cat_printf(
+            line,
+            "%08lX%08lX:%u:%s\n",
+            (uint32_t)(keys[i] >> 32),
+            (uint32_t)keys[i],
+            types ? types[i] : KEELOQ_LEARNING_NORMAL,
+            furi_string_get_cstr(name));
+        size_t size = furi_string_size(line);
+        written = storage_file_write(file, furi_string_get_cstr(line), size) == size;
+        furi_string_reset(line);
+    }
+    furi_string_free(line);
+    furi_string_free(name);
+    storage_file_free(file);
+    furi_record_close(RECORD_STORAGE);
+    return written;
+}
+
+static bool subghz_test_keeloq_decode_remote(
+    SubGhzProtocolDecoderBase* decoder,
+    FlipperFormat* flipper_format,
+    uint64_t data,
+    uint32_t seed,
+    const char* manufacture_name,
+    uint32_t cnt) {
+    uint8_t key_data[sizeof(uint64_t)];
+    for(size_t j = 0; j < sizeof(uint64_t); j++) {
+        key_data[j] = data >> (56 - j * 8);
+    }
+    uint8_t seed_data[sizeof(uint32_t)];
+    for(size_t j = 0; j < sizeof(uint32_t); j++) {
+        seed_data[j] = seed >> (24 - j * 8);
+    }
+    uint32_t bits = 64;
+    Stream* stream = flipper_format_get_raw_stream(flipper_format);
+    stream_clean(stream);
+    flipper_format_write_uint32(flipper_format, "Bit", &bits, 1);
+    flipper_format_write_hex(flipper_format, "Key", key_data, sizeof(key_data));
+    flipper_format_write_hex(flipper_format, "Seed", seed_data, sizeof(seed_data));
+
+    // Forget manufacture of the previous remote
+    decoder->protocol->decoder->reset(decoder);
+    if(subghz_protocol_decoder_base_deserialize(decoder, flipper_format) !=
+       SubGhzProtocolStatusOk) {
+        return false;
+    }
+    FuriString* text = furi_string_alloc();
+    FuriString* expected = furi_string_alloc();
+    subghz_protocol_decoder_base_get_string(decoder, text);
+
+    furi_string_printf(expected, "MF:%s", manufacture_name);
+    bool decoded = furi_string_search_str(text, furi_string_get_cstr(expected), 0) !=
+                   FURI_STRING_FAILURE;
+    furi_string_printf(expected, "Cnt:%04lX", cnt);
+    decoded = decoded && (furi_string_search_str(text, furi_string_get_cstr(expected), 0) !=
+                          FURI_STRING_FAILURE);
+
+    furi_string_free(expected);
+    furi_string_free(text);
+    return decoded;
+}
+
+static uint32_t subghz_test_keeloq_decode(
+    SubGhzProtocolDecoderBase* decoder,
+    const uint64_t* data,
+    const int32_t* key_index,
+    const uint32_t* cnt) {
+    FlipperFormat* flipper_format = flipper_format_string_alloc();
+    FuriString* name = furi_string_alloc();
+    uint32_t decoded = 0;
+
+    for(size_t i = 0; i < TEST_KEELOQ_REMOTES; i++) {
+        subghz_test_keeloq_key_name(name, key_index[i], -1);
+        if(subghz_test_keeloq_decode_remote(
+               decoder, flipper_format, data[i], 0, furi_string_get_cstr(name), cnt[i])) {
+            decoded++;
+        }
+    }
+
+    furi_string_free(name);
+    flipper_format_free(flipper_format);
+
+    return decoded;
+}
+
+/* Manufacture key of a remote, derived the way the scalar KeeLoq decoder does it */
+static uint64_t subghz_test_keeloq_learning_man(
+    uint8_t learning,
+    bool mirrored,
+    uint32_t fix,
+    uint32_t seed,
+    uint64_t key) {
+    if(mirrored) {
+        key = __builtin_bswap64(key);
+    }
+
+    switch(learning) {
+    case KEELOQ_LEARNING_SIMPLE:
+        return key;
+    case KEELOQ_LEARNING_NORMAL:
+        return subghz_protocol_keeloq_common_normal_learning(fix, key);
+    case KEELOQ_LEARNING_SECURE:
+        return subghz_protocol_keeloq_common_secure_learning(fix, seed, key);
+    case KEELOQ_LEARNING_MAGIC_XOR_TYPE_1:
+        return subghz_protocol_keeloq_common_magic_xor_type1_learning(fix, key);
+    case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_1:
+        return subghz_protocol_keeloq_common_magic_serial_type1_learning(fix, key);
+    case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_2:
+        return subghz_protocol_keeloq_common_magic_serial_type2_learning(fix, key);
+    case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_3:
+        return subghz_protocol_keeloq_common_magic_serial_type3_learning(fix, key);
+    default:
+        furi_crash();
+    }
+}
+
+/* Learnings tried for keys of unknown type, each one as is and mirrored */
+static const uint8_t subghz_test_keeloq_unknown_learnings[] = {
+    KEELOQ_LEARNING_SIMPLE,
+    KEELOQ_LEARNING_NORMAL,
+    KEELOQ_LEARNING_SECURE,
+    KEELOQ_LEARNING_MAGIC_XOR_TYPE_1,
+};
+
+/* Key by key, learning by learning search over the keystore, in the scalar decoder order */
+static int32_t subghz_test_keeloq_find_key_scalar(
+    const uint64_t* keys,
+    const uint8_t* types,
+    uint32_t fix,
+    uint32_t hop,
+    uint8_t* kl_type,
+    uint32_t* cnt) {
+    for(int32_t i = 0; i < TEST_KEELOQ_LEARNING_KEYS; i++) {
+        const bool unknown = types[i] == KEELOQ_LEARNING_UNKNOWN;
+        const size_t variants = unknown ? COUNT_OF(subghz_test_keeloq_unknown_learnings) * 2 : 1;
+        for(size_t variant = 0; variant < variants; variant++) {
+            const uint8_t learning =
+                unknown ? subghz_test_keeloq_unknown_learnings[variant / 2] : types[i];
+            const uint64_t man = subghz_test_keeloq_learning_man(
+                learning, unknown && (variant & 1), fix, TEST_KEELOQ_SEED, keys[i]);
+            const uint32_t decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
+
+            bool match = (decrypt >> 28) == (fix >> 28);
+            if((i == TEST_KEELOQ_CENTURION_KEY) && !unknown) {
+                match = match && (((decrypt >> 16) & 0x3FF) == 0x1CE);
+            } else {
+                const uint32_t end_serial = (decrypt >> 16) & 0xFF;
+                match = match && ((end_serial == (fix & 0xFF)) || (end_serial == 0));
+            }
+            if(match) {
+                *kl_type = unknown ? learning : 0;
+                *cnt = decrypt & 0xFFFF;
+                return i;
+            }
+        }
+    }
+    return -1;
+}
+
+typedef struct {
+    uint8_t key_index;
+    uint8_t learning;
+    bool mirrored;
+} SubGhzTestKeeloqRemote;
+
+/* Key types repeat every 8 keys: unknown, simple, normal, secure, magic xor, magic serial 1-3 */
+static const SubGhzTestKeeloqRemote subghz_test_keeloq_learning_remotes[] = {
+    {65, KEELOQ_LEARNING_SIMPLE, false},
+    {0, KEELOQ_LEARNING_SIMPLE, false},
+    {8, KEELOQ_LEARNING_SIMPLE, true},
+    {66, KEELOQ_LEARNING_NORMAL, false},
+    {16, KEELOQ_LEARNING_NORMAL, false},
+    {24, KEELOQ_LEARNING_NORMAL, true},
+    {67, KEELOQ_LEARNING_SECURE, false},
+    {32, KEELOQ_LEARNING_SECURE, false},
+    {40, KEELOQ_LEARNING_SECURE, true},
+    {68, KEELOQ_LEARNING_MAGIC_XOR_TYPE_1, false},
+    {48, KEELOQ_LEARNING_MAGIC_XOR_TYPE_1, false},
+    {56, KEELOQ_LEARNING_MAGIC_XOR_TYPE_1, true},
+    {69, KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_1, false},
+    {70, KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_2, false},
+    {71, KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_3, false},
+    // Normal key next to Centurion in the same slice still checks 8 serial bits
+    {34, KEELOQ_LEARNING_NORMAL, false},
+    {TEST_KEELOQ_CENTURION_KEY, KEELOQ_LEARNING_NORMAL, false},
+};
+
+static const uint8_t subghz_test_keeloq_type_cycle[] = {
+    KEELOQ_LEARNING_UNKNOWN,
+    KEELOQ_LEARNING_SIMPLE,
+    KEELOQ_LEARNING_NORMAL,
+    KEELOQ_LEARNING_SECURE,
+    KEELOQ_LEARNING_MAGIC_XOR_TYPE_1,
+    KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_1,
+    KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_2,
+    KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_3,
+};
+
+/* Remote made with one of the keys, in a way that depends on the key learning type */
+static void subghz_test_keeloq_learning_remote(
+    const uint64_t* keys,
+    size_t index,
+    uint32_t* fix,
+    uint32_t* hop) {
+    const SubGhzTestKeeloqRemote* remote = &subghz_test_keeloq_learning_remotes[index];
+    const uint32_t btn = 1 << (index % 4);
+    *fix = btn << 28 | (0x0A5C3E1 + index * 0x10307);
+    const uint32_t end_serial =
+        (remote->key_index == TEST_KEELOQ_CENTURION_KEY) ? 0x1CE : (*fix & 0xFF);
+    const uint64_t man = subghz_test_keeloq_learning_man(
+        remote->learning, remote->mirrored, *fix, TEST_KEELOQ_SEED, keys[remote->key_index]);
+    *hop = subghz_protocol_keeloq_common_encrypt(
+        btn << 28 | end_serial << 16 | (0x100 + index), man);
+}
+
+MU_TEST(subghz_keeloq_keystore_benchmark) {
+    uint64_t* keys = subghz_test_keeloq_keys_alloc(TEST_KEELOQ_KEYS);
+    bool written = subghz_test_keeloq_write_keystore(keys, NULL, TEST_KEELOQ_KEYS, -1);
+    mu_assert(written, "Cannot write keystore");
+
+    // Remotes paired with keys at the end of the keystore, the worst case for a linear search
+    uint64_t data[TEST_KEELOQ_REMOTES];
+    int32_t key_index[TEST_KEELOQ_REMOTES];
+    uint32_t cnt[TEST_KEELOQ_REMOTES];
+    for(size_t i = 0; i < TEST_KEELOQ_REMOTES; i++) {
+        uint64_t key = keys[TEST_KEELOQ_KEYS - 1 - i * 3];
+        uint32_t btn = 1 << (i % 4);
+        uint32_t fix = btn << 28 | (0x0A5C3E1 + i * 0x10307);
+        uint32_t hop = subghz_test_keeloq_encrypt(
+            btn << 28 | (fix & 0xFF) << 16 | (0x100 + i),
+            subghz_test_keeloq_normal_learning(fix, key));
+        data[i] = subghz_protocol_blocks_reverse_key((uint64_t)fix << 32 | hop, 64);
+    }
+
+    // Expected results come from the reference search, should another key happen to match first
+    uint32_t start = furi_get_tick();
+    for(size_t i = 0; i < TEST_KEELOQ_REMOTES; i++) {
+        uint64_t key = subghz_protocol_blocks_reverse_key(data[i], 64);
+        key_index[i] = subghz_test_keeloq_find_key(keys, key >> 32, key, &cnt[i]);
+    }
+    uint32_t reference = furi_get_tick() - start;
+    free(keys);
+
+    SubGhzEnvironment* environment = subghz_environment_alloc();
+    subghz_environment_set_protocol_registry(environment, (void*)&subghz_protocol_registry);
+    start = furi_get_tick();
+    bool loaded = subghz_environment_load_keystore(environment, TEST_KEELOQ_KEYSTORE_PATH);
+    uint32_t load = furi_get_tick() - start;
+    SubGhzReceiver* receiver = subghz_receiver_alloc_init(environment);
+    SubGhzProtocolDecoderBase* decoder =
+        subghz_receiver_search_decoder_base_by_name(receiver, SUBGHZ_PROTOCOL_KEELOQ_NAME);
+
+    uint32_t search = 0, cached = 0, search_decoded = 0, cached_decoded = 0;
+    if(loaded && decoder) {
+        start = furi_get_tick();
+        search_decoded = subghz_test_keeloq_decode(decoder, data, key_index, cnt);
+        search = furi_get_tick() - start;
+
+        // Same remotes again, keys found for their serial numbers are tried first
+        start = furi_get_tick();
+        cached_decoded = subghz_test_keeloq_decode(decoder, data, key_index, cnt);
+        cached = furi_get_tick() - start;
+    }
+
+    subghz_receiver_free(receiver);
+    subghz_environment_free(environment);
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    mu_assert(storage_simply_remove_recursive(storage, TEST_RAW_DIR_NAME), "Cannot clean data");
+    furi_record_close(RECORD_STORAGE);
+
+    FURI_LOG_I(
+        TAG,
+        "KeeLoq %d remotes, %d keys: load %lu ms; decode: linear %lu ms, indexed %lu ms, cached %lu ms",
+        TEST_KEELOQ_REMOTES,
+        TEST_KEELOQ_KEYS,
+        load,
+        reference,
+        search,
+        cached);
+
+    mu_assert(loaded, "Cannot load keystore");
+    mu_assert(decoder, "KeeLoq decoder not found");
+    for(size_t i = 0; i < TEST_KEELOQ_REMOTES; i++) {
+        mu_assert(key_index[i] >= 0, "Reference search failed");
+    }
+    mu_assert_int_eq(TEST_KEELOQ_REMOTES, search_decoded);
+    mu_assert_int_eq(TEST_KEELOQ_REMOTES, cached_decoded);
+    mu_assert(search <= reference, "Indexed search is slower than linear");
+    mu_assert(cached <= search, "Cached search is slower than indexed");
+}
+
+MU_TEST(subghz_keeloq_keystore_learning_test) {
+    uint64_t* keys = subghz_test_keeloq_keys_alloc(TEST_KEELOQ_LEARNING_KEYS);
+    uint8_t types[TEST_KEELOQ_LEARNING_KEYS];
+    for(size_t i = 0; i < TEST_KEELOQ_LEARNING_KEYS; i++) {
+        types[i] = subghz_test_keeloq_type_cycle[i % COUNT_OF(subghz_test_keeloq_type_cycle)];
+    }
+    bool written = subghz_test_keeloq_write_keystore(
+        keys, types, TEST_KEELOQ_LEARNING_KEYS, TEST_KEELOQ_CENTURION_KEY);
+
+    SubGhzEnvironment* environment = subghz_environment_alloc();
+    subghz_environment_set_protocol_registry(environment, (void*)&subghz_protocol_registry);
+    bool loaded =
+        written && subghz_environment_load_keystore(environment, TEST_KEELOQ_KEYSTORE_PATH);
+    SubGhzKeystore* keystore = subghz_environment_get_keystore(environment);
+    SubGhzReceiver* receiver = subghz_receiver_alloc_init(environment);
+    SubGhzProtocolDecoderBase* decoder =
+        subghz_receiver_search_decoder_base_by_name(receiver, SUBGHZ_PROTOCOL_KEELOQ_NAME);
+    FlipperFormat* flipper_format = flipper_format_string_alloc();
+    FuriString* name = furi_string_alloc();
+
+    int32_t scalar_mismatch = -1, decode_mismatch = -1;
+    for(size_t i = 0; (i < COUNT_OF(subghz_test_keeloq_learning_remotes)) && loaded && decoder;
+        i++) {
+        uint32_t fix, hop;
+        subghz_test_keeloq_learning_remote(keys, i, &fix, &hop);
+
+        // Scalar search must find the key the remote was made with, or the case tests nothing
+        uint8_t kl_type = 0;
+        uint32_t cnt = 0;
+        int32_t key_index =
+            subghz_test_keeloq_find_key_scalar(keys, types, fix, hop, &kl_type, &cnt);
+        if((key_index != subghz_test_keeloq_learning_remotes[i].key_index) &&
+           (scalar_mismatch < 0)) {
+            scalar_mismatch = i;
+        }
+
+        // Full search first, then the key remembered for the serial number
+        subghz_test_keeloq_key_name(name, key_index, TEST_KEELOQ_CENTURION_KEY);
+        const uint64_t data = subghz_protocol_blocks_reverse_key((uint64_t)fix << 32 | hop, 64);
+        for(size_t pass = 0; pass < 2; pass++) {
+            bool decoded = subghz_test_keeloq_decode_remote(
+                decoder, flipper_format, data, TEST_KEELOQ_SEED, furi_string_get_cstr(name), cnt);
+            if((!decoded || (keystore->kl_type != kl_type)) && (decode_mismatch < 0)) {
+                decode_mismatch = i;
+            }
+        }
+    }
+
+    furi_string_free(name);
+    flipper_format_free(flipper_format);
+    subghz_receiver_free(receiver);
+    subghz_environment_free(environment);
+    free(keys);
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    mu_assert(storage_simply_remove_recursive(storage, TEST_RAW_DIR_NAME), "Cannot clean data");
+    furi_record_close(RECORD_STORAGE);
+
+    mu_assert(written, "Cannot write keystore");
+    mu_assert(loaded, "Cannot load keystore");
+    mu_assert(decoder, "KeeLoq decoder not found");
+    mu_assert_int_eq(-1, scalar_mismatch);
+    mu_assert_int_eq(-1, decode_mismatch);
+}
+
+#define TEST_HOPPER_FREQUENCIES 6
+#define TEST_HOPPER_TICKS       50000
+
+static uint32_t subghz_hopper_test_random(uint32_t* state) {
+    // xorshift32, reproducible unlike furi_hal_random
+    *state ^= *state << 13;
+    *state ^= *state >> 17;
+    *state ^= *state << 5;
+    return *state;
+}
+
+// Share of transmissions that started on a frequency while a slot listened to it at any point
+static float subghz_hopper_test_capture(
+    const float* traffic,
+    SubGhzHopperMode mode,
+    uint8_t slot_count,
+    float* estimate) {
+    SubGhzHopper* hopper = subghz_hopper_alloc(TEST_HOPPER_FREQUENCIES, slot_count);
+    subghz_hopper_set_mode(hopper, mode);
+
+    uint32_t random = 7;
+    uint8_t remain[TEST_HOPPER_FREQUENCIES] = {};
+    bool captured[TEST_HOPPER_FREQUENCIES] = {};
+    uint32_t total = 0, capture = 0;
+    float traffic_total = 0.0f;
+    for(size_t i = 0; i < TEST_HOPPER_FREQUENCIES; i++) {
+        traffic_total += traffic[i];
+    }
+
+    for(uint32_t tick = 0; tick < TEST_HOPPER_TICKS; tick++) {
+        // 1.5% chance per tick of a 1 to 6 ticks long transmission
+        if(subghz_hopper_test_random(&random) % 1000 < 15) {
+            float r = (float)(subghz_hopper_test_random(&random) % 10000) / 10000.0f *
+                      traffic_total;
+            size_t idx = 0;
+            for(; idx < TEST_HOPPER_FREQUENCIES - 1; idx++) {
+                if(r < traffic[idx]) break;
+                r -= traffic[idx];
+            }
+            if(!remain[idx]) {
+                remain[idx] = 1 + subghz_hopper_test_random(&random) % 6;
+                captured[idx] = false;
+                total++;
+            }
+        }
+
+        for(uint8_t slot = 0; slot < slot_count; slot++) {
+            size_t idx = subghz_hopper_get_frequency_idx(hopper, slot);
+            float rssi = -95.0f;
+            if(remain[idx]) {
+                rssi = -50.0f;
+                if(!captured[idx]) {
+                    captured[idx] = true;
+                    capture++;
+                    subghz_hopper_add_hit(hopper, slot);
+                }
+            }
+            subghz_hopper_update(hopper, slot, rssi, -70.0f);
+        }
+
+        for(size_t i = 0; i < TEST_HOPPER_FREQUENCIES; i++) {
+            if(remain[i]) remain[i]--;
+        }
+    }
+
+    *estimate = subghz_hopper_get_capture_probability(hopper);
+    subghz_hopper_free(hopper);
+
+    return total ? (float)capture / (float)total : 0.0f;
+}
+
+MU_TEST(subghz_hopper_test) {
+    const float skewed[TEST_HOPPER_FREQUENCIES] = {0.0f, 0.0f, 0.3f, 0.0f, 1.0f, 0.1f};
+    const float uniform[TEST_HOPPER_FREQUENCIES] = {1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f};
+
+    for(uint8_t slot_count = 1; slot_count <= SUBGHZ_HOPPER_SLOTS_MAX; slot_count++) {
+        float estimate;
+        float skewed_rr =
+            subghz_hopper_test_capture(skewed, SubGhzHopperModeRoundRobin, slot_count, &estimate);
+        float skewed_adaptive =
+            subghz_hopper_test_capture(skewed, SubGhzHopperModeAdaptive, slot_count, &estimate);
+        float uniform_rr =
+            subghz_hopper_test_capture(uniform, SubGhzHopperModeRoundRobin, slot_count, &estimate);
+        float uniform_adaptive =
+            subghz_hopper_test_capture(uniform, SubGhzHopperModeAdaptive, slot_count, &estimate);
+
+        FURI_LOG_I(
+            TAG,
+            "Hopper %u slots: skewed rr %.3f adaptive %.3f, uniform rr %.3f adaptive %.3f (est %.3f)",
+            slot_count,
+            (double)skewed_rr,
+            (double)skewed_adaptive,
+            (double)uniform_rr,
+            (double)uniform_adaptive,
+            (double)estimate);
+
+        mu_assert(skewed_adaptive > skewed_rr, "Adaptive hopper is worse on skewed traffic");
+        mu_assert(
+            uniform_adaptive >= uniform_rr * 0.9f, "Adaptive hopper is worse on uniform traffic");
+        mu_assert(estimate > 0.0f && estimate <= 1.0f, "Capture estimate out of range");
+    }
+}
+
+#define TEST_SPECTRUM_SIZE        SUBGHZ_SPECTRUM_SIZE_MAX
+#define TEST_SPECTRUM_SAMPLE_RATE 20000
+#define TEST_SPECTRUM_RUNS        1000
+
+static void subghz_spectrum_test_tone(int16_t* samples, size_t bin, float amplitude) {
+    for(size_t i = 0; i < TEST_SPECTRUM_SIZE; i++) {
+        samples[i] =
+            (int16_t)(amplitude * cosf(2.0f * (float)M_PI * bin * i / TEST_SPECTRUM_SIZE));
+    }
+}
+
+MU_TEST(subghz_spectrum_fft_test) {
+    int16_t samples[TEST_SPECTRUM_SIZE];
+    int16_t re[TEST_SPECTRUM_SIZE];
+    int16_t im[TEST_SPECTRUM_SIZE];
+
+    subghz_spectrum_test_tone(samples, 5, 16000.0f);
+    memcpy(re, samples, sizeof(re));
+    memset(im, 0, sizeof(im));
+    subghz_spectrum_fft(re, im, TEST_SPECTRUM_SIZE);
+
+    // Real tone splits evenly between positive and negative frequency
+    mu_assert(abs(re[5] - 8000) < 64 && abs(im[5]) < 64, "Wrong FFT tone bin");
+    for(size_t k = 1; k < TEST_SPECTRUM_SIZE / 2; k++) {
+        if(k == 5) continue;
+        mu_assert(abs(re[k]) < 64 && abs(im[k]) < 64, "FFT leaks into other bins");
+    }
+
+    // Goertzel is the same DFT bin, also between bins
+    uint32_t fft_power = re[5] * re[5] + im[5] * im[5];
+    uint32_t goertzel_power = subghz_spectrum_goertzel(
+        samples,
+        TEST_SPECTRUM_SIZE,
+        subghz_spectrum_goertzel_coeff(
+            5 * TEST_SPECTRUM_SAMPLE_RATE / TEST_SPECTRUM_SIZE, TEST_SPECTRUM_SAMPLE_RATE));
+    mu_assert(
+        goertzel_power > fft_power * 0.97f && goertzel_power < fft_power * 1.03f,
+        "Goertzel doesn't match FFT");
+    uint32_t off_power = subghz_spectrum_goertzel(
+        samples,
+        TEST_SPECTRUM_SIZE,
+        subghz_spectrum_goertzel_coeff(
+            11 * TEST_SPECTRUM_SAMPLE_RATE / TEST_SPECTRUM_SIZE, TEST_SPECTRUM_SAMPLE_RATE));
+    mu_assert(off_power < fft_power / 1000, "Goertzel responds to other bins");
+}
+
+MU_TEST(subghz_spectrum_modulation_test) {
+    int16_t envelope[TEST_SPECTRUM_SIZE];
+    uint32_t keying_frequency;
+    uint32_t random = 7;
+
+    // Steady carrier, RSSI jitters by about a dB
+    for(size_t i = 0; i < TEST_SPECTRUM_SIZE; i++) {
+        int32_t noise = (int32_t)(subghz_hopper_test_random(&random) % 128) - 64;
+        envelope[i] = -60 * SUBGHZ_SPECTRUM_ENVELOPE_SCALE + noise;
+    }
+    mu_assert(
+        subghz_spectrum_get_modulation(
+            envelope, TEST_SPECTRUM_SIZE, TEST_SPECTRUM_SAMPLE_RATE, &keying_frequency) ==
+            SubGhzSpectrumModulationCarrier,
+        "Carrier is detected as keyed");
+    mu_assert_int_eq(0, keying_frequency);
+
+    // OOK preamble, 1.6 kHz symbol rate, falls between FFT bins
+    const float keying = 800.0f;
+    for(size_t i = 0; i < TEST_SPECTRUM_SIZE; i++) {
+        int32_t noise = (int32_t)(subghz_hopper_test_random(&random) % 128) - 64;
+        bool is_on = fmodf(i * keying / TEST_SPECTRUM_SAMPLE_RATE, 1.0f) < 0.5f;
+        envelope[i] = (is_on ? -50 : -95) * SUBGHZ_SPECTRUM_ENVELOPE_SCALE + noise;
+    }
+    mu_assert(
+        subghz_spectrum_get_modulation(
+            envelope, TEST_SPECTRUM_SIZE, TEST_SPECTRUM_SAMPLE_RATE, &keying_frequency) ==
+            SubGhzSpectrumModulationKeyed,
+        "OOK is not detected");
+    const float resolution = (float)TEST_SPECTRUM_SAMPLE_RATE / TEST_SPECTRUM_SIZE / 2;
+    mu_assert(fabsf(keying_frequency - keying) <= resolution, "Wrong keying frequency");
+
+    // Levels across a sweep with 20 kHz steps: a signal about 100 kHz wide
+    const float levels[] = {-97, -96, -95, -80, -70, -66, -65, -67, -71, -85, -96, -97};
+    mu_assert_int_eq(100000, subghz_spectrum_get_bandwidth(levels, COUNT_OF(levels), 20000));
+    mu_assert_int_eq(0, subghz_spectrum_get_bandwidth(levels, 0, 20000));
+}
+
+MU_TEST(subghz_spectrum_short_test) {
+    // Worker always uses full size, kernels take any power of two
+    const size_t size = TEST_SPECTRUM_SIZE / 4;
+    int16_t samples[TEST_SPECTRUM_SIZE / 4];
+    int16_t re[TEST_SPECTRUM_SIZE / 4];
+    int16_t im[TEST_SPECTRUM_SIZE / 4] = {};
+    for(size_t i = 0; i < size; i++) {
+        samples[i] = (int16_t)(16000.0f * cosf(2.0f * (float)M_PI * 3 * i / size));
+        re[i] = samples[i];
+    }
+    subghz_spectrum_fft(re, im, size);
+    mu_assert(abs(re[3] - 8000) < 64 && abs(im[3]) < 64, "Wrong short FFT tone bin");
+
+    uint32_t fft_power = re[3] * re[3] + im[3] * im[3];
+    uint32_t goertzel_power = subghz_spectrum_goertzel(
+        samples,
+        size,
+        subghz_spectrum_goertzel_coeff(
+            3 * TEST_SPECTRUM_SAMPLE_RATE / size, TEST_SPECTRUM_SAMPLE_RATE));
+    mu_assert(
+        goertzel_power > fft_power * 0.97f && goertzel_power < fft_power * 1.03f,
+        "Short Goertzel doesn't match FFT");
+
+    // Keyed envelope half as long, 1250 Hz keying is bin 2
+    int16_t envelope[TEST_SPECTRUM_SIZE / 2];
+    uint32_t keying_frequency;
+    for(size_t i = 0; i < COUNT_OF(envelope); i++) {
+        bool is_on = (i * 1250 * 2 / TEST_SPECTRUM_SAMPLE_RATE) % 2 == 0;
+        envelope[i] = (is_on ? -55 : -90) * SUBGHZ_SPECTRUM_ENVELOPE_SCALE;
+    }
+    mu_assert(
+        subghz_spectrum_get_modulation(
+            envelope, COUNT_OF(envelope), TEST_SPECTRUM_SAMPLE_RATE, &keying_frequency) ==
+            SubGhzSpectrumModulationKeyed,
+        "Short OOK is not detected");
+    const float resolution = (float)TEST_SPECTRUM_SAMPLE_RATE / COUNT_OF(envelope) / 2;
+    mu_assert(fabsf(keying_frequency - 1250.0f) <= resolution, "Wrong short keying frequency");
+
+    // Signal at the edge of the sweep and a flat sweep
+    const float edge[] = {-60, -62, -64, -80, -95};
+    mu_assert_int_eq(60000, subghz_spectrum_get_bandwidth(edge, COUNT_OF(edge), 20000));
+    const float flat[] = {-97, -97, -97, -97};
+    mu_assert_int_eq(80000, subghz_spectrum_get_bandwidth(flat, COUNT_OF(flat), 20000));
+}
+
+MU_TEST(subghz_spectrum_benchmark) {
+    int16_t samples[TEST_SPECTRUM_SIZE];
+    int16_t re[TEST_SPECTRUM_SIZE];
+    int16_t im[TEST_SPECTRUM_SIZE];
+    int32_t coeff[TEST_SPECTRUM_SIZE / 2];
+
+    subghz_spectrum_test_tone(samples, 3, 12000.0f);
+    for(size_t k = 0; k < TEST_SPECTRUM_SIZE / 2; k++) {
+        coeff[k] = subghz_spectrum_goertzel_coeff(
+            k * TEST_SPECTRUM_SAMPLE_RATE / TEST_SPECTRUM_SIZE, TEST_SPECTRUM_SAMPLE_RATE);
+    }
+
+    uint32_t start = furi_get_tick();
+    for(size_t run = 0; run < TEST_SPECTRUM_RUNS; run++) {
+        memcpy(re, samples, sizeof(re));
+        memset(im, 0, sizeof(im));
+        subghz_spectrum_fft(re, im, TEST_SPECTRUM_SIZE);
+    }
+    uint32_t fft = furi_get_tick() - start;
+
+    // Full Goertzel bank, the same bins as FFT
+    start = furi_get_tick();
+    for(size_t run = 0; run < TEST_SPECTRUM_RUNS; run++) {
+        for(size_t k = 0; k < TEST_SPECTRUM_SIZE / 2; k++) {
+            subghz_spectrum_goertzel(samples, TEST_SPECTRUM_SIZE, coeff[k]);
+        }
+    }
+    uint32_t bank = furi_get_tick() - start;
+
+    FURI_LOG_I(
+        TAG,
+        "Spectrum %d samples x%d: FFT %lu ms, Goertzel bank %lu ms",
+        TEST_SPECTRUM_SIZE,
+        TEST_SPECTRUM_RUNS,
+        fft,
+        bank);
+
+    mu_assert(fft < bank, "FFT is slower than Goertzel bank");
+}
+
+#define TEST_DEDUP_TE        400
+#define TEST_DEDUP_BITS      24
+#define TEST_DEDUP_BURST_MAX (TEST_DEDUP_BITS * 2 + 2)
+#define TEST_DEDUP_PATH      TEST_RAW_DIR_NAME "/dedup.sub"
+#define TEST_DEDUP_SOURCE    TEST_RAW_DIR_NAME "/dedup_source.sub"
+#define TEST_DEDUP_AGAIN     TEST_RAW_DIR_NAME "/dedup_again.sub"
+
+// Princeton-like burst: start pulse, PWM bits, guard gap, all with jitter
+static size_t subghz_raw_dedup_test_burst(int32_t* samples, uint32_t code, uint32_t* random) {
+    size_t count = 0;
+    samples[count++] = TEST_DEDUP_TE;
+    for(int8_t bit = TEST_DEDUP_BITS - 1; bit >= 0; bit--) {
+        const int32_t high = ((code >> bit) & 1) ? 3 : 1;
+        samples[count++] = high * TEST_DEDUP_TE;
+        samples[count++] = -(4 - high) * TEST_DEDUP_TE;
+    }
+    samples[count++] = -31 * TEST_DEDUP_TE;
+
+    for(size_t i = 0; i < count; i++) {
+        const int32_t jitter = (int32_t)(subghz_hopper_test_random(random) % 81) - 40;
+        samples[i] += (samples[i] > 0) ? jitter : -jitter;
+    }
+    return count;
+}
+
+MU_TEST(subghz_raw_dedup_test) {
+    const uint32_t codes[] = {0xA5A5A5, 0xA5A5A5, 0x123456, 0xA5A5A5, 0x123456, 0xA5A5A5};
+    const size_t size_max = COUNT_OF(codes) * TEST_DEDUP_BURST_MAX + 1;
+    int32_t* samples = malloc(size_max * sizeof(int32_t));
+    int32_t* output = malloc(size_max * sizeof(int32_t));
+    uint32_t random = 0x12345678;
+
+    // Silence before the first burst is dropped
+    size_t count = 0;
+    samples[count++] = -20000;
+    size_t first_size = 0, second_size = 0;
+    for(size_t i = 0; i < COUNT_OF(codes); i++) {
+        const size_t size = subghz_raw_dedup_test_burst(&samples[count], codes[i], &random);
+        if(i == 0) first_size = size;
+        if(i == 2) second_size = size;
+        count += size;
+    }
+
+    SubGhzRawDedup* dedup = subghz_raw_dedup_alloc();
+    // Odd chunks, so bursts cross chunk boundaries
+    const size_t chunk = 37;
+    for(size_t i = 0; i < count; i += chunk) {
+        subghz_raw_dedup_feed(dedup, &samples[i], MIN(chunk, count - i));
+    }
+    subghz_raw_dedup_rewind(dedup);
+    size_t kept = 0;
+    for(size_t i = 0; i < count; i += chunk) {
+        kept += subghz_raw_dedup_filter(dedup, &samples[i], MIN(chunk, count - i), &output[kept]);
+    }
+
+    mu_assert_int_eq(COUNT_OF(codes), subghz_raw_dedup_get_burst_count(dedup));
+    mu_assert_int_eq(2, subghz_raw_dedup_get_kept_count(dedup));
+    mu_assert_int_eq(4, subghz_raw_dedup_get_repeats(dedup, 0));
+    mu_assert_int_eq(2, subghz_raw_dedup_get_repeats(dedup, 1));
+    mu_assert_int_eq(first_size + second_size, kept);
+    mu_assert_mem_eq(&samples[1], output, first_size * sizeof(int32_t));
+    mu_assert_mem_eq(
+        &samples[1 + first_size * 2], &output[first_size], second_size * sizeof(int32_t));
+
+    subghz_raw_dedup_reset(dedup);
+    subghz_raw_dedup_feed(dedup, &samples[1 + first_size * 2], second_size);
+    subghz_raw_dedup_rewind(dedup);
+    mu_assert_int_eq(1, subghz_raw_dedup_get_burst_count(dedup));
+    mu_assert_int_eq(1, subghz_raw_dedup_get_repeats(dedup, 0));
+
+    subghz_raw_dedup_free(dedup);
+    free(output);
+    free(samples);
+}
+
+// Number of samples file encoder worker plays from file
+static size_t subghz_raw_dedup_test_play(const char* path) {
+    SubGhzFileEncoderWorker* worker = subghz_file_encoder_worker_alloc();
+    size_t count = 0;
+
+    if(subghz_file_encoder_worker_start(worker, path, NULL)) {
+        // the worker needs a file in order to open and read part of the file
+        furi_delay_ms(100);
+
+        uint32_t start = furi_get_tick();
+        while(furi_get_tick() - start < TEST_TIMEOUT) {
+            LevelDuration level_duration = subghz_file_encoder_worker_get_level_duration(worker);
+            if(level_duration_is_reset(level_duration)) break;
+            if(!level_duration_is_wait(level_duration)) count++;
+            furi_thread_yield();
+        }
+        subghz_file_encoder_worker_stop(worker);
+    }
+    subghz_file_encoder_worker_free(worker);
+
+    return count;
+}
+
+MU_TEST(subghz_raw_dedup_repeats_test) {
+    const uint32_t codes[] = {0xA5A5A5, 0xA5A5A5, 0x123456, 0xA5A5A5, 0x123456, 0xA5A5A5};
+    int32_t* samples = malloc(COUNT_OF(codes) * TEST_DEDUP_BURST_MAX * sizeof(int32_t));
+    uint32_t random = 0x87654321;
+    size_t count = 0;
+    for(size_t i = 0; i < COUNT_OF(codes); i++) {
+        count += subghz_raw_dedup_test_burst(&samples[count], codes[i], &random);
+    }
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    mu_assert(storage_simply_mkdir(storage, TEST_RAW_DIR_NAME), "Cannot create test dir");
+    FlipperFormat* flipper_format = flipper_format_file_alloc(storage);
+    SubGhzRawFile* raw_file = subghz_raw_file_alloc();
+    bool written =
+        flipper_format_file_open_always(flipper_format, TEST_DEDUP_SOURCE) &&
+        flipper_format_write_header_cstr(
+            flipper_format, SUBGHZ_RAW_FILE_TYPE, SUBGHZ_RAW_FILE_VERSION) &&
+        flipper_format_write_string_cstr(flipper_format, "Protocol", "RAW") &&
+        subghz_raw_file_write_format(raw_file, flipper_format, SubGhzRawFileFormatText) &&
+        subghz_raw_file_write(raw_file, flipper_format, samples, count);
+    flipper_format_file_close(flipper_format);
+    subghz_raw_file_free(raw_file);
+    free(samples);
+    mu_assert(written, "Cannot write source\r\n");
+
+    // Deduplicating again merges repeats instead of adding another key
+    SubGhzRawDedupStats stats, stats_again;
+    mu_assert(
+        subghz_raw_dedup_file(storage, TEST_DEDUP_SOURCE, TEST_DEDUP_PATH, &stats),
+        "Dedup failed\r\n");
+    mu_assert(
+        subghz_raw_dedup_file(storage, TEST_DEDUP_PATH, TEST_DEDUP_AGAIN, &stats_again),
+        "Dedup again failed\r\n");
+    mu_assert_int_eq(2, stats.kept_count);
+    mu_assert_int_eq(2, stats_again.burst_count);
+    mu_assert_int_eq(2, stats_again.kept_count);
+    mu_assert_int_eq(stats.samples_out, stats_again.samples_out);
+
+    size_t repeats_count = 0;
+    uint32_t* repeats = NULL;
+    bool second_key = true;
+    if(flipper_format_file_open_existing(flipper_format, TEST_DEDUP_AGAIN)) {
+        repeats = subghz_raw_dedup_read_repeats(flipper_format, &repeats_count);
+        // Another key would be found past the first one
+        uint32_t value_count;
+        second_key = flipper_format_get_value_count(
+            flipper_format, SUBGHZ_RAW_DEDUP_REPEATS_KEY, &value_count);
+    }
+    flipper_format_file_close(flipper_format);
+    flipper_format_free(flipper_format);
+    mu_assert(!second_key, "Repeats are written twice\r\n");
+    mu_assert_int_eq(2, repeats_count);
+    mu_assert_int_eq(4, repeats[0]);
+    mu_assert_int_eq(2, repeats[1]);
+    free(repeats);
+
+    // Playback restores every burst
+    mu_assert_int_eq(count, subghz_raw_dedup_test_play(TEST_DEDUP_SOURCE));
+    mu_assert_int_eq(count, subghz_raw_dedup_test_play(TEST_DEDUP_PATH));
+    mu_assert_int_eq(count, subghz_raw_dedup_test_play(TEST_DEDUP_AGAIN));
+
+    mu_assert(storage_simply_remove_recursive(storage, TEST_RAW_DIR_NAME), "Cannot clean data");
+    furi_record_close(RECORD_STORAGE);
+}
+
+MU_TEST(subghz_raw_dedup_repeats_eof_test) {
+    int32_t* samples = malloc(2 * TEST_DEDUP_BURST_MAX * sizeof(int32_t));
+    uint32_t random = 0x13572468;
+    const size_t first_size = subghz_raw_dedup_test_burst(samples, 0xA5A5A5, &random);
+    // Recording stopped right after the last burst, no gap closes it
+    const size_t last_size =
+        subghz_raw_dedup_test_burst(&samples[first_size], 0x123456, &random) - 1;
+    const uint32_t repeats[] = {2, 3};
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    mu_assert(storage_simply_mkdir(storage, TEST_RAW_DIR_NAME), "Cannot create test dir");
+    FlipperFormat* flipper_format = flipper_format_file_alloc(storage);
+    SubGhzRawFile* raw_file = subghz_raw_file_alloc();
+    bool written =
+        flipper_format_file_open_always(flipper_format, TEST_DEDUP_PATH) &&
+        flipper_format_write_header_cstr(
+            flipper_format, SUBGHZ_RAW_FILE_TYPE, SUBGHZ_RAW_FILE_VERSION) &&
+        flipper_format_write_uint32(
+            flipper_format, SUBGHZ_RAW_DEDUP_REPEATS_KEY, repeats, COUNT_OF(repeats)) &&
+        flipper_format_write_string_cstr(flipper_format, "Protocol", "RAW") &&
+        subghz_raw_file_write_format(raw_file, flipper_format, SubGhzRawFileFormatText) &&
+        subghz_raw_file_write(raw_file, flipper_format, samples, first_size + last_size);
+    flipper_format_file_close(flipper_format);
+    flipper_format_free(flipper_format);
+    subghz_raw_file_free(raw_file);
+    free(samples);
+    mu_assert(written, "Cannot write source\r\n");
+
+    // Burst at the end of file is replayed as many times as the other ones
+    mu_assert_int_eq(
+        first_size * repeats[0] + last_size * repeats[1],
+        subghz_raw_dedup_test_play(TEST_DEDUP_PATH));
+
+    mu_assert(storage_simply_remove_recursive(storage, TEST_RAW_DIR_NAME), "Cannot clean data");
+    furi_record_close(RECORD_STORAGE);
+}
+
+MU_TEST(subghz_raw_dedup_benchmark) {
+    const char* paths[] = {
+        EXT_PATH("unit_tests/subghz/Princeton_raw.sub"),
+        EXT_PATH("unit_tests/subghz/came_raw.sub"),
+        EXT_PATH("unit_tests/subghz/megacode_raw.sub"),
+        EXT_PATH("unit_tests/subghz/doorhan_raw.sub"),
+        TEST_RANDOM_DIR_NAME,
+    };
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    mu_assert(storage_simply_mkdir(storage, TEST_RAW_DIR_NAME), "Cannot create test dir");
+    FlipperFormat* flipper_format = flipper_format_file_alloc(storage);
+
+    for(size_t i = 0; i < COUNT_OF(paths); i++) {
+        SubGhzRawDedupStats stats;
+        uint32_t start = furi_get_tick();
+        mu_assert(
+            subghz_raw_dedup_file(storage, paths[i], TEST_DEDUP_PATH, &stats),
+            "Dedup failed\r\n");
+        uint32_t ticks = furi_get_tick() - start;
+
+        SubGhzRawFileTestResult result;
+        mu_assert(subghz_raw_file_test_read(TEST_DEDUP_PATH, &result), "Read back failed\r\n");
+        mu_assert_int_eq(stats.samples_out, result.sample_count);
+        mu_assert(stats.samples_out <= stats.samples_in, "Output is larger\r\n");
+
+        // Every burst is accounted for by the repeat count of its representative
+        uint32_t* repeats = malloc(MAX(stats.kept_count, 1U) * sizeof(uint32_t));
+        uint32_t total = 0;
+        if(flipper_format_file_open_existing(flipper_format, TEST_DEDUP_PATH) &&
+           flipper_format_read_uint32(
+               flipper_format, SUBGHZ_RAW_DEDUP_REPEATS_KEY, repeats, stats.kept_count)) {
+            for(size_t j = 0; j < stats.kept_count; j++) {
+                total += repeats[j];
+            }
+        }
+        flipper_format_file_close(flipper_format);
+        free(repeats);
+        mu_assert_int_eq(stats.burst_count, total);
+
+        FURI_LOG_I(
+            TAG,
+            "Dedup %s: %zu bursts to %zu, %zu samples to %zu, ratio %.2f, %lu ms, %lu samples/s",
+            paths[i],
+            stats.burst_count,
+            stats.kept_count,
+            stats.samples_in,
+            stats.samples_out,
+            (double)stats.samples_in / (double)MAX(stats.samples_out, 1U),
+            ticks,
+            (uint32_t)((uint64_t)stats.samples_in * 1000 / MAX(ticks, 1UL)));
+    }
+
+    flipper_format_free(flipper_format);
+    mu_assert(storage_simply_remove_recursive(storage, TEST_RAW_DIR_NAME), "Cannot clean data");
+    furi_record_close(RECORD_STORAGE);
+}
+
+#define TEST_TX_BUFFER_SIZE 8192
+
+static LevelDuration subghz_tx_buffer_test_yield(void* context) {
+    size_t* count = context;
+    if(*count == 0) return level_duration_reset();
+    (*count)--;
+    return level_duration_make(*count % 2, 100 + *count);
+}
+
+MU_TEST(subghz_tx_buffer_test) {
+    const uint32_t durations[] = {0, 1, 0x3FFF, 0x4000, 0xFFFFFFF, 0x10000000, 0x3FFFFFFF};
+    SubGhzTxBuffer* buffer = subghz_tx_buffer_alloc(14);
+
+    for(size_t i = 0; i < COUNT_OF(durations); i++) {
+        mu_assert(
+            subghz_tx_buffer_add(buffer, level_duration_make(i % 2, durations[i])),
+            "Add failed\r\n");
+    }
+    mu_assert_int_eq(1 + 1 + 1 + 2 + 2 + 3 + 3, subghz_tx_buffer_get_size(buffer));
+    mu_assert(subghz_tx_buffer_add(buffer, level_duration_wait()), "Add wait failed\r\n");
+    mu_assert(!subghz_tx_buffer_add(buffer, level_duration_make(true, 1)), "Buffer overflow\r\n");
+    mu_assert_int_eq(COUNT_OF(durations) + 1, subghz_tx_buffer_get_count(buffer));
+
+    size_t position = 0;
+    for(size_t i = 0; i < COUNT_OF(durations); i++) {
+        LevelDuration level_duration = subghz_tx_buffer_get(buffer, &position);
+        mu_assert(!level_duration_is_reset(level_duration), "Early end\r\n");
+        mu_assert_int_eq(i % 2, level_duration_get_level(level_duration));
+        mu_assert_int_eq(durations[i], level_duration_get_duration(level_duration));
+    }
+    mu_assert(level_duration_is_wait(subghz_tx_buffer_get(buffer, &position)), "No wait\r\n");
+    mu_assert(level_duration_is_reset(subghz_tx_buffer_get(buffer, &position)), "No end\r\n");
+    mu_assert(level_duration_is_reset(subghz_tx_buffer_get(buffer, &position)), "No end\r\n");
+    subghz_tx_buffer_free(buffer);
+
+    // Render stops at reset or when buffer is full
+    buffer = subghz_tx_buffer_alloc(10);
+    size_t count = 10;
+    mu_assert(subghz_tx_buffer_render(buffer, subghz_tx_buffer_test_yield, &count), "Render\r\n");
+    mu_assert_int_eq(10, subghz_tx_buffer_get_count(buffer));
+    mu_assert_int_eq(10 * 100 + 45, subghz_tx_buffer_get_duration(buffer));
+    subghz_tx_buffer_reset(buffer);
+    count = 11;
+    mu_assert(
+        !subghz_tx_buffer_render(buffer, subghz_tx_buffer_test_yield, &count), "No overflow\r\n");
+    subghz_tx_buffer_free(buffer);
+}
+
+MU_TEST(subghz_tx_queue_test) {
+    SubGhzTxBuffer* first = subghz_tx_buffer_alloc(4);
+    SubGhzTxBuffer* second = subghz_tx_buffer_alloc(4);
+    subghz_tx_buffer_add(first, level_duration_make(true, 100));
+    subghz_tx_buffer_add(first, level_duration_make(false, 200));
+    subghz_tx_buffer_add(second, level_duration_make(true, 300));
+
+    SubGhzTxQueue* queue = subghz_tx_queue_alloc();
+    mu_assert(subghz_tx_queue_add(queue, first, 2, 1000), "Add failed\r\n");
+    mu_assert(subghz_tx_queue_add(queue, second, 1, 500), "Add failed\r\n");
+    mu_assert_int_eq(2, subghz_tx_queue_get_count(queue));
+    mu_assert_int_eq(300 * 2 + 1000 + 300, subghz_tx_queue_get_duration(queue));
+
+    // Gap after the last signal is not sent
+    const int32_t expected[] = {100, -200, 100, -200, -1000, 300};
+    for(size_t run = 0; run < 2; run++) {
+        subghz_tx_queue_rewind(queue);
+        for(size_t i = 0; i < COUNT_OF(expected); i++) {
+            LevelDuration level_duration = subghz_tx_queue_yield(queue);
+            mu_assert(!level_duration_is_reset(level_duration), "Early end\r\n");
+            mu_assert_int_eq(expected[i] > 0, level_duration_get_level(level_duration));
+            mu_assert_int_eq(
+                (uint32_t)abs(expected[i]), level_duration_get_duration(level_duration));
+        }
+        mu_assert(level_duration_is_reset(subghz_tx_queue_yield(queue)), "No end\r\n");
+    }
+
+    // Same buffers in another queue, as for a second radio
+    SubGhzTxQueue* other = subghz_tx_queue_alloc();
+    subghz_tx_queue_add(other, second, 1, 0);
+    subghz_tx_queue_add(other, first, 1, 0);
+    subghz_tx_queue_rewind(other);
+    subghz_tx_queue_rewind(queue);
+    mu_assert_int_eq(300, level_duration_get_duration(subghz_tx_queue_yield(other)));
+    mu_assert_int_eq(100, level_duration_get_duration(subghz_tx_queue_yield(queue)));
+    mu_assert_int_eq(100, level_duration_get_duration(subghz_tx_queue_yield(other)));
+    mu_assert_int_eq(200, level_duration_get_duration(subghz_tx_queue_yield(queue)));
+
+    for(size_t i = subghz_tx_queue_get_count(other); i < SUBGHZ_TX_QUEUE_SIZE_MAX; i++) {
+        mu_assert(subghz_tx_queue_add(other, first, 1, 0), "Add failed\r\n");
+    }
+    mu_assert(!subghz_tx_queue_add(other, first, 1, 0), "Queue overflow\r\n");
+
+    subghz_tx_queue_free(other);
+    subghz_tx_queue_free(queue);
+    subghz_tx_buffer_free(second);
+    subghz_tx_buffer_free(first);
+}
+
+// DWT cycle counter
+static inline uint32_t subghz_tx_buffer_test_cycles(void) {
+    return furi_hal_cortex_timer_get(0).start;
+}
+
+// Encoders of dynamic protocols write the next key back, so every transmitter
+// gets its own copy of the file to start from the same key
+static SubGhzTransmitter* subghz_tx_buffer_test_transmitter(Storage* storage, const char* path) {
+    FlipperFormat* flipper_format = flipper_format_string_alloc();
+    FuriString* temp_str = furi_string_alloc();
+    SubGhzTransmitter* transmitter = NULL;
+
+    if(stream_load_from_file(flipper_format_get_raw_stream(flipper_format), storage, path) &&
+       flipper_format_rewind(flipper_format) &&
+       flipper_format_read_string(flipper_format, "Protocol", temp_str)) {
+        transmitter =
+            subghz_transmitter_alloc_init(environment_handler, furi_string_get_cstr(temp_str));
+    }
+    if(transmitter &&
+       subghz_transmitter_deserialize(transmitter, flipper_format) != SubGhzProtocolStatusOk) {
+        subghz_transmitter_free(transmitter);
+        transmitter = NULL;
+    }
+
+    furi_string_free(temp_str);
+    flipper_format_free(flipper_format);
+    return transmitter;
+}
+
+MU_TEST(subghz_tx_buffer_encoder_test) {
+    const char* paths[] = {
+        EXT_PATH("unit_tests/subghz/princeton.sub"),
+        EXT_PATH("unit_tests/subghz/came.sub"),
+        EXT_PATH("unit_tests/subghz/came_twee.sub"),
+        EXT_PATH("unit_tests/subghz/gate_tx.sub"),
+        EXT_PATH("unit_tests/subghz/nice_flo.sub"),
+        EXT_PATH("unit_tests/subghz/doorhan.sub"),
+        EXT_PATH("unit_tests/subghz/linear.sub"),
+        EXT_PATH("unit_tests/subghz/linear_delta3.sub"),
+        EXT_PATH("unit_tests/subghz/megacode.sub"),
+        EXT_PATH("unit_tests/subghz/holtek.sub"),
+        EXT_PATH("unit_tests/subghz/security_pls_1_0.sub"),
+        EXT_PATH("unit_tests/subghz/security_pls_2_0.sub"),
+        EXT_PATH("unit_tests/subghz/power_smart.sub"),
+        EXT_PATH("unit_tests/subghz/marantec.sub"),
+        EXT_PATH("unit_tests/subghz/bett.sub"),
+        EXT_PATH("unit_tests/subghz/doitrand.sub"),
+        EXT_PATH("unit_tests/subghz/phoenix_v2.sub"),
+        EXT_PATH("unit_tests/subghz/honeywell_wdb.sub"),
+        EXT_PATH("unit_tests/subghz/magellan.sub"),
+        EXT_PATH("unit_tests/subghz/intertechno_v3.sub"),
+        EXT_PATH("unit_tests/subghz/clemsa.sub"),
+        EXT_PATH("unit_tests/subghz/ansonic.sub"),
+        EXT_PATH("unit_tests/subghz/smc5326.sub"),
+        EXT_PATH("unit_tests/subghz/holtek_ht12x.sub"),
+        EXT_PATH("unit_tests/subghz/dooya.sub"),
+        EXT_PATH("unit_tests/subghz/mastercode.sub"),
+        EXT_PATH("unit_tests/subghz/dickert_mahs.sub"),
+    };
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    SubGhzTxBuffer* buffer = subghz_tx_buffer_alloc(TEST_TX_BUFFER_SIZE);
+
+    for(size_t i = 0; i < COUNT_OF(paths); i++) {
+        // Two transmitters from the same file: one is rendered, the other one streamed
+        SubGhzTransmitter* rendered = subghz_tx_buffer_test_transmitter(storage, paths[i]);
+        SubGhzTransmitter* streamed = subghz_tx_buffer_test_transmitter(storage, paths[i]);
+        mu_assert(rendered && streamed, "Cannot load encoder\r\n");
+
+        subghz_tx_buffer_reset(buffer);
+        mu_assert(
+            subghz_tx_buffer_render(buffer, subghz_transmitter_yield, rendered),
+            "Signal does not fit\r\n");
+
+        size_t position = 0;
+        size_t count = 0;
+        uint32_t stream_max = 0, stream_total = 0;
+        uint32_t buffer_max = 0, buffer_total = 0;
+        bool equal = true;
+        while(true) {
+            uint32_t start = subghz_tx_buffer_test_cycles();
+            LevelDuration expected = subghz_transmitter_yield(streamed);
+            uint32_t stream_cycles = subghz_tx_buffer_test_cycles() - start;
+
+            start = subghz_tx_buffer_test_cycles();
+            LevelDuration actual = subghz_tx_buffer_get(buffer, &position);
+            uint32_t buffer_cycles = subghz_tx_buffer_test_cycles() - start;
+
+            if(level_duration_is_reset(expected) || level_duration_is_reset(actual)) {
+                equal = level_duration_is_reset(expected) && level_duration_is_reset(actual);
+                break;
+            }
+            if(level_duration_is_wait(expected) || level_duration_is_wait(actual)) {
+                equal = level_duration_is_wait(expected) && level_duration_is_wait(actual);
+            } else {
+                equal = level_duration_get_level(expected) == level_duration_get_level(actual) &&
+                        level_duration_get_duration(expected) ==
+                            level_duration_get_duration(actual);
+            }
+            if(!equal) break;
+
+            count++;
+            stream_max = MAX(stream_max, stream_cycles);
+            stream_total += stream_cycles;
+            buffer_max = MAX(buffer_max, buffer_cycles);
+            buffer_total += buffer_cycles;
+        }
+
+        subghz_transmitter_free(streamed);
+        subghz_transmitter_free(rendered);
+
+        mu_assert(equal, "Rendered signal differs\r\n");
+        mu_assert_int_eq(subghz_tx_buffer_get_count(buffer), count);
+
+        FURI_LOG_I(
+            TAG,
+            "TX %s: %zu pulses, %zu bytes, yield cycles avg/max: stream %lu/%lu, buffer %lu/%lu",
+            paths[i],
+            count,
+            subghz_tx_buffer_get_size(buffer) * sizeof(uint16_t),
+            stream_total / MAX(count, 1U),
+            stream_max,
+            buffer_total / MAX(count, 1U),
+            buffer_max);
+    }
+
+    subghz_tx_buffer_free(buffer);
+    furi_record_close(RECORD_STORAGE);
+}
+
 MU_TEST_SUITE(subghz) {
     subghz_test_init();
     MU_RUN_TEST(subghz_keystore_test);
@@ -923,6 +2346,26 @@ MU_TEST_SUITE(subghz) {
     MU_RUN_TEST(subghz_encoder_dickert_test);
 
     MU_RUN_TEST(subghz_random_test);
+
+    MU_RUN_TEST(subghz_raw_file_convert_test);
+    MU_RUN_TEST(subghz_raw_file_skip_test);
+    MU_RUN_TEST(subghz_raw_file_binary_random_test);
+    MU_RUN_TEST(subghz_raw_file_benchmark);
+
+    MU_RUN_TEST(subghz_keeloq_keystore_benchmark);
+    MU_RUN_TEST(subghz_keeloq_keystore_learning_test);
+    MU_RUN_TEST(subghz_hopper_test);
+    MU_RUN_TEST(subghz_spectrum_fft_test);
+    MU_RUN_TEST(subghz_spectrum_modulation_test);
+    MU_RUN_TEST(subghz_spectrum_short_test);
+    MU_RUN_TEST(subghz_spectrum_benchmark);
+    MU_RUN_TEST(subghz_raw_dedup_test);
+    MU_RUN_TEST(subghz_raw_dedup_repeats_test);
+    MU_RUN_TEST(subghz_raw_dedup_repeats_eof_test);
+    MU_RUN_TEST(subghz_raw_dedup_benchmark);
+    MU_RUN_TEST(subghz_tx_buffer_test);
+    MU_RUN_TEST(subghz_tx_queue_test);
+    MU_RUN_TEST(subghz_tx_buffer_encoder_test);
     subghz_test_deinit();
 }
 
@@ -0,0 +1,268 @@
+#include <furi.h>
+#include <furi_hal.h>
+#include <gui/gui.h>
+#include <gui/view_i.h>
+#include <gui/modules/text_box.h>
+#include <storage/storage.h>
+#include <toolbox/stream/string_stream.h>
+#include <toolbox/stream/file_stream.h>
+#include "../test.h" // IWYU pragma: keep
+
+#define TAG "TextBoxTest"
+
+#define TEXT_BOX_TEST_FILE      EXT_PATH(".tmp/unit_tests/text_box.txt")
+#define TEXT_BOX_TEST_FILE_SIZE (10 * 1024 * 1024)
+#define TEXT_BOX_TEST_TEXT_SIZE (6 * 1024)
+#define TEXT_BOX_TEST_CHUNK     (4096)
+// Shorter than the backward scan limit, so stream and string layouts are the same
+#define TEXT_BOX_TEST_LINE_MAX (300)
+
+#define TEXT_BOX_TEST_FRAME_SIZE (128 * 64 / 8)
+// Frame buffer is 8 rows of 128 byte columns, scrollbar is right of the text frame
+#define TEXT_BOX_TEST_FRAME_WIDTH (128)
+#define TEXT_BOX_TEST_TEXT_WIDTH  (124)
+
+#define TEXT_BOX_TEST_SCROLLS        (400)
+#define TEXT_BOX_TEST_BIG_SCROLLS    (2000)
+#define TEXT_BOX_TEST_RAM_MAX        (4 * 1024)
+#define TEXT_BOX_TEST_LATENCY_MAX_US (100 * 1000)
+
+typedef struct {
+    Gui* gui;
+    Canvas* canvas;
+    uint8_t* frame;
+} TextBoxTest;
+
+typedef struct {
+    uint32_t line;
+    uint32_t column;
+    uint32_t length;
+} TextBoxTestText;
+
+/* Lines of different length, empty ones and long paragraphs that wrap several times */
+static char text_box_test_text_next(TextBoxTestText* text) {
+    if(text->column == text->length) {
+        text->line++;
+        text->column = 0;
+        text->length = (text->line % 13) ? (text->line * 7919) % TEXT_BOX_TEST_LINE_MAX : 0;
+        return '\n';
+    }
+
+    uint32_t column = text->column++;
+    return (column % 6 == 5) ? ' ' : 'a' + (text->line + column) % 26;
+}
+
+static void text_box_test_frame_callback(
+    uint8_t* data,
+    size_t size,
+    CanvasOrientation orientation,
+    void* context) {
+    UNUSED(orientation);
+    TextBoxTest* test = context;
+    if(test->frame && size == TEXT_BOX_TEST_FRAME_SIZE) {
+        memcpy(test->frame, data, size);
+    }
+}
+
+static void text_box_test_alloc(TextBoxTest* test) {
+    test->gui = furi_record_open(RECORD_GUI);
+    gui_add_framebuffer_callback(test->gui, text_box_test_frame_callback, test);
+    test->canvas = gui_direct_draw_acquire(test->gui);
+    test->frame = NULL;
+}
+
+static void text_box_test_free(TextBoxTest* test) {
+    gui_direct_draw_release(test->gui);
+    gui_remove_framebuffer_callback(test->gui, text_box_test_frame_callback, test);
+    furi_record_close(RECORD_GUI);
+}
+
+/* Draw view, return time it took in cycles and the frame if asked to */
+static uint32_t text_box_test_draw(TextBoxTest* test, TextBox* text_box, uint8_t* frame) {
+    canvas_reset(test->canvas);
+    uint32_t start = furi_hal_cortex_timer_get(0).start;
+    view_draw(text_box_get_view(text_box), test->canvas);
+    uint32_t cycles = furi_hal_cortex_timer_get(0).start - start;
+
+    test->frame = frame;
+    canvas_commit(test->canvas);
+    test->frame = NULL;
+    return cycles;
+}
+
+static void text_box_test_scroll(TextBox* text_box, InputKey key) {
+    // Release after every press keeps scrolling at one line per step
+    InputEvent event = {.key = key, .type = InputTypeShort};
+    view_input(text_box_get_view(text_box), &event);
+    event.type = InputTypeRelease;
+    view_input(text_box_get_view(text_box), &event);
+}
+
+static bool text_box_test_text_equal(const uint8_t* frame, const uint8_t* expected) {
+    for(size_t offset = 0; offset < TEXT_BOX_TEST_FRAME_SIZE;
+        offset += TEXT_BOX_TEST_FRAME_WIDTH) {
+        if(memcmp(&frame[offset], &expected[offset], TEXT_BOX_TEST_TEXT_WIDTH) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void text_box_test_stream_matches_text(TextBoxFocus focus) {
+    FuriString* text = furi_string_alloc();
+    TextBoxTestText generator = {0};
+    while(furi_string_size(text) < TEXT_BOX_TEST_TEXT_SIZE) {
+        furi_string_push_back(text, text_box_test_text_next(&generator));
+    }
+    Stream* stream = string_stream_alloc();
+    stream_write_string(stream, text);
+    stream_rewind(stream);
+
+    TextBox* text_box = text_box_alloc();
+    text_box_set_focus(text_box, focus);
+    text_box_set_text(text_box, furi_string_get_cstr(text));
+    TextBox* stream_box = text_box_alloc();
+    text_box_set_focus(stream_box, focus);
+    text_box_set_stream(stream_box, stream);
+
+    TextBoxTest test;
+    text_box_test_alloc(&test);
+    uint8_t* expected = malloc(TEXT_BOX_TEST_FRAME_SIZE);
+    uint8_t* frame = malloc(TEXT_BOX_TEST_FRAME_SIZE);
+
+    // Down past the end and back up past the start, screens must match on every step
+    int32_t mismatch_step = -1;
+    for(int32_t step = 0; step < TEXT_BOX_TEST_SCROLLS * 2; step++) {
+        text_box_test_draw(&test, text_box, expected);
+        text_box_test_draw(&test, stream_box, frame);
+        if(!text_box_test_text_equal(frame, expected)) {
+            mismatch_step = step;
+            break;
+        }
+
+        InputKey key = (step < TEXT_BOX_TEST_SCROLLS) ? InputKeyDown : InputKeyUp;
+        text_box_test_scroll(text_box, key);
+        text_box_test_scroll(stream_box, key);
+    }
+
+    text_box_test_free(&test);
+    free(frame);
+    free(expected);
+    text_box_free(stream_box);
+    text_box_free(text_box);
+    stream_free(stream);
+    furi_string_free(text);
+
+    mu_assert_int_eq(-1, mismatch_step);
+}
+
+MU_TEST(text_box_stream_matches_text_start) {
+    text_box_test_stream_matches_text(TextBoxFocusStart);
+}
+
+MU_TEST(text_box_stream_matches_text_end) {
+    text_box_test_stream_matches_text(TextBoxFocusEnd);
+}
+
+static bool text_box_test_file_create(Storage* storage) {
+    File* file = storage_file_alloc(storage);
+    char* chunk = malloc(TEXT_BOX_TEST_CHUNK);
+    TextBoxTestText generator = {0};
+
+    bool success = storage_file_open(file, TEXT_BOX_TEST_FILE, FSAM_WRITE, FSOM_CREATE_ALWAYS);
+    for(size_t written = 0; success && written < TEXT_BOX_TEST_FILE_SIZE;
+        written += TEXT_BOX_TEST_CHUNK) {
+        for(size_t i = 0; i < TEXT_BOX_TEST_CHUNK; i++) {
+            chunk[i] = text_box_test_text_next(&generator);
+        }
+        success = storage_file_write(file, chunk, TEXT_BOX_TEST_CHUNK) == TEXT_BOX_TEST_CHUNK;
+    }
+    storage_file_close(file);
+
+    free(chunk);
+    storage_file_free(file);
+    return success;
+}
+
+typedef struct {
+    uint32_t max;
+    uint64_t total;
+    size_t count;
+} TextBoxTestLatency;
+
+static void text_box_test_latency_add(TextBoxTestLatency* latency, uint32_t cycles) {
+    latency->max = MAX(latency->max, cycles);
+    latency->total += cycles;
+    latency->count++;
+}
+
+MU_TEST(text_box_stream_big_file) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    mu_check(text_box_test_file_create(storage));
+
+    Stream* stream = file_stream_alloc(storage);
+    mu_check(file_stream_open(stream, TEXT_BOX_TEST_FILE, FSAM_READ, FSOM_OPEN_EXISTING));
+    TextBox* text_box = text_box_alloc();
+    TextBoxTest test;
+    text_box_test_alloc(&test);
+
+    size_t heap_before = memmgr_get_free_heap();
+    size_t heap_min = heap_before;
+    TextBoxTestLatency latency = {0};
+
+    text_box_set_stream(text_box, stream);
+    uint32_t open_cycles = text_box_test_draw(&test, text_box, NULL);
+    for(size_t step = 0; step < TEXT_BOX_TEST_BIG_SCROLLS * 2; step++) {
+        text_box_test_scroll(
+            text_box, (step < TEXT_BOX_TEST_BIG_SCROLLS) ? InputKeyDown : InputKeyUp);
+        text_box_test_latency_add(&latency, text_box_test_draw(&test, text_box, NULL));
+        heap_min = MIN(heap_min, memmgr_get_free_heap());
+    }
+
+    // Open at the end: only the last screen is laid out, not the whole file
+    text_box_set_focus(text_box, TextBoxFocusEnd);
+    text_box_set_stream(text_box, stream);
+    uint32_t end_cycles = text_box_test_draw(&test, text_box, NULL);
+    for(size_t step = 0; step < TEXT_BOX_TEST_SCROLLS; step++) {
+        text_box_test_scroll(text_box, InputKeyUp);
+        text_box_test_latency_add(&latency, text_box_test_draw(&test, text_box, NULL));
+        heap_min = MIN(heap_min, memmgr_get_free_heap());
+    }
+
+    size_t heap_used = heap_before - heap_min;
+    const uint32_t cycles_per_us = furi_hal_cortex_instructions_per_microsecond();
+    uint32_t latency_max_us = latency.max / cycles_per_us;
+    FURI_LOG_I(
+        TAG,
+        "%d byte file: %zu bytes of heap, open %luus, open at end %luus, "
+        "scroll avg %luus max %luus",
+        TEXT_BOX_TEST_FILE_SIZE,
+        heap_used,
+        open_cycles / cycles_per_us,
+        end_cycles / cycles_per_us,
+        (uint32_t)(latency.total / latency.count / cycles_per_us),
+        latency_max_us);
+
+    text_box_test_free(&test);
+    text_box_free(text_box);
+    file_stream_close(stream);
+    stream_free(stream);
+    storage_simply_remove(storage, TEXT_BOX_TEST_FILE);
+    furi_record_close(RECORD_STORAGE);
+
+    mu_assert(heap_used < TEXT_BOX_TEST_RAM_MAX, "Paging must not depend on file size");
+    mu_assert(latency_max_us < TEXT_BOX_TEST_LATENCY_MAX_US, "Scrolling is too slow");
+}
+
+MU_TEST_SUITE(test_text_box) {
+    MU_RUN_TEST(text_box_stream_matches_text_start);
+    MU_RUN_TEST(text_box_stream_matches_text_end);
+    MU_RUN_TEST(text_box_stream_big_file);
+}
+
+int run_minunit_test_text_box(void) {
+    MU_RUN_SUITE(test_text_box);
+    return MU_EXIT_CODE;
+}
+
+TEST_API_DEFINE(run_minunit_test_text_box)
@@ -1,6 +1,8 @@
 #include <update_util/resources/manifest.h>
 #include <nfc/protocols/slix/slix_i.h>
 #include <nfc/protocols/iso15693_3/iso15693_3_poller_i.h>
+#include <nfc/protocols/iso14443_3a/iso14443_3a_listener_i.h>
+#include <nfc/nfc_mock.h>
 #include <FreeRTOS.h>
 #include <FreeRTOS-Kernel/include/queue.h>
 #include <task.h>
@@ -8,6 +10,8 @@
 #include <rpc/rpc_i.h>
 #include <flipper.pb.h>
 #include <core/event_loop.h>
+#include <gui/view_i.h>
+#include <lib/subghz/protocols/keeloq_common.h>
 
 static constexpr auto unit_tests_api_table = sort(create_array_t<sym_entry>(
     API_METHOD(resource_manifest_reader_alloc, ResourceManifestReader*, (Storage*)),
@@ -17,6 +21,17 @@ static constexpr auto unit_tests_api_table = sort(create_array_t<sym_entry>(
     API_METHOD(resource_manifest_reader_previous, ResourceManifestEntry*, (ResourceManifestReader*)),
     API_METHOD(slix_process_iso15693_3_error, SlixError, (Iso15693_3Error)),
     API_METHOD(iso15693_3_poller_get_data, const Iso15693_3Data*, (Iso15693_3Poller*)),
+    API_METHOD(
+        iso15693_3_poller_send_frame,
+        Iso15693_3Error,
+        (Iso15693_3Poller*, const BitBuffer*, BitBuffer*, uint32_t)),
+    API_METHOD(
+        iso14443_3a_listener_send_standard_frame,
+        Iso14443_3aError,
+        (Iso14443_3aListener*, const BitBuffer*)),
+    API_METHOD(nfc_mock_set_trace, void, (bool)),
+    API_METHOD(nfc_mock_get_frame_count, uint32_t, (void)),
+    API_METHOD(nfc_mock_reset_frame_count, void, (void)),
     API_METHOD(rpc_system_storage_get_error, PB_CommandStatus, (FS_Error)),
     API_METHOD(xQueueSemaphoreTake, BaseType_t, (QueueHandle_t, TickType_t)),
     API_METHOD(
@@ -46,4 +61,22 @@ static constexpr auto unit_tests_api_table = sort(create_array_t<sym_entry>(
     API_METHOD(furi_event_loop_message_queue_unsubscribe, void, (FuriEventLoop*, FuriMessageQueue*)),
     API_METHOD(furi_event_loop_run, void, (FuriEventLoop*)),
     API_METHOD(furi_event_loop_stop, void, (FuriEventLoop*)),
+    API_METHOD(view_draw, void, (View*, Canvas*)),
+    API_METHOD(view_input, bool, (View*, InputEvent*)),
+    API_METHOD(subghz_protocol_keeloq_common_encrypt, uint32_t, (const uint32_t, const uint64_t)),
+    API_METHOD(subghz_protocol_keeloq_common_decrypt, uint32_t, (const uint32_t, const uint64_t)),
+    API_METHOD(
+        subghz_protocol_keeloq_common_normal_learning, uint64_t, (uint32_t, const uint64_t)),
+    API_METHOD(
+        subghz_protocol_keeloq_common_secure_learning,
+        uint64_t,
+        (uint32_t, uint32_t, const uint64_t)),
+    API_METHOD(
+        subghz_protocol_keeloq_common_magic_xor_type1_learning, uint64_t, (uint32_t, uint64_t)),
+    API_METHOD(
+        subghz_protocol_keeloq_common_magic_serial_type1_learning, uint64_t, (uint32_t, uint64_t)),
+    API_METHOD(
+        subghz_protocol_keeloq_common_magic_serial_type2_learning, uint64_t, (uint32_t, uint64_t)),
+    API_METHOD(
+        subghz_protocol_keeloq_common_magic_serial_type3_learning, uint64_t, (uint32_t, uint64_t)),
     API_VARIABLE(PB_Main_msg, PB_Main_msg_t)));
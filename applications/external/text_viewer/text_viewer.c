@@ -32,6 +32,12 @@ TextViewer* text_viewer_alloc() {
     view_dispatcher_add_view(
         app->view_dispatcher, TextViewerViewWidget, widget_get_view(app->widget));
 
+    app->text_box = text_box_alloc();
+    view_dispatcher_add_view(
+        app->view_dispatcher, TextViewerViewTextBox, text_box_get_view(app->text_box));
+
+    app->storage = furi_record_open(RECORD_STORAGE);
+    app->stream = file_stream_alloc(app->storage);
     app->path = furi_string_alloc();
 
     return app;
@@ -42,11 +48,15 @@ void text_viewer_free(TextViewer* app) {
 
     view_dispatcher_remove_view(app->view_dispatcher, TextViewerViewWidget);
     widget_free(app->widget);
+    view_dispatcher_remove_view(app->view_dispatcher, TextViewerViewTextBox);
+    text_box_free(app->text_box);
 
     view_dispatcher_free(app->view_dispatcher);
     scene_manager_free(app->scene_manager);
 
     furi_string_free(app->path);
+    stream_free(app->stream);
+    furi_record_close(RECORD_STORAGE);
 
     furi_record_close(RECORD_GUI);
     free(app);
@@ -6,6 +6,8 @@
 #include <gui/view_dispatcher.h>
 #include <gui/scene_manager.h>
 #include <gui/modules/widget.h>
+#include <gui/modules/text_box.h>
+#include <toolbox/stream/file_stream.h>
 #include "text_viewer_icons.h"
 #include "scenes/text_viewer_scene.h"
 
@@ -17,10 +19,14 @@ typedef struct {
     SceneManager* scene_manager;
     ViewDispatcher* view_dispatcher;
     Widget* widget;
+    TextBox* text_box;
 
+    Storage* storage;
+    Stream* stream;
     FuriString* path;
 } TextViewer;
 
 typedef enum {
     TextViewerViewWidget,
+    TextViewerViewTextBox,
 } TextViewerView;
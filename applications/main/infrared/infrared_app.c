@@ -271,6 +271,7 @@ static void infrared_free(InfraredApp* infrared) {
 
     infrared_brute_force_free(infrared->brute_force);
     infrared_signal_free(infrared->current_signal);
+    // Pending edits are written out to the remote file here
     infrared_remote_free(infrared->remote);
     infrared_worker_free(infrared->worker);
 
@@ -28,9 +28,9 @@
 
 #include <notification/notification_messages.h>
 #include <infrared/worker/infrared_worker.h>
+#include <infrared/signal/infrared_remote.h>
 
 #include "infrared_app.h"
-#include "infrared_remote.h"
 #include "infrared_brute_force.h"
 #include "infrared_custom_event.h"
 
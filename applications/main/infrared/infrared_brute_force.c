@@ -4,7 +4,7 @@
 #include <m-dict.h>
 #include <flipper_format/flipper_format.h>
 
-#include "infrared_signal.h"
+#include <infrared/signal/infrared_signal.h>
 
 typedef struct {
     uint32_t index;
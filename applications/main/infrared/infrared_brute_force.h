@@ -10,7 +10,7 @@
 
 #include <stdint.h>
 #include <stdbool.h>
-#include "infrared_error_code.h"
+#include <infrared/signal/infrared_error_code.h>
 
 /**
  * @brief InfraredBruteForce opaque type declaration.
@@ -8,7 +8,7 @@
 #include <toolbox/strint.h>
 #include <m-dict.h>
 
-#include "infrared_signal.h"
+#include <infrared/signal/infrared_signal.h>
 #include "infrared_brute_force.h"
 
 #define INFRARED_CLI_BUF_SIZE            (10U)
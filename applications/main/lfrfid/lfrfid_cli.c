@@ -12,6 +12,7 @@
 #include <toolbox/protocols/protocol_dict.h>
 #include <lfrfid/protocols/lfrfid_protocols.h>
 #include <lfrfid/lfrfid_raw_file.h>
+#include <lfrfid/lfrfid_raw_analyzer.h>
 #include <toolbox/pulse_protocols/pulse_glue.h>
 
 static void lfrfid_cli_print_usage(void) {
@@ -23,6 +24,8 @@ static void lfrfid_cli_print_usage(void) {
         "rfid raw_emulate <filename>                   - emulate raw data (not very useful, but helps debug protocols)\r\n");
     printf(
         "rfid raw_analyze <filename>                   - outputs raw data to the cli and tries to decode it (useful for protocol development)\r\n");
+    printf(
+        "rfid raw_scan <filename> [<filename> ...]     - decodes whole raw files, shows results with confidence and decode time\r\n");
 }
 
 typedef struct {
@@ -377,6 +380,96 @@ static void lfrfid_cli_raw_analyze(Cli* cli, FuriString* args) {
     furi_record_close(RECORD_STORAGE);
 }
 
+static void lfrfid_cli_raw_scan(Cli* cli, FuriString* args) {
+    FuriString* filepath = furi_string_alloc();
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    ProtocolDict* dict = protocol_dict_alloc(lfrfid_protocols, LFRFIDProtocolMax);
+    LFRFIDRawAnalyzer* analyzer = lfrfid_raw_analyzer_alloc(dict);
+
+    uint32_t total_files = 0;
+    uint32_t total_found = 0;
+    uint32_t total_time = 0;
+
+    while(args_read_probably_quoted_string_and_trim(args, filepath)) {
+        if(cli_cmd_interrupt_received(cli)) break;
+
+        LFRFIDRawFile* file = lfrfid_raw_file_alloc(storage);
+        float frequency = 0;
+        float duty_cycle = 0;
+
+        printf("%s: ", furi_string_get_cstr(filepath));
+        total_files++;
+
+        do {
+            if(!lfrfid_raw_file_open_read(file, furi_string_get_cstr(filepath))) {
+                printf("failed to open file\r\n");
+                break;
+            }
+
+            if(!lfrfid_raw_file_read_header(file, &frequency, &duty_cycle)) {
+                printf("invalid header\r\n");
+                break;
+            }
+
+            lfrfid_raw_analyzer_reset(analyzer);
+            if(!lfrfid_raw_analyzer_feed_file(analyzer, file)) {
+                printf("read error, ");
+            }
+
+            LFRFIDRawAnalyzerStats stats;
+            ProtocolId protocol = lfrfid_raw_analyzer_get_result(analyzer, &stats);
+            total_time += stats.decode_time_us;
+
+            if(protocol != PROTOCOL_NO) {
+                total_found++;
+                size_t data_size = protocol_dict_get_data_size(dict, protocol);
+                uint8_t* data = malloc(data_size);
+                protocol_dict_get_data(dict, protocol, data, data_size);
+
+                printf("%s [", protocol_dict_get_name(dict, protocol));
+                for(size_t i = 0; i < data_size; i++) {
+                    printf("%02X", data[i]);
+                    if(i < data_size - 1) {
+                        printf(" ");
+                    }
+                }
+                printf("]\r\n");
+                free(data);
+            } else {
+                printf("not found\r\n");
+            }
+
+            printf(
+                "  Confidence: %lu/%lu windows (%lu with any protocol)\r\n",
+                stats.windows_matched,
+                stats.windows,
+                stats.windows_decoded);
+            printf(
+                "  Pairs: %lu, warns: %lu, decode time: %lu us\r\n",
+                stats.pairs,
+                stats.warnings,
+                stats.decode_time_us);
+        } while(false);
+
+        lfrfid_raw_file_free(file);
+    }
+
+    if(total_files == 0) {
+        lfrfid_cli_print_usage();
+    } else {
+        printf(
+            "Found in %lu of %lu files, total decode time: %lu us\r\n",
+            total_found,
+            total_files,
+            total_time);
+    }
+
+    lfrfid_raw_analyzer_free(analyzer);
+    protocol_dict_free(dict);
+    furi_record_close(RECORD_STORAGE);
+    furi_string_free(filepath);
+}
+
 static void lfrfid_cli_raw_read_callback(LFRFIDWorkerReadRawResult result, void* context) {
     furi_assert(context);
     FuriEventFlag* event = context;
@@ -562,6 +655,8 @@ static void lfrfid_cli(Cli* cli, FuriString* args, void* context) {
         lfrfid_cli_raw_emulate(cli, args);
     } else if(furi_string_cmp_str(cmd, "raw_analyze") == 0) {
         lfrfid_cli_raw_analyze(cli, args);
+    } else if(furi_string_cmp_str(cmd, "raw_scan") == 0) {
+        lfrfid_cli_raw_scan(cli, args);
     } else {
         lfrfid_cli_print_usage();
     }
@@ -55,6 +55,7 @@
 
 #include <nfc/nfc_device.h>
 #include <nfc/helpers/nfc_data_generator.h>
+#include <nfc/helpers/mf_classic_key_stats.h>
 #include <toolbox/keys_dict.h>
 
 #include <gui/modules/validators.h>
@@ -80,6 +81,7 @@
 #define NFC_APP_MF_CLASSIC_DICT_SYSTEM_PATH (NFC_APP_FOLDER "/assets/mf_classic_dict.nfc")
 #define NFC_APP_MF_CLASSIC_DICT_SYSTEM_NESTED_PATH \
     (NFC_APP_FOLDER "/assets/mf_classic_dict_nested.nfc")
+#define NFC_APP_MF_CLASSIC_KEY_STATS_PATH (NFC_APP_FOLDER "/assets/mf_classic_key_stats.nfc")
 
 typedef enum {
     NfcRpcStateIdle,
@@ -88,6 +90,8 @@ typedef enum {
 
 typedef struct {
     KeysDict* dict;
+    MfClassicKeyStats* key_stats;
+    bool key_stats_enabled;
     uint8_t sectors_total;
     uint8_t sectors_read;
     uint8_t current_sector;
@@ -43,8 +43,15 @@ NfcCommand nfc_dict_attack_worker_callback(NfcGenericEvent event, void* context)
             instance->view_dispatcher, NfcCustomEventDictAttackDataUpdate);
     } else if(mfc_event->type == MfClassicPollerEventTypeRequestKey) {
         MfClassicKey key = {};
-        if(keys_dict_get_next_key(
-               instance->nfc_dict_context.dict, key.data, sizeof(MfClassicKey))) {
+        // Keys found on previous cards go first, then the dictionary in file order
+        bool key_provided =
+            instance->nfc_dict_context.key_stats_enabled &&
+            mf_classic_key_stats_get_next_key(instance->nfc_dict_context.key_stats, &key);
+        if(!key_provided) {
+            key_provided = keys_dict_get_next_key(
+                instance->nfc_dict_context.dict, key.data, sizeof(MfClassicKey));
+        }
+        if(key_provided) {
             mfc_event->data->key_request_data.key = key;
             mfc_event->data->key_request_data.key_provided = true;
             instance->nfc_dict_context.dict_keys_current++;
@@ -72,6 +79,8 @@ NfcCommand nfc_dict_attack_worker_callback(NfcGenericEvent event, void* context)
         instance->nfc_dict_context.dict_keys_current = 0;
         instance->nfc_dict_context.current_sector =
             mfc_event->data->next_sector_data.current_sector;
+        mf_classic_key_stats_rewind(
+            instance->nfc_dict_context.key_stats, instance->nfc_dict_context.current_sector);
         view_dispatcher_send_custom_event(
             instance->view_dispatcher, NfcCustomEventDictAttackDataUpdate);
     } else if(mfc_event->type == MfClassicPollerEventTypeFoundKeyA) {
@@ -88,6 +97,8 @@ NfcCommand nfc_dict_attack_worker_callback(NfcGenericEvent event, void* context)
             instance->view_dispatcher, NfcCustomEventDictAttackDataUpdate);
     } else if(mfc_event->type == MfClassicPollerEventTypeKeyAttackStop) {
         keys_dict_rewind(instance->nfc_dict_context.dict);
+        mf_classic_key_stats_rewind(
+            instance->nfc_dict_context.key_stats, instance->nfc_dict_context.current_sector);
         instance->nfc_dict_context.is_key_attack = false;
         instance->nfc_dict_context.dict_keys_current = 0;
         view_dispatcher_send_custom_event(
@@ -182,6 +193,11 @@ static void nfc_scene_mf_classic_dict_attack_prepare_view(NfcApp* instance) {
 
     instance->nfc_dict_context.dict_keys_total =
         keys_dict_get_total_keys(instance->nfc_dict_context.dict);
+    if(instance->nfc_dict_context.key_stats_enabled) {
+        instance->nfc_dict_context.dict_keys_total +=
+            mf_classic_key_stats_get_keys_num(instance->nfc_dict_context.key_stats);
+    }
+    mf_classic_key_stats_rewind(instance->nfc_dict_context.key_stats, 0);
     dict_attack_set_total_dict_keys(
         instance->dict_attack, instance->nfc_dict_context.dict_keys_total);
     instance->nfc_dict_context.dict_keys_current = 0;
@@ -196,6 +212,12 @@ static void nfc_scene_mf_classic_dict_attack_prepare_view(NfcApp* instance) {
 void nfc_scene_mf_classic_dict_attack_on_enter(void* context) {
     NfcApp* instance = context;
 
+    // Keys from statistics are only tried in the first dictionary pass
+    instance->nfc_dict_context.key_stats = mf_classic_key_stats_alloc();
+    mf_classic_key_stats_load(
+        instance->nfc_dict_context.key_stats, NFC_APP_MF_CLASSIC_KEY_STATS_PATH);
+    instance->nfc_dict_context.key_stats_enabled = true;
+
     scene_manager_set_scene_state(
         instance->scene_manager, NfcSceneMfClassicDictAttack, DictAttackStateUserDictInProgress);
     nfc_scene_mf_classic_dict_attack_prepare_view(instance);
@@ -217,6 +239,17 @@ static void nfc_scene_mf_classic_dict_attack_notify_read(NfcApp* instance) {
     }
 }
 
+static void nfc_scene_mf_classic_dict_attack_update_key_stats(NfcApp* instance) {
+    const MfClassicData* mfc_data = nfc_poller_get_data(instance->poller);
+    if((mfc_data->key_a_mask | mfc_data->key_b_mask) == 0) return;
+
+    mf_classic_key_stats_add_card(instance->nfc_dict_context.key_stats, mfc_data);
+    if(!mf_classic_key_stats_save(
+           instance->nfc_dict_context.key_stats, NFC_APP_MF_CLASSIC_KEY_STATS_PATH)) {
+        FURI_LOG_W(TAG, "Failed to save key stats");
+    }
+}
+
 bool nfc_scene_mf_classic_dict_attack_on_event(void* context, SceneManagerEvent event) {
     NfcApp* instance = context;
     bool consumed = false;
@@ -229,6 +262,7 @@ bool nfc_scene_mf_classic_dict_attack_on_event(void* context, SceneManagerEvent
                 nfc_poller_stop(instance->poller);
                 nfc_poller_free(instance->poller);
                 keys_dict_free(instance->nfc_dict_context.dict);
+                instance->nfc_dict_context.key_stats_enabled = false;
                 scene_manager_set_scene_state(
                     instance->scene_manager,
                     NfcSceneMfClassicDictAttack,
@@ -238,6 +272,7 @@ bool nfc_scene_mf_classic_dict_attack_on_event(void* context, SceneManagerEvent
                 nfc_poller_start(instance->poller, nfc_dict_attack_worker_callback, instance);
                 consumed = true;
             } else {
+                nfc_scene_mf_classic_dict_attack_update_key_stats(instance);
                 nfc_scene_mf_classic_dict_attack_notify_read(instance);
                 scene_manager_next_scene(instance->scene_manager, NfcSceneReadSuccess);
                 dolphin_deed(DolphinDeedNfcReadSuccess);
@@ -259,6 +294,7 @@ bool nfc_scene_mf_classic_dict_attack_on_event(void* context, SceneManagerEvent
                     nfc_poller_stop(instance->poller);
                     nfc_poller_free(instance->poller);
                     keys_dict_free(instance->nfc_dict_context.dict);
+                    instance->nfc_dict_context.key_stats_enabled = false;
                     scene_manager_set_scene_state(
                         instance->scene_manager,
                         NfcSceneMfClassicDictAttack,
@@ -267,12 +303,14 @@ bool nfc_scene_mf_classic_dict_attack_on_event(void* context, SceneManagerEvent
                     instance->poller = nfc_poller_alloc(instance->nfc, NfcProtocolMfClassic);
                     nfc_poller_start(instance->poller, nfc_dict_attack_worker_callback, instance);
                 } else {
+                    nfc_scene_mf_classic_dict_attack_update_key_stats(instance);
                     nfc_scene_mf_classic_dict_attack_notify_read(instance);
                     scene_manager_next_scene(instance->scene_manager, NfcSceneReadSuccess);
                     dolphin_deed(DolphinDeedNfcReadSuccess);
                 }
                 consumed = true;
             } else if(state == DictAttackStateSystemDictInProgress) {
+                nfc_scene_mf_classic_dict_attack_update_key_stats(instance);
                 nfc_scene_mf_classic_dict_attack_notify_read(instance);
                 scene_manager_next_scene(instance->scene_manager, NfcSceneReadSuccess);
                 dolphin_deed(DolphinDeedNfcReadSuccess);
@@ -297,6 +335,9 @@ void nfc_scene_mf_classic_dict_attack_on_exit(void* context) {
         instance->scene_manager, NfcSceneMfClassicDictAttack, DictAttackStateUserDictInProgress);
 
     keys_dict_free(instance->nfc_dict_context.dict);
+    mf_classic_key_stats_free(instance->nfc_dict_context.key_stats);
+    instance->nfc_dict_context.key_stats = NULL;
+    instance->nfc_dict_context.key_stats_enabled = false;
 
     instance->nfc_dict_context.current_sector = 0;
     instance->nfc_dict_context.sectors_total = 0;
@@ -11,11 +11,16 @@ typedef enum {
     SubGhzCustomEventSceneDeleteBack,
     SubGhzCustomEventSceneDeleteRAW,
     SubGhzCustomEventSceneDeleteRAWBack,
+    SubGhzCustomEventSceneDedupRAW,
+    SubGhzCustomEventSceneDedupRAWBack,
+    SubGhzCustomEventSceneDedupRAWDone,
+    SubGhzCustomEventSceneDedupRAWError,
 
     SubGhzCustomEventSceneReceiverInfoTxStart,
     SubGhzCustomEventSceneReceiverInfoTxStop,
     SubGhzCustomEventSceneReceiverInfoSave,
     SubGhzCustomEventSceneReceiverInfoSats,
+    SubGhzCustomEventSceneReceiverHopperHit,
     SubGhzCustomEventSceneSaveName,
     SubGhzCustomEventSceneSaveSuccess,
     SubGhzCustomEventSceneShowErrorBack,
@@ -2,12 +2,28 @@
 #include <lib/drivers/cc1101.h>
 
 #include <furi.h>
+#include <furi_hal_cortex.h>
 #include <float_tools.h>
 
 #define TAG "SubghzFrequencyAnalyzerWorker"
 
 #define SUBGHZ_FREQUENCY_ANALYZER_THRESHOLD -97.0f
 
+#define SUBGHZ_FREQUENCY_ANALYZER_FINE_SPAN 300000
+#define SUBGHZ_FREQUENCY_ANALYZER_FINE_STEP 20000
+#define SUBGHZ_FREQUENCY_ANALYZER_FINE_STEPS \
+    (2 * SUBGHZ_FREQUENCY_ANALYZER_FINE_SPAN / SUBGHZ_FREQUENCY_ANALYZER_FINE_STEP)
+
+// Spectrum mode: RSSI bursts instead of single readings
+#define SUBGHZ_FREQUENCY_ANALYZER_SETTLE_US     1000
+#define SUBGHZ_FREQUENCY_ANALYZER_SAMPLE_US     50
+#define SUBGHZ_FREQUENCY_ANALYZER_BURST_SAMPLES 16
+#define SUBGHZ_FREQUENCY_ANALYZER_ENVELOPE_SIZE SUBGHZ_SPECTRUM_SIZE_MAX
+// Level over the quietest of the last sweeps for a frequency to be a candidate
+#define SUBGHZ_FREQUENCY_ANALYZER_FLOOR_MARGIN 6
+// Sweeps kept to find the quietest level of every frequency
+#define SUBGHZ_FREQUENCY_ANALYZER_WATERFALL_ROWS 32
+
 static const uint8_t subghz_preset_ook_58khz[][2] = {
     {CC1101_MDMCFG4, 0b11110111}, // Rx BW filter is 58.035714kHz
     /* End  */
@@ -35,6 +51,13 @@ struct SubGhzFrequencyAnalyzerWorker {
     float filVal;
     float trigger_level;
 
+    SubGhzFrequencyAnalyzerMode mode;
+    uint8_t* waterfall; // Coarse levels of last sweeps, dBm + 127
+    size_t waterfall_columns;
+    size_t waterfall_row;
+    int16_t envelope[SUBGHZ_FREQUENCY_ANALYZER_ENVELOPE_SIZE];
+    SubGhzFrequencyAnalyzerSignal signal;
+
     SubGhzFrequencyAnalyzerWorkerPairCallback pair_callback;
     void* context;
 };
@@ -67,6 +90,67 @@ static uint32_t subghz_frequency_analyzer_worker_expRunningAverageAdaptive(
     return (uint32_t)instance->filVal;
 }
 
+static uint32_t subghz_frequency_analyzer_worker_set_frequency(
+    FuriHalSpiBusHandle* spi_bus,
+    uint32_t value) {
+    furi_hal_spi_acquire(spi_bus);
+    cc1101_switch_to_idle(spi_bus);
+    uint32_t frequency = cc1101_set_frequency(spi_bus, value);
+
+    cc1101_calibrate(spi_bus);
+
+    furi_check(cc1101_wait_status_state(spi_bus, CC1101StateIDLE, 10000));
+
+    cc1101_switch_to_rx(spi_bus);
+    furi_hal_spi_release(spi_bus);
+
+    return frequency;
+}
+
+// Sweep mode reads RSSI once, spectrum mode takes the strongest of a burst, so keyed
+// signals aren't missed between pulses. Burst is kept as envelope.
+static float subghz_frequency_analyzer_worker_get_rssi(
+    SubGhzFrequencyAnalyzerWorker* instance,
+    size_t samples) {
+    if(instance->mode == SubGhzFrequencyAnalyzerModeSweep) {
+        furi_delay_ms(2);
+        // return furi_hal_subghz_get_rssi();
+        return subghz_devices_get_rssi(instance->radio_device);
+    }
+
+    furi_delay_us(SUBGHZ_FREQUENCY_ANALYZER_SETTLE_US);
+
+    float rssi_max = -127.0f;
+    for(size_t i = 0; i < samples; i++) {
+        FuriHalCortexTimer timer = furi_hal_cortex_timer_get(SUBGHZ_FREQUENCY_ANALYZER_SAMPLE_US);
+        float rssi = subghz_devices_get_rssi(instance->radio_device);
+        instance->envelope[i] = (int16_t)(rssi * SUBGHZ_SPECTRUM_ENVELOPE_SCALE);
+        if(rssi > rssi_max) rssi_max = rssi;
+        furi_hal_cortex_timer_wait(timer);
+    }
+
+    return rssi_max;
+}
+
+// Put coarse level to the waterfall, returns true if it stands out from the quietest
+// level of the frequency in the previous sweeps, so always busy frequencies are ignored
+static bool subghz_frequency_analyzer_worker_waterfall_put(
+    SubGhzFrequencyAnalyzerWorker* instance,
+    size_t column,
+    float rssi) {
+    if(!instance->waterfall || column >= instance->waterfall_columns) return true;
+
+    uint8_t level = (uint8_t)CLAMP(rssi + 127.0f, 255.0f, 0.0f);
+    uint8_t floor = UINT8_MAX;
+    for(size_t row = 0; row < SUBGHZ_FREQUENCY_ANALYZER_WATERFALL_ROWS; row++) {
+        if(row == instance->waterfall_row) continue;
+        floor = MIN(floor, instance->waterfall[row * instance->waterfall_columns + column]);
+    }
+    instance->waterfall[instance->waterfall_row * instance->waterfall_columns + column] = level;
+
+    return level >= floor + SUBGHZ_FREQUENCY_ANALYZER_FLOOR_MARGIN;
+}
+
 /** Worker thread
  * 
  * @param context 
@@ -137,28 +221,19 @@ static int32_t subghz_frequency_analyzer_worker_thread(void* context) {
                  ((current_frequency == 390000000) || (current_frequency == 312000000) ||
                   (current_frequency == 312100000) || (current_frequency == 312200000) ||
                   (current_frequency == 440175000)))) {
-                furi_hal_spi_acquire(spi_bus);
-                cc1101_switch_to_idle(spi_bus);
-                frequency = cc1101_set_frequency(spi_bus, current_frequency);
+                frequency =
+                    subghz_frequency_analyzer_worker_set_frequency(spi_bus, current_frequency);
 
-                cc1101_calibrate(spi_bus);
-
-                furi_check(cc1101_wait_status_state(spi_bus, CC1101StateIDLE, 10000));
-
-                cc1101_switch_to_rx(spi_bus);
-                furi_hal_spi_release(spi_bus);
-
-                furi_delay_ms(2);
-
-                // rssi = furi_hal_subghz_get_rssi();
-                rssi = subghz_devices_get_rssi(radio_device);
+                rssi = subghz_frequency_analyzer_worker_get_rssi(
+                    instance, SUBGHZ_FREQUENCY_ANALYZER_BURST_SAMPLES);
 
                 rssi_avg += rssi;
                 rssi_avg_samples++;
 
                 if(rssi < rssi_min) rssi_min = rssi;
 
-                if(frequency_rssi.rssi_coarse < rssi) {
+                if(subghz_frequency_analyzer_worker_waterfall_put(instance, i, rssi) &&
+                   frequency_rssi.rssi_coarse < rssi) {
                     frequency_rssi.rssi_coarse = rssi;
                     frequency_rssi.frequency_coarse = frequency;
                 }
@@ -173,41 +248,73 @@ static int32_t subghz_frequency_analyzer_worker_thread(void* context) {
             frequency_rssi.frequency_coarse,
             (double)rssi_min);
 
+        if(instance->waterfall) {
+            instance->waterfall_row =
+                (instance->waterfall_row + 1) % SUBGHZ_FREQUENCY_ANALYZER_WATERFALL_ROWS;
+        }
+
         // Second stage: fine scan
         if(frequency_rssi.rssi_coarse > instance->trigger_level) {
+            float fine_levels[SUBGHZ_FREQUENCY_ANALYZER_FINE_STEPS];
+            size_t fine_count = 0;
+            uint32_t fine_start = furi_get_tick();
+
             // furi_hal_subghz_idle();
             subghz_devices_idle(radio_device);
             subghz_frequency_analyzer_worker_load_registers(spi_bus, subghz_preset_ook_58khz);
             //for example -0.3 ... 433.92 ... +0.3 step 20KHz
-            for(uint32_t i = frequency_rssi.frequency_coarse - 300000;
-                i < frequency_rssi.frequency_coarse + 300000;
-                i += 20000) {
+            for(uint32_t i = frequency_rssi.frequency_coarse - SUBGHZ_FREQUENCY_ANALYZER_FINE_SPAN;
+                i < frequency_rssi.frequency_coarse + SUBGHZ_FREQUENCY_ANALYZER_FINE_SPAN;
+                i += SUBGHZ_FREQUENCY_ANALYZER_FINE_STEP) {
                 // if(furi_hal_subghz_is_frequency_valid(i)) {
                 if(subghz_devices_is_frequency_valid(radio_device, i)) {
-                    furi_hal_spi_acquire(spi_bus);
-                    cc1101_switch_to_idle(spi_bus);
-                    frequency = cc1101_set_frequency(spi_bus, i);
-
-                    cc1101_calibrate(spi_bus);
-
-                    furi_check(cc1101_wait_status_state(spi_bus, CC1101StateIDLE, 10000));
+                    frequency = subghz_frequency_analyzer_worker_set_frequency(spi_bus, i);
 
-                    cc1101_switch_to_rx(spi_bus);
-                    furi_hal_spi_release(spi_bus);
-
-                    furi_delay_ms(2);
-
-                    // rssi = furi_hal_subghz_get_rssi();
-                    rssi = subghz_devices_get_rssi(radio_device);
+                    rssi = subghz_frequency_analyzer_worker_get_rssi(
+                        instance, SUBGHZ_FREQUENCY_ANALYZER_BURST_SAMPLES);
 
                     FURI_LOG_T(TAG, "#:%lu:%f", frequency, (double)rssi);
 
+                    fine_levels[fine_count++] = rssi;
                     if(frequency_rssi.rssi_fine < rssi) {
                         frequency_rssi.rssi_fine = rssi;
                         frequency_rssi.frequency_fine = frequency;
                     }
                 }
             }
+
+            FURI_LOG_T(
+                TAG,
+                "Fine scan: %lu ms/MHz",
+                (furi_get_tick() - fine_start) * 1000000UL /
+                    (2 * SUBGHZ_FREQUENCY_ANALYZER_FINE_SPAN));
+
+            // Spectrum mode: look closer at the peak
+            if(instance->mode == SubGhzFrequencyAnalyzerModeSpectrum &&
+               frequency_rssi.rssi_fine > instance->trigger_level) {
+                SubGhzFrequencyAnalyzerSignal* signal = &instance->signal;
+                signal->bandwidth = subghz_spectrum_get_bandwidth(
+                    fine_levels, fine_count, SUBGHZ_FREQUENCY_ANALYZER_FINE_STEP);
+
+                subghz_frequency_analyzer_worker_set_frequency(
+                    spi_bus, frequency_rssi.frequency_fine);
+                subghz_frequency_analyzer_worker_get_rssi(
+                    instance, SUBGHZ_FREQUENCY_ANALYZER_ENVELOPE_SIZE);
+                signal->modulation = subghz_spectrum_get_modulation(
+                    instance->envelope,
+                    SUBGHZ_FREQUENCY_ANALYZER_ENVELOPE_SIZE,
+                    1000000UL / SUBGHZ_FREQUENCY_ANALYZER_SAMPLE_US,
+                    &signal->keying_frequency);
+                signal->frequency = frequency_rssi.frequency_fine;
+
+                FURI_LOG_D(
+                    TAG,
+                    "Spectrum: %lu bw %lu %s %lu",
+                    signal->frequency,
+                    signal->bandwidth,
+                    signal->modulation == SubGhzSpectrumModulationKeyed ? "keyed" : "carrier",
+                    signal->keying_frequency);
+            }
         }
 
         // Deliver results fine
@@ -289,7 +396,7 @@ SubGhzFrequencyAnalyzerWorker* subghz_frequency_analyzer_worker_alloc(void* cont
 
     instance->thread = furi_thread_alloc();
     furi_thread_set_name(instance->thread, "SubGhzFAWorker");
-    furi_thread_set_stack_size(instance->thread, 2048);
+    furi_thread_set_stack_size(instance->thread, 3072);
     furi_thread_set_context(instance->thread, instance);
     furi_thread_set_callback(instance->thread, subghz_frequency_analyzer_worker_thread);
 
@@ -297,6 +404,15 @@ SubGhzFrequencyAnalyzerWorker* subghz_frequency_analyzer_worker_alloc(void* cont
     instance->setting = subghz_txrx_get_setting(subghz->txrx);
     instance->trigger_level = subghz->last_settings->frequency_analyzer_trigger;
     //instance->trigger_level = SUBGHZ_FREQUENCY_ANALYZER_THRESHOLD;
+
+    instance->mode = subghz->last_settings->frequency_analyzer_spectrum ?
+                         SubGhzFrequencyAnalyzerModeSpectrum :
+                         SubGhzFrequencyAnalyzerModeSweep;
+    if(instance->mode == SubGhzFrequencyAnalyzerModeSpectrum) {
+        instance->waterfall_columns = subghz_setting_get_frequency_count(instance->setting);
+        instance->waterfall =
+            malloc(instance->waterfall_columns * SUBGHZ_FREQUENCY_ANALYZER_WATERFALL_ROWS);
+    }
     return instance;
 }
 
@@ -304,6 +420,7 @@ void subghz_frequency_analyzer_worker_free(SubGhzFrequencyAnalyzerWorker* instan
     furi_assert(instance);
 
     furi_thread_free(instance->thread);
+    free(instance->waterfall);
     free(instance);
 }
 
@@ -365,3 +482,20 @@ void subghz_frequency_analyzer_worker_set_trigger_level(
 float subghz_frequency_analyzer_worker_get_trigger_level(SubGhzFrequencyAnalyzerWorker* instance) {
     return instance->trigger_level;
 }
+
+SubGhzFrequencyAnalyzerMode
+    subghz_frequency_analyzer_worker_get_mode(SubGhzFrequencyAnalyzerWorker* instance) {
+    furi_assert(instance);
+    return instance->mode;
+}
+
+bool subghz_frequency_analyzer_worker_get_signal(
+    SubGhzFrequencyAnalyzerWorker* instance,
+    SubGhzFrequencyAnalyzerSignal* signal) {
+    furi_assert(instance);
+    furi_assert(signal);
+
+    if(instance->signal.frequency == 0) return false;
+    *signal = instance->signal;
+    return true;
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <furi_hal.h>
+#include <lib/subghz/subghz_spectrum.h>
 #include "../subghz_i.h"
 
 typedef struct SubGhzFrequencyAnalyzerWorker SubGhzFrequencyAnalyzerWorker;
@@ -18,6 +19,18 @@ typedef struct {
     float rssi_fine;
 } FrequencyRSSI;
 
+typedef enum {
+    SubGhzFrequencyAnalyzerModeSweep, /**< Single RSSI reading per step */
+    SubGhzFrequencyAnalyzerModeSpectrum, /**< RSSI burst per step, peak signal is analyzed */
+} SubGhzFrequencyAnalyzerMode;
+
+typedef struct {
+    uint32_t frequency;
+    uint32_t bandwidth;
+    SubGhzSpectrumModulation modulation;
+    uint32_t keying_frequency;
+} SubGhzFrequencyAnalyzerSignal;
+
 /** Allocate SubGhzFrequencyAnalyzerWorker
  * 
  * @param context SubGhz* context
@@ -78,3 +91,21 @@ void subghz_frequency_analyzer_worker_set_trigger_level(
  * @return RSSI trigger level
  */
 float subghz_frequency_analyzer_worker_get_trigger_level(SubGhzFrequencyAnalyzerWorker* instance);
+
+/** Get analyzer mode, chosen in radio settings
+ * 
+ * @param instance SubGhzFrequencyAnalyzerWorker instance
+ * @return SubGhzFrequencyAnalyzerMode
+ */
+SubGhzFrequencyAnalyzerMode
+    subghz_frequency_analyzer_worker_get_mode(SubGhzFrequencyAnalyzerWorker* instance);
+
+/** Get last signal analyzed in spectrum mode
+ * 
+ * @param instance SubGhzFrequencyAnalyzerWorker instance
+ * @param signal SubGhzFrequencyAnalyzerSignal to fill
+ * @return true if there was a signal
+ */
+bool subghz_frequency_analyzer_worker_get_signal(
+    SubGhzFrequencyAnalyzerWorker* instance,
+    SubGhzFrequencyAnalyzerSignal* signal);
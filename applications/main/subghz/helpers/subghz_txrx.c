@@ -7,6 +7,10 @@
 
 #define TAG "SubGhzTxRx"
 
+#define SUBGHZ_TXRX_TX_REPEAT 200
+// Longest uploads, BinRAW and Nice FloR-S, fit with one word per pulse
+#define SUBGHZ_TXRX_TX_BUFFER_SIZE 3072
+
 static void subghz_txrx_radio_device_power_on(SubGhzTxRx* instance) {
     UNUSED(instance);
     uint8_t attempts = 0;
@@ -26,6 +30,8 @@ SubGhzTxRx* subghz_txrx_alloc(void) {
     SubGhzTxRx* instance = malloc(sizeof(SubGhzTxRx));
     instance->setting = subghz_setting_alloc();
     subghz_setting_load(instance->setting, EXT_PATH("subghz/assets/setting_user.txt"));
+    instance->hopper =
+        subghz_hopper_alloc(subghz_setting_get_hopper_frequency_count(instance->setting), 1);
 
     instance->preset = malloc(sizeof(SubGhzRadioPreset));
     instance->preset->name = furi_string_alloc();
@@ -82,6 +88,7 @@ void subghz_txrx_free(SubGhzTxRx* instance) {
     subghz_environment_free(instance->environment);
     flipper_format_free(instance->fff_data);
     furi_string_free(instance->preset->name);
+    subghz_hopper_free(instance->hopper);
     subghz_setting_free(instance->setting);
 
     free(instance->preset);
@@ -238,6 +245,49 @@ static bool subghz_txrx_tx(SubGhzTxRx* instance, uint32_t frequency) {
     return ret;
 }
 
+static void subghz_txrx_tx_render_free(SubGhzTxRx* instance) {
+    if(instance->tx_queue) {
+        subghz_tx_queue_free(instance->tx_queue);
+        instance->tx_queue = NULL;
+    }
+    if(instance->tx_buffer) {
+        subghz_tx_buffer_free(instance->tx_buffer);
+        instance->tx_buffer = NULL;
+    }
+}
+
+/** Render one upload, so async TX interrupt only copies pulses
+ *
+ * Encoder must be deserialized with Repeat 1. A static signal too long for the
+ * buffer is loaded again in a new encoder and streamed. Dynamic one can not be,
+ * since every deserialize advances the counter, this is an error.
+ */
+static bool subghz_txrx_tx_render(
+    SubGhzTxRx* instance,
+    FlipperFormat* flipper_format,
+    const SubGhzProtocol* protocol) {
+    instance->tx_buffer = subghz_tx_buffer_alloc(SUBGHZ_TXRX_TX_BUFFER_SIZE);
+    if(subghz_tx_buffer_render(
+           instance->tx_buffer, subghz_transmitter_yield, instance->transmitter)) {
+        instance->tx_queue = subghz_tx_queue_alloc();
+        subghz_tx_queue_add(instance->tx_queue, instance->tx_buffer, SUBGHZ_TXRX_TX_REPEAT, 0);
+        return true;
+    }
+    subghz_txrx_tx_render_free(instance);
+
+    if(protocol->type == SubGhzProtocolTypeDynamic) {
+        FURI_LOG_E(TAG, "Upload doesn't fit in TX buffer");
+        return false;
+    }
+    FURI_LOG_W(TAG, "Upload doesn't fit in TX buffer, streaming");
+    subghz_transmitter_free(instance->transmitter);
+    instance->transmitter = subghz_transmitter_alloc_init(instance->environment, protocol->name);
+    uint32_t repeat = SUBGHZ_TXRX_TX_REPEAT;
+    return flipper_format_insert_or_update_uint32(flipper_format, "Repeat", &repeat, 1) &&
+           subghz_transmitter_deserialize(instance->transmitter, flipper_format) ==
+               SubGhzProtocolStatusOk;
+}
+
 SubGhzTxRxStartTxState subghz_txrx_tx_start(SubGhzTxRx* instance, FlipperFormat* flipper_format) {
     furi_assert(instance);
     furi_assert(flipper_format);
@@ -246,7 +296,6 @@ SubGhzTxRxStartTxState subghz_txrx_tx_start(SubGhzTxRx* instance, FlipperFormat*
 
     SubGhzTxRxStartTxState ret = SubGhzTxRxStartTxStateErrorParserOthers;
     FuriString* temp_str = furi_string_alloc();
-    uint32_t repeat = 200;
     do {
         if(!flipper_format_rewind(flipper_format)) {
             FURI_LOG_E(TAG, "Rewind error");
@@ -256,6 +305,12 @@ SubGhzTxRxStartTxState subghz_txrx_tx_start(SubGhzTxRx* instance, FlipperFormat*
             FURI_LOG_E(TAG, "Missing Protocol");
             break;
         }
+        // RAW is streamed from the file, other signals are encoded once and repeated
+        const SubGhzProtocol* protocol = subghz_protocol_registry_get_by_name(
+            subghz_environment_get_protocol_registry(instance->environment),
+            furi_string_get_cstr(temp_str));
+        bool render = protocol && protocol->type != SubGhzProtocolTypeRAW;
+        uint32_t repeat = render ? 1 : SUBGHZ_TXRX_TX_REPEAT;
         if(!flipper_format_insert_or_update_uint32(flipper_format, "Repeat", &repeat, 1)) {
             FURI_LOG_E(TAG, "Unable Repeat");
             break;
@@ -269,7 +324,9 @@ SubGhzTxRxStartTxState subghz_txrx_tx_start(SubGhzTxRx* instance, FlipperFormat*
         if(instance->transmitter) {
             if(subghz_transmitter_deserialize(instance->transmitter, flipper_format) ==
                SubGhzProtocolStatusOk) {
-                if(strcmp(furi_string_get_cstr(preset->name), "") != 0) {
+                if(render && !subghz_txrx_tx_render(instance, flipper_format, protocol)) {
+                    ret = SubGhzTxRxStartTxStateErrorParserOthers;
+                } else if(strcmp(furi_string_get_cstr(preset->name), "") != 0) {
                     subghz_txrx_begin(
                         instance,
                         subghz_setting_get_preset_data_by_name(
@@ -291,8 +348,20 @@ SubGhzTxRxStartTxState subghz_txrx_tx_start(SubGhzTxRx* instance, FlipperFormat*
 
                 if(ret == SubGhzTxRxStartTxStateOk) {
                     //Start TX
-                    subghz_devices_start_async_tx(
-                        instance->radio_device, subghz_transmitter_yield, instance->transmitter);
+                    bool started = false;
+                    if(instance->tx_queue) {
+                        started =
+                            subghz_tx_queue_start(instance->tx_queue, instance->radio_device);
+                    } else {
+                        started = subghz_devices_start_async_tx(
+                            instance->radio_device,
+                            subghz_transmitter_yield,
+                            instance->transmitter);
+                    }
+                    if(!started) {
+                        FURI_LOG_E(TAG, "Only Rx");
+                        ret = SubGhzTxRxStartTxStateErrorOnlyRx;
+                    }
                 }
             } else {
                 ret = SubGhzTxRxStartTxStateErrorParserOthers;
@@ -302,6 +371,7 @@ SubGhzTxRxStartTxState subghz_txrx_tx_start(SubGhzTxRx* instance, FlipperFormat*
         }
         if(ret != SubGhzTxRxStartTxStateOk) {
             if(instance->transmitter) subghz_transmitter_free(instance->transmitter);
+            subghz_txrx_tx_render_free(instance);
             if(instance->txrx_state != SubGhzTxRxStateIDLE) {
                 subghz_txrx_idle(instance);
             }
@@ -335,9 +405,14 @@ static void subghz_txrx_tx_stop(SubGhzTxRx* instance) {
     furi_assert(instance);
     furi_assert(instance->txrx_state == SubGhzTxRxStateTx);
     //Stop TX
-    subghz_devices_stop_async_tx(instance->radio_device);
+    if(instance->tx_queue) {
+        subghz_tx_queue_stop(instance->tx_queue);
+    } else {
+        subghz_devices_stop_async_tx(instance->radio_device);
+    }
     subghz_transmitter_stop(instance->transmitter);
     subghz_transmitter_free(instance->transmitter);
+    subghz_txrx_tx_render_free(instance);
 
     //if protocol dynamic then we save the last upload
     if(instance->decoder_result->protocol->type == SubGhzProtocolTypeDynamic) {
@@ -384,49 +459,39 @@ void subghz_txrx_hopper_update(SubGhzTxRx* instance, float stay_threshold) {
     case SubGhzHopperStateOFF:
     case SubGhzHopperStatePause:
         return;
-    case SubGhzHopperStateRSSITimeOut:
-        if(instance->hopper_timeout != 0) {
-            instance->hopper_timeout--;
-            return;
-        }
-        break;
     default:
         break;
     }
-    //    Init value isn't using
-    //    float rssi = -127.0f;
-    if(instance->hopper_state != SubGhzHopperStateRSSITimeOut) {
-        // See RSSI Calculation timings in CC1101 17.3 RSSI
-        float rssi = subghz_devices_get_rssi(instance->radio_device);
-
-        // Stay if RSSI is high enough
-        if(rssi > stay_threshold) {
-            instance->hopper_timeout = 10;
-            instance->hopper_state = SubGhzHopperStateRSSITimeOut;
-            return;
-        }
-    } else {
-        instance->hopper_state = SubGhzHopperStateRunning;
-    }
-    // Select next frequency
-    if(instance->hopper_idx_frequency <
-       subghz_setting_get_hopper_frequency_count(instance->setting) - 1) {
-        instance->hopper_idx_frequency++;
-    } else {
-        instance->hopper_idx_frequency = 0;
-    }
+
+    // See RSSI Calculation timings in CC1101 17.3 RSSI
+    float rssi = subghz_devices_get_rssi(instance->radio_device);
+
+    // Stay if RSSI is high enough, otherwise select next frequency
+    if(!subghz_hopper_update(instance->hopper, 0, rssi, stay_threshold)) return;
 
     if(instance->txrx_state == SubGhzTxRxStateRx) {
         subghz_txrx_rx_end(instance);
     }
     if(instance->txrx_state == SubGhzTxRxStateIDLE) {
         subghz_receiver_reset(instance->receiver);
-        instance->preset->frequency =
-            subghz_setting_get_hopper_frequency(instance->setting, instance->hopper_idx_frequency);
+        instance->preset->frequency = subghz_setting_get_hopper_frequency(
+            instance->setting, subghz_hopper_get_frequency_idx(instance->hopper, 0));
         subghz_txrx_rx(instance, instance->preset->frequency);
     }
 }
 
+void subghz_txrx_hopper_add_hit(SubGhzTxRx* instance) {
+    furi_assert(instance);
+
+    if(instance->hopper_state == SubGhzHopperStateOFF) return;
+
+    subghz_hopper_add_hit(instance->hopper, 0);
+    FURI_LOG_D(
+        TAG,
+        "Capture probability %.2f",
+        (double)subghz_hopper_get_capture_probability(instance->hopper));
+}
+
 SubGhzHopperState subghz_txrx_hopper_get_state(SubGhzTxRx* instance) {
     furi_assert(instance);
     return instance->hopper_state;
@@ -4,6 +4,7 @@
 
 #include <lib/subghz/subghz_worker.h>
 #include <lib/subghz/subghz_setting.h>
+#include <lib/subghz/subghz_hopper.h>
 #include <lib/subghz/receiver.h>
 #include <lib/subghz/transmitter.h>
 #include <lib/subghz/protocols/raw.h>
@@ -175,6 +176,15 @@ void subghz_txrx_hopper_unpause(SubGhzTxRx* instance);
  */
 void subghz_txrx_hopper_pause(SubGhzTxRx* instance);
 
+/**
+ * Report a signal decoded on the current hopper frequency,
+ * so it is visited more often. Call from the same thread
+ * as subghz_txrx_hopper_update
+ * 
+ * @param instance Pointer to a SubGhzTxRx
+ */
+void subghz_txrx_hopper_add_hit(SubGhzTxRx* instance);
+
 /**
  * Speaker on
  * 
@@ -2,20 +2,23 @@
 
 #include "subghz_txrx.h"
 
+#include <lib/subghz/subghz_tx_queue.h>
+
 struct SubGhzTxRx {
     SubGhzWorker* worker;
 
     SubGhzEnvironment* environment;
     SubGhzReceiver* receiver;
     SubGhzTransmitter* transmitter;
+    SubGhzTxBuffer* tx_buffer;
+    SubGhzTxQueue* tx_queue;
     SubGhzProtocolDecoderBase* decoder_result;
     FlipperFormat* fff_data;
 
     SubGhzRadioPreset* preset;
     SubGhzSetting* setting;
 
-    uint8_t hopper_timeout;
-    uint8_t hopper_idx_frequency;
+    SubGhzHopper* hopper;
     bool is_database_loaded;
     SubGhzHopperState hopper_state;
 
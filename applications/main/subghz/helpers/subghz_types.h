@@ -25,7 +25,6 @@ typedef enum {
     SubGhzHopperStateOFF,
     SubGhzHopperStateRunning,
     SubGhzHopperStatePause,
-    SubGhzHopperStateRSSITimeOut,
 } SubGhzHopperState;
 
 /** SubGhzSpeakerState state */
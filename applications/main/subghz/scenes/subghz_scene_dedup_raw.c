@@ -0,0 +1,120 @@
+#include "../subghz_i.h"
+#include "../helpers/subghz_custom_event.h"
+
+#define SUBGHZ_DEDUP_RAW_STACK_SIZE (2 * 1024)
+
+static int32_t subghz_scene_dedup_raw_worker(void* context) {
+    SubGhz* subghz = context;
+
+    const bool success = subghz_dedup_file(subghz);
+    view_dispatcher_send_custom_event(
+        subghz->view_dispatcher,
+        success ? SubGhzCustomEventSceneDedupRAWDone : SubGhzCustomEventSceneDedupRAWError);
+
+    return 0;
+}
+
+static void subghz_scene_dedup_raw_worker_stop(SubGhz* subghz) {
+    if(subghz->dedup_thread) {
+        furi_thread_join(subghz->dedup_thread);
+        furi_thread_free(subghz->dedup_thread);
+        subghz->dedup_thread = NULL;
+    }
+}
+
+void subghz_scene_dedup_raw_callback(GuiButtonType result, InputType type, void* context) {
+    furi_assert(context);
+    SubGhz* subghz = context;
+    if((result == GuiButtonTypeRight) && (type == InputTypeShort)) {
+        view_dispatcher_send_custom_event(subghz->view_dispatcher, SubGhzCustomEventSceneDedupRAW);
+    } else if((result == GuiButtonTypeLeft) && (type == InputTypeShort)) {
+        view_dispatcher_send_custom_event(
+            subghz->view_dispatcher, SubGhzCustomEventSceneDedupRAWBack);
+    }
+}
+
+void subghz_scene_dedup_raw_popup_callback(void* context) {
+    SubGhz* subghz = context;
+    view_dispatcher_send_custom_event(subghz->view_dispatcher, SubGhzCustomEventSceneDedupRAWBack);
+}
+
+void subghz_scene_dedup_raw_on_enter(void* context) {
+    SubGhz* subghz = context;
+    FuriString* file_name = furi_string_alloc();
+
+    subghz_dedup_get_path(subghz);
+    path_extract_filename(subghz->file_path_tmp, file_name, true);
+
+    widget_add_text_box_element(
+        subghz->widget, 0, 0, 128, 23, AlignCenter, AlignCenter, "\e#Remove repeats?\e#", false);
+    widget_add_string_element(
+        subghz->widget, 64, 25, AlignCenter, AlignTop, FontSecondary, "Result is saved as");
+    widget_add_string_element(
+        subghz->widget,
+        64,
+        37,
+        AlignCenter,
+        AlignTop,
+        FontSecondary,
+        furi_string_get_cstr(file_name));
+
+    furi_string_free(file_name);
+
+    widget_add_button_element(
+        subghz->widget, GuiButtonTypeRight, "Save", subghz_scene_dedup_raw_callback, subghz);
+    widget_add_button_element(
+        subghz->widget, GuiButtonTypeLeft, "Back", subghz_scene_dedup_raw_callback, subghz);
+
+    view_dispatcher_switch_to_view(subghz->view_dispatcher, SubGhzViewIdWidget);
+}
+
+bool subghz_scene_dedup_raw_on_event(void* context, SceneManagerEvent event) {
+    SubGhz* subghz = context;
+    if(event.type == SceneManagerEventTypeCustom) {
+        if(event.event == SubGhzCustomEventSceneDedupRAW) {
+            // Long files take a while, keep the app responsive meanwhile
+            Popup* popup = subghz->popup;
+            popup_set_header(popup, "Removing\nrepeats...", 64, 32, AlignCenter, AlignCenter);
+            view_dispatcher_switch_to_view(subghz->view_dispatcher, SubGhzViewIdPopup);
+
+            subghz->dedup_thread = furi_thread_alloc_ex(
+                "SubGhzDedupWorker",
+                SUBGHZ_DEDUP_RAW_STACK_SIZE,
+                subghz_scene_dedup_raw_worker,
+                subghz);
+            furi_thread_start(subghz->dedup_thread);
+            return true;
+        } else if(event.event == SubGhzCustomEventSceneDedupRAWDone) {
+            subghz_scene_dedup_raw_worker_stop(subghz);
+            notification_message(subghz->notifications, &sequence_success);
+
+            Popup* popup = subghz->popup;
+            popup_reset(popup);
+            popup_set_icon(popup, 32, 5, &I_DolphinNice_96x59);
+            popup_set_header(popup, "Saved!", 13, 22, AlignLeft, AlignBottom);
+            popup_set_timeout(popup, 1500);
+            popup_set_context(popup, subghz);
+            popup_set_callback(popup, subghz_scene_dedup_raw_popup_callback);
+            popup_enable_timeout(popup);
+            return true;
+        } else if(event.event == SubGhzCustomEventSceneDedupRAWError) {
+            subghz_scene_dedup_raw_worker_stop(subghz);
+            dialog_message_show_storage_error(subghz->dialogs, "Cannot remove\nrepeats");
+            return scene_manager_previous_scene(subghz->scene_manager);
+        } else if(event.event == SubGhzCustomEventSceneDedupRAWBack) {
+            return scene_manager_previous_scene(subghz->scene_manager);
+        }
+    } else if(event.type == SceneManagerEventTypeBack) {
+        // Not leaving until the worker is done with the files
+        return subghz->dedup_thread != NULL;
+    }
+    return false;
+}
+
+void subghz_scene_dedup_raw_on_exit(void* context) {
+    SubGhz* subghz = context;
+    subghz_scene_dedup_raw_worker_stop(subghz);
+    widget_reset(subghz->widget);
+    popup_reset(subghz->popup);
+    furi_string_reset(subghz->file_path_tmp);
+}
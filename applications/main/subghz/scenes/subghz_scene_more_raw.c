@@ -3,6 +3,7 @@
 enum SubmenuIndex {
     SubmenuIndexDecode,
     SubmenuIndexEdit,
+    SubmenuIndexDedup,
     SubmenuIndexDelete,
 };
 
@@ -28,6 +29,13 @@ void subghz_scene_more_raw_on_enter(void* context) {
         subghz_scene_more_raw_submenu_callback,
         subghz);
 
+    submenu_add_item(
+        subghz->submenu,
+        "Remove Repeats",
+        SubmenuIndexDedup,
+        subghz_scene_more_raw_submenu_callback,
+        subghz);
+
     submenu_add_item(
         subghz->submenu,
         "Delete",
@@ -74,6 +82,19 @@ bool subghz_scene_more_raw_on_event(void* context, SceneManagerEvent event) {
                     view_dispatcher_stop(subghz->view_dispatcher);
                 }
             }
+        } else if(event.event == SubmenuIndexDedup) {
+            if(subghz_file_available(subghz)) {
+                scene_manager_set_scene_state(
+                    subghz->scene_manager, SubGhzSceneMoreRAW, SubmenuIndexDedup);
+                scene_manager_next_scene(subghz->scene_manager, SubGhzSceneDedupRAW);
+                return true;
+            } else {
+                if(!scene_manager_search_and_switch_to_previous_scene(
+                       subghz->scene_manager, SubGhzSceneStart)) {
+                    scene_manager_stop(subghz->scene_manager);
+                    view_dispatcher_stop(subghz->view_dispatcher);
+                }
+            }
         } else if(event.event == SubmenuIndexDecode) {
             if(subghz_file_available(subghz)) {
                 scene_manager_set_scene_state(
@@ -20,6 +20,12 @@ const char* const timestamp_names_text[TIMESTAMP_NAMES_COUNT] = {
     "ON",
 };
 
+#define ANALYZER_MODE_COUNT 2
+const char* const analyzer_mode_text[ANALYZER_MODE_COUNT] = {
+    "Sweep",
+    "Spectrum",
+};
+
 #define DEBUG_P_COUNT 2
 const char* const debug_pin_text[DEBUG_P_COUNT] = {
     "OFF",
@@ -145,6 +151,16 @@ static void subghz_scene_receiver_config_set_protocol_file_names(VariableItem* i
     subghz_last_settings_save(subghz->last_settings);
 }
 
+static void subghz_scene_radio_settings_set_analyzer_mode(VariableItem* item) {
+    SubGhz* subghz = variable_item_get_context(item);
+    uint8_t index = variable_item_get_current_value_index(item);
+
+    variable_item_set_current_value_text(item, analyzer_mode_text[index]);
+
+    subghz->last_settings->frequency_analyzer_spectrum = (index == 1);
+    subghz_last_settings_save(subghz->last_settings);
+}
+
 void subghz_scene_radio_settings_on_enter(void* context) {
     SubGhz* subghz = context;
 
@@ -190,6 +206,16 @@ void subghz_scene_radio_settings_on_enter(void* context) {
     variable_item_set_current_value_index(item, value_index);
     variable_item_set_current_value_text(item, timestamp_names_text[value_index]);
 
+    item = variable_item_list_add(
+        variable_item_list,
+        "Freq. Analyzer",
+        ANALYZER_MODE_COUNT,
+        subghz_scene_radio_settings_set_analyzer_mode,
+        subghz);
+    value_index = subghz->last_settings->frequency_analyzer_spectrum;
+    variable_item_set_current_value_index(item, value_index);
+    variable_item_set_current_value_text(item, analyzer_mode_text[value_index]);
+
     item = variable_item_list_add(
         variable_item_list,
         "Counter Incr.",
@@ -125,6 +125,10 @@ static void subghz_scene_add_to_history_callback(
     furi_assert(context);
     SubGhz* subghz = context;
 
+    // Called from worker thread, hopper is only touched from the app thread
+    view_dispatcher_send_custom_event(
+        subghz->view_dispatcher, SubGhzCustomEventSceneReceiverHopperHit);
+
     SubGhzHistory* history = subghz->history;
     FuriString* item_name = furi_string_alloc();
     FuriString* item_time = furi_string_alloc();
@@ -353,6 +357,10 @@ bool subghz_scene_receiver_on_event(void* context, SceneManagerEvent event) {
         subghz->idx_menu_chosen = subghz_view_receiver_get_idx_menu(subghz->subghz_receiver);
 
         switch(event.event) {
+        case SubGhzCustomEventSceneReceiverHopperHit:
+            subghz_txrx_hopper_add_hit(subghz->txrx);
+            consumed = true;
+            break;
         case SubGhzCustomEventViewReceiverBack:
             // Stop CC1101 Rx
             subghz->state_notifications = SubGhzNotificationStateIDLE;
@@ -11,6 +11,7 @@ enum SubGhzSettingIndex {
     SubGhzSettingIndexBinRAW,
     SubGhzSettingIndexRAWRSSIThreshold = SubGhzSettingIndexBinRAW,
     SubGhzSettingIndexRepeater,
+    SubGhzSettingIndexRAWFormat = SubGhzSettingIndexRepeater,
     SubGhzSettingIndexRemoveDuplicates,
     SubGhzSettingIndexDeleteOldSignals,
     SubGhzSettingIndexAutosave,
@@ -78,6 +79,11 @@ const char* const combobox_text[COMBO_BOX_COUNT] = {
     "ON",
 };
 
+const char* const raw_format_text[COMBO_BOX_COUNT] = {
+    "Text",
+    "Binary",
+};
+
 #define HOPPING_MODE_COUNT 12
 const char* const hopping_mode_text[HOPPING_MODE_COUNT] = {
     "OFF",
@@ -376,6 +382,15 @@ static void subghz_scene_receiver_config_set_raw_threshold_rssi(VariableItem* it
     subghz->last_settings->rssi = raw_threshold_rssi_value[index];
 }
 
+static void subghz_scene_receiver_config_set_raw_format(VariableItem* item) {
+    SubGhz* subghz = variable_item_get_context(item);
+    uint8_t index = variable_item_get_current_value_index(item);
+
+    variable_item_set_current_value_text(item, raw_format_text[index]);
+
+    subghz->last_settings->raw_binary = index == 1;
+}
+
 static void subghz_scene_receiver_config_set_duplicates(VariableItem* item) {
     SubGhz* subghz = variable_item_get_context(item);
     uint8_t index = variable_item_get_current_value_index(item);
@@ -475,6 +490,7 @@ static void subghz_scene_receiver_config_var_list_enter_callback(void* context,
         subghz->repeater = SubGhzRepeaterStateOff;
         subghz->last_settings->delete_old_signals = false;
         subghz->last_settings->autosave = false;
+        subghz->last_settings->raw_binary = false;
 
         subghz_txrx_speaker_set_state(subghz->txrx, speaker_value[default_index]);
         subghz->last_settings->enable_sound = false;
@@ -734,6 +750,16 @@ void subghz_scene_receiver_config_on_enter(void* context) {
             RAW_THRESHOLD_RSSI_COUNT);
         variable_item_set_current_value_index(item, value_index);
         variable_item_set_current_value_text(item, raw_threshold_rssi_text[value_index]);
+
+        item = variable_item_list_add(
+            subghz->variable_item_list,
+            "RAW Format:",
+            COMBO_BOX_COUNT,
+            subghz_scene_receiver_config_set_raw_format,
+            subghz);
+        value_index = subghz->last_settings->raw_binary;
+        variable_item_set_current_value_index(item, value_index);
+        variable_item_set_current_value_text(item, raw_format_text[value_index]);
     }
 
     variable_item_list_set_selected_item(
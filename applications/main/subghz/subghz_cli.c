@@ -9,6 +9,8 @@
 #include <lib/subghz/receiver.h>
 #include <lib/subghz/transmitter.h>
 #include <lib/subghz/subghz_file_encoder_worker.h>
+#include <lib/subghz/subghz_raw_file.h>
+#include <lib/subghz/subghz_tx_queue.h>
 #include <lib/subghz/protocols/protocol_items.h>
 #include <lib/subghz/devices/cc1101_int/cc1101_int_interconnect.h>
 #include <lib/subghz/devices/devices.h>
@@ -34,6 +36,9 @@
 
 #define TAG "SubGhzCli"
 
+// One 24 bit Princeton packet, 50 pulses of up to 3 words each
+#define SUBGHZ_CLI_TX_BUFFER_SIZE 150
+
 static void subghz_cli_radio_device_power_on(void) {
     uint8_t attempts = 5;
     while(--attempts > 0) {
@@ -223,12 +228,11 @@ void subghz_cli_command_tx(Cli* cli, FuriString* args, void* context) {
         "Bit: 24\n"
         "Key: 00 00 00 00 00 %02X %02X %02X\n"
         "TE: %lu\n"
-        "Repeat: %lu\n",
+        "Repeat: 1\n",
         (uint8_t)((key >> 16) & 0xFFU),
         (uint8_t)((key >> 8) & 0xFFU),
         (uint8_t)(key & 0xFFU),
-        te,
-        repeat);
+        te);
     FlipperFormat* flipper_format = flipper_format_string_alloc();
     Stream* stream = flipper_format_get_raw_stream(flipper_format);
     stream_clean(stream);
@@ -240,19 +244,34 @@ void subghz_cli_command_tx(Cli* cli, FuriString* args, void* context) {
     SubGhzTransmitter* transmitter = subghz_transmitter_alloc_init(environment, "Princeton");
     subghz_transmitter_deserialize(transmitter, flipper_format);
 
+    // Render one packet ahead and repeat it from the buffer, so the encoder doesn't run in DMA ISR
+    SubGhzTxBuffer* buffer = subghz_tx_buffer_alloc(SUBGHZ_CLI_TX_BUFFER_SIZE);
+    if(!subghz_tx_buffer_render(buffer, subghz_transmitter_yield, transmitter)) {
+        printf("Signal doesn't fit in TX buffer\r\n");
+        subghz_tx_buffer_free(buffer);
+        flipper_format_free(flipper_format);
+        subghz_transmitter_free(transmitter);
+        subghz_environment_free(environment);
+        subghz_devices_deinit();
+        subghz_cli_radio_device_power_off();
+        return;
+    }
+    SubGhzTxQueue* queue = subghz_tx_queue_alloc();
+    subghz_tx_queue_add(queue, buffer, MAX(repeat, 1UL), 0);
+
     subghz_devices_begin(device);
     subghz_devices_reset(device);
     subghz_devices_load_preset(device, FuriHalSubGhzPresetOok650Async, NULL);
     frequency = subghz_devices_set_frequency(device, frequency);
 
     furi_hal_power_suppress_charge_enter();
-    if(subghz_devices_start_async_tx(device, subghz_transmitter_yield, transmitter)) {
-        while(!(subghz_devices_is_async_complete_tx(device) || cli_cmd_interrupt_received(cli))) {
+    if(subghz_tx_queue_start(queue, device)) {
+        while(!(subghz_tx_queue_is_complete(queue) || cli_cmd_interrupt_received(cli))) {
             printf(".");
             fflush(stdout);
             furi_delay_ms(333);
         }
-        subghz_devices_stop_async_tx(device);
+        subghz_tx_queue_stop(queue);
 
     } else {
         printf("Transmission on this frequency is restricted by your settings/region\r\n");
@@ -266,6 +285,8 @@ void subghz_cli_command_tx(Cli* cli, FuriString* args, void* context) {
     furi_hal_power_suppress_charge_exit();
 
     flipper_format_free(flipper_format);
+    subghz_tx_queue_free(queue);
+    subghz_tx_buffer_free(buffer);
     subghz_transmitter_free(transmitter);
     subghz_environment_free(environment);
 }
@@ -836,6 +857,8 @@ static void subghz_cli_command_print_usage(void) {
     printf("\trx <frequency:in Hz> <device: 0 - CC1101_INT, 1 - CC1101_EXT>\t - Receive\r\n");
     printf("\trx_raw <frequency:in Hz>\t - Receive RAW\r\n");
     printf("\tdecode_raw <file_name: path_RAW_file>\t - Testing\r\n");
+    printf(
+        "\tconvert_raw <path_RAW_file> <path_converted_file> <format: text, binary>\t - Convert RAW data format\r\n");
     printf(
         "\ttx_from_file <file_name: path_file> <repeat: count> <device: 0 - CC1101_INT, 1 - CC1101_EXT>\t - Transmitting from file\r\n");
 
@@ -927,6 +950,50 @@ static void subghz_cli_command_encrypt_raw(Cli* cli, FuriString* args) {
     furi_string_free(source);
 }
 
+static void subghz_cli_command_convert_raw(Cli* cli, FuriString* args) {
+    UNUSED(cli);
+
+    FuriString* source = furi_string_alloc();
+    FuriString* destination = furi_string_alloc();
+    FuriString* format = furi_string_alloc();
+
+    do {
+        if(!args_read_string_and_trim(args, source) ||
+           !args_read_string_and_trim(args, destination) ||
+           !args_read_string_and_trim(args, format)) {
+            subghz_cli_command_print_usage();
+            break;
+        }
+
+        SubGhzRawFileFormat raw_format;
+        if(furi_string_cmp_str(format, "text") == 0) {
+            raw_format = SubGhzRawFileFormatText;
+        } else if(furi_string_cmp_str(format, "binary") == 0) {
+            raw_format = SubGhzRawFileFormatBinary;
+        } else {
+            subghz_cli_command_print_usage();
+            break;
+        }
+
+        Storage* storage = furi_record_open(RECORD_STORAGE);
+        bool converted = subghz_raw_file_convert(
+            storage,
+            furi_string_get_cstr(source),
+            furi_string_get_cstr(destination),
+            raw_format);
+        furi_record_close(RECORD_STORAGE);
+
+        if(!converted) {
+            printf("Failed to convert RAW file\r\n");
+            break;
+        }
+    } while(false);
+
+    furi_string_free(format);
+    furi_string_free(destination);
+    furi_string_free(source);
+}
+
 static void subghz_cli_command_chat(Cli* cli, FuriString* args) {
     uint32_t frequency = 433920000;
     uint32_t device_ind = 0; // 0 - CC1101_INT, 1 - CC1101_EXT
@@ -1151,6 +1218,11 @@ static void subghz_cli_command(Cli* cli, FuriString* args, void* context) {
             break;
         }
 
+        if(furi_string_cmp_str(cmd, "convert_raw") == 0) {
+            subghz_cli_command_convert_raw(cli, args);
+            break;
+        }
+
         if(furi_string_cmp_str(cmd, "tx_from_file") == 0) {
             subghz_cli_command_tx_from_file(cli, args, context);
             break;
@@ -8,6 +8,7 @@
 #include <notification/notification_messages.h>
 #include <flipper_format/flipper_format.h>
 #include <flipper_format/flipper_format_i.h>
+#include <lib/subghz/subghz_raw_dedup.h>
 
 #define TAG "SubGhz"
 
@@ -391,6 +392,61 @@ bool subghz_rename_file(SubGhz* subghz) {
     return ret;
 }
 
+void subghz_dedup_get_path(SubGhz* subghz) {
+    furi_assert(subghz);
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FuriString* file_name = furi_string_alloc();
+    FuriString* file_dir = furi_string_alloc();
+
+    // <name>_dedup.sub next to the original, numbered if already taken
+    path_extract_filename(subghz->file_path, file_name, true);
+    path_extract_dirname(furi_string_get_cstr(subghz->file_path), file_dir);
+    furi_string_cat_str(file_name, SUBGHZ_DEDUP_FILENAME_SUFFIX);
+
+    storage_get_next_filename(
+        storage,
+        furi_string_get_cstr(file_dir),
+        furi_string_get_cstr(file_name),
+        SUBGHZ_APP_FILENAME_EXTENSION,
+        file_name,
+        SUBGHZ_MAX_LEN_NAME);
+
+    furi_string_printf(
+        subghz->file_path_tmp,
+        "%s/%s%s",
+        furi_string_get_cstr(file_dir),
+        furi_string_get_cstr(file_name),
+        SUBGHZ_APP_FILENAME_EXTENSION);
+
+    furi_string_free(file_dir);
+    furi_string_free(file_name);
+    furi_record_close(RECORD_STORAGE);
+}
+
+bool subghz_dedup_file(SubGhz* subghz) {
+    furi_assert(subghz);
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    SubGhzRawDedupStats stats;
+
+    // Original is left as is, repeated bursts are dropped in a new file
+    bool ret = subghz_raw_dedup_file(
+        storage,
+        furi_string_get_cstr(subghz->file_path),
+        furi_string_get_cstr(subghz->file_path_tmp),
+        &stats);
+    if(ret) {
+        FURI_LOG_I(TAG, "Kept %zu of %zu bursts", stats.kept_count, stats.burst_count);
+    } else {
+        storage_simply_remove(storage, furi_string_get_cstr(subghz->file_path_tmp));
+    }
+
+    furi_record_close(RECORD_STORAGE);
+
+    return ret;
+}
+
 bool subghz_file_available(SubGhz* subghz) {
     furi_assert(subghz);
     bool ret = true;
@@ -41,10 +41,11 @@
 #include "helpers/subghz_txrx.h"
 #include "helpers/subghz_gps.h"
 
-#define SUBGHZ_MAX_LEN_NAME      64
-#define SUBGHZ_EXT_PRESET_NAME   true
-#define SUBGHZ_RAW_THRESHOLD_MIN (-90.0f)
-#define SUBGHZ_MEASURE_LOADING   false
+#define SUBGHZ_MAX_LEN_NAME          64
+#define SUBGHZ_EXT_PRESET_NAME       true
+#define SUBGHZ_RAW_THRESHOLD_MIN     (-90.0f)
+#define SUBGHZ_MEASURE_LOADING       false
+#define SUBGHZ_DEDUP_FILENAME_SUFFIX "_dedup"
 
 typedef struct {
     uint8_t fix[4];
@@ -107,6 +108,7 @@ struct SubGhz {
 
     bool fav_timeout;
     FuriTimer* timer;
+    FuriThread* dedup_thread;
 
     void* rpc_ctx;
 };
@@ -126,6 +128,8 @@ bool subghz_save_protocol_to_file(
 void subghz_save_to_file(void* context);
 bool subghz_load_protocol_from_file(SubGhz* subghz);
 bool subghz_rename_file(SubGhz* subghz);
+void subghz_dedup_get_path(SubGhz* subghz);
+bool subghz_dedup_file(SubGhz* subghz);
 bool subghz_file_available(SubGhz* subghz);
 bool subghz_delete_file(SubGhz* subghz);
 void subghz_file_name_clear(SubGhz* subghz);
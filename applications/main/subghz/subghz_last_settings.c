@@ -11,6 +11,7 @@
 #define SUBGHZ_LAST_SETTING_FIELD_PRESET                            "Preset" // AKA Modulation
 #define SUBGHZ_LAST_SETTING_FIELD_FREQUENCY_ANALYZER_FEEDBACK_LEVEL "FeedbackLevel"
 #define SUBGHZ_LAST_SETTING_FIELD_FREQUENCY_ANALYZER_TRIGGER        "FATrigger"
+#define SUBGHZ_LAST_SETTING_FIELD_FREQUENCY_ANALYZER_SPECTRUM       "FASpectrum"
 #define SUBGHZ_LAST_SETTING_FIELD_PROTOCOL_FILE_NAMES               "ProtocolNames"
 #define SUBGHZ_LAST_SETTING_FIELD_HOPPING_ENABLE                    "Hopping"
 #define SUBGHZ_LAST_SETTING_FIELD_IGNORE_FILTER                     "IgnoreFilter"
@@ -24,6 +25,7 @@
 #define SUBGHZ_LAST_SETTING_FIELD_ENABLE_SOUND      "Sound"
 #define SUBGHZ_LAST_SETTING_FIELD_AUTOSAVE          "Autosave"
 #define SUBGHZ_LAST_SETTING_FIELD_HOPPING_THRESHOLD "HoppingThreshold"
+#define SUBGHZ_LAST_SETTING_FIELD_RAW_BINARY        "RawBinary"
 
 SubGhzLastSettings* subghz_last_settings_alloc(void) {
     SubGhzLastSettings* instance = malloc(sizeof(SubGhzLastSettings));
@@ -86,6 +88,13 @@ void subghz_last_settings_load(SubGhzLastSettings* instance, size_t preset_count
                    1)) {
                 flipper_format_rewind(fff_data_file);
             }
+            if(!flipper_format_read_bool(
+                   fff_data_file,
+                   SUBGHZ_LAST_SETTING_FIELD_FREQUENCY_ANALYZER_SPECTRUM,
+                   &instance->frequency_analyzer_spectrum,
+                   1)) {
+                flipper_format_rewind(fff_data_file);
+            }
             if(!flipper_format_read_bool(
                    fff_data_file,
                    SUBGHZ_LAST_SETTING_FIELD_PROTOCOL_FILE_NAMES,
@@ -162,6 +171,13 @@ void subghz_last_settings_load(SubGhzLastSettings* instance, size_t preset_count
                    1)) {
                 flipper_format_rewind(fff_data_file);
             }
+            if(!flipper_format_read_bool(
+                   fff_data_file,
+                   SUBGHZ_LAST_SETTING_FIELD_RAW_BINARY,
+                   &instance->raw_binary,
+                   1)) {
+                flipper_format_rewind(fff_data_file);
+            }
         } while(0);
     } else {
         FURI_LOG_E(TAG, "Error open file %s", SUBGHZ_LAST_SETTINGS_PATH);
@@ -223,6 +239,13 @@ bool subghz_last_settings_save(SubGhzLastSettings* instance) {
                1)) {
             break;
         }
+        if(!flipper_format_write_bool(
+               file,
+               SUBGHZ_LAST_SETTING_FIELD_FREQUENCY_ANALYZER_SPECTRUM,
+               &instance->frequency_analyzer_spectrum,
+               1)) {
+            break;
+        }
         if(!flipper_format_write_bool(
                file,
                SUBGHZ_LAST_SETTING_FIELD_PROTOCOL_FILE_NAMES,
@@ -281,6 +304,10 @@ bool subghz_last_settings_save(SubGhzLastSettings* instance) {
                1)) {
             break;
         }
+        if(!flipper_format_write_bool(
+               file, SUBGHZ_LAST_SETTING_FIELD_RAW_BINARY, &instance->raw_binary, 1)) {
+            break;
+        }
         saved = true;
     } while(0);
 
@@ -18,6 +18,7 @@ typedef struct {
     uint32_t preset_index; // AKA Modulation
     uint32_t frequency_analyzer_feedback_level;
     float frequency_analyzer_trigger;
+    bool frequency_analyzer_spectrum;
     bool protocol_file_names;
     bool enable_hopping;
     uint32_t ignore_filter;
@@ -31,6 +32,7 @@ typedef struct {
     bool enable_sound;
     bool autosave;
     float hopping_threshold;
+    bool raw_binary;
 } SubGhzLastSettings;
 
 SubGhzLastSettings* subghz_last_settings_alloc(void);
@@ -118,6 +118,8 @@ typedef struct {
     uint8_t max_index;
     bool show_frame;
     bool is_ext_radio;
+    bool is_analyzed;
+    SubGhzFrequencyAnalyzerSignal analysis;
 } SubGhzFrequencyAnalyzerModel;
 
 void subghz_frequency_analyzer_set_callback(
@@ -226,7 +228,21 @@ void subghz_frequency_analyzer_draw(Canvas* canvas, SubGhzFrequencyAnalyzerModel
     canvas_set_font(canvas, FontSecondary);
 
     canvas_draw_str(canvas, 0, 7, model->is_ext_radio ? "Ext" : "Int");
-    canvas_draw_str(canvas, 20, 7, "Frequency Analyzer");
+    if(model->is_analyzed) {
+        if(model->analysis.modulation == SubGhzSpectrumModulationKeyed) {
+            snprintf(
+                buffer,
+                sizeof(buffer),
+                "AM %luHz BW %luk",
+                model->analysis.keying_frequency,
+                model->analysis.bandwidth / 1000);
+        } else {
+            snprintf(buffer, sizeof(buffer), "FM/CW BW %luk", model->analysis.bandwidth / 1000);
+        }
+        canvas_draw_str(canvas, 20, 7, buffer);
+    } else {
+        canvas_draw_str(canvas, 20, 7, "Frequency Analyzer");
+    }
 
     // RSSI
     canvas_draw_str(canvas, 33, 62, "RSSI");
@@ -523,6 +539,9 @@ void subghz_frequency_analyzer_pair_callback(
             model->rssi_last = instance->rssi_last;
             model->frequency = frequency;
             model->signal = signal;
+            model->is_analyzed =
+                signal &&
+                subghz_frequency_analyzer_worker_get_signal(instance->worker, &model->analysis);
             model->trigger = subghz_frequency_analyzer_worker_get_trigger_level(instance->worker);
             model->feedback_level = instance->feedback_level;
             model->max_index = instance->max_index;
@@ -572,6 +591,7 @@ void subghz_frequency_analyzer_enter(void* context) {
             model->history_frequency_rx_count[0] = 0;
             model->frequency_to_save = 0;
             model->trigger = RSSI_MIN;
+            model->is_analyzed = false;
             model->is_ext_radio =
                 (subghz_txrx_radio_device_get(instance->txrx) != SubGhzRadioDeviceTypeInternal);
         },
@@ -0,0 +1,183 @@
+#include "animation_frame_stream.h"
+
+#include <furi.h>
+#include <storage/storage.h>
+
+#define TAG "AnimationFrameStream"
+
+#define ANIMATION_FRAME_STREAM_RING_SIZE 2
+
+typedef struct {
+    int16_t frame;
+    uint8_t* data;
+} AnimationFrameStreamSlot;
+
+struct AnimationFrameStream {
+    /* Guards ring slots, never held while storage is accessed */
+    FuriMutex* mutex;
+    /* Serializes file access */
+    FuriMutex* file_mutex;
+    File* file;
+    uint32_t* frame_offsets;
+    uint8_t frame_count;
+    int16_t last_frame;
+    uint8_t next_slot;
+    AnimationFrameStreamSlot ring[ANIMATION_FRAME_STREAM_RING_SIZE];
+};
+
+AnimationFrameStream* animation_frame_stream_alloc(
+    const char* path,
+    uint32_t* frame_offsets,
+    uint8_t frame_count) {
+    furi_assert(path);
+    furi_assert(frame_offsets);
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* file = storage_file_alloc(storage);
+    if(!storage_file_open(file, path, FSAM_READ, FSOM_OPEN_EXISTING)) {
+        FURI_LOG_E(TAG, "Failed to open '%s'", path);
+        storage_file_free(file);
+        furi_record_close(RECORD_STORAGE);
+        return NULL;
+    }
+
+    AnimationFrameStream* stream = malloc(sizeof(AnimationFrameStream));
+    stream->mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+    stream->file_mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+    stream->file = file;
+    stream->frame_offsets = frame_offsets;
+    stream->frame_count = frame_count;
+    stream->last_frame = -1;
+    stream->next_slot = 0;
+
+    /* Buffers are allocated once, so heap use doesn't change during playback */
+    size_t max_frame_size = 0;
+    for(uint8_t i = 0; i < frame_count; ++i) {
+        max_frame_size = MAX(max_frame_size, animation_frame_stream_get_size(stream, i));
+    }
+
+    for(size_t i = 0; i < ANIMATION_FRAME_STREAM_RING_SIZE; ++i) {
+        stream->ring[i].frame = -1;
+        stream->ring[i].data = malloc(max_frame_size);
+    }
+
+    return stream;
+}
+
+void animation_frame_stream_free(AnimationFrameStream* stream) {
+    furi_assert(stream);
+
+    for(size_t i = 0; i < ANIMATION_FRAME_STREAM_RING_SIZE; ++i) {
+        free(stream->ring[i].data);
+    }
+
+    storage_file_free(stream->file);
+    furi_record_close(RECORD_STORAGE);
+
+    free(stream->frame_offsets);
+    furi_mutex_free(stream->file_mutex);
+    furi_mutex_free(stream->mutex);
+    free(stream);
+}
+
+size_t animation_frame_stream_get_size(AnimationFrameStream* stream, uint8_t frame) {
+    furi_assert(stream);
+    furi_check(frame < stream->frame_count);
+
+    return stream->frame_offsets[frame + 1] - stream->frame_offsets[frame];
+}
+
+static AnimationFrameStreamSlot*
+    animation_frame_stream_find(AnimationFrameStream* stream, int16_t frame) {
+    for(size_t i = 0; i < ANIMATION_FRAME_STREAM_RING_SIZE; ++i) {
+        if(stream->ring[i].frame == frame) {
+            return &stream->ring[i];
+        }
+    }
+    return NULL;
+}
+
+static bool animation_frame_stream_read_file(
+    AnimationFrameStream* stream,
+    uint8_t frame,
+    uint8_t* buffer) {
+    size_t size = animation_frame_stream_get_size(stream, frame);
+    bool success = storage_file_seek(stream->file, stream->frame_offsets[frame], true) &&
+                   (storage_file_read(stream->file, buffer, size) == size);
+
+    if(!success) {
+        FURI_LOG_E(TAG, "Failed to read frame %u", frame);
+    }
+
+    return success;
+}
+
+bool animation_frame_stream_prefetch(AnimationFrameStream* stream, uint8_t frame) {
+    furi_assert(stream);
+    furi_check(frame < stream->frame_count);
+
+    furi_check(furi_mutex_acquire(stream->file_mutex, FuriWaitForever) == FuriStatusOk);
+    furi_check(furi_mutex_acquire(stream->mutex, FuriWaitForever) == FuriStatusOk);
+
+    bool success = !!animation_frame_stream_find(stream, frame);
+    AnimationFrameStreamSlot* slot = NULL;
+
+    if(!success) {
+        /* Frame that is on screen may still be drawn, take another slot */
+        slot = &stream->ring[stream->next_slot];
+        if(slot->frame == stream->last_frame) {
+            stream->next_slot = (stream->next_slot + 1) % ANIMATION_FRAME_STREAM_RING_SIZE;
+            slot = &stream->ring[stream->next_slot];
+        }
+        stream->next_slot = (stream->next_slot + 1) % ANIMATION_FRAME_STREAM_RING_SIZE;
+        slot->frame = -1;
+    }
+
+    furi_check(furi_mutex_release(stream->mutex) == FuriStatusOk);
+
+    if(slot) {
+        /* Slot is not visible to readers until it is filled */
+        success = animation_frame_stream_read_file(stream, frame, slot->data);
+
+        furi_check(furi_mutex_acquire(stream->mutex, FuriWaitForever) == FuriStatusOk);
+        slot->frame = success ? frame : -1;
+        furi_check(furi_mutex_release(stream->mutex) == FuriStatusOk);
+    }
+
+    furi_check(furi_mutex_release(stream->file_mutex) == FuriStatusOk);
+    return success;
+}
+
+bool animation_frame_stream_read(AnimationFrameStream* stream, uint8_t frame, uint8_t* buffer) {
+    furi_assert(stream);
+    furi_assert(buffer);
+    furi_check(frame < stream->frame_count);
+
+    furi_check(furi_mutex_acquire(stream->file_mutex, FuriWaitForever) == FuriStatusOk);
+    bool success = animation_frame_stream_read_file(stream, frame, buffer);
+    furi_check(furi_mutex_release(stream->file_mutex) == FuriStatusOk);
+
+    return success;
+}
+
+const uint8_t* animation_frame_stream_get(AnimationFrameStream* stream, uint8_t frame) {
+    furi_assert(stream);
+    furi_check(frame < stream->frame_count);
+
+    const uint8_t* data = NULL;
+    furi_check(furi_mutex_acquire(stream->mutex, FuriWaitForever) == FuriStatusOk);
+
+    AnimationFrameStreamSlot* slot = animation_frame_stream_find(stream, frame);
+    if(slot) {
+        stream->last_frame = frame;
+    } else if(stream->last_frame >= 0) {
+        /* Not read yet, keep showing previous frame */
+        slot = animation_frame_stream_find(stream, stream->last_frame);
+    }
+    if(slot) {
+        data = slot->data;
+    }
+
+    furi_check(furi_mutex_release(stream->mutex) == FuriStatusOk);
+    return data;
+}
@@ -0,0 +1,78 @@
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+/** Frame source for packed animations.
+ * Frames stay in the animation file and are read ahead
+ * into a small ring of buffers, so only a couple of frames
+ * are resident in RAM while animation is playing.
+ * Animation file is kept open as long as stream exists.
+ * Frame data is returned in the same (optionally heatshrink
+ * compressed) format as regular icon frames. */
+typedef struct AnimationFrameStream AnimationFrameStream;
+
+/**
+ * Allocate frame stream and open animation file.
+ *
+ * @path            path to packed animation file
+ * @frame_offsets   absolute offsets of frames in file, frame_count + 1 items,
+ *                  last one marks the end of last frame. Owned by stream if it is allocated.
+ * @frame_count     number of unique frames in file
+ * @return          frame stream instance, NULL if file can't be opened
+ */
+AnimationFrameStream* animation_frame_stream_alloc(
+    const char* path,
+    uint32_t* frame_offsets,
+    uint8_t frame_count);
+
+/**
+ * Close animation file, free frame stream and all cached frames.
+ *
+ * @stream      frame stream instance
+ */
+void animation_frame_stream_free(AnimationFrameStream* stream);
+
+/**
+ * Read frame into the ring, if it is not there yet.
+ * Blocks on storage, so must not be called from draw callback
+ * or with view model locked. animation_frame_stream_get() doesn't
+ * wait for it. Never evicts frame last returned by animation_frame_stream_get().
+ *
+ * @stream      frame stream instance
+ * @frame       unique frame index
+ * @return      true if frame is in the ring
+ */
+bool animation_frame_stream_prefetch(AnimationFrameStream* stream, uint8_t frame);
+
+/**
+ * Read frame into caller buffer, bypassing the ring.
+ * Blocks on storage, same as animation_frame_stream_prefetch().
+ *
+ * @stream      frame stream instance
+ * @frame       unique frame index
+ * @buffer      buffer of animation_frame_stream_get_size() bytes
+ * @return      true if frame was read
+ */
+bool animation_frame_stream_read(AnimationFrameStream* stream, uint8_t frame, uint8_t* buffer);
+
+/**
+ * Get frame data read with animation_frame_stream_prefetch().
+ * Doesn't touch storage or wait for it. Returned pointer stays valid until
+ * another frame is returned by this function and one more is prefetched.
+ *
+ * @stream      frame stream instance
+ * @frame       unique frame index
+ * @return      frame data, data of frame returned last time if this one is
+ *              not in the ring yet, NULL if there is none
+ */
+const uint8_t* animation_frame_stream_get(AnimationFrameStream* stream, uint8_t frame);
+
+/**
+ * Get size of frame data.
+ *
+ * @stream      frame stream instance
+ * @frame       unique frame index
+ * @return      size of frame data in bytes
+ */
+size_t animation_frame_stream_get_size(AnimationFrameStream* stream, uint8_t frame);
@@ -13,14 +13,63 @@
 #include <assets_dolphin_internal.h>
 #include <assets_dolphin_blocking.h>
 
-#define ANIMATION_META_FILE "meta.txt"
-#define ANIMATION_DIR       EXT_PATH("dolphin")
-#define TAG                 "AnimationStorage"
+#define ANIMATION_META_FILE   "meta.txt"
+#define ANIMATION_PACKED_FILE "animation.bin"
+#define ANIMATION_DIR         EXT_PATH("dolphin")
+#define TAG                   "AnimationStorage"
+
+#define ANIMATION_PACKED_MAGIC                 0x4D494E41
+#define ANIMATION_PACKED_MAX_SUPPORTED_VERSION 1
+
+#pragma pack(push, 1)
+
+/* Packed animation file layout:
+ * header, frame order (passive + active frames), bubbles (each one followed
+ * by its text), frame offsets table (frame_count + 1 items), frames data */
+typedef struct {
+    uint32_t magic;
+    uint8_t version;
+    uint8_t width;
+    uint8_t height;
+    uint8_t frame_count;
+    uint8_t passive_frames;
+    uint8_t active_frames;
+    uint8_t active_cycles;
+    uint8_t frame_rate;
+    uint16_t duration;
+    uint16_t active_cooldown;
+    uint8_t bubble_slots;
+    uint8_t bubble_count;
+    uint16_t reserved;
+} AnimationPackedHeader;
+_Static_assert(sizeof(AnimationPackedHeader) == 20, "Incorrect AnimationPackedHeader size");
+
+typedef struct {
+    uint8_t slot;
+    uint8_t x;
+    uint8_t y;
+    char align_h;
+    char align_v;
+    uint8_t start_frame;
+    uint8_t end_frame;
+    uint8_t text_size;
+} AnimationPackedBubble;
+_Static_assert(sizeof(AnimationPackedBubble) == 8, "Incorrect AnimationPackedBubble size");
+
+#pragma pack(pop)
+
+/* Lowest free heap seen during animation load, sampled where loaders hold the most */
+static size_t animation_storage_heap_low = 0;
+
+static void animation_storage_sample_heap(void) {
+    animation_storage_heap_low = MIN(animation_storage_heap_low, memmgr_get_free_heap());
+}
 
 static void animation_storage_free_bubbles(BubbleAnimation* animation);
 static void animation_storage_free_frames(BubbleAnimation* animation);
 static void animation_storage_free_animation(BubbleAnimation** storage_animation);
 static BubbleAnimation* animation_storage_load_animation(const char* name);
+static BubbleAnimation* animation_storage_load_meta_animation(Storage* storage, const char* name);
 
 static bool animation_storage_load_single_manifest_info(
     StorageAnimationManifestInfo* manifest_info,
@@ -227,7 +276,11 @@ static void animation_storage_free_animation(BubbleAnimation** animation) {
 
     if(*animation) {
         animation_storage_free_bubbles(*animation);
-        animation_storage_free_frames(*animation);
+        if((*animation)->frame_stream) {
+            animation_frame_stream_free((*animation)->frame_stream);
+        } else {
+            animation_storage_free_frames(*animation);
+        }
         if((*animation)->frame_order) {
             free((void*)(*animation)->frame_order);
         }
@@ -343,6 +396,7 @@ static bool animation_storage_load_frames(
             FURI_LOG_E(TAG, "Read failed: \'%s\'", furi_string_get_cstr(filename));
             break;
         }
+        animation_storage_sample_heap();
         storage_file_close(file);
         frames_ok = true;
     }
@@ -449,27 +503,246 @@ static bool animation_storage_load_bubbles(BubbleAnimation* animation, FlipperFo
     return success;
 }
 
+static bool animation_storage_cast_packed_align(char align_char, Align* align) {
+    switch(align_char) {
+    case 'B':
+        *align = AlignBottom;
+        break;
+    case 'T':
+        *align = AlignTop;
+        break;
+    case 'L':
+        *align = AlignLeft;
+        break;
+    case 'R':
+        *align = AlignRight;
+        break;
+    case 'C':
+        *align = AlignCenter;
+        break;
+    default:
+        return false;
+    }
+
+    return true;
+}
+
+static bool animation_storage_load_packed_bubbles(
+    BubbleAnimation* animation,
+    File* file,
+    const AnimationPackedHeader* header) {
+    bool success = false;
+    furi_assert(!animation->frame_bubble_sequences);
+
+    do {
+        if(header->bubble_slots > 20) break;
+        animation->frame_bubble_sequences_count = header->bubble_slots;
+        if(animation->frame_bubble_sequences_count == 0) {
+            success = (header->bubble_count == 0);
+            break;
+        }
+        animation->frame_bubble_sequences =
+            malloc(sizeof(FrameBubble*) * animation->frame_bubble_sequences_count);
+
+        for(int i = 0; i < animation->frame_bubble_sequences_count; ++i) {
+            FURI_CONST_ASSIGN_PTR(
+                animation->frame_bubble_sequences[i], malloc(sizeof(FrameBubble)));
+        }
+
+        const FrameBubble* bubble = animation->frame_bubble_sequences[0];
+        int16_t index = -1;
+        uint8_t bubble_number = 0;
+        for(; bubble_number < header->bubble_count; ++bubble_number) {
+            AnimationPackedBubble packed;
+            if(storage_file_read(file, &packed, sizeof(packed)) != sizeof(packed)) break;
+
+            /* same rules as in meta.txt: slots start from 0 and go ascending */
+            if(packed.slot == index) {
+                FURI_CONST_ASSIGN_PTR(bubble->next_bubble, malloc(sizeof(FrameBubble)));
+                bubble = bubble->next_bubble;
+            } else if(packed.slot == index + 1) {
+                ++index;
+                if(index >= animation->frame_bubble_sequences_count) break;
+                bubble = animation->frame_bubble_sequences[index];
+            } else {
+                break;
+            }
+
+            FURI_CONST_ASSIGN(bubble->bubble.x, packed.x);
+            FURI_CONST_ASSIGN(bubble->bubble.y, packed.y);
+            FURI_CONST_ASSIGN(bubble->start_frame, packed.start_frame);
+            FURI_CONST_ASSIGN(bubble->end_frame, packed.end_frame);
+
+            if(packed.text_size > 100) break;
+            char* text = malloc(packed.text_size + 1);
+            FURI_CONST_ASSIGN_PTR(bubble->bubble.text, text);
+            if(storage_file_read(file, text, packed.text_size) != packed.text_size) break;
+            text[packed.text_size] = '\0';
+
+            if(!animation_storage_cast_packed_align(
+                   packed.align_h, (Align*)&bubble->bubble.align_h))
+                break;
+            if(!animation_storage_cast_packed_align(
+                   packed.align_v, (Align*)&bubble->bubble.align_v))
+                break;
+        }
+        success = (bubble_number == header->bubble_count) &&
+                  ((index + 1) == animation->frame_bubble_sequences_count);
+    } while(0);
+
+    if(!success) {
+        if(animation->frame_bubble_sequences) {
+            FURI_LOG_E(TAG, "Failed to load animation bubbles");
+            animation_storage_free_bubbles(animation);
+        }
+    }
+
+    return success;
+}
+
+static BubbleAnimation* animation_storage_load_packed_animation(Storage* storage, const char* name) {
+    BubbleAnimation* animation = NULL;
+    FuriString* path = furi_string_alloc_printf(ANIMATION_DIR "/%s/" ANIMATION_PACKED_FILE, name);
+    File* file = storage_file_alloc(storage);
+    uint32_t* frame_offsets = NULL;
+
+    bool success = false;
+    do {
+        if(!storage_file_open(file, furi_string_get_cstr(path), FSAM_READ, FSOM_OPEN_EXISTING))
+            break;
+
+        AnimationPackedHeader header;
+        if((storage_file_read(file, &header, sizeof(header)) != sizeof(header)) ||
+           (header.magic != ANIMATION_PACKED_MAGIC) ||
+           (header.version > ANIMATION_PACKED_MAX_SUPPORTED_VERSION)) {
+            FURI_LOG_E(TAG, "Invalid packed animation header: '%s'", name);
+            break;
+        }
+
+        uint16_t frame_order_count = header.passive_frames + header.active_frames;
+        if(!header.frame_count || !header.frame_rate || frame_order_count > UINT8_MAX) break;
+
+        animation = malloc(sizeof(BubbleAnimation));
+        animation->frame_bubble_sequences = NULL;
+        animation->frame_stream = NULL;
+        animation->passive_frames = header.passive_frames;
+        animation->active_frames = header.active_frames;
+        animation->active_cycles = header.active_cycles;
+        animation->duration = header.duration;
+        animation->active_cooldown = header.active_cooldown;
+
+        Icon* icon = (Icon*)&animation->icon_animation;
+        FURI_CONST_ASSIGN(icon->frame_count, header.frame_count);
+        FURI_CONST_ASSIGN(icon->frame_rate, header.frame_rate);
+        FURI_CONST_ASSIGN(icon->height, header.height);
+        FURI_CONST_ASSIGN(icon->width, header.width);
+        icon->frames = NULL;
+
+        uint8_t* frame_order = malloc(frame_order_count);
+        animation->frame_order = frame_order;
+        if(storage_file_read(file, frame_order, frame_order_count) != frame_order_count) break;
+
+        /* The frames should go in order (0...N), without omissions */
+        bool frame_order_ok = true;
+        for(int i = 0; i < frame_order_count; ++i) {
+            frame_order_ok &= frame_order[i] < header.frame_count;
+        }
+        if(!frame_order_ok) break;
+
+        if(!animation_storage_load_packed_bubbles(animation, file, &header)) break;
+
+        size_t frame_offsets_size = sizeof(uint32_t) * (header.frame_count + 1);
+        frame_offsets = malloc(frame_offsets_size);
+        if(storage_file_read(file, frame_offsets, frame_offsets_size) != frame_offsets_size)
+            break;
+
+        size_t max_frame_size = ROUND_UP_TO(header.width, 8) * header.height + 1;
+        uint64_t file_size = storage_file_size(file);
+        bool frames_ok = frame_offsets[header.frame_count] <= file_size;
+        for(int i = 0; i < header.frame_count; ++i) {
+            frames_ok &= (frame_offsets[i] < frame_offsets[i + 1]) &&
+                         ((frame_offsets[i + 1] - frame_offsets[i]) <= max_frame_size);
+        }
+        if(!frames_ok) {
+            FURI_LOG_E(TAG, "Invalid frames table: '%s'", name);
+            break;
+        }
+
+        animation->frame_stream = animation_frame_stream_alloc(
+            furi_string_get_cstr(path), frame_offsets, header.frame_count);
+        if(!animation->frame_stream) break;
+        frame_offsets = NULL;
+        success = true;
+    } while(0);
+
+    animation_storage_sample_heap();
+
+    storage_file_free(file);
+    furi_string_free(path);
+    free(frame_offsets);
+
+    if(!success && animation) {
+        animation_storage_free_bubbles(animation);
+        if(animation->frame_order) {
+            free((void*)animation->frame_order);
+        }
+        free(animation);
+        animation = NULL;
+    }
+
+    return animation;
+}
+
 static BubbleAnimation* animation_storage_load_animation(const char* name) {
     furi_assert(name);
+
+    uint32_t load_start = furi_get_tick();
+    size_t heap_before = memmgr_get_free_heap();
+    animation_storage_heap_low = heap_before;
+    BubbleAnimation* animation = NULL;
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    if(FSE_OK == storage_sd_status(storage)) {
+        animation = animation_storage_load_packed_animation(storage, name);
+        if(!animation) {
+            animation = animation_storage_load_meta_animation(storage, name);
+        }
+    }
+    furi_record_close(RECORD_STORAGE);
+
+    /* Frames are never read in whole later on, so load peak is playback peak too */
+    if(animation) {
+        FURI_LOG_I(
+            TAG,
+            "Loaded '%s' (%s) in %lums, heap peak %zu, retained %zu",
+            name,
+            animation->frame_stream ? "packed" : "meta",
+            furi_get_tick() - load_start,
+            heap_before - animation_storage_heap_low,
+            heap_before - memmgr_get_free_heap());
+    }
+
+    return animation;
+}
+
+static BubbleAnimation* animation_storage_load_meta_animation(Storage* storage, const char* name) {
     BubbleAnimation* animation = malloc(sizeof(BubbleAnimation));
 
     uint32_t height = 0;
     uint32_t width = 0;
     uint32_t* u32array = NULL;
-    Storage* storage = furi_record_open(RECORD_STORAGE);
     FlipperFormat* ff = flipper_format_file_alloc(storage);
     /* Forbid skipping fields */
     flipper_format_set_strict_mode(ff, true);
     FuriString* str;
     str = furi_string_alloc();
     animation->frame_bubble_sequences = NULL;
+    animation->frame_stream = NULL;
 
     bool success = false;
     do {
         uint32_t u32value;
 
-        if(FSE_OK != storage_sd_status(storage)) break;
-
         furi_string_printf(str, EXT_PATH("dolphin") "/%s/" ANIMATION_META_FILE, name);
         if(!flipper_format_file_open_existing(ff, furi_string_get_cstr(str))) break;
         if(!flipper_format_read_header(ff, str, &u32value)) break;
@@ -514,6 +787,7 @@ static BubbleAnimation* animation_storage_load_animation(const char* name) {
         success = true;
     } while(0);
 
+    animation_storage_sample_heap();
     furi_string_free(str);
     flipper_format_free(ff);
     if(u32array) {
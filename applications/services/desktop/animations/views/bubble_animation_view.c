@@ -28,6 +28,8 @@ typedef struct {
 
 struct BubbleAnimationView {
     View* view;
+    /* Held while frame is read, so animation isn't switched and freed under it */
+    FuriMutex* mutex;
     FuriTimer* timer;
     BubbleAnimationInteractCallback interact_callback;
     void* interact_callback_context;
@@ -53,6 +55,41 @@ static uint8_t bubble_animation_get_frame_index(BubbleAnimationViewModel* model)
     return animation->frame_order[icon_index];
 }
 
+static const uint8_t*
+    bubble_animation_get_frame_data(const BubbleAnimation* animation, uint8_t frame) {
+    if(animation->frame_stream) {
+        return animation_frame_stream_get(animation->frame_stream, frame);
+    }
+    return animation->icon_animation.frames[frame];
+}
+
+/* Commit model and read frame it is going to show. Frames of packed animations
+ * are read with model unlocked, so draw callback never waits for storage, and
+ * previous frame stays on screen until redraw. Must be called with view mutex held. */
+static void bubble_animation_commit_model(
+    BubbleAnimationView* view,
+    BubbleAnimationViewModel* model,
+    bool update) {
+    furi_assert(view);
+    furi_assert(model);
+
+    AnimationFrameStream* stream = NULL;
+    uint8_t frame = 0;
+    if(model->current && model->current->frame_stream && !model->freeze_frame) {
+        stream = model->current->frame_stream;
+        frame = bubble_animation_get_frame_index(model);
+    }
+    view_commit_model(view->view, update && !stream);
+
+    if(stream) {
+        animation_frame_stream_prefetch(stream, frame);
+        if(update) {
+            view_get_model(view->view);
+            view_commit_model(view->view, true);
+        }
+    }
+}
+
 static void bubble_animation_draw_callback(Canvas* canvas, void* model_) {
     furi_assert(model_);
     furi_assert(canvas);
@@ -76,8 +113,10 @@ static void bubble_animation_draw_callback(Canvas* canvas, void* model_) {
     uint8_t width = icon_get_width(&animation->icon_animation);
     uint8_t height = icon_get_height(&animation->icon_animation);
     uint8_t y_offset = canvas_height(canvas) - height;
-    canvas_draw_bitmap(
-        canvas, 0, y_offset, width, height, animation->icon_animation.frames[index]);
+    const uint8_t* frame_data = bubble_animation_get_frame_data(animation, index);
+    if(frame_data) {
+        canvas_draw_bitmap(canvas, 0, y_offset, width, height, frame_data);
+    }
 
     const FrameBubble* bubble = model->current_bubble;
     if(bubble) {
@@ -175,6 +214,7 @@ static void bubble_animation_activate(BubbleAnimationView* view, bool force) {
     }
 }
 
+/* Must be called with view mutex held */
 static void bubble_animation_activate_right_now(BubbleAnimationView* view) {
     furi_assert(view);
 
@@ -186,7 +226,7 @@ static void bubble_animation_activate_right_now(BubbleAnimationView* view) {
         model->current_bubble = bubble_animation_pick_bubble(model, true);
         frame_rate = model->current->icon_animation.frame_rate;
     }
-    view_commit_model(view->view, true);
+    bubble_animation_commit_model(view, model, true);
 
     if(frame_rate) {
         furi_timer_start(view->timer, 1000 / frame_rate);
@@ -228,6 +268,7 @@ static void bubble_animation_timer_callback(void* context) {
     BubbleAnimationView* view = context;
     bool activate = false;
 
+    furi_check(furi_mutex_acquire(view->mutex, FuriWaitForever) == FuriStatusOk);
     BubbleAnimationViewModel* model = view_get_model(view->view);
 
     if(model->active_shift > 0) {
@@ -238,21 +279,21 @@ static void bubble_animation_timer_callback(void* context) {
         bubble_animation_next_frame(model);
     }
 
-    view_commit_model(view->view, !activate);
+    bubble_animation_commit_model(view, model, !activate);
 
     if(activate) {
         bubble_animation_activate_right_now(view);
     }
+    furi_check(furi_mutex_release(view->mutex) == FuriStatusOk);
 }
 
 /* always freeze first passive frame, because
  * animation is always activated at unfreezing and played
  * passive frame first, and 2 frames after - active
  */
-static Icon* bubble_animation_clone_first_frame(const Icon* icon_orig) {
-    furi_assert(icon_orig);
-    furi_assert(icon_orig->frames);
-    furi_assert(icon_orig->frames[0]);
+static Icon* bubble_animation_clone_first_frame(const BubbleAnimation* animation) {
+    furi_assert(animation);
+    const Icon* icon_orig = &animation->icon_animation;
 
     Icon* icon_clone = malloc(sizeof(Icon));
     memcpy(icon_clone, icon_orig, sizeof(Icon));
@@ -264,8 +305,16 @@ static Icon* bubble_animation_clone_first_frame(const Icon* icon_orig) {
      * for compressed header
      */
     size_t max_bitmap_size = ROUND_UP_TO(icon_orig->width, 8) * icon_orig->height + 1;
-    FURI_CONST_ASSIGN_PTR(icon_clone->frames[0], malloc(max_bitmap_size));
-    memcpy((void*)icon_clone->frames[0], icon_orig->frames[0], max_bitmap_size);
+    uint8_t* bitmap = NULL;
+    if(animation->frame_stream) {
+        max_bitmap_size = animation_frame_stream_get_size(animation->frame_stream, 0);
+        bitmap = malloc(max_bitmap_size);
+        furi_check(animation_frame_stream_read(animation->frame_stream, 0, bitmap));
+    } else {
+        bitmap = malloc(max_bitmap_size);
+        memcpy(bitmap, icon_orig->frames[0], max_bitmap_size);
+    }
+    FURI_CONST_ASSIGN_PTR(icon_clone->frames[0], bitmap);
     FURI_CONST_ASSIGN(icon_clone->frame_count, 1);
 
     return icon_clone;
@@ -307,6 +356,7 @@ static void bubble_animation_exit(void* context) {
 BubbleAnimationView* bubble_animation_view_alloc(void) {
     BubbleAnimationView* view = malloc(sizeof(BubbleAnimationView));
     view->view = view_alloc();
+    view->mutex = furi_mutex_alloc(FuriMutexTypeNormal);
     view->interact_callback = NULL;
     view->timer = furi_timer_alloc(bubble_animation_timer_callback, FuriTimerTypePeriodic, view);
 
@@ -329,6 +379,7 @@ void bubble_animation_view_free(BubbleAnimationView* view) {
 
     view_free(view->view);
     view->view = NULL;
+    furi_mutex_free(view->mutex);
     free(view);
 }
 
@@ -348,6 +399,7 @@ void bubble_animation_view_set_animation(
     furi_assert(view);
     furi_assert(new_animation);
 
+    furi_check(furi_mutex_acquire(view->mutex, FuriWaitForever) == FuriStatusOk);
     BubbleAnimationViewModel* model = view_get_model(view->view);
     furi_assert(model);
     model->current = new_animation;
@@ -367,7 +419,8 @@ void bubble_animation_view_set_animation(
     model->current_bubble = bubble_animation_pick_bubble(model, false);
     model->current_frame = 0;
     model->active_cycle = 0;
-    view_commit_model(view->view, true);
+    bubble_animation_commit_model(view, model, true);
+    furi_check(furi_mutex_release(view->mutex) == FuriStatusOk);
 
     furi_timer_start(view->timer, 1000 / new_animation->icon_animation.frame_rate);
 }
@@ -375,12 +428,21 @@ void bubble_animation_view_set_animation(
 void bubble_animation_freeze(BubbleAnimationView* view) {
     furi_assert(view);
 
+    furi_check(furi_mutex_acquire(view->mutex, FuriWaitForever) == FuriStatusOk);
     BubbleAnimationViewModel* model = view_get_model(view->view);
-    furi_assert(model->current);
+    const BubbleAnimation* animation = model->current;
+    furi_assert(animation);
     furi_assert(!model->freeze_frame);
-    model->freeze_frame = bubble_animation_clone_first_frame(&model->current->icon_animation);
+    view_commit_model(view->view, false);
+
+    // Frame is read with model unlocked, animation stays while mutex is held
+    Icon* freeze_frame = bubble_animation_clone_first_frame(animation);
+
+    model = view_get_model(view->view);
+    model->freeze_frame = freeze_frame;
     model->current = NULL;
     view_commit_model(view->view, false);
+    furi_check(furi_mutex_release(view->mutex) == FuriStatusOk);
     furi_timer_stop(view->timer);
 }
 
@@ -388,12 +450,14 @@ void bubble_animation_unfreeze(BubbleAnimationView* view) {
     furi_assert(view);
     uint8_t frame_rate;
 
+    furi_check(furi_mutex_acquire(view->mutex, FuriWaitForever) == FuriStatusOk);
     BubbleAnimationViewModel* model = view_get_model(view->view);
     furi_assert(model->freeze_frame);
     bubble_animation_release_frame(&model->freeze_frame);
     furi_assert(model->current);
     frame_rate = model->current->icon_animation.frame_rate;
-    view_commit_model(view->view, true);
+    bubble_animation_commit_model(view, model, true);
+    furi_check(furi_mutex_release(view->mutex) == FuriStatusOk);
 
     furi_timer_start(view->timer, 1000 / frame_rate);
     bubble_animation_activate(view, false);
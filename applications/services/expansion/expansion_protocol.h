@@ -29,6 +29,21 @@ extern "C" {
  */
 #define EXPANSION_PROTOCOL_MAX_DATA_SIZE (64U)
 
+/**
+ * @brief Maximum data size per stream data frame, in bytes.
+ *
+ * Modules short on memory may define a smaller value before including this file
+ * and advertise it during stream mode negotiation.
+ */
+#ifndef EXPANSION_PROTOCOL_STREAM_MAX_DATA_SIZE
+#define EXPANSION_PROTOCOL_STREAM_MAX_DATA_SIZE (256U)
+#endif
+
+/**
+ * @brief Maximum number of unacknowledged stream data frames either side may advertise.
+ */
+#define EXPANSION_PROTOCOL_STREAM_MAX_WINDOW (16U)
+
 /**
  * @brief Maximum allowed inactivity period, in milliseconds.
  */
@@ -48,6 +63,9 @@ typedef enum {
     ExpansionFrameTypeBaudRate = 3, /**< Baud rate negotiation frame. */
     ExpansionFrameTypeControl = 4, /**< Control frame. */
     ExpansionFrameTypeData = 5, /**< Data frame. */
+    ExpansionFrameTypeStreamConfig = 6, /**< Stream mode negotiation frame. */
+    ExpansionFrameTypeStreamData = 7, /**< Stream data frame. */
+    ExpansionFrameTypeStreamAck = 8, /**< Stream data acknowledgement frame. */
     ExpansionFrameTypeReserved, /**< Special value. */
 } ExpansionFrameType;
 
@@ -115,6 +133,34 @@ typedef struct {
     uint8_t bytes[EXPANSION_PROTOCOL_MAX_DATA_SIZE];
 } ExpansionFrameData;
 
+/**
+ * @brief Stream mode negotiation frame contents.
+ *
+ * Describes what the sending side is able to receive.
+ */
+typedef struct {
+    uint16_t max_data_size; /**< Largest stream data frame payload accepted, in bytes. */
+    uint8_t window; /**< Number of unacknowledged stream data frames accepted. */
+} ExpansionFrameStreamConfig;
+
+/**
+ * @brief Stream data frame contents.
+ */
+typedef struct {
+    uint8_t seq; /**< Sequence number, incremented by one for each frame. */
+    /** Size of the data. Must not exceed EXPANSION_PROTOCOL_STREAM_MAX_DATA_SIZE. */
+    uint16_t size;
+    /** Data bytes. Valid only up to ExpansionFrameStreamData::size bytes. */
+    uint8_t bytes[EXPANSION_PROTOCOL_STREAM_MAX_DATA_SIZE];
+} ExpansionFrameStreamData;
+
+/**
+ * @brief Stream data acknowledgement frame contents.
+ */
+typedef struct {
+    uint8_t seq; /**< Sequence number of the last frame received, acknowledges all before it. */
+} ExpansionFrameStreamAck;
+
 /**
  * @brief Expansion protocol frame structure.
  */
@@ -126,6 +172,9 @@ typedef struct {
         ExpansionFrameBaudRate baud_rate; /**< Baud rate frame contents. */
         ExpansionFrameControl control; /**< Control frame contents. */
         ExpansionFrameData data; /**< Data frame contents. */
+        ExpansionFrameStreamConfig stream_config; /**< Stream config frame contents. */
+        ExpansionFrameStreamData stream_data; /**< Stream data frame contents. */
+        ExpansionFrameStreamAck stream_ack; /**< Stream ack frame contents. */
     } content; /**< Contents of the frame. */
 } ExpansionFrame;
 
@@ -180,6 +229,13 @@ static inline size_t expansion_frame_get_encoded_size(const ExpansionFrame* fram
         return sizeof(frame->header) + sizeof(frame->content.control);
     case ExpansionFrameTypeData:
         return sizeof(frame->header) + sizeof(frame->content.data.size) + frame->content.data.size;
+    case ExpansionFrameTypeStreamConfig:
+        return sizeof(frame->header) + sizeof(frame->content.stream_config);
+    case ExpansionFrameTypeStreamData:
+        return sizeof(frame->header) + offsetof(ExpansionFrameStreamData, bytes) +
+               frame->content.stream_data.size;
+    case ExpansionFrameTypeStreamAck:
+        return sizeof(frame->header) + sizeof(frame->content.stream_ack);
     default:
         return 0;
     }
@@ -233,6 +289,24 @@ static inline bool expansion_frame_get_remaining_size(
             content_size = sizeof(frame->content.data.size) + frame->content.data.size;
         }
         break;
+    case ExpansionFrameTypeStreamConfig:
+        content_size = sizeof(frame->content.stream_config);
+        break;
+    case ExpansionFrameTypeStreamData:
+        if(received_content_size < offsetof(ExpansionFrameStreamData, bytes)) {
+            // Data size is unknown as of now
+            content_size = offsetof(ExpansionFrameStreamData, bytes);
+        } else if(frame->content.stream_data.size > sizeof(frame->content.stream_data.bytes)) {
+            // Malformed frame or garbage input
+            return false;
+        } else {
+            content_size =
+                offsetof(ExpansionFrameStreamData, bytes) + frame->content.stream_data.size;
+        }
+        break;
+    case ExpansionFrameTypeStreamAck:
+        content_size = sizeof(frame->content.stream_ack);
+        break;
     default:
         return false;
     }
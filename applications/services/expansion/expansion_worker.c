@@ -11,8 +11,14 @@
 
 #define TAG "ExpansionSrv"
 
-#define EXPANSION_WORKER_STACK_SZIE  (768UL)
-#define EXPANSION_WORKER_BUFFER_SIZE (sizeof(ExpansionFrame) + sizeof(ExpansionFrameChecksum))
+#define EXPANSION_WORKER_STACK_SZIE    (768UL)
+#define EXPANSION_WORKER_FRAME_SIZE    (sizeof(ExpansionFrame) + sizeof(ExpansionFrameChecksum))
+#define EXPANSION_WORKER_STREAM_WINDOW (4U)
+#define EXPANSION_WORKER_RX_CHUNK_SIZE (64U)
+
+// Room for a full window of stream data frames plus a control frame in between
+#define EXPANSION_WORKER_BUFFER_SIZE \
+    ((EXPANSION_WORKER_STREAM_WINDOW + 1U) * EXPANSION_WORKER_FRAME_SIZE)
 
 typedef enum {
     ExpansionWorkerStateHandShake,
@@ -39,6 +45,7 @@ struct ExpansionWorker {
     FuriThread* thread;
     FuriStreamBuffer* rx_buf;
     FuriSemaphore* tx_semaphore;
+    FuriMutex* tx_mutex;
 
     FuriHalSerialId serial_id;
     FuriHalSerialHandle* serial_handle;
@@ -49,12 +56,25 @@ struct ExpansionWorker {
     ExpansionWorkerExitReason exit_reason;
     ExpansionWorkerCallback callback;
     void* cb_context;
+
+    // Stream mode state, negotiated by the module before starting RPC
+    bool is_stream_mode;
+    uint16_t tx_max_data_size;
+    uint8_t tx_window;
+    uint8_t tx_seq;
+    uint8_t tx_seq_acked;
+    uint8_t rx_seq;
+
+    // Frames are too large to be kept on thread stacks, tx_frame is guarded by tx_mutex
+    ExpansionFrame rx_frame;
+    ExpansionFrame tx_frame;
 };
 
 // Called in UART IRQ context
 static void expansion_worker_serial_rx_callback(
     FuriHalSerialHandle* handle,
     FuriHalSerialRxEvent event,
+    size_t data_len,
     void* context) {
     furi_assert(handle);
     furi_assert(context);
@@ -64,10 +84,13 @@ static void expansion_worker_serial_rx_callback(
     if(event & (FuriHalSerialRxEventNoiseError | FuriHalSerialRxEventFrameError |
                 FuriHalSerialRxEventOverrunError)) {
         furi_thread_flags_set(furi_thread_get_id(instance->thread), ExpansionWorkerFlagError);
-    } else if(event & FuriHalSerialRxEventData) {
-        while(furi_hal_serial_async_rx_available(handle)) {
-            const uint8_t data = furi_hal_serial_async_rx(handle);
-            furi_stream_buffer_send(instance->rx_buf, &data, sizeof(data), 0);
+    } else if(event & (FuriHalSerialRxEventData | FuriHalSerialRxEventIdle)) {
+        uint8_t data[EXPANSION_WORKER_RX_CHUNK_SIZE];
+        while(data_len > 0) {
+            const size_t received_size =
+                furi_hal_serial_dma_rx(handle, data, MIN(data_len, sizeof(data)));
+            furi_stream_buffer_send(instance->rx_buf, data, received_size, 0);
+            data_len -= received_size;
         }
         furi_thread_flags_set(furi_thread_get_id(instance->thread), ExpansionWorkerFlagData);
     }
@@ -123,54 +146,97 @@ static size_t
     expansion_worker_send_callback(const uint8_t* data, size_t data_size, void* context) {
     ExpansionWorker* instance = context;
     furi_hal_serial_tx(instance->serial_handle, data, data_size);
-    furi_hal_serial_tx_wait_complete(instance->serial_handle);
     return data_size;
 }
 
-static inline bool
-    expansion_worker_send_frame(ExpansionWorker* instance, const ExpansionFrame* frame) {
-    return expansion_protocol_encode(frame, expansion_worker_send_callback, instance) ==
+// Both the worker and the Rpc session thread send frames, tx_mutex keeps them from interleaving
+static inline bool expansion_worker_send_frame(ExpansionWorker* instance) {
+    return expansion_protocol_encode(
+               &instance->tx_frame, expansion_worker_send_callback, instance) ==
            ExpansionProtocolStatusOk;
 }
 
 static bool expansion_worker_send_heartbeat(ExpansionWorker* instance) {
-    const ExpansionFrame frame = {
-        .header.type = ExpansionFrameTypeHeartbeat,
-        .content.heartbeat = {},
-    };
+    furi_check(furi_mutex_acquire(instance->tx_mutex, FuriWaitForever) == FuriStatusOk);
+
+    instance->tx_frame.header.type = ExpansionFrameTypeHeartbeat;
+    const bool success = expansion_worker_send_frame(instance);
 
-    return expansion_worker_send_frame(instance, &frame);
+    furi_check(furi_mutex_release(instance->tx_mutex) == FuriStatusOk);
+    return success;
 }
 
 static bool
     expansion_worker_send_status_response(ExpansionWorker* instance, ExpansionFrameError error) {
-    const ExpansionFrame frame = {
-        .header.type = ExpansionFrameTypeStatus,
-        .content.status.error = error,
-    };
+    furi_check(furi_mutex_acquire(instance->tx_mutex, FuriWaitForever) == FuriStatusOk);
+
+    instance->tx_frame.header.type = ExpansionFrameTypeStatus;
+    instance->tx_frame.content.status.error = error;
+    const bool success = expansion_worker_send_frame(instance);
+
+    furi_check(furi_mutex_release(instance->tx_mutex) == FuriStatusOk);
+    return success;
+}
+
+static bool expansion_worker_send_stream_config_response(ExpansionWorker* instance) {
+    furi_check(furi_mutex_acquire(instance->tx_mutex, FuriWaitForever) == FuriStatusOk);
+
+    instance->tx_frame.header.type = ExpansionFrameTypeStreamConfig;
+    instance->tx_frame.content.stream_config.max_data_size =
+        EXPANSION_PROTOCOL_STREAM_MAX_DATA_SIZE;
+    instance->tx_frame.content.stream_config.window = EXPANSION_WORKER_STREAM_WINDOW;
+    const bool success = expansion_worker_send_frame(instance);
 
-    return expansion_worker_send_frame(instance, &frame);
+    furi_check(furi_mutex_release(instance->tx_mutex) == FuriStatusOk);
+    return success;
+}
+
+static bool expansion_worker_send_stream_ack(ExpansionWorker* instance, uint8_t seq) {
+    furi_check(furi_mutex_acquire(instance->tx_mutex, FuriWaitForever) == FuriStatusOk);
+
+    instance->tx_frame.header.type = ExpansionFrameTypeStreamAck;
+    instance->tx_frame.content.stream_ack.seq = seq;
+    const bool success = expansion_worker_send_frame(instance);
+
+    furi_check(furi_mutex_release(instance->tx_mutex) == FuriStatusOk);
+    return success;
 }
 
 static bool expansion_worker_send_data_response(
     ExpansionWorker* instance,
     const uint8_t* data,
     size_t data_size) {
-    furi_assert(data_size <= EXPANSION_PROTOCOL_MAX_DATA_SIZE);
+    furi_check(furi_mutex_acquire(instance->tx_mutex, FuriWaitForever) == FuriStatusOk);
+
+    ExpansionFrame* frame = &instance->tx_frame;
+
+    if(instance->is_stream_mode) {
+        furi_assert(data_size <= instance->tx_max_data_size);
+        frame->header.type = ExpansionFrameTypeStreamData;
+        frame->content.stream_data.seq = instance->tx_seq++;
+        frame->content.stream_data.size = data_size;
+        memcpy(frame->content.stream_data.bytes, data, data_size);
+    } else {
+        furi_assert(data_size <= EXPANSION_PROTOCOL_MAX_DATA_SIZE);
+        frame->header.type = ExpansionFrameTypeData;
+        frame->content.data.size = data_size;
+        memcpy(frame->content.data.bytes, data, data_size);
+    }
 
-    ExpansionFrame frame = {
-        .header.type = ExpansionFrameTypeData,
-        .content.data.size = data_size,
-    };
+    const bool success = expansion_worker_send_frame(instance);
 
-    memcpy(frame.content.data.bytes, data, data_size);
-    return expansion_worker_send_frame(instance, &frame);
+    furi_check(furi_mutex_release(instance->tx_mutex) == FuriStatusOk);
+    return success;
 }
 
 // Called in Rpc session thread context
 static void expansion_worker_rpc_send_callback(void* context, uint8_t* data, size_t data_size) {
     ExpansionWorker* instance = context;
 
+    // In stream mode, the semaphore counts free slots in the module's receive window
+    const size_t max_data_size = instance->is_stream_mode ? instance->tx_max_data_size :
+                                                            EXPANSION_PROTOCOL_MAX_DATA_SIZE;
+
     for(size_t sent_data_size = 0; sent_data_size < data_size;) {
         if(furi_semaphore_acquire(
                instance->tx_semaphore, furi_ms_to_ticks(EXPANSION_PROTOCOL_TIMEOUT_MS)) !=
@@ -179,8 +245,7 @@ static void expansion_worker_rpc_send_callback(void* context, uint8_t* data, siz
             break;
         }
 
-        const size_t current_data_size =
-            MIN(data_size - sent_data_size, EXPANSION_PROTOCOL_MAX_DATA_SIZE);
+        const size_t current_data_size = MIN(data_size - sent_data_size, max_data_size);
         if(!expansion_worker_send_data_response(instance, data + sent_data_size, current_data_size))
             break;
         sent_data_size += current_data_size;
@@ -192,7 +257,8 @@ static bool expansion_worker_rpc_session_open(ExpansionWorker* instance) {
     instance->rpc_session = rpc_session_open(rpc, RpcOwnerUart);
 
     if(instance->rpc_session) {
-        instance->tx_semaphore = furi_semaphore_alloc(1, 1);
+        const uint32_t window = instance->is_stream_mode ? instance->tx_window : 1;
+        instance->tx_semaphore = furi_semaphore_alloc(window, window);
         rpc_session_set_context(instance->rpc_session, instance);
         rpc_session_set_send_bytes_callback(
             instance->rpc_session, expansion_worker_rpc_send_callback);
@@ -226,6 +292,7 @@ static bool expansion_worker_handle_state_handshake(
             instance->callback(instance->cb_context, ExpansionWorkerCallbackReasonConnected);
             // Send response at previous baud rate
             if(!expansion_worker_send_status_response(instance, ExpansionFrameErrorNone)) break;
+            furi_hal_serial_tx_wait_complete(instance->serial_handle);
             furi_hal_serial_set_br(instance->serial_handle, baud_rate);
 
         } else {
@@ -239,6 +306,50 @@ static bool expansion_worker_handle_state_handshake(
     return success;
 }
 
+static bool expansion_worker_handle_stream_config(
+    ExpansionWorker* instance,
+    const ExpansionFrameStreamConfig* config) {
+    FURI_LOG_D(
+        TAG, "Proposed stream mode: %u bytes, window %u", config->max_data_size, config->window);
+
+    if((config->max_data_size == 0) || (config->window == 0)) {
+        return expansion_worker_send_status_response(instance, ExpansionFrameErrorUnknown);
+    }
+
+    instance->is_stream_mode = true;
+    instance->tx_max_data_size =
+        MIN(config->max_data_size, EXPANSION_PROTOCOL_STREAM_MAX_DATA_SIZE);
+    instance->tx_window = MIN(config->window, EXPANSION_PROTOCOL_STREAM_MAX_WINDOW);
+    instance->tx_seq = 0;
+    instance->tx_seq_acked = 0;
+    instance->rx_seq = 0;
+
+    return expansion_worker_send_stream_config_response(instance);
+}
+
+// Acknowledges all frames up to and including seq, freeing their window slots
+static bool expansion_worker_handle_stream_ack(ExpansionWorker* instance, uint8_t seq) {
+    furi_check(furi_mutex_acquire(instance->tx_mutex, FuriWaitForever) == FuriStatusOk);
+
+    const uint8_t frames_in_flight = instance->tx_seq - instance->tx_seq_acked;
+    const uint8_t frames_acked = seq + 1U - instance->tx_seq_acked;
+    const bool success = (frames_acked > 0) && (frames_acked <= frames_in_flight);
+
+    if(success) {
+        instance->tx_seq_acked += frames_acked;
+    }
+
+    furi_check(furi_mutex_release(instance->tx_mutex) == FuriStatusOk);
+
+    if(success) {
+        for(uint8_t i = 0; i < frames_acked; ++i) {
+            furi_semaphore_release(instance->tx_semaphore);
+        }
+    }
+
+    return success;
+}
+
 static bool expansion_worker_handle_state_connected(
     ExpansionWorker* instance,
     const ExpansionFrame* rx_frame) {
@@ -251,6 +362,10 @@ static bool expansion_worker_handle_state_connected(
             if(!expansion_worker_rpc_session_open(instance)) break;
             if(!expansion_worker_send_status_response(instance, ExpansionFrameErrorNone)) break;
 
+        } else if(rx_frame->header.type == ExpansionFrameTypeStreamConfig) {
+            if(!expansion_worker_handle_stream_config(instance, &rx_frame->content.stream_config))
+                break;
+
         } else if(rx_frame->header.type == ExpansionFrameTypeHeartbeat) {
             if(!expansion_worker_send_heartbeat(instance)) break;
 
@@ -279,6 +394,24 @@ static bool expansion_worker_handle_state_rpc_active(
                 EXPANSION_PROTOCOL_TIMEOUT_MS);
             if(size_consumed != rx_frame->content.data.size) break;
 
+        } else if(rx_frame->header.type == ExpansionFrameTypeStreamData) {
+            if(!instance->is_stream_mode) break;
+            if(rx_frame->content.stream_data.seq != instance->rx_seq) break;
+            // The frame is already out of the receive buffer, so its window slot is free
+            if(!expansion_worker_send_stream_ack(instance, instance->rx_seq++)) break;
+
+            const size_t size_consumed = rpc_session_feed(
+                instance->rpc_session,
+                rx_frame->content.stream_data.bytes,
+                rx_frame->content.stream_data.size,
+                EXPANSION_PROTOCOL_TIMEOUT_MS);
+            if(size_consumed != rx_frame->content.stream_data.size) break;
+
+        } else if(rx_frame->header.type == ExpansionFrameTypeStreamAck) {
+            if(!instance->is_stream_mode) break;
+            if(!expansion_worker_handle_stream_ack(instance, rx_frame->content.stream_ack.seq))
+                break;
+
         } else if(rx_frame->header.type == ExpansionFrameTypeControl) {
             if(rx_frame->content.control.command != ExpansionFrameControlCommandStopRpc) break;
             instance->state = ExpansionWorkerStateConnected;
@@ -286,6 +419,7 @@ static bool expansion_worker_handle_state_rpc_active(
             if(!expansion_worker_send_status_response(instance, ExpansionFrameErrorNone)) break;
 
         } else if(rx_frame->header.type == ExpansionFrameTypeStatus) {
+            if(instance->is_stream_mode) break;
             if(rx_frame->content.status.error != ExpansionFrameErrorNone) break;
             furi_semaphore_release(instance->tx_semaphore);
 
@@ -310,11 +444,11 @@ static const ExpansionWorkerStateHandler expansion_handlers[] = {
 };
 
 static inline void expansion_worker_state_machine(ExpansionWorker* instance) {
-    ExpansionFrame rx_frame;
+    ExpansionFrame* rx_frame = &instance->rx_frame;
 
     while(true) {
-        if(!expansion_worker_receive_frame(instance, &rx_frame)) break;
-        if(!expansion_handlers[instance->state](instance, &rx_frame)) break;
+        if(!expansion_worker_receive_frame(instance, rx_frame)) break;
+        if(!expansion_handlers[instance->state](instance, rx_frame)) break;
     }
 }
 
@@ -331,10 +465,11 @@ static int32_t expansion_worker(void* context) {
 
     instance->state = ExpansionWorkerStateHandShake;
     instance->exit_reason = ExpansionWorkerExitReasonUnknown;
+    instance->is_stream_mode = false;
 
     furi_hal_serial_init(instance->serial_handle, EXPANSION_PROTOCOL_DEFAULT_BAUD_RATE);
 
-    furi_hal_serial_async_rx_start(
+    furi_hal_serial_dma_rx_start(
         instance->serial_handle, expansion_worker_serial_rx_callback, instance, true);
 
     if(expansion_worker_send_heartbeat(instance)) {
@@ -364,6 +499,7 @@ ExpansionWorker* expansion_worker_alloc(FuriHalSerialId serial_id) {
     instance->thread = furi_thread_alloc_ex(
         TAG "Worker", EXPANSION_WORKER_STACK_SZIE, expansion_worker, instance);
     instance->rx_buf = furi_stream_buffer_alloc(EXPANSION_WORKER_BUFFER_SIZE, 1);
+    instance->tx_mutex = furi_mutex_alloc(FuriMutexTypeNormal);
     instance->serial_id = serial_id;
 
     // Improves responsiveness in heavy games at the expense of dropped frames
@@ -374,6 +510,7 @@ ExpansionWorker* expansion_worker_alloc(FuriHalSerialId serial_id) {
 
 void expansion_worker_free(ExpansionWorker* instance) {
     furi_stream_buffer_free(instance->rx_buf);
+    furi_mutex_free(instance->tx_mutex);
     furi_thread_join(instance->thread);
     furi_thread_free(instance->thread);
     free(instance);
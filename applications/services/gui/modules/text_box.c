@@ -12,16 +12,47 @@
 #define TEXT_BOX_LINES_SCROLL_SPEED_FAST       (5)
 #define TEXT_BOX_LINES_SCROLL_SPEED_SATURATION (9)
 
+// Stream is read in pages, enough of them to cover backward scan and the screen after it
+#define TEXT_BOX_STREAM_PAGE_SIZE  (512)
+#define TEXT_BOX_STREAM_PAGE_COUNT (4)
+// Sparse index of line starts, spacing between entries doubles when it is full
+#define TEXT_BOX_STREAM_INDEX_SIZE    (128)
+#define TEXT_BOX_STREAM_INDEX_SPACING (1024)
+// Longest backward scan for the paragraph start before falling back to the index
+#define TEXT_BOX_STREAM_SCAN_MAX (1024)
+
 struct TextBox {
     View* view;
 
     uint16_t button_held_for_ticks;
 };
 
+typedef struct {
+    size_t offset;
+    size_t size;
+    uint8_t data[TEXT_BOX_STREAM_PAGE_SIZE];
+} TextBoxPage;
+
+typedef struct {
+    Stream* stream;
+    size_t size;
+
+    TextBoxPage pages[TEXT_BOX_STREAM_PAGE_COUNT];
+    uint8_t page_next;
+
+    // Offsets of line starts, sorted
+    size_t index[TEXT_BOX_STREAM_INDEX_SIZE];
+    size_t index_count;
+    size_t index_spacing;
+
+    size_t screen_end_offset;
+} TextBoxStream;
+
 typedef struct {
     TextBoxFont font;
     TextBoxFocus focus;
     const char* text;
+    TextBoxStream* stream;
 
     int32_t scroll_pos;
     int32_t scroll_num;
@@ -40,7 +71,10 @@ static void text_box_process_down(TextBox* text_box, uint8_t lines) {
         text_box->view,
         TextBoxModel * model,
         {
-            if(model->scroll_pos + lines < model->scroll_num) {
+            if(model->stream) {
+                // Applied and clamped on draw, since length is not known in advance
+                model->scroll_pos += lines;
+            } else if(model->scroll_pos + lines < model->scroll_num) {
                 model->scroll_pos += lines;
             } else {
                 if(model->scroll_num > 0) {
@@ -56,7 +90,9 @@ static void text_box_process_up(TextBox* text_box, uint8_t lines) {
         text_box->view,
         TextBoxModel * model,
         {
-            if(model->scroll_pos - lines > 0) {
+            if(model->stream) {
+                model->scroll_pos -= lines;
+            } else if(model->scroll_pos - lines > 0) {
                 model->scroll_pos -= lines;
             } else {
                 model->scroll_pos = 0;
@@ -101,8 +137,86 @@ static bool text_box_view_input_callback(InputEvent* event, void* context) {
     return consumed;
 }
 
+static char text_box_stream_get_char(TextBoxStream* stream, size_t offset) {
+    if(offset >= stream->size) {
+        return '\0';
+    }
+
+    TextBoxPage* page = NULL;
+    for(size_t i = 0; i < TEXT_BOX_STREAM_PAGE_COUNT; i++) {
+        if(offset >= stream->pages[i].offset &&
+           offset < stream->pages[i].offset + stream->pages[i].size) {
+            page = &stream->pages[i];
+            break;
+        }
+    }
+
+    if(!page) {
+        page = &stream->pages[stream->page_next];
+        stream->page_next = (stream->page_next + 1) % TEXT_BOX_STREAM_PAGE_COUNT;
+        page->offset = offset - offset % TEXT_BOX_STREAM_PAGE_SIZE;
+        page->size = 0;
+        if(stream_seek(stream->stream, page->offset, StreamOffsetFromStart)) {
+            page->size = stream_read(stream->stream, page->data, TEXT_BOX_STREAM_PAGE_SIZE);
+        }
+        if(offset >= page->offset + page->size) {
+            // Treat read errors as end of text
+            stream->size = offset;
+            return '\0';
+        }
+    }
+
+    char symb = page->data[offset - page->offset];
+    // Zero would be taken for the end of text
+    return symb ? symb : ' ';
+}
+
+static char text_box_get_char(TextBoxModel* model, int32_t offset) {
+    if(model->stream) {
+        return text_box_stream_get_char(model->stream, offset);
+    }
+    return model->text[offset];
+}
+
+/* Remember line start in the sparse index, if there is no entry close to it */
+static void text_box_stream_index_add(TextBoxStream* stream, size_t offset) {
+    size_t pos = 0;
+    while(pos < stream->index_count && stream->index[pos] < offset) {
+        pos++;
+    }
+    if(pos > 0 && offset - stream->index[pos - 1] < stream->index_spacing) return;
+    if(pos < stream->index_count && stream->index[pos] - offset < stream->index_spacing) return;
+
+    if(stream->index_count == TEXT_BOX_STREAM_INDEX_SIZE) {
+        // Keep RAM usage constant: drop every other entry and make index sparser
+        for(size_t i = 0; i < TEXT_BOX_STREAM_INDEX_SIZE / 2; i++) {
+            stream->index[i] = stream->index[i * 2];
+        }
+        stream->index_count = TEXT_BOX_STREAM_INDEX_SIZE / 2;
+        stream->index_spacing *= 2;
+        text_box_stream_index_add(stream, offset);
+        return;
+    }
+
+    memmove(
+        &stream->index[pos + 1],
+        &stream->index[pos],
+        (stream->index_count - pos) * sizeof(stream->index[0]));
+    stream->index[pos] = offset;
+    stream->index_count++;
+}
+
+/* Get closest known line start before offset */
+static size_t text_box_stream_index_find(TextBoxStream* stream, size_t offset) {
+    size_t found = 0;
+    for(size_t i = 0; i < stream->index_count && stream->index[i] < offset; i++) {
+        found = stream->index[i];
+    }
+    return found;
+}
+
 static bool text_box_end_of_text_reached(TextBoxModel* model) {
-    return model->text[model->text_offset] == '\0';
+    return text_box_get_char(model, model->text_offset) == '\0';
 }
 
 static bool text_box_start_of_text_reached(TextBoxModel* model) {
@@ -113,7 +227,7 @@ static void text_box_seek_next_line(Canvas* canvas, TextBoxModel* model) {
     size_t line_width = 0;
 
     while(!text_box_end_of_text_reached(model)) {
-        char symb = model->text[model->text_offset];
+        char symb = text_box_get_char(model, model->text_offset);
         if(symb == '\n') {
             model->text_offset++;
             break;
@@ -133,18 +247,33 @@ static void text_box_seek_end_of_prev_line(TextBoxModel* model) {
         if(text_box_start_of_text_reached(model)) break;
         model->text_offset--;
         if(text_box_start_of_text_reached(model)) break;
-        if(model->text[model->text_offset] == '\n') {
+        if(text_box_get_char(model, model->text_offset) == '\n') {
             model->text_offset--;
         }
     } while(false);
 }
 
 static void text_box_seek_prev_paragraph(TextBoxModel* model) {
+    int32_t start_text_offset = model->text_offset;
+    int32_t scan_end = 0;
+    if(model->stream && model->text_offset > TEXT_BOX_STREAM_SCAN_MAX) {
+        scan_end = model->text_offset - TEXT_BOX_STREAM_SCAN_MAX;
+    }
+
     while(!text_box_start_of_text_reached(model)) {
-        if(model->text[model->text_offset] == '\n') {
+        if(text_box_get_char(model, model->text_offset) == '\n') {
             model->text_offset++;
             break;
         }
+        if(model->text_offset == scan_end) {
+            // Long paragraph: lines can be counted from any known line start as well.
+            // Without one nearby, line wrapping may shift a bit, but scrolling stays fast.
+            size_t line_start = text_box_stream_index_find(model->stream, start_text_offset);
+            if(line_start + TEXT_BOX_STREAM_SCAN_MAX >= (size_t)scan_end) {
+                model->text_offset = line_start;
+            }
+            break;
+        }
         model->text_offset--;
     }
 }
@@ -158,7 +287,7 @@ static void text_box_seek_prev_line(Canvas* canvas, TextBoxModel* model) {
     int32_t current_text_offset = model->text_offset;
     while(true) {
         text_box_seek_next_line(canvas, model);
-        if(model->text_offset == start_text_offset) {
+        if(model->text_offset >= start_text_offset || text_box_end_of_text_reached(model)) {
             break;
         }
         current_text_offset = model->text_offset;
@@ -188,12 +317,12 @@ static void text_box_update_screen_text(Canvas* canvas, TextBoxModel* model) {
         int32_t current_line_text_offset = model->text_offset;
         text_box_seek_next_line(canvas, model);
         int32_t next_line_text_offset = model->text_offset;
-        furi_string_set_strn(
-            model->text_line,
-            &model->text[current_line_text_offset],
-            next_line_text_offset - current_line_text_offset);
+        furi_string_reset(model->text_line);
+        for(int32_t j = current_line_text_offset; j < next_line_text_offset; j++) {
+            furi_string_push_back(model->text_line, text_box_get_char(model, j));
+        }
         size_t str_len = furi_string_size(model->text_line);
-        if(furi_string_get_char(model->text_line, str_len - 1) != '\n') {
+        if(str_len == 0 || furi_string_get_char(model->text_line, str_len - 1) != '\n') {
             furi_string_push_back(model->text_line, '\n');
         }
         furi_string_cat(model->text_on_screen, model->text_line);
@@ -202,6 +331,10 @@ static void text_box_update_screen_text(Canvas* canvas, TextBoxModel* model) {
         current_line_text_offset = next_line_text_offset;
     }
 
+    if(model->stream) {
+        model->stream->screen_end_offset = model->text_offset;
+        text_box_stream_index_add(model->stream, start_text_offset);
+    }
     model->text_offset = start_text_offset;
 }
 
@@ -212,6 +345,55 @@ static void text_box_update_text_on_screen(Canvas* canvas, TextBoxModel* model)
     model->line_offset = model->scroll_pos;
 }
 
+static void text_box_update_stream_on_screen(Canvas* canvas, TextBoxModel* model) {
+    TextBoxStream* stream = model->stream;
+    int32_t line_offset = model->scroll_pos - model->line_offset;
+
+    // Stop scrolling down when the last line is on screen and up at the start of text
+    for(; line_offset > 0; line_offset--) {
+        if(text_box_stream_get_char(stream, stream->screen_end_offset) == '\0') break;
+        text_box_seek_next_line(canvas, model);
+        int32_t text_offset = model->text_offset;
+        model->text_offset = stream->screen_end_offset;
+        text_box_seek_next_line(canvas, model);
+        stream->screen_end_offset = model->text_offset;
+        model->text_offset = text_offset;
+    }
+    for(; line_offset < 0; line_offset++) {
+        if(text_box_start_of_text_reached(model)) break;
+        text_box_seek_prev_line(canvas, model);
+    }
+
+    text_box_update_screen_text(canvas, model);
+    model->scroll_pos -= line_offset;
+    model->line_offset = model->scroll_pos;
+}
+
+static void text_box_prepare_stream(Canvas* canvas, TextBoxModel* model) {
+    TextBoxStream* stream = model->stream;
+    model->scroll_num = 0;
+    model->scroll_pos = 0;
+    model->line_offset = 0;
+    model->lines_on_screen = TEXT_BOX_TEXT_HEIGHT / canvas_current_font_height(canvas);
+
+    // Line starts depend on the font
+    stream->index_count = 0;
+    stream->index_spacing = TEXT_BOX_STREAM_INDEX_SPACING;
+
+    model->text_offset = 0;
+    if(model->focus == TextBoxFocusEnd) {
+        // Only the lines that are shown are scanned
+        model->text_offset = stream->size;
+        if(stream->size > 0 && text_box_stream_get_char(stream, stream->size - 1) == '\n') {
+            model->text_offset--;
+        }
+        text_box_move_line_offset(canvas, model, -(model->lines_on_screen - 1));
+        text_box_seek_prev_line(canvas, model);
+    }
+
+    text_box_update_screen_text(canvas, model);
+}
+
 static void text_box_prepare_model(Canvas* canvas, TextBoxModel* model) {
     int32_t lines_num = 0;
     model->text_offset = 0;
@@ -248,7 +430,7 @@ static void text_box_prepare_model(Canvas* canvas, TextBoxModel* model) {
 static void text_box_view_draw_callback(Canvas* canvas, void* _model) {
     TextBoxModel* model = _model;
 
-    if(!model->text) {
+    if(!model->text && !model->stream) {
         return;
     }
 
@@ -260,15 +442,28 @@ static void text_box_view_draw_callback(Canvas* canvas, void* _model) {
     }
 
     if(!model->formatted) {
-        text_box_prepare_model(canvas, model);
+        if(model->stream) {
+            text_box_prepare_stream(canvas, model);
+        } else {
+            text_box_prepare_model(canvas, model);
+        }
         model->formatted = true;
     }
 
-    elements_slightly_rounded_frame(canvas, 0, 0, 124, 64);
-    elements_scrollbar(canvas, model->scroll_pos, model->scroll_num);
+    if(model->stream) {
+        if(model->line_offset != model->scroll_pos) {
+            text_box_update_stream_on_screen(canvas, model);
+        }
+        elements_slightly_rounded_frame(canvas, 0, 0, 124, 64);
+        // Line count is unknown, so position is shown in bytes
+        elements_scrollbar(canvas, model->text_offset, model->stream->size);
+    } else {
+        elements_slightly_rounded_frame(canvas, 0, 0, 124, 64);
+        elements_scrollbar(canvas, model->scroll_pos, model->scroll_num);
 
-    if(model->line_offset != model->scroll_pos) {
-        text_box_update_text_on_screen(canvas, model);
+        if(model->line_offset != model->scroll_pos) {
+            text_box_update_text_on_screen(canvas, model);
+        }
     }
     elements_multiline_text(canvas, 3, 11, furi_string_get_cstr(model->text_on_screen));
 }
@@ -305,6 +500,7 @@ void text_box_free(TextBox* text_box) {
         {
             furi_string_free(model->text_on_screen);
             furi_string_free(model->text_line);
+            free(model->stream);
         },
         true);
     view_free(text_box->view);
@@ -324,6 +520,8 @@ void text_box_reset(TextBox* text_box) {
         TextBoxModel * model,
         {
             model->text = NULL;
+            free(model->stream);
+            model->stream = NULL;
             model->font = TextBoxFontText;
             model->focus = TextBoxFocusStart;
             furi_string_reset(model->text_line);
@@ -347,6 +545,28 @@ void text_box_set_text(TextBox* text_box, const char* text) {
         TextBoxModel * model,
         {
             model->text = text;
+            free(model->stream);
+            model->stream = NULL;
+            model->formatted = false;
+        },
+        true);
+}
+
+void text_box_set_stream(TextBox* text_box, Stream* stream) {
+    furi_check(text_box);
+    furi_check(stream);
+
+    with_view_model(
+        text_box->view,
+        TextBoxModel * model,
+        {
+            model->text = NULL;
+            if(!model->stream) {
+                model->stream = malloc(sizeof(TextBoxStream));
+            }
+            memset(model->stream, 0, sizeof(TextBoxStream));
+            model->stream->stream = stream;
+            model->stream->size = stream_size(stream);
             model->formatted = false;
         },
         true);
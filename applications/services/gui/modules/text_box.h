@@ -6,6 +6,7 @@
 #pragma once
 
 #include <gui/view.h>
+#include <toolbox/stream/stream.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -57,6 +58,17 @@ void text_box_reset(TextBox* text_box);
  */
 void text_box_set_text(TextBox* text_box, const char* text);
 
+/** Set stream to show text from, instead of a string
+ *
+ * Text is read in small pages on demand, so files of any size can be shown
+ * with constant RAM usage. Stream must stay open and must not be used by
+ * anyone else until text_box is reset or other text is set.
+ *
+ * @param      text_box  TextBox instance
+ * @param      stream    Stream instance with text
+ */
+void text_box_set_stream(TextBox* text_box, Stream* stream);
+
 /** Set TextBox font
  *
  * @param      text_box  TextBox instance
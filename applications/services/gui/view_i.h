@@ -8,6 +8,10 @@
 #include "view.h"
 #include <furi.h>
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 typedef struct {
     FuriMutex* mutex;
     uint8_t data[];
@@ -54,3 +58,7 @@ void view_enter(View* view);
 
 /** Exit Callback for View dispatcher */
 void view_exit(View* view);
+
+#ifdef __cplusplus
+}
+#endif
@@ -26,6 +26,11 @@ typedef enum {
 
 #define RPC_ALL_EVENTS (RpcEvtNewData | RpcEvtDisconnect)
 
+/* Messages are encoded into a per-session buffer and handed to transport in one call */
+#define RPC_SEND_BUFFER_SIZE (RPC_BUFFER_SIZE)
+/* Room for the length prefix, which is only known once the message is encoded */
+#define RPC_SEND_PREFIX_SIZE (5U)
+
 DICT_DEF2(RpcHandlerDict, pb_size_t, M_DEFAULT_OPLIST, RpcHandler, M_POD_OPLIST)
 
 typedef struct {
@@ -84,6 +89,10 @@ struct RpcSession {
     RpcSessionTerminatedCallback terminated_callback;
     RpcOwner owner;
     void* context;
+
+    /* Guarded by callbacks_mutex */
+    uint8_t* send_buffer;
+    size_t send_buffer_used;
 };
 
 struct Rpc {
@@ -360,6 +369,7 @@ static void rpc_session_thread_pending_callback(void* context, uint32_t arg) {
     }
     free(session->system_contexts);
     free(session->decoded_message);
+    free(session->send_buffer);
     RpcHandlerDict_clear(session->handlers);
     furi_stream_buffer_free(session->stream);
 
@@ -397,6 +407,8 @@ RpcSession* rpc_session_open(Rpc* rpc, RpcOwner owner) {
     session->decoded_message->cb_content.funcs.decode = rpc_pb_content_callback;
     session->decoded_message->cb_content.arg = session;
 
+    session->send_buffer = malloc(RPC_SEND_PREFIX_SIZE + RPC_SEND_BUFFER_SIZE);
+
     session->system_contexts = malloc(COUNT_OF(rpc_systems) * sizeof(void*));
     for(size_t i = 0; i < COUNT_OF(rpc_systems); ++i) {
         session->system_contexts[i] = rpc_systems[i].alloc(session);
@@ -452,17 +464,62 @@ void rpc_add_handler(RpcSession* session, pb_size_t message_tag, RpcHandler* han
     RpcHandlerDict_set_at(session->handlers, message_tag, *handler);
 }
 
-void rpc_send(RpcSession* session, PB_Main* message) {
-    furi_assert(session);
-    furi_assert(message);
-
-    pb_ostream_t ostream = PB_OSTREAM_SIZING;
-
+static void rpc_send_bytes(RpcSession* session, const uint8_t* bytes, size_t bytes_len) {
 #ifdef SRV_RPC_DEBUG
-    FURI_LOG_I(TAG, "OUTPUT:");
-    rpc_debug_print_message(message);
+    rpc_debug_print_data("OUTPUT", (uint8_t*)bytes, bytes_len);
 #endif
 
+    // Transport doesn't modify data, it just has no const in callback signature
+    session->send_bytes_callback(session->context, (uint8_t*)bytes, bytes_len);
+}
+
+static bool rpc_send_buffer_write(pb_ostream_t* stream, const pb_byte_t* buf, size_t count) {
+    RpcSession* session = stream->state;
+
+    if(count > RPC_SEND_BUFFER_SIZE - session->send_buffer_used) {
+        return false;
+    }
+
+    memcpy(&session->send_buffer[RPC_SEND_PREFIX_SIZE + session->send_buffer_used], buf, count);
+    session->send_buffer_used += count;
+
+    return true;
+}
+
+/* Encode message in one pass into the send buffer and send it, false if it doesn't fit */
+static bool rpc_send_buffered(RpcSession* session, const PB_Main* message) {
+    session->send_buffer_used = 0;
+
+    pb_ostream_t ostream = {
+        .callback = rpc_send_buffer_write,
+        .state = session,
+        .max_size = SIZE_MAX,
+        .bytes_written = 0,
+        .errmsg = NULL,
+    };
+    if(!pb_encode(&ostream, &PB_Main_msg, message)) {
+        return false;
+    }
+
+    // Put length prefix right before the message, as PB_ENCODE_DELIMITED would
+    uint8_t prefix[RPC_SEND_PREFIX_SIZE];
+    pb_ostream_t prefix_stream = pb_ostream_from_buffer(prefix, sizeof(prefix));
+    furi_check(pb_encode_varint(&prefix_stream, ostream.bytes_written));
+    // Transports send one frame or packet per call, so message goes out whole
+    uint8_t* chunk = &session->send_buffer[RPC_SEND_PREFIX_SIZE - prefix_stream.bytes_written];
+    memcpy(chunk, prefix, prefix_stream.bytes_written);
+
+    if(session->send_bytes_callback) {
+        rpc_send_bytes(session, chunk, prefix_stream.bytes_written + session->send_buffer_used);
+    }
+
+    return true;
+}
+
+/* Encode message into a buffer allocated for it and send it */
+static void rpc_send_allocated(RpcSession* session, const PB_Main* message) {
+    pb_ostream_t ostream = PB_OSTREAM_SIZING;
+
     bool result = pb_encode_ex(&ostream, &PB_Main_msg, message, PB_ENCODE_DELIMITED);
     furi_check(result && ostream.bytes_written);
 
@@ -471,17 +528,27 @@ void rpc_send(RpcSession* session, PB_Main* message) {
 
     pb_encode_ex(&ostream, &PB_Main_msg, message, PB_ENCODE_DELIMITED);
 
+    if(session->send_bytes_callback) {
+        rpc_send_bytes(session, buffer, ostream.bytes_written);
+    }
+
+    free(buffer);
+}
+
+void rpc_send(RpcSession* session, PB_Main* message) {
+    furi_assert(session);
+    furi_assert(message);
+
 #ifdef SRV_RPC_DEBUG
-    rpc_debug_print_data("OUTPUT", buffer, ostream.bytes_written);
+    FURI_LOG_I(TAG, "OUTPUT:");
+    rpc_debug_print_message(message);
 #endif
 
     furi_mutex_acquire(session->callbacks_mutex, FuriWaitForever);
-    if(session->send_bytes_callback) {
-        session->send_bytes_callback(session->context, buffer, ostream.bytes_written);
+    if(!rpc_send_buffered(session, message)) {
+        rpc_send_allocated(session, message);
     }
     furi_mutex_release(session->callbacks_mutex);
-
-    free(buffer);
 }
 
 void rpc_send_and_release(RpcSession* session, PB_Main* message) {
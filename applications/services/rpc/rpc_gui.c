@@ -52,6 +52,10 @@ typedef enum {
 
 #define RPC_GUI_INPUT_RESET (0u)
 
+// Pause after each frame as a fraction of its transmit time, leaves ~5% of link to other RPC
+#define RPC_GUI_TRANSMIT_RESERVE_DIV (20u)
+#define RPC_GUI_TRANSMIT_DELAY_MAX   (500u)
+
 typedef struct {
     RpcSession* session;
     Gui* gui;
@@ -65,6 +69,12 @@ typedef struct {
     // Transmit
     PB_Main* transmit_frame;
     FuriThread* transmit_thread;
+    // Newest frame not yet sent, guarded by transmit_mutex
+    FuriMutex* transmit_mutex;
+    pb_bytes_array_t* pending_data;
+    PB_Gui_ScreenOrientation pending_orientation;
+    bool is_frame_pending;
+    bool is_frame_sent;
 
     bool virtual_display_not_empty;
     bool is_streaming;
@@ -94,15 +104,48 @@ static void rpc_system_gui_screen_stream_frame_callback(
     furi_assert(context);
 
     RpcGuiSystem* rpc_gui = (RpcGuiSystem*)context;
-    uint8_t* buffer = rpc_gui->transmit_frame->content.gui_screen_frame.data->bytes;
+    PB_Gui_ScreenFrame* frame = &rpc_gui->transmit_frame->content.gui_screen_frame;
+    PB_Gui_ScreenOrientation pb_orientation = rpc_system_gui_screen_orientation_map[orientation];
+
+    furi_assert(size == rpc_gui->pending_data->size);
+
+    furi_check(furi_mutex_acquire(rpc_gui->transmit_mutex, FuriWaitForever) == FuriStatusOk);
+    // Frame being sent is only swapped under the mutex, so it is safe to read here
+    bool is_sent = rpc_gui->is_frame_sent && frame->orientation == pb_orientation &&
+                   memcmp(frame->data->bytes, data, size) == 0;
+    if(is_sent) {
+        // Screen is back to what client already has, drop the pending frame if any
+        rpc_gui->is_frame_pending = false;
+    } else {
+        // Overwrite the pending frame: only the newest one is sent
+        memcpy(rpc_gui->pending_data->bytes, data, size);
+        rpc_gui->pending_orientation = pb_orientation;
+        rpc_gui->is_frame_pending = true;
+    }
+    furi_mutex_release(rpc_gui->transmit_mutex);
 
-    furi_assert(size == rpc_gui->transmit_frame->content.gui_screen_frame.data->size);
+    if(!is_sent) {
+        furi_thread_flags_set(
+            furi_thread_get_id(rpc_gui->transmit_thread), RpcGuiWorkerFlagTransmit);
+    }
+}
 
-    memcpy(buffer, data, size);
-    rpc_gui->transmit_frame->content.gui_screen_frame.orientation =
-        rpc_system_gui_screen_orientation_map[orientation];
+static bool rpc_system_gui_screen_stream_take_pending(RpcGuiSystem* rpc_gui) {
+    PB_Gui_ScreenFrame* frame = &rpc_gui->transmit_frame->content.gui_screen_frame;
+
+    furi_check(furi_mutex_acquire(rpc_gui->transmit_mutex, FuriWaitForever) == FuriStatusOk);
+    bool is_pending = rpc_gui->is_frame_pending;
+    if(is_pending) {
+        pb_bytes_array_t* data = frame->data;
+        frame->data = rpc_gui->pending_data;
+        frame->orientation = rpc_gui->pending_orientation;
+        rpc_gui->pending_data = data;
+        rpc_gui->is_frame_pending = false;
+        rpc_gui->is_frame_sent = true;
+    }
+    furi_mutex_release(rpc_gui->transmit_mutex);
 
-    furi_thread_flags_set(furi_thread_get_id(rpc_gui->transmit_thread), RpcGuiWorkerFlagTransmit);
+    return is_pending;
 }
 
 static int32_t rpc_system_gui_screen_stream_frame_transmit_thread(void* context) {
@@ -115,25 +158,47 @@ static int32_t rpc_system_gui_screen_stream_frame_transmit_thread(void* context)
         uint32_t flags =
             furi_thread_flags_wait(RpcGuiWorkerFlagAny, FuriFlagWaitAny, FuriWaitForever);
 
-        if(flags & RpcGuiWorkerFlagTransmit) {
+        if(flags & RpcGuiWorkerFlagExit) {
+            break;
+        }
+
+        if((flags & RpcGuiWorkerFlagTransmit) &&
+           rpc_system_gui_screen_stream_take_pending(rpc_gui)) {
             transmit_time = furi_get_tick();
             rpc_send(rpc_gui->session, rpc_gui->transmit_frame);
             transmit_time = furi_get_tick() - transmit_time;
 
-            // Guaranteed bandwidth reserve
-            uint32_t extra_delay = transmit_time / 20;
-            if(extra_delay > 500) extra_delay = 500;
-            if(extra_delay) furi_delay_tick(extra_delay);
-        }
-
-        if(flags & RpcGuiWorkerFlagExit) {
-            break;
+            // Guaranteed bandwidth reserve: frames committed meanwhile are coalesced
+            uint32_t extra_delay = transmit_time / RPC_GUI_TRANSMIT_RESERVE_DIV;
+            if(extra_delay > RPC_GUI_TRANSMIT_DELAY_MAX) extra_delay = RPC_GUI_TRANSMIT_DELAY_MAX;
+            if(extra_delay) {
+                furi_thread_flags_wait(
+                    RpcGuiWorkerFlagExit, FuriFlagWaitAny | FuriFlagNoClear, extra_delay);
+            }
         }
     }
 
     return 0;
 }
 
+static void rpc_system_gui_screen_stream_stop(RpcGuiSystem* rpc_gui) {
+    rpc_gui->is_streaming = false;
+    // Remove GUI framebuffer callback
+    gui_remove_framebuffer_callback(
+        rpc_gui->gui, rpc_system_gui_screen_stream_frame_callback, rpc_gui);
+    // Stop and release worker thread
+    furi_thread_flags_set(furi_thread_get_id(rpc_gui->transmit_thread), RpcGuiWorkerFlagExit);
+    furi_thread_join(rpc_gui->transmit_thread);
+    furi_thread_free(rpc_gui->transmit_thread);
+    // Release frames
+    furi_mutex_free(rpc_gui->transmit_mutex);
+    free(rpc_gui->pending_data);
+    rpc_gui->pending_data = NULL;
+    pb_release(&PB_Main_msg, rpc_gui->transmit_frame);
+    free(rpc_gui->transmit_frame);
+    rpc_gui->transmit_frame = NULL;
+}
+
 static void rpc_system_gui_start_screen_stream_process(const PB_Main* request, void* context) {
     furi_assert(request);
     furi_assert(context);
@@ -159,6 +224,12 @@ static void rpc_system_gui_start_screen_stream_process(const PB_Main* request, v
         rpc_gui->transmit_frame->content.gui_screen_frame.data =
             malloc(PB_BYTES_ARRAY_T_ALLOCSIZE(framebuffer_size));
         rpc_gui->transmit_frame->content.gui_screen_frame.data->size = framebuffer_size;
+        // Pending frame, swapped with the one above on transmit
+        rpc_gui->pending_data = malloc(PB_BYTES_ARRAY_T_ALLOCSIZE(framebuffer_size));
+        rpc_gui->pending_data->size = framebuffer_size;
+        rpc_gui->is_frame_pending = false;
+        rpc_gui->is_frame_sent = false;
+        rpc_gui->transmit_mutex = furi_mutex_alloc(FuriMutexTypeNormal);
         // Transmission thread for async TX
         rpc_gui->transmit_thread = furi_thread_alloc_ex(
             "GuiRpcWorker", 1024, rpc_system_gui_screen_stream_frame_transmit_thread, rpc_gui);
@@ -180,18 +251,7 @@ static void rpc_system_gui_stop_screen_stream_process(const PB_Main* request, vo
     furi_assert(session);
 
     if(rpc_gui->is_streaming) {
-        rpc_gui->is_streaming = false;
-        // Remove GUI framebuffer callback
-        gui_remove_framebuffer_callback(
-            rpc_gui->gui, rpc_system_gui_screen_stream_frame_callback, context);
-        // Stop and release worker thread
-        furi_thread_flags_set(furi_thread_get_id(rpc_gui->transmit_thread), RpcGuiWorkerFlagExit);
-        furi_thread_join(rpc_gui->transmit_thread);
-        furi_thread_free(rpc_gui->transmit_thread);
-        // Release frame
-        pb_release(&PB_Main_msg, rpc_gui->transmit_frame);
-        free(rpc_gui->transmit_frame);
-        rpc_gui->transmit_frame = NULL;
+        rpc_system_gui_screen_stream_stop(rpc_gui);
     }
 
     rpc_send_and_release_empty(session, request->command_id, PB_CommandStatus_OK);
@@ -524,18 +584,7 @@ void rpc_system_gui_free(void* context) {
     view_port_free(rpc_gui->rpc_session_active_viewport_slim);
 
     if(rpc_gui->is_streaming) {
-        rpc_gui->is_streaming = false;
-        // Remove GUI framebuffer callback
-        gui_remove_framebuffer_callback(
-            rpc_gui->gui, rpc_system_gui_screen_stream_frame_callback, context);
-        // Stop and release worker thread
-        furi_thread_flags_set(furi_thread_get_id(rpc_gui->transmit_thread), RpcGuiWorkerFlagExit);
-        furi_thread_join(rpc_gui->transmit_thread);
-        furi_thread_free(rpc_gui->transmit_thread);
-        // Release frame
-        pb_release(&PB_Main_msg, rpc_gui->transmit_frame);
-        free(rpc_gui->transmit_frame);
-        rpc_gui->transmit_frame = NULL;
+        rpc_system_gui_screen_stream_stop(rpc_gui);
     }
     furi_record_close(RECORD_INPUT_EVENTS);
     furi_record_close(RECORD_GUI);
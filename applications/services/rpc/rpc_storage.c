@@ -364,40 +364,33 @@ static void rpc_system_storage_read_process(const PB_Main* request, void* contex
 
     if(fs_operation_success) {
         size_t size_left = storage_file_size(file);
+        /* and same data buffer for every chunk */
+        pb_bytes_array_t* data = malloc(PB_BYTES_ARRAY_T_ALLOCSIZE(MAX_DATA_SIZE));
         do {
             response->command_id = request->command_id;
             response->which_content = PB_Main_storage_read_response_tag;
             response->command_status = PB_CommandStatus_OK;
+            response->content.storage_read_response.has_file = true;
+            response->content.storage_read_response.file.data = data;
 
             size_t read_size = MIN(size_left, MAX_DATA_SIZE);
             if(read_size) {
-                response->content.storage_read_response.has_file = true;
-                response->content.storage_read_response.file.data =
-                    malloc(PB_BYTES_ARRAY_T_ALLOCSIZE(read_size));
-                uint8_t* buffer = &response->content.storage_read_response.file.data->bytes[0];
-                uint16_t* read_size_msg = &response->content.storage_read_response.file.data->size;
-
-                *read_size_msg = storage_file_read(file, buffer, read_size);
-                size_left -= *read_size_msg;
-                fs_operation_success = (*read_size_msg == read_size);
+                data->size = storage_file_read(file, &data->bytes[0], read_size);
+                size_left -= data->size;
+                fs_operation_success = (data->size == read_size);
 
                 response->has_next = fs_operation_success && (size_left > 0);
             } else {
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Warray-bounds"
-                response->content.storage_read_response.file.data =
-                    malloc(PB_BYTES_ARRAY_T_ALLOCSIZE(0));
-                response->content.storage_read_response.file.data->size = 0;
-#pragma GCC diagnostic pop
-                response->content.storage_read_response.has_file = true;
+                data->size = 0;
                 response->has_next = false;
                 fs_operation_success = true;
             }
 
             if(fs_operation_success) {
-                rpc_send_and_release(session, response);
+                rpc_send(session, response);
             }
         } while((size_left != 0) && fs_operation_success);
+        free(data);
     }
 
     if(!fs_operation_success) {
@@ -110,11 +110,15 @@ int32_t storage_srv(void* p) {
     furi_record_create(RECORD_STORAGE, app);
 
     StorageMessage message;
+    uint32_t tick_last = furi_get_tick();
     while(1) {
         if(furi_message_queue_get(app->message_queue, &message, STORAGE_TICK) == FuriStatusOk) {
             storage_process_message(app, &message);
-        } else {
+        }
+        // Tick even when busy, internal storage flushes deferred writes in it
+        if(furi_get_tick() - tick_last >= STORAGE_TICK) {
             storage_tick(app);
+            tick_last = furi_get_tick();
         }
     }
 
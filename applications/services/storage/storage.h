@@ -522,6 +522,20 @@ FS_Error storage_sd_info(Storage* storage, SDInfo* info);
  */
 FS_Error storage_sd_status(Storage* storage);
 
+/** SD card read statistics since boot */
+typedef struct {
+    uint32_t read_sectors; /**< Sectors read by the file system */
+    uint32_t read_commands; /**< SD read commands sent */
+    uint32_t cache_hits; /**< Sectors served from the sector cache */
+} StorageSdStats;
+
+/**
+ * @brief Get the SD card read statistics.
+ *
+ * @param stats pointer to a statistics structure to fill.
+ */
+void storage_sd_get_stats(StorageSdStats* stats);
+
 /******************* Internal LFS Functions *******************/
 
 typedef void (*Storage_name_converter)(FuriString*);
@@ -546,6 +560,23 @@ FS_Error storage_int_backup(Storage* storage, const char* dstname);
 FS_Error
     storage_int_restore(Storage* storage, const char* dstname, Storage_name_converter converter);
 
+/** Internal storage write statistics since boot */
+typedef struct {
+    uint32_t write_bytes; /**< Bytes written to files */
+    uint32_t prog_count; /**< Flash program operations */
+    uint32_t prog_bytes; /**< Bytes programmed to flash */
+    uint32_t erase_count; /**< Flash pages erased */
+} StorageIntStats;
+
+/**
+ * @brief Get the internal storage write statistics.
+ *
+ * In low wear mode flash programming is deferred, so recent writes may not be counted yet.
+ *
+ * @param stats pointer to a statistics structure to fill.
+ */
+void storage_int_get_stats(StorageIntStats* stats);
+
 /******************* FatFs Virtual Mount Functions *******************/
 
 /**
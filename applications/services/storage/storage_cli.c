@@ -37,6 +37,24 @@ static void storage_cli_info(Cli* cli, FuriString* path, FuriString* args) {
                 furi_hal_version_get_name_ptr() ? furi_hal_version_get_name_ptr() : "Unknown",
                 (uint32_t)(total_space / 1024),
                 (uint32_t)(free_space / 1024));
+
+            StorageIntStats stats;
+            storage_int_get_stats(&stats);
+            const bool low_wear = furi_hal_rtc_get_storage_mode() == FuriHalRtcStorageModeLowWear;
+            // Flash bytes programmed per byte written to files, in hundredths
+            uint32_t amplification =
+                stats.write_bytes ? (uint64_t)stats.prog_bytes * 100 / stats.write_bytes : 0;
+            printf(
+                "Mode: %s\r\n"
+                "Since boot: %luB written, %luB programmed in %lu ops, %lu pages erased\r\n"
+                "Write amplification: %lu.%02lu\r\n",
+                low_wear ? "low wear" : "default",
+                stats.write_bytes,
+                stats.prog_bytes,
+                stats.prog_count,
+                stats.erase_count,
+                amplification / 100,
+                amplification % 100);
         }
     } else if(furi_string_cmp_str(path, STORAGE_EXT_PATH_PREFIX) == 0) {
         SDInfo sd_info;
@@ -60,6 +78,14 @@ static void storage_cli_info(Cli* cli, FuriString* path, FuriString* args) {
                 sd_info.product_serial_number,
                 sd_info.manufacturing_month,
                 sd_info.manufacturing_year);
+
+            StorageSdStats stats;
+            storage_sd_get_stats(&stats);
+            printf(
+                "Since boot: %lu sectors read in %lu commands, %lu from cache\r\n",
+                stats.read_sectors,
+                stats.read_commands,
+                stats.cache_hits);
         }
     } else {
         storage_cli_print_usage();
@@ -25,6 +25,22 @@ static FS_Error storage_ext_parse_error(SDError error);
 
 /******************* Core Functions *******************/
 
+/* Sector cache keeps FAT and directory sectors of the mounted volume longer */
+static void sd_set_driver_layout(FATFS* fs) {
+    if(fs && fs->fs_type) {
+        SdFatfsDriverLayout layout = {
+            .fat_start = fs->fatbase,
+            .fat_size = fs->fsize,
+            .fat_count = fs->n_fats,
+            .data_start = fs->database,
+            .cluster_size = fs->csize,
+        };
+        sd_fatfs_driver_set_layout(&layout);
+    } else {
+        sd_fatfs_driver_set_layout(NULL);
+    }
+}
+
 static bool sd_mount_card_internal(StorageData* storage, bool notify) {
     bool result = false;
     uint8_t counter = furi_hal_sd_max_mount_retry_count();
@@ -50,6 +66,7 @@ static bool sd_mount_card_internal(StorageData* storage, bool notify) {
             storage->status = StorageStatusErrorInternal;
         } else {
             SDError status = f_mount(sd_data->fs, sd_data->path, 1);
+            sd_set_driver_layout(status == FR_OK ? sd_data->fs : NULL);
 
             if(status == FR_OK || status == FR_NO_FILESYSTEM) {
 #ifndef FURI_RAM_EXEC
@@ -103,6 +120,7 @@ FS_Error sd_unmount_card(StorageData* storage) {
 
     // TODO FL-3522: do i need to close the files?
     f_mount(0, sd_data->path, 0);
+    sd_set_driver_layout(NULL);
 
     return storage_ext_parse_error(error);
 }
@@ -143,6 +161,7 @@ FS_Error sd_format_card(StorageData* storage) {
     SDError error;
 
     work_area = malloc(_MAX_SS);
+    sd_set_driver_layout(NULL);
     error = f_mkfs(sd_data->path, FM_ANY, 0, work_area, _MAX_SS);
     free(work_area);
 
@@ -157,6 +176,7 @@ FS_Error sd_format_card(StorageData* storage) {
         storage->status = StorageStatusNotMounted;
         error = f_mount(sd_data->fs, sd_data->path, 1);
         if(error != FR_OK) break;
+        sd_set_driver_layout(sd_data->fs);
         storage->status = StorageStatusOK;
     } while(false);
 
@@ -698,6 +718,16 @@ void storage_ext_init(StorageData* storage) {
     storage_ext_tick_internal(storage, false);
 }
 
+void storage_sd_get_stats(StorageSdStats* stats) {
+    furi_check(stats);
+
+    SdFatfsDriverStats driver_stats;
+    sd_fatfs_driver_get_stats(&driver_stats);
+    stats->read_sectors = driver_stats.read_sectors;
+    stats->read_commands = driver_stats.read_commands;
+    stats->cache_hits = driver_stats.cache_hits;
+}
+
 #include "fatfs/ff_gen_drv.h"
 
 #define SCSI_BLOCK_SIZE (0x200UL)
@@ -1,4 +1,5 @@
 #include "storage_int.h"
+#include "../storage.h"
 #include <lfs.h>
 #include <furi_hal.h>
 #include <toolbox/path.h>
@@ -12,13 +13,35 @@
  * modification of non-dot files is restricted */
 #define LFS_RESERVED_PAGES_COUNT 3
 
+/* Files that fit in inline limit are stored in directory metadata: saving such
+ * file appends to metadata log instead of erasing and programming a page of its
+ * own. Cache and 1/8 of page cap the limit, both are sized for settings files. */
+#define LFS_CACHE_SIZE 512
+
+/* Inline limit of the old 16 byte cache: older firmware can read all files */
+#define LFS_INLINE_MAX_DEFAULT 16
+
+/* Low wear mode: flash programs are collected in RAM and written on device sync */
+#define LFS_BATCH_SIZE (LFS_CACHE_SIZE * 4)
+
+/* One bit per page, enough to cover whole internal storage */
+#define LFS_LOOKAHEAD_SIZE 32
+
 typedef struct {
     const size_t start_address;
     const size_t start_page;
     struct lfs_config config;
     lfs_t lfs;
+    StorageIntStats stats;
+    // Pending program operation, contiguous, allocated in low wear mode only
+    uint8_t* batch;
+    lfs_block_t batch_block;
+    lfs_off_t batch_off;
+    lfs_size_t batch_size;
 } LFSData;
 
+static LFSData* storage_int_lfs_data = NULL;
+
 typedef struct {
     void* data;
     bool open;
@@ -87,9 +110,47 @@ static int storage_int_device_read(
 
     memcpy(buffer, (void*)address, size);
 
+    // Data still waiting to be programmed takes precedence over flash
+    if(lfs_data->batch_size && lfs_data->batch_block == block) {
+        const lfs_off_t start = MAX(off, lfs_data->batch_off);
+        const lfs_off_t end = MIN(off + size, lfs_data->batch_off + lfs_data->batch_size);
+        if(start < end) {
+            memcpy(
+                (uint8_t*)buffer + (start - off),
+                &lfs_data->batch[start - lfs_data->batch_off],
+                end - start);
+        }
+    }
+
     return 0;
 }
 
+static void storage_int_device_write(
+    LFSData* lfs_data,
+    lfs_block_t block,
+    lfs_off_t off,
+    const void* buffer,
+    lfs_size_t size) {
+    size_t address = lfs_data->start_address + block * lfs_data->config.block_size + off;
+
+    lfs_data->stats.prog_count++;
+    lfs_data->stats.prog_bytes += size;
+
+    furi_hal_flash_write(address, buffer, size);
+}
+
+static void storage_int_device_flush(LFSData* lfs_data) {
+    if(lfs_data->batch_size) {
+        storage_int_device_write(
+            lfs_data,
+            lfs_data->batch_block,
+            lfs_data->batch_off,
+            lfs_data->batch,
+            lfs_data->batch_size);
+        lfs_data->batch_size = 0;
+    }
+}
+
 static int storage_int_device_prog(
     const struct lfs_config* c,
     lfs_block_t block,
@@ -108,15 +169,28 @@ static int storage_int_device_prog(
         size,
         (void*)address);
 
-    int ret = 0;
-    while(size > 0) {
-        furi_hal_flash_write_dword(address, *(uint64_t*)buffer);
-        address += c->prog_size;
-        buffer += c->prog_size;
-        size -= c->prog_size;
+    if(lfs_data->batch) {
+        // Commits append to metadata log, so successive programs are usually contiguous
+        if(lfs_data->batch_size &&
+           (lfs_data->batch_block != block ||
+            lfs_data->batch_off + lfs_data->batch_size != off ||
+            lfs_data->batch_size + size > LFS_BATCH_SIZE)) {
+            storage_int_device_flush(lfs_data);
+        }
+        if(size <= LFS_BATCH_SIZE) {
+            if(!lfs_data->batch_size) {
+                lfs_data->batch_block = block;
+                lfs_data->batch_off = off;
+            }
+            memcpy(&lfs_data->batch[lfs_data->batch_size], buffer, size);
+            lfs_data->batch_size += size;
+            return 0;
+        }
     }
 
-    return ret;
+    storage_int_device_write(lfs_data, block, off, buffer, size);
+
+    return 0;
 }
 
 static int storage_int_device_erase(const struct lfs_config* c, lfs_block_t block) {
@@ -125,13 +199,20 @@ static int storage_int_device_erase(const struct lfs_config* c, lfs_block_t bloc
 
     FURI_LOG_D(TAG, "Device erase: page %lu, translated page: %zx", block, page);
 
+    // Keep operations in order, littlefs relies on it to survive power loss
+    storage_int_device_flush(lfs_data);
+    lfs_data->stats.erase_count++;
+
     furi_hal_flash_erase(page);
     return 0;
 }
 
 static int storage_int_device_sync(const struct lfs_config* c) {
-    UNUSED(c);
-    FURI_LOG_D(TAG, "Device sync: skipping");
+    LFSData* lfs_data = c->context;
+    FURI_LOG_T(TAG, "Device sync");
+
+    // File sync and close must not report success before data is on flash
+    storage_int_device_flush(lfs_data);
     return 0;
 }
 
@@ -157,8 +238,19 @@ static LFSData* storage_int_lfs_data_alloc(void) {
     lfs_data->config.block_size = furi_hal_flash_get_page_size();
     lfs_data->config.block_count = furi_hal_flash_get_free_page_count();
     lfs_data->config.block_cycles = furi_hal_flash_get_cycles_count();
-    lfs_data->config.cache_size = 16;
-    lfs_data->config.lookahead_size = 16;
+    lfs_data->config.lookahead_size = LFS_LOOKAHEAD_SIZE;
+
+    const bool low_wear = furi_hal_rtc_get_storage_mode() == FuriHalRtcStorageModeLowWear;
+#if LFS_VERSION >= 0x00020009
+    lfs_data->config.cache_size = LFS_CACHE_SIZE;
+    lfs_data->config.inline_max = low_wear ? LFS_CACHE_SIZE : LFS_INLINE_MAX_DEFAULT;
+#else
+    // Inline limit follows cache size
+    lfs_data->config.cache_size = low_wear ? LFS_CACHE_SIZE : LFS_INLINE_MAX_DEFAULT;
+#endif
+    if(low_wear) {
+        lfs_data->batch = malloc(LFS_BATCH_SIZE);
+    }
 
     return lfs_data;
 }
@@ -408,6 +500,7 @@ static uint16_t
     if(file->error_id == FSE_OK) {
         bytes_written = file->internal_error_id;
         file->internal_error_id = 0;
+        lfs_data_get_from_storage(storage)->stats.write_bytes += bytes_written;
     }
     return bytes_written;
 }
@@ -699,6 +792,10 @@ static bool storage_int_common_equivalent_path(const char* path1, const char* pa
     return strcmp(path1, path2) == 0;
 }
 
+static void storage_int_tick(StorageData* storage) {
+    storage_int_device_flush(lfs_data_get_from_storage(storage));
+}
+
 /******************* Init Storage *******************/
 static const FS_Api fs_api = {
     .file =
@@ -744,10 +841,25 @@ void storage_int_init(StorageData* storage) {
         lfs_data->config.block_size,
         lfs_data->config.block_count,
         lfs_data->config.block_cycles);
+    if(lfs_data->batch) {
+        FURI_LOG_I(TAG, "Low wear mode");
+    }
 
     storage_int_lfs_mount(lfs_data, storage);
 
     storage->data = lfs_data;
-    storage->api.tick = NULL;
+    storage->api.tick = lfs_data->batch ? storage_int_tick : NULL;
     storage->fs_api = &fs_api;
+
+    storage_int_lfs_data = lfs_data;
+}
+
+void storage_int_get_stats(StorageIntStats* stats) {
+    furi_check(stats);
+
+    if(storage_int_lfs_data) {
+        *stats = storage_int_lfs_data->stats;
+    } else {
+        memset(stats, 0, sizeof(StorageIntStats));
+    }
 }
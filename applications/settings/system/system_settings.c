@@ -208,6 +208,19 @@ static void filename_scheme_changed(VariableItem* item) {
     }
 }
 
+const char* const storage_mode_text[] = {
+    "Default",
+    "Low Wear",
+};
+
+static void storage_mode_changed(VariableItem* item) {
+    uint8_t index = variable_item_get_current_value_index(item);
+    variable_item_set_current_value_text(item, storage_mode_text[index]);
+    // Internal storage is configured at boot
+    furi_hal_rtc_set_storage_mode(
+        index ? FuriHalRtcStorageModeLowWear : FuriHalRtcStorageModeDefault);
+}
+
 static uint32_t system_settings_exit(void* context) {
     UNUSED(context);
     return VIEW_NONE;
@@ -315,6 +328,16 @@ SystemSettings* system_settings_alloc(void) {
     variable_item_set_current_value_index(item, value_index);
     variable_item_set_current_value_text(item, filename_scheme[value_index]);
 
+    item = variable_item_list_add(
+        app->var_item_list,
+        "Int. Storage",
+        COUNT_OF(storage_mode_text),
+        storage_mode_changed,
+        app);
+    value_index = furi_hal_rtc_get_storage_mode() == FuriHalRtcStorageModeLowWear ? 1 : 0;
+    variable_item_set_current_value_index(item, value_index);
+    variable_item_set_current_value_text(item, storage_mode_text[value_index]);
+
     view_set_previous_callback(
         variable_item_list_get_view(app->var_item_list), system_settings_exit);
     view_dispatcher_add_view(
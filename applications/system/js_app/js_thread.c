@@ -1,6 +1,8 @@
 #include <common/cs_dbg.h>
 #include <toolbox/path.h>
 #include <toolbox/stream/file_stream.h>
+#include <toolbox/version.h>
+#include <toolbox/crc.h>
 #include <loader/firmware_api/firmware_api.h>
 #include <flipper_application/api_hashtable/api_hashtable.h>
 #include <flipper_application/plugins/composite_resolver.h>
@@ -12,6 +14,8 @@
 
 #define TAG "JS"
 
+#define JS_JSC_CACHE_DIR APP_DATA_PATH("cache")
+
 struct JsThread {
     FuriThread* thread;
     FuriString* path;
@@ -101,6 +105,7 @@ static void js_exit_flag_poll(struct mjs* mjs) {
 }
 
 bool js_delay_with_flags(struct mjs* mjs, uint32_t time) {
+    mjs_gc_idle(mjs, false);
     uint32_t flags = furi_thread_flags_wait(ThreadEventStop, FuriFlagWaitAny, time);
     if(flags & FuriFlagError) {
         return false;
@@ -123,6 +128,7 @@ uint32_t js_flags_wait(struct mjs* mjs, uint32_t flags_mask, uint32_t timeout) {
     uint32_t flags = furi_thread_flags_get();
     furi_check((flags & FuriFlagError) == 0);
     if(flags == 0) {
+        mjs_gc_idle(mjs, false);
         flags = furi_thread_flags_wait(flags_mask, FuriFlagWaitAny, timeout);
     } else {
         uint32_t state = furi_thread_flags_clear(flags & flags_mask);
@@ -154,7 +160,11 @@ static void js_delay(struct mjs* mjs) {
         mjs_return(mjs, MJS_UNDEFINED);
         return;
     }
-    js_delay_with_flags(mjs, ms);
+    // Script is idle, collect garbage now rather than in the middle of its work
+    uint32_t start = furi_get_tick();
+    mjs_gc_idle(mjs, true);
+    uint32_t elapsed = furi_get_tick() - start;
+    js_delay_with_flags(mjs, (uint32_t)ms > elapsed ? ms - elapsed : 0);
     mjs_return(mjs, MJS_UNDEFINED);
 }
 
@@ -311,6 +321,18 @@ static void js_dump_write_callback(void* ctx, const char* format, ...) {
 }
 #endif
 
+// Bytecode is only valid for the firmware build that wrote it
+static uint32_t js_thread_get_build_id(void) {
+    const char* githash = version_get_githash(NULL);
+    const char* builddate = version_get_builddate(NULL);
+    uint32_t crc = crc32_update(UINT32_MAX, githash, strlen(githash));
+    return crc32_update(crc, builddate, strlen(builddate));
+}
+
+static uint32_t js_thread_gc_clock(void) {
+    return furi_hal_cortex_timer_get(0).start;
+}
+
 static int32_t js_thread(void* arg) {
     JsThread* worker = arg;
     worker->resolver = composite_api_resolver_alloc();
@@ -318,6 +340,11 @@ static int32_t js_thread(void* arg) {
     composite_api_resolver_add(worker->resolver, application_api_interface);
 
     struct mjs* mjs = mjs_create(worker);
+    // Cache script bytecode in app data, so it is not parsed on every launch
+    mjs_set_generate_jsc(mjs, 1);
+    mjs_set_jsc_cache(mjs, JS_JSC_CACHE_DIR, js_thread_get_build_id());
+    mjs_gc_set_incremental(mjs, 1);
+    mjs_gc_set_clock(mjs, js_thread_gc_clock, furi_hal_cortex_instructions_per_microsecond());
     worker->modules = js_modules_create(mjs, worker->resolver);
     mjs_val_t global = mjs_get_global(mjs);
     if(worker->path) {
@@ -10,6 +10,7 @@
 #include <mjs_util_public.h>
 #include <mjs_primitive_public.h>
 #include <mjs_array_buf_public.h>
+#include <mjs_gc_public.h>
 
 #define INST_PROP_NAME "_"
 
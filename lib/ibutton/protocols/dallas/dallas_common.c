@@ -82,11 +82,14 @@ bool dallas_common_copy_scratchpad(
 }
 
 bool dallas_common_read_mem(OneWireHost* host, uint16_t address, uint8_t* data, size_t data_size) {
-    onewire_host_write(host, DALLAS_COMMON_CMD_READ_MEM);
-
-    onewire_host_write(host, (uint8_t)address);
-    onewire_host_write(host, (uint8_t)(address >> BITS_IN_BYTE));
-
+    const uint8_t read_mem_cmd[] = {
+        DALLAS_COMMON_CMD_READ_MEM,
+        (uint8_t)address,
+        (uint8_t)(address >> BITS_IN_BYTE),
+    };
+
+    // Whole memory goes in one block transfer, device auto-increments the address
+    onewire_host_write_bytes(host, read_mem_cmd, sizeof(read_mem_cmd));
     onewire_host_read_bytes(host, data, (uint16_t)data_size);
 
     return true;
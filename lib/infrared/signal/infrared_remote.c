@@ -0,0 +1,884 @@
+#include "infrared_remote.h"
+
+#include <m-array.h>
+
+#include <toolbox/m_cstr_dup.h>
+#include <toolbox/crc32_calc.h>
+#include <toolbox/path.h>
+#include <toolbox/stream/stream.h>
+#include <storage/storage.h>
+#include <flipper_format/flipper_format_i.h>
+
+#define TAG "InfraredRemote"
+
+#define INFRARED_FILE_HEADER    "IR signals file"
+#define INFRARED_LIBRARY_HEADER "IR library file"
+#define INFRARED_FILE_VERSION   (1)
+
+#define INFRARED_SIGNAL_NAME_KEY  "name"
+#define INFRARED_GENERATION_KEY   "Generation"
+#define INFRARED_COPY_BUFFER_SIZE (64U)
+#define INFRARED_CRC_BUFFER_SIZE  (512U)
+
+/*
+ * Edits are not applied to the remote file right away. Inserted signals are appended to it,
+ * and the edit itself is appended to a journal next to it. The remote file gets rewritten in
+ * the right order only when the journal is compacted, which happens on a number of pending
+ * edits, before the remote is closed, and on load if a previous session left a journal behind.
+ *
+ * Compacted file gets a generation number right after its header, one more than the file it
+ * replaces. Journal keeps the generation, size and CRC of the remote file it was started on
+ * and is only replayed onto the same generation of a file that still begins with exactly
+ * these bytes. Compaction renames the new file over the old one before removing the
+ * journal, and a journal left behind by an interrupted compaction is older than the file,
+ * so it is skipped instead of applying its edits twice.
+ */
+#define INFRARED_JOURNAL_HEADER    "IR edit journal"
+#define INFRARED_JOURNAL_VERSION   (3)
+#define INFRARED_JOURNAL_SUFFIX    ".journal"
+#define INFRARED_JOURNAL_EDITS_MAX (64U)
+
+#define INFRARED_JOURNAL_SIZE_KEY   "Size"
+#define INFRARED_JOURNAL_CRC_KEY    "Crc"
+#define INFRARED_JOURNAL_EDIT_KEY   "Edit"
+#define INFRARED_JOURNAL_INDEX_KEY  "Index"
+#define INFRARED_JOURNAL_TARGET_KEY "Target"
+#define INFRARED_JOURNAL_NAME_KEY   "Name"
+
+#define INFRARED_JOURNAL_EDIT_INSERT "Insert"
+#define INFRARED_JOURNAL_EDIT_RENAME "Rename"
+#define INFRARED_JOURNAL_EDIT_MOVE   "Move"
+#define INFRARED_JOURNAL_EDIT_DELETE "Delete"
+
+/* Signal location in the remote file, from the line after its name to its last line */
+typedef struct {
+    size_t start;
+    size_t end;
+} InfraredSignalRange;
+
+ARRAY_DEF(StringArray, const char*, M_CSTR_DUP_OPLIST); //-V575
+ARRAY_DEF(SignalRangeArray, InfraredSignalRange, M_POD_OPLIST); //-V658
+
+struct InfraredRemote {
+    StringArray_t signal_names;
+    SignalRangeArray_t signal_ranges;
+    FuriString* name;
+    FuriString* path;
+    uint32_t generation;
+    bool journal_active;
+    size_t journal_edits;
+};
+
+InfraredRemote* infrared_remote_alloc(void) {
+    InfraredRemote* remote = malloc(sizeof(InfraredRemote));
+    StringArray_init(remote->signal_names);
+    SignalRangeArray_init(remote->signal_ranges);
+    remote->name = furi_string_alloc();
+    remote->path = furi_string_alloc();
+    remote->generation = 0;
+    remote->journal_active = false;
+    remote->journal_edits = 0;
+    return remote;
+}
+
+void infrared_remote_free(InfraredRemote* remote) {
+    infrared_remote_compact(remote);
+
+    SignalRangeArray_clear(remote->signal_ranges);
+    StringArray_clear(remote->signal_names);
+    furi_string_free(remote->path);
+    furi_string_free(remote->name);
+    free(remote);
+}
+
+void infrared_remote_reset(InfraredRemote* remote) {
+    StringArray_reset(remote->signal_names);
+    SignalRangeArray_reset(remote->signal_ranges);
+    furi_string_reset(remote->name);
+    furi_string_reset(remote->path);
+    remote->generation = 0;
+    remote->journal_active = false;
+    remote->journal_edits = 0;
+}
+
+const char* infrared_remote_get_name(const InfraredRemote* remote) {
+    return furi_string_get_cstr(remote->name);
+}
+
+static void infrared_remote_set_path(InfraredRemote* remote, const char* path) {
+    furi_string_set(remote->path, path);
+    path_extract_filename(remote->path, remote->name, true);
+}
+
+const char* infrared_remote_get_path(const InfraredRemote* remote) {
+    return furi_string_get_cstr(remote->path);
+}
+
+size_t infrared_remote_get_signal_count(const InfraredRemote* remote) {
+    return StringArray_size(remote->signal_names);
+}
+
+const char* infrared_remote_get_signal_name(const InfraredRemote* remote, size_t index) {
+    furi_assert(index < infrared_remote_get_signal_count(remote));
+    return *StringArray_cget(remote->signal_names, index);
+}
+
+static void infrared_remote_get_journal_path(const InfraredRemote* remote, FuriString* path) {
+    furi_string_printf(path, "%s" INFRARED_JOURNAL_SUFFIX, furi_string_get_cstr(remote->path));
+}
+
+/* Calculate CRC of the first size bytes of a file, fails if the file is shorter */
+static bool infrared_remote_get_file_crc(const char* path, uint32_t size, uint32_t* crc) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* file = storage_file_alloc(storage);
+    uint8_t* buffer = malloc(INFRARED_CRC_BUFFER_SIZE);
+
+    bool success = storage_file_open(file, path, FSAM_READ, FSOM_OPEN_EXISTING);
+    *crc = 0;
+
+    for(uint32_t offset = 0; success && offset < size;) {
+        const size_t chunk_size = MIN(size - offset, INFRARED_CRC_BUFFER_SIZE);
+        success = storage_file_read(file, buffer, chunk_size) == chunk_size;
+        *crc = crc32_calc_buffer(*crc, buffer, chunk_size);
+        offset += chunk_size;
+    }
+
+    free(buffer);
+    storage_file_free(file);
+    furi_record_close(RECORD_STORAGE);
+
+    return success;
+}
+
+/* Read generation number that follows the file header, files without one are generation 0 */
+static uint32_t infrared_remote_read_generation(Stream* stream, FuriString* line) {
+    const size_t offset = stream_tell(stream);
+    uint32_t generation = 0;
+
+    if(stream_read_line(stream, line) &&
+       furi_string_start_with_str(line, INFRARED_GENERATION_KEY ":")) {
+        furi_string_right(line, strlen(INFRARED_GENERATION_KEY ":"));
+        furi_string_trim(line);
+        generation = strtoul(furi_string_get_cstr(line), NULL, 10);
+    } else {
+        stream_seek(stream, offset, StreamOffsetFromStart);
+    }
+
+    return generation;
+}
+
+/* Add all signals from the current stream position on to the index */
+static void infrared_remote_index_signals(InfraredRemote* remote, Stream* stream) {
+    FuriString* line = furi_string_alloc();
+    InfraredSignalRange range = {};
+    bool signal_found = false;
+
+    while(stream_read_line(stream, line)) {
+        const size_t line_end = stream_tell(stream);
+
+        furi_string_trim(line);
+        if(furi_string_empty(line) || furi_string_start_with_str(line, "#")) continue;
+
+        if(furi_string_start_with_str(line, INFRARED_SIGNAL_NAME_KEY ":")) {
+            if(signal_found) SignalRangeArray_push_back(remote->signal_ranges, range);
+
+            furi_string_right(line, strlen(INFRARED_SIGNAL_NAME_KEY ":"));
+            furi_string_trim(line);
+            StringArray_push_back(remote->signal_names, furi_string_get_cstr(line));
+
+            range.start = line_end;
+            range.end = line_end;
+            signal_found = true;
+        } else {
+            range.end = line_end;
+        }
+    }
+
+    if(signal_found) SignalRangeArray_push_back(remote->signal_ranges, range);
+
+    furi_string_free(line);
+}
+
+static void infrared_remote_move_entry(InfraredRemote* remote, size_t index, size_t new_index) {
+    char* signal_name = strdup(*StringArray_cget(remote->signal_names, index));
+    const InfraredSignalRange range = *SignalRangeArray_cget(remote->signal_ranges, index);
+
+    StringArray_remove_v(remote->signal_names, index, index + 1);
+    SignalRangeArray_remove_v(remote->signal_ranges, index, index + 1);
+    StringArray_push_at(remote->signal_names, new_index, signal_name);
+    SignalRangeArray_push_at(remote->signal_ranges, new_index, range);
+
+    free(signal_name);
+}
+
+InfraredErrorCode infrared_remote_load_signal(
+    const InfraredRemote* remote,
+    InfraredSignal* signal,
+    size_t index) {
+    furi_assert(index < infrared_remote_get_signal_count(remote));
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FlipperFormat* ff = flipper_format_buffered_file_alloc(storage);
+
+    InfraredErrorCode error = InfraredErrorCodeNone;
+
+    do {
+        const char* path = furi_string_get_cstr(remote->path);
+        if(!flipper_format_buffered_file_open_existing(ff, path)) {
+            error = InfraredErrorCodeFileOperationFailed;
+            break;
+        }
+
+        // Jump straight to the signal body, no need to scan the file
+        const InfraredSignalRange* range = SignalRangeArray_cget(remote->signal_ranges, index);
+        if(!stream_seek(
+               flipper_format_get_raw_stream(ff), range->start, StreamOffsetFromStart)) {
+            error = InfraredErrorCodeFileOperationFailed;
+            break;
+        }
+
+        error = infrared_signal_read_body(signal, ff);
+        if(INFRARED_ERROR_PRESENT(error)) {
+            INFRARED_ERROR_SET_INDEX(error, index);
+            const char* signal_name = infrared_remote_get_signal_name(remote, index);
+            FURI_LOG_E(TAG, "Failed to load signal '%s' from file '%s'", signal_name, path);
+            break;
+        }
+    } while(false);
+
+    flipper_format_free(ff);
+    furi_record_close(RECORD_STORAGE);
+
+    return error;
+}
+
+bool infrared_remote_get_signal_index(
+    const InfraredRemote* remote,
+    const char* name,
+    size_t* index) {
+    uint32_t i = 0;
+    StringArray_it_t it;
+
+    for(StringArray_it(it, remote->signal_names); !StringArray_end_p(it);
+        StringArray_next(it), ++i) {
+        if(strcmp(*StringArray_cref(it), name) == 0) {
+            *index = i;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/* Append a signal to the end of the remote file and of the index */
+static InfraredErrorCode infrared_remote_write_signal(
+    InfraredRemote* remote,
+    const InfraredSignal* signal,
+    const char* name) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FlipperFormat* ff = flipper_format_file_alloc(storage);
+
+    InfraredErrorCode error = InfraredErrorCodeNone;
+    const char* path = furi_string_get_cstr(remote->path);
+
+    do {
+        if(!flipper_format_file_open_append(ff, path)) {
+            error = InfraredErrorCodeFileOperationFailed;
+            break;
+        }
+
+        Stream* stream = flipper_format_get_raw_stream(ff);
+        const size_t signal_offset = stream_size(stream);
+
+        error = infrared_signal_save(signal, ff, name);
+        if(INFRARED_ERROR_PRESENT(error)) break;
+
+        if(!stream_seek(stream, signal_offset, StreamOffsetFromStart)) {
+            error = InfraredErrorCodeFileOperationFailed;
+            break;
+        }
+
+        const size_t signal_count = infrared_remote_get_signal_count(remote);
+        infrared_remote_index_signals(remote, stream);
+        if(infrared_remote_get_signal_count(remote) != signal_count + 1) {
+            error = InfraredErrorCodeFileOperationFailed;
+        }
+    } while(false);
+
+    flipper_format_free(ff);
+    furi_record_close(RECORD_STORAGE);
+
+    return error;
+}
+
+static InfraredErrorCode infrared_remote_journal_open(InfraredRemote* remote, FlipperFormat* ff) {
+    FuriString* journal_path = furi_string_alloc();
+    infrared_remote_get_journal_path(remote, journal_path);
+    const char* path = furi_string_get_cstr(journal_path);
+
+    bool success = false;
+
+    do {
+        if(remote->journal_active) {
+            success = flipper_format_file_open_append(ff, path);
+            break;
+        }
+
+        // New journal remembers the remote file size, signals past it come from the journal
+        const char* remote_path = furi_string_get_cstr(remote->path);
+        Storage* storage = furi_record_open(RECORD_STORAGE);
+        FileInfo file_info;
+        const FS_Error status = storage_common_stat(storage, remote_path, &file_info);
+        furi_record_close(RECORD_STORAGE);
+        if(status != FSE_OK) break;
+
+        const uint32_t file_size = file_info.size;
+        uint32_t file_crc;
+        if(!infrared_remote_get_file_crc(remote_path, file_size, &file_crc)) break;
+
+        if(!flipper_format_file_open_always(ff, path)) break;
+        if(!flipper_format_write_header_cstr(
+               ff, INFRARED_JOURNAL_HEADER, INFRARED_JOURNAL_VERSION))
+            break;
+        if(!flipper_format_write_uint32(ff, INFRARED_GENERATION_KEY, &remote->generation, 1))
+            break;
+        if(!flipper_format_write_uint32(ff, INFRARED_JOURNAL_SIZE_KEY, &file_size, 1)) break;
+        if(!flipper_format_write_uint32(ff, INFRARED_JOURNAL_CRC_KEY, &file_crc, 1)) break;
+
+        remote->journal_active = true;
+        success = true;
+    } while(false);
+
+    furi_string_free(journal_path);
+
+    return success ? InfraredErrorCodeNone : InfraredErrorCodeFileOperationFailed;
+}
+
+static InfraredErrorCode infrared_remote_journal_write(
+    InfraredRemote* remote,
+    const char* edit,
+    size_t index,
+    size_t target,
+    const char* name) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FlipperFormat* ff = flipper_format_file_alloc(storage);
+
+    InfraredErrorCode error = infrared_remote_journal_open(remote, ff);
+
+    if(!INFRARED_ERROR_PRESENT(error)) {
+        const uint32_t index_value = index;
+        const uint32_t target_value = target;
+
+        bool success = flipper_format_write_comment_cstr(ff, "") &&
+                       flipper_format_write_string_cstr(ff, INFRARED_JOURNAL_EDIT_KEY, edit) &&
+                       flipper_format_write_uint32(
+                           ff, INFRARED_JOURNAL_INDEX_KEY, &index_value, 1);
+        if(success && !strcmp(edit, INFRARED_JOURNAL_EDIT_MOVE)) {
+            success = flipper_format_write_uint32(
+                ff, INFRARED_JOURNAL_TARGET_KEY, &target_value, 1);
+        } else if(success && !strcmp(edit, INFRARED_JOURNAL_EDIT_RENAME)) {
+            success = flipper_format_write_string_cstr(ff, INFRARED_JOURNAL_NAME_KEY, name);
+        }
+
+        if(success) {
+            remote->journal_edits++;
+        } else {
+            error = InfraredErrorCodeFileOperationFailed;
+        }
+    }
+
+    flipper_format_free(ff);
+    furi_record_close(RECORD_STORAGE);
+
+    return error;
+}
+
+/* Apply edits left in the journal to the freshly loaded index */
+static bool infrared_remote_journal_replay(InfraredRemote* remote, FlipperFormat* ff) {
+    FuriString* tmp = furi_string_alloc();
+    StringArray_t pending_names;
+    SignalRangeArray_t pending_ranges;
+    StringArray_init(pending_names);
+    SignalRangeArray_init(pending_ranges);
+
+    bool journal_valid = false;
+    size_t edits_replayed = 0;
+
+    do {
+        uint32_t version;
+        if(!flipper_format_read_header(ff, tmp, &version)) break;
+        if(!furi_string_equal(tmp, INFRARED_JOURNAL_HEADER) ||
+           version != INFRARED_JOURNAL_VERSION)
+            break;
+
+        // Journal of an older generation was compacted in, but not removed
+        uint32_t generation;
+        if(!flipper_format_read_uint32(ff, INFRARED_GENERATION_KEY, &generation, 1)) break;
+        if(generation != remote->generation) {
+            FURI_LOG_W(
+                TAG,
+                "Journal is for generation %lu, remote is %lu",
+                generation,
+                remote->generation);
+            break;
+        }
+
+        uint32_t file_size, file_crc, crc;
+        if(!flipper_format_read_uint32(ff, INFRARED_JOURNAL_SIZE_KEY, &file_size, 1)) break;
+        if(!flipper_format_read_uint32(ff, INFRARED_JOURNAL_CRC_KEY, &file_crc, 1)) break;
+
+        // Remote must be the very file the journal was started on, only grown by inserts
+        const char* remote_path = furi_string_get_cstr(remote->path);
+        if(!infrared_remote_get_file_crc(remote_path, file_size, &crc) || crc != file_crc) {
+            FURI_LOG_W(TAG, "Journal does not match the remote file");
+            break;
+        }
+
+        // Signals appended after the journal was started are waiting to be inserted
+        size_t signal_count = infrared_remote_get_signal_count(remote);
+        while(signal_count &&
+              SignalRangeArray_cget(remote->signal_ranges, signal_count - 1)->start > file_size) {
+            signal_count--;
+        }
+        for(size_t i = signal_count; i < infrared_remote_get_signal_count(remote); ++i) {
+            StringArray_push_back(pending_names, infrared_remote_get_signal_name(remote, i));
+            SignalRangeArray_push_back(
+                pending_ranges, *SignalRangeArray_cget(remote->signal_ranges, i));
+        }
+        StringArray_resize(remote->signal_names, signal_count);
+        SignalRangeArray_resize(remote->signal_ranges, signal_count);
+
+        size_t pending_index = 0;
+        while(flipper_format_read_string(ff, INFRARED_JOURNAL_EDIT_KEY, tmp)) {
+            uint32_t index, target;
+            if(!flipper_format_read_uint32(ff, INFRARED_JOURNAL_INDEX_KEY, &index, 1)) break;
+
+            const size_t count = infrared_remote_get_signal_count(remote);
+            bool edit_valid = false;
+
+            if(furi_string_equal(tmp, INFRARED_JOURNAL_EDIT_INSERT)) {
+                if(index > count || pending_index == StringArray_size(pending_names)) break;
+                StringArray_push_at(
+                    remote->signal_names,
+                    index,
+                    *StringArray_cget(pending_names, pending_index));
+                SignalRangeArray_push_at(
+                    remote->signal_ranges,
+                    index,
+                    *SignalRangeArray_cget(pending_ranges, pending_index));
+                pending_index++;
+                edit_valid = true;
+            } else if(furi_string_equal(tmp, INFRARED_JOURNAL_EDIT_RENAME)) {
+                if(index >= count) break;
+                if(!flipper_format_read_string(ff, INFRARED_JOURNAL_NAME_KEY, tmp)) break;
+                StringArray_set_at(remote->signal_names, index, furi_string_get_cstr(tmp));
+                edit_valid = true;
+            } else if(furi_string_equal(tmp, INFRARED_JOURNAL_EDIT_MOVE)) {
+                if(!flipper_format_read_uint32(ff, INFRARED_JOURNAL_TARGET_KEY, &target, 1))
+                    break;
+                if(index >= count || target >= count) break;
+                infrared_remote_move_entry(remote, index, target);
+                edit_valid = true;
+            } else if(furi_string_equal(tmp, INFRARED_JOURNAL_EDIT_DELETE)) {
+                if(index >= count) break;
+                StringArray_remove_v(remote->signal_names, index, index + 1);
+                SignalRangeArray_remove_v(remote->signal_ranges, index, index + 1);
+                edit_valid = true;
+            }
+
+            if(!edit_valid) break;
+            edits_replayed++;
+        }
+
+        // Signals appended without a journal record stay at the end, as in the file
+        for(; pending_index < StringArray_size(pending_names); ++pending_index) {
+            StringArray_push_back(
+                remote->signal_names, *StringArray_cget(pending_names, pending_index));
+            SignalRangeArray_push_back(
+                remote->signal_ranges, *SignalRangeArray_cget(pending_ranges, pending_index));
+            edits_replayed++;
+        }
+
+        journal_valid = true;
+    } while(false);
+
+    if(journal_valid) {
+        FURI_LOG_I(TAG, "Replayed %zu edits from journal", edits_replayed);
+        remote->journal_active = true;
+        remote->journal_edits = edits_replayed;
+    }
+
+    SignalRangeArray_clear(pending_ranges);
+    StringArray_clear(pending_names);
+    furi_string_free(tmp);
+
+    return journal_valid;
+}
+
+static bool infrared_remote_copy_signal_body(
+    Stream* stream_in,
+    Stream* stream_out,
+    const InfraredSignalRange* range) {
+    uint8_t buffer[INFRARED_COPY_BUFFER_SIZE];
+    uint8_t last_char = '\n';
+
+    if(!stream_seek(stream_in, range->start, StreamOffsetFromStart)) return false;
+
+    for(size_t offset = range->start; offset < range->end;) {
+        const size_t chunk_size = MIN(range->end - offset, sizeof(buffer));
+        if(stream_read(stream_in, buffer, chunk_size) != chunk_size) return false;
+        if(stream_write(stream_out, buffer, chunk_size) != chunk_size) return false;
+        last_char = buffer[chunk_size - 1];
+        offset += chunk_size;
+    }
+
+    // Last line of the file may lack an end of line
+    return (last_char == '\n') || (stream_write_char(stream_out, '\n') == 1);
+}
+
+InfraredErrorCode infrared_remote_compact(InfraredRemote* remote) {
+    if(!remote->journal_active) return InfraredErrorCodeNone;
+
+    FuriString* tmp = furi_string_alloc();
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FlipperFormat* ff_in = flipper_format_buffered_file_alloc(storage);
+    FlipperFormat* ff_out = flipper_format_buffered_file_alloc(storage);
+
+    SignalRangeArray_t new_ranges;
+    SignalRangeArray_init(new_ranges);
+
+    const char* path_in = furi_string_get_cstr(remote->path);
+    const char* path_out;
+
+    FS_Error status;
+
+    do {
+        furi_string_printf(tmp, "%s.temp%08x.swp", path_in, rand());
+        path_out = furi_string_get_cstr(tmp);
+        status = storage_common_stat(storage, path_out, NULL);
+    } while(status == FSE_OK || status == FSE_EXIST);
+
+    InfraredErrorCode error = InfraredErrorCodeNone;
+    const uint32_t generation = remote->generation + 1;
+
+    do {
+        if(!flipper_format_buffered_file_open_existing(ff_in, path_in) ||
+           !flipper_format_buffered_file_open_always(ff_out, path_out) ||
+           !flipper_format_write_header_cstr(
+               ff_out, INFRARED_FILE_HEADER, INFRARED_FILE_VERSION) ||
+           !flipper_format_write_uint32(ff_out, INFRARED_GENERATION_KEY, &generation, 1)) {
+            error = InfraredErrorCodeFileOperationFailed;
+            break;
+        }
+
+        Stream* stream_in = flipper_format_get_raw_stream(ff_in);
+        Stream* stream_out = flipper_format_get_raw_stream(ff_out);
+        const size_t signal_count = infrared_remote_get_signal_count(remote);
+
+        // Signal bodies are copied as is, only the names are written anew
+        for(size_t i = 0; i < signal_count; ++i) {
+            const char* signal_name = infrared_remote_get_signal_name(remote, i);
+            if(!flipper_format_write_comment_cstr(ff_out, "") ||
+               !flipper_format_write_string_cstr(ff_out, INFRARED_SIGNAL_NAME_KEY, signal_name)) {
+                error = InfraredErrorCodeFileOperationFailed;
+            } else {
+                InfraredSignalRange* range = SignalRangeArray_push_new(new_ranges);
+                range->start = stream_tell(stream_out);
+                if(!infrared_remote_copy_signal_body(
+                       stream_in, stream_out, SignalRangeArray_cget(remote->signal_ranges, i))) {
+                    error = InfraredErrorCodeFileOperationFailed;
+                }
+                range->end = stream_tell(stream_out);
+            }
+
+            if(INFRARED_ERROR_PRESENT(error)) {
+                INFRARED_ERROR_SET_INDEX(error, i);
+                break;
+            }
+        }
+        if(INFRARED_ERROR_PRESENT(error)) break;
+
+        if(!flipper_format_buffered_file_close(ff_out) ||
+           !flipper_format_buffered_file_close(ff_in)) {
+            error = InfraredErrorCodeFileOperationFailed;
+            break;
+        }
+
+        // Until the rename the journal still applies to the old file
+        status = storage_common_rename(storage, path_out, path_in);
+        if(status != FSE_OK && status != FSE_EXIST) {
+            // Edits are still in the index, next compaction writes them out
+            error = InfraredErrorCodeFileOperationFailed;
+            break;
+        }
+
+        SignalRangeArray_swap(remote->signal_ranges, new_ranges);
+        remote->generation = generation;
+        remote->journal_active = false;
+        remote->journal_edits = 0;
+
+        // Journal is of the previous generation now, it is skipped on load if it stays
+        FuriString* journal_path = furi_string_alloc();
+        infrared_remote_get_journal_path(remote, journal_path);
+        status = storage_common_remove(storage, furi_string_get_cstr(journal_path));
+        furi_string_free(journal_path);
+        if(status != FSE_OK && status != FSE_NOT_EXIST) {
+            FURI_LOG_W(TAG, "Failed to remove journal");
+        }
+    } while(false);
+
+    if(INFRARED_ERROR_PRESENT(error)) {
+        // Edits are retried on the next compaction, or on load if the journal is still there
+        flipper_format_buffered_file_close(ff_out);
+        flipper_format_buffered_file_close(ff_in);
+        status = storage_common_stat(storage, path_out, NULL);
+        if(status == FSE_OK || status == FSE_EXIST) storage_common_remove(storage, path_out);
+    }
+
+    SignalRangeArray_clear(new_ranges);
+    flipper_format_free(ff_out);
+    flipper_format_free(ff_in);
+    furi_record_close(RECORD_STORAGE);
+    furi_string_free(tmp);
+
+    return error;
+}
+
+static InfraredErrorCode infrared_remote_journal_commit(InfraredRemote* remote) {
+    if(remote->journal_edits < INFRARED_JOURNAL_EDITS_MAX) return InfraredErrorCodeNone;
+    return infrared_remote_compact(remote);
+}
+
+InfraredErrorCode infrared_remote_append_signal(
+    InfraredRemote* remote,
+    const InfraredSignal* signal,
+    const char* name) {
+    return infrared_remote_insert_signal(
+        remote, signal, name, infrared_remote_get_signal_count(remote));
+}
+
+InfraredErrorCode infrared_remote_insert_signal(
+    InfraredRemote* remote,
+    const InfraredSignal* signal,
+    const char* name,
+    size_t index) {
+    const size_t signal_count = infrared_remote_get_signal_count(remote);
+
+    // Appending to a file without pending edits keeps it in order, no journal needed
+    if(index >= signal_count && !remote->journal_active) {
+        return infrared_remote_write_signal(remote, signal, name);
+    }
+
+    index = MIN(index, signal_count);
+
+    InfraredErrorCode error = InfraredErrorCodeNone;
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FlipperFormat* ff = flipper_format_file_alloc(storage);
+
+    do {
+        // Journal must be started before the remote file grows
+        if(!remote->journal_active) {
+            error = infrared_remote_journal_open(remote, ff);
+            flipper_format_file_close(ff);
+            if(INFRARED_ERROR_PRESENT(error)) break;
+        }
+
+        error = infrared_remote_write_signal(remote, signal, name);
+        if(INFRARED_ERROR_PRESENT(error)) break;
+
+        // Signal stays at the end of the file until compaction, the journal knows where it goes
+        error = infrared_remote_journal_write(
+            remote, INFRARED_JOURNAL_EDIT_INSERT, index, 0, NULL);
+        if(INFRARED_ERROR_PRESENT(error)) break;
+
+        infrared_remote_move_entry(remote, signal_count, index);
+        error = infrared_remote_journal_commit(remote);
+    } while(false);
+
+    flipper_format_free(ff);
+    furi_record_close(RECORD_STORAGE);
+
+    return error;
+}
+
+InfraredErrorCode
+    infrared_remote_rename_signal(InfraredRemote* remote, size_t index, const char* new_name) {
+    furi_assert(index < infrared_remote_get_signal_count(remote));
+
+    InfraredErrorCode error =
+        infrared_remote_journal_write(remote, INFRARED_JOURNAL_EDIT_RENAME, index, 0, new_name);
+    if(INFRARED_ERROR_PRESENT(error)) return error;
+
+    StringArray_set_at(remote->signal_names, index, new_name);
+
+    return infrared_remote_journal_commit(remote);
+}
+
+InfraredErrorCode infrared_remote_delete_signal(InfraredRemote* remote, size_t index) {
+    furi_assert(index < infrared_remote_get_signal_count(remote));
+
+    InfraredErrorCode error =
+        infrared_remote_journal_write(remote, INFRARED_JOURNAL_EDIT_DELETE, index, 0, NULL);
+    if(INFRARED_ERROR_PRESENT(error)) return error;
+
+    // Signal data stays in the file until compaction, but is no longer indexed
+    StringArray_remove_v(remote->signal_names, index, index + 1);
+    SignalRangeArray_remove_v(remote->signal_ranges, index, index + 1);
+
+    return infrared_remote_journal_commit(remote);
+}
+
+InfraredErrorCode
+    infrared_remote_move_signal(InfraredRemote* remote, size_t index, size_t new_index) {
+    const size_t signal_count = infrared_remote_get_signal_count(remote);
+    furi_assert(index < signal_count);
+    furi_assert(new_index < signal_count);
+
+    if(index == new_index) return InfraredErrorCodeNone;
+
+    InfraredErrorCode error =
+        infrared_remote_journal_write(remote, INFRARED_JOURNAL_EDIT_MOVE, index, new_index, NULL);
+    if(INFRARED_ERROR_PRESENT(error)) return error;
+
+    infrared_remote_move_entry(remote, index, new_index);
+
+    return infrared_remote_journal_commit(remote);
+}
+
+InfraredErrorCode infrared_remote_create(InfraredRemote* remote, const char* path) {
+    FURI_LOG_I(TAG, "Creating new file: '%s'", path);
+
+    infrared_remote_compact(remote);
+    infrared_remote_reset(remote);
+    infrared_remote_set_path(remote, path);
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FlipperFormat* ff = flipper_format_file_alloc(storage);
+
+    bool success = false;
+
+    do {
+        if(!flipper_format_file_open_always(ff, path)) break;
+        if(!flipper_format_write_header_cstr(ff, INFRARED_FILE_HEADER, INFRARED_FILE_VERSION))
+            break;
+
+        success = true;
+    } while(false);
+
+    flipper_format_free(ff);
+    furi_record_close(RECORD_STORAGE);
+
+    return success ? InfraredErrorCodeNone : InfraredErrorCodeFileOperationFailed;
+}
+
+InfraredErrorCode infrared_remote_load(InfraredRemote* remote, const char* path) {
+    FURI_LOG_I(TAG, "Loading file: '%s'", path);
+
+    infrared_remote_compact(remote);
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FlipperFormat* ff = flipper_format_buffered_file_alloc(storage);
+
+    FuriString* tmp = furi_string_alloc();
+    InfraredErrorCode error = InfraredErrorCodeNone;
+
+    do {
+        if(!flipper_format_buffered_file_open_existing(ff, path)) {
+            error = InfraredErrorCodeFileOperationFailed;
+            break;
+        }
+
+        uint32_t version;
+        if(!flipper_format_read_header(ff, tmp, &version)) {
+            error = InfraredErrorCodeFileOperationFailed;
+            break;
+        }
+
+        if(furi_string_equal(tmp, INFRARED_LIBRARY_HEADER)) {
+            FURI_LOG_E(TAG, "Library file can't be loaded in this context");
+            error = InfraredErrorCodeWrongFileType;
+            break;
+        }
+
+        if(!furi_string_equal(tmp, INFRARED_FILE_HEADER)) {
+            error = InfraredErrorCodeWrongFileType;
+            FURI_LOG_E(TAG, "Filetype unknown");
+            break;
+        }
+
+        if(version != INFRARED_FILE_VERSION) {
+            error = InfraredErrorCodeWrongFileVersion;
+            FURI_LOG_E(TAG, "Wrong file version");
+            break;
+        }
+
+        infrared_remote_reset(remote);
+        infrared_remote_set_path(remote, path);
+        Stream* stream = flipper_format_get_raw_stream(ff);
+        remote->generation = infrared_remote_read_generation(stream, tmp);
+        infrared_remote_index_signals(remote, stream);
+
+        // Edits left over from a session that did not finish compaction
+        infrared_remote_get_journal_path(remote, tmp);
+        const char* journal_path = furi_string_get_cstr(tmp);
+        if(!storage_file_exists(storage, journal_path)) break;
+
+        flipper_format_buffered_file_close(ff);
+        const bool journal_valid = flipper_format_buffered_file_open_existing(ff, journal_path) &&
+                                   infrared_remote_journal_replay(remote, ff);
+        flipper_format_buffered_file_close(ff);
+
+        if(journal_valid) {
+            error = infrared_remote_compact(remote);
+        } else {
+            FURI_LOG_W(TAG, "Discarding invalid journal");
+            storage_common_remove(storage, journal_path);
+        }
+    } while(false);
+
+    furi_string_free(tmp);
+    flipper_format_free(ff);
+    furi_record_close(RECORD_STORAGE);
+
+    return error;
+}
+
+InfraredErrorCode infrared_remote_rename(InfraredRemote* remote, const char* new_path) {
+    // Journal is named after the remote file, no point in moving it along
+    InfraredErrorCode error = infrared_remote_compact(remote);
+    if(INFRARED_ERROR_PRESENT(error)) return error;
+
+    const char* old_path = infrared_remote_get_path(remote);
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    const FS_Error status = storage_common_rename(storage, old_path, new_path);
+    furi_record_close(RECORD_STORAGE);
+
+    const bool success = (status == FSE_OK || status == FSE_EXIST);
+
+    if(success) {
+        infrared_remote_set_path(remote, new_path);
+    }
+
+    return success ? InfraredErrorCodeNone : InfraredErrorCodeFileOperationFailed;
+}
+
+InfraredErrorCode infrared_remote_remove(InfraredRemote* remote) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+
+    FuriString* journal_path = furi_string_alloc();
+    infrared_remote_get_journal_path(remote, journal_path);
+    storage_common_remove(storage, furi_string_get_cstr(journal_path));
+    furi_string_free(journal_path);
+
+    const FS_Error status = storage_common_remove(storage, infrared_remote_get_path(remote));
+    furi_record_close(RECORD_STORAGE);
+
+    const bool success = (status == FSE_OK || status == FSE_NOT_EXIST);
+
+    if(success) {
+        infrared_remote_reset(remote);
+    }
+
+    return success ? InfraredErrorCodeNone : InfraredErrorCodeFileOperationFailed;
+}
@@ -5,14 +5,28 @@
  * An infrared remote contains zero or more infrared signals which
  * have a (possibly non-unique) name each.
  *
- * The current implementation does load only the names into the memory,
+ * The current implementation does load only the names and file offsets into the memory,
  * while the signals themselves are loaded on-demand one by one. In theory,
  * this should allow for quite large remotes with relatively bulky signals.
+ *
+ * Edits (insertions, renames, moves and deletions) do not rewrite the file. Instead, they
+ * are recorded in a journal file next to it and applied in one pass by
+ * infrared_remote_compact(), which runs automatically once enough edits pile up and when
+ * the instance is freed or associated with another file.
+ *
+ * Until then, the file on disk is not in its final order and may still hold renamed, moved
+ * or deleted signals in their old state. Other readers of the file (Archive, RPC, CLI) only
+ * see the edits once it is compacted, which the Infrared app does at the latest on exit
+ * when it frees its remote.
  */
 #pragma once
 
 #include "infrared_signal.h"
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 /**
  * @brief InfraredRemote opaque type declaration.
  */
@@ -231,3 +245,19 @@ InfraredErrorCode infrared_remote_rename(InfraredRemote* remote, const char* new
  * @returns InfraredErrorCodeNone if the file was successfully removed, otherwise error code.
  */
 InfraredErrorCode infrared_remote_remove(InfraredRemote* remote);
+
+/**
+ * @brief Apply all pending edits to the file associated with an InfraredRemote instance.
+ *
+ * The file is rewritten in the current signal order and the journal is removed.
+ * Does nothing if there are no pending edits.
+ *
+ * @param[in,out] remote pointer to the instance to be compacted.
+ * @returns InfraredErrorCodeNone if the file was successfully compacted, otherwise error
+ * code describing what error happened ORed with index pointing which signal caused an error.
+ */
+InfraredErrorCode infrared_remote_compact(InfraredRemote* remote);
+
+#ifdef __cplusplus
+}
+#endif
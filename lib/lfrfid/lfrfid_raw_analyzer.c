@@ -0,0 +1,176 @@
+#include "lfrfid_raw_analyzer.h"
+#include <furi.h>
+#include <furi_hal_cortex.h>
+
+// Distinct results kept per capture, more would mean the capture is just noise
+#define LFRFID_RAW_ANALYZER_CANDIDATES 4
+
+typedef struct {
+    ProtocolId protocol;
+    uint32_t count;
+    uint8_t* data;
+} LFRFIDRawAnalyzerCandidate;
+
+struct LFRFIDRawAnalyzer {
+    ProtocolDict* dict;
+    size_t data_size;
+    uint8_t* data;
+
+    uint32_t window_us;
+    uint32_t window_time;
+    bool window_decoded;
+
+    LFRFIDRawAnalyzerCandidate candidates[LFRFID_RAW_ANALYZER_CANDIDATES];
+    LFRFIDRawAnalyzerStats stats;
+    uint64_t decode_ticks;
+};
+
+LFRFIDRawAnalyzer* lfrfid_raw_analyzer_alloc(ProtocolDict* dict) {
+    furi_check(dict);
+
+    LFRFIDRawAnalyzer* analyzer = malloc(sizeof(LFRFIDRawAnalyzer));
+    analyzer->dict = dict;
+    analyzer->data_size = protocol_dict_get_max_data_size(dict);
+    analyzer->data = malloc(analyzer->data_size);
+    for(size_t i = 0; i < LFRFID_RAW_ANALYZER_CANDIDATES; i++) {
+        analyzer->candidates[i].data = malloc(analyzer->data_size);
+    }
+    analyzer->window_us = LFRFID_RAW_ANALYZER_WINDOW_DEFAULT_US;
+    lfrfid_raw_analyzer_reset(analyzer);
+
+    return analyzer;
+}
+
+void lfrfid_raw_analyzer_free(LFRFIDRawAnalyzer* analyzer) {
+    furi_check(analyzer);
+
+    for(size_t i = 0; i < LFRFID_RAW_ANALYZER_CANDIDATES; i++) {
+        free(analyzer->candidates[i].data);
+    }
+    free(analyzer->data);
+    free(analyzer);
+}
+
+void lfrfid_raw_analyzer_set_window(LFRFIDRawAnalyzer* analyzer, uint32_t window_us) {
+    furi_check(analyzer);
+    furi_check(window_us);
+    analyzer->window_us = window_us;
+}
+
+void lfrfid_raw_analyzer_reset(LFRFIDRawAnalyzer* analyzer) {
+    furi_check(analyzer);
+
+    for(size_t i = 0; i < LFRFID_RAW_ANALYZER_CANDIDATES; i++) {
+        analyzer->candidates[i].protocol = PROTOCOL_NO;
+        analyzer->candidates[i].count = 0;
+    }
+    memset(&analyzer->stats, 0, sizeof(LFRFIDRawAnalyzerStats));
+    analyzer->decode_ticks = 0;
+    analyzer->window_time = 0;
+    analyzer->window_decoded = false;
+}
+
+static void lfrfid_raw_analyzer_add_candidate(LFRFIDRawAnalyzer* analyzer, ProtocolId protocol) {
+    size_t data_size = protocol_dict_get_data_size(analyzer->dict, protocol);
+    protocol_dict_get_data(analyzer->dict, protocol, analyzer->data, data_size);
+
+    for(size_t i = 0; i < LFRFID_RAW_ANALYZER_CANDIDATES; i++) {
+        LFRFIDRawAnalyzerCandidate* candidate = &analyzer->candidates[i];
+        if(candidate->protocol == PROTOCOL_NO) {
+            candidate->protocol = protocol;
+            memcpy(candidate->data, analyzer->data, data_size);
+        } else if(
+            candidate->protocol != protocol ||
+            memcmp(candidate->data, analyzer->data, data_size) != 0) {
+            continue;
+        }
+        candidate->count++;
+        break;
+    }
+}
+
+void lfrfid_raw_analyzer_feed(LFRFIDRawAnalyzer* analyzer, uint32_t duration, uint32_t pulse) {
+    furi_check(analyzer);
+
+    if(analyzer->window_time == 0) {
+        protocol_dict_decoders_start(analyzer->dict);
+        analyzer->window_decoded = false;
+    }
+
+    analyzer->stats.pairs++;
+    analyzer->window_time += duration;
+
+    if(pulse == 0 || pulse >= duration) {
+        analyzer->stats.warnings++;
+    } else if(!analyzer->window_decoded) {
+        uint32_t start = furi_hal_cortex_timer_get(0).start;
+
+        ProtocolId protocol = protocol_dict_decoders_feed(analyzer->dict, true, pulse);
+        if(protocol == PROTOCOL_NO) {
+            protocol = protocol_dict_decoders_feed(analyzer->dict, false, duration - pulse);
+        }
+
+        analyzer->decode_ticks += furi_hal_cortex_timer_get(0).start - start;
+
+        // Decoders are done for this window, the rest of it is skipped
+        if(protocol != PROTOCOL_NO) {
+            analyzer->window_decoded = true;
+            analyzer->stats.windows_decoded++;
+            lfrfid_raw_analyzer_add_candidate(analyzer, protocol);
+        }
+    }
+
+    if(analyzer->window_time >= analyzer->window_us) {
+        analyzer->window_time = 0;
+        analyzer->stats.windows++;
+    }
+}
+
+bool lfrfid_raw_analyzer_feed_file(LFRFIDRawAnalyzer* analyzer, LFRFIDRawFile* file) {
+    furi_check(analyzer);
+    furi_check(file);
+
+    bool file_end = false;
+    while(true) {
+        uint32_t duration, pulse;
+        if(!lfrfid_raw_file_read_pair(file, &duration, &pulse, &file_end)) break;
+        // Reader wraps around at the end of file
+        if(file_end) break;
+        lfrfid_raw_analyzer_feed(analyzer, duration, pulse);
+    }
+
+    return file_end;
+}
+
+ProtocolId
+    lfrfid_raw_analyzer_get_result(LFRFIDRawAnalyzer* analyzer, LFRFIDRawAnalyzerStats* stats) {
+    furi_check(analyzer);
+
+    LFRFIDRawAnalyzerCandidate* result = NULL;
+    for(size_t i = 0; i < LFRFID_RAW_ANALYZER_CANDIDATES; i++) {
+        LFRFIDRawAnalyzerCandidate* candidate = &analyzer->candidates[i];
+        if(candidate->protocol != PROTOCOL_NO && (!result || candidate->count > result->count)) {
+            result = candidate;
+        }
+    }
+
+    if(result) {
+        protocol_dict_set_data(
+            analyzer->dict,
+            result->protocol,
+            result->data,
+            protocol_dict_get_data_size(analyzer->dict, result->protocol));
+    }
+
+    if(stats) {
+        *stats = analyzer->stats;
+        if(analyzer->window_time > 0 && analyzer->window_decoded) {
+            stats->windows++;
+        }
+        stats->windows_matched = result ? result->count : 0;
+        stats->decode_time_us =
+            analyzer->decode_ticks / furi_hal_cortex_instructions_per_microsecond();
+    }
+
+    return result ? result->protocol : PROTOCOL_NO;
+}
@@ -0,0 +1,94 @@
+/**
+ * @file lfrfid_raw_analyzer.h
+ * 
+ * LF RFID RAW capture analyzer.
+ * Decodes RAW captures offline through all protocol decoders, as fast as they go.
+ * Capture is split into time windows with decoders restarted for each one,
+ * so the number of windows that agree on the result shows how reliable it is.
+ */
+#pragma once
+#include <toolbox/protocols/protocol_dict.h>
+#include "lfrfid_raw_file.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define LFRFID_RAW_ANALYZER_WINDOW_DEFAULT_US (200000)
+
+typedef struct LFRFIDRawAnalyzer LFRFIDRawAnalyzer;
+
+typedef struct {
+    uint32_t pairs; /**< Pulse pairs fed */
+    uint32_t warnings; /**< Malformed pulse pairs, not fed to decoders */
+    uint32_t windows; /**< Complete windows, and the last one if something was found in it */
+    uint32_t windows_decoded; /**< Windows in which any protocol was found */
+    uint32_t windows_matched; /**< Windows in which the result was found */
+    uint32_t decode_time_us; /**< Time spent in decoders */
+} LFRFIDRawAnalyzerStats;
+
+/**
+ * @brief Allocate a new LFRFIDRawAnalyzer instance
+ * 
+ * @param dict protocol dictionary to decode with, result data is stored in it
+ * @return LFRFIDRawAnalyzer* 
+ */
+LFRFIDRawAnalyzer* lfrfid_raw_analyzer_alloc(ProtocolDict* dict);
+
+/**
+ * @brief Free a LFRFIDRawAnalyzer instance
+ * 
+ * @param analyzer 
+ */
+void lfrfid_raw_analyzer_free(LFRFIDRawAnalyzer* analyzer);
+
+/**
+ * @brief Set window length, applies after reset
+ * 
+ * @param analyzer 
+ * @param window_us window length in microseconds
+ */
+void lfrfid_raw_analyzer_set_window(LFRFIDRawAnalyzer* analyzer, uint32_t window_us);
+
+/**
+ * @brief Forget results and statistics, to start with a new capture
+ * 
+ * @param analyzer 
+ */
+void lfrfid_raw_analyzer_reset(LFRFIDRawAnalyzer* analyzer);
+
+/**
+ * @brief Feed pulse pair
+ * 
+ * @param analyzer 
+ * @param duration pulse period, in microseconds
+ * @param pulse high level length, in microseconds
+ */
+void lfrfid_raw_analyzer_feed(LFRFIDRawAnalyzer* analyzer, uint32_t duration, uint32_t pulse);
+
+/**
+ * @brief Feed all pulse pairs of RAW file
+ * 
+ * File must be open for reading, with header read.
+ * 
+ * @param analyzer 
+ * @param file 
+ * @return bool whole file was read
+ */
+bool lfrfid_raw_analyzer_feed_file(LFRFIDRawAnalyzer* analyzer, LFRFIDRawFile* file);
+
+/**
+ * @brief Get result: protocol found in the most windows
+ * 
+ * Protocol data is set to the dictionary, so it can be read and rendered.
+ * 
+ * @param analyzer 
+ * @param stats statistics, can be NULL
+ * @return ProtocolId protocol, PROTOCOL_NO if nothing was found
+ */
+ProtocolId
+    lfrfid_raw_analyzer_get_result(LFRFIDRawAnalyzer* analyzer, LFRFIDRawAnalyzerStats* stats);
+
+#ifdef __cplusplus
+}
+#endif
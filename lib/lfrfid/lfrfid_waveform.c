@@ -0,0 +1,96 @@
+#include "lfrfid_waveform.h"
+#include <furi.h>
+
+// Number of periods past the buffer that have to follow the detected period
+#define LFRFID_WAVEFORM_VERIFY_PERIODS 2
+// Limit of pulses to render while looking for the period, in buffer sizes
+#define LFRFID_WAVEFORM_VERIFY_MAX 8
+
+static void lfrfid_waveform_render_pulse(
+    ProtocolDict* dict,
+    size_t protocol,
+    PulseGlue* pulse_glue,
+    uint32_t* duration,
+    uint32_t* pulse) {
+    bool pulse_pop = false;
+    while(!pulse_pop) {
+        LevelDuration level_duration = protocol_dict_encoder_yield(dict, protocol);
+        pulse_pop = pulse_glue_push(
+            pulse_glue,
+            level_duration_get_level(level_duration),
+            level_duration_get_duration(level_duration));
+    }
+    pulse_glue_pop(pulse_glue, duration, pulse);
+    *duration -= 1;
+}
+
+void lfrfid_waveform_render(
+    ProtocolDict* dict,
+    size_t protocol,
+    PulseGlue* pulse_glue,
+    uint32_t* duration,
+    uint32_t* pulse,
+    size_t count) {
+    for(size_t i = 0; i < count; i++) {
+        lfrfid_waveform_render_pulse(dict, protocol, pulse_glue, &duration[i], &pulse[i]);
+    }
+}
+
+/* Smallest period of the rendered pulses starting from given one, size if there is none */
+static size_t
+    lfrfid_waveform_find_period(uint32_t* duration, uint32_t* pulse, size_t size, size_t period) {
+    for(; period < size; period++) {
+        size_t i = 0;
+        while(i < size - period && duration[i] == duration[i + period] &&
+              pulse[i] == pulse[i + period]) {
+            i++;
+        }
+        if(i == size - period) break;
+    }
+    return period;
+}
+
+size_t lfrfid_waveform_render_periodic(
+    ProtocolDict* dict,
+    size_t protocol,
+    uint32_t* duration,
+    uint32_t* pulse,
+    size_t size) {
+    PulseGlue* pulse_glue = pulse_glue_alloc();
+    size_t loop_size = 0;
+
+    do {
+        if(!protocol_dict_encoder_start(dict, protocol)) break;
+
+        // First pulse may be cut short, pulse glue drops leading low level
+        uint32_t next_duration, next_pulse;
+        lfrfid_waveform_render_pulse(dict, protocol, pulse_glue, &next_duration, &next_pulse);
+        lfrfid_waveform_render(dict, protocol, pulse_glue, duration, pulse, size);
+
+        // Long period candidates barely overlap within the buffer, so they are
+        // checked against the following pulses, moving on to the next candidate on mismatch
+        size_t period = lfrfid_waveform_find_period(duration, pulse, size, 1);
+        size_t matched = 0;
+        for(size_t i = size; period < size && matched < period * LFRFID_WAVEFORM_VERIFY_PERIODS;
+            i++) {
+            if(i == size * LFRFID_WAVEFORM_VERIFY_MAX) {
+                period = size;
+                break;
+            }
+
+            lfrfid_waveform_render_pulse(dict, protocol, pulse_glue, &next_duration, &next_pulse);
+            while(period < size &&
+                  (next_duration != duration[i % period] || next_pulse != pulse[i % period])) {
+                period = lfrfid_waveform_find_period(duration, pulse, size, period + 1);
+                matched = 0;
+            }
+            matched++;
+        }
+        if(period == size) break;
+
+        loop_size = size - size % period;
+    } while(false);
+
+    pulse_glue_free(pulse_glue);
+    return loop_size;
+}
@@ -0,0 +1,58 @@
+/**
+ * @file lfrfid_waveform.h
+ * 
+ * LF RFID emulation waveform rendering.
+ * Waveform is rendered as timer values, ready to be fed to emulation DMA:
+ * carrier period count minus one and pulse width for each pulse.
+ */
+#pragma once
+#include <toolbox/protocols/protocol_dict.h>
+#include <toolbox/pulse_protocols/pulse_glue.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Render next pulses of a started encoder
+ * 
+ * @param dict protocol dictionary
+ * @param protocol protocol id
+ * @param pulse_glue pulse glue, keeps state between calls
+ * @param duration output, timer period values
+ * @param pulse output, timer pulse values
+ * @param count number of pulses to render
+ */
+void lfrfid_waveform_render(
+    ProtocolDict* dict,
+    size_t protocol,
+    PulseGlue* pulse_glue,
+    uint32_t* duration,
+    uint32_t* pulse,
+    size_t count);
+
+/**
+ * @brief Start encoder and render whole number of waveform periods
+ * 
+ * Encoder output is checked to repeat exactly, so the result can be played in a loop
+ * with no further encoding. Protocols with a period longer than the buffer, or with
+ * output that changes from one period to another, have to be rendered on the fly.
+ * The first pulse after encoder start is left out, as pulse glue may cut it short.
+ * 
+ * @param dict protocol dictionary
+ * @param protocol protocol id
+ * @param duration output, timer period values
+ * @param pulse output, timer pulse values
+ * @param size output buffers size
+ * @return size_t number of pulses to loop, 0 if waveform is not periodic
+ */
+size_t lfrfid_waveform_render_periodic(
+    ProtocolDict* dict,
+    size_t protocol,
+    uint32_t* duration,
+    uint32_t* pulse,
+    size_t size);
+
+#ifdef __cplusplus
+}
+#endif
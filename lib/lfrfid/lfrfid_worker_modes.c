@@ -2,6 +2,7 @@
 #include <furi.h>
 #include <furi_hal.h>
 #include "lfrfid_worker_i.h"
+#include "lfrfid_waveform.h"
 #include "tools/t5577.h"
 #include <toolbox/pulse_protocols/pulse_glue.h>
 #include <toolbox/buffer_stream.h>
@@ -489,22 +490,22 @@ static void lfrfid_worker_emulate_ttf(LFRFIDWorker* worker) {
     LFRFIDProtocol protocol = worker->protocol;
     PulseGlue* pulse_glue = pulse_glue_alloc();
 
-    protocol_dict_encoder_start(worker->protocols, protocol);
+    // Periodic waveform is rendered once and looped by DMA, with no encoding on the go
+    size_t length = lfrfid_waveform_render_periodic(
+        worker->protocols,
+        protocol,
+        buffer->duration,
+        buffer->pulse,
+        LFRFID_WORKER_EMULATE_BUFFER_SIZE);
+    bool periodic = length > 0;
 
-    for(size_t i = 0; i < LFRFID_WORKER_EMULATE_BUFFER_SIZE; i++) {
-        bool pulse_pop = false;
-        while(!pulse_pop) {
-            LevelDuration level_duration =
-                protocol_dict_encoder_yield(worker->protocols, protocol);
-            pulse_pop = pulse_glue_push(
-                pulse_glue,
-                level_duration_get_level(level_duration),
-                level_duration_get_duration(level_duration));
-        }
-        uint32_t duration, pulse;
-        pulse_glue_pop(pulse_glue, &duration, &pulse);
-        buffer->duration[i] = duration - 1;
-        buffer->pulse[i] = pulse;
+    if(periodic) {
+        FURI_LOG_D(TAG, "Emulating %zu pulses in a loop", length);
+    } else {
+        length = LFRFID_WORKER_EMULATE_BUFFER_SIZE;
+        protocol_dict_encoder_start(worker->protocols, protocol);
+        lfrfid_waveform_render(
+            worker->protocols, protocol, pulse_glue, buffer->duration, buffer->pulse, length);
     }
 
 #ifdef LFRFID_WORKER_READ_DEBUG_GPIO
@@ -514,7 +515,7 @@ static void lfrfid_worker_emulate_ttf(LFRFIDWorker* worker) {
     furi_hal_rfid_tim_emulate_dma_start(
         buffer->duration,
         buffer->pulse,
-        LFRFID_WORKER_EMULATE_BUFFER_SIZE,
+        length,
         lfrfid_worker_emulate_dma_isr,
         stream);
 
@@ -526,7 +527,7 @@ static void lfrfid_worker_emulate_ttf(LFRFIDWorker* worker) {
         furi_hal_gpio_write(LFRFID_WORKER_READ_DEBUG_GPIO_LOAD, true);
 #endif
 
-        if(size == sizeof(uint32_t)) {
+        if(!periodic && size == sizeof(uint32_t)) {
             size_t start = 0;
 
             if(flag == HalfTransfer) {
@@ -535,21 +536,13 @@ static void lfrfid_worker_emulate_ttf(LFRFIDWorker* worker) {
                 start = (LFRFID_WORKER_EMULATE_BUFFER_SIZE / 2);
             }
 
-            for(size_t i = 0; i < (LFRFID_WORKER_EMULATE_BUFFER_SIZE / 2); i++) {
-                bool pulse_pop = false;
-                while(!pulse_pop) {
-                    LevelDuration level_duration =
-                        protocol_dict_encoder_yield(worker->protocols, protocol);
-                    pulse_pop = pulse_glue_push(
-                        pulse_glue,
-                        level_duration_get_level(level_duration),
-                        level_duration_get_duration(level_duration));
-                }
-                uint32_t duration, pulse;
-                pulse_glue_pop(pulse_glue, &duration, &pulse);
-                buffer->duration[start + i] = duration - 1;
-                buffer->pulse[start + i] = pulse;
-            }
+            lfrfid_waveform_render(
+                worker->protocols,
+                protocol,
+                pulse_glue,
+                &buffer->duration[start],
+                &buffer->pulse[start],
+                LFRFID_WORKER_EMULATE_BUFFER_SIZE / 2);
         }
 
         if(lfrfid_worker_check_for_stop(worker)) {
@@ -111,6 +111,27 @@ static void mjs_do_gc(struct mjs* mjs) {
     mjs_return(mjs, arg0);
 }
 
+static void mjs_gc_stats(struct mjs* mjs) {
+    struct mjs_gc_stats stats;
+    mjs_val_t res = mjs_mk_object(mjs);
+
+    mjs_gc_get_stats(mjs, &stats);
+    mjs_set(mjs, res, "collections", ~0, mjs_mk_number(mjs, stats.collections));
+    mjs_set(mjs, res, "pauseLast", ~0, mjs_mk_number(mjs, stats.pause_last_us));
+    mjs_set(mjs, res, "pauseMax", ~0, mjs_mk_number(mjs, stats.pause_max_us));
+    mjs_set(mjs, res, "pauseTotal", ~0, mjs_mk_number(mjs, stats.pause_total_us));
+    mjs_set(mjs, res, "sweepSteps", ~0, mjs_mk_number(mjs, stats.sweep_steps));
+    mjs_set(mjs, res, "sweepMax", ~0, mjs_mk_number(mjs, stats.sweep_max_us));
+    mjs_set(mjs, res, "freed", ~0, mjs_mk_number(mjs, stats.bytes_freed));
+    mjs_set(mjs, res, "objects", ~0, mjs_mk_number(mjs, stats.object_cells));
+    mjs_set(mjs, res, "objectsFree", ~0, mjs_mk_number(mjs, stats.object_cells_free));
+    mjs_set(mjs, res, "properties", ~0, mjs_mk_number(mjs, stats.property_cells));
+    mjs_set(mjs, res, "propertiesFree", ~0, mjs_mk_number(mjs, stats.property_cells_free));
+    mjs_set(mjs, res, "strings", ~0, mjs_mk_number(mjs, stats.strings_used));
+    mjs_set(mjs, res, "stringsSize", ~0, mjs_mk_number(mjs, stats.strings_size));
+    mjs_return(mjs, res);
+}
+
 static void mjs_s2o(struct mjs* mjs) {
     mjs_return(
         mjs,
@@ -133,6 +154,7 @@ void mjs_init_builtin(struct mjs* mjs, mjs_val_t obj) {
     mjs_set(mjs, obj, "getMJS", ~0, mjs_mk_foreign_func(mjs, (mjs_func_ptr_t)mjs_get_mjs));
     mjs_set(mjs, obj, "die", ~0, mjs_mk_foreign_func(mjs, (mjs_func_ptr_t)mjs_die));
     mjs_set(mjs, obj, "gc", ~0, mjs_mk_foreign_func(mjs, (mjs_func_ptr_t)mjs_do_gc));
+    mjs_set(mjs, obj, "gcStats", ~0, mjs_mk_foreign_func(mjs, (mjs_func_ptr_t)mjs_gc_stats));
     mjs_set(mjs, obj, "chr", ~0, mjs_mk_foreign_func(mjs, (mjs_func_ptr_t)mjs_chr));
     mjs_set(mjs, obj, "s2o", ~0, mjs_mk_foreign_func(mjs, (mjs_func_ptr_t)mjs_s2o));
 
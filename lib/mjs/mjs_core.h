@@ -89,9 +89,18 @@ struct mjs {
     struct gc_arena property_arena;
     struct gc_arena ffi_sig_arena;
 
+    struct mjs_gc_stats gc_stats;
+    mjs_gc_clock_t gc_clock; /* Host clock for GC statistics, may be NULL */
+    uint32_t gc_clock_ticks_per_us;
+    size_t gc_strings_len; /* owned_strings length after the last collection */
+
+    char* jsc_cache_dir;
+    uint32_t jsc_build_id;
+
     unsigned inhibit_gc : 1;
     unsigned need_gc : 1;
     unsigned generate_jsc : 1;
+    unsigned gc_incremental : 1;
 };
 
 /*
@@ -262,6 +262,19 @@ const char* mjs_get_stack_trace(struct mjs* mjs);
  */
 void mjs_set_generate_jsc(struct mjs* mjs, int generate_jsc);
 
+/*
+ * Sets where bcode of *.js files is cached when .jsc generation is on. Cache
+ * files are kept in `dir`, named after CRC-32 of the script path, so scripts'
+ * own directories are never written to. No cache is used until it is set.
+ *
+ * `build_id` identifies the interpreter build: it is stored in cache files
+ * and ones written by another build are not loaded. *.jsc files executed
+ * directly must have the same build id too.
+ *
+ * Only has effect if `MJS_JSC_CACHE` is on.
+ */
+void mjs_set_jsc_cache(struct mjs* mjs, const char* dir, uint32_t build_id);
+
 /*
  * When invoked from a cfunction, returns number of arguments passed to the
  * current JS function call.
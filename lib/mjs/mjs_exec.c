@@ -18,6 +18,7 @@
 #include "mjs_tok.h"
 #include "mjs_util.h"
 #include "mjs_array_buf.h"
+#include "mjs_jsc.h"
 
 #if MJS_GENERATE_JSC && defined(CS_MMAP)
 #include <sys/mman.h>
@@ -1135,6 +1136,10 @@ MJS_PRIVATE mjs_err_t mjs_exec_internal(
                 }
             }
         }
+#elif MJS_JSC_CACHE
+        if(generate_jsc && path != NULL) {
+            mjs_jsc_save(mjs, path, src, strlen(src));
+        }
 #else
         (void)generate_jsc;
 #endif
@@ -1153,7 +1158,24 @@ mjs_err_t mjs_exec_file(struct mjs* mjs, const char* path, mjs_val_t* res) {
     mjs_err_t error = MJS_FILE_READ_ERROR;
     mjs_val_t r = MJS_UNDEFINED;
     size_t size;
-    char* source_code = cs_read_file(path, &size);
+    char* source_code;
+
+#if MJS_JSC_CACHE
+    size_t off = mjs->bcode_len;
+    switch(mjs_jsc_load(mjs, path)) {
+    case 1:
+        /* Bcode is already there, skip reading and parsing the source */
+        mjs->error = MJS_OK;
+        mjs_execute(mjs, off, &r);
+        error = mjs->error;
+        goto clean;
+    case -1:
+        mjs_prepend_errorf(mjs, error, "invalid bytecode file \"%s\"", path);
+        goto clean;
+    }
+#endif
+
+    source_code = cs_read_file(path, &size);
 
     if(source_code == NULL) {
         error = MJS_FILE_READ_ERROR;
@@ -1170,6 +1192,40 @@ clean:
     return error;
 }
 
+mjs_err_t mjs_compile_file(struct mjs* mjs, const char* path) {
+    size_t size;
+    char* source_code;
+
+#if MJS_JSC_CACHE
+    switch(mjs_jsc_load(mjs, path)) {
+    case 1:
+        mjs->error = MJS_OK;
+        return mjs->error;
+    case -1:
+        mjs->error = MJS_FILE_READ_ERROR;
+        mjs_prepend_errorf(mjs, mjs->error, "invalid bytecode file \"%s\"", path);
+        return mjs->error;
+    }
+#endif
+
+    source_code = cs_read_file(path, &size);
+    if(source_code == NULL) {
+        mjs->error = MJS_FILE_READ_ERROR;
+        mjs_prepend_errorf(mjs, mjs->error, "failed to read file \"%s\"", path);
+        return mjs->error;
+    }
+
+    mjs->error = mjs_parse(path, source_code, mjs);
+#if MJS_JSC_CACHE
+    if(mjs->error == MJS_OK && mjs->generate_jsc) {
+        mjs_jsc_save(mjs, path, source_code, size);
+    }
+#endif
+    free(source_code);
+
+    return mjs->error;
+}
+
 mjs_err_t
     mjs_call(struct mjs* mjs, mjs_val_t* res, mjs_val_t func, mjs_val_t this_val, int nargs, ...) {
     va_list ap;
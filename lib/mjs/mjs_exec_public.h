@@ -16,6 +16,13 @@ extern "C" {
 mjs_err_t mjs_exec(struct mjs*, const char* src, mjs_val_t* res);
 
 mjs_err_t mjs_exec_file(struct mjs* mjs, const char* path, mjs_val_t* res);
+
+/*
+ * Parses the file at `path` into bcode without executing it. If .jsc
+ * generation is enabled, bcode is taken from .jsc cache when it is up to
+ * date, and the cache is written otherwise.
+ */
+mjs_err_t mjs_compile_file(struct mjs* mjs, const char* path);
 mjs_err_t mjs_apply(
     struct mjs* mjs,
     mjs_val_t* res,
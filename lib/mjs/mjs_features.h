@@ -30,4 +30,21 @@
 #endif
 #endif
 
+/*
+ * MJS_JSC_CACHE: used where mmapping is not available. If enabled, bcode of
+ * .js files is cached in .jsc files in a cache directory, keyed on the source
+ * CRC and interpreter build. Cached bcode is loaded to RAM instead of parsing
+ * the source, only when .jsc generation and cache directory are set for the
+ * mjs instance.
+ *
+ * By default it's enabled (provided that CS_MMAP is not defined)
+ */
+#if !defined(MJS_JSC_CACHE)
+#if defined(CS_MMAP)
+#define MJS_JSC_CACHE 0
+#else
+#define MJS_JSC_CACHE 1
+#endif
+#endif
+
 #endif /* MJS_FEATURES_H_ */
@@ -17,16 +17,16 @@
 #include "mjs_string.h"
 
 /*
- * Macros for marking reachable things: use bit 0.
+ * Reachable cells are marked in the block's `marks` bitmap rather than in the
+ * cell itself, so that marked cells stay intact while incremental sweep is in
+ * progress.
  */
-#define MARK(p) (((struct gc_cell*)(p))->head.word |= 1)
-#define UNMARK(p) (((struct gc_cell*)(p))->head.word &= ~1)
-#define MARKED(p) (((struct gc_cell*)(p))->head.word & 1)
+#define GC_MARKS_WORDS(size) (((size) + 31) / 32)
 
 /*
- * Similar to `MARK()` / `UNMARK()` / `MARKED()`, but `.._FREE` counterparts
- * are intended to mark free cells (as opposed to used ones), so they use
- * bit 1.
+ * Free cells are marked in the cell itself: their contents are never seen
+ * by the user code. Since the first word of a used cell is a pointer, bit 1
+ * is always clear there.
  */
 #define MARK_FREE(p) (((struct gc_cell*)(p))->head.word |= 2)
 #define UNMARK_FREE(p) (((struct gc_cell*)(p))->head.word &= ~2)
@@ -40,6 +40,18 @@
 static struct gc_block* gc_new_block(struct gc_arena* a, size_t size);
 static void gc_free_block(struct gc_block* b);
 static void gc_mark_mbuf_pt(struct mjs* mjs, const struct mbuf* mbuf);
+static void gc_sweep_begin(struct gc_arena* a);
+static void gc_sweep_step(struct mjs* mjs, struct gc_arena* a);
+static void gc_sweep_finish(struct mjs* mjs, struct gc_arena* a);
+
+/* Host clock, used for GC statistics */
+static uint32_t gc_clock(struct mjs* mjs) {
+    return mjs->gc_clock ? mjs->gc_clock() : 0;
+}
+
+static uint32_t gc_clock_us(struct mjs* mjs, uint32_t start) {
+    return (gc_clock(mjs) - start) / mjs->gc_clock_ticks_per_us;
+}
 
 MJS_PRIVATE struct mjs_object* new_object(struct mjs* mjs) {
     return (struct mjs_object*)gc_alloc_cell(mjs, &mjs->object_arena);
@@ -71,7 +83,9 @@ MJS_PRIVATE void gc_arena_destroy(struct mjs* mjs, struct gc_arena* a) {
     struct gc_block* b;
 
     if(a->blocks != NULL) {
-        gc_sweep(mjs, a, 0);
+        /* Nothing is marked after the pending sweep, so all cells are freed */
+        gc_sweep_finish(mjs, a);
+        gc_sweep(mjs, a);
         for(b = a->blocks; b != NULL;) {
             struct gc_block* tmp;
             tmp = b;
@@ -90,7 +104,7 @@ static struct gc_block* gc_new_block(struct gc_arena* a, size_t size) {
     struct gc_cell* cur;
     struct gc_block* b;
 
-    b = (struct gc_block*)calloc(1, sizeof(*b));
+    b = (struct gc_block*)calloc(1, sizeof(*b) + GC_MARKS_WORDS(size) * sizeof(uint32_t));
     if(b == NULL) abort();
 
     b->size = size;
@@ -102,10 +116,44 @@ static struct gc_block* gc_new_block(struct gc_arena* a, size_t size) {
         cur->head.link = a->free;
         a->free = cur;
     }
+    a->cells += size;
+    a->free_cells += size;
 
     return b;
 }
 
+/* Returns the block the cell belongs to, or NULL */
+static struct gc_block* gc_find_block(const struct gc_arena* a, const void* ptr) {
+    const struct gc_cell* p = (const struct gc_cell*)ptr;
+    struct gc_block* b;
+    for(b = a->blocks; b != NULL; b = b->next) {
+        if(p >= b->base && p < GC_CELL_OP(a, b->base, +, b->size)) {
+            return b;
+        }
+    }
+    return NULL;
+}
+
+/*
+ * Marks the cell as reachable. Returns 0 if it was already marked. Aborts if
+ * the cell does not belong to the arena.
+ */
+static int gc_mark_cell(struct gc_arena* a, const void* p) {
+    struct gc_block* b = gc_find_block(a, p);
+    size_t idx;
+    uint32_t bit;
+
+    if(b == NULL) {
+        abort();
+    }
+
+    idx = ((const char*)p - (const char*)b->base) / a->cell_size;
+    bit = 1U << (idx % 32);
+    if(b->marks[idx / 32] & bit) return 0;
+    b->marks[idx / 32] |= bit;
+    return 1;
+}
+
 /*
  * Returns whether the given arena has GC_ARENA_CELLS_RESERVE or less free
  * cells
@@ -131,24 +179,44 @@ MJS_PRIVATE int gc_strings_is_gc_needed(struct mjs* mjs) {
 MJS_PRIVATE void* gc_alloc_cell(struct mjs* mjs, struct gc_arena* a) {
     struct gc_cell* r;
 
+    /* Reuse garbage from pending sweep before growing the arena */
+    while(a->free == NULL && a->sweep_block != NULL) {
+        uint32_t start = gc_clock(mjs);
+        uint32_t elapsed;
+
+        gc_sweep_step(mjs, a);
+
+        elapsed = gc_clock_us(mjs, start);
+        mjs->gc_stats.sweep_steps++;
+        mjs->gc_stats.pause_total_us += elapsed;
+        if(elapsed > mjs->gc_stats.sweep_max_us) {
+            mjs->gc_stats.sweep_max_us = elapsed;
+        }
+    }
+
     if(a->free == NULL) {
         struct gc_block* b = gc_new_block(a, a->size_increment);
         b->next = a->blocks;
         a->blocks = b;
+        if(a->sweep_block != NULL && a->sweep_prev == NULL) {
+            a->sweep_prev = b;
+        }
     }
     r = a->free;
 
-    UNMARK(r);
-
     a->free = r->head.link;
+    a->free_cells--;
 
 #if MJS_MEMORY_STATS
     a->allocations++;
     a->alive++;
 #endif
 
-    /* Schedule GC if needed */
-    if(gc_arena_is_gc_needed(a)) {
+    /*
+   * Schedule GC if needed. While sweep is in progress the free list only holds
+   * the cells of swept blocks, so it says nothing about heap occupancy.
+   */
+    if(a->sweep_block == NULL && gc_arena_is_gc_needed(a)) {
         mjs->need_gc = 1;
     }
 
@@ -161,101 +229,144 @@ MJS_PRIVATE void* gc_alloc_cell(struct mjs* mjs, struct gc_arena* a) {
 }
 
 /*
- * Scans the arena and add all unmarked cells to the free list.
- *
- * Empty blocks get deallocated. The head of the free list will contais cells
- * from the last (oldest) block. Cells will thus be allocated in block order.
+ * Prepares the arena for sweeping: all unmarked cells will be added to the
+ * free list by the following gc_sweep_step() calls.
  */
-void gc_sweep(struct mjs* mjs, struct gc_arena* a, size_t start) {
-    struct gc_block* b;
+static void gc_sweep_begin(struct gc_arena* a) {
     struct gc_cell* cur;
-    struct gc_block** prevp = &a->blocks;
+    struct gc_cell* next;
+
 #if MJS_MEMORY_STATS
     a->alive = 0;
 #endif
 
     /*
    * Before we sweep, we should mark all free cells in a way that is
-   * distinguishable from marked used cells.
+   * distinguishable from garbage.
    */
-    {
-        struct gc_cell* next;
-        for(cur = a->free; cur != NULL; cur = next) {
-            next = cur->head.link;
-            MARK_FREE(cur);
-        }
+    for(cur = a->free; cur != NULL; cur = next) {
+        next = cur->head.link;
+        MARK_FREE(cur);
     }
 
     /*
    * We'll rebuild the whole `free` list, so initially we just reset it
    */
     a->free = NULL;
+    a->free_cells = 0;
 
-    for(b = a->blocks; b != NULL;) {
-        size_t freed_in_block = 0;
-        /*
-     * if it turns out that this block is 100% garbage
-     * we can release the whole block, but the addition
-     * of it's cells to the free list has to be undone.
-     */
-        struct gc_cell* prev_free = a->free;
+    a->sweep_block = a->blocks;
+    a->sweep_prev = NULL;
+}
+
+/*
+ * Sweeps the next block of the arena: adds unmarked cells to the free list
+ * and clears marks.
+ *
+ * Empty blocks get deallocated. The head of the free list will contais cells
+ * from the last (oldest) block. Cells will thus be allocated in block order.
+ */
+static void gc_sweep_step(struct mjs* mjs, struct gc_arena* a) {
+    struct gc_block* b = a->sweep_block;
+    struct gc_cell* cur;
+    size_t freed_in_block = 0;
+    size_t garbage_in_block = 0;
+    size_t idx;
+
+    /*
+   * if it turns out that this block is 100% garbage
+   * we can release the whole block, but the addition
+   * of it's cells to the free list has to be undone.
+   */
+    struct gc_cell* prev_free = a->free;
 
-        for(cur = GC_CELL_OP(a, b->base, +, start); cur < GC_CELL_OP(a, b->base, +, b->size);
-            cur = GC_CELL_OP(a, cur, +, 1)) {
-            if(MARKED(cur)) {
-                /* The cell is used and marked  */
-                UNMARK(cur);
+    for(idx = 0, cur = b->base; idx < b->size; idx++, cur = GC_CELL_OP(a, cur, +, 1)) {
+        if(b->marks[idx / 32] & (1U << (idx % 32))) {
+            /* The cell is used and marked  */
 #if MJS_MEMORY_STATS
-                a->alive++;
+            a->alive++;
 #endif
-            } else {
-                /*
-         * The cell is either:
-         * - free
-         * - garbage that's about to be freed
-         */
-
-                if(MARKED_FREE(cur)) {
-                    /* The cell is free, so, just unmark it */
-                    UNMARK_FREE(cur);
-                } else {
-                    /*
-           * The cell is used and should be freed: call the destructor and
-           * reset the memory
-           */
-                    if(a->destructor != NULL) {
-                        a->destructor(mjs, cur);
-                    }
-                    memset(cur, 0, a->cell_size);
-                }
-
-                /* Add this cell to the `free` list */
-                cur->head.link = a->free;
-                a->free = cur;
-                freed_in_block++;
+            continue;
+        }
+
+        /*
+     * The cell is either:
+     * - free
+     * - garbage that's about to be freed
+     */
+        if(MARKED_FREE(cur)) {
+            /* The cell is free, so, just unmark it */
+            UNMARK_FREE(cur);
+        } else {
+            /*
+       * The cell is used and should be freed: call the destructor and
+       * reset the memory
+       */
+            if(a->destructor != NULL) {
+                a->destructor(mjs, cur);
+            }
+            memset(cur, 0, a->cell_size);
+            garbage_in_block++;
 #if MJS_MEMORY_STATS
-                a->garbage++;
+            a->garbage++;
 #endif
-            }
         }
 
-        /*
-     * don't free the initial block, which is at the tail
-     * because it has a special size aimed at reducing waste
-     * and simplifying initial startup. TODO(mkm): improve
-     * */
-        if(b->next != NULL && freed_in_block == b->size) {
-            *prevp = b->next;
-            gc_free_block(b);
-            b = *prevp;
-            a->free = prev_free;
+        /* Add this cell to the `free` list */
+        cur->head.link = a->free;
+        a->free = cur;
+        freed_in_block++;
+    }
+    memset(b->marks, 0, GC_MARKS_WORDS(b->size) * sizeof(uint32_t));
+
+    mjs->gc_stats.bytes_freed += garbage_in_block * a->cell_size;
+    a->sweep_block = b->next;
+
+    /*
+   * don't free the initial block, which is at the tail
+   * because it has a special size aimed at reducing waste
+   * and simplifying initial startup. TODO(mkm): improve
+   * */
+    if(b->next != NULL && freed_in_block == b->size) {
+        if(a->sweep_prev != NULL) {
+            a->sweep_prev->next = b->next;
         } else {
-            prevp = &b->next;
-            b = b->next;
+            a->blocks = b->next;
         }
+        a->cells -= b->size;
+        gc_free_block(b);
+        a->free = prev_free;
+    } else {
+        a->free_cells += freed_in_block;
+        a->sweep_prev = b;
+    }
+
+    /*
+   * Grow the arena if the collection left less than a quarter of it free,
+   * otherwise the next collection would be scheduled almost right away
+   */
+    if(a->sweep_block == NULL && a->free_cells * 4 < a->cells) {
+        size_t size = a->cells / 4;
+        if(size < a->size_increment) size = a->size_increment;
+        b = gc_new_block(a, size);
+        b->next = a->blocks;
+        a->blocks = b;
+    }
+}
+
+/* Sweeps the remaining blocks of the arena */
+static void gc_sweep_finish(struct mjs* mjs, struct gc_arena* a) {
+    while(a->sweep_block != NULL) {
+        gc_sweep_step(mjs, a);
     }
 }
 
+/* Scans the whole arena and adds all unmarked cells to the free list. */
+void gc_sweep(struct mjs* mjs, struct gc_arena* a) {
+    gc_sweep_begin(a);
+    gc_sweep_finish(mjs, a);
+}
+
 /* Mark an FFI signature */
 static void gc_mark_ffi_sig(struct mjs* mjs, mjs_val_t* v) {
     struct mjs_ffi_sig* psig;
@@ -264,17 +375,7 @@ static void gc_mark_ffi_sig(struct mjs* mjs, mjs_val_t* v) {
 
     psig = mjs_get_ffi_sig_struct(*v);
 
-    /*
-   * we treat all object like things like objects but they might be functions,
-   * gc_check_val checks the appropriate arena per actual value type.
-   */
-    if(!gc_check_val(mjs, *v)) {
-        abort();
-    }
-
-    if(MARKED(psig)) return;
-
-    MARK(psig);
+    gc_mark_cell(&mjs->ffi_sig_arena, psig);
 }
 
 /* Mark an object */
@@ -289,25 +390,18 @@ static void gc_mark_object(struct mjs* mjs, mjs_val_t* v) {
 
     /*
    * we treat all object like things like objects but they might be functions,
-   * gc_check_val checks the appropriate arena per actual value type.
+   * gc_mark_cell aborts if the pointer does not belong to the object arena.
    */
-    if(!gc_check_val(mjs, *v)) {
-        abort();
-    }
-
-    if(MARKED(obj_base)) return;
+    if(!gc_mark_cell(&mjs->object_arena, obj_base)) return;
 
     /* mark object itself, and its properties */
-    for((prop = obj_base->properties), MARK(obj_base); prop != NULL; prop = next) {
-        if(!gc_check_ptr(&mjs->property_arena, prop)) {
-            abort();
-        }
+    for(prop = obj_base->properties; prop != NULL; prop = next) {
+        gc_mark_cell(&mjs->property_arena, prop);
 
         gc_mark(mjs, &prop->name);
         gc_mark(mjs, &prop->value);
 
         next = prop->next;
-        MARK(prop);
     }
 
     /* mark object's prototype */
@@ -485,6 +579,15 @@ static void gc_mark_ffi_cbargs_list(struct mjs* mjs, ffi_cb_args_t* cbargs) {
 
 /* Perform garbage collection */
 void mjs_gc(struct mjs* mjs, int full) {
+    uint32_t start = gc_clock(mjs);
+    uint32_t elapsed;
+    size_t strings_len;
+
+    /* Marks of the previous collection have to be cleared first */
+    gc_sweep_finish(mjs, &mjs->object_arena);
+    gc_sweep_finish(mjs, &mjs->property_arena);
+    gc_sweep_finish(mjs, &mjs->ffi_sig_arena);
+
     gc_mark_val_array(mjs, (mjs_val_t*)&mjs->vals, sizeof(mjs->vals) / sizeof(mjs_val_t));
 
     gc_mark_mbuf_pt(mjs, &mjs->owned_values);
@@ -494,11 +597,25 @@ void mjs_gc(struct mjs* mjs, int full) {
 
     gc_mark_ffi_cbargs_list(mjs, mjs->ffi_cb_args);
 
+    strings_len = mjs->owned_strings.len;
     gc_compact_strings(mjs);
+    mjs->gc_stats.bytes_freed += strings_len - mjs->owned_strings.len;
+    mjs->gc_strings_len = mjs->owned_strings.len;
+
+    /* Same for strings: keep at least a third of the buffer free */
+    if(!full && mjs->owned_strings.len + mjs->owned_strings.len / 2 > mjs->owned_strings.size) {
+        mbuf_resize(&mjs->owned_strings, mjs->owned_strings.len + mjs->owned_strings.len / 2);
+    }
+
+    gc_sweep_begin(&mjs->object_arena);
+    gc_sweep_begin(&mjs->property_arena);
+    gc_sweep_begin(&mjs->ffi_sig_arena);
 
-    gc_sweep(mjs, &mjs->object_arena, 0);
-    gc_sweep(mjs, &mjs->property_arena, 0);
-    gc_sweep(mjs, &mjs->ffi_sig_arena, 0);
+    if(!mjs->gc_incremental || full) {
+        gc_sweep_finish(mjs, &mjs->object_arena);
+        gc_sweep_finish(mjs, &mjs->property_arena);
+        gc_sweep_finish(mjs, &mjs->ffi_sig_arena);
+    }
 
     if(full) {
         /*
@@ -511,6 +628,54 @@ void mjs_gc(struct mjs* mjs, int full) {
             mbuf_resize(&mjs->owned_strings, trimmed_size);
         }
     }
+
+    elapsed = gc_clock_us(mjs, start);
+    mjs->gc_stats.collections++;
+    mjs->gc_stats.pause_last_us = elapsed;
+    mjs->gc_stats.pause_total_us += elapsed;
+    if(elapsed > mjs->gc_stats.pause_max_us) {
+        mjs->gc_stats.pause_max_us = elapsed;
+    }
+}
+
+void mjs_gc_set_incremental(struct mjs* mjs, int enable) {
+    mjs->gc_incremental = enable ? 1 : 0;
+}
+
+void mjs_gc_set_clock(struct mjs* mjs, mjs_gc_clock_t clock, uint32_t ticks_per_us) {
+    mjs->gc_clock = clock;
+    mjs->gc_clock_ticks_per_us = ticks_per_us ? ticks_per_us : 1;
+}
+
+/*
+ * Returns whether the strings buffer has taken more than a half of its
+ * headroom since the last collection
+ */
+static int gc_strings_is_idle_gc_useful(struct mjs* mjs) {
+    const struct mbuf* m = &mjs->owned_strings;
+    return m->len > mjs->gc_strings_len &&
+           m->len - mjs->gc_strings_len > (m->size - mjs->gc_strings_len) / 2;
+}
+
+void mjs_gc_idle(struct mjs* mjs, int collect) {
+    if(collect && !mjs->inhibit_gc && (mjs->need_gc || gc_strings_is_idle_gc_useful(mjs))) {
+        mjs_gc(mjs, 0);
+        mjs->need_gc = 0;
+    }
+
+    gc_sweep_finish(mjs, &mjs->object_arena);
+    gc_sweep_finish(mjs, &mjs->property_arena);
+    gc_sweep_finish(mjs, &mjs->ffi_sig_arena);
+}
+
+void mjs_gc_get_stats(struct mjs* mjs, struct mjs_gc_stats* stats) {
+    *stats = mjs->gc_stats;
+    stats->object_cells = mjs->object_arena.cells;
+    stats->object_cells_free = mjs->object_arena.free_cells;
+    stats->property_cells = mjs->property_arena.cells;
+    stats->property_cells_free = mjs->property_arena.free_cells;
+    stats->strings_used = mjs->owned_strings.len;
+    stats->strings_size = mjs->owned_strings.size;
 }
 
 MJS_PRIVATE int gc_check_val(struct mjs* mjs, mjs_val_t v) {
@@ -524,12 +689,5 @@ MJS_PRIVATE int gc_check_val(struct mjs* mjs, mjs_val_t v) {
 }
 
 MJS_PRIVATE int gc_check_ptr(const struct gc_arena* a, const void* ptr) {
-    const struct gc_cell* p = (const struct gc_cell*)ptr;
-    struct gc_block* b;
-    for(b = a->blocks; b != NULL; b = b->next) {
-        if(p >= b->base && p < GC_CELL_OP(a, b->base, +, b->size)) {
-            return 1;
-        }
-    }
-    return 0;
+    return gc_find_block(a, ptr) != NULL;
 }
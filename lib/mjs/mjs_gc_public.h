@@ -18,6 +18,60 @@ extern "C" {
  */
 void mjs_gc(struct mjs* mjs, int full);
 
+/*
+ * Garbage collector statistics. Durations are in microseconds, counters are
+ * cumulative since mjs_create().
+ */
+struct mjs_gc_stats {
+    uint32_t collections; /* Number of mark phases */
+    uint32_t pause_last_us; /* Duration of the last mark phase */
+    uint32_t pause_max_us; /* Longest mark phase */
+    uint32_t pause_total_us; /* Total time of mark phases and sweep steps */
+    uint32_t sweep_steps; /* Number of incremental sweep steps */
+    uint32_t sweep_max_us; /* Longest incremental sweep step */
+    uint32_t bytes_freed; /* Size of reclaimed cells and strings */
+
+    /* Current occupancy, free cells are the ones available without sweeping */
+    uint32_t object_cells;
+    uint32_t object_cells_free;
+    uint32_t property_cells;
+    uint32_t property_cells_free;
+    uint32_t strings_used; /* Owned strings buffer, bytes */
+    uint32_t strings_size;
+};
+
+/*
+ * Enable or disable incremental sweeping.
+ *
+ * Marking and string compaction always happen at once, but in incremental
+ * mode unreachable cells are swept block by block: on allocation, when free
+ * cells run out, and from mjs_gc_idle(). This keeps GC pauses proportional
+ * to the amount of live data instead of the whole heap. Disabled by default.
+ */
+void mjs_gc_set_incremental(struct mjs* mjs, int enable);
+
+/*
+ * Perform pending GC work while the script is idle (e.g. waiting for an
+ * event): finish incremental sweeping and, if `collect` is true and enough
+ * garbage is expected, run a collection ahead of time.
+ *
+ * Collection moves strings, so `collect` must only be set when the caller
+ * holds no pointers obtained from mjs_get_string().
+ */
+void mjs_gc_idle(struct mjs* mjs, int collect);
+
+/* Get garbage collector statistics */
+void mjs_gc_get_stats(struct mjs* mjs, struct mjs_gc_stats* stats);
+
+/* Free-running counter, wrapping at 32 bits */
+typedef uint32_t (*mjs_gc_clock_t)(void);
+
+/*
+ * Set the clock that GC pauses in statistics are timed with, `ticks_per_us`
+ * being its rate. Without a clock pause durations are reported as 0.
+ */
+void mjs_gc_set_clock(struct mjs* mjs, mjs_gc_clock_t clock, uint32_t ticks_per_us);
+
 #if defined(__cplusplus)
 }
 #endif /* __cplusplus */
@@ -0,0 +1,202 @@
+#include "mjs_jsc.h"
+#include "mjs_bcode.h"
+
+#if MJS_JSC_CACHE
+
+#include <furi.h>
+#include <storage/storage.h>
+#include <toolbox/stream/file_stream.h>
+#include <toolbox/crc.h>
+
+#define MJS_JSC_MAGIC 0x43534a4d /* "MJSC" */
+#define MJS_JSC_VERSION                                                       \
+    (((uint32_t)MJS_JSC_FORMAT_VERSION << 16) | ((uint32_t)OP_MAX << 8) | \
+     (sizeof(mjs_header_item_t) * MJS_HDR_ITEMS_CNT))
+
+#define MJS_JSC_READ_CHUNK 512
+
+/* File header, followed by bcode_size bytes of bcode */
+struct mjs_jsc_header {
+    uint32_t magic;
+    uint32_t version;
+    /* Interpreter build that wrote the file, see mjs_set_jsc_cache() */
+    uint32_t build_id;
+    /* Source size and CRC-32 of its path and contents */
+    uint32_t source_size;
+    uint32_t source_crc;
+    uint32_t bcode_size;
+    uint32_t bcode_crc;
+};
+
+static int mjs_jsc_has_ext(const char* path, const char* ext) {
+    size_t path_len = strlen(path);
+    size_t ext_len = strlen(ext);
+    return path_len > ext_len && strcmp(path + path_len - ext_len, ext) == 0;
+}
+
+static uint32_t mjs_jsc_path_crc(const char* path) {
+    return crc32_update(0xFFFFFFFF, path, strlen(path));
+}
+
+/* Returns allocated cache file path for .js file path */
+static char* mjs_jsc_get_path(struct mjs* mjs, const char* path) {
+    size_t len = strlen(mjs->jsc_cache_dir) + sizeof("/01234567.jsc");
+    char* jsc_path = malloc(len);
+    snprintf(
+        jsc_path, len, "%s/%08lx.jsc", mjs->jsc_cache_dir, (unsigned long)mjs_jsc_path_crc(path));
+    return jsc_path;
+}
+
+/* Hash source file in chunks, so it doesn't have to be loaded to RAM */
+static int mjs_jsc_hash_file(Stream* stream, uint32_t* crc, uint32_t* size) {
+    uint8_t* buffer = malloc(MJS_JSC_READ_CHUNK);
+    size_t read;
+    *size = 0;
+    while((read = stream_read(stream, buffer, MJS_JSC_READ_CHUNK)) > 0) {
+        *crc = crc32_update(*crc, buffer, read);
+        *size += read;
+    }
+    free(buffer);
+    return *size == stream_size(stream);
+}
+
+static int
+    mjs_jsc_read_header(struct mjs* mjs, Stream* stream, struct mjs_jsc_header* header) {
+    return stream_read(stream, (uint8_t*)header, sizeof(*header)) == sizeof(*header) &&
+           header->magic == MJS_JSC_MAGIC && header->version == MJS_JSC_VERSION &&
+           header->build_id == mjs->jsc_build_id &&
+           header->bcode_size > sizeof(mjs_header_item_t) * MJS_HDR_ITEMS_CNT &&
+           header->bcode_size == stream_size(stream) - sizeof(*header);
+}
+
+MJS_PRIVATE int mjs_jsc_load(struct mjs* mjs, const char* path) {
+    int is_jsc = mjs_jsc_has_ext(path, ".jsc");
+    if(!is_jsc &&
+       !(mjs->generate_jsc && mjs->jsc_cache_dir && mjs_jsc_has_ext(path, ".js"))) {
+        return 0;
+    }
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    Stream* stream = file_stream_alloc(storage);
+    char* jsc_path = is_jsc ? NULL : mjs_jsc_get_path(mjs, path);
+    char* bcode = NULL;
+    struct mjs_jsc_header header;
+    int loaded = is_jsc ? -1 : 0;
+
+    do {
+        if(!file_stream_open(stream, is_jsc ? path : jsc_path, FSAM_READ, FSOM_OPEN_EXISTING)) {
+            break;
+        }
+        if(!mjs_jsc_read_header(mjs, stream, &header)) {
+            LOG(LL_DEBUG, ("%s: invalid or outdated .jsc", path));
+            break;
+        }
+
+        if(!is_jsc) {
+            /* Cache is only valid for the source it was built from */
+            Stream* source = file_stream_alloc(storage);
+            uint32_t crc = mjs_jsc_path_crc(path);
+            uint32_t size = 0;
+            int valid = file_stream_open(source, path, FSAM_READ, FSOM_OPEN_EXISTING) &&
+                        stream_size(source) == header.source_size &&
+                        mjs_jsc_hash_file(source, &crc, &size) && crc == header.source_crc;
+            file_stream_close(source);
+            stream_free(source);
+            if(!valid) {
+                LOG(LL_DEBUG, ("%s: stale .jsc", path));
+                break;
+            }
+        }
+
+        /* Bcode is read straight into the buffer that becomes the bcode part */
+        bcode = malloc(header.bcode_size);
+        if(stream_read(stream, (uint8_t*)bcode, header.bcode_size) != header.bcode_size ||
+           crc32_update(0xFFFFFFFF, bcode, header.bcode_size) != header.bcode_crc) {
+            LOG(LL_WARN, ("%s: corrupted .jsc", path));
+            /* Header is intact, so it would not be rewritten otherwise */
+            if(!is_jsc) storage_simply_remove(storage, jsc_path);
+            break;
+        }
+
+        mjs_header_item_t total_size;
+        memcpy(
+            &total_size,
+            bcode + 1 /* OP_BCODE_HEADER */ + sizeof(mjs_header_item_t) * MJS_HDR_ITEM_TOTAL_SIZE,
+            sizeof(total_size));
+        if(bcode[0] != OP_BCODE_HEADER || total_size + 1 != header.bcode_size) {
+            LOG(LL_WARN, ("%s: invalid bcode in .jsc", path));
+            if(!is_jsc) storage_simply_remove(storage, jsc_path);
+            break;
+        }
+
+        struct mjs_bcode_part bp;
+        memset(&bp, 0, sizeof(bp));
+        bp.data.p = bcode;
+        bp.data.len = header.bcode_size;
+        bp.start_idx = mjs->bcode_len;
+        bp.exec_res = MJS_ERRS_CNT;
+        mjs_bcode_part_add(mjs, &bp);
+        mjs->bcode_len += bp.data.len;
+
+        /* Ownership is transferred to the bcode part */
+        bcode = NULL;
+        loaded = 1;
+    } while(0);
+
+    free(bcode);
+    free(jsc_path);
+    file_stream_close(stream);
+    stream_free(stream);
+    furi_record_close(RECORD_STORAGE);
+
+    return loaded;
+}
+
+MJS_PRIVATE void mjs_jsc_save(struct mjs* mjs, const char* path, const char* src, size_t src_len) {
+    if(!mjs->jsc_cache_dir || !mjs_jsc_has_ext(path, ".js")) return;
+
+    struct mjs_bcode_part* bp = mjs_bcode_part_get(mjs, mjs_bcode_parts_cnt(mjs) - 1);
+    struct mjs_jsc_header header = {
+        .magic = MJS_JSC_MAGIC,
+        .version = MJS_JSC_VERSION,
+        .build_id = mjs->jsc_build_id,
+        .source_size = src_len,
+        .source_crc = crc32_update(mjs_jsc_path_crc(path), src, src_len),
+        .bcode_size = bp->data.len,
+        .bcode_crc = crc32_update(0xFFFFFFFF, bp->data.p, bp->data.len),
+    };
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    Stream* stream = file_stream_alloc(storage);
+    char* jsc_path = mjs_jsc_get_path(mjs, path);
+
+    do {
+        /* Don't wear the card if the file is up to date */
+        struct mjs_jsc_header current;
+        if(file_stream_open(stream, jsc_path, FSAM_READ, FSOM_OPEN_EXISTING) &&
+           mjs_jsc_read_header(mjs, stream, &current) &&
+           memcmp(&current, &header, sizeof(header)) == 0) {
+            break;
+        }
+        file_stream_close(stream);
+
+        storage_simply_mkdir(storage, mjs->jsc_cache_dir);
+        if(!file_stream_open(stream, jsc_path, FSAM_WRITE, FSOM_CREATE_ALWAYS)) {
+            LOG(LL_WARN, ("Failed to open %s for writing", jsc_path));
+            break;
+        }
+        if(stream_write(stream, (const uint8_t*)&header, sizeof(header)) != sizeof(header) ||
+           stream_write(stream, (const uint8_t*)bp->data.p, bp->data.len) != bp->data.len) {
+            LOG(LL_WARN, ("Failed to write %s", jsc_path));
+            file_stream_close(stream);
+            storage_simply_remove(storage, jsc_path);
+        }
+    } while(0);
+
+    free(jsc_path);
+    file_stream_close(stream);
+    stream_free(stream);
+    furi_record_close(RECORD_STORAGE);
+}
+
+#endif /* MJS_JSC_CACHE */
@@ -0,0 +1,42 @@
+#ifndef MJS_JSC_H_
+#define MJS_JSC_H_
+
+#include "mjs_internal.h"
+#include "mjs_core.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+/*
+ * Version of the .jsc file layout. Opcode count and bcode header size are
+ * mixed into the version stored in files, so adding an opcode invalidates
+ * caches by itself; bump this for any other change of bcode encoding.
+ */
+#define MJS_JSC_FORMAT_VERSION 2
+
+/*
+ * Loads bcode for `path` from the cache and adds it as a new bcode part.
+ *
+ * If `path` is a .jsc file, it is loaded as is, provided it was written by
+ * the same interpreter build. If `path` is a .js file and .jsc generation
+ * and cache directory are set, cache file for it is used only if it was
+ * built from the same source by the same interpreter build.
+ *
+ * Returns 1 if bcode was loaded, 0 if the source has to be parsed, -1 if
+ * `path` is a .jsc file that could not be loaded.
+ */
+MJS_PRIVATE int mjs_jsc_load(struct mjs* mjs, const char* path);
+
+/*
+ * Writes the last bcode part to cache file of the .js file `path`, keyed on
+ * `src` of `src_len` bytes it was parsed from. File is not rewritten if it
+ * is up to date. Nothing is written without cache directory.
+ */
+MJS_PRIVATE void mjs_jsc_save(struct mjs* mjs, const char* path, const char* src, size_t src_len);
+
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+
+#endif /* MJS_JSC_H_ */
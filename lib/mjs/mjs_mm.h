@@ -20,6 +20,7 @@ struct gc_block {
     struct gc_block* next;
     struct gc_cell* base;
     size_t size;
+    uint32_t marks[]; /* mark bits of the cells, one per cell */
 };
 
 struct gc_arena {
@@ -28,6 +29,16 @@ struct gc_arena {
     struct gc_cell* free; /* head of free list */
     size_t cell_size;
 
+    size_t cells; /* total number of cells in all blocks */
+    size_t free_cells; /* number of cells in the free list */
+
+    /*
+   * Incremental sweep state: next block to be swept (NULL if sweep is done)
+   * and the block preceding it in the `blocks` list (NULL if it is the head)
+   */
+    struct gc_block* sweep_block;
+    struct gc_block* sweep_prev;
+
 #if MJS_MEMORY_STATS
     unsigned long allocations; /* cumulative counter of allocations */
     unsigned long garbage; /* cumulative counter of garbage */
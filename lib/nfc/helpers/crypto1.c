@@ -41,24 +41,60 @@ void crypto1_init(Crypto1* crypto1, uint64_t key) {
     }
 }
 
-static uint32_t crypto1_filter(uint32_t in) {
-    uint32_t out = 0;
-    out = 0xf22c0 >> (in & 0xf) & 16;
-    out |= 0x6c9c0 >> (in >> 4 & 0xf) & 8;
-    out |= 0x3c8b0 >> (in >> 8 & 0xf) & 4;
-    out |= 0x1e458 >> (in >> 12 & 0xf) & 2;
+/* Filter function split into byte lookups: each table maps a byte of the odd
+ * register to the corresponding fa/fb output bits of the final fc index */
+static const uint8_t crypto1_filter_lut_low[256] = {
+    0, 0, 16, 16, 0, 16, 0, 0, 0, 16, 0, 0, 16, 16, 16, 16, 0, 0, 16, 16, 0, 16, 0, 0, 0, 16, 0,
+    0, 16, 16, 16, 16, 0, 0, 16, 16, 0, 16, 0, 0, 0, 16, 0, 0, 16, 16, 16, 16, 8, 8, 24, 24, 8,
+    24, 8, 8, 8, 24, 8, 8, 24, 24, 24, 24, 8, 8, 24, 24, 8, 24, 8, 8, 8, 24, 8, 8, 24, 24, 24, 24,
+    8, 8, 24, 24, 8, 24, 8, 8, 8, 24, 8, 8, 24, 24, 24, 24, 0, 0, 16, 16, 0, 16, 0, 0, 0, 16, 0,
+    0, 16, 16, 16, 16, 0, 0, 16, 16, 0, 16, 0, 0, 0, 16, 0, 0, 16, 16, 16, 16, 8, 8, 24, 24, 8,
+    24, 8, 8, 8, 24, 8, 8, 24, 24, 24, 24, 0, 0, 16, 16, 0, 16, 0, 0, 0, 16, 0, 0, 16, 16, 16, 16,
+    0, 0, 16, 16, 0, 16, 0, 0, 0, 16, 0, 0, 16, 16, 16, 16, 8, 8, 24, 24, 8, 24, 8, 8, 8, 24, 8,
+    8, 24, 24, 24, 24, 8, 8, 24, 24, 8, 24, 8, 8, 8, 24, 8, 8, 24, 24, 24, 24, 0, 0, 16, 16, 0,
+    16, 0, 0, 0, 16, 0, 0, 16, 16, 16, 16, 8, 8, 24, 24, 8, 24, 8, 8, 8, 24, 8, 8, 24, 24, 24, 24,
+    8, 8, 24, 24, 8, 24, 8, 8, 8, 24, 8, 8, 24, 24, 24, 24};
+
+static const uint8_t crypto1_filter_lut_high[256] = {
+    0, 0, 4, 4, 0, 4, 0, 0, 0, 4, 0, 0, 4, 4, 4, 4, 0, 0, 4, 4, 0, 4, 0, 0, 0, 4, 0, 0, 4, 4, 4,
+    4, 2, 2, 6, 6, 2, 6, 2, 2, 2, 6, 2, 2, 6, 6, 6, 6, 2, 2, 6, 6, 2, 6, 2, 2, 2, 6, 2, 2, 6, 6,
+    6, 6, 0, 0, 4, 4, 0, 4, 0, 0, 0, 4, 0, 0, 4, 4, 4, 4, 2, 2, 6, 6, 2, 6, 2, 2, 2, 6, 2, 2, 6,
+    6, 6, 6, 0, 0, 4, 4, 0, 4, 0, 0, 0, 4, 0, 0, 4, 4, 4, 4, 0, 0, 4, 4, 0, 4, 0, 0, 0, 4, 0, 0,
+    4, 4, 4, 4, 0, 0, 4, 4, 0, 4, 0, 0, 0, 4, 0, 0, 4, 4, 4, 4, 2, 2, 6, 6, 2, 6, 2, 2, 2, 6, 2,
+    2, 6, 6, 6, 6, 0, 0, 4, 4, 0, 4, 0, 0, 0, 4, 0, 0, 4, 4, 4, 4, 0, 0, 4, 4, 0, 4, 0, 0, 0, 4,
+    0, 0, 4, 4, 4, 4, 2, 2, 6, 6, 2, 6, 2, 2, 2, 6, 2, 2, 6, 6, 6, 6, 2, 2, 6, 6, 2, 6, 2, 2, 2,
+    6, 2, 2, 6, 6, 6, 6, 2, 2, 6, 6, 2, 6, 2, 2, 2, 6, 2, 2, 6, 6, 6, 6, 2, 2, 6, 6, 2, 6, 2, 2,
+    2, 6, 2, 2, 6, 6, 6, 6};
+
+static FURI_ALWAYS_INLINE uint32_t crypto1_filter(uint32_t in) {
+    uint32_t out = crypto1_filter_lut_low[in & 0xff];
+    out |= crypto1_filter_lut_high[in >> 8 & 0xff];
     out |= 0x0d938 >> (in >> 16 & 0xf) & 1;
     return FURI_BIT(0xEC57E80A, out);
 }
 
+static FURI_ALWAYS_INLINE uint32_t crypto1_parity(uint32_t x) {
+    x ^= x >> 16;
+    x ^= x >> 8;
+    x ^= x >> 4;
+    return 0x6996 >> (x & 0xf) & 1;
+}
+
+/* One LFSR step. Odd and even halves swap roles on each step,
+ * so callers advance two bits at a time with arguments exchanged. */
+static FURI_ALWAYS_INLINE uint32_t
+    crypto1_step(uint32_t odd, uint32_t* even, uint32_t in, uint32_t is_encrypted) {
+    uint32_t out = crypto1_filter(odd);
+    uint32_t feed = (out & is_encrypted) ^ in;
+    feed ^= LF_POLY_ODD & odd;
+    feed ^= LF_POLY_EVEN & *even;
+    *even = *even << 1 | crypto1_parity(feed);
+    return out;
+}
+
 uint8_t crypto1_bit(Crypto1* crypto1, uint8_t in, int is_encrypted) {
     furi_assert(crypto1);
-    uint8_t out = crypto1_filter(crypto1->odd);
-    uint32_t feed = out & (!!is_encrypted);
-    feed ^= !!in;
-    feed ^= LF_POLY_ODD & crypto1->odd;
-    feed ^= LF_POLY_EVEN & crypto1->even;
-    crypto1->even = crypto1->even << 1 | (nfc_util_even_parity32(feed));
+    uint8_t out = crypto1_step(crypto1->odd, &crypto1->even, !!in, !!is_encrypted);
 
     FURI_SWAP(crypto1->odd, crypto1->even);
     return out;
@@ -66,22 +102,124 @@ uint8_t crypto1_bit(Crypto1* crypto1, uint8_t in, int is_encrypted) {
 
 uint8_t crypto1_byte(Crypto1* crypto1, uint8_t in, int is_encrypted) {
     furi_assert(crypto1);
-    uint8_t out = 0;
-    for(uint8_t i = 0; i < 8; i++) {
-        out |= crypto1_bit(crypto1, FURI_BIT(in, i), is_encrypted) << i;
+    uint32_t odd = crypto1->odd;
+    uint32_t even = crypto1->even;
+    uint32_t fb = !!is_encrypted;
+    uint32_t out = 0;
+    for(uint8_t i = 0; i < 8; i += 2) {
+        out |= crypto1_step(odd, &even, FURI_BIT(in, i), fb) << i;
+        out |= crypto1_step(even, &odd, FURI_BIT(in, i + 1), fb) << (i + 1);
     }
+    crypto1->odd = odd;
+    crypto1->even = even;
     return out;
 }
 
 uint32_t crypto1_word(Crypto1* crypto1, uint32_t in, int is_encrypted) {
     furi_assert(crypto1);
+    uint32_t odd = crypto1->odd;
+    uint32_t even = crypto1->even;
+    uint32_t fb = !!is_encrypted;
     uint32_t out = 0;
-    for(uint8_t i = 0; i < 32; i++) {
-        out |= (uint32_t)crypto1_bit(crypto1, BEBIT(in, i), is_encrypted) << (24 ^ i);
+    for(uint8_t i = 0; i < 32; i += 2) {
+        out |= crypto1_step(odd, &even, BEBIT(in, i), fb) << (24 ^ i);
+        out |= crypto1_step(even, &odd, BEBIT(in, i + 1), fb) << (24 ^ (i + 1));
     }
+    crypto1->odd = odd;
+    crypto1->even = even;
     return out;
 }
 
+/* Bit-sliced evaluation of 4 input boolean function given by 16 bit truth table */
+static uint32_t
+    crypto1_batch_lut4(uint16_t table, uint32_t b0, uint32_t b1, uint32_t b2, uint32_t b3) {
+    uint32_t r[8];
+    for(uint8_t i = 0; i < 8; i++) {
+        uint32_t lo = FURI_BIT(table, 2 * i) ? UINT32_MAX : 0;
+        uint32_t hi = FURI_BIT(table, 2 * i + 1) ? UINT32_MAX : 0;
+        r[i] = lo ^ ((lo ^ hi) & b0);
+    }
+    for(uint8_t i = 0; i < 4; i++) {
+        r[i] = r[2 * i] ^ ((r[2 * i] ^ r[2 * i + 1]) & b1);
+    }
+    for(uint8_t i = 0; i < 2; i++) {
+        r[i] = r[2 * i] ^ ((r[2 * i] ^ r[2 * i + 1]) & b2);
+    }
+    return r[0] ^ ((r[0] ^ r[1]) & b3);
+}
+
+/* Bit-sliced LFSR is kept as a stream of bits where the newest one is at head[0].
+ * Bit i of odd register is head[-2 * i], bit i of even register is head[-1 - 2 * i]. */
+static const uint8_t crypto1_batch_taps[] = {
+    4, 5, 6, 8, 12, 18, 20, 22, 23, 28, 30, 32, 33, 35, 37, 38, 42, 47,
+};
+
+static uint32_t crypto1_batch_filter(const uint32_t* head) {
+    uint32_t n0 = crypto1_batch_lut4(0xf22c, head[0], head[-2], head[-4], head[-6]);
+    uint32_t n1 = crypto1_batch_lut4(0xd938, head[-8], head[-10], head[-12], head[-14]);
+    uint32_t n2 = crypto1_batch_lut4(0xf22c, head[-16], head[-18], head[-20], head[-22]);
+    uint32_t n3 = crypto1_batch_lut4(0xf22c, head[-24], head[-26], head[-28], head[-30]);
+    uint32_t n4 = crypto1_batch_lut4(0xd938, head[-32], head[-34], head[-36], head[-38]);
+    uint32_t lo = crypto1_batch_lut4(0xE80A, n4, n3, n2, n1);
+    uint32_t hi = crypto1_batch_lut4(0xEC57, n4, n3, n2, n1);
+    return lo ^ ((lo ^ hi) & n0);
+}
+
+/* In place transpose of 32x32 bit matrix, Hacker's Delight 7-3 */
+static void crypto1_batch_transpose(uint32_t* matrix) {
+    uint32_t mask = 0x0000FFFF;
+    for(uint32_t j = 16; j != 0; j >>= 1, mask ^= mask << j) {
+        for(uint32_t k = 0; k < 32; k = (k + j + 1) & ~j) {
+            uint32_t t = (matrix[k] ^ (matrix[k + j] >> j)) & mask;
+            matrix[k] ^= t;
+            matrix[k + j] ^= t << j;
+        }
+    }
+}
+
+void crypto1_batch_init(Crypto1Batch* batch, const uint64_t* keys, size_t count) {
+    furi_assert(batch);
+    furi_assert(keys);
+    furi_check(count <= CRYPTO1_BATCH_SIZE);
+
+    memset(batch, 0, sizeof(Crypto1Batch));
+    for(size_t lane = 0; lane < count; lane++) {
+        for(uint8_t i = 0; i < CRYPTO1_LFSR_SIZE; i++) {
+            batch->lfsr[CRYPTO1_LFSR_SIZE - 1 - i] |= (uint32_t)FURI_BIT(keys[lane], i ^ 7)
+                                                      << lane;
+        }
+    }
+}
+
+void crypto1_batch_word(Crypto1Batch* batch, uint32_t in, int is_encrypted, uint32_t* out) {
+    furi_assert(batch);
+    furi_assert(out);
+
+    // New bits are appended to the window instead of shifting the whole state
+    uint32_t window[CRYPTO1_LFSR_SIZE + 32];
+    memcpy(window, batch->lfsr, sizeof(batch->lfsr));
+
+    uint32_t fb = is_encrypted ? UINT32_MAX : 0;
+    for(uint8_t i = 0; i < 32; i++) {
+        const uint32_t* head = &window[CRYPTO1_LFSR_SIZE - 1 + i];
+        uint32_t ks = crypto1_batch_filter(head);
+        uint32_t feed = (ks & fb) ^ (BEBIT(in, i) ? UINT32_MAX : 0);
+        for(size_t j = 0; j < COUNT_OF(crypto1_batch_taps); j++) {
+            feed ^= head[-crypto1_batch_taps[j]];
+        }
+        window[CRYPTO1_LFSR_SIZE + i] = feed;
+        // Keystream bit (24 ^ i) of every lane goes to matrix column of the same index
+        out[31 - (24 ^ i)] = ks;
+    }
+
+    memcpy(batch->lfsr, &window[32], sizeof(batch->lfsr));
+
+    crypto1_batch_transpose(out);
+    for(uint8_t i = 0; i < 16; i++) {
+        FURI_SWAP(out[i], out[31 - i]);
+    }
+}
+
 uint32_t prng_successor(uint32_t x, uint32_t n) {
     SWAPENDIAN(x);
     while(n--)
@@ -7,11 +7,23 @@
 extern "C" {
 #endif
 
+#define CRYPTO1_LFSR_SIZE  (48U)
+#define CRYPTO1_BATCH_SIZE (32U)
+
 typedef struct {
     uint32_t odd;
     uint32_t even;
 } Crypto1;
 
+/** Up to CRYPTO1_BATCH_SIZE independent ciphers advanced together.
+ *
+ * State is bit-sliced: lfsr[i] holds LFSR bit i of every cipher, one cipher per bit.
+ * Meant for testing many key candidates against the same data at once.
+ */
+typedef struct {
+    uint32_t lfsr[CRYPTO1_LFSR_SIZE];
+} Crypto1Batch;
+
 Crypto1* crypto1_alloc(void);
 
 void crypto1_free(Crypto1* instance);
@@ -26,6 +38,23 @@ uint8_t crypto1_byte(Crypto1* crypto1, uint8_t in, int is_encrypted);
 
 uint32_t crypto1_word(Crypto1* crypto1, uint32_t in, int is_encrypted);
 
+/** Initialize batch of ciphers, one per key.
+ *
+ * @param[out] batch pointer to the batch instance
+ * @param[in] keys keys in the same format as for crypto1_init()
+ * @param[in] count number of keys, up to CRYPTO1_BATCH_SIZE. Remaining lanes are zeroed.
+ */
+void crypto1_batch_init(Crypto1Batch* batch, const uint64_t* keys, size_t count);
+
+/** Advance all ciphers of batch by one word, same as crypto1_word() does for single cipher.
+ *
+ * @param[in,out] batch pointer to the batch instance
+ * @param[in] in input word shared by all ciphers
+ * @param[in] is_encrypted whether input is encrypted with cipher output
+ * @param[out] out CRYPTO1_BATCH_SIZE output words, one per cipher
+ */
+void crypto1_batch_word(Crypto1Batch* batch, uint32_t in, int is_encrypted, uint32_t* out);
+
 void crypto1_decrypt(Crypto1* crypto, const BitBuffer* buff, BitBuffer* out);
 
 void crypto1_encrypt(Crypto1* crypto, uint8_t* keystream, const BitBuffer* buff, BitBuffer* out);
@@ -1,10 +1,10 @@
 #include "iso13239_crc.h"
 
 #include <core/check.h>
+#include <toolbox/crc.h>
 
 #define ISO13239_CRC_INIT_DEFAULT  (0xFFFFU)
 #define ISO13239_CRC_INIT_PICOPASS (0xE012U)
-#define ISO13239_CRC_POLY          (0x8408U)
 
 static uint16_t
     iso13239_crc_calculate(Iso13239CrcType type, const uint8_t* data, size_t data_size) {
@@ -18,16 +18,7 @@ static uint16_t
         furi_crash("Wrong ISO13239 CRC type");
     }
 
-    for(size_t i = 0; i < data_size; ++i) {
-        crc ^= (uint16_t)data[i];
-        for(size_t j = 0; j < 8; ++j) {
-            if(crc & 1U) {
-                crc = (crc >> 1) ^ ISO13239_CRC_POLY;
-            } else {
-                crc >>= 1;
-            }
-        }
-    }
+    crc = crc16_ccitt_reflected_update(crc, data, data_size);
 
     return type == Iso13239CrcTypePicopass ? crc : ~crc;
 }
@@ -0,0 +1,296 @@
+#include "mf_classic_key_stats.h"
+
+#include <furi/furi.h>
+#include <storage/storage.h>
+#include <flipper_format/flipper_format.h>
+
+#define TAG "MfClassicKeyStats"
+
+static const char* mf_classic_key_stats_file_header = "Flipper NFC key stats";
+static const uint32_t mf_classic_key_stats_file_version = 1;
+
+typedef struct {
+    MfClassicKey key;
+    /* Number of cards the key was found on */
+    uint16_t hits;
+    /* Number of cards the key was found on, per sector */
+    uint8_t sector_hits[MF_CLASSIC_TOTAL_SECTORS_MAX];
+} MfClassicKeyStatsEntry;
+
+struct MfClassicKeyStats {
+    MfClassicKeyStatsEntry entries[MF_CLASSIC_KEY_STATS_KEYS_MAX];
+    size_t keys_num;
+    uint32_t cards_num;
+
+    uint8_t order[MF_CLASSIC_KEY_STATS_KEYS_MAX];
+    size_t order_pos;
+};
+
+MfClassicKeyStats* mf_classic_key_stats_alloc(void) {
+    MfClassicKeyStats* instance = malloc(sizeof(MfClassicKeyStats));
+
+    return instance;
+}
+
+void mf_classic_key_stats_free(MfClassicKeyStats* instance) {
+    furi_check(instance);
+
+    free(instance);
+}
+
+void mf_classic_key_stats_reset(MfClassicKeyStats* instance) {
+    furi_check(instance);
+
+    memset(instance, 0, sizeof(MfClassicKeyStats));
+}
+
+bool mf_classic_key_stats_load(MfClassicKeyStats* instance, const char* path) {
+    furi_check(instance);
+    furi_check(path);
+
+    mf_classic_key_stats_reset(instance);
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FlipperFormat* ff = flipper_format_buffered_file_alloc(storage);
+    FuriString* temp_str = furi_string_alloc();
+
+    bool load_success = false;
+    do {
+        if(!flipper_format_buffered_file_open_existing(ff, path)) break;
+
+        uint32_t version = 0;
+        if(!flipper_format_read_header(ff, temp_str, &version)) break;
+        if(furi_string_cmp_str(temp_str, mf_classic_key_stats_file_header)) break;
+        if(version != mf_classic_key_stats_file_version) break;
+
+        uint32_t keys_num = 0;
+        if(!flipper_format_read_uint32(ff, "Cards", &instance->cards_num, 1)) break;
+        if(!flipper_format_read_uint32(ff, "Keys", &keys_num, 1)) break;
+        if(keys_num > MF_CLASSIC_KEY_STATS_KEYS_MAX) break;
+
+        bool key_read_success = true;
+        for(size_t i = 0; (i < keys_num) && key_read_success; i++) {
+            MfClassicKeyStatsEntry* entry = &instance->entries[i];
+            uint32_t hits = 0;
+
+            furi_string_printf(temp_str, "Key %u", i);
+            key_read_success = flipper_format_read_hex(
+                ff, furi_string_get_cstr(temp_str), entry->key.data, sizeof(MfClassicKey));
+            if(!key_read_success) break;
+            furi_string_printf(temp_str, "Hits %u", i);
+            key_read_success =
+                flipper_format_read_uint32(ff, furi_string_get_cstr(temp_str), &hits, 1);
+            if(!key_read_success) break;
+            entry->hits = MIN(hits, UINT16_MAX);
+            furi_string_printf(temp_str, "Sector hits %u", i);
+            key_read_success = flipper_format_read_hex(
+                ff,
+                furi_string_get_cstr(temp_str),
+                entry->sector_hits,
+                sizeof(entry->sector_hits));
+        }
+        if(!key_read_success) break;
+
+        instance->keys_num = keys_num;
+        load_success = true;
+    } while(false);
+
+    if(!load_success) {
+        FURI_LOG_D(TAG, "No valid stats in %s", path);
+        mf_classic_key_stats_reset(instance);
+    }
+
+    furi_string_free(temp_str);
+    flipper_format_free(ff);
+    furi_record_close(RECORD_STORAGE);
+
+    return load_success;
+}
+
+bool mf_classic_key_stats_save(const MfClassicKeyStats* instance, const char* path) {
+    furi_check(instance);
+    furi_check(path);
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FlipperFormat* ff = flipper_format_buffered_file_alloc(storage);
+    FuriString* temp_str = furi_string_alloc();
+
+    bool save_success = false;
+    do {
+        if(!flipper_format_buffered_file_open_always(ff, path)) break;
+
+        if(!flipper_format_write_header_cstr(
+               ff, mf_classic_key_stats_file_header, mf_classic_key_stats_file_version))
+            break;
+
+        uint32_t keys_num = instance->keys_num;
+        if(!flipper_format_write_uint32(ff, "Cards", &instance->cards_num, 1)) break;
+        if(!flipper_format_write_uint32(ff, "Keys", &keys_num, 1)) break;
+
+        bool key_save_success = true;
+        for(size_t i = 0; (i < keys_num) && key_save_success; i++) {
+            const MfClassicKeyStatsEntry* entry = &instance->entries[i];
+            uint32_t hits = entry->hits;
+
+            furi_string_printf(temp_str, "Key %u", i);
+            key_save_success = flipper_format_write_hex(
+                ff, furi_string_get_cstr(temp_str), entry->key.data, sizeof(MfClassicKey));
+            if(!key_save_success) break;
+            furi_string_printf(temp_str, "Hits %u", i);
+            key_save_success =
+                flipper_format_write_uint32(ff, furi_string_get_cstr(temp_str), &hits, 1);
+            if(!key_save_success) break;
+            furi_string_printf(temp_str, "Sector hits %u", i);
+            key_save_success = flipper_format_write_hex(
+                ff,
+                furi_string_get_cstr(temp_str),
+                entry->sector_hits,
+                sizeof(entry->sector_hits));
+        }
+        save_success = key_save_success;
+    } while(false);
+
+    furi_string_free(temp_str);
+    flipper_format_free(ff);
+    furi_record_close(RECORD_STORAGE);
+
+    return save_success;
+}
+
+/* Halve all counters, so old cards weigh less than new ones and counters don't overflow */
+static void mf_classic_key_stats_age(MfClassicKeyStats* instance) {
+    for(size_t i = 0; i < instance->keys_num; i++) {
+        MfClassicKeyStatsEntry* entry = &instance->entries[i];
+        entry->hits >>= 1;
+        for(size_t j = 0; j < MF_CLASSIC_TOTAL_SECTORS_MAX; j++) {
+            entry->sector_hits[j] >>= 1;
+        }
+    }
+}
+
+static int32_t mf_classic_key_stats_get_entry(
+    MfClassicKeyStats* instance,
+    const MfClassicKey* key,
+    const bool* is_on_card) {
+    for(size_t i = 0; i < instance->keys_num; i++) {
+        if(memcmp(instance->entries[i].key.data, key->data, sizeof(MfClassicKey)) == 0) {
+            return i;
+        }
+    }
+
+    int32_t index = -1;
+    if(instance->keys_num < MF_CLASSIC_KEY_STATS_KEYS_MAX) {
+        index = instance->keys_num++;
+    } else {
+        // Evict the least found key, keeping keys already seen on this card
+        for(size_t i = 0; i < instance->keys_num; i++) {
+            if(is_on_card[i]) continue;
+            if((index < 0) || (instance->entries[i].hits < instance->entries[index].hits)) {
+                index = i;
+            }
+        }
+    }
+
+    if(index >= 0) {
+        memset(&instance->entries[index], 0, sizeof(MfClassicKeyStatsEntry));
+        instance->entries[index].key = *key;
+    }
+
+    return index;
+}
+
+static void mf_classic_key_stats_add_key(
+    MfClassicKeyStats* instance,
+    const MfClassicKey* key,
+    uint8_t sector_num,
+    bool* is_on_card) {
+    int32_t index = mf_classic_key_stats_get_entry(instance, key, is_on_card);
+    if(index < 0) return;
+
+    MfClassicKeyStatsEntry* entry = &instance->entries[index];
+    if((entry->hits == UINT16_MAX) || (entry->sector_hits[sector_num] == UINT8_MAX)) {
+        mf_classic_key_stats_age(instance);
+    }
+    if(!is_on_card[index]) {
+        is_on_card[index] = true;
+        entry->hits++;
+    }
+    entry->sector_hits[sector_num]++;
+}
+
+void mf_classic_key_stats_add_card(MfClassicKeyStats* instance, const MfClassicData* data) {
+    furi_check(instance);
+    furi_check(data);
+
+    bool is_on_card[MF_CLASSIC_KEY_STATS_KEYS_MAX] = {};
+    uint8_t sectors_num = mf_classic_get_total_sectors_num(data->type);
+
+    for(uint8_t i = 0; i < sectors_num; i++) {
+        const MfClassicSectorTrailer* sec_tr = mf_classic_get_sector_trailer_by_sector(data, i);
+        bool key_a_found = mf_classic_is_key_found(data, i, MfClassicKeyTypeA);
+        bool key_b_found = mf_classic_is_key_found(data, i, MfClassicKeyTypeB);
+
+        bool keys_equal =
+            memcmp(sec_tr->key_a.data, sec_tr->key_b.data, sizeof(MfClassicKey)) == 0;
+
+        if(key_a_found) {
+            mf_classic_key_stats_add_key(instance, &sec_tr->key_a, i, is_on_card);
+        }
+        if(key_b_found && !(key_a_found && keys_equal)) {
+            mf_classic_key_stats_add_key(instance, &sec_tr->key_b, i, is_on_card);
+        }
+    }
+
+    instance->cards_num++;
+}
+
+size_t mf_classic_key_stats_get_keys_num(const MfClassicKeyStats* instance) {
+    furi_check(instance);
+
+    return instance->keys_num;
+}
+
+uint32_t mf_classic_key_stats_get_cards_num(const MfClassicKeyStats* instance) {
+    furi_check(instance);
+
+    return instance->cards_num;
+}
+
+static bool mf_classic_key_stats_is_before(
+    const MfClassicKeyStatsEntry* a,
+    const MfClassicKeyStatsEntry* b,
+    uint8_t sector_num) {
+    if(a->sector_hits[sector_num] != b->sector_hits[sector_num]) {
+        return a->sector_hits[sector_num] > b->sector_hits[sector_num];
+    }
+    return a->hits > b->hits;
+}
+
+void mf_classic_key_stats_rewind(MfClassicKeyStats* instance, uint8_t sector_num) {
+    furi_check(instance);
+    furi_check(sector_num < MF_CLASSIC_TOTAL_SECTORS_MAX);
+
+    instance->order_pos = 0;
+
+    // Insertion sort, stable and fast enough for a few dozen keys
+    for(size_t i = 0; i < instance->keys_num; i++) {
+        size_t j = i;
+        for(; j > 0; j--) {
+            const MfClassicKeyStatsEntry* prev = &instance->entries[instance->order[j - 1]];
+            if(!mf_classic_key_stats_is_before(&instance->entries[i], prev, sector_num)) break;
+            instance->order[j] = instance->order[j - 1];
+        }
+        instance->order[j] = i;
+    }
+}
+
+bool mf_classic_key_stats_get_next_key(MfClassicKeyStats* instance, MfClassicKey* key) {
+    furi_check(instance);
+    furi_check(key);
+
+    if(instance->order_pos >= instance->keys_num) return false;
+
+    *key = instance->entries[instance->order[instance->order_pos++]].key;
+
+    return true;
+}
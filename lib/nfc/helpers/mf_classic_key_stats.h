@@ -0,0 +1,113 @@
+#pragma once
+
+#include "protocols/mf_classic/mf_classic.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file mf_classic_key_stats.h
+ * @brief MIFARE Classic key usage statistics.
+ *
+ * Keeps track of which keys were found on previously read cards and in which
+ * sectors. Keys are then offered to the dictionary attack ordered by how often
+ * they were found in the sector being attacked and on cards in general, so keys
+ * common to a card system are tried before the rest of the dictionary.
+ */
+
+/** Maximum number of keys kept in statistics, least found keys are evicted first. */
+#define MF_CLASSIC_KEY_STATS_KEYS_MAX (32U)
+
+typedef struct MfClassicKeyStats MfClassicKeyStats;
+
+/**
+ * @brief Allocate an empty MfClassicKeyStats instance.
+ *
+ * @returns pointer to the allocated instance.
+ */
+MfClassicKeyStats* mf_classic_key_stats_alloc(void);
+
+/**
+ * @brief Delete an MfClassicKeyStats instance.
+ *
+ * @param[in,out] instance pointer to the instance to be deleted.
+ */
+void mf_classic_key_stats_free(MfClassicKeyStats* instance);
+
+/**
+ * @brief Remove all keys from statistics.
+ *
+ * @param[in,out] instance pointer to the instance to be reset.
+ */
+void mf_classic_key_stats_reset(MfClassicKeyStats* instance);
+
+/**
+ * @brief Load statistics from a file.
+ *
+ * Statistics are reset if the file is missing or invalid.
+ *
+ * @param[in,out] instance pointer to the instance to be loaded.
+ * @param[in] path pointer to the full path of the file.
+ * @returns true if the file was loaded successfully, false otherwise.
+ */
+bool mf_classic_key_stats_load(MfClassicKeyStats* instance, const char* path);
+
+/**
+ * @brief Save statistics to a file.
+ *
+ * @param[in] instance pointer to the instance to be saved.
+ * @param[in] path pointer to the full path of the file.
+ * @returns true if the file was saved successfully, false otherwise.
+ */
+bool mf_classic_key_stats_save(const MfClassicKeyStats* instance, const char* path);
+
+/**
+ * @brief Record all keys found on a card.
+ *
+ * Every key counts once per card, and once per sector it was found in.
+ *
+ * @param[in,out] instance pointer to the instance to be updated.
+ * @param[in] data pointer to the card data with found keys.
+ */
+void mf_classic_key_stats_add_card(MfClassicKeyStats* instance, const MfClassicData* data);
+
+/**
+ * @brief Get the number of keys in statistics.
+ *
+ * @param[in] instance pointer to the instance to be queried.
+ * @returns number of keys.
+ */
+size_t mf_classic_key_stats_get_keys_num(const MfClassicKeyStats* instance);
+
+/**
+ * @brief Get the number of cards recorded in statistics.
+ *
+ * @param[in] instance pointer to the instance to be queried.
+ * @returns number of cards.
+ */
+uint32_t mf_classic_key_stats_get_cards_num(const MfClassicKeyStats* instance);
+
+/**
+ * @brief Start iterating over keys for a sector.
+ *
+ * Keys found in this sector most often come first, followed by keys found
+ * on most cards.
+ *
+ * @param[in,out] instance pointer to the instance to be iterated.
+ * @param[in] sector_num sector number the keys will be tried against.
+ */
+void mf_classic_key_stats_rewind(MfClassicKeyStats* instance, uint8_t sector_num);
+
+/**
+ * @brief Get the next key for the sector set by mf_classic_key_stats_rewind().
+ *
+ * @param[in,out] instance pointer to the instance to be iterated.
+ * @param[out] key pointer to the key to be filled.
+ * @returns true if a key was provided, false if all keys were iterated.
+ */
+bool mf_classic_key_stats_get_next_key(MfClassicKeyStats* instance, MfClassicKey* key);
+
+#ifdef __cplusplus
+}
+#endif
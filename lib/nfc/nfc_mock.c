@@ -1,6 +1,7 @@
 #ifdef FW_CFG_unit_tests
 
 #include <lib/nfc/nfc.h>
+#include <lib/nfc/nfc_mock.h>
 #include <lib/nfc/helpers/iso14443_crc.h>
 #include <lib/nfc/protocols/iso14443_3a/iso14443_3a.h>
 #include <lib/nfc/protocols/felica/felica.h>
@@ -19,6 +20,9 @@ typedef enum {
 FuriMessageQueue* poller_queue = NULL;
 FuriMessageQueue* listener_queue = NULL;
 
+static bool nfc_mock_trace = true;
+static volatile uint32_t nfc_mock_frame_count = 0;
+
 typedef enum {
     NfcMessageTypeTx,
     NfcMessageTypeTimeout,
@@ -84,15 +88,30 @@ struct Nfc {
     void* context;
 
     NfcMode mode;
+    bool listener_responded;
 
     FuriThread* worker_thread;
 };
 
+void nfc_mock_set_trace(bool enable) {
+    nfc_mock_trace = enable;
+}
+
+uint32_t nfc_mock_get_frame_count(void) {
+    return nfc_mock_frame_count;
+}
+
+void nfc_mock_reset_frame_count(void) {
+    nfc_mock_frame_count = 0;
+}
+
 static void nfc_test_print(
     NfcTransportLogLevel log_level,
     const char* message,
     uint8_t* buffer,
     uint16_t bits) {
+    if(!nfc_mock_trace) return;
+
     FuriString* str = furi_string_alloc();
     size_t bytes = (bits + 7) / 8;
 
@@ -322,8 +341,14 @@ static int32_t nfc_worker_listener(void* context) {
                     instance, message.data.data, message.data.data_bits);
             } else {
                 instance->state = NfcStateReady;
+                instance->listener_responded = false;
                 nfc_event.type = NfcEventTypeRxEnd;
                 instance->callback(nfc_event, instance->context);
+                if(!instance->listener_responded) {
+                    // Listener stays silent, don't make poller wait for the whole timeout
+                    NfcMessage timeout_message = {.type = NfcMessageTypeTimeout};
+                    furi_message_queue_put(poller_queue, &timeout_message, FuriWaitForever);
+                }
             }
         }
     }
@@ -413,6 +438,8 @@ NfcError nfc_listener_tx(Nfc* instance, const BitBuffer* tx_buffer) {
     message.data.data_bits = bit_buffer_get_size(tx_buffer);
     bit_buffer_write_bytes(tx_buffer, message.data.data, bit_buffer_get_size_bytes(tx_buffer));
 
+    instance->listener_responded = true;
+    nfc_mock_frame_count++;
     furi_message_queue_put(poller_queue, &message, FuriWaitForever);
 
     return NfcErrorNone;
@@ -437,6 +464,7 @@ NfcError
     message.type = NfcMessageTypeTx;
     message.data.data_bits = bit_buffer_get_size(tx_buffer);
     bit_buffer_write_bytes(tx_buffer, message.data.data, bit_buffer_get_size_bytes(tx_buffer));
+    nfc_mock_frame_count++;
     // Tx
     furi_check(furi_message_queue_put(listener_queue, &message, FuriWaitForever) == FuriStatusOk);
     // Rx
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file nfc_mock.h
+ * @brief Loopback NFC transport controls.
+ *
+ * In unit test builds nfc.c is replaced with a loopback transport that passes
+ * frames between a poller and a listener running on the same device.
+ * These functions are only available in such builds.
+ */
+
+/**
+ * @brief Enable or disable logging of every transferred frame.
+ *
+ * Tracing is enabled by default. Disable it for throughput measurements
+ * and fuzzing, since logging dominates the transfer time.
+ *
+ * @param[in] enable true to log frames, false otherwise.
+ */
+void nfc_mock_set_trace(bool enable);
+
+/**
+ * @brief Get number of frames transferred in both directions.
+ *
+ * @returns number of frames since last reset.
+ */
+uint32_t nfc_mock_get_frame_count(void);
+
+/**
+ * @brief Reset transferred frames counter.
+ */
+void nfc_mock_reset_frame_count(void);
+
+#ifdef __cplusplus
+}
+#endif
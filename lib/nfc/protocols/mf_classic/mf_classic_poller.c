@@ -102,6 +102,35 @@ static NfcCommand mf_classic_poller_handle_data_update(MfClassicPoller* instance
     return instance->callback(instance->general_event, instance->context);
 }
 
+static void mf_classic_poller_close_reuse_session(MfClassicPoller* instance) {
+    MfClassicPollerDictAttackContext* dict_attack_ctx = &instance->mode_ctx.dict_attack_ctx;
+
+    if(dict_attack_ctx->reuse_session_active) {
+        mf_classic_poller_halt(instance);
+        dict_attack_ctx->reuse_session_active = false;
+    }
+}
+
+static MfClassicError mf_classic_poller_key_reuse_auth(
+    MfClassicPoller* instance,
+    uint8_t block_num,
+    MfClassicKeyType key_type) {
+    MfClassicPollerDictAttackContext* dict_attack_ctx = &instance->mode_ctx.dict_attack_ctx;
+    MfClassicError error = MfClassicErrorNone;
+
+    if(dict_attack_ctx->reuse_session_active) {
+        // Nested auth within the open session saves HALT timeout and card reactivation
+        dict_attack_ctx->reuse_session_active = false;
+        error = mf_classic_poller_auth_nested(
+            instance, block_num, &dict_attack_ctx->current_key, key_type, NULL, false, false);
+    } else {
+        error = mf_classic_poller_auth(
+            instance, block_num, &dict_attack_ctx->current_key, key_type, NULL, false);
+    }
+
+    return error;
+}
+
 static void mf_classic_poller_check_key_b_is_readable(
     MfClassicPoller* instance,
     uint8_t block_num,
@@ -715,7 +744,6 @@ NfcCommand mf_classic_poller_handler_auth_a(MfClassicPoller* instance) {
             dict_attack_ctx->auth_passed = true;
             instance->state = MfClassicPollerStateReadSector;
         } else {
-            mf_classic_poller_halt(instance);
             instance->state = MfClassicPollerStateAuthKeyB;
         }
     }
@@ -755,7 +783,6 @@ NfcCommand mf_classic_poller_handler_auth_b(MfClassicPoller* instance) {
             dict_attack_ctx->auth_passed = true;
             instance->state = MfClassicPollerStateReadSector;
         } else {
-            mf_classic_poller_halt(instance);
             instance->state = MfClassicPollerStateRequestKey;
         }
     }
@@ -827,10 +854,12 @@ NfcCommand mf_classic_poller_handler_read_sector(MfClassicPoller* instance) {
     if(dict_attack_ctx->current_block > sec_tr_block_num) {
         mf_classic_poller_handle_data_update(instance);
 
-        mf_classic_poller_halt(instance);
+        // Keep the card authenticated, key reuse continues with nested auth
+        dict_attack_ctx->reuse_session_active = dict_attack_ctx->auth_passed;
         dict_attack_ctx->auth_passed = false;
 
         if(dict_attack_ctx->current_sector == instance->sectors_total) {
+            mf_classic_poller_close_reuse_session(instance);
             instance->state = MfClassicPollerStateNextSector;
         } else {
             dict_attack_ctx->reuse_key_sector = dict_attack_ctx->current_sector;
@@ -856,6 +885,7 @@ NfcCommand mf_classic_poller_handler_key_reuse_start(MfClassicPoller* instance)
         } else {
             dict_attack_ctx->reuse_key_sector++;
             if(dict_attack_ctx->reuse_key_sector == instance->sectors_total) {
+                mf_classic_poller_close_reuse_session(instance);
                 instance->mfc_event.type = MfClassicPollerEventTypeKeyAttackStop;
                 command = instance->callback(instance->general_event, instance->context);
                 // Nested entrypoint
@@ -912,8 +942,8 @@ NfcCommand mf_classic_poller_handler_key_reuse_auth_key_a(MfClassicPoller* insta
             bit_lib_bytes_to_num_be(dict_attack_ctx->current_key.data, sizeof(MfClassicKey));
         FURI_LOG_D(TAG, "Key attack auth to block %d with key A: %06llx", block, key);
 
-        MfClassicError error = mf_classic_poller_auth(
-            instance, block, &dict_attack_ctx->current_key, MfClassicKeyTypeA, NULL, false);
+        MfClassicError error =
+            mf_classic_poller_key_reuse_auth(instance, block, MfClassicKeyTypeA);
         if(error == MfClassicErrorNone) {
             FURI_LOG_I(TAG, "Key A found");
             mf_classic_set_key_found(
@@ -925,7 +955,6 @@ NfcCommand mf_classic_poller_handler_key_reuse_auth_key_a(MfClassicPoller* insta
             dict_attack_ctx->auth_passed = true;
             instance->state = MfClassicPollerStateKeyReuseReadSector;
         } else {
-            mf_classic_poller_halt(instance);
             dict_attack_ctx->auth_passed = false;
             instance->state = MfClassicPollerStateKeyReuseStart;
         }
@@ -948,8 +977,8 @@ NfcCommand mf_classic_poller_handler_key_reuse_auth_key_b(MfClassicPoller* insta
             bit_lib_bytes_to_num_be(dict_attack_ctx->current_key.data, sizeof(MfClassicKey));
         FURI_LOG_D(TAG, "Key attack auth to block %d with key B: %06llx", block, key);
 
-        MfClassicError error = mf_classic_poller_auth(
-            instance, block, &dict_attack_ctx->current_key, MfClassicKeyTypeB, NULL, false);
+        MfClassicError error =
+            mf_classic_poller_key_reuse_auth(instance, block, MfClassicKeyTypeB);
         if(error == MfClassicErrorNone) {
             FURI_LOG_I(TAG, "Key B found");
             mf_classic_set_key_found(
@@ -962,7 +991,6 @@ NfcCommand mf_classic_poller_handler_key_reuse_auth_key_b(MfClassicPoller* insta
             dict_attack_ctx->auth_passed = true;
             instance->state = MfClassicPollerStateKeyReuseReadSector;
         } else {
-            mf_classic_poller_halt(instance);
             dict_attack_ctx->auth_passed = false;
             instance->state = MfClassicPollerStateKeyReuseStart;
         }
@@ -1015,7 +1043,7 @@ NfcCommand mf_classic_poller_handler_key_reuse_read_sector(MfClassicPoller* inst
         mf_classic_get_sector_trailer_num_by_sector(dict_attack_ctx->reuse_key_sector);
     dict_attack_ctx->current_block++;
     if(dict_attack_ctx->current_block > sec_tr_block_num) {
-        mf_classic_poller_halt(instance);
+        dict_attack_ctx->reuse_session_active = dict_attack_ctx->auth_passed;
         dict_attack_ctx->auth_passed = false;
 
         mf_classic_poller_handle_data_update(instance);
@@ -1463,13 +1491,49 @@ NfcCommand mf_classic_poller_handler_nested_collect_nt_enc(MfClassicPoller* inst
     return command;
 }
 
+// Returns index of the first key matching all collected nonces, -1 if none does
+static int32_t search_keys_for_nonce_key(
+    const MfClassicKey* keys,
+    size_t count,
+    MfClassicNestedNonceArray* nonce_array,
+    bool is_weak) {
+    uint64_t keys_num[CRYPTO1_BATCH_SIZE];
+    for(size_t i = 0; i < count; i++) {
+        keys_num[i] = bit_lib_bytes_to_num_be(keys[i].data, sizeof(MfClassicKey));
+    }
+    Crypto1Batch initial_state;
+    crypto1_batch_init(&initial_state, keys_num, count);
+
+    uint32_t candidates = (count == 32) ? UINT32_MAX : ((1UL << count) - 1);
+    for(uint8_t j = 0; (j < nonce_array->count) && candidates; j++) {
+        // Verify nonce matches encrypted parity bits for all nonces
+        const MfClassicNestedNonce* nonce = &nonce_array->nonces[j];
+        Crypto1Batch batch = initial_state;
+        uint32_t ks[CRYPTO1_BATCH_SIZE];
+        crypto1_batch_word(&batch, nonce->nt_enc ^ nonce->cuid, 1, ks);
+
+        for(uint32_t remaining = candidates; remaining; remaining &= remaining - 1) {
+            uint8_t lane = __builtin_ctz(remaining);
+            uint32_t nt_enc_plain = nonce->nt_enc ^ ks[lane];
+            bool match = !is_weak || is_weak_prng_nonce(nt_enc_plain);
+            match = match &&
+                    nonce_matches_encrypted_parity_bits(nt_enc_plain, ks[lane], nonce->par);
+            if(!match) candidates &= ~(1UL << lane);
+        }
+    }
+
+    return candidates ? (int32_t)__builtin_ctz(candidates) : -1;
+}
+
 static MfClassicKey* search_dicts_for_nonce_key(
     MfClassicPollerDictAttackContext* dict_attack_ctx,
     MfClassicNestedNonceArray* nonce_array,
     KeysDict* system_dict,
     KeysDict* user_dict,
     bool is_weak) {
-    MfClassicKey stack_key;
+    // Keys are checked in batches of bit-sliced Crypto1 states
+    MfClassicKey keys[CRYPTO1_BATCH_SIZE];
+    size_t keys_count = 0;
     KeysDict* dicts[] = {user_dict, system_dict};
     bool is_resumed = dict_attack_ctx->nested_phase == MfClassicNestedPhaseDictAttackResume;
     bool found_resume_point = false;
@@ -1477,35 +1541,31 @@ static MfClassicKey* search_dicts_for_nonce_key(
     for(int i = 0; i < 2; i++) {
         if(!dicts[i]) continue;
         keys_dict_rewind(dicts[i]);
-        while(keys_dict_get_next_key(dicts[i], stack_key.data, sizeof(MfClassicKey))) {
-            if(is_resumed && !found_resume_point) {
-                found_resume_point =
-                    (memcmp(
-                         dict_attack_ctx->current_key.data,
-                         stack_key.data,
-                         sizeof(MfClassicKey)) == 0);
-                continue;
-            }
-            bool full_match = true;
-            for(uint8_t j = 0; j < nonce_array->count; j++) {
-                // Verify nonce matches encrypted parity bits for all nonces
-                uint32_t nt_enc_plain = decrypt_nt_enc(
-                    nonce_array->nonces[j].cuid, nonce_array->nonces[j].nt_enc, stack_key);
-                if(is_weak) {
-                    full_match &= is_weak_prng_nonce(nt_enc_plain);
-                    if(!full_match) break;
+        bool is_last_key = false;
+        while(!is_last_key) {
+            is_last_key =
+                !keys_dict_get_next_key(dicts[i], keys[keys_count].data, sizeof(MfClassicKey));
+            if(!is_last_key) {
+                if(is_resumed && !found_resume_point) {
+                    found_resume_point =
+                        (memcmp(
+                             dict_attack_ctx->current_key.data,
+                             keys[keys_count].data,
+                             sizeof(MfClassicKey)) == 0);
+                    continue;
                 }
-                full_match &= nonce_matches_encrypted_parity_bits(
-                    nt_enc_plain,
-                    nt_enc_plain ^ nonce_array->nonces[j].nt_enc,
-                    nonce_array->nonces[j].par);
-                if(!full_match) break;
+                keys_count++;
             }
-            if(full_match) {
-                MfClassicKey* new_candidate = malloc(sizeof(MfClassicKey));
-                if(new_candidate == NULL) return NULL; // malloc failed
-                memcpy(new_candidate, &stack_key, sizeof(MfClassicKey));
-                return new_candidate;
+            bool is_last_batch = is_last_key && (i == 1 || !dicts[1]);
+            if((keys_count == CRYPTO1_BATCH_SIZE) || (is_last_batch && keys_count)) {
+                int32_t found = search_keys_for_nonce_key(keys, keys_count, nonce_array, is_weak);
+                keys_count = 0;
+                if(found >= 0) {
+                    MfClassicKey* new_candidate = malloc(sizeof(MfClassicKey));
+                    if(new_candidate == NULL) return NULL; // malloc failed
+                    memcpy(new_candidate, &keys[found], sizeof(MfClassicKey));
+                    return new_candidate;
+                }
             }
         }
     }
@@ -170,6 +170,7 @@ MfClassicError mf_classic_poller_auth_common(
         }
         if(bit_buffer_get_size_bytes(instance->rx_encrypted_buffer) != 4) {
             ret = MfClassicErrorAuth;
+            break;
         }
 
         crypto1_word(instance->crypto, 0, 0);
@@ -185,7 +186,9 @@ MfClassicError mf_classic_poller_auth_common(
     } while(false);
 
     if(ret != MfClassicErrorNone) {
+        // Card drops to idle state on failed authentication, no need for encrypted HALT
         iso14443_3a_poller_halt(instance->iso14443_3a_poller);
+        instance->auth_state = MfClassicAuthStateIdle;
     }
 
     return ret;
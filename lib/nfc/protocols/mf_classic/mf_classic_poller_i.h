@@ -157,6 +157,7 @@ typedef struct {
     bool auth_passed;
     uint16_t current_block;
     uint8_t reuse_key_sector;
+    bool reuse_session_active; // Card stays authenticated between key reuse sectors
     MfClassicBackdoor backdoor;
     // Enhanced dictionary attack and nested nonce collection
     MfClassicNestedPhase nested_phase;
@@ -1,4 +1,5 @@
 #include <furi.h>
+#include <furi_hal.h>
 
 /**
  * Timings based on Application Note 126:
@@ -49,6 +50,7 @@ static const OneWireHostTimings onewire_host_timings_overdrive = {
 struct OneWireHost {
     const GpioPin* gpio_pin;
     const OneWireHostTimings* timings;
+    OneWireHostSlotTable slots;
     unsigned char saved_rom[8]; /** < global search state */
     uint8_t last_discrepancy;
     uint8_t last_family_discrepancy;
@@ -106,40 +108,74 @@ bool onewire_host_reset(OneWireHost* host) {
     return r;
 }
 
-bool onewire_host_read_bit(OneWireHost* host) {
-    furi_check(host);
+static inline void onewire_host_wait_until(uint32_t start, uint32_t ticks) {
+    while(DWT->CYCCNT - start < ticks) {
+    }
+}
 
-    bool result;
+/* Runs a single bit slot, timed from the slot start so call overhead does not add up */
+static bool onewire_host_run_slot(OneWireHost* host, const OneWireHostSlot* slot) {
+    bool level = true;
+    uint32_t start;
 
-    const OneWireHostTimings* timings = host->timings;
+    if(slot->interruptible) {
+        // Interrupts may only stretch the low pulse, which stays well within slave limits.
+        // Pulse is timed once the bus is low, and no other thread may take over meanwhile.
+        const int32_t lock = furi_kernel_lock();
+        furi_hal_gpio_write(host->gpio_pin, false);
+        start = DWT->CYCCNT;
+        onewire_host_wait_until(start, slot->release);
+        furi_hal_gpio_write(host->gpio_pin, true);
+        furi_kernel_restore_lock(lock);
+    } else {
+        // Short low pulse and sampling point are critical, an interrupt there corrupts the bit
+        FURI_CRITICAL_ENTER();
+        start = DWT->CYCCNT;
+        furi_hal_gpio_write(host->gpio_pin, false);
+        onewire_host_wait_until(start, slot->release);
+        furi_hal_gpio_write(host->gpio_pin, true);
+        if(slot->sample) {
+            onewire_host_wait_until(start, slot->sample);
+            level = furi_hal_gpio_read(host->gpio_pin);
+        }
+        FURI_CRITICAL_EXIT();
+    }
 
-    // drive low
-    furi_hal_gpio_write(host->gpio_pin, false);
-    furi_delay_us(timings->a);
+    // Recovery time may be stretched, so it is left interruptible
+    onewire_host_wait_until(start, slot->end);
 
-    // release
-    furi_hal_gpio_write(host->gpio_pin, true);
-    furi_delay_us(timings->e);
+    return level;
+}
 
-    // read and post delay
-    result = furi_hal_gpio_read(host->gpio_pin);
-    furi_delay_us(timings->f);
+static uint8_t onewire_host_read_byte(OneWireHost* host) {
+    uint8_t result = 0;
+
+    for(uint8_t bit_mask = 0x01; bit_mask; bit_mask <<= 1) {
+        if(onewire_host_run_slot(host, &host->slots.read)) {
+            result |= bit_mask;
+        }
+    }
 
     return result;
 }
 
-uint8_t onewire_host_read(OneWireHost* host) {
+static void onewire_host_write_byte(OneWireHost* host, uint8_t value) {
+    for(uint8_t bit_mask = 0x01; bit_mask; bit_mask <<= 1) {
+        onewire_host_run_slot(
+            host, (value & bit_mask) ? &host->slots.write_1 : &host->slots.write_0);
+    }
+}
+
+bool onewire_host_read_bit(OneWireHost* host) {
     furi_check(host);
 
-    uint8_t result = 0;
+    return onewire_host_run_slot(host, &host->slots.read);
+}
 
-    for(uint8_t bitMask = 0x01; bitMask; bitMask <<= 1) {
-        if(onewire_host_read_bit(host)) {
-            result |= bitMask;
-        }
-    }
+uint8_t onewire_host_read(OneWireHost* host) {
+    furi_check(host);
 
-    return result;
+    return onewire_host_read_byte(host);
 }
 
 void onewire_host_read_bytes(OneWireHost* host, uint8_t* buffer, uint16_t count) {
@@ -147,42 +183,20 @@ void onewire_host_read_bytes(OneWireHost* host, uint8_t* buffer, uint16_t count)
     furi_check(buffer);
 
     for(uint16_t i = 0; i < count; i++) {
-        buffer[i] = onewire_host_read(host);
+        buffer[i] = onewire_host_read_byte(host);
     }
 }
 
 void onewire_host_write_bit(OneWireHost* host, bool value) {
     furi_check(host);
 
-    const OneWireHostTimings* timings = host->timings;
-
-    if(value) {
-        // drive low
-        furi_hal_gpio_write(host->gpio_pin, false);
-        furi_delay_us(timings->a);
-
-        // release
-        furi_hal_gpio_write(host->gpio_pin, true);
-        furi_delay_us(timings->b);
-    } else {
-        // drive low
-        furi_hal_gpio_write(host->gpio_pin, false);
-        furi_delay_us(timings->c);
-
-        // release
-        furi_hal_gpio_write(host->gpio_pin, true);
-        furi_delay_us(timings->d);
-    }
+    onewire_host_run_slot(host, value ? &host->slots.write_1 : &host->slots.write_0);
 }
 
 void onewire_host_write(OneWireHost* host, uint8_t value) {
     furi_check(host);
 
-    uint8_t bitMask;
-
-    for(bitMask = 0x01; bitMask; bitMask <<= 1) {
-        onewire_host_write_bit(host, (bitMask & value) ? 1 : 0);
-    }
+    onewire_host_write_byte(host, value);
 }
 
 void onewire_host_write_bytes(OneWireHost* host, const uint8_t* buffer, uint16_t count) {
@@ -190,7 +204,7 @@ void onewire_host_write_bytes(OneWireHost* host, const uint8_t* buffer, uint16_t
     furi_check(buffer);
 
     for(uint16_t i = 0; i < count; ++i) {
-        onewire_host_write(host, buffer[i]);
+        onewire_host_write_byte(host, buffer[i]);
     }
 }
 
@@ -353,4 +367,32 @@ void onewire_host_set_overdrive(OneWireHost* host, bool set) {
     furi_check(host);
 
     host->timings = set ? &onewire_host_timings_overdrive : &onewire_host_timings_normal;
+    onewire_host_get_slot_table(
+        &host->slots, set, furi_hal_cortex_instructions_per_microsecond());
+}
+
+void onewire_host_get_slot_table(
+    OneWireHostSlotTable* table,
+    bool overdrive,
+    uint32_t ticks_per_us) {
+    furi_check(table);
+
+    const OneWireHostTimings* timings = overdrive ? &onewire_host_timings_overdrive :
+                                                    &onewire_host_timings_normal;
+
+    table->write_0.release = timings->c * ticks_per_us;
+    table->write_0.sample = 0;
+    table->write_0.end = (timings->c + timings->d) * ticks_per_us;
+    // Standard speed slave takes up to twice as long low pulse as 0, overdrive one does not
+    table->write_0.interruptible = !overdrive;
+
+    table->write_1.release = timings->a * ticks_per_us;
+    table->write_1.sample = 0;
+    table->write_1.end = (timings->a + timings->b) * ticks_per_us;
+    table->write_1.interruptible = false;
+
+    table->read.release = timings->a * ticks_per_us;
+    table->read.sample = (timings->a + timings->e) * ticks_per_us;
+    table->read.end = (timings->a + timings->e + timings->f) * ticks_per_us;
+    table->read.interruptible = false;
 }
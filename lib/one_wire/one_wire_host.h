@@ -20,6 +20,21 @@ typedef enum {
 
 typedef struct OneWireHost OneWireHost;
 
+/** Bit time slot, all times are counted from the falling edge starting the slot */
+typedef struct {
+    uint32_t release; /**< Time to release the bus */
+    uint32_t sample; /**< Time to sample the bus, 0 if the slot is not sampled */
+    uint32_t end; /**< Time the next slot may start, including recovery */
+    bool interruptible; /**< Interrupts may stretch the low pulse, otherwise they are masked */
+} OneWireHostSlot;
+
+/** Time slots used for bit transfers at the selected bus speed */
+typedef struct {
+    OneWireHostSlot write_0; /**< Write 0 slot */
+    OneWireHostSlot write_1; /**< Write 1 slot */
+    OneWireHostSlot read; /**< Read slot */
+} OneWireHostSlotTable;
+
 /**
  * Allocate OneWireHost instance
  * @param [in] gpio_pin connection pin
@@ -125,6 +140,21 @@ bool onewire_host_search(OneWireHost* host, uint8_t* new_addr, OneWireHostSearch
  */
 void onewire_host_set_overdrive(OneWireHost* host, bool set);
 
+/**
+ * Get bit time slots for the given bus speed
+ *
+ * Bit and block transfers are driven from this table, precomputed in CPU
+ * cycles when the bus speed is set.
+ *
+ * @param [out] table pointer to the table to be filled
+ * @param [in] overdrive true for overdrive speed, false for standard speed
+ * @param [in] ticks_per_us number of time units in one microsecond
+ */
+void onewire_host_get_slot_table(
+    OneWireHostSlotTable* table,
+    bool overdrive,
+    uint32_t ticks_per_us);
+
 #ifdef __cplusplus
 }
 #endif
@@ -773,6 +773,364 @@ static inline bool subghz_protocol_keeloq_check_decrypt_centurion(
     return false;
 }
 
+/*
+ * Ways a manufacture key is checked against a parcel, in the order they are tried for one key.
+ * Keys of unknown learning type are checked in every way but magic serial ones.
+ */
+typedef enum {
+    KeeloqCheckSimple,
+    KeeloqCheckSimpleMirrored,
+    KeeloqCheckNormal,
+    KeeloqCheckNormalMirrored,
+    KeeloqCheckSecure,
+    KeeloqCheckSecureMirrored,
+    KeeloqCheckMagicXorType1,
+    KeeloqCheckMagicXorType1Mirrored,
+    KeeloqCheckMagicSerialType1,
+    KeeloqCheckMagicSerialType2,
+    KeeloqCheckMagicSerialType3,
+
+    KeeloqCheckNum,
+} KeeloqCheck;
+
+/* Learning type of keys checked this way, besides the ones of unknown type */
+static const uint8_t subghz_protocol_keeloq_check_learning[KeeloqCheckNum] = {
+    [KeeloqCheckSimple] = KEELOQ_LEARNING_SIMPLE,
+    [KeeloqCheckSimpleMirrored] = KEELOQ_LEARNING_UNKNOWN,
+    [KeeloqCheckNormal] = KEELOQ_LEARNING_NORMAL,
+    [KeeloqCheckNormalMirrored] = KEELOQ_LEARNING_UNKNOWN,
+    [KeeloqCheckSecure] = KEELOQ_LEARNING_SECURE,
+    [KeeloqCheckSecureMirrored] = KEELOQ_LEARNING_UNKNOWN,
+    [KeeloqCheckMagicXorType1] = KEELOQ_LEARNING_MAGIC_XOR_TYPE_1,
+    [KeeloqCheckMagicXorType1Mirrored] = KEELOQ_LEARNING_UNKNOWN,
+    [KeeloqCheckMagicSerialType1] = KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_1,
+    [KeeloqCheckMagicSerialType2] = KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_2,
+    [KeeloqCheckMagicSerialType3] = KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_3,
+};
+
+/* Learning type reported for keys of unknown type found with this check */
+static const uint8_t subghz_protocol_keeloq_check_kl_type[KeeloqCheckNum] = {
+    [KeeloqCheckSimple] = 1,
+    [KeeloqCheckSimpleMirrored] = 1,
+    [KeeloqCheckNormal] = 2,
+    [KeeloqCheckNormalMirrored] = 2,
+    [KeeloqCheckSecure] = 3,
+    [KeeloqCheckSecureMirrored] = 3,
+    [KeeloqCheckMagicXorType1] = 4,
+    [KeeloqCheckMagicXorType1Mirrored] = 4,
+};
+
+static bool subghz_protocol_keeloq_check_is_mirrored(KeeloqCheck check) {
+    return (check == KeeloqCheckSimpleMirrored) || (check == KeeloqCheckNormalMirrored) ||
+           (check == KeeloqCheckSecureMirrored) || (check == KeeloqCheckMagicXorType1Mirrored);
+}
+
+static bool subghz_protocol_keeloq_is_centurion(const SubGhzKey* manufacture_code) {
+    return (manufacture_code->type == KEELOQ_LEARNING_NORMAL) &&
+           (strcmp(furi_string_get_cstr(manufacture_code->name), "Centurion") == 0);
+}
+
+static uint64_t subghz_protocol_keeloq_mirror_key(uint64_t key) {
+    uint64_t man_rev = 0;
+    for(uint8_t i = 0; i < 64; i += 8) {
+        man_rev |= (uint64_t)(uint8_t)(key >> i) << (56 - i);
+    }
+    return man_rev;
+}
+
+/* Learnings that only select and flip manufacture key bits, depending on the fix part */
+static uint64_t
+    subghz_protocol_keeloq_magic_learning(KeeloqCheck check, uint32_t fix, uint64_t key) {
+    switch(check) {
+    case KeeloqCheckMagicXorType1:
+    case KeeloqCheckMagicXorType1Mirrored:
+        return subghz_protocol_keeloq_common_magic_xor_type1_learning(fix, key);
+    case KeeloqCheckMagicSerialType1:
+        return subghz_protocol_keeloq_common_magic_serial_type1_learning(fix, key);
+    case KeeloqCheckMagicSerialType2:
+        return subghz_protocol_keeloq_common_magic_serial_type2_learning(fix, key);
+    case KeeloqCheckMagicSerialType3:
+        return subghz_protocol_keeloq_common_magic_serial_type3_learning(fix, key);
+    default:
+        furi_crash();
+    }
+}
+
+static uint64_t
+    subghz_protocol_keeloq_get_man(KeeloqCheck check, uint32_t fix, uint32_t seed, uint64_t key) {
+    if(subghz_protocol_keeloq_check_is_mirrored(check)) {
+        key = subghz_protocol_keeloq_mirror_key(key);
+    }
+
+    switch(check) {
+    case KeeloqCheckSimple:
+    case KeeloqCheckSimpleMirrored:
+        return key;
+    case KeeloqCheckNormal:
+    case KeeloqCheckNormalMirrored:
+        // https://phreakerclub.com/forum/showpost.php?p=43557&postcount=37
+        return subghz_protocol_keeloq_common_normal_learning(fix, key);
+    case KeeloqCheckSecure:
+    case KeeloqCheckSecureMirrored:
+        return subghz_protocol_keeloq_common_secure_learning(fix, seed, key);
+    default:
+        return subghz_protocol_keeloq_magic_learning(check, fix, key);
+    }
+}
+
+/* Same as subghz_protocol_keeloq_get_man(), for 32 keys at once */
+static void subghz_protocol_keeloq_get_man_slice(
+    KeeloqCheck check,
+    uint32_t fix,
+    uint32_t seed,
+    const KeeloqKeySlice* keys,
+    KeeloqKeySlice* man) {
+    KeeloqKeySlice keys_mirrored;
+    if(subghz_protocol_keeloq_check_is_mirrored(check)) {
+        // Mirroring swaps bytes, which is just a different order of bit planes
+        for(size_t i = 0; i < 64; i++) {
+            keys_mirrored.planes[i] = keys->planes[(56 - (i & ~7U)) + (i & 7U)];
+        }
+        keys = &keys_mirrored;
+    }
+
+    switch(check) {
+    case KeeloqCheckSimple:
+    case KeeloqCheckSimpleMirrored:
+        *man = *keys;
+        break;
+    case KeeloqCheckNormal:
+    case KeeloqCheckNormalMirrored:
+        fix &= 0x0FFFFFFF;
+        subghz_protocol_keeloq_common_decrypt_slice(fix | 0x20000000, keys, &man->planes[0]);
+        subghz_protocol_keeloq_common_decrypt_slice(fix | 0x60000000, keys, &man->planes[32]);
+        break;
+    case KeeloqCheckSecure:
+    case KeeloqCheckSecureMirrored:
+        subghz_protocol_keeloq_common_decrypt_slice(fix & 0x0FFFFFFF, keys, &man->planes[32]);
+        subghz_protocol_keeloq_common_decrypt_slice(seed, keys, &man->planes[0]);
+        break;
+    default: {
+        // Each man bit is either a constant or a key bit, possibly inverted
+        const uint64_t man_zero = subghz_protocol_keeloq_magic_learning(check, fix, 0);
+        const uint64_t man_ones = subghz_protocol_keeloq_magic_learning(check, fix, UINT64_MAX);
+        for(size_t i = 0; i < 64; i++) {
+            const uint32_t constant = ((man_zero >> i) & 1) ? UINT32_MAX : 0;
+            const uint32_t key_mask = (((man_zero ^ man_ones) >> i) & 1) ? UINT32_MAX : 0;
+            man->planes[i] = constant ^ (keys->planes[i] & key_mask);
+        }
+        break;
+    }
+    }
+}
+
+/* Lanes where bits [first, first + count) of the decrypted data equal value */
+static uint32_t subghz_protocol_keeloq_match_slice(
+    const uint32_t* decrypt,
+    size_t first,
+    size_t count,
+    uint32_t value) {
+    uint32_t lanes = UINT32_MAX;
+    for(size_t i = 0; i < count; i++) {
+        lanes &= ((value >> i) & 1) ? decrypt[first + i] : ~decrypt[first + i];
+    }
+    return lanes;
+}
+
+/* Same as subghz_protocol_keeloq_check_decrypt() and its Centurion variant, for 32 keys */
+static uint32_t subghz_protocol_keeloq_check_decrypt_slice(
+    const uint32_t* decrypt,
+    uint8_t btn,
+    uint32_t end_serial,
+    uint32_t centurion_lanes) {
+    const uint32_t btn_lanes = subghz_protocol_keeloq_match_slice(decrypt, 28, 4, btn);
+    const uint32_t serial_lanes = subghz_protocol_keeloq_match_slice(decrypt, 16, 8, end_serial) |
+                                  subghz_protocol_keeloq_match_slice(decrypt, 16, 8, 0);
+    const uint32_t centurion_serial_lanes =
+        subghz_protocol_keeloq_match_slice(decrypt, 16, 10, 0x1CE);
+
+    return btn_lanes &
+           ((serial_lanes & ~centurion_lanes) | (centurion_serial_lanes & centurion_lanes));
+}
+
+static bool subghz_protocol_keeloq_check_key(
+    SubGhzBlockGeneric* instance,
+    uint32_t fix,
+    uint32_t hop,
+    const SubGhzKey* manufacture_code,
+    KeeloqCheck check) {
+    const uint64_t man =
+        subghz_protocol_keeloq_get_man(check, fix, instance->seed, manufacture_code->key);
+    const uint32_t decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
+    const uint8_t btn = (uint8_t)(fix >> 28);
+
+    if((check == KeeloqCheckNormal) && subghz_protocol_keeloq_is_centurion(manufacture_code)) {
+        return subghz_protocol_keeloq_check_decrypt_centurion(instance, decrypt, btn);
+    } else {
+        return subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, fix & 0xFF);
+    }
+}
+
+/* Keys that are allowed to be checked, either all or the ones of the manufacture already known */
+static uint32_t subghz_protocol_keeloq_get_slice_lanes(
+    SubGhzKeystore* keystore,
+    size_t slice_index,
+    bool mf_not_set) {
+    const SubGhzKeystoreKeeloqSlice* slice = &keystore->keeloq_slices[slice_index];
+    uint32_t lanes = 0;
+
+    for(size_t i = 0; i < COUNT_OF(slice->type_lanes); i++) {
+        lanes |= slice->type_lanes[i];
+    }
+
+    if(!mf_not_set) {
+        const SubGhzKeyArray_t* keys = subghz_keystore_get_data(keystore);
+        for(size_t lane = 0; lane < KEELOQ_SLICE_WIDTH; lane++) {
+            if(!(lanes & (1UL << lane))) continue;
+            const SubGhzKey* manufacture_code =
+                SubGhzKeyArray_cget(*keys, slice_index * KEELOQ_SLICE_WIDTH + lane);
+            if(strcmp(furi_string_get_cstr(manufacture_code->name), keystore->mfname) != 0) {
+                lanes &= ~(1UL << lane);
+            }
+        }
+    }
+
+    return lanes;
+}
+
+/*
+ * Look for the first key in the keystore that decrypts the parcel, checking 32 keys at once.
+ * Decrypted data is not kept, the found key is to be checked again with
+ * subghz_protocol_keeloq_check_key() to fill the counter.
+ */
+static bool subghz_protocol_keeloq_find_key(
+    SubGhzBlockGeneric* instance,
+    uint32_t fix,
+    uint32_t hop,
+    SubGhzKeystore* keystore,
+    bool mf_not_set,
+    size_t* key_index,
+    KeeloqCheck* found_check) {
+    const SubGhzKeyArray_t* keys = subghz_keystore_get_data(keystore);
+    furi_check(
+        keystore->keeloq_slices_count * KEELOQ_SLICE_WIDTH >= SubGhzKeyArray_size(*keys));
+
+    const uint8_t btn = (uint8_t)(fix >> 28);
+    const uint32_t end_serial = fix & 0xFF;
+    KeeloqKeySlice* man = malloc(sizeof(KeeloqKeySlice));
+    bool found = false;
+
+    for(size_t i = 0; (i < keystore->keeloq_slices_count) && !found; i++) {
+        const SubGhzKeystoreKeeloqSlice* slice = &keystore->keeloq_slices[i];
+        const uint32_t lanes = subghz_protocol_keeloq_get_slice_lanes(keystore, i, mf_not_set);
+        if(!lanes) continue;
+
+        uint32_t centurion_lanes = 0;
+        const uint32_t normal_lanes = lanes & slice->type_lanes[KEELOQ_LEARNING_NORMAL];
+        for(size_t lane = 0; lane < KEELOQ_SLICE_WIDTH; lane++) {
+            if(!(normal_lanes & (1UL << lane))) continue;
+            const SubGhzKey* manufacture_code =
+                SubGhzKeyArray_cget(*keys, i * KEELOQ_SLICE_WIDTH + lane);
+            if(subghz_protocol_keeloq_is_centurion(manufacture_code)) {
+                centurion_lanes |= 1UL << lane;
+            }
+        }
+
+        uint32_t check_lanes[KeeloqCheckNum];
+        uint32_t found_lanes = 0;
+        for(KeeloqCheck check = 0; check < KeeloqCheckNum; check++) {
+            const uint8_t learning = subghz_protocol_keeloq_check_learning[check];
+            check_lanes[check] = lanes & slice->type_lanes[learning];
+            if(subghz_protocol_keeloq_check_kl_type[check]) {
+                check_lanes[check] |= lanes & slice->type_lanes[KEELOQ_LEARNING_UNKNOWN];
+            }
+            if(!check_lanes[check]) continue;
+
+            uint32_t decrypt[32];
+            subghz_protocol_keeloq_get_man_slice(check, fix, instance->seed, &slice->keys, man);
+            subghz_protocol_keeloq_common_decrypt_slice(hop, man, decrypt);
+            check_lanes[check] &= subghz_protocol_keeloq_check_decrypt_slice(
+                decrypt, btn, end_serial, (check == KeeloqCheckNormal) ? centurion_lanes : 0);
+            found_lanes |= check_lanes[check];
+        }
+        if(!found_lanes) continue;
+
+        // First key in the keystore, then first check in order
+        const uint32_t lane = __builtin_ctz(found_lanes);
+        for(KeeloqCheck check = 0; check < KeeloqCheckNum; check++) {
+            if(check_lanes[check] & (1UL << lane)) {
+                *key_index = i * KEELOQ_SLICE_WIDTH + lane;
+                *found_check = check;
+                found = true;
+                break;
+            }
+        }
+    }
+
+    free(man);
+
+    return found;
+}
+
+static void subghz_protocol_keeloq_remember_match(
+    SubGhzKeystore* keystore,
+    uint32_t serial,
+    size_t key_index,
+    KeeloqCheck check) {
+    size_t i = 0;
+    while((i < keystore->keeloq_matches_count) && (keystore->keeloq_matches[i].serial != serial)) {
+        i++;
+    }
+    if(i == SUBGHZ_KEYSTORE_KEELOQ_MATCHES_MAX) {
+        i--;
+    } else if(i == keystore->keeloq_matches_count) {
+        keystore->keeloq_matches_count++;
+    }
+
+    memmove(
+        &keystore->keeloq_matches[1],
+        &keystore->keeloq_matches[0],
+        i * sizeof(SubGhzKeystoreKeeloqMatch));
+    keystore->keeloq_matches[0] = (SubGhzKeystoreKeeloqMatch){
+        .serial = serial,
+        .key_index = key_index,
+        .check = check,
+    };
+}
+
+/* Key found for this serial number before, if it still matches */
+static bool subghz_protocol_keeloq_find_remembered_key(
+    SubGhzBlockGeneric* instance,
+    uint32_t fix,
+    uint32_t hop,
+    SubGhzKeystore* keystore,
+    bool mf_not_set,
+    size_t* key_index,
+    KeeloqCheck* found_check) {
+    const SubGhzKeyArray_t* keys = subghz_keystore_get_data(keystore);
+    const uint32_t serial = fix & 0x0FFFFFFF;
+
+    for(size_t i = 0; i < keystore->keeloq_matches_count; i++) {
+        const SubGhzKeystoreKeeloqMatch* match = &keystore->keeloq_matches[i];
+        if(match->serial != serial) continue;
+        if(match->key_index >= SubGhzKeyArray_size(*keys)) break;
+
+        const SubGhzKey* manufacture_code = SubGhzKeyArray_cget(*keys, match->key_index);
+        if(!mf_not_set &&
+           (strcmp(furi_string_get_cstr(manufacture_code->name), keystore->mfname) != 0)) {
+            break;
+        }
+        if(subghz_protocol_keeloq_check_key(instance, fix, hop, manufacture_code, match->check)) {
+            *key_index = match->key_index;
+            *found_check = match->check;
+            return true;
+        }
+        break;
+    }
+
+    return false;
+}
+
 /** 
  * Checking the accepted code against the database manafacture key
  * @param instance Pointer to a SubGhzBlockGeneric* instance
@@ -792,10 +1150,6 @@ static uint8_t subghz_protocol_keeloq_check_remote_controller_selector(
     // HCS300 -> uint16_t end_serial = (uint16_t)(fix & 0x3FF);
     // HCS200 -> uint16_t end_serial = (uint16_t)(fix & 0xFF);
 
-    uint16_t end_serial = (uint16_t)(fix & 0xFF);
-    uint8_t btn = (uint8_t)(fix >> 28);
-    uint32_t decrypt = 0;
-    uint64_t man;
     bool mf_not_set = false;
     // TODO:
     // if(mfname == 0x0) {
@@ -809,186 +1163,31 @@ static uint8_t subghz_protocol_keeloq_check_remote_controller_selector(
     } else if(strcmp(mfname, "") == 0) {
         mf_not_set = true;
     }
-    for
-        M_EACH(manufacture_code, *subghz_keystore_get_data(keystore), SubGhzKeyArray_t) {
-            if(mf_not_set || (strcmp(furi_string_get_cstr(manufacture_code->name), mfname) == 0)) {
-                switch(manufacture_code->type) {
-                case KEELOQ_LEARNING_SIMPLE:
-                    // Simple Learning
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, manufacture_code->key);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        return 1;
-                    }
-                    break;
-                case KEELOQ_LEARNING_NORMAL:
-                    // Normal Learning
-                    // https://phreakerclub.com/forum/showpost.php?p=43557&postcount=37
-                    man =
-                        subghz_protocol_keeloq_common_normal_learning(fix, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if((strcmp(furi_string_get_cstr(manufacture_code->name), "Centurion") == 0)) {
-                        if(subghz_protocol_keeloq_check_decrypt_centurion(instance, decrypt, btn)) {
-                            *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                            keystore->mfname = *manufacture_name;
-                            return 1;
-                        }
-                    } else {
-                        if(subghz_protocol_keeloq_check_decrypt(
-                               instance, decrypt, btn, end_serial)) {
-                            *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                            keystore->mfname = *manufacture_name;
-                            return 1;
-                        }
-                    }
-                    break;
-                case KEELOQ_LEARNING_SECURE:
-                    man = subghz_protocol_keeloq_common_secure_learning(
-                        fix, instance->seed, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        return 1;
-                    }
-                    break;
-                case KEELOQ_LEARNING_MAGIC_XOR_TYPE_1:
-                    man = subghz_protocol_keeloq_common_magic_xor_type1_learning(
-                        fix, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        return 1;
-                    }
-                    break;
-                case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_1:
-                    man = subghz_protocol_keeloq_common_magic_serial_type1_learning(
-                        fix, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        return 1;
-                    }
-                    break;
-                case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_2:
-                    man = subghz_protocol_keeloq_common_magic_serial_type2_learning(
-                        fix, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        return 1;
-                    }
-                    break;
-                case KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_3:
-                    man = subghz_protocol_keeloq_common_magic_serial_type3_learning(
-                        fix, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        return 1;
-                    }
-                    break;
-                case KEELOQ_LEARNING_UNKNOWN:
-                    // Simple Learning
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, manufacture_code->key);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        keystore->kl_type = 1;
-                        return 1;
-                    }
-
-                    // Check for mirrored man
-                    uint64_t man_rev = 0;
-                    uint64_t man_rev_byte = 0;
-                    for(uint8_t i = 0; i < 64; i += 8) {
-                        man_rev_byte = (uint8_t)(manufacture_code->key >> i);
-                        man_rev = man_rev | man_rev_byte << (56 - i);
-                    }
-
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man_rev);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        keystore->kl_type = 1;
-                        return 1;
-                    }
-
-                    //###########################
-                    // Normal Learning
-                    // https://phreakerclub.com/forum/showpost.php?p=43557&postcount=37
-                    man =
-                        subghz_protocol_keeloq_common_normal_learning(fix, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        keystore->kl_type = 2;
-                        return 1;
-                    }
 
-                    // Check for mirrored man
-                    man = subghz_protocol_keeloq_common_normal_learning(fix, man_rev);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        keystore->kl_type = 2;
-                        return 1;
-                    }
-
-                    // Secure Learning
-                    man = subghz_protocol_keeloq_common_secure_learning(
-                        fix, instance->seed, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        keystore->kl_type = 3;
-                        return 1;
-                    }
-
-                    // Check for mirrored man
-                    man = subghz_protocol_keeloq_common_secure_learning(
-                        fix, instance->seed, man_rev);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        keystore->kl_type = 3;
-                        return 1;
-                    }
-
-                    // Magic xor type1 learning
-                    man = subghz_protocol_keeloq_common_magic_xor_type1_learning(
-                        fix, manufacture_code->key);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        keystore->kl_type = 4;
-                        return 1;
-                    }
-
-                    // Check for mirrored man
-                    man = subghz_protocol_keeloq_common_magic_xor_type1_learning(fix, man_rev);
-                    decrypt = subghz_protocol_keeloq_common_decrypt(hop, man);
-                    if(subghz_protocol_keeloq_check_decrypt(instance, decrypt, btn, end_serial)) {
-                        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
-                        keystore->mfname = *manufacture_name;
-                        keystore->kl_type = 4;
-                        return 1;
-                    }
-
-                    break;
-                }
-            }
+    size_t key_index;
+    KeeloqCheck check;
+
+    // Remotes are usually pressed several times in a row, try the key they were decoded with first
+    if(subghz_protocol_keeloq_find_remembered_key(
+           instance, fix, hop, keystore, mf_not_set, &key_index, &check) ||
+       (subghz_protocol_keeloq_find_key(
+            instance, fix, hop, keystore, mf_not_set, &key_index, &check) &&
+        subghz_protocol_keeloq_check_key(
+            instance,
+            fix,
+            hop,
+            SubGhzKeyArray_cget(*subghz_keystore_get_data(keystore), key_index),
+            check))) {
+        const SubGhzKey* manufacture_code =
+            SubGhzKeyArray_cget(*subghz_keystore_get_data(keystore), key_index);
+        *manufacture_name = furi_string_get_cstr(manufacture_code->name);
+        keystore->mfname = *manufacture_name;
+        if(manufacture_code->type == KEELOQ_LEARNING_UNKNOWN) {
+            keystore->kl_type = subghz_protocol_keeloq_check_kl_type[check];
         }
+        subghz_protocol_keeloq_remember_match(keystore, fix & 0x0FFFFFFF, key_index, check);
+        return 1;
+    }
 
     // MF not found
     *manufacture_name = "Unknown";
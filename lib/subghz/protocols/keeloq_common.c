@@ -8,18 +8,47 @@
 #define g5(x, a, b, c, d, e) \
     (bit(x, a) + bit(x, b) * 2 + bit(x, c) * 4 + bit(x, d) * 8 + bit(x, e) * 16)
 
+/*
+ * Key bits are fed into the rounds from 32-bit halves of the key, so that the round loop only
+ * has to shift a register instead of indexing a 64-bit value.
+ */
+static FURI_ALWAYS_INLINE uint32_t
+    subghz_protocol_keeloq_common_encrypt_rounds(uint32_t x, uint32_t key_bits, size_t rounds) {
+    for(size_t r = 0; r < rounds; r++) {
+        const uint32_t nlf_index = ((x >> 1) & 1) | ((x >> 8) & 2) | ((x >> 18) & 4) |
+                                   ((x >> 23) & 8) | ((x >> 27) & 16);
+        const uint32_t msb = x ^ (x >> 16) ^ key_bits ^ (KEELOQ_NLF >> nlf_index);
+        x = (x >> 1) | (msb << 31);
+        key_bits >>= 1;
+    }
+    return x;
+}
+
+static FURI_ALWAYS_INLINE uint32_t
+    subghz_protocol_keeloq_common_decrypt_rounds(uint32_t x, uint32_t key_bits, size_t rounds) {
+    for(size_t r = 0; r < rounds; r++) {
+        const uint32_t nlf_index = (x & 1) | ((x >> 7) & 2) | ((x >> 17) & 4) | ((x >> 22) & 8) |
+                                   ((x >> 26) & 16);
+        const uint32_t lsb = (x >> 31) ^ (x >> 15) ^ (key_bits >> 31) ^ (KEELOQ_NLF >> nlf_index);
+        x = (x << 1) | (lsb & 1);
+        key_bits <<= 1;
+    }
+    return x;
+}
+
 /** Simple Learning Encrypt
  * @param data - 0xBSSSCCCC, B(4bit) key, S(10bit) serial&0x3FF, C(16bit) counter
  * @param key - manufacture (64bit)
  * @return keeloq encrypt data
  */
 inline uint32_t subghz_protocol_keeloq_common_encrypt(const uint32_t data, const uint64_t key) {
-    uint32_t x = data, r;
-    for(r = 0; r < 528; r++)
-        x = (x >> 1) ^ ((bit(x, 0) ^ bit(x, 16) ^ (uint32_t)bit(key, r & 63) ^
-                         bit(KEELOQ_NLF, g5(x, 1, 9, 20, 26, 31)))
-                        << 31);
-    return x;
+    // 528 rounds use key bits 0 to 63 eight times, then bits 0 to 15
+    uint32_t x = data;
+    for(size_t i = 0; i < 8; i++) {
+        x = subghz_protocol_keeloq_common_encrypt_rounds(x, (uint32_t)key, 32);
+        x = subghz_protocol_keeloq_common_encrypt_rounds(x, (uint32_t)(key >> 32), 32);
+    }
+    return subghz_protocol_keeloq_common_encrypt_rounds(x, (uint32_t)key, 16);
 }
 
 /** Simple Learning Decrypt
@@ -28,13 +57,65 @@ inline uint32_t subghz_protocol_keeloq_common_encrypt(const uint32_t data, const
  * @return 0xBSSSCCCC, B(4bit) key, S(10bit) serial&0x3FF, C(16bit) counter
  */
 inline uint32_t subghz_protocol_keeloq_common_decrypt(const uint32_t data, const uint64_t key) {
-    uint32_t x = data, r;
-    for(r = 0; r < 528; r++)
-        x = (x << 1) ^ bit(x, 31) ^ bit(x, 15) ^ (uint32_t)bit(key, (15 - r) & 63) ^
-            bit(KEELOQ_NLF, g5(x, 0, 8, 19, 25, 30));
+    // 528 rounds use key bits 15 to 0, then bits 63 to 0 eight times
+    uint32_t x = subghz_protocol_keeloq_common_decrypt_rounds(data, (uint32_t)key << 16, 16);
+    for(size_t i = 0; i < 8; i++) {
+        x = subghz_protocol_keeloq_common_decrypt_rounds(x, (uint32_t)(key >> 32), 32);
+        x = subghz_protocol_keeloq_common_decrypt_rounds(x, (uint32_t)key, 32);
+    }
     return x;
 }
 
+void subghz_protocol_keeloq_common_slice_set_key(
+    KeeloqKeySlice* slice,
+    size_t lane,
+    uint64_t key) {
+    furi_check(lane < KEELOQ_SLICE_WIDTH);
+
+    const uint32_t lane_mask = 1UL << lane;
+    for(size_t i = 0; i < 64; i++) {
+        if((key >> i) & 1) {
+            slice->planes[i] |= lane_mask;
+        } else {
+            slice->planes[i] &= ~lane_mask;
+        }
+    }
+}
+
+void subghz_protocol_keeloq_common_decrypt_slice(
+    const uint32_t data,
+    const KeeloqKeySlice* keys,
+    uint32_t* result) {
+    /*
+     * Round r shifts in bit y[r + 32] computed from y[r] ... y[r + 31], where y[r + 31 - i] is
+     * bit i of the state. Only the last 32 bits are needed, they are kept in a ring buffer
+     * written twice, so that every bit used by a round is at a constant offset from y[r].
+     */
+    uint32_t y[64];
+    for(size_t i = 0; i < 32; i++) {
+        y[31 - i] = y[63 - i] = ((data >> i) & 1) ? UINT32_MAX : 0;
+    }
+
+    for(size_t r = 0; r < 528; r++) {
+        uint32_t* state = &y[r & 31];
+        // NLF inputs are state bits 0, 8, 19, 25 and 30
+        const uint32_t a = state[31];
+        const uint32_t b = state[23];
+        const uint32_t c = state[12];
+        const uint32_t d = state[6];
+        const uint32_t e = state[1];
+        // Algebraic normal form of KEELOQ_NLF
+        const uint32_t nlf = a ^ b ^ ((b ^ d) & (a ^ c)) ^ (e & (a ^ c ^ ((b ^ c) & (a ^ d))));
+        const uint32_t lsb = state[0] ^ state[16] ^ keys->planes[(15 - r) & 63] ^ nlf;
+        state[0] = state[32] = lsb;
+    }
+
+    // After 528 rounds bit i of the state is y[559 - i]
+    for(size_t i = 0; i < 32; i++) {
+        result[i] = y[(15 - i) & 31];
+    }
+}
+
 /** Normal Learning
  * @param data - serial number (28bit)
  * @param key - manufacture (64bit)
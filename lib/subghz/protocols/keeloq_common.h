@@ -4,6 +4,10 @@
 
 #include <furi.h>
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 /*
  * Keeloq
  * https://ru.wikipedia.org/wiki/KeeLoq
@@ -26,6 +30,18 @@
 #define KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_2 7u
 #define KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_3 8u
 
+/*
+ * Number of keys decrypted at once by subghz_protocol_keeloq_common_decrypt_slice()
+ */
+#define KEELOQ_SLICE_WIDTH (32U)
+
+/*
+ * Bitsliced KeeLoq keys, bit n of planes[b] is bit b of key n
+ */
+typedef struct {
+    uint32_t planes[64];
+} KeeloqKeySlice;
+
 /**
  * Simple Learning Encrypt
  * @param data - 0xBSSSCCCC, B(4bit) key, S(10bit) serial&0x3FF, C(16bit) counter
@@ -98,3 +114,27 @@ uint64_t subghz_protocol_keeloq_common_magic_serial_type2_learning(uint32_t data
  */
 
 uint64_t subghz_protocol_keeloq_common_magic_serial_type3_learning(uint32_t data, uint64_t man);
+
+/**
+ * Put a key into a bitsliced key set
+ * @param slice - bitsliced key set
+ * @param lane - key number in the set, less than KEELOQ_SLICE_WIDTH
+ * @param key - manufacture (64bit)
+ */
+void subghz_protocol_keeloq_common_slice_set_key(KeeloqKeySlice* slice, size_t lane, uint64_t key);
+
+/**
+ * Simple Learning Decrypt of the same data with up to KEELOQ_SLICE_WIDTH keys at once
+ * @param data - keeloq encrypt data
+ * @param keys - bitsliced manufacture keys
+ * @param result - 32 bit planes of decrypted data, bit n of result[b] is bit b of data
+ *                 decrypted with key n
+ */
+void subghz_protocol_keeloq_common_decrypt_slice(
+    const uint32_t data,
+    const KeeloqKeySlice* keys,
+    uint32_t* result);
+
+#ifdef __cplusplus
+}
+#endif
@@ -1,6 +1,7 @@
 #include "raw.h"
 #include <lib/flipper_format/flipper_format.h>
 #include "../subghz_file_encoder_worker.h"
+#include "../subghz_raw_file.h"
 
 #include "../blocks/const.h"
 #include "../blocks/generic.h"
@@ -10,7 +11,7 @@
 
 #define TAG "SubGhzProtocolRaw"
 
-#define SUBGHZ_DOWNLOAD_MAX_SIZE 512
+#define SUBGHZ_DOWNLOAD_MAX_SIZE SUBGHZ_RAW_FILE_BLOCK_SIZE_MAX
 
 static const SubGhzBlockConst subghz_protocol_raw_const = {
     .te_short = 50,
@@ -26,6 +27,8 @@ struct SubGhzProtocolDecoderRAW {
     uint16_t ind_write;
     Storage* storage;
     FlipperFormat* flipper_file;
+    SubGhzRawFile* raw_file;
+    SubGhzRawFileFormat format;
     uint32_t file_is_open;
     FuriString* file_name;
     size_t sample_write;
@@ -158,6 +161,15 @@ bool subghz_protocol_raw_save_to_file_init(
             break;
         }
 
+        instance->raw_file = subghz_raw_file_alloc();
+        if(!subghz_raw_file_write_format(
+               instance->raw_file, instance->flipper_file, instance->format)) {
+            FURI_LOG_E(TAG, "Unable to add RAW format");
+            subghz_raw_file_free(instance->raw_file);
+            instance->raw_file = NULL;
+            break;
+        }
+
         instance->upload_raw = malloc(SUBGHZ_DOWNLOAD_MAX_SIZE * sizeof(int32_t));
         instance->file_is_open = RAWFileIsOpenWrite;
         instance->sample_write = 0;
@@ -176,8 +188,11 @@ static bool subghz_protocol_raw_save_to_file_write(SubGhzProtocolDecoderRAW* ins
 
     bool is_write = false;
     if(instance->file_is_open == RAWFileIsOpenWrite) {
-        if(!flipper_format_write_int32(
-               instance->flipper_file, "RAW_Data", instance->upload_raw, instance->ind_write)) {
+        if(!subghz_raw_file_write(
+               instance->raw_file,
+               instance->flipper_file,
+               instance->upload_raw,
+               instance->ind_write)) {
             FURI_LOG_E(TAG, "Unable to add RAW_Data");
         } else {
             instance->sample_write += instance->ind_write;
@@ -196,6 +211,8 @@ void subghz_protocol_raw_save_to_file_stop(SubGhzProtocolDecoderRAW* instance) {
     if(instance->file_is_open != RAWFileIsOpenClose) {
         free(instance->upload_raw);
         instance->upload_raw = NULL;
+        subghz_raw_file_free(instance->raw_file);
+        instance->raw_file = NULL;
         flipper_format_file_close(instance->flipper_file);
         flipper_format_free(instance->flipper_file);
         furi_record_close(RECORD_STORAGE);
@@ -212,6 +229,13 @@ void subghz_protocol_raw_save_to_file_pause(SubGhzProtocolDecoderRAW* instance,
     }
 }
 
+void subghz_protocol_raw_save_to_file_set_format(
+    SubGhzProtocolDecoderRAW* instance,
+    SubGhzRawFileFormat format) {
+    furi_check(instance);
+    instance->format = format;
+}
+
 size_t subghz_protocol_raw_get_sample_write(SubGhzProtocolDecoderRAW* instance) {
     furi_check(instance);
     return instance->sample_write + instance->ind_write;
@@ -225,6 +249,7 @@ void* subghz_protocol_decoder_raw_alloc(SubGhzEnvironment* environment) {
     instance->ind_write = 0;
     instance->last_level = false;
     instance->file_is_open = RAWFileIsOpenClose;
+    instance->format = SubGhzRawFileFormatText;
     instance->file_name = furi_string_alloc();
 
     return instance;
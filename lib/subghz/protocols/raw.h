@@ -1,6 +1,7 @@
 #pragma once
 
 #include "base.h"
+#include "../subghz_raw_file.h"
 
 #define SUBGHZ_PROTOCOL_RAW_NAME "RAW"
 
@@ -35,6 +36,16 @@ bool subghz_protocol_raw_save_to_file_init(
  */
 void subghz_protocol_raw_save_to_file_stop(SubGhzProtocolDecoderRAW* instance);
 
+/**
+ * Set data format for files written by subghz_protocol_raw_save_to_file_init.
+ * Text is the default, binary files are smaller and faster to replay.
+ * @param instance Pointer to a SubGhzProtocolDecoderRAW instance
+ * @param format Data format, SubGhzRawFileFormat
+ */
+void subghz_protocol_raw_save_to_file_set_format(
+    SubGhzProtocolDecoderRAW* instance,
+    SubGhzRawFileFormat format);
+
 /**
  * Get the number of samples received SubGhzProtocolDecoderRAW.
  * @param instance Pointer to a SubGhzProtocolDecoderRAW instance
@@ -1,14 +1,33 @@
 #include "subghz_file_encoder_worker.h"
+#include "subghz_raw_file.h"
+#include "subghz_raw_dedup.h"
 
 #include <toolbox/stream/stream.h>
 #include <flipper_format/flipper_format.h>
 #include <flipper_format/flipper_format_i.h>
 #include <lib/subghz/devices/devices.h>
-#include <lib/toolbox/strint.h>
 
 #define TAG "SubGhzFileEncoderWorker"
 
-#define SUBGHZ_FILE_ENCODER_LOAD 512
+#define SUBGHZ_FILE_ENCODER_LOAD SUBGHZ_RAW_FILE_BLOCK_SIZE_MAX
+// Longest burst replayed from memory, longer ones are sent once
+#define SUBGHZ_FILE_ENCODER_BURST_MAX 1024U
+
+// Deduplicated file playback: every burst is sent as many times as it was seen
+typedef struct {
+    uint32_t* counts;
+    size_t count;
+    size_t index;
+    int32_t* output;
+    size_t samples_count;
+    size_t samples_position;
+    int32_t* burst;
+    size_t burst_size;
+    size_t burst_length;
+    size_t burst_position;
+    uint32_t burst_replays;
+    bool in_burst;
+} SubGhzFileEncoderWorkerRepeats;
 
 struct SubGhzFileEncoderWorker {
     FuriThread* thread;
@@ -16,6 +35,9 @@ struct SubGhzFileEncoderWorker {
 
     Storage* storage;
     FlipperFormat* flipper_format;
+    SubGhzRawFile* raw_file;
+    int32_t* samples;
+    SubGhzFileEncoderWorkerRepeats repeats;
 
     volatile bool worker_running;
     volatile bool worker_stopping;
@@ -45,29 +67,6 @@ void subghz_file_encoder_worker_add_level_duration(
     if(sizeof(int32_t) != ret) FURI_LOG_E(TAG, "Invalid add duration in the stream");
 }
 
-bool subghz_file_encoder_worker_data_parse(SubGhzFileEncoderWorker* instance, const char* strStart) {
-    // Line sample: "RAW_Data: -1, 2, -2..."
-
-    // Look for the key in the line
-    char* str = strstr(strStart, "RAW_Data: ");
-    bool res = false;
-
-    if(str) {
-        // Skip key
-        str = strchr(str, ' ');
-
-        // Parse next element
-        int32_t duration;
-        while(strint_to_int32(str, &str, &duration, 10) == StrintParseNoError) {
-            subghz_file_encoder_worker_add_level_duration(instance, duration);
-            if(*str == ',') str++; // could also be `\0`
-        }
-
-        res = true;
-    }
-    return res;
-}
-
 void subghz_file_encoder_worker_get_text_progress(
     SubGhzFileEncoderWorker* instance,
     FuriString* output) {
@@ -103,6 +102,85 @@ LevelDuration subghz_file_encoder_worker_get_level_duration(void* context) {
     }
 }
 
+static void subghz_file_encoder_worker_burst_add(
+    SubGhzFileEncoderWorkerRepeats* repeats,
+    int32_t sample) {
+    if(repeats->burst_length == repeats->burst_size &&
+       repeats->burst_size < SUBGHZ_FILE_ENCODER_BURST_MAX) {
+        repeats->burst_size = MIN(repeats->burst_size * 2 + 64, SUBGHZ_FILE_ENCODER_BURST_MAX);
+        repeats->burst = realloc(repeats->burst, repeats->burst_size * sizeof(int32_t));
+    }
+    // Counted past the end too, so too long burst is not replayed
+    if(repeats->burst_length < repeats->burst_size) {
+        repeats->burst[repeats->burst_length] = sample;
+    }
+    repeats->burst_length++;
+}
+
+static void subghz_file_encoder_worker_burst_end(SubGhzFileEncoderWorkerRepeats* repeats) {
+    repeats->in_burst = false;
+    const uint32_t burst_repeats =
+        (repeats->index < repeats->count) ? repeats->counts[repeats->index++] : 1;
+    if(repeats->burst_length > repeats->burst_size) {
+        FURI_LOG_W(TAG, "Burst is too long to repeat");
+    } else if(burst_repeats > 1) {
+        repeats->burst_replays = burst_repeats - 1;
+    }
+}
+
+/** Read samples of deduplicated file, expanding bursts by their repeat count
+ *
+ * Bursts are split the same way subghz_raw_dedup does it: by long low levels,
+ * with the gap following a burst replayed along with it. Burst at the end of
+ * file is closed by the end of file.
+ *
+ * @param instance  SubGhzFileEncoderWorker instance
+ * @return number of samples in output, 0 at the end of file
+ */
+static size_t subghz_file_encoder_worker_read_repeats(SubGhzFileEncoderWorker* instance) {
+    SubGhzFileEncoderWorkerRepeats* repeats = &instance->repeats;
+    size_t count = 0;
+    while(count < SUBGHZ_FILE_ENCODER_LOAD) {
+        if(repeats->burst_replays) {
+            repeats->output[count++] = repeats->burst[repeats->burst_position++];
+            if(repeats->burst_position == repeats->burst_length) {
+                repeats->burst_position = 0;
+                repeats->burst_replays--;
+            }
+            continue;
+        }
+
+        if(repeats->samples_position == repeats->samples_count) {
+            repeats->samples_count = subghz_raw_file_read(
+                instance->raw_file,
+                instance->flipper_format,
+                instance->samples,
+                SUBGHZ_FILE_ENCODER_LOAD);
+            repeats->samples_position = 0;
+            if(!repeats->samples_count) {
+                // Last burst may run up to the end of file with no gap after it
+                if(!repeats->in_burst) break;
+                subghz_file_encoder_worker_burst_end(repeats);
+                continue;
+            }
+        }
+
+        const int32_t sample = instance->samples[repeats->samples_position++];
+        repeats->output[count++] = sample;
+        if(sample > -SUBGHZ_RAW_DEDUP_GAP_US) {
+            if(!repeats->in_burst) {
+                repeats->in_burst = true;
+                repeats->burst_length = 0;
+            }
+            subghz_file_encoder_worker_burst_add(repeats, sample);
+        } else if(repeats->in_burst) {
+            subghz_file_encoder_worker_burst_add(repeats, sample);
+            subghz_file_encoder_worker_burst_end(repeats);
+        }
+    }
+    return count;
+}
+
 /** Worker thread
  * 
  * @param context 
@@ -113,7 +191,6 @@ static int32_t subghz_file_encoder_worker_thread(void* context) {
     FURI_LOG_I(TAG, "Worker start");
     bool res = false;
     instance->is_storage_slow = false;
-    Stream* stream = flipper_format_get_raw_stream(instance->flipper_format);
     do {
         if(!flipper_format_file_open_existing(
                instance->flipper_format, furi_string_get_cstr(instance->file_path))) {
@@ -123,13 +200,20 @@ static int32_t subghz_file_encoder_worker_thread(void* context) {
                 furi_string_get_cstr(instance->file_path));
             break;
         }
+        instance->repeats.counts =
+            subghz_raw_dedup_read_repeats(instance->flipper_format, &instance->repeats.count);
         if(!flipper_format_read_string(instance->flipper_format, "Protocol", instance->str_data)) {
             FURI_LOG_E(TAG, "Missing Protocol");
             break;
         }
 
-        //skip the end of the previous line "\n"
-        stream_seek(stream, 1, StreamOffsetFromCurrent);
+        SubGhzRawFileFormat format =
+            subghz_raw_file_read_format(instance->raw_file, instance->flipper_format);
+        FURI_LOG_D(TAG, "Data format %s", format == SubGhzRawFileFormatBinary ? "binary" : "text");
+        if(instance->repeats.counts) {
+            FURI_LOG_D(TAG, "Repeats of %zu bursts", instance->repeats.count);
+            instance->repeats.output = malloc(sizeof(int32_t) * SUBGHZ_FILE_ENCODER_LOAD);
+        }
         res = true;
         instance->worker_stopping = false;
         FURI_LOG_I(TAG, "Start transmission");
@@ -138,12 +222,23 @@ static int32_t subghz_file_encoder_worker_thread(void* context) {
     while(res && instance->worker_running) {
         size_t stream_free_byte = furi_stream_buffer_spaces_available(instance->stream);
         if((stream_free_byte / sizeof(int32_t)) >= SUBGHZ_FILE_ENCODER_LOAD) {
-            if(stream_read_line(stream, instance->str_data)) {
-                furi_string_trim(instance->str_data);
-                if(!subghz_file_encoder_worker_data_parse(
-                       instance, furi_string_get_cstr(instance->str_data))) {
-                    subghz_file_encoder_worker_add_level_duration(instance, LEVEL_DURATION_RESET);
-                    break;
+            size_t count;
+            const int32_t* samples;
+            if(instance->repeats.counts) {
+                count = subghz_file_encoder_worker_read_repeats(instance);
+                samples = instance->repeats.output;
+            } else {
+                count = subghz_raw_file_read(
+                    instance->raw_file,
+                    instance->flipper_format,
+                    instance->samples,
+                    SUBGHZ_FILE_ENCODER_LOAD);
+                samples = instance->samples;
+            }
+            if(count) {
+                size_t size = count * sizeof(int32_t);
+                if(furi_stream_buffer_send(instance->stream, samples, size, 100) != size) {
+                    FURI_LOG_E(TAG, "Invalid add duration in the stream");
                 }
             } else {
                 subghz_file_encoder_worker_add_level_duration(instance, LEVEL_DURATION_RESET);
@@ -173,6 +268,11 @@ static int32_t subghz_file_encoder_worker_thread(void* context) {
     }
     flipper_format_file_close(instance->flipper_format);
 
+    free(instance->repeats.counts);
+    free(instance->repeats.output);
+    free(instance->repeats.burst);
+    memset(&instance->repeats, 0, sizeof(SubGhzFileEncoderWorkerRepeats));
+
     FURI_LOG_I(TAG, "Worker stop");
     return 0;
 }
@@ -186,6 +286,8 @@ SubGhzFileEncoderWorker* subghz_file_encoder_worker_alloc(void) {
 
     instance->storage = furi_record_open(RECORD_STORAGE);
     instance->flipper_format = flipper_format_file_alloc(instance->storage);
+    instance->raw_file = subghz_raw_file_alloc();
+    instance->samples = malloc(sizeof(int32_t) * SUBGHZ_FILE_ENCODER_LOAD);
 
     instance->str_data = furi_string_alloc();
     instance->file_path = furi_string_alloc();
@@ -203,6 +305,8 @@ void subghz_file_encoder_worker_free(SubGhzFileEncoderWorker* instance) {
     furi_string_free(instance->str_data);
     furi_string_free(instance->file_path);
 
+    free(instance->samples);
+    subghz_raw_file_free(instance->raw_file);
     flipper_format_free(instance->flipper_format);
     furi_record_close(RECORD_STORAGE);
 
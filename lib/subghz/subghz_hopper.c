@@ -0,0 +1,207 @@
+#include "subghz_hopper.h"
+
+#include <furi.h>
+#include <math.h>
+
+// Per slot tick, gives statistics half-life of ~700 ticks
+#define SUBGHZ_HOPPER_DECAY        0.999f
+#define SUBGHZ_HOPPER_BURST_WEIGHT 1.0f
+#define SUBGHZ_HOPPER_HIT_WEIGHT   4.0f
+
+// Prior for activity rate, so frequencies not listened to yet aren't starved or favored
+#define SUBGHZ_HOPPER_PRIOR_ACTIVITY 0.1f
+#define SUBGHZ_HOPPER_PRIOR_LISTEN   10.0f
+
+typedef struct {
+    float activity; // Decayed count of RSSI bursts and decoded signals
+    float listen; // Decayed count of slot ticks spent on the frequency
+    float pass; // Stride scheduling virtual time
+    uint32_t hits;
+} SubGhzHopperChannel;
+
+typedef struct {
+    size_t frequency_idx;
+    uint8_t stay_ticks;
+} SubGhzHopperSlot;
+
+struct SubGhzHopper {
+    SubGhzHopperMode mode;
+    size_t frequency_count;
+    uint8_t slot_count;
+    SubGhzHopperSlot slots[SUBGHZ_HOPPER_SLOTS_MAX];
+    SubGhzHopperChannel* channels;
+};
+
+SubGhzHopper* subghz_hopper_alloc(size_t frequency_count, uint8_t slot_count) {
+    furi_check(slot_count > 0 && slot_count <= SUBGHZ_HOPPER_SLOTS_MAX);
+
+    SubGhzHopper* instance = malloc(sizeof(SubGhzHopper));
+    instance->mode = SubGhzHopperModeAdaptive;
+    instance->frequency_count = frequency_count;
+    instance->slot_count = slot_count;
+    instance->channels = malloc(sizeof(SubGhzHopperChannel) * MAX(frequency_count, 1U));
+
+    subghz_hopper_reset(instance);
+
+    return instance;
+}
+
+void subghz_hopper_free(SubGhzHopper* instance) {
+    furi_check(instance);
+
+    free(instance->channels);
+    free(instance);
+}
+
+void subghz_hopper_reset(SubGhzHopper* instance) {
+    furi_check(instance);
+
+    memset(instance->channels, 0, sizeof(SubGhzHopperChannel) * instance->frequency_count);
+    for(uint8_t slot = 0; slot < instance->slot_count; slot++) {
+        instance->slots[slot].frequency_idx =
+            instance->frequency_count ? slot % instance->frequency_count : 0;
+        instance->slots[slot].stay_ticks = 0;
+    }
+}
+
+void subghz_hopper_set_mode(SubGhzHopper* instance, SubGhzHopperMode mode) {
+    furi_check(instance);
+    instance->mode = mode;
+}
+
+size_t subghz_hopper_get_frequency_idx(SubGhzHopper* instance, uint8_t slot) {
+    furi_check(instance);
+    furi_check(slot < instance->slot_count);
+    return instance->slots[slot].frequency_idx;
+}
+
+static bool subghz_hopper_is_taken(SubGhzHopper* instance, size_t frequency_idx, uint8_t slot) {
+    for(uint8_t i = 0; i < instance->slot_count; i++) {
+        if(i != slot && instance->slots[i].frequency_idx == frequency_idx) return true;
+    }
+    return false;
+}
+
+static void subghz_hopper_tick(SubGhzHopper* instance, size_t frequency_idx) {
+    for(size_t i = 0; i < instance->frequency_count; i++) {
+        instance->channels[i].activity *= SUBGHZ_HOPPER_DECAY;
+        instance->channels[i].listen *= SUBGHZ_HOPPER_DECAY;
+    }
+    instance->channels[frequency_idx].listen += 1.0f;
+}
+
+// Activity per listened tick. Raw activity would favor frequencies just because
+// they were listened to more.
+static float subghz_hopper_get_rate(const SubGhzHopperChannel* channel) {
+    return (channel->activity + SUBGHZ_HOPPER_PRIOR_ACTIVITY) /
+           (channel->listen + SUBGHZ_HOPPER_PRIOR_LISTEN);
+}
+
+static size_t subghz_hopper_next_round_robin(SubGhzHopper* instance, uint8_t slot) {
+    size_t frequency_idx = instance->slots[slot].frequency_idx;
+
+    for(size_t i = 0; i < instance->frequency_count; i++) {
+        frequency_idx = (frequency_idx + 1) % instance->frequency_count;
+        if(!subghz_hopper_is_taken(instance, frequency_idx, slot)) break;
+    }
+
+    return frequency_idx;
+}
+
+static size_t subghz_hopper_next_adaptive(SubGhzHopper* instance, uint8_t slot) {
+    size_t next_idx = instance->slots[slot].frequency_idx;
+    float min_pass = INFINITY;
+
+    for(size_t i = 0; i < instance->frequency_count; i++) {
+        if(subghz_hopper_is_taken(instance, i, slot)) continue;
+        if(instance->channels[i].pass < min_pass) {
+            min_pass = instance->channels[i].pass;
+            next_idx = i;
+        }
+    }
+
+    // Keep virtual time small, so float precision doesn't degrade over long sessions
+    for(size_t i = 0; i < instance->frequency_count; i++) {
+        instance->channels[i].pass -= min_pass;
+    }
+
+    // Square root rule: visiting frequencies proportionally to square root
+    // of their rate minimizes the wait for the next transmission
+    SubGhzHopperChannel* channel = &instance->channels[next_idx];
+    channel->pass += 1.0f / sqrtf(subghz_hopper_get_rate(channel));
+
+    return next_idx;
+}
+
+bool subghz_hopper_update(SubGhzHopper* instance, uint8_t slot, float rssi, float threshold) {
+    furi_check(instance);
+    furi_check(slot < instance->slot_count);
+
+    if(instance->frequency_count == 0) return false;
+
+    SubGhzHopperSlot* current = &instance->slots[slot];
+    subghz_hopper_tick(instance, current->frequency_idx);
+
+    if(current->stay_ticks > 0) {
+        // Hop once stay is over, so a constant carrier doesn't hold the slot
+        if(--current->stay_ticks > 0) return false;
+    } else if(rssi > threshold) {
+        instance->channels[current->frequency_idx].activity += SUBGHZ_HOPPER_BURST_WEIGHT;
+        current->stay_ticks = SUBGHZ_HOPPER_STAY_TICKS;
+        return false;
+    }
+
+    size_t next_idx = (instance->mode == SubGhzHopperModeRoundRobin) ?
+                          subghz_hopper_next_round_robin(instance, slot) :
+                          subghz_hopper_next_adaptive(instance, slot);
+
+    if(next_idx == current->frequency_idx) return false;
+
+    current->frequency_idx = next_idx;
+    return true;
+}
+
+void subghz_hopper_add_hit(SubGhzHopper* instance, uint8_t slot) {
+    furi_check(instance);
+    furi_check(slot < instance->slot_count);
+
+    if(instance->frequency_count == 0) return;
+
+    SubGhzHopperSlot* current = &instance->slots[slot];
+    SubGhzHopperChannel* channel = &instance->channels[current->frequency_idx];
+    channel->activity += SUBGHZ_HOPPER_HIT_WEIGHT;
+    channel->hits++;
+
+    // Remotes usually repeat, stay for the next packets
+    current->stay_ticks = SUBGHZ_HOPPER_STAY_TICKS;
+}
+
+uint32_t subghz_hopper_get_hits(SubGhzHopper* instance, size_t frequency_idx) {
+    furi_check(instance);
+    furi_check(frequency_idx < instance->frequency_count);
+    return instance->channels[frequency_idx].hits;
+}
+
+float subghz_hopper_get_capture_probability(SubGhzHopper* instance) {
+    furi_check(instance);
+
+    float rate_total = 0.0f;
+    float listen_total = 0.0f;
+    for(size_t i = 0; i < instance->frequency_count; i++) {
+        rate_total += subghz_hopper_get_rate(&instance->channels[i]);
+        listen_total += instance->channels[i].listen;
+    }
+
+    if(listen_total <= 0.0f) return 0.0f;
+
+    float probability = 0.0f;
+    for(size_t i = 0; i < instance->frequency_count; i++) {
+        const SubGhzHopperChannel* channel = &instance->channels[i];
+        const float rate_share = subghz_hopper_get_rate(channel) / rate_total;
+        // Slots listen on distinct frequencies, so their time shares add up
+        const float listen_share = channel->listen / listen_total * instance->slot_count;
+        probability += rate_share * MIN(listen_share, 1.0f);
+    }
+
+    return probability;
+}
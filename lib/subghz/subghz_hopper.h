@@ -0,0 +1,108 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Maximum number of radios sharing one hopper, each one listening on its own frequency */
+#define SUBGHZ_HOPPER_SLOTS_MAX 2
+
+/** Ticks to stay on a frequency after RSSI crossed the threshold */
+#define SUBGHZ_HOPPER_STAY_TICKS 10
+
+typedef enum {
+    SubGhzHopperModeRoundRobin, /**< Visit frequencies in order, one tick each */
+    SubGhzHopperModeAdaptive, /**< Visit frequencies with more recent activity more often */
+} SubGhzHopperMode;
+
+/** Frequency hopping scheduler
+ *
+ * Frequencies are referred to by their index in the hopper frequency list.
+ * Every tick each slot reports RSSI measured on its current frequency and
+ * is told whether to hop. RSSI bursts and decoded signals are accumulated
+ * into per-frequency activity, decaying over time, along with time spent
+ * listening. In adaptive mode frequencies are chosen by stride scheduling
+ * weighted by square root of activity per listened tick, so busy
+ * frequencies are revisited more often while idle ones are still visited.
+ */
+typedef struct SubGhzHopper SubGhzHopper;
+
+/** Allocate SubGhzHopper
+ *
+ * @param frequency_count   number of hopper frequencies
+ * @param slot_count        number of radios, up to SUBGHZ_HOPPER_SLOTS_MAX
+ * @return SubGhzHopper instance
+ */
+SubGhzHopper* subghz_hopper_alloc(size_t frequency_count, uint8_t slot_count);
+
+/** Free SubGhzHopper
+ *
+ * @param instance SubGhzHopper instance
+ */
+void subghz_hopper_free(SubGhzHopper* instance);
+
+/** Forget collected statistics and put slots on the first frequencies
+ *
+ * @param instance SubGhzHopper instance
+ */
+void subghz_hopper_reset(SubGhzHopper* instance);
+
+/** Set scheduling mode
+ *
+ * @param instance  SubGhzHopper instance
+ * @param mode      SubGhzHopperMode
+ */
+void subghz_hopper_set_mode(SubGhzHopper* instance, SubGhzHopperMode mode);
+
+/** Get frequency index the slot listens on
+ *
+ * @param instance  SubGhzHopper instance
+ * @param slot      slot number
+ * @return frequency index
+ */
+size_t subghz_hopper_get_frequency_idx(SubGhzHopper* instance, uint8_t slot);
+
+/** Account one tick of the slot and pick its next frequency
+ *
+ * @param instance  SubGhzHopper instance
+ * @param slot      slot number
+ * @param rssi      RSSI measured on the current frequency, dBm
+ * @param threshold RSSI level to stay on the frequency at, dBm
+ * @return true if the slot has to be tuned to a new frequency
+ */
+bool subghz_hopper_update(SubGhzHopper* instance, uint8_t slot, float rssi, float threshold);
+
+/** Report a signal decoded on the current frequency of the slot
+ *
+ * @param instance  SubGhzHopper instance
+ * @param slot      slot number
+ */
+void subghz_hopper_add_hit(SubGhzHopper* instance, uint8_t slot);
+
+/** Get number of signals decoded on the frequency
+ *
+ * @param instance      SubGhzHopper instance
+ * @param frequency_idx frequency index
+ * @return number of hits
+ */
+uint32_t subghz_hopper_get_hits(SubGhzHopper* instance, size_t frequency_idx);
+
+/** Estimate probability of catching the next transmission
+ *
+ * Chance of listening on the right frequency at the moment a transmission
+ * starts: recent share of listening time of every frequency weighted by its
+ * share of activity rate. Transmissions longer than a tick are caught more
+ * often than that, so it is a lower bound.
+ *
+ * @param instance SubGhzHopper instance
+ * @return probability, 0 to 1
+ */
+float subghz_hopper_get_capture_probability(SubGhzHopper* instance);
+
+#ifdef __cplusplus
+}
+#endif
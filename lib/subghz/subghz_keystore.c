@@ -31,6 +31,9 @@ SubGhzKeystore* subghz_keystore_alloc(void) {
     SubGhzKeystore* instance = malloc(sizeof(SubGhzKeystore));
 
     SubGhzKeyArray_init(instance->data);
+    instance->keeloq_slices = NULL;
+    instance->keeloq_slices_count = 0;
+    instance->keeloq_matches_count = 0;
 
     subghz_keystore_reset_kl(instance);
 
@@ -54,6 +57,7 @@ void subghz_keystore_free(SubGhzKeystore* instance) {
         }
     SubGhzKeyArray_clear(instance->data);
 
+    free(instance->keeloq_slices);
     free(instance);
 }
 
@@ -68,6 +72,28 @@ static void subghz_keystore_add_key(
     manufacture_code->type = type;
 }
 
+static void subghz_keystore_update_keeloq_slices(SubGhzKeystore* instance) {
+    const size_t keys_count = SubGhzKeyArray_size(instance->data);
+    const size_t slices_count = (keys_count + KEELOQ_SLICE_WIDTH - 1) / KEELOQ_SLICE_WIDTH;
+
+    free(instance->keeloq_slices);
+    instance->keeloq_slices = calloc(slices_count, sizeof(SubGhzKeystoreKeeloqSlice));
+    instance->keeloq_slices_count = slices_count;
+    // Key indices may have changed
+    instance->keeloq_matches_count = 0;
+
+    for(size_t i = 0; i < keys_count; i++) {
+        const SubGhzKey* manufacture_code = SubGhzKeyArray_cget(instance->data, i);
+        SubGhzKeystoreKeeloqSlice* slice = &instance->keeloq_slices[i / KEELOQ_SLICE_WIDTH];
+        const size_t lane = i % KEELOQ_SLICE_WIDTH;
+
+        subghz_protocol_keeloq_common_slice_set_key(&slice->keys, lane, manufacture_code->key);
+        if(manufacture_code->type < COUNT_OF(slice->type_lanes)) {
+            slice->type_lanes[manufacture_code->type] |= 1UL << lane;
+        }
+    }
+}
+
 static bool subghz_keystore_process_line(SubGhzKeystore* instance, char* line) {
     uint64_t key = 0;
     uint16_t type = 0;
@@ -239,6 +265,8 @@ bool subghz_keystore_load(SubGhzKeystore* instance, const char* file_name) {
             FURI_LOG_E(TAG, "Unknown encryption");
             break;
         }
+
+        subghz_keystore_update_keeloq_slices(instance);
     } while(0);
     flipper_format_free(flipper_format);
 
@@ -2,8 +2,33 @@
 
 #include <m-array.h>
 
+#include "protocols/keeloq_common.h"
+
+#define SUBGHZ_KEYSTORE_KEELOQ_MATCHES_MAX (8U)
+
+/* Keys in bitsliced form, built once on load, so that KeeLoq can check them 32 at a time */
+typedef struct {
+    KeeloqKeySlice keys;
+    /* Lanes holding a key of each KeeLoq learning type */
+    uint32_t type_lanes[KEELOQ_LEARNING_MAGIC_SERIAL_TYPE_3 + 1];
+} SubGhzKeystoreKeeloqSlice;
+
+/* Key that was found for a serial number by a previous KeeLoq decode */
+typedef struct {
+    uint32_t serial;
+    uint32_t key_index;
+    uint8_t check;
+} SubGhzKeystoreKeeloqMatch;
+
 struct SubGhzKeystore {
     SubGhzKeyArray_t data;
     const char* mfname;
     uint8_t kl_type;
+
+    SubGhzKeystoreKeeloqSlice* keeloq_slices;
+    size_t keeloq_slices_count;
+
+    /* Most recent match first */
+    SubGhzKeystoreKeeloqMatch keeloq_matches[SUBGHZ_KEYSTORE_KEELOQ_MATCHES_MAX];
+    size_t keeloq_matches_count;
 };
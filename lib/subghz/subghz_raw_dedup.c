@@ -0,0 +1,501 @@
+#include "subghz_raw_dedup.h"
+#include "subghz_raw_file.h"
+#include "types.h"
+
+#include <flipper_format/flipper_format_i.h>
+#include <toolbox/stream/stream.h>
+
+#define TAG "SubGhzRawDedup"
+
+// Pulses used for the fingerprint, the rest of a long burst is only counted
+#define SUBGHZ_RAW_DEDUP_PULSES_MAX 512
+
+#define SUBGHZ_RAW_DEDUP_HISTOGRAM_SIZE 16
+// Share of pulses in the histogram bucket to take it for the base pulse width, 1/8
+#define SUBGHZ_RAW_DEDUP_BASE_SHARE_SHIFT 3
+// Symbols are whole base widths up to this, then powers of two split in 4 steps
+#define SUBGHZ_RAW_DEDUP_SYMBOL_LINEAR_MAX 16
+
+#define SUBGHZ_RAW_DEDUP_FNV_OFFSET 2166136261UL
+#define SUBGHZ_RAW_DEDUP_FNV_PRIME  16777619UL
+
+typedef struct {
+    uint32_t hash;
+    size_t pulse_count;
+    size_t kept_index;
+} SubGhzRawDedupCluster;
+
+struct SubGhzRawDedup {
+    // Burst segmentation, shared by both passes
+    bool in_burst;
+    size_t burst_count;
+    size_t pulse_count;
+    int16_t* pulses;
+
+    SubGhzRawDedupCluster clusters[SUBGHZ_RAW_DEDUP_CLUSTERS_MAX];
+    size_t cluster_count;
+
+    // Keep flag of every burst, bitmap by burst index
+    uint32_t* keep;
+    size_t keep_size;
+    // Repeat count of every kept burst
+    uint32_t* repeats;
+    size_t repeats_size;
+    size_t kept_count;
+    // Repeat counts of source bursts if it is deduplicated already, not owned
+    const uint32_t* weights;
+    size_t weights_count;
+
+    // Second pass segmentation
+    bool filter_in_burst;
+    bool filter_keep;
+    size_t filter_burst_count;
+};
+
+SubGhzRawDedup* subghz_raw_dedup_alloc(void) {
+    SubGhzRawDedup* instance = malloc(sizeof(SubGhzRawDedup));
+    instance->pulses = malloc(SUBGHZ_RAW_DEDUP_PULSES_MAX * sizeof(int16_t));
+    return instance;
+}
+
+void subghz_raw_dedup_free(SubGhzRawDedup* instance) {
+    furi_check(instance);
+
+    free(instance->repeats);
+    free(instance->keep);
+    free(instance->pulses);
+    free(instance);
+}
+
+void subghz_raw_dedup_reset(SubGhzRawDedup* instance) {
+    furi_check(instance);
+
+    instance->in_burst = false;
+    instance->burst_count = 0;
+    instance->pulse_count = 0;
+    instance->cluster_count = 0;
+    instance->kept_count = 0;
+    if(instance->keep) memset(instance->keep, 0, instance->keep_size * sizeof(uint32_t));
+    instance->filter_in_burst = false;
+    instance->filter_keep = false;
+    instance->filter_burst_count = 0;
+}
+
+static inline uint32_t subghz_raw_dedup_abs(int32_t duration) {
+    return (duration < 0) ? (uint32_t)-duration : (uint32_t)duration;
+}
+
+static inline bool subghz_raw_dedup_is_gap(int32_t duration) {
+    return duration <= -SUBGHZ_RAW_DEDUP_GAP_US;
+}
+
+static inline uint8_t subghz_raw_dedup_log2(uint32_t value) {
+    return (uint8_t)(31 - __builtin_clz(value | 1));
+}
+
+// Base pulse width: mean of the shortest common pulses. The lowest histogram
+// bucket holding enough pulses gives a rough value, then it is refined over
+// pulses close to it, as jitter may spread them over two buckets.
+static uint32_t subghz_raw_dedup_get_base(const int16_t* pulses, size_t count) {
+    uint32_t bucket_count[SUBGHZ_RAW_DEDUP_HISTOGRAM_SIZE] = {};
+    uint32_t bucket_sum[SUBGHZ_RAW_DEDUP_HISTOGRAM_SIZE] = {};
+
+    for(size_t i = 0; i < count; i++) {
+        const uint32_t width = subghz_raw_dedup_abs(pulses[i]);
+        const uint8_t bucket =
+            MIN(subghz_raw_dedup_log2(width), SUBGHZ_RAW_DEDUP_HISTOGRAM_SIZE - 1);
+        bucket_count[bucket]++;
+        bucket_sum[bucket] += width;
+    }
+
+    uint32_t rough = 0;
+    for(size_t bucket = 0; bucket < SUBGHZ_RAW_DEDUP_HISTOGRAM_SIZE; bucket++) {
+        if(bucket_count[bucket] &&
+           (bucket_count[bucket] << SUBGHZ_RAW_DEDUP_BASE_SHARE_SHIFT) >= count) {
+            rough = bucket_sum[bucket] / bucket_count[bucket];
+            break;
+        }
+    }
+    if(!rough) return 1;
+
+    uint32_t near_count = 0;
+    uint32_t near_sum = 0;
+    for(size_t i = 0; i < count; i++) {
+        const uint32_t width = subghz_raw_dedup_abs(pulses[i]);
+        if(width * 4 >= rough * 3 && width * 2 <= rough * 3) {
+            near_count++;
+            near_sum += width;
+        }
+    }
+
+    return MAX(near_sum / MAX(near_count, 1U), 1U);
+}
+
+// Pulse width in base widths with level in the top bit. Long pulses jitter
+// by more than a base width, so they are quantized logarithmically.
+static uint8_t subghz_raw_dedup_get_symbol(int16_t pulse, uint32_t base) {
+    const uint32_t width = subghz_raw_dedup_abs(pulse);
+    uint32_t symbol = (width + base / 2) / base;
+
+    if(symbol > SUBGHZ_RAW_DEDUP_SYMBOL_LINEAR_MAX) {
+        // Integer log2 with 2 fractional bits
+        const uint8_t exponent = subghz_raw_dedup_log2(symbol);
+        const uint32_t fraction = (symbol >> (exponent - 2)) & 0x3;
+        symbol = SUBGHZ_RAW_DEDUP_SYMBOL_LINEAR_MAX + (exponent - 4) * 4 + fraction;
+    }
+
+    return (uint8_t)(MIN(symbol, 0x7FU) | ((pulse > 0) ? 0x80 : 0x00));
+}
+
+static void
+    subghz_raw_dedup_keep(SubGhzRawDedup* instance, size_t burst_index, uint32_t weight) {
+    const size_t word = burst_index / 32;
+    if(word >= instance->keep_size) {
+        const size_t size = MAX(instance->keep_size * 2, word + 1);
+        instance->keep = realloc(instance->keep, size * sizeof(uint32_t));
+        memset(
+            instance->keep + instance->keep_size,
+            0,
+            (size - instance->keep_size) * sizeof(uint32_t));
+        instance->keep_size = size;
+    }
+    instance->keep[word] |= 1UL << (burst_index % 32);
+
+    if(instance->kept_count >= instance->repeats_size) {
+        instance->repeats_size = MAX(instance->repeats_size * 2, 16U);
+        instance->repeats =
+            realloc(instance->repeats, instance->repeats_size * sizeof(uint32_t));
+    }
+    instance->repeats[instance->kept_count++] = weight;
+}
+
+static bool subghz_raw_dedup_is_kept(SubGhzRawDedup* instance, size_t burst_index) {
+    const size_t word = burst_index / 32;
+    return (word < instance->keep_size) && (instance->keep[word] & (1UL << (burst_index % 32)));
+}
+
+static void subghz_raw_dedup_end_burst(SubGhzRawDedup* instance) {
+    const size_t count = MIN(instance->pulse_count, (size_t)SUBGHZ_RAW_DEDUP_PULSES_MAX);
+    const uint32_t base = subghz_raw_dedup_get_base(instance->pulses, count);
+
+    // FNV-1a over symbols, first and last pulses are often cut by the receiver
+    uint32_t hash = SUBGHZ_RAW_DEDUP_FNV_OFFSET;
+    for(size_t i = 1; i + 1 < count; i++) {
+        hash ^= subghz_raw_dedup_get_symbol(instance->pulses[i], base);
+        hash *= SUBGHZ_RAW_DEDUP_FNV_PRIME;
+    }
+
+    const size_t burst_index = instance->burst_count++;
+    const uint32_t weight =
+        (burst_index < instance->weights_count) ? instance->weights[burst_index] : 1;
+    instance->in_burst = false;
+
+    for(size_t i = 0; i < instance->cluster_count; i++) {
+        SubGhzRawDedupCluster* cluster = &instance->clusters[i];
+        if(cluster->hash == hash && cluster->pulse_count == instance->pulse_count) {
+            instance->repeats[cluster->kept_index] += weight;
+            return;
+        }
+    }
+
+    // Once clusters are exhausted unknown bursts are kept as they are
+    if(instance->cluster_count < SUBGHZ_RAW_DEDUP_CLUSTERS_MAX) {
+        SubGhzRawDedupCluster* cluster = &instance->clusters[instance->cluster_count++];
+        cluster->hash = hash;
+        cluster->pulse_count = instance->pulse_count;
+        cluster->kept_index = instance->kept_count;
+    }
+    subghz_raw_dedup_keep(instance, burst_index, weight);
+}
+
+void subghz_raw_dedup_feed(SubGhzRawDedup* instance, const int32_t* samples, size_t count) {
+    furi_check(instance);
+    furi_check(samples);
+
+    for(size_t i = 0; i < count; i++) {
+        const int32_t sample = samples[i];
+        if(subghz_raw_dedup_is_gap(sample)) {
+            if(instance->in_burst) subghz_raw_dedup_end_burst(instance);
+            continue;
+        }
+
+        if(!instance->in_burst) {
+            instance->in_burst = true;
+            instance->pulse_count = 0;
+        }
+        if(instance->pulse_count < SUBGHZ_RAW_DEDUP_PULSES_MAX) {
+            instance->pulses[instance->pulse_count] = (int16_t)CLAMP(sample, INT16_MAX, INT16_MIN);
+        }
+        instance->pulse_count++;
+    }
+}
+
+void subghz_raw_dedup_rewind(SubGhzRawDedup* instance) {
+    furi_check(instance);
+
+    if(instance->in_burst) subghz_raw_dedup_end_burst(instance);
+    instance->filter_in_burst = false;
+    instance->filter_keep = false;
+    instance->filter_burst_count = 0;
+}
+
+size_t subghz_raw_dedup_filter(
+    SubGhzRawDedup* instance,
+    const int32_t* samples,
+    size_t count,
+    int32_t* output) {
+    furi_check(instance);
+    furi_check(samples);
+    furi_check(output);
+
+    size_t kept = 0;
+    for(size_t i = 0; i < count; i++) {
+        const int32_t sample = samples[i];
+        // Gap ending a burst goes with it, so repeats keep their spacing on replay
+        if(subghz_raw_dedup_is_gap(sample)) {
+            if(instance->filter_in_burst && instance->filter_keep) output[kept++] = sample;
+            instance->filter_in_burst = false;
+            continue;
+        }
+
+        if(!instance->filter_in_burst) {
+            instance->filter_in_burst = true;
+            instance->filter_keep =
+                subghz_raw_dedup_is_kept(instance, instance->filter_burst_count++);
+        }
+        if(instance->filter_keep) output[kept++] = sample;
+    }
+
+    return kept;
+}
+
+size_t subghz_raw_dedup_get_burst_count(SubGhzRawDedup* instance) {
+    furi_check(instance);
+    return instance->burst_count;
+}
+
+size_t subghz_raw_dedup_get_kept_count(SubGhzRawDedup* instance) {
+    furi_check(instance);
+    return instance->kept_count;
+}
+
+uint32_t subghz_raw_dedup_get_repeats(SubGhzRawDedup* instance, size_t index) {
+    furi_check(instance);
+    furi_check(index < instance->kept_count);
+    return instance->repeats[index];
+}
+
+// Start of the line the position is in
+static size_t subghz_raw_dedup_get_line_start(Stream* stream, size_t position) {
+    uint8_t data;
+    while(position > 0) {
+        if(!stream_seek(stream, position - 1, StreamOffsetFromStart) ||
+           stream_read(stream, &data, 1) != 1 || data == '\n') {
+            break;
+        }
+        position--;
+    }
+    return position;
+}
+
+// Find repeats key in the header, from current position up to Protocol key.
+// Stream is left at the start of the line found, line end is stored if found.
+static bool subghz_raw_dedup_find_repeats(Stream* stream, FuriString* line, size_t* line_end) {
+    while(true) {
+        const size_t position = stream_tell(stream);
+        if(!stream_read_line(stream, line)) return false;
+
+        const bool found = furi_string_start_with_str(line, SUBGHZ_RAW_DEDUP_REPEATS_KEY ":");
+        if(found || furi_string_start_with_str(line, "Protocol:")) {
+            if(found && line_end) *line_end = stream_tell(stream);
+            stream_seek(stream, position, StreamOffsetFromStart);
+            return found;
+        }
+    }
+}
+
+uint32_t* subghz_raw_dedup_read_repeats(FlipperFormat* flipper_format, size_t* count) {
+    furi_check(flipper_format);
+    furi_check(count);
+
+    Stream* stream = flipper_format_get_raw_stream(flipper_format);
+    FuriString* line = furi_string_alloc();
+    uint32_t* repeats = NULL;
+    uint32_t repeats_count = 0;
+
+    // Key is looked up in the header only, RAW data that follows may be long
+    if(subghz_raw_dedup_find_repeats(stream, line, NULL) &&
+       flipper_format_get_value_count(
+           flipper_format, SUBGHZ_RAW_DEDUP_REPEATS_KEY, &repeats_count) &&
+       repeats_count && repeats_count <= UINT16_MAX) {
+        repeats = malloc(repeats_count * sizeof(uint32_t));
+        if(!flipper_format_read_uint32(
+               flipper_format, SUBGHZ_RAW_DEDUP_REPEATS_KEY, repeats, repeats_count)) {
+            FURI_LOG_E(TAG, "Invalid repeats");
+            free(repeats);
+            repeats = NULL;
+        }
+    }
+
+    furi_string_free(line);
+    *count = repeats ? repeats_count : 0;
+    return repeats;
+}
+
+// Open RAW file and read its file type and version
+static bool
+    subghz_raw_dedup_open(FlipperFormat* flipper_format, const char* path, FuriString* temp_str) {
+    uint32_t version;
+    if(!flipper_format_file_open_existing(flipper_format, path)) {
+        FURI_LOG_E(TAG, "Unable to open file for read: %s", path);
+        return false;
+    }
+    if(!flipper_format_read_header(flipper_format, temp_str, &version) ||
+       furi_string_cmp_str(temp_str, SUBGHZ_RAW_FILE_TYPE)) {
+        FURI_LOG_E(TAG, "Not a RAW file");
+        return false;
+    }
+    return true;
+}
+
+bool subghz_raw_dedup_file(
+    Storage* storage,
+    const char* source_path,
+    const char* destination_path,
+    SubGhzRawDedupStats* stats) {
+    furi_check(storage);
+    furi_check(source_path);
+    furi_check(destination_path);
+
+    FlipperFormat* source = flipper_format_file_alloc(storage);
+    FlipperFormat* destination = flipper_format_file_alloc(storage);
+    SubGhzRawFile* reader = subghz_raw_file_alloc();
+    SubGhzRawFile* writer = subghz_raw_file_alloc();
+    SubGhzRawDedup* dedup = subghz_raw_dedup_alloc();
+    int32_t* samples = malloc(SUBGHZ_RAW_FILE_BLOCK_SIZE_MAX * sizeof(int32_t));
+    uint32_t* repeats = NULL;
+    uint32_t* weights = NULL;
+    FuriString* temp_str = furi_string_alloc();
+    SubGhzRawDedupStats result_stats = {};
+    bool result = false;
+
+    do {
+        if(!subghz_raw_dedup_open(source, source_path, temp_str)) break;
+        Stream* source_stream = flipper_format_get_raw_stream(source);
+
+        // Repeats of source deduplicated before are replaced, they weigh its bursts instead
+        size_t repeats_start = 0;
+        size_t repeats_end = 0;
+        if(subghz_raw_dedup_find_repeats(source_stream, temp_str, &repeats_end)) {
+            repeats_start = stream_tell(source_stream);
+            weights = subghz_raw_dedup_read_repeats(source, &dedup->weights_count);
+            if(!weights) break;
+            dedup->weights = weights;
+        }
+        if(!flipper_format_read_string(source, "Protocol", temp_str)) {
+            FURI_LOG_E(TAG, "Missing Protocol");
+            break;
+        }
+        const size_t header_size = stream_tell(source_stream);
+        const size_t protocol_start = subghz_raw_dedup_get_line_start(source_stream, header_size);
+        if(!stream_seek(source_stream, header_size, StreamOffsetFromStart)) break;
+        const SubGhzRawFileFormat format = subghz_raw_file_read_format(reader, source);
+        const size_t data_start = stream_tell(source_stream);
+
+        // First pass: cluster bursts
+        size_t count;
+        while((count = subghz_raw_file_read(
+                   reader, source, samples, SUBGHZ_RAW_FILE_BLOCK_SIZE_MAX)) > 0) {
+            subghz_raw_dedup_feed(dedup, samples, count);
+            result_stats.samples_in += count;
+        }
+        subghz_raw_dedup_rewind(dedup);
+        result_stats.burst_count = subghz_raw_dedup_get_burst_count(dedup);
+        result_stats.kept_count = subghz_raw_dedup_get_kept_count(dedup);
+
+        if(result_stats.kept_count > UINT16_MAX) {
+            FURI_LOG_E(TAG, "Too many distinct bursts");
+            break;
+        }
+        if(!flipper_format_file_open_always(destination, destination_path)) {
+            FURI_LOG_E(TAG, "Unable to open file for write: %s", destination_path);
+            break;
+        }
+
+        // Format marker has to follow Protocol, so repeats go right before it
+        Stream* destination_stream = flipper_format_get_raw_stream(destination);
+        const size_t copy_size = repeats_end ? repeats_start : protocol_start;
+        if(!stream_rewind(source_stream) ||
+           stream_copy(source_stream, destination_stream, copy_size) != copy_size) {
+            FURI_LOG_E(TAG, "Unable to copy header");
+            break;
+        }
+        if(repeats_end) {
+            const size_t rest_size = protocol_start - repeats_end;
+            if(!stream_seek(source_stream, repeats_end, StreamOffsetFromStart) ||
+               stream_copy(source_stream, destination_stream, rest_size) != rest_size) {
+                FURI_LOG_E(TAG, "Unable to copy header");
+                break;
+            }
+        }
+        if(result_stats.kept_count) {
+            repeats = malloc(result_stats.kept_count * sizeof(uint32_t));
+            for(size_t i = 0; i < result_stats.kept_count; i++) {
+                repeats[i] = subghz_raw_dedup_get_repeats(dedup, i);
+            }
+            if(!flipper_format_write_uint32(
+                   destination,
+                   SUBGHZ_RAW_DEDUP_REPEATS_KEY,
+                   repeats,
+                   (uint16_t)result_stats.kept_count)) {
+                FURI_LOG_E(TAG, "Unable to write repeats");
+                break;
+            }
+        }
+        const size_t protocol_size = header_size - protocol_start;
+        if(stream_copy(source_stream, destination_stream, protocol_size) != protocol_size ||
+           stream_write_char(destination_stream, '\n') != 1) {
+            FURI_LOG_E(TAG, "Unable to copy header");
+            break;
+        }
+        if(!subghz_raw_file_write_format(writer, destination, format)) {
+            FURI_LOG_E(TAG, "Unable to write format");
+            break;
+        }
+
+        // Second pass: write kept bursts
+        if(!stream_seek(source_stream, data_start, StreamOffsetFromStart)) break;
+        bool write_error = false;
+        while((count = subghz_raw_file_read(
+                   reader, source, samples, SUBGHZ_RAW_FILE_BLOCK_SIZE_MAX)) > 0) {
+            count = subghz_raw_dedup_filter(dedup, samples, count, samples);
+            if(count && !subghz_raw_file_write(writer, destination, samples, count)) {
+                write_error = true;
+                break;
+            }
+            result_stats.samples_out += count;
+        }
+        if(write_error) {
+            FURI_LOG_E(TAG, "Unable to write data");
+            break;
+        }
+
+        result = true;
+    } while(false);
+
+    furi_string_free(temp_str);
+    free(weights);
+    free(repeats);
+    free(samples);
+    subghz_raw_dedup_free(dedup);
+    subghz_raw_file_free(writer);
+    subghz_raw_file_free(reader);
+    flipper_format_file_close(destination);
+    flipper_format_file_close(source);
+    flipper_format_free(destination);
+    flipper_format_free(source);
+
+    if(stats) *stats = result_stats;
+
+    return result;
+}
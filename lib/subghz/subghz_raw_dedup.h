@@ -0,0 +1,142 @@
+#pragma once
+
+#include <storage/storage.h>
+#include <flipper_format/flipper_format.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Key with repeat count of every burst in deduplicated RAW file, written before Protocol key */
+#define SUBGHZ_RAW_DEDUP_REPEATS_KEY "RAW_Repeats"
+
+/** Low level at least that long in us separates bursts */
+#define SUBGHZ_RAW_DEDUP_GAP_US 5000
+
+/** Maximum number of distinct bursts tracked, once exceeded new bursts are all kept */
+#define SUBGHZ_RAW_DEDUP_CLUSTERS_MAX 64
+
+typedef struct {
+    size_t burst_count; /**< Bursts in source */
+    size_t kept_count; /**< Bursts written to destination */
+    size_t samples_in; /**< Samples in source */
+    size_t samples_out; /**< Samples written to destination */
+} SubGhzRawDedupStats;
+
+/** Streaming deduplication of SubGhz RAW samples
+ *
+ * Samples are split into bursts by long low levels. Every burst is
+ * fingerprinted: pulse widths are quantized to the base pulse width taken
+ * from a log2 width histogram, and the resulting symbol sequence is hashed.
+ * First and last pulses are left out, as receiver often cuts them.
+ * Bursts with the same fingerprint form a cluster.
+ *
+ * Data is processed in two passes: subghz_raw_dedup_feed() over all samples
+ * to build clusters, then, after subghz_raw_dedup_rewind(), the same samples
+ * through subghz_raw_dedup_filter() to get the first burst of every cluster
+ * along with the gap after it.
+ */
+typedef struct SubGhzRawDedup SubGhzRawDedup;
+
+/** Allocate SubGhzRawDedup
+ *
+ * @return SubGhzRawDedup instance
+ */
+SubGhzRawDedup* subghz_raw_dedup_alloc(void);
+
+/** Free SubGhzRawDedup
+ *
+ * @param instance SubGhzRawDedup instance
+ */
+void subghz_raw_dedup_free(SubGhzRawDedup* instance);
+
+/** Forget all bursts and clusters
+ *
+ * @param instance SubGhzRawDedup instance
+ */
+void subghz_raw_dedup_reset(SubGhzRawDedup* instance);
+
+/** Analyze next samples, first pass
+ *
+ * @param instance  SubGhzRawDedup instance
+ * @param samples   signed durations, positive for high level
+ * @param count     sample count
+ */
+void subghz_raw_dedup_feed(SubGhzRawDedup* instance, const int32_t* samples, size_t count);
+
+/** Finish the first pass and prepare for the second one
+ *
+ * @param instance SubGhzRawDedup instance
+ */
+void subghz_raw_dedup_rewind(SubGhzRawDedup* instance);
+
+/** Filter next samples, second pass
+ *
+ * Samples must be the same as in the first pass, in any chunks.
+ *
+ * @param instance  SubGhzRawDedup instance
+ * @param samples   signed durations, positive for high level
+ * @param count     sample count
+ * @param output    kept samples, at least count in size, may be the same as samples
+ * @return number of kept samples
+ */
+size_t subghz_raw_dedup_filter(
+    SubGhzRawDedup* instance,
+    const int32_t* samples,
+    size_t count,
+    int32_t* output);
+
+/** Get number of bursts seen in the first pass
+ *
+ * @param instance SubGhzRawDedup instance
+ * @return burst count
+ */
+size_t subghz_raw_dedup_get_burst_count(SubGhzRawDedup* instance);
+
+/** Get number of bursts kept by filter
+ *
+ * @param instance SubGhzRawDedup instance
+ * @return kept burst count
+ */
+size_t subghz_raw_dedup_get_kept_count(SubGhzRawDedup* instance);
+
+/** Get how many times kept burst was seen
+ *
+ * @param instance  SubGhzRawDedup instance
+ * @param index     kept burst index
+ * @return repeat count
+ */
+uint32_t subghz_raw_dedup_get_repeats(SubGhzRawDedup* instance, size_t index);
+
+/** Read SUBGHZ_RAW_DEDUP_REPEATS_KEY from RAW file header
+ *
+ * Key is looked up from the current position up to Protocol key, which is
+ * still to be read after the call.
+ *
+ * @param flipper_format    FlipperFormat instance, positioned in the header
+ * @param count             repeat count output, 0 if there are none
+ * @return allocated repeat count of every burst, NULL if there are none
+ */
+uint32_t* subghz_raw_dedup_read_repeats(FlipperFormat* flipper_format, size_t* count);
+
+/** Write RAW file with one burst per cluster
+ *
+ * Header is copied as is, SUBGHZ_RAW_DEDUP_REPEATS_KEY is added before
+ * Protocol key. Source deduplicated before has its repeats merged into the
+ * new ones. Data is written in the source format.
+ *
+ * @param storage           Storage instance
+ * @param source_path       source file path
+ * @param destination_path  destination file path, overwritten
+ * @param stats             statistics output, may be NULL
+ * @return true on success
+ */
+bool subghz_raw_dedup_file(
+    Storage* storage,
+    const char* source_path,
+    const char* destination_path,
+    SubGhzRawDedupStats* stats);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,350 @@
+#include "subghz_raw_file.h"
+#include "types.h"
+
+#include <flipper_format/flipper_format_i.h>
+#include <toolbox/stream/stream.h>
+#include <toolbox/varint.h>
+#include <toolbox/strint.h>
+#include <toolbox/crc.h>
+
+#define TAG "SubGhzRawFile"
+
+#define SUBGHZ_RAW_FILE_DATA_KEY "RAW_Data"
+
+#define SUBGHZ_RAW_FILE_BLOCK_MAGIC    0x4252
+#define SUBGHZ_RAW_FILE_BLOCK_DATA_MAX (SUBGHZ_RAW_FILE_BLOCK_SIZE_MAX * 5)
+
+typedef struct {
+    uint16_t magic;
+    uint16_t sample_count;
+    uint16_t data_size;
+    uint16_t crc;
+} FURI_PACKED SubGhzRawFileBlockHeader;
+
+struct SubGhzRawFile {
+    SubGhzRawFileFormat format;
+    // Block header followed by payload
+    uint8_t* buffer;
+    // Current text line and parse position in it
+    FuriString* line;
+    const char* cursor;
+};
+
+SubGhzRawFile* subghz_raw_file_alloc(void) {
+    SubGhzRawFile* instance = malloc(sizeof(SubGhzRawFile));
+    instance->format = SubGhzRawFileFormatText;
+    instance->buffer = malloc(sizeof(SubGhzRawFileBlockHeader) + SUBGHZ_RAW_FILE_BLOCK_DATA_MAX);
+    instance->line = furi_string_alloc();
+    instance->cursor = NULL;
+    return instance;
+}
+
+void subghz_raw_file_free(SubGhzRawFile* instance) {
+    furi_check(instance);
+    furi_string_free(instance->line);
+    free(instance->buffer);
+    free(instance);
+}
+
+bool subghz_raw_file_write_format(
+    SubGhzRawFile* instance,
+    FlipperFormat* flipper_format,
+    SubGhzRawFileFormat format) {
+    furi_check(instance);
+    furi_check(flipper_format);
+
+    instance->format = format;
+    if(format == SubGhzRawFileFormatText) return true;
+
+    uint32_t version = SUBGHZ_RAW_FILE_FORMAT_VERSION;
+    return flipper_format_write_uint32(flipper_format, SUBGHZ_RAW_FILE_FORMAT_KEY, &version, 1);
+}
+
+static bool subghz_raw_file_write_block(
+    SubGhzRawFile* instance,
+    Stream* stream,
+    const int32_t* samples,
+    size_t count) {
+    uint8_t* data = instance->buffer + sizeof(SubGhzRawFileBlockHeader);
+    size_t data_size = 0;
+    for(size_t i = 0; i < count; i++) {
+        data_size += varint_int32_pack(samples[i], &data[data_size]);
+    }
+
+    SubGhzRawFileBlockHeader header = {
+        .magic = SUBGHZ_RAW_FILE_BLOCK_MAGIC,
+        .sample_count = count,
+        .data_size = data_size,
+        .crc = crc16_ccitt_update(0xFFFF, data, data_size),
+    };
+    memcpy(instance->buffer, &header, sizeof(SubGhzRawFileBlockHeader));
+
+    size_t size = sizeof(SubGhzRawFileBlockHeader) + data_size;
+    return stream_write(stream, instance->buffer, size) == size;
+}
+
+bool subghz_raw_file_write(
+    SubGhzRawFile* instance,
+    FlipperFormat* flipper_format,
+    const int32_t* samples,
+    size_t count) {
+    furi_check(instance);
+    furi_check(flipper_format);
+    furi_check(samples);
+    furi_check(count <= SUBGHZ_RAW_FILE_BLOCK_SIZE_MAX);
+
+    if(instance->format == SubGhzRawFileFormatBinary) {
+        return subghz_raw_file_write_block(
+            instance, flipper_format_get_raw_stream(flipper_format), samples, count);
+    } else {
+        return flipper_format_write_int32(flipper_format, SUBGHZ_RAW_FILE_DATA_KEY, samples, count);
+    }
+}
+
+SubGhzRawFileFormat
+    subghz_raw_file_read_format(SubGhzRawFile* instance, FlipperFormat* flipper_format) {
+    furi_check(instance);
+    furi_check(flipper_format);
+
+    Stream* stream = flipper_format_get_raw_stream(flipper_format);
+    instance->format = SubGhzRawFileFormatText;
+    instance->cursor = NULL;
+
+    // Skip the end of Protocol line
+    stream_read_line(stream, instance->line);
+
+    size_t position = stream_tell(stream);
+    if(stream_read_line(stream, instance->line) &&
+       furi_string_start_with_str(instance->line, SUBGHZ_RAW_FILE_FORMAT_KEY ": ")) {
+        uint32_t version = 0;
+        const char* value = furi_string_get_cstr(instance->line) +
+                            strlen(SUBGHZ_RAW_FILE_FORMAT_KEY ": ");
+        if(strint_to_uint32(value, NULL, &version, 10) == StrintParseNoError &&
+           version == SUBGHZ_RAW_FILE_FORMAT_VERSION) {
+            instance->format = SubGhzRawFileFormatBinary;
+        } else {
+            FURI_LOG_E(TAG, "Unknown data version %lu", version);
+        }
+    } else {
+        stream_seek(stream, position, StreamOffsetFromStart);
+    }
+
+    return instance->format;
+}
+
+static bool subghz_raw_file_read_block_header(Stream* stream, SubGhzRawFileBlockHeader* header) {
+    size_t size = stream_read(stream, (uint8_t*)header, sizeof(SubGhzRawFileBlockHeader));
+    if(size == 0) return false;
+
+    if(size != sizeof(SubGhzRawFileBlockHeader) || header->magic != SUBGHZ_RAW_FILE_BLOCK_MAGIC ||
+       header->sample_count > SUBGHZ_RAW_FILE_BLOCK_SIZE_MAX ||
+       header->data_size > SUBGHZ_RAW_FILE_BLOCK_DATA_MAX) {
+        FURI_LOG_E(TAG, "Invalid block header");
+        return false;
+    }
+
+    return true;
+}
+
+static size_t subghz_raw_file_read_block(SubGhzRawFile* instance, Stream* stream, int32_t* samples) {
+    SubGhzRawFileBlockHeader header;
+    if(!subghz_raw_file_read_block_header(stream, &header)) return 0;
+
+    uint8_t* data = instance->buffer;
+    if(stream_read(stream, data, header.data_size) != header.data_size) {
+        FURI_LOG_E(TAG, "Truncated block");
+        return 0;
+    }
+    if(crc16_ccitt_update(0xFFFF, data, header.data_size) != header.crc) {
+        FURI_LOG_E(TAG, "Block CRC mismatch");
+        return 0;
+    }
+
+    size_t left = header.data_size;
+    for(size_t i = 0; i < header.sample_count; i++) {
+        size_t size = varint_int32_unpack(&samples[i], data, left);
+        if(size > left) {
+            FURI_LOG_E(TAG, "Block data is too short");
+            return 0;
+        }
+        data += size;
+        left -= size;
+    }
+
+    return header.sample_count;
+}
+
+// Parse samples from text line, only count them if samples is NULL
+static size_t
+    subghz_raw_file_parse_text(const char** cursor, int32_t* samples, size_t samples_max) {
+    size_t count = 0;
+    char* str = (char*)*cursor;
+    int32_t duration;
+    while(count < samples_max &&
+          strint_to_int32(str, &str, &duration, 10) == StrintParseNoError) {
+        if(samples) samples[count] = duration;
+        count++;
+        if(*str == ',') str++; // could also be `\0`
+    }
+    *cursor = str;
+    return count;
+}
+
+static bool subghz_raw_file_read_line(SubGhzRawFile* instance, Stream* stream) {
+    // Line sample: "RAW_Data: -1, 2, -2..."
+    instance->cursor = NULL;
+    if(!stream_read_line(stream, instance->line)) return false;
+
+    const char* str = strstr(furi_string_get_cstr(instance->line), SUBGHZ_RAW_FILE_DATA_KEY ": ");
+    if(!str) return false;
+
+    // Skip key
+    instance->cursor = strchr(str, ' ');
+    return true;
+}
+
+size_t subghz_raw_file_read(
+    SubGhzRawFile* instance,
+    FlipperFormat* flipper_format,
+    int32_t* samples,
+    size_t samples_max) {
+    furi_check(instance);
+    furi_check(flipper_format);
+    furi_check(samples);
+    furi_check(samples_max >= SUBGHZ_RAW_FILE_BLOCK_SIZE_MAX);
+
+    Stream* stream = flipper_format_get_raw_stream(flipper_format);
+    if(instance->format == SubGhzRawFileFormatBinary) {
+        return subghz_raw_file_read_block(instance, stream, samples);
+    }
+
+    size_t count = 0;
+    if(instance->cursor) {
+        count = subghz_raw_file_parse_text(&instance->cursor, samples, samples_max);
+    }
+    // Lines are read until one with data is found, empty RAW_Data is valid
+    while(!count && subghz_raw_file_read_line(instance, stream)) {
+        count = subghz_raw_file_parse_text(&instance->cursor, samples, samples_max);
+    }
+
+    return count;
+}
+
+size_t subghz_raw_file_skip(SubGhzRawFile* instance, FlipperFormat* flipper_format, size_t count) {
+    furi_check(instance);
+    furi_check(flipper_format);
+
+    Stream* stream = flipper_format_get_raw_stream(flipper_format);
+    instance->cursor = NULL;
+
+    size_t skipped = 0;
+    while(skipped < count) {
+        size_t position = stream_tell(stream);
+        size_t chunk = 0;
+
+        if(instance->format == SubGhzRawFileFormatBinary) {
+            SubGhzRawFileBlockHeader header;
+            if(!subghz_raw_file_read_block_header(stream, &header)) break;
+            chunk = header.sample_count;
+            if(skipped + chunk <= count &&
+               !stream_seek(stream, header.data_size, StreamOffsetFromCurrent)) {
+                break;
+            }
+        } else {
+            if(!subghz_raw_file_read_line(instance, stream)) break;
+            chunk = subghz_raw_file_parse_text(&instance->cursor, NULL, SIZE_MAX);
+            instance->cursor = NULL;
+        }
+
+        if(skipped + chunk > count) {
+            stream_seek(stream, position, StreamOffsetFromStart);
+            break;
+        }
+        skipped += chunk;
+    }
+
+    return skipped;
+}
+
+bool subghz_raw_file_convert(
+    Storage* storage,
+    const char* source_path,
+    const char* destination_path,
+    SubGhzRawFileFormat format) {
+    furi_check(storage);
+    furi_check(source_path);
+    furi_check(destination_path);
+
+    FlipperFormat* source = flipper_format_file_alloc(storage);
+    FlipperFormat* destination = flipper_format_file_alloc(storage);
+    SubGhzRawFile* reader = subghz_raw_file_alloc();
+    SubGhzRawFile* writer = subghz_raw_file_alloc();
+    int32_t* samples = malloc(SUBGHZ_RAW_FILE_BLOCK_SIZE_MAX * sizeof(int32_t));
+    FuriString* temp_str = furi_string_alloc();
+    bool result = false;
+
+    do {
+        uint32_t version;
+        if(!flipper_format_file_open_existing(source, source_path)) {
+            FURI_LOG_E(TAG, "Unable to open file for read: %s", source_path);
+            break;
+        }
+        if(!flipper_format_read_header(source, temp_str, &version) ||
+           furi_string_cmp_str(temp_str, SUBGHZ_RAW_FILE_TYPE)) {
+            FURI_LOG_E(TAG, "Not a RAW file");
+            break;
+        }
+        if(!flipper_format_read_string(source, "Protocol", temp_str)) {
+            FURI_LOG_E(TAG, "Missing Protocol");
+            break;
+        }
+        if(!flipper_format_file_open_always(destination, destination_path)) {
+            FURI_LOG_E(TAG, "Unable to open file for write: %s", destination_path);
+            break;
+        }
+
+        // Copy header up to the end of Protocol value
+        Stream* source_stream = flipper_format_get_raw_stream(source);
+        Stream* destination_stream = flipper_format_get_raw_stream(destination);
+        size_t header_size = stream_tell(source_stream);
+        if(!stream_rewind(source_stream) ||
+           stream_copy(source_stream, destination_stream, header_size) != header_size ||
+           stream_write_char(destination_stream, '\n') != 1) {
+            FURI_LOG_E(TAG, "Unable to copy header");
+            break;
+        }
+
+        subghz_raw_file_read_format(reader, source);
+        if(!subghz_raw_file_write_format(writer, destination, format)) {
+            FURI_LOG_E(TAG, "Unable to write format");
+            break;
+        }
+
+        bool write_error = false;
+        size_t count;
+        while((count = subghz_raw_file_read(
+                   reader, source, samples, SUBGHZ_RAW_FILE_BLOCK_SIZE_MAX)) > 0) {
+            if(!subghz_raw_file_write(writer, destination, samples, count)) {
+                write_error = true;
+                break;
+            }
+        }
+        if(write_error) {
+            FURI_LOG_E(TAG, "Unable to write data");
+            break;
+        }
+
+        result = true;
+    } while(false);
+
+    furi_string_free(temp_str);
+    free(samples);
+    subghz_raw_file_free(writer);
+    subghz_raw_file_free(reader);
+    flipper_format_file_close(destination);
+    flipper_format_file_close(source);
+    flipper_format_free(destination);
+    flipper_format_free(source);
+
+    return result;
+}
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <flipper_format/flipper_format.h>
+#include <storage/storage.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Key marking RAW files with binary data, written right after Protocol key */
+#define SUBGHZ_RAW_FILE_FORMAT_KEY     "RAW_Version"
+#define SUBGHZ_RAW_FILE_FORMAT_VERSION 2
+
+/** Maximum number of samples in one RAW_Data line or binary block */
+#define SUBGHZ_RAW_FILE_BLOCK_SIZE_MAX 512
+
+typedef enum {
+    SubGhzRawFileFormatText, /**< RAW_Data lines of signed decimal durations */
+    SubGhzRawFileFormatBinary, /**< Blocks of zig-zag varint durations with header and CRC */
+} SubGhzRawFileFormat;
+
+/** Streaming reader/writer for data part of SubGhz RAW files
+ *
+ * Both formats share the same text header, data follows Protocol key.
+ * Binary data is a sequence of blocks, each one is a packed header
+ * (magic, sample count, payload size, CRC-16/CCITT of payload) and
+ * up to SUBGHZ_RAW_FILE_BLOCK_SIZE_MAX varint encoded durations.
+ * Block header allows to skip blocks without decoding them.
+ */
+typedef struct SubGhzRawFile SubGhzRawFile;
+
+/** Allocate SubGhzRawFile
+ *
+ * @return SubGhzRawFile instance
+ */
+SubGhzRawFile* subghz_raw_file_alloc(void);
+
+/** Free SubGhzRawFile
+ *
+ * @param instance SubGhzRawFile instance
+ */
+void subghz_raw_file_free(SubGhzRawFile* instance);
+
+/** Write data format marker and set format for subghz_raw_file_write
+ *
+ * Must be called right after Protocol key is written.
+ * Nothing is written for text format, so text files stay as they were.
+ *
+ * @param instance          SubGhzRawFile instance
+ * @param flipper_format    FlipperFormat instance
+ * @param format            data format
+ * @return true on success
+ */
+bool subghz_raw_file_write_format(
+    SubGhzRawFile* instance,
+    FlipperFormat* flipper_format,
+    SubGhzRawFileFormat format);
+
+/** Write samples as one RAW_Data line or one binary block
+ *
+ * @param instance          SubGhzRawFile instance
+ * @param flipper_format    FlipperFormat instance
+ * @param samples           signed durations, positive for high level
+ * @param count             sample count, up to SUBGHZ_RAW_FILE_BLOCK_SIZE_MAX
+ * @return true on success
+ */
+bool subghz_raw_file_write(
+    SubGhzRawFile* instance,
+    FlipperFormat* flipper_format,
+    const int32_t* samples,
+    size_t count);
+
+/** Read data format marker and position stream at the start of data
+ *
+ * Must be called right after Protocol key is read.
+ *
+ * @param instance          SubGhzRawFile instance
+ * @param flipper_format    FlipperFormat instance
+ * @return data format
+ */
+SubGhzRawFileFormat
+    subghz_raw_file_read_format(SubGhzRawFile* instance, FlipperFormat* flipper_format);
+
+/** Read next chunk of samples
+ *
+ * One call returns at most one line or one block.
+ *
+ * @param instance          SubGhzRawFile instance
+ * @param flipper_format    FlipperFormat instance
+ * @param samples           output buffer
+ * @param samples_max       output buffer size, at least SUBGHZ_RAW_FILE_BLOCK_SIZE_MAX
+ * @return sample count, 0 at the end of data or on error
+ */
+size_t subghz_raw_file_read(
+    SubGhzRawFile* instance,
+    FlipperFormat* flipper_format,
+    int32_t* samples,
+    size_t samples_max);
+
+/** Skip whole lines or blocks without returning samples
+ *
+ * Stops before the chunk that contains sample number `count`, so the
+ * next subghz_raw_file_read() returns it. Binary blocks are skipped by
+ * their header without decoding. Unread part of a partially read text
+ * line is dropped.
+ *
+ * @param instance          SubGhzRawFile instance
+ * @param flipper_format    FlipperFormat instance
+ * @param count             number of samples to skip
+ * @return number of samples actually skipped
+ */
+size_t subghz_raw_file_skip(SubGhzRawFile* instance, FlipperFormat* flipper_format, size_t count);
+
+/** Convert RAW file to given data format
+ *
+ * Header is copied as is.
+ *
+ * @param storage           Storage instance
+ * @param source_path       source file path
+ * @param destination_path  destination file path, overwritten
+ * @param format            destination data format
+ * @return true on success
+ */
+bool subghz_raw_file_convert(
+    Storage* storage,
+    const char* source_path,
+    const char* destination_path,
+    SubGhzRawFileFormat format);
+
+#ifdef __cplusplus
+}
+#endif
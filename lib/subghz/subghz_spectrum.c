@@ -0,0 +1,184 @@
+#include "subghz_spectrum.h"
+
+#include <furi.h>
+#include <math.h>
+
+// Envelope RMS above which it is considered keyed rather than noise on a steady carrier
+#define SUBGHZ_SPECTRUM_KEYED_RMS_DB 3
+
+#define SUBGHZ_SPECTRUM_BANDWIDTH_DB 6.0f
+
+// sin(2 * pi * k / SUBGHZ_SPECTRUM_SIZE_MAX) in Q15, first quarter of the period
+static const int16_t subghz_spectrum_sin_table[SUBGHZ_SPECTRUM_SIZE_MAX / 4 + 1] = {
+    0,     3212,  6393,  9512,  12539, 15446, 18204, 20787, 23170,
+    25329, 27245, 28898, 30273, 31356, 32137, 32609, 32767,
+};
+
+// Twiddle factors for k in [0, SUBGHZ_SPECTRUM_SIZE_MAX / 2)
+static inline int32_t subghz_spectrum_sin(size_t k) {
+    const size_t quarter = SUBGHZ_SPECTRUM_SIZE_MAX / 4;
+    return (k <= quarter) ? subghz_spectrum_sin_table[k] :
+                            subghz_spectrum_sin_table[2 * quarter - k];
+}
+
+static inline int32_t subghz_spectrum_cos(size_t k) {
+    const size_t quarter = SUBGHZ_SPECTRUM_SIZE_MAX / 4;
+    return (k <= quarter) ? subghz_spectrum_sin_table[quarter - k] :
+                            -subghz_spectrum_sin_table[k - quarter];
+}
+
+void subghz_spectrum_fft(int16_t* re, int16_t* im, size_t size) {
+    furi_check(re);
+    furi_check(im);
+    furi_check(size >= 2 && size <= SUBGHZ_SPECTRUM_SIZE_MAX && (size & (size - 1)) == 0);
+
+    // Bit reversal permutation
+    for(size_t i = 1, j = 0; i < size; i++) {
+        size_t bit = size >> 1;
+        for(; j & bit; bit >>= 1) {
+            j ^= bit;
+        }
+        j |= bit;
+        if(i < j) {
+            int16_t tmp = re[i];
+            re[i] = re[j];
+            re[j] = tmp;
+            tmp = im[i];
+            im[i] = im[j];
+            im[j] = tmp;
+        }
+    }
+
+    for(size_t len = 2; len <= size; len <<= 1) {
+        const size_t half = len >> 1;
+        const size_t step = SUBGHZ_SPECTRUM_SIZE_MAX / len;
+        for(size_t j = 0; j < half; j++) {
+            const int32_t wr = subghz_spectrum_cos(j * step);
+            const int32_t wi = -subghz_spectrum_sin(j * step);
+            for(size_t i = j; i < size; i += len) {
+                const size_t k = i + half;
+                const int32_t tr = (wr * re[k] - wi * im[k]) >> 15;
+                const int32_t ti = (wr * im[k] + wi * re[k]) >> 15;
+                re[k] = (re[i] - tr) >> 1;
+                im[k] = (im[i] - ti) >> 1;
+                re[i] = (re[i] + tr) >> 1;
+                im[i] = (im[i] + ti) >> 1;
+            }
+        }
+    }
+}
+
+int32_t subghz_spectrum_goertzel_coeff(uint32_t frequency, uint32_t sample_rate) {
+    furi_check(sample_rate);
+    const float w = 2.0f * (float)M_PI * (float)frequency / (float)sample_rate;
+    return (int32_t)lroundf(2.0f * cosf(w) * (float)(1 << 14));
+}
+
+uint32_t subghz_spectrum_goertzel(const int16_t* samples, size_t size, int32_t coeff) {
+    furi_check(samples);
+    furi_check(size > 0 && size <= SUBGHZ_SPECTRUM_SIZE_MAX);
+
+    int64_t s1 = 0;
+    int64_t s2 = 0;
+    for(size_t i = 0; i < size; i++) {
+        const int64_t s = samples[i] + ((coeff * s1) >> 14) - s2;
+        s2 = s1;
+        s1 = s;
+    }
+
+    const int64_t power = s1 * s1 + s2 * s2 - ((coeff * s1) >> 14) * s2;
+    return (uint32_t)(MAX(power, 0) / (int64_t)(size * size));
+}
+
+SubGhzSpectrumModulation subghz_spectrum_get_modulation(
+    const int16_t* envelope,
+    size_t size,
+    uint32_t sample_rate,
+    uint32_t* keying_frequency) {
+    furi_check(envelope);
+    furi_check(keying_frequency);
+    furi_check(size >= 2 && size <= SUBGHZ_SPECTRUM_SIZE_MAX);
+
+    *keying_frequency = 0;
+
+    int32_t sum = 0;
+    for(size_t i = 0; i < size; i++) {
+        sum += envelope[i];
+    }
+    const int32_t mean = sum / (int32_t)size;
+
+    int64_t variance = 0;
+    int32_t peak = 0;
+    for(size_t i = 0; i < size; i++) {
+        const int32_t ac = envelope[i] - mean;
+        variance += (int64_t)ac * ac;
+        peak = MAX(peak, ac < 0 ? -ac : ac);
+    }
+    variance /= (int64_t)size;
+
+    const int32_t keyed_rms = SUBGHZ_SPECTRUM_KEYED_RMS_DB * SUBGHZ_SPECTRUM_ENVELOPE_SCALE;
+    if(variance <= (int64_t)keyed_rms * keyed_rms) return SubGhzSpectrumModulationCarrier;
+
+    // Scale up to use most of Q15 range, FFT loses a bit per stage
+    uint8_t shift = 0;
+    while(shift < 15 && (peak << (shift + 1)) < (1 << 14)) {
+        shift++;
+    }
+
+    int16_t samples[SUBGHZ_SPECTRUM_SIZE_MAX];
+    int16_t re[SUBGHZ_SPECTRUM_SIZE_MAX];
+    int16_t im[SUBGHZ_SPECTRUM_SIZE_MAX] = {};
+    for(size_t i = 0; i < size; i++) {
+        samples[i] = (int16_t)((envelope[i] - mean) * (1 << shift));
+        re[i] = samples[i];
+    }
+    subghz_spectrum_fft(re, im, size);
+
+    size_t peak_bin = 1;
+    uint32_t peak_power = 0;
+    for(size_t k = 1; k < size / 2; k++) {
+        const uint32_t power = (uint32_t)(re[k] * re[k]) + (uint32_t)(im[k] * im[k]);
+        if(power > peak_power) {
+            peak_power = power;
+            peak_bin = k;
+        }
+    }
+
+    // Keying rarely falls on a bin, check half a bin on both sides
+    uint32_t best_power = 0;
+    for(int32_t offset = -1; offset <= 1; offset++) {
+        const uint32_t frequency = (uint32_t)((2 * (int32_t)peak_bin + offset) *
+                                              (int32_t)sample_rate / (2 * (int32_t)size));
+        const uint32_t power = subghz_spectrum_goertzel(
+            samples, size, subghz_spectrum_goertzel_coeff(frequency, sample_rate));
+        if(power > best_power) {
+            best_power = power;
+            *keying_frequency = frequency;
+        }
+    }
+
+    return SubGhzSpectrumModulationKeyed;
+}
+
+uint32_t subghz_spectrum_get_bandwidth(const float* levels, size_t count, uint32_t step) {
+    furi_check(levels);
+
+    if(count == 0) return 0;
+
+    size_t peak = 0;
+    for(size_t i = 1; i < count; i++) {
+        if(levels[i] > levels[peak]) peak = i;
+    }
+
+    const float edge = levels[peak] - SUBGHZ_SPECTRUM_BANDWIDTH_DB;
+    size_t first = peak;
+    size_t last = peak;
+    while(first > 0 && levels[first - 1] >= edge) {
+        first--;
+    }
+    while(last + 1 < count && levels[last + 1] >= edge) {
+        last++;
+    }
+
+    return (uint32_t)(last - first + 1) * step;
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Maximum number of samples in FFT and envelope analysis, power of two */
+#define SUBGHZ_SPECTRUM_SIZE_MAX 64
+
+/** RSSI envelope samples per dB */
+#define SUBGHZ_SPECTRUM_ENVELOPE_SCALE 64
+
+typedef enum {
+    SubGhzSpectrumModulationCarrier, /**< Steady envelope: unmodulated carrier or FM/FSK */
+    SubGhzSpectrumModulationKeyed, /**< Keyed envelope: AM/OOK */
+} SubGhzSpectrumModulation;
+
+/** In-place radix-2 FFT of Q15 samples
+ *
+ * Every stage is scaled down by 2 to prevent overflow, so the result is the
+ * DFT divided by size.
+ *
+ * @param re    real part, replaced with the spectrum real part
+ * @param im    imaginary part, replaced with the spectrum imaginary part
+ * @param size  number of samples, power of two up to SUBGHZ_SPECTRUM_SIZE_MAX
+ */
+void subghz_spectrum_fft(int16_t* re, int16_t* im, size_t size);
+
+/** Get Goertzel filter coefficient
+ *
+ * @param frequency     frequency to detect, Hz, doesn't have to fall on a DFT bin
+ * @param sample_rate   sample rate, Hz
+ * @return coefficient, 2cos(w) in Q14
+ */
+int32_t subghz_spectrum_goertzel_coeff(uint32_t frequency, uint32_t sample_rate);
+
+/** Get power of a single frequency with Goertzel filter
+ *
+ * Power is scaled the same as subghz_spectrum_fft output, so the two can be compared.
+ *
+ * @param samples   Q15 samples
+ * @param size      number of samples, up to SUBGHZ_SPECTRUM_SIZE_MAX
+ * @param coeff     coefficient from subghz_spectrum_goertzel_coeff
+ * @return power, squared magnitude of the DFT divided by size
+ */
+uint32_t subghz_spectrum_goertzel(const int16_t* samples, size_t size, int32_t coeff);
+
+/** Estimate modulation from RSSI envelope
+ *
+ * Envelope varying by more than a few dB is considered keyed. The keying
+ * frequency is its strongest spectral component, found with FFT and refined
+ * with Goertzel filters between bins. For alternating preambles it is half
+ * the symbol rate.
+ *
+ * @param envelope          RSSI samples, dBm * SUBGHZ_SPECTRUM_ENVELOPE_SCALE
+ * @param size              number of samples, power of two up to SUBGHZ_SPECTRUM_SIZE_MAX
+ * @param sample_rate       sample rate, Hz
+ * @param keying_frequency  keying frequency, Hz, 0 if not keyed
+ * @return SubGhzSpectrumModulation
+ */
+SubGhzSpectrumModulation subghz_spectrum_get_modulation(
+    const int16_t* envelope,
+    size_t size,
+    uint32_t sample_rate,
+    uint32_t* keying_frequency);
+
+/** Estimate signal bandwidth from levels measured across a sweep
+ *
+ * Width of the -6 dB span around the strongest level. It includes receiver
+ * filter bandwidth, so narrow signals are at least that wide.
+ *
+ * @param levels    RSSI at every step, dBm
+ * @param count     number of steps
+ * @param step      frequency step, Hz
+ * @return bandwidth, Hz
+ */
+uint32_t subghz_spectrum_get_bandwidth(const float* levels, size_t count, uint32_t step);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,121 @@
+#include "subghz_tx_buffer.h"
+
+#include <furi.h>
+
+#define SUBGHZ_TX_BUFFER_LEVEL_SHIFT    14
+#define SUBGHZ_TX_BUFFER_DURATION_MASK  0x3FFFU
+#define SUBGHZ_TX_BUFFER_LEVEL_EXTENDED 0U
+#define SUBGHZ_TX_BUFFER_LEVEL_LOW      1U
+#define SUBGHZ_TX_BUFFER_LEVEL_HIGH     2U
+#define SUBGHZ_TX_BUFFER_LEVEL_WAIT     3U
+
+struct SubGhzTxBuffer {
+    uint16_t* data;
+    size_t size;
+    size_t size_max;
+    size_t count;
+    uint32_t duration;
+};
+
+SubGhzTxBuffer* subghz_tx_buffer_alloc(size_t size_max) {
+    SubGhzTxBuffer* instance = malloc(sizeof(SubGhzTxBuffer));
+    instance->data = malloc(sizeof(uint16_t) * MAX(size_max, 1U));
+    instance->size_max = size_max;
+    return instance;
+}
+
+void subghz_tx_buffer_free(SubGhzTxBuffer* instance) {
+    furi_check(instance);
+
+    free(instance->data);
+    free(instance);
+}
+
+void subghz_tx_buffer_reset(SubGhzTxBuffer* instance) {
+    furi_check(instance);
+
+    instance->size = 0;
+    instance->count = 0;
+    instance->duration = 0;
+}
+
+bool subghz_tx_buffer_add(SubGhzTxBuffer* instance, LevelDuration level_duration) {
+    furi_check(instance);
+    furi_check(!level_duration_is_reset(level_duration));
+
+    uint16_t level;
+    uint32_t duration = 0;
+    if(level_duration_is_wait(level_duration)) {
+        level = SUBGHZ_TX_BUFFER_LEVEL_WAIT;
+    } else {
+        level = level_duration_get_level(level_duration) ? SUBGHZ_TX_BUFFER_LEVEL_HIGH :
+                                                           SUBGHZ_TX_BUFFER_LEVEL_LOW;
+        duration = level_duration_get_duration(level_duration);
+    }
+
+    // Duration is 30 bits at most, so up to two extension words
+    size_t words = 1;
+    if(duration > SUBGHZ_TX_BUFFER_DURATION_MASK) words++;
+    if(duration >> (2 * SUBGHZ_TX_BUFFER_LEVEL_SHIFT)) words++;
+    if(instance->size + words > instance->size_max) return false;
+
+    for(size_t i = words; i > 1; i--) {
+        instance->data[instance->size++] =
+            (duration >> ((i - 1) * SUBGHZ_TX_BUFFER_LEVEL_SHIFT)) &
+            SUBGHZ_TX_BUFFER_DURATION_MASK;
+    }
+    instance->data[instance->size++] = (level << SUBGHZ_TX_BUFFER_LEVEL_SHIFT) |
+                                       (duration & SUBGHZ_TX_BUFFER_DURATION_MASK);
+    instance->count++;
+    instance->duration += duration;
+
+    return true;
+}
+
+bool subghz_tx_buffer_render(
+    SubGhzTxBuffer* instance,
+    FuriHalSubGhzAsyncTxCallback callback,
+    void* context) {
+    furi_check(instance);
+    furi_check(callback);
+
+    while(true) {
+        LevelDuration level_duration = callback(context);
+        if(level_duration_is_reset(level_duration)) return true;
+        if(!subghz_tx_buffer_add(instance, level_duration)) return false;
+    }
+}
+
+LevelDuration subghz_tx_buffer_get(const SubGhzTxBuffer* instance, size_t* position) {
+    furi_check(instance);
+    furi_check(position);
+
+    uint32_t duration = 0;
+    while(*position < instance->size) {
+        const uint16_t word = instance->data[(*position)++];
+        const uint16_t level = word >> SUBGHZ_TX_BUFFER_LEVEL_SHIFT;
+        duration = (duration << SUBGHZ_TX_BUFFER_LEVEL_SHIFT) |
+                   (word & SUBGHZ_TX_BUFFER_DURATION_MASK);
+
+        if(level == SUBGHZ_TX_BUFFER_LEVEL_EXTENDED) continue;
+        if(level == SUBGHZ_TX_BUFFER_LEVEL_WAIT) return level_duration_wait();
+        return level_duration_make(level == SUBGHZ_TX_BUFFER_LEVEL_HIGH, duration);
+    }
+
+    return level_duration_reset();
+}
+
+size_t subghz_tx_buffer_get_size(const SubGhzTxBuffer* instance) {
+    furi_check(instance);
+    return instance->size;
+}
+
+size_t subghz_tx_buffer_get_count(const SubGhzTxBuffer* instance) {
+    furi_check(instance);
+    return instance->count;
+}
+
+uint32_t subghz_tx_buffer_get_duration(const SubGhzTxBuffer* instance) {
+    furi_check(instance);
+    return instance->duration;
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <furi_hal.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Pre-rendered SubGhz signal
+ *
+ * Encoder output is rendered ahead of transmission, so the radio DMA
+ * interrupt only copies pulses instead of running the encoder. Pulses are
+ * stored as 16 bit words: level in the top 2 bits, same as in LevelDuration,
+ * and 14 bits of duration. Longer durations are preceded by extension words
+ * with zero level carrying the upper bits, so most pulses take 2 bytes
+ * instead of 4.
+ *
+ * Buffer is not changed by playback, position is kept by the reader, so
+ * one buffer can be played on several radios at once.
+ */
+typedef struct SubGhzTxBuffer SubGhzTxBuffer;
+
+/** Allocate SubGhzTxBuffer
+ *
+ * @param size_max  capacity in words, a pulse takes 1 to 3 words
+ * @return SubGhzTxBuffer instance
+ */
+SubGhzTxBuffer* subghz_tx_buffer_alloc(size_t size_max);
+
+/** Free SubGhzTxBuffer
+ *
+ * @param instance SubGhzTxBuffer instance
+ */
+void subghz_tx_buffer_free(SubGhzTxBuffer* instance);
+
+/** Remove all pulses
+ *
+ * @param instance SubGhzTxBuffer instance
+ */
+void subghz_tx_buffer_reset(SubGhzTxBuffer* instance);
+
+/** Append one pulse
+ *
+ * @param instance          SubGhzTxBuffer instance
+ * @param level_duration    pulse or wait, duration of wait is not kept
+ * @return false if buffer is full
+ */
+bool subghz_tx_buffer_add(SubGhzTxBuffer* instance, LevelDuration level_duration);
+
+/** Append pulses yielded by callback until it returns reset
+ *
+ * @param instance  SubGhzTxBuffer instance
+ * @param callback  yield callback, for example subghz_transmitter_yield
+ * @param context   callback context
+ * @return true if signal is complete, false if buffer got full before reset
+ */
+bool subghz_tx_buffer_render(
+    SubGhzTxBuffer* instance,
+    FuriHalSubGhzAsyncTxCallback callback,
+    void* context);
+
+/** Get next pulse
+ *
+ * @param instance  SubGhzTxBuffer instance
+ * @param position  read position in words, start from 0, advanced on every call
+ * @return LevelDuration, reset at the end of buffer
+ */
+LevelDuration subghz_tx_buffer_get(const SubGhzTxBuffer* instance, size_t* position);
+
+/** Get used size
+ *
+ * @param instance SubGhzTxBuffer instance
+ * @return size in words
+ */
+size_t subghz_tx_buffer_get_size(const SubGhzTxBuffer* instance);
+
+/** Get number of pulses
+ *
+ * @param instance SubGhzTxBuffer instance
+ * @return pulse count, including waits
+ */
+size_t subghz_tx_buffer_get_count(const SubGhzTxBuffer* instance);
+
+/** Get signal duration
+ *
+ * @param instance SubGhzTxBuffer instance
+ * @return sum of pulse durations, us, waits not included
+ */
+uint32_t subghz_tx_buffer_get_duration(const SubGhzTxBuffer* instance);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,140 @@
+#include "subghz_tx_queue.h"
+
+#include <furi.h>
+
+typedef struct {
+    const SubGhzTxBuffer* buffer;
+    uint32_t repeat;
+    uint32_t gap;
+} SubGhzTxQueueItem;
+
+struct SubGhzTxQueue {
+    SubGhzTxQueueItem items[SUBGHZ_TX_QUEUE_SIZE_MAX];
+    size_t count;
+
+    // Playback state, accessed from async TX interrupt
+    size_t index;
+    uint32_t repeat;
+    size_t position;
+
+    const SubGhzDevice* device;
+};
+
+SubGhzTxQueue* subghz_tx_queue_alloc(void) {
+    SubGhzTxQueue* instance = malloc(sizeof(SubGhzTxQueue));
+    return instance;
+}
+
+void subghz_tx_queue_free(SubGhzTxQueue* instance) {
+    furi_check(instance);
+    furi_check(!instance->device);
+
+    free(instance);
+}
+
+void subghz_tx_queue_reset(SubGhzTxQueue* instance) {
+    furi_check(instance);
+    furi_check(!instance->device);
+
+    instance->count = 0;
+    subghz_tx_queue_rewind(instance);
+}
+
+bool subghz_tx_queue_add(
+    SubGhzTxQueue* instance,
+    const SubGhzTxBuffer* buffer,
+    uint32_t repeat,
+    uint32_t gap) {
+    furi_check(instance);
+    furi_check(buffer);
+    furi_check(repeat > 0);
+    furi_check(!instance->device);
+
+    if(instance->count >= SUBGHZ_TX_QUEUE_SIZE_MAX) return false;
+
+    SubGhzTxQueueItem* item = &instance->items[instance->count++];
+    item->buffer = buffer;
+    item->repeat = repeat;
+    item->gap = gap;
+
+    return true;
+}
+
+size_t subghz_tx_queue_get_count(SubGhzTxQueue* instance) {
+    furi_check(instance);
+    return instance->count;
+}
+
+uint32_t subghz_tx_queue_get_duration(SubGhzTxQueue* instance) {
+    furi_check(instance);
+
+    uint32_t duration = 0;
+    for(size_t i = 0; i < instance->count; i++) {
+        const SubGhzTxQueueItem* item = &instance->items[i];
+        duration += subghz_tx_buffer_get_duration(item->buffer) * item->repeat;
+        if(i + 1 < instance->count) duration += item->gap;
+    }
+    return duration;
+}
+
+void subghz_tx_queue_rewind(SubGhzTxQueue* instance) {
+    furi_check(instance);
+
+    instance->index = 0;
+    instance->repeat = 0;
+    instance->position = 0;
+}
+
+LevelDuration subghz_tx_queue_yield(void* context) {
+    SubGhzTxQueue* instance = context;
+
+    while(instance->index < instance->count) {
+        const SubGhzTxQueueItem* item = &instance->items[instance->index];
+
+        if(instance->repeat < item->repeat) {
+            LevelDuration level_duration =
+                subghz_tx_buffer_get(item->buffer, &instance->position);
+            if(!level_duration_is_reset(level_duration)) return level_duration;
+
+            instance->position = 0;
+            instance->repeat++;
+            continue;
+        }
+
+        // All repeats are sent, gap goes before the next signal only
+        instance->index++;
+        instance->repeat = 0;
+        if(item->gap && instance->index < instance->count) {
+            return level_duration_make(false, item->gap);
+        }
+    }
+
+    return level_duration_reset();
+}
+
+bool subghz_tx_queue_start(SubGhzTxQueue* instance, const SubGhzDevice* device) {
+    furi_check(instance);
+    furi_check(device);
+    furi_check(!instance->device);
+
+    subghz_tx_queue_rewind(instance);
+    if(!subghz_devices_start_async_tx(device, subghz_tx_queue_yield, instance)) return false;
+
+    instance->device = device;
+    return true;
+}
+
+bool subghz_tx_queue_is_complete(SubGhzTxQueue* instance) {
+    furi_check(instance);
+    furi_check(instance->device);
+
+    return subghz_devices_is_async_complete_tx(instance->device);
+}
+
+void subghz_tx_queue_stop(SubGhzTxQueue* instance) {
+    furi_check(instance);
+    furi_check(instance->device);
+
+    subghz_devices_stop_async_tx(instance->device);
+    instance->device = NULL;
+}
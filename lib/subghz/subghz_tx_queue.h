@@ -0,0 +1,108 @@
+#pragma once
+
+#include "subghz_tx_buffer.h"
+#include "devices/devices.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Maximum number of signals in one queue */
+#define SUBGHZ_TX_QUEUE_SIZE_MAX 16
+
+/** Back-to-back transmission of pre-rendered signals on one radio
+ *
+ * Signals are played in order, each one repeated the given number of
+ * times and followed by a low level gap before the next one, all in one
+ * async transmission. Queues only refer to buffers, so the same buffers
+ * can be sent by internal and external radios in parallel with a queue
+ * per radio. Buffers must not be changed or freed while a queue using
+ * them is running.
+ */
+typedef struct SubGhzTxQueue SubGhzTxQueue;
+
+/** Allocate SubGhzTxQueue
+ *
+ * @return SubGhzTxQueue instance
+ */
+SubGhzTxQueue* subghz_tx_queue_alloc(void);
+
+/** Free SubGhzTxQueue
+ *
+ * @param instance SubGhzTxQueue instance
+ */
+void subghz_tx_queue_free(SubGhzTxQueue* instance);
+
+/** Remove all signals
+ *
+ * @param instance SubGhzTxQueue instance
+ */
+void subghz_tx_queue_reset(SubGhzTxQueue* instance);
+
+/** Append signal
+ *
+ * @param instance  SubGhzTxQueue instance
+ * @param buffer    pre-rendered signal
+ * @param repeat    number of times to send it back-to-back, at least 1
+ * @param gap       low level after the last repeat before the next signal, us
+ * @return false if queue is full
+ */
+bool subghz_tx_queue_add(
+    SubGhzTxQueue* instance,
+    const SubGhzTxBuffer* buffer,
+    uint32_t repeat,
+    uint32_t gap);
+
+/** Get number of signals
+ *
+ * @param instance SubGhzTxQueue instance
+ * @return signal count
+ */
+size_t subghz_tx_queue_get_count(SubGhzTxQueue* instance);
+
+/** Get duration of the whole queue
+ *
+ * @param instance SubGhzTxQueue instance
+ * @return duration, us
+ */
+uint32_t subghz_tx_queue_get_duration(SubGhzTxQueue* instance);
+
+/** Start playback from the first signal
+ *
+ * @param instance SubGhzTxQueue instance
+ */
+void subghz_tx_queue_rewind(SubGhzTxQueue* instance);
+
+/** Get next pulse, async TX callback
+ *
+ * @param context SubGhzTxQueue instance
+ * @return LevelDuration, reset after the last signal
+ */
+LevelDuration subghz_tx_queue_yield(void* context);
+
+/** Rewind and start async transmission on the radio
+ *
+ * Radio must be configured and tuned already.
+ *
+ * @param instance  SubGhzTxQueue instance
+ * @param device    radio device, one queue per radio
+ * @return false if transmission is not allowed
+ */
+bool subghz_tx_queue_start(SubGhzTxQueue* instance, const SubGhzDevice* device);
+
+/** Check if transmission started with subghz_tx_queue_start is over
+ *
+ * @param instance SubGhzTxQueue instance
+ * @return true if all signals are sent
+ */
+bool subghz_tx_queue_is_complete(SubGhzTxQueue* instance);
+
+/** Stop transmission started with subghz_tx_queue_start
+ *
+ * @param instance SubGhzTxQueue instance
+ */
+void subghz_tx_queue_stop(SubGhzTxQueue* instance);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,198 @@
+#include "crc.h"
+
+#include <string.h>
+
+#define CRC32_POLY_REFLECTED       (0xEDB88320U)
+#define CRC16_CCITT_POLY           (0x1021U)
+#define CRC16_CCITT_POLY_REFLECTED (0x8408U)
+#define CRC8_MAXIM_POLY_REFLECTED  (0x8CU)
+
+/* Tables are generated at compile time.
+ *
+ * Table k maps a byte to the register after this byte and k zero bytes are fed
+ * to an empty register. CRC is linear, so an entry is a xor of the entries for
+ * the single bits set in its index, and these 8 basis values are obtained by
+ * running the bitwise algorithm over the basis of the previous table. */
+
+#define CRC_LSB_1(x, poly) (((x) >> 1) ^ (((x) & 1U) ? (poly) : 0U))
+#define CRC_LSB_2(x, poly) CRC_LSB_1(CRC_LSB_1(x, poly), poly)
+#define CRC_LSB_4(x, poly) CRC_LSB_2(CRC_LSB_2(x, poly), poly)
+#define CRC_LSB_8(x, poly) CRC_LSB_4(CRC_LSB_4(x, poly), poly)
+
+#define CRC16_MSB_1(x, poly) ((((x) << 1) ^ (((x) & 0x8000U) ? (poly) : 0U)) & 0xFFFFU)
+#define CRC16_MSB_2(x, poly) CRC16_MSB_1(CRC16_MSB_1(x, poly), poly)
+#define CRC16_MSB_4(x, poly) CRC16_MSB_2(CRC16_MSB_2(x, poly), poly)
+#define CRC16_MSB_8(x, poly) CRC16_MSB_4(CRC16_MSB_4(x, poly), poly)
+
+#define CRC_BASIS(name, prev, step)                                                           \
+    name##0 = step(prev##0), name##1 = step(prev##1), name##2 = step(prev##2),                \
+    name##3 = step(prev##3), name##4 = step(prev##4), name##5 = step(prev##5),                \
+    name##6 = step(prev##6), name##7 = step(prev##7)
+
+#define CRC_BASIS_SEED(name, shift)                                                    \
+    name##0 = 0x01U << (shift), name##1 = 0x02U << (shift), name##2 = 0x04U << (shift), \
+    name##3 = 0x08U << (shift), name##4 = 0x10U << (shift), name##5 = 0x20U << (shift), \
+    name##6 = 0x40U << (shift), name##7 = 0x80U << (shift)
+
+#define CRC_TABLE_ENTRY(n, b)                                                      \
+    ((((n) & 0x01) ? b##0 : 0U) ^ (((n) & 0x02) ? b##1 : 0U) ^                     \
+     (((n) & 0x04) ? b##2 : 0U) ^ (((n) & 0x08) ? b##3 : 0U) ^                     \
+     (((n) & 0x10) ? b##4 : 0U) ^ (((n) & 0x20) ? b##5 : 0U) ^                     \
+     (((n) & 0x40) ? b##6 : 0U) ^ (((n) & 0x80) ? b##7 : 0U))
+#define CRC_TABLE_4(n, b)                                                           \
+    CRC_TABLE_ENTRY((n), b), CRC_TABLE_ENTRY((n) + 1, b), CRC_TABLE_ENTRY((n) + 2, b), \
+        CRC_TABLE_ENTRY((n) + 3, b)
+#define CRC_TABLE_16(n, b) \
+    CRC_TABLE_4((n), b), CRC_TABLE_4((n) + 4, b), CRC_TABLE_4((n) + 8, b), CRC_TABLE_4((n) + 12, b)
+#define CRC_TABLE_64(n, b)                                                     \
+    CRC_TABLE_16((n), b), CRC_TABLE_16((n) + 16, b), CRC_TABLE_16((n) + 32, b), \
+        CRC_TABLE_16((n) + 48, b)
+#define CRC_TABLE(b) \
+    {CRC_TABLE_64(0, b), CRC_TABLE_64(64, b), CRC_TABLE_64(128, b), CRC_TABLE_64(192, b)}
+
+#define CRC32_STEP(x)       CRC_LSB_8(x, CRC32_POLY_REFLECTED)
+#define CRC16_CCITT_STEP(x) CRC16_MSB_8(x, CRC16_CCITT_POLY)
+#define CRC16_CCITT_REFLECTED_STEP(x) CRC_LSB_8(x, CRC16_CCITT_POLY_REFLECTED)
+#define CRC8_MAXIM_STEP(x)  CRC_LSB_8(x, CRC8_MAXIM_POLY_REFLECTED)
+
+enum {
+    CRC_BASIS_SEED(CRC32_S, 0),
+    CRC_BASIS(CRC32_T0_, CRC32_S, CRC32_STEP),
+    CRC_BASIS(CRC32_T1_, CRC32_T0_, CRC32_STEP),
+    CRC_BASIS(CRC32_T2_, CRC32_T1_, CRC32_STEP),
+    CRC_BASIS(CRC32_T3_, CRC32_T2_, CRC32_STEP),
+    CRC_BASIS(CRC32_T4_, CRC32_T3_, CRC32_STEP),
+    CRC_BASIS(CRC32_T5_, CRC32_T4_, CRC32_STEP),
+    CRC_BASIS(CRC32_T6_, CRC32_T5_, CRC32_STEP),
+    CRC_BASIS(CRC32_T7_, CRC32_T6_, CRC32_STEP),
+
+    CRC_BASIS_SEED(CRC16_CCITT_S, 8),
+    CRC_BASIS(CRC16_CCITT_T0_, CRC16_CCITT_S, CRC16_CCITT_STEP),
+    CRC_BASIS(CRC16_CCITT_T1_, CRC16_CCITT_T0_, CRC16_CCITT_STEP),
+    CRC_BASIS(CRC16_CCITT_T2_, CRC16_CCITT_T1_, CRC16_CCITT_STEP),
+    CRC_BASIS(CRC16_CCITT_T3_, CRC16_CCITT_T2_, CRC16_CCITT_STEP),
+
+    CRC_BASIS_SEED(CRC16_CCITT_REFLECTED_S, 0),
+    CRC_BASIS(CRC16_CCITT_REFLECTED_T0_, CRC16_CCITT_REFLECTED_S, CRC16_CCITT_REFLECTED_STEP),
+    CRC_BASIS(CRC16_CCITT_REFLECTED_T1_, CRC16_CCITT_REFLECTED_T0_, CRC16_CCITT_REFLECTED_STEP),
+    CRC_BASIS(CRC16_CCITT_REFLECTED_T2_, CRC16_CCITT_REFLECTED_T1_, CRC16_CCITT_REFLECTED_STEP),
+    CRC_BASIS(CRC16_CCITT_REFLECTED_T3_, CRC16_CCITT_REFLECTED_T2_, CRC16_CCITT_REFLECTED_STEP),
+
+    CRC_BASIS_SEED(CRC8_MAXIM_S, 0),
+    CRC_BASIS(CRC8_MAXIM_T0_, CRC8_MAXIM_S, CRC8_MAXIM_STEP),
+    CRC_BASIS(CRC8_MAXIM_T1_, CRC8_MAXIM_T0_, CRC8_MAXIM_STEP),
+    CRC_BASIS(CRC8_MAXIM_T2_, CRC8_MAXIM_T1_, CRC8_MAXIM_STEP),
+    CRC_BASIS(CRC8_MAXIM_T3_, CRC8_MAXIM_T2_, CRC8_MAXIM_STEP),
+};
+
+static const uint32_t crc32_table[8][256] = {
+    CRC_TABLE(CRC32_T0_),
+    CRC_TABLE(CRC32_T1_),
+    CRC_TABLE(CRC32_T2_),
+    CRC_TABLE(CRC32_T3_),
+    CRC_TABLE(CRC32_T4_),
+    CRC_TABLE(CRC32_T5_),
+    CRC_TABLE(CRC32_T6_),
+    CRC_TABLE(CRC32_T7_),
+};
+
+static const uint16_t crc16_ccitt_table[4][256] = {
+    CRC_TABLE(CRC16_CCITT_T0_),
+    CRC_TABLE(CRC16_CCITT_T1_),
+    CRC_TABLE(CRC16_CCITT_T2_),
+    CRC_TABLE(CRC16_CCITT_T3_),
+};
+
+static const uint16_t crc16_ccitt_reflected_table[4][256] = {
+    CRC_TABLE(CRC16_CCITT_REFLECTED_T0_),
+    CRC_TABLE(CRC16_CCITT_REFLECTED_T1_),
+    CRC_TABLE(CRC16_CCITT_REFLECTED_T2_),
+    CRC_TABLE(CRC16_CCITT_REFLECTED_T3_),
+};
+
+static const uint8_t crc8_maxim_table[4][256] = {
+    CRC_TABLE(CRC8_MAXIM_T0_),
+    CRC_TABLE(CRC8_MAXIM_T1_),
+    CRC_TABLE(CRC8_MAXIM_T2_),
+    CRC_TABLE(CRC8_MAXIM_T3_),
+};
+
+/* Words are read in little endian order, as on the target */
+static inline uint32_t crc_read_word(const uint8_t* data) {
+    uint32_t word;
+    memcpy(&word, data, sizeof(word));
+    return word;
+}
+
+uint32_t crc32_update(uint32_t crc, const void* data, size_t size) {
+    const uint8_t* p = data;
+
+    while(size && ((uintptr_t)p & 3U)) {
+        crc = (crc >> 8) ^ crc32_table[0][(crc ^ *p++) & 0xFF];
+        size--;
+    }
+
+    for(; size >= 8; size -= 8, p += 8) {
+        uint32_t one = crc_read_word(p) ^ crc;
+        uint32_t two = crc_read_word(p + 4);
+        crc = crc32_table[7][one & 0xFF] ^ crc32_table[6][(one >> 8) & 0xFF] ^
+              crc32_table[5][(one >> 16) & 0xFF] ^ crc32_table[4][one >> 24] ^
+              crc32_table[3][two & 0xFF] ^ crc32_table[2][(two >> 8) & 0xFF] ^
+              crc32_table[1][(two >> 16) & 0xFF] ^ crc32_table[0][two >> 24];
+    }
+
+    while(size--) {
+        crc = (crc >> 8) ^ crc32_table[0][(crc ^ *p++) & 0xFF];
+    }
+
+    return crc;
+}
+
+uint16_t crc16_ccitt_update(uint16_t crc, const void* data, size_t size) {
+    const uint8_t* p = data;
+
+    for(; size >= 4; size -= 4, p += 4) {
+        crc = crc16_ccitt_table[3][p[0] ^ (crc >> 8)] ^ crc16_ccitt_table[2][p[1] ^ (crc & 0xFF)] ^
+              crc16_ccitt_table[1][p[2]] ^ crc16_ccitt_table[0][p[3]];
+    }
+
+    while(size--) {
+        crc = (crc << 8) ^ crc16_ccitt_table[0][(crc >> 8) ^ *p++];
+    }
+
+    return crc;
+}
+
+uint16_t crc16_ccitt_reflected_update(uint16_t crc, const void* data, size_t size) {
+    const uint8_t* p = data;
+
+    for(; size >= 4; size -= 4, p += 4) {
+        uint32_t word = crc_read_word(p) ^ crc;
+        crc = crc16_ccitt_reflected_table[3][word & 0xFF] ^
+              crc16_ccitt_reflected_table[2][(word >> 8) & 0xFF] ^
+              crc16_ccitt_reflected_table[1][(word >> 16) & 0xFF] ^
+              crc16_ccitt_reflected_table[0][word >> 24];
+    }
+
+    while(size--) {
+        crc = (crc >> 8) ^ crc16_ccitt_reflected_table[0][(crc ^ *p++) & 0xFF];
+    }
+
+    return crc;
+}
+
+uint8_t crc8_maxim_update(uint8_t crc, const void* data, size_t size) {
+    const uint8_t* p = data;
+
+    for(; size >= 4; size -= 4, p += 4) {
+        uint32_t word = crc_read_word(p) ^ crc;
+        crc = crc8_maxim_table[3][word & 0xFF] ^ crc8_maxim_table[2][(word >> 8) & 0xFF] ^
+              crc8_maxim_table[1][(word >> 16) & 0xFF] ^ crc8_maxim_table[0][word >> 24];
+    }
+
+    while(size--) {
+        crc = crc8_maxim_table[0][crc ^ *p++];
+    }
+
+    return crc;
+}
@@ -0,0 +1,65 @@
+/**
+ * @file crc.h
+ * Table-driven CRC engines shared by protocol stacks
+ *
+ * All functions take and return raw CRC register value: no initial or final
+ * inversion is applied, so calculation can be split into several calls.
+ * Protocol-specific init values and final xor are handled by the callers.
+ */
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Update CRC-32 (reflected, polynomial 0x04C11DB7) register, slicing-by-8
+ *
+ * Standard CRC-32 is ~crc32_update(0xFFFFFFFF, data, size).
+ *
+ * @param crc   raw CRC register
+ * @param data  data to process
+ * @param size  data size in bytes
+ * @return updated CRC register
+ */
+uint32_t crc32_update(uint32_t crc, const void* data, size_t size);
+
+/** Update CRC-16/CCITT (polynomial 0x1021, MSB first) register, slicing-by-4
+ *
+ * Used by FeliCa.
+ *
+ * @param crc   raw CRC register
+ * @param data  data to process
+ * @param size  data size in bytes
+ * @return updated CRC register
+ */
+uint16_t crc16_ccitt_update(uint16_t crc, const void* data, size_t size);
+
+/** Update reflected CRC-16/CCITT (polynomial 0x1021, LSB first) register, slicing-by-4
+ *
+ * Used by ISO14443 and ISO13239.
+ *
+ * @param crc   raw CRC register
+ * @param data  data to process
+ * @param size  data size in bytes
+ * @return updated CRC register
+ */
+uint16_t crc16_ccitt_reflected_update(uint16_t crc, const void* data, size_t size);
+
+/** Update Maxim/Dallas CRC-8 (reflected, polynomial 0x31) register, slicing-by-4
+ *
+ * Used by 1-Wire.
+ *
+ * @param crc   raw CRC register
+ * @param data  data to process
+ * @param size  data size in bytes
+ * @return updated CRC register
+ */
+uint8_t crc8_maxim_update(uint8_t crc, const void* data, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
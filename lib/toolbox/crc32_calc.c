@@ -1,11 +1,10 @@
 #include "crc32_calc.h"
-#include <littlefs/lfs_util.h>
+#include "crc.h"
 
 #define CRC_DATA_BUFFER_MAX_LEN 512
 
 uint32_t crc32_calc_buffer(uint32_t crc, const void* buffer, size_t size) {
-    // TODO FL-3547: consider removing dependency on LFS
-    return ~lfs_crc(~crc, buffer, size);
+    return ~crc32_update(~crc, buffer, size);
 }
 
 uint32_t crc32_calc_file(File* file, const FileCrcProgressCb progress_cb, void* context) {
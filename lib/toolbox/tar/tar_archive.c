@@ -6,6 +6,54 @@
 #include <toolbox/path.h>
 
 #include <lib/uzlib/src/uzlib.h>
+#include <m-array.h>
+
+#define TAG             "TarArch"
+#define MAX_NAME_LEN    254
+#define FILE_BLOCK_SIZE (10 * 1024)
+
+#define FILE_OPEN_NTRIES      10
+#define FILE_OPEN_RETRY_DELAY 25
+
+#define GUNZIP_INDEX_MAGIC   (0x495A4754U) /* "TGZI" */
+#define GUNZIP_INDEX_VERSION (2U)
+
+#define GUNZIP_INDEX_FLAG_COMPLETE (1U << 0)
+
+/* Decompressor state snapshot, taken at a known output offset */
+typedef struct {
+    uint32_t dest_pos; /* Uncompressed offset the snapshot was taken at */
+    uint32_t source_pos; /* Compressed offset of the first unconsumed input byte */
+    uint32_t snapshot_offset; /* Offset of the state + dictionary blob in the index file */
+} GunzipCheckpoint;
+
+ARRAY_DEF(GunzipCheckpointArray, GunzipCheckpoint, M_POD_OPLIST);
+
+/* Index file header. Written last, so an interrupted build is never trusted */
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t state_size;
+    uint32_t source_size;
+    uint32_t source_crc32; /* CRC32 from the gzip trailer of the indexed archive */
+    uint32_t source_timestamp; /* Modification time of the indexed archive */
+    uint32_t dict_size;
+    uint32_t interval;
+    uint32_t flags;
+    uint32_t checkpoint_count;
+    uint32_t table_offset;
+} FURI_PACKED GunzipIndexHeader;
+
+typedef struct {
+    File* file;
+    uint32_t interval;
+    uint32_t source_size;
+    uint32_t source_crc32;
+    uint32_t source_timestamp;
+    bool complete; /* Whole stream was indexed, no new checkpoints needed */
+    bool dirty; /* New checkpoints were appended, header must be rewritten */
+    GunzipCheckpointArray_t checkpoints;
+} GunzipIndex;
 
 typedef struct {
     File* file;
@@ -18,6 +66,8 @@ typedef struct {
     uint32_t source_pos;
     uint32_t dest_pos;
     bool eof;
+
+    GunzipIndex* index;
 } Gunzip;
 
 int gunzip_read_cb(struct uzlib_uncomp* uncomp) {
@@ -37,14 +87,7 @@ int gunzip_read_cb(struct uzlib_uncomp* uncomp) {
     return gunzip->buffer[0];
 }
 
-Gunzip* gunzip_alloc(File* file, size_t dict_size, size_t buffer_size) {
-    Gunzip* gunzip = malloc(sizeof(Gunzip));
-    gunzip->file = file;
-    gunzip->buffer_size = buffer_size;
-    gunzip->buffer = malloc(buffer_size);
-    gunzip->dict_size = dict_size;
-    gunzip->dict = malloc(dict_size);
-
+static void gunzip_reset_state(Gunzip* gunzip) {
     uzlib_uncompress_init(&gunzip->uzlib, gunzip->dict, gunzip->dict_size);
 
     gunzip->uzlib.source = 0;
@@ -53,16 +96,71 @@ Gunzip* gunzip_alloc(File* file, size_t dict_size, size_t buffer_size) {
     gunzip->source_pos = 0;
     gunzip->dest_pos = 0;
     gunzip->eof = false;
+}
+
+Gunzip* gunzip_alloc(File* file, size_t dict_size, size_t buffer_size) {
+    Gunzip* gunzip = malloc(sizeof(Gunzip));
+    gunzip->file = file;
+    gunzip->buffer_size = buffer_size;
+    gunzip->buffer = malloc(buffer_size);
+    gunzip->dict_size = dict_size;
+    gunzip->dict = malloc(dict_size);
+    gunzip->index = NULL;
+
+    gunzip_reset_state(gunzip);
 
     return gunzip;
 }
 
+static void gunzip_index_finalize(Gunzip* gunzip);
+static void gunzip_index_free(GunzipIndex* index);
+
 void gunzip_free(Gunzip* gunzip) {
+    if(gunzip->index) {
+        gunzip_index_finalize(gunzip);
+        gunzip_index_free(gunzip->index);
+    }
     free(gunzip->buffer);
     free(gunzip->dict);
     free(gunzip);
 }
 
+/* Offset of the first compressed byte not yet consumed by uzlib */
+static uint32_t gunzip_get_consumed_pos(Gunzip* gunzip) {
+    return gunzip->source_pos - (gunzip->uzlib.source_limit - gunzip->uzlib.source);
+}
+
+static void gunzip_index_add_checkpoint(Gunzip* gunzip) {
+    GunzipIndex* index = gunzip->index;
+    GunzipCheckpoint checkpoint = {
+        .dest_pos = gunzip->dest_pos,
+        .source_pos = gunzip_get_consumed_pos(gunzip),
+        .snapshot_offset = storage_file_size(index->file),
+    };
+
+    if(!storage_file_seek(index->file, checkpoint.snapshot_offset, true) ||
+       storage_file_write(index->file, &gunzip->uzlib, sizeof(gunzip->uzlib)) !=
+           sizeof(gunzip->uzlib) ||
+       storage_file_write(index->file, gunzip->dict, gunzip->dict_size) != gunzip->dict_size) {
+        FURI_LOG_W(TAG, "Failed to store checkpoint at %lu", checkpoint.dest_pos);
+        return;
+    }
+
+    GunzipCheckpointArray_push_back(index->checkpoints, checkpoint);
+    index->dirty = true;
+}
+
+static bool gunzip_index_should_checkpoint(Gunzip* gunzip) {
+    GunzipIndex* index = gunzip->index;
+    if(!index || index->complete || gunzip->eof) return false;
+
+    uint32_t last_pos = 0;
+    if(!GunzipCheckpointArray_empty_p(index->checkpoints)) {
+        last_pos = GunzipCheckpointArray_back(index->checkpoints)->dest_pos;
+    }
+    return gunzip->dest_pos >= last_pos + index->interval;
+}
+
 int32_t gunzip_uncompress(Gunzip* gunzip, void* out, size_t out_len) {
     if(gunzip->eof) {
         return 0;
@@ -75,24 +173,98 @@ int32_t gunzip_uncompress(Gunzip* gunzip, void* out, size_t out_len) {
 
     if(res == TINF_DONE) {
         gunzip->eof = true;
+        if(gunzip->index && !gunzip->index->complete) {
+            gunzip->index->complete = true;
+            gunzip->index->dirty = true;
+        }
     }
     if(res < 0) {
         return res;
     }
     int32_t read = gunzip->uzlib.dest - (uint8_t*)out;
     gunzip->dest_pos += read;
+
+    if(gunzip_index_should_checkpoint(gunzip)) {
+        gunzip_index_add_checkpoint(gunzip);
+    }
+
     return read;
 }
 
+static bool gunzip_rewind(Gunzip* gunzip) {
+    if(!storage_file_seek(gunzip->file, 0, true)) {
+        return false;
+    }
+    gunzip_reset_state(gunzip);
+    return uzlib_gzip_parse_header(&gunzip->uzlib) == TINF_OK;
+}
+
+static bool gunzip_restore_checkpoint(Gunzip* gunzip, const GunzipCheckpoint* checkpoint) {
+    File* index_file = gunzip->index->file;
+    bool success = false;
+
+    do {
+        if(!storage_file_seek(index_file, checkpoint->snapshot_offset, true)) break;
+        if(storage_file_read(index_file, &gunzip->uzlib, sizeof(gunzip->uzlib)) !=
+           sizeof(gunzip->uzlib))
+            break;
+        if(storage_file_read(index_file, gunzip->dict, gunzip->dict_size) != gunzip->dict_size)
+            break;
+        if(!storage_file_seek(gunzip->file, checkpoint->source_pos, true)) break;
+        success = true;
+    } while(false);
+
+    // Pointers in the snapshot are only meaningful for this instance, fix them up
+    gunzip->uzlib.source = 0;
+    gunzip->uzlib.source_limit = 0;
+    gunzip->uzlib.source_read_cb = gunzip_read_cb;
+    gunzip->uzlib.dict_ring = gunzip->dict;
+    gunzip->source_pos = checkpoint->source_pos;
+    gunzip->dest_pos = checkpoint->dest_pos;
+    gunzip->eof = false;
+
+    return success;
+}
+
+/* Last checkpoint at or before pos, NULL if there is none */
+static const GunzipCheckpoint* gunzip_index_lookup(GunzipIndex* index, size_t pos) {
+    size_t count = GunzipCheckpointArray_size(index->checkpoints);
+    size_t lo = 0, hi = count;
+    while(lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if(GunzipCheckpointArray_cget(index->checkpoints, mid)->dest_pos <= pos) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo ? GunzipCheckpointArray_cget(index->checkpoints, lo - 1) : NULL;
+}
+
 int32_t gunzip_seek(Gunzip* gunzip, size_t pos) {
     if(pos == gunzip->dest_pos) {
         return 0;
     }
 
-    if(pos < gunzip->dest_pos) {
-        // TODO: rewind to start if this causes issues
-        furi_crash("Gunzip rewind");
-        return -1;
+    const GunzipCheckpoint* checkpoint = NULL;
+    if(gunzip->index) {
+        checkpoint = gunzip_index_lookup(gunzip->index, pos);
+    }
+
+    if(checkpoint && (checkpoint->dest_pos > gunzip->dest_pos || pos < gunzip->dest_pos)) {
+        if(!gunzip_restore_checkpoint(gunzip, checkpoint)) {
+            FURI_LOG_E(TAG, "Failed to restore checkpoint at %lu", checkpoint->dest_pos);
+            return -1;
+        }
+    } else if(pos < gunzip->dest_pos) {
+        if(!gunzip_rewind(gunzip)) {
+            FURI_LOG_E(TAG, "Failed to rewind gzip stream");
+            return -1;
+        }
+    }
+
+    if(pos == gunzip->dest_pos) {
+        return 0;
     }
 
     size_t void_size = MIN(4096U, pos - gunzip->dest_pos);
@@ -109,12 +281,146 @@ int32_t gunzip_seek(Gunzip* gunzip, size_t pos) {
     return (pos == gunzip->dest_pos) ? 0 : -1;
 }
 
-#define TAG             "TarArch"
-#define MAX_NAME_LEN    254
-#define FILE_BLOCK_SIZE (10 * 1024)
+static bool gunzip_index_load(Gunzip* gunzip, GunzipIndex* index) {
+    GunzipIndexHeader header;
+    if(storage_file_read(index->file, &header, sizeof(header)) != sizeof(header)) return false;
 
-#define FILE_OPEN_NTRIES      10
-#define FILE_OPEN_RETRY_DELAY 25
+    if(header.magic != GUNZIP_INDEX_MAGIC || header.version != GUNZIP_INDEX_VERSION ||
+       header.state_size != sizeof(gunzip->uzlib) || header.source_size != index->source_size ||
+       header.source_crc32 != index->source_crc32 ||
+       header.source_timestamp != index->source_timestamp ||
+       header.dict_size != gunzip->dict_size || header.interval != index->interval ||
+       header.table_offset == 0) {
+        return false;
+    }
+
+    index->complete = header.flags & GUNZIP_INDEX_FLAG_COMPLETE;
+
+    if(!storage_file_seek(index->file, header.table_offset, true)) return false;
+
+    for(uint32_t i = 0; i < header.checkpoint_count; i++) {
+        GunzipCheckpoint checkpoint;
+        if(storage_file_read(index->file, &checkpoint, sizeof(checkpoint)) !=
+           sizeof(checkpoint)) {
+            GunzipCheckpointArray_reset(index->checkpoints);
+            return false;
+        }
+        GunzipCheckpointArray_push_back(index->checkpoints, checkpoint);
+    }
+
+    return true;
+}
+
+static void gunzip_index_save(GunzipIndex* index, size_t dict_size) {
+    GunzipIndexHeader header = {
+        .magic = GUNZIP_INDEX_MAGIC,
+        .version = GUNZIP_INDEX_VERSION,
+        .state_size = sizeof(struct uzlib_uncomp),
+        .source_size = index->source_size,
+        .source_crc32 = index->source_crc32,
+        .source_timestamp = index->source_timestamp,
+        .dict_size = dict_size,
+        .interval = index->interval,
+        .flags = index->complete ? GUNZIP_INDEX_FLAG_COMPLETE : 0,
+        .checkpoint_count = GunzipCheckpointArray_size(index->checkpoints),
+        .table_offset = storage_file_size(index->file),
+    };
+
+    if(!storage_file_seek(index->file, header.table_offset, true)) return;
+
+    GunzipCheckpointArray_it_t it;
+    for(GunzipCheckpointArray_it(it, index->checkpoints); !GunzipCheckpointArray_end_p(it);
+        GunzipCheckpointArray_next(it)) {
+        const GunzipCheckpoint* checkpoint = GunzipCheckpointArray_cref(it);
+        if(storage_file_write(index->file, checkpoint, sizeof(*checkpoint)) !=
+           sizeof(*checkpoint)) {
+            return;
+        }
+    }
+
+    if(storage_file_seek(index->file, 0, true)) {
+        storage_file_write(index->file, &header, sizeof(header));
+    }
+}
+
+static void gunzip_index_free(GunzipIndex* index) {
+    storage_file_close(index->file);
+    storage_file_free(index->file);
+    GunzipCheckpointArray_clear(index->checkpoints);
+    free(index);
+}
+
+/* Read CRC32 of the uncompressed data from the gzip trailer, keeping the read position */
+static bool gunzip_read_trailer_crc32(Gunzip* gunzip, uint32_t source_size, uint32_t* crc32) {
+    uint32_t trailer[2]; /* CRC32, ISIZE */
+    uint64_t pos = storage_file_tell(gunzip->file);
+
+    bool success = source_size >= sizeof(trailer) &&
+                   storage_file_seek(gunzip->file, source_size - sizeof(trailer), true) &&
+                   storage_file_read(gunzip->file, trailer, sizeof(trailer)) == sizeof(trailer);
+    success = storage_file_seek(gunzip->file, pos, true) && success;
+
+    if(success) *crc32 = trailer[0];
+    return success;
+}
+
+static bool gunzip_index_attach(
+    Gunzip* gunzip,
+    Storage* storage,
+    const char* index_path,
+    uint32_t interval,
+    uint32_t source_size,
+    uint32_t source_timestamp) {
+    // Size alone does not tell an archive edited in place from the one that was indexed
+    uint32_t source_crc32;
+    if(!gunzip_read_trailer_crc32(gunzip, source_size, &source_crc32)) {
+        FURI_LOG_E(TAG, "Failed to read gzip trailer");
+        return false;
+    }
+
+    GunzipIndex* index = malloc(sizeof(GunzipIndex));
+    index->file = storage_file_alloc(storage);
+    index->interval = interval;
+    index->source_size = source_size;
+    index->source_crc32 = source_crc32;
+    index->source_timestamp = source_timestamp;
+    index->complete = false;
+    index->dirty = false;
+    GunzipCheckpointArray_init(index->checkpoints);
+
+    bool loaded = false;
+    if(storage_file_open(index->file, index_path, FSAM_READ_WRITE, FSOM_OPEN_EXISTING)) {
+        loaded = gunzip_index_load(gunzip, index);
+        if(!loaded) {
+            storage_file_close(index->file);
+        }
+    }
+
+    if(!loaded) {
+        FURI_LOG_I(TAG, "Building gzip index '%s'", index_path);
+        GunzipIndexHeader header = {0};
+        if(!storage_file_open(index->file, index_path, FSAM_READ_WRITE, FSOM_CREATE_ALWAYS) ||
+           storage_file_write(index->file, &header, sizeof(header)) != sizeof(header)) {
+            storage_file_free(index->file);
+            GunzipCheckpointArray_clear(index->checkpoints);
+            free(index);
+            return false;
+        }
+        // Even an empty table has to be written, small archives never get checkpoints
+        index->dirty = true;
+    }
+
+    gunzip->index = index;
+    return true;
+}
+
+static void gunzip_index_finalize(Gunzip* gunzip) {
+    GunzipIndex* index = gunzip->index;
+    if(index && index->dirty) {
+        gunzip_index_save(index, gunzip->dict_size);
+        index->dirty = false;
+    }
+}
 
 typedef struct TarArchive {
     Storage* storage;
@@ -125,6 +431,7 @@ typedef struct TarArchive {
     tar_unpack_read_cb read_cb;
     void* read_cb_context;
     size_t total_size;
+    uint32_t timestamp;
     Gunzip* gunzip;
 } TarArchive;
 
@@ -207,6 +514,8 @@ TarArchive* tar_archive_alloc(Storage* storage) {
     TarArchive* archive = malloc(sizeof(TarArchive));
     archive->storage = storage;
     archive->unpack_cb = NULL;
+    archive->read_cb = NULL;
+    archive->gunzip = NULL;
     return archive;
 }
 
@@ -243,6 +552,10 @@ bool tar_archive_open(TarArchive* archive, const char* path, TarOpenMode mode) {
         mtar_init(&archive->tar, mtar_access, &filesystem_ops, stream);
     } else {
         archive->gunzip = gunzip_alloc(stream, 32 * 1024, 10 * 1024);
+        // Unknown time only leaves the trailer CRC to validate a gzip index with
+        if(storage_common_timestamp(archive->storage, path, &archive->timestamp) != FSE_OK) {
+            archive->timestamp = 0;
+        }
 
         int res = uzlib_gzip_parse_header(&archive->gunzip->uzlib);
         if(res != TINF_OK) {
@@ -268,6 +581,27 @@ void tar_archive_free(TarArchive* archive) {
     free(archive);
 }
 
+bool tar_archive_set_gzip_index(
+    TarArchive* archive,
+    const char* index_path,
+    uint32_t checkpoint_interval) {
+    furi_check(archive);
+    furi_check(index_path);
+    furi_check(checkpoint_interval > 0);
+
+    if(!archive->gunzip || archive->gunzip->index) {
+        return false;
+    }
+
+    return gunzip_index_attach(
+        archive->gunzip,
+        archive->storage,
+        index_path,
+        checkpoint_interval,
+        archive->total_size,
+        archive->timestamp);
+}
+
 void tar_archive_set_file_callback(TarArchive* archive, tar_unpack_file_cb callback, void* context) {
     furi_check(archive);
     archive->unpack_cb = callback;
@@ -45,6 +45,22 @@ bool tar_archive_unpack_file(
     const char* archive_fname,
     const char* destination);
 
+/* Default distance between gzip index checkpoints, in uncompressed bytes */
+#define TAR_GZIP_INDEX_INTERVAL_DEFAULT (64 * 1024)
+
+/* Optional random access index for gzip-compressed archives opened for reading.
+ * Decompressor snapshots are stored every checkpoint_interval bytes of output in
+ * a sidecar file at index_path. An existing index is reused if it was built for an
+ * archive of the same size, modification time and gzip trailer CRC, otherwise it is
+ * rebuilt while the archive is read. Allows backward seeks and skipping over already
+ * indexed data, so repeated tar_archive_unpack_file calls don't decompress the
+ * whole archive every time. Each checkpoint takes ~33KB in the index file.
+ * Returns false if archive is not gzip-compressed or index file can't be created. */
+bool tar_archive_set_gzip_index(
+    TarArchive* archive,
+    const char* index_path,
+    uint32_t checkpoint_interval);
+
 /* Optional per-entry callback on unpacking - return false to skip entry */
 typedef bool (*tar_unpack_file_cb)(const char* name, bool is_directory, void* context);
 
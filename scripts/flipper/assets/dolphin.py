@@ -1,6 +1,7 @@
 import multiprocessing
 import logging
 import os
+import struct
 from collections import Counter
 
 from flipper.utils.fff import FlipperFormatFile
@@ -8,12 +9,6 @@ from flipper.utils.templite import Templite
 from .icon import ImageTools, file2image
 
 
-def _convert_image_to_bm(pair: set):
-    source_filename, destination_filename = pair
-    image = file2image(source_filename)
-    image.write(destination_filename)
-
-
 def _convert_image(source_filename: str):
     image = file2image(source_filename)
     return image.data
@@ -23,6 +18,13 @@ class DolphinBubbleAnimation:
     FILE_TYPE = "Flipper Animation"
     FILE_VERSION = 1
 
+    # Packed animation, see animation_storage.c for layout
+    PACKED_FILENAME = "animation.bin"
+    PACKED_MAGIC = 0x4D494E41
+    PACKED_VERSION = 1
+    PACKED_HEADER_FORMAT = "<IBBBBBBBBHHBBH"
+    PACKED_BUBBLE_FORMAT = "<BBBccBBB"
+
     def __init__(
         self,
         name: str,
@@ -218,18 +220,72 @@ class DolphinBubbleAnimation:
 
         file.save(meta_filename)
 
-        to_pack = []
-        for index, frame in enumerate(self.frames):
-            to_pack.append(
-                (frame, os.path.join(animation_directory, f"frame_{index}.bm"))
-            )
-
         if ImageTools.is_processing_slow():
             pool = multiprocessing.Pool()
-            pool.map(_convert_image_to_bm, to_pack)
+            frames_data = pool.map(_convert_image, self.frames)
         else:
-            for image in to_pack:
-                _convert_image_to_bm(image)
+            frames_data = list(_convert_image(frame) for frame in self.frames)
+
+        # Unpacked files stay for older firmware and tools, packed one is used if present
+        for index, frame in enumerate(frames_data):
+            with open(
+                os.path.join(animation_directory, f"frame_{index}.bm"), "wb"
+            ) as bm_file:
+                bm_file.write(frame)
+
+        self.save_packed(
+            os.path.join(animation_directory, self.PACKED_FILENAME), frames_data
+        )
+
+    def save_packed(self, packed_filename: str, frames_data: list):
+        frames_order = self.meta["Frames order"]
+        data = bytearray(
+            struct.pack(
+                self.PACKED_HEADER_FORMAT,
+                self.PACKED_MAGIC,
+                self.PACKED_VERSION,
+                self.meta["Width"],
+                self.meta["Height"],
+                len(frames_data),
+                self.meta["Passive frames"],
+                self.meta["Active frames"],
+                self.meta["Active cycles"],
+                self.meta["Frame rate"],
+                self.meta["Duration"],
+                self.meta["Active cooldown"],
+                self.bubble_slots,
+                len(self.bubbles),
+                0,
+            )
+        )
+        data += bytes(frames_order)
+
+        for bubble in self.bubbles:
+            text = bubble["Text"].replace("\\n", "\n").encode()
+            data += struct.pack(
+                self.PACKED_BUBBLE_FORMAT,
+                bubble["Slot"],
+                bubble["X"],
+                bubble["Y"],
+                bubble["AlignH"][0].encode(),
+                bubble["AlignV"][0].encode(),
+                bubble["StartFrame"],
+                bubble["EndFrame"],
+                len(text),
+            )
+            data += text
+
+        offset = len(data) + 4 * (len(frames_data) + 1)
+        for frame in frames_data:
+            data += struct.pack("<I", offset)
+            offset += len(frame)
+        data += struct.pack("<I", offset)
+
+        for frame in frames_data:
+            data += frame
+
+        with open(packed_filename, "wb") as packed_file:
+            packed_file.write(data)
 
     def process(self):
         if ImageTools.is_processing_slow():
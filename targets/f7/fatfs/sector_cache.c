@@ -6,51 +6,202 @@
 #include <furi.h>
 #include <furi_hal_memory.h>
 
+#define TAG "SectorCache"
+
 #define SECTOR_SIZE 512
-#define N_SECTORS   8
+#define N_BUCKETS   32
+#define NO_ENTRY    0xFF
+
+_Static_assert(SECTOR_CACHE_SECTORS < NO_ENTRY, "Sector index doesn't fit");
+
+#define SECTOR_BUCKET(n_sector) ((n_sector) % N_BUCKETS)
 
 typedef struct {
-    uint32_t itr;
-    uint32_t sectors[N_SECTORS];
-    uint8_t sector_data[N_SECTORS][SECTOR_SIZE];
+    uint32_t sector;
+    uint8_t bucket_next;
+    uint8_t lru_prev;
+    uint8_t lru_next;
+    uint8_t priority;
+    bool is_valid;
+} SectorCacheEntry;
+
+typedef struct {
+    SectorCacheEntry entries[SECTOR_CACHE_SECTORS];
+    uint8_t buckets[N_BUCKETS];
+    uint8_t lru_head; // most recently used
+    uint8_t lru_tail; // least recently used
+    uint8_t meta_count;
+    uint8_t sector_data[][SECTOR_SIZE];
 } SectorCache;
 
 static SectorCache* cache = NULL;
+static uint8_t cache_sectors = 0;
+// Leave room for data, so file reads don't evict each other immediately
+static uint8_t cache_meta_max = 0;
+
+static void sector_cache_lru_unlink(uint8_t index) {
+    SectorCacheEntry* entry = &cache->entries[index];
+
+    if(entry->lru_prev != NO_ENTRY) {
+        cache->entries[entry->lru_prev].lru_next = entry->lru_next;
+    } else {
+        cache->lru_head = entry->lru_next;
+    }
+
+    if(entry->lru_next != NO_ENTRY) {
+        cache->entries[entry->lru_next].lru_prev = entry->lru_prev;
+    } else {
+        cache->lru_tail = entry->lru_prev;
+    }
+}
+
+static void sector_cache_lru_push_head(uint8_t index) {
+    SectorCacheEntry* entry = &cache->entries[index];
+
+    entry->lru_prev = NO_ENTRY;
+    entry->lru_next = cache->lru_head;
+    if(cache->lru_head != NO_ENTRY) {
+        cache->entries[cache->lru_head].lru_prev = index;
+    } else {
+        cache->lru_tail = index;
+    }
+    cache->lru_head = index;
+}
+
+static void sector_cache_lru_push_tail(uint8_t index) {
+    SectorCacheEntry* entry = &cache->entries[index];
+
+    entry->lru_next = NO_ENTRY;
+    entry->lru_prev = cache->lru_tail;
+    if(cache->lru_tail != NO_ENTRY) {
+        cache->entries[cache->lru_tail].lru_next = index;
+    } else {
+        cache->lru_head = index;
+    }
+    cache->lru_tail = index;
+}
+
+static uint8_t sector_cache_find(uint32_t n_sector) {
+    uint8_t index = cache->buckets[SECTOR_BUCKET(n_sector)];
+    while(index != NO_ENTRY && cache->entries[index].sector != n_sector) {
+        index = cache->entries[index].bucket_next;
+    }
+    return index;
+}
+
+static void sector_cache_remove(uint8_t index) {
+    SectorCacheEntry* entry = &cache->entries[index];
+    if(!entry->is_valid) return;
+
+    uint8_t* link = &cache->buckets[SECTOR_BUCKET(entry->sector)];
+    while(*link != index) {
+        link = &cache->entries[*link].bucket_next;
+    }
+    *link = entry->bucket_next;
+
+    if(entry->priority == SectorCachePriorityMeta) cache->meta_count--;
+    entry->is_valid = false;
+}
+
+static uint8_t sector_cache_get_victim(SectorCachePriority priority) {
+    // Metadata only replaces metadata once it took its share of the cache
+    bool is_meta = (priority == SectorCachePriorityMeta) && (cache->meta_count >= cache_meta_max);
+
+    for(uint8_t index = cache->lru_tail; index != NO_ENTRY;
+        index = cache->entries[index].lru_prev) {
+        SectorCacheEntry* entry = &cache->entries[index];
+        if(!entry->is_valid || ((entry->priority == SectorCachePriorityMeta) == is_meta)) {
+            return index;
+        }
+    }
+
+    return cache->lru_tail;
+}
 
 void sector_cache_init(void) {
     if(cache == NULL) {
-        cache = memmgr_alloc_from_pool(sizeof(SectorCache));
+        cache_sectors = SECTOR_CACHE_SECTORS;
+        cache = furi_hal_memory_alloc(sizeof(SectorCache) + cache_sectors * SECTOR_SIZE);
+        if(cache == NULL) {
+            // No SRAM2 pool left, don't take more heap than the old cache did
+            cache_sectors = MIN(SECTOR_CACHE_SECTORS, SECTOR_CACHE_SECTORS_HEAP);
+            cache = malloc(sizeof(SectorCache) + cache_sectors * SECTOR_SIZE);
+            FURI_LOG_W(TAG, "Pool is full, %u sectors on heap", cache_sectors);
+        }
+        cache_meta_max = cache_sectors * 3 / 4;
     }
 
     if(cache != NULL) {
-        memset(cache, 0, sizeof(SectorCache));
+        memset(cache, 0, sizeof(SectorCache) + cache_sectors * SECTOR_SIZE);
+        memset(cache->buckets, NO_ENTRY, sizeof(cache->buckets));
+        cache->lru_head = NO_ENTRY;
+        cache->lru_tail = NO_ENTRY;
+        for(uint8_t index = 0; index < cache_sectors; ++index) {
+            sector_cache_lru_push_tail(index);
+        }
     }
 }
 
 uint8_t* sector_cache_get(uint32_t n_sector) {
-    if(cache != NULL && n_sector != 0) {
-        for(int sector_i = 0; sector_i < N_SECTORS; ++sector_i) {
-            if(cache->sectors[sector_i] == n_sector) {
-                return cache->sector_data[sector_i];
-            }
+    if(cache == NULL) return NULL;
+
+    uint8_t index = sector_cache_find(n_sector);
+    if(index == NO_ENTRY) return NULL;
+
+    SectorCacheEntry* entry = &cache->entries[index];
+    sector_cache_lru_unlink(index);
+    if(entry->priority == SectorCachePriorityReadAhead) {
+        // Sequentially read data is rarely needed twice
+        entry->priority = SectorCachePriorityData;
+        sector_cache_lru_push_tail(index);
+    } else {
+        if(entry->priority == SectorCachePriorityData && cache->meta_count < cache_meta_max) {
+            entry->priority = SectorCachePriorityMeta;
+            cache->meta_count++;
         }
+        sector_cache_lru_push_head(index);
     }
-    return NULL;
+
+    return cache->sector_data[index];
 }
 
-void sector_cache_put(uint32_t n_sector, uint8_t* data) {
+void sector_cache_put(uint32_t n_sector, const uint8_t* data, SectorCachePriority priority) {
     if(cache == NULL) return;
-    cache->sectors[cache->itr % N_SECTORS] = n_sector;
-    memcpy(cache->sector_data[cache->itr % N_SECTORS], data, SECTOR_SIZE);
-    cache->itr++;
+
+    uint8_t index = sector_cache_find(n_sector);
+    if(index != NO_ENTRY) {
+        // Don't demote a sector that was already found to be reused
+        if(cache->entries[index].priority > priority) priority = cache->entries[index].priority;
+        sector_cache_remove(index);
+    } else {
+        index = sector_cache_get_victim(priority);
+        sector_cache_remove(index);
+    }
+
+    SectorCacheEntry* entry = &cache->entries[index];
+    if(priority == SectorCachePriorityMeta && cache->meta_count >= cache_meta_max) {
+        priority = SectorCachePriorityData;
+    }
+    entry->sector = n_sector;
+    entry->priority = priority;
+    entry->is_valid = true;
+    entry->bucket_next = cache->buckets[SECTOR_BUCKET(n_sector)];
+    cache->buckets[SECTOR_BUCKET(n_sector)] = index;
+    if(priority == SectorCachePriorityMeta) cache->meta_count++;
+
+    memcpy(cache->sector_data[index], data, SECTOR_SIZE);
+    sector_cache_lru_unlink(index);
+    sector_cache_lru_push_head(index);
 }
 
 void sector_cache_invalidate_range(uint32_t start_sector, uint32_t end_sector) {
     if(cache == NULL) return;
-    for(int sector_i = 0; sector_i < N_SECTORS; ++sector_i) {
-        if((cache->sectors[sector_i] >= start_sector) &&
-           (cache->sectors[sector_i] <= end_sector)) {
-            cache->sectors[sector_i] = 0;
+    for(uint8_t index = 0; index < cache_sectors; ++index) {
+        SectorCacheEntry* entry = &cache->entries[index];
+        if(entry->is_valid && (entry->sector >= start_sector) && (entry->sector <= end_sector)) {
+            sector_cache_remove(index);
+            sector_cache_lru_unlink(index);
+            sector_cache_lru_push_tail(index);
         }
     }
 }
@@ -1,10 +1,27 @@
 #pragma once
 #include <stdint.h>
 
+/** Sectors cached when the SRAM2 pool has room, 512 bytes each */
+#ifndef SECTOR_CACHE_SECTORS
+#define SECTOR_CACHE_SECTORS 16
+#endif
+
+/** Sectors cached when the pool is full and the cache goes to heap */
+#ifndef SECTOR_CACHE_SECTORS_HEAP
+#define SECTOR_CACHE_SECTORS_HEAP 8
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/** Cached sector priority */
+typedef enum {
+    SectorCachePriorityReadAhead, /**< Read speculatively, dropped first once consumed */
+    SectorCachePriorityData, /**< File data, promoted to metadata when read again */
+    SectorCachePriorityMeta, /**< Boot, FAT and directory sectors, evicted last */
+} SectorCachePriority;
+
 /**
  * @brief Init sector cache system
  */
@@ -21,8 +38,9 @@ uint8_t* sector_cache_get(uint32_t n_sector);
  * @brief Put sector data to cache
  * @param n_sector Sector number
  * @param data Pointer to sector data
+ * @param priority Sector priority, least recently used sectors of lower priority are evicted first
  */
-void sector_cache_put(uint32_t n_sector, uint8_t* data);
+void sector_cache_put(uint32_t n_sector, const uint8_t* data, SectorCachePriority priority);
 
 /**
  * @brief Invalidate sector cache for given range
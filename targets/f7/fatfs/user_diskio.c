@@ -1,8 +1,17 @@
 #include <furi.h>
 #include <furi_hal.h>
+#include <furi_hal_memory.h>
 #include "user_diskio.h"
 #include "sector_cache.h"
 
+#define TAG "SdFatfsDriver"
+
+/** Sectors fetched in one command for sequential readers, 1 disables read-ahead */
+#ifndef DRIVER_READ_AHEAD_SECTORS
+#define DRIVER_READ_AHEAD_SECTORS (4)
+#endif
+#define DRIVER_READ_STREAMS (4)
+
 static DSTATUS driver_initialize(BYTE pdrv);
 static DSTATUS driver_status(BYTE pdrv);
 static DRESULT driver_read(BYTE pdrv, BYTE* buff, DWORD sector, UINT count);
@@ -17,6 +26,91 @@ Diskio_drvTypeDef sd_fatfs_driver = {
     driver_ioctl,
 };
 
+/** Next sector expected by each of recent sequential readers, usually open files */
+static DWORD driver_read_streams[DRIVER_READ_STREAMS];
+static uint8_t driver_read_streams_itr = 0;
+static uint8_t* driver_read_ahead_buffer = NULL;
+static SdFatfsDriverStats driver_stats = {0};
+/** Volume layout from storage service, cluster size is 0 when there is none */
+static SdFatfsDriverLayout driver_layout = {0};
+
+static bool driver_read_stream_advance(DWORD sector) {
+    for(uint8_t i = 0; i < DRIVER_READ_STREAMS; i++) {
+        if(driver_read_streams[i] == sector) {
+            driver_read_streams[i] = sector + 1;
+            return true;
+        }
+    }
+
+    driver_read_streams[driver_read_streams_itr++ % DRIVER_READ_STREAMS] = sector + 1;
+    return false;
+}
+
+static SectorCachePriority driver_sector_priority(DWORD sector) {
+    const SdFatfsDriverLayout* layout = &driver_layout;
+    const DWORD mirrors_start = layout->fat_start + layout->fat_size;
+    const DWORD mirrors_end = layout->fat_start + layout->fat_size * layout->fat_count;
+
+    // Boot sectors, FATs and FAT12/16 root directory precede data area
+    if(!layout->cluster_size || sector >= layout->data_start) return SectorCachePriorityData;
+    // FAT mirrors are only written
+    if(sector >= mirrors_start && sector < mirrors_end) {
+        return SectorCachePriorityData;
+    }
+    return SectorCachePriorityMeta;
+}
+
+static UINT driver_read_ahead_count(DWORD sector) {
+    const SdFatfsDriverLayout* layout = &driver_layout;
+    DWORD end;
+
+    if(!layout->cluster_size) {
+        return 1;
+    } else if(sector < layout->data_start) {
+        end = layout->data_start;
+    } else {
+        // Next cluster of the file is not necessarily adjacent
+        end = sector - (sector - layout->data_start) % layout->cluster_size +
+              layout->cluster_size;
+    }
+
+    return MIN(end - sector, (DWORD)DRIVER_READ_AHEAD_SECTORS);
+}
+
+static FuriStatus driver_read_sector(BYTE* buff, DWORD sector, bool is_sequential) {
+    FuriStatus status;
+    SectorCachePriority priority = driver_sector_priority(sector);
+    UINT count = is_sequential ? driver_read_ahead_count(sector) : 1;
+
+    if(count > 1 && driver_read_ahead_buffer) {
+        // Sequential reader: fetch following sectors with the same command
+        status = furi_hal_sd_read_blocks((uint32_t*)driver_read_ahead_buffer, sector, count);
+        driver_stats.read_commands++;
+        if(status == FuriStatusOk) {
+            memcpy(buff, driver_read_ahead_buffer, _MAX_SS);
+            for(UINT i = 1; i < count; i++) {
+                SectorCachePriority ahead_priority = driver_sector_priority(sector + i);
+                if(ahead_priority != SectorCachePriorityMeta) {
+                    ahead_priority = SectorCachePriorityReadAhead;
+                }
+                sector_cache_put(
+                    sector + i, driver_read_ahead_buffer + i * _MAX_SS, ahead_priority);
+            }
+        }
+    } else {
+        status = furi_hal_sd_read_blocks((uint32_t*)buff, (uint32_t)(sector), 1);
+        driver_stats.read_commands++;
+    }
+
+    // Sequentially read data is consumed at once, no need to keep it
+    bool is_kept = !is_sequential || (priority == SectorCachePriorityMeta);
+    if(status == FuriStatusOk && is_kept) {
+        sector_cache_put(sector, buff, priority);
+    }
+
+    return status;
+}
+
 /**
   * @brief  Initializes a Drive
   * @param  pdrv: Physical drive number (0..)
@@ -24,6 +118,11 @@ Diskio_drvTypeDef sd_fatfs_driver = {
   */
 static DSTATUS driver_initialize(BYTE pdrv) {
     UNUSED(pdrv);
+    if(DRIVER_READ_AHEAD_SECTORS > 1 && !driver_read_ahead_buffer) {
+        // Pool only, read-ahead is not worth heap
+        driver_read_ahead_buffer = furi_hal_memory_alloc(DRIVER_READ_AHEAD_SECTORS * _MAX_SS);
+        if(!driver_read_ahead_buffer) FURI_LOG_W(TAG, "Pool is full, no read-ahead");
+    }
     return RES_OK;
 }
 
@@ -52,7 +151,24 @@ static DSTATUS driver_status(BYTE pdrv) {
   */
 static DRESULT driver_read(BYTE pdrv, BYTE* buff, DWORD sector, UINT count) {
     UNUSED(pdrv);
-    FuriStatus status = furi_hal_sd_read_blocks((uint32_t*)buff, (uint32_t)(sector), count);
+    FuriStatus status;
+    driver_stats.read_sectors += count;
+
+    if(count == 1) {
+        // Single sector reads come from FAT/directory window and partial file reads
+        bool is_sequential = driver_read_stream_advance(sector);
+        uint8_t* cached_data = sector_cache_get(sector);
+        if(cached_data) {
+            memcpy(buff, cached_data, _MAX_SS);
+            driver_stats.cache_hits++;
+            return RES_OK;
+        }
+        status = driver_read_sector(buff, sector, is_sequential);
+    } else {
+        status = furi_hal_sd_read_blocks((uint32_t*)buff, (uint32_t)(sector), count);
+        driver_stats.read_commands++;
+    }
+
     return status == FuriStatusOk ? RES_OK : RES_ERROR;
 }
 
@@ -67,6 +183,11 @@ static DRESULT driver_read(BYTE pdrv, BYTE* buff, DWORD sector, UINT count) {
 static DRESULT driver_write(BYTE pdrv, const BYTE* buff, DWORD sector, UINT count) {
     UNUSED(pdrv);
     FuriStatus status = furi_hal_sd_write_blocks((uint32_t*)buff, (uint32_t)(sector), count);
+    // Written sectors are dropped from cache, keep the metadata FatFs is going to read back
+    if(status == FuriStatusOk && count == 1 &&
+       driver_sector_priority(sector) == SectorCachePriorityMeta) {
+        sector_cache_put(sector, buff, SectorCachePriorityMeta);
+    }
     return status == FuriStatusOk ? RES_OK : RES_ERROR;
 }
 
@@ -117,3 +238,16 @@ static DRESULT driver_ioctl(BYTE pdrv, BYTE cmd, void* buff) {
 
     return res;
 }
+
+void sd_fatfs_driver_set_layout(const SdFatfsDriverLayout* layout) {
+    if(layout) {
+        driver_layout = *layout;
+    } else {
+        memset(&driver_layout, 0, sizeof(driver_layout));
+    }
+}
+
+void sd_fatfs_driver_get_stats(SdFatfsDriverStats* stats) {
+    furi_check(stats);
+    *stats = driver_stats;
+}
@@ -8,6 +8,34 @@ extern "C" {
 
 extern Diskio_drvTypeDef sd_fatfs_driver;
 
+typedef struct {
+    uint32_t read_sectors; /**< Sectors read by FatFs */
+    uint32_t read_commands; /**< SD read commands sent */
+    uint32_t cache_hits; /**< Sectors served from the sector cache */
+} SdFatfsDriverStats;
+
+typedef struct {
+    uint32_t fat_start; /**< First sector of the first FAT */
+    uint32_t fat_size; /**< Sectors in one FAT */
+    uint32_t fat_count; /**< Number of FAT copies */
+    uint32_t data_start; /**< First sector of data area, FATs and FAT12/16 root dir precede it */
+    uint32_t cluster_size; /**< Sectors in one cluster */
+} SdFatfsDriverLayout;
+
+/** Set volume layout the sector cache uses to tell FAT and directory sectors from file data
+ *
+ * Without layout every sector is treated as file data and read-ahead is off.
+ *
+ * @param layout pointer to SdFatfsDriverLayout, NULL when no volume is mounted
+ */
+void sd_fatfs_driver_set_layout(const SdFatfsDriverLayout* layout);
+
+/** Get SD read counters since boot
+ *
+ * @param stats pointer to SdFatfsDriverStats to fill
+ */
+void sd_fatfs_driver_get_stats(SdFatfsDriverStats* stats);
+
 #ifdef __cplusplus
 }
 #endif
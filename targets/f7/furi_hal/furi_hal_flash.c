@@ -379,6 +379,33 @@ void furi_hal_flash_write_dword(size_t address, uint64_t data) {
         (double)((float)op_stat / (float)furi_hal_cortex_instructions_per_microsecond()));
 }
 
+void furi_hal_flash_write(size_t address, const void* data, size_t size) {
+    /* Check the parameters */
+    furi_check(IS_ADDR_ALIGNED_64BITS(address));
+    furi_check(size && (size % FURI_HAL_FLASH_WRITE_BLOCK) == 0);
+    furi_check(IS_FLASH_PROGRAM_ADDRESS(address));
+    furi_check(IS_FLASH_PROGRAM_ADDRESS(address + size - 1));
+
+    uint32_t op_stat = DWT->CYCCNT;
+
+    /* Flash and core2 lock is taken for every double word, so interrupts and core2 are
+       never held off for more than one programming operation */
+    const uint8_t* bytes = data;
+    for(size_t offset = 0; offset < size; offset += FURI_HAL_FLASH_WRITE_BLOCK) {
+        uint64_t dword;
+        memcpy(&dword, &bytes[offset], sizeof(dword));
+        furi_hal_flash_write_dword(address + offset, dword);
+    }
+
+    op_stat = DWT->CYCCNT - op_stat;
+    FURI_LOG_T(
+        TAG,
+        "write %zu bytes took %lu clocks or %luus",
+        size,
+        op_stat,
+        op_stat / furi_hal_cortex_instructions_per_microsecond());
+}
+
 static size_t furi_hal_flash_get_page_address(uint8_t page) {
     return furi_hal_flash_get_base() + page * FURI_HAL_FLASH_PAGE_SIZE;
 }
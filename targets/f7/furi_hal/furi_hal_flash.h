@@ -102,6 +102,19 @@ void furi_hal_flash_erase(uint8_t page);
  */
 void furi_hal_flash_write_dword(size_t address, uint64_t data);
 
+/** Write double words (64 bits)
+ *
+ * Source data doesn't have to be aligned. Flash access is negotiated with core2 for every
+ * double word, same as furi_hal_flash_write_dword.
+ *
+ * @warning locking operation with critical section, stalls execution
+ *
+ * @param      address  destination address, must be double word aligned.
+ * @param      data     data to write
+ * @param      size     data size, must be multiple of double word size
+ */
+void furi_hal_flash_write(size_t address, const void* data, size_t size);
+
 /** Write aligned page data (up to page size)
  *
  * @warning locking operation with critical section, stalls execution
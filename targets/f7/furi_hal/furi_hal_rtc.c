@@ -37,7 +37,7 @@ typedef struct {
     FuriHalRtcLocaleDateFormat locale_dateformat : 2;
     FuriHalRtcLogDevice log_device               : 2;
     FuriHalRtcLogBaudRate log_baud_rate          : 3;
-    uint8_t reserved                             : 1;
+    FuriHalRtcStorageMode storage_mode           : 1;
 } SystemReg;
 
 _Static_assert(sizeof(SystemReg) == 4, "SystemReg size mismatch");
@@ -299,6 +299,19 @@ FuriHalRtcHeapTrackMode furi_hal_rtc_get_heap_track_mode(void) {
     return data->heap_track_mode;
 }
 
+void furi_hal_rtc_set_storage_mode(FuriHalRtcStorageMode mode) {
+    uint32_t data_reg = furi_hal_rtc_get_register(FuriHalRtcRegisterSystem);
+    SystemReg* data = (SystemReg*)&data_reg;
+    data->storage_mode = mode;
+    furi_hal_rtc_set_register(FuriHalRtcRegisterSystem, data_reg);
+}
+
+FuriHalRtcStorageMode furi_hal_rtc_get_storage_mode(void) {
+    uint32_t data_reg = furi_hal_rtc_get_register(FuriHalRtcRegisterSystem);
+    SystemReg* data = (SystemReg*)&data_reg;
+    return data->storage_mode;
+}
+
 void furi_hal_rtc_set_locale_units(FuriHalRtcLocaleUnits value) {
     uint32_t data_reg = furi_hal_rtc_get_register(FuriHalRtcRegisterSystem);
     SystemReg* data = (SystemReg*)&data_reg;
@@ -40,6 +40,11 @@ typedef enum {
     FuriHalRtcHeapTrackModeAll, /**< Enable allocation tracking for all threads */
 } FuriHalRtcHeapTrackMode;
 
+typedef enum {
+    FuriHalRtcStorageModeDefault = 0, /**< Internal storage readable by older firmware */
+    FuriHalRtcStorageModeLowWear, /**< Inline small files, batch flash programming */
+} FuriHalRtcStorageMode;
+
 typedef enum {
     FuriHalRtcRegisterHeader, /**< RTC structure header */
     FuriHalRtcRegisterSystem, /**< Various system bits */
@@ -197,6 +202,18 @@ void furi_hal_rtc_set_heap_track_mode(FuriHalRtcHeapTrackMode mode);
  */
 FuriHalRtcHeapTrackMode furi_hal_rtc_get_heap_track_mode(void);
 
+/** Set internal storage mode, applied on next boot
+ *
+ * @param[in]  mode  The mode to set
+ */
+void furi_hal_rtc_set_storage_mode(FuriHalRtcStorageMode mode);
+
+/** Get internal storage mode
+ *
+ * @return     The internal storage mode.
+ */
+FuriHalRtcStorageMode furi_hal_rtc_get_storage_mode(void);
+
 /** Set locale units
  *
  * @param[in]  value  The RTC Locale Units
@@ -816,19 +816,6 @@ static FuriStatus sd_spi_get_card_state(void) {
     return FuriStatusError;
 }
 
-static inline bool sd_cache_get(uint32_t address, uint32_t* data) {
-    uint8_t* cached_data = sector_cache_get(address);
-    if(cached_data) {
-        memcpy(data, cached_data, SD_BLOCK_SIZE);
-        return true;
-    }
-    return false;
-}
-
-static inline void sd_cache_put(uint32_t address, uint32_t* data) {
-    sector_cache_put(address, (uint8_t*)data);
-}
-
 static inline void sd_cache_invalidate_range(uint32_t start_sector, uint32_t end_sector) {
     sector_cache_invalidate_range(start_sector, end_sector);
 }
@@ -975,13 +962,6 @@ FuriStatus furi_hal_sd_read_blocks(uint32_t* buff, uint32_t sector, uint32_t cou
     furi_check(buff);
 
     FuriStatus status;
-    bool single_sector = count == 1;
-
-    if(single_sector) {
-        if(sd_cache_get(sector, buff)) {
-            return FuriStatusOk;
-        }
-    }
 
     status = sd_device_read(buff, sector, count);
 
@@ -1003,10 +983,6 @@ FuriStatus furi_hal_sd_read_blocks(uint32_t* buff, uint32_t sector, uint32_t cou
         }
     }
 
-    if(single_sector && status == FuriStatusOk) {
-        sd_cache_put(sector, buff);
-    }
-
     return status;
 }
 